@@ -349,6 +349,10 @@ def Z3_solver_propagate_fixed(ctx, s, fixed_eh, _elems = Elementaries(_lib.Z3_so
     _elems.f(ctx, s, fixed_eh)
     _elems.Check(ctx)
 
+def Z3_solver_propagate_fixed_batch(ctx, s, fixed_batch_eh, _elems = Elementaries(_lib.Z3_solver_propagate_fixed_batch)):
+    _elems.f(ctx, s, fixed_batch_eh)
+    _elems.Check(ctx)
+
 def Z3_solver_propagate_eq(ctx, s, eq_eh, _elems = Elementaries(_lib.Z3_solver_propagate_eq)):
     _elems.f(ctx, s, eq_eh)
     _elems.Check(ctx)
@@ -357,6 +361,11 @@ def Z3_solver_propagate_diseq(ctx, s, diseq_eh, _elems = Elementaries(_lib.Z3_so
     _elems.f(ctx, s, diseq_eh)
     _elems.Check(ctx)
 
+def Z3_model_eval_int64s(ctx, m, num_terms, terms, model_completion, values, _elems = Elementaries(_lib.Z3_model_eval_int64s)):
+    r = _elems.f(ctx, m, num_terms, terms, model_completion, values)
+    _elems.Check(ctx)
+    return r
+
 
 """)
 
@@ -1721,7 +1730,7 @@ def write_log_h_preamble(log_h):
   log_h.write('extern std::ostream * g_z3_log;\n')
   log_h.write('extern std::atomic<bool>      g_z3_log_enabled;\n')
   log_h.write('class z3_log_ctx { bool m_prev; public: z3_log_ctx() { m_prev = g_z3_log && g_z3_log_enabled.exchange(false); } ~z3_log_ctx() { if (g_z3_log) g_z3_log_enabled = m_prev; } bool enabled() const { return m_prev; } };\n')
-  log_h.write('inline void SetR(void * obj) { *g_z3_log << "= " << obj << "\\n"; }\ninline void SetO(void * obj, unsigned pos) { *g_z3_log << "* " << obj << " " << pos << "\\n"; } \ninline void SetAO(void * obj, unsigned pos, unsigned idx) { *g_z3_log << "@ " << obj << " " << pos << " " << idx << "\\n"; }\n')
+  log_h.write('void SetR(void * obj);\nvoid SetO(void * obj, unsigned pos);\nvoid SetAO(void * obj, unsigned pos, unsigned idx);\n')
   log_h.write('#define RETURN_Z3(Z3RES) if (_LOG_CTX.enabled()) { SetR(Z3RES); } return Z3RES\n')
   log_h.write('void _Z3_append_log(char const * msg);\n')
 
@@ -1851,6 +1860,7 @@ pop_eh_type   = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_uint)
 fresh_eh_type = ctypes.CFUNCTYPE(ctypes.c_void_p, ctypes.c_void_p, ctypes.c_void_p)
 
 fixed_eh_type = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint, ctypes.c_void_p)
+fixed_batch_eh_type = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint, ctypes.POINTER(ctypes.c_uint), ctypes.POINTER(ctypes.c_void_p))
 final_eh_type = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p)
 eq_eh_type    = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_void_p, ctypes.c_uint, ctypes.c_uint)
 
@@ -1863,12 +1873,18 @@ _lib.Z3_solver_propagate_final.argtypes = [ContextObj, SolverObj, final_eh_type]
 _lib.Z3_solver_propagate_fixed.restype = None
 _lib.Z3_solver_propagate_fixed.argtypes = [ContextObj, SolverObj, fixed_eh_type]
 
+_lib.Z3_solver_propagate_fixed_batch.restype = None
+_lib.Z3_solver_propagate_fixed_batch.argtypes = [ContextObj, SolverObj, fixed_batch_eh_type]
+
 _lib.Z3_solver_propagate_eq.restype = None
 _lib.Z3_solver_propagate_eq.argtypes = [ContextObj, SolverObj, eq_eh_type]
 
 _lib.Z3_solver_propagate_diseq.restype = None
 _lib.Z3_solver_propagate_diseq.argtypes = [ContextObj, SolverObj, eq_eh_type]
 
+_lib.Z3_model_eval_int64s.restype = ctypes.c_bool
+_lib.Z3_model_eval_int64s.argtypes = [ContextObj, Model, ctypes.c_uint, ctypes.POINTER(Ast), ctypes.c_bool, ctypes.POINTER(ctypes.c_int64)]
+
 
 """
   )
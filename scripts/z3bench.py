@@ -0,0 +1,310 @@
+#!/usr/bin/env python
+############################################
+# Copyright (c) 2026 Microsoft Corporation
+#
+# End-to-end regression benchmark runner.
+#
+############################################
+"""
+Run the z3 executable on directories of benchmarks and compare the
+results with a stored baseline.
+
+    z3bench.py run [options] -o results.json DIR_OR_FILE ...
+
+runs every SMT-LIB2 (.smt2, including CHC problems) and DIMACS (.cnf,
+.dimacs) file, each in its own z3 process, with -st so that the solver
+statistics are recorded along with the wall time, the answers and the
+peak memory reported by z3. Benchmarks run in parallel (-j) and each run
+is limited by a timeout.
+
+    z3bench.py compare [options] baseline.json results.json
+
+compares two result files benchmark by benchmark and summarizes per
+logic. With several repetitions per benchmark (--repeat), a change in
+run time is only reported as a regression or an improvement when a
+Mann-Whitney U test rejects that both samples have the same
+distribution. Different answers are always reported. The exit code is
+1 if there are regressions or different answers.
+"""
+import argparse
+import concurrent.futures
+import json
+import math
+import os
+import re
+import subprocess
+import sys
+import time
+
+SMT2_EXTS = ('.smt2',)
+DIMACS_EXTS = ('.cnf', '.dimacs')
+ANSWERS = ('sat', 'unsat', 'unknown', 'timeout')
+
+STAT_RE = re.compile(r':([^\s()]+)\s+(-?[0-9][0-9.eE+-]*)')
+LOGIC_RE = re.compile(r'\(\s*set-logic\s+([^\s)]+)\s*\)')
+
+
+def find_benchmarks(paths):
+    files = []
+    for p in paths:
+        if os.path.isfile(p):
+            files.append(p)
+            continue
+        for root, dirs, names in os.walk(p):
+            dirs.sort()
+            for n in sorted(names):
+                if n.endswith(SMT2_EXTS + DIMACS_EXTS):
+                    files.append(os.path.join(root, n))
+    return files
+
+
+def get_logic(path):
+    if path.endswith(DIMACS_EXTS):
+        return 'SAT'
+    try:
+        with open(path, 'r', errors='replace') as f:
+            head = f.read(1 << 16)
+    except OSError:
+        return 'ALL'
+    m = LOGIC_RE.search(head)
+    if m:
+        return m.group(1)
+    if 'declare-rel' in head or 'declare-var' in head:
+        return 'HORN'
+    return 'ALL'
+
+
+def parse_output(out):
+    answers = []
+    stats = {}
+    stats_start = out.find('(:')
+    body = out if stats_start < 0 else out[:stats_start]
+    for line in body.splitlines():
+        line = line.strip()
+        if line in ANSWERS:
+            answers.append(line)
+        elif line.startswith('s '):
+            # DIMACS solution line.
+            answers.append({'SATISFIABLE': 'sat', 'UNSATISFIABLE': 'unsat'}.get(line[2:].strip(), 'unknown'))
+    if stats_start >= 0:
+        for key, val in STAT_RE.findall(out[stats_start:]):
+            try:
+                stats[key] = float(val) if ('.' in val or 'e' in val or 'E' in val) else int(val)
+            except ValueError:
+                pass
+    return answers, stats
+
+
+def run_one(z3, args, timeout, path):
+    cmd = [z3, '-st', '-T:%d' % timeout]
+    if path.endswith(DIMACS_EXTS):
+        cmd.append('-dimacs')
+    cmd += args + [path]
+    start = time.monotonic()
+    status = 'ok'
+    try:
+        # z3 enforces the timeout itself, the grace period only catches runs that hang.
+        p = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                           universal_newlines=True, timeout=timeout + 10)
+        out, code = p.stdout, p.returncode
+    except subprocess.TimeoutExpired as e:
+        out, code, status = e.stdout or '', None, 'killed'
+        if isinstance(out, bytes):
+            out = out.decode(errors='replace')
+    wall = time.monotonic() - start
+    answers, stats = parse_output(out)
+    if status == 'ok' and (wall >= timeout or 'timeout' in answers):
+        status = 'timeout'
+    elif status == 'ok' and code not in (0, 10, 20):
+        # dimacs mode exits with 10 and 20 for sat and unsat.
+        status = 'error'
+    return {
+        'time': wall,
+        'status': status,
+        'answers': answers,
+        'memory': stats.get('max-memory'),
+        'stats': stats,
+    }
+
+
+def cmd_run(opts):
+    files = find_benchmarks(opts.paths)
+    if not files:
+        print('no benchmarks found', file=sys.stderr)
+        return 1
+    version = subprocess.run([opts.z3, '-version'], stdout=subprocess.PIPE,
+                             universal_newlines=True).stdout.strip()
+    jobs = [(f, r) for f in files for r in range(opts.repeat)]
+    runs = {f: [None] * opts.repeat for f in files}
+    with concurrent.futures.ThreadPoolExecutor(max_workers=opts.jobs) as pool:
+        futures = {pool.submit(run_one, opts.z3, opts.args, opts.timeout, f): (f, r) for f, r in jobs}
+        done = 0
+        for fut in concurrent.futures.as_completed(futures):
+            f, r = futures[fut]
+            runs[f][r] = fut.result()
+            done += 1
+            if opts.verbose:
+                res = runs[f][r]
+                print('[%d/%d] %s %s %.3fs' % (done, len(jobs), f, res['status'], res['time']), file=sys.stderr)
+    result = {
+        'z3': opts.z3,
+        'version': version,
+        'args': opts.args,
+        'timeout': opts.timeout,
+        'repeat': opts.repeat,
+        'date': time.strftime('%Y-%m-%dT%H:%M:%S'),
+        'benchmarks': [{'file': f, 'logic': get_logic(f), 'runs': runs[f]} for f in files],
+    }
+    with open(opts.output, 'w') as out:
+        json.dump(result, out, indent=1)
+    return 0
+
+
+def median(xs):
+    xs = sorted(xs)
+    n = len(xs)
+    return (xs[n // 2] + xs[(n - 1) // 2]) / 2.0
+
+
+def mann_whitney_p(xs, ys):
+    """
+    Two-sided p-value of the Mann-Whitney U test, using the normal
+    approximation with tie correction. Returns None for samples that are
+    too small for the test to be meaningful.
+    """
+    n1, n2 = len(xs), len(ys)
+    if n1 < 3 or n2 < 3:
+        return None
+    pooled = sorted([(x, 0) for x in xs] + [(y, 1) for y in ys])
+    ranks = [0.0] * len(pooled)
+    ties = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1
+        t = j - i + 1
+        ties += t ** 3 - t
+        i = j + 1
+    r1 = sum(r for r, (_, s) in zip(ranks, pooled) if s == 0)
+    u = r1 - n1 * (n1 + 1) / 2.0
+    n = n1 + n2
+    var = n1 * n2 / 12.0 * ((n + 1) - ties / (n * (n - 1)))
+    if var <= 0:
+        return 1.0
+    z = (abs(u - n1 * n2 / 2.0) - 0.5) / math.sqrt(var)
+    return max(0.0, min(1.0, math.erfc(max(z, 0.0) / math.sqrt(2))))
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return {b['file']: b for b in data['benchmarks']}, data
+
+
+def solved(runs):
+    return all(r['status'] == 'ok' and r['answers'] and 'unknown' not in r['answers'] for r in runs)
+
+
+def cmd_compare(opts):
+    base, base_data = load(opts.baseline)
+    cur, cur_data = load(opts.results)
+    per_logic = {}
+    regressions, improvements, mismatches = [], [], []
+    for f in sorted(set(base) & set(cur)):
+        b, c = base[f], cur[f]
+        logic = c['logic']
+        s = per_logic.setdefault(logic, {'count': 0, 'base_solved': 0, 'solved': 0, 'log_ratio': 0.0,
+                                         'regressions': 0, 'improvements': 0})
+        s['count'] += 1
+        b_solved, c_solved = solved(b['runs']), solved(c['runs'])
+        s['base_solved'] += b_solved
+        s['solved'] += c_solved
+        b_ans, c_ans = b['runs'][0]['answers'], c['runs'][0]['answers']
+        if b_solved and c_solved and b_ans != c_ans:
+            mismatches.append((f, b_ans, c_ans))
+        bt = [r['time'] for r in b['runs']]
+        ct = [r['time'] for r in c['runs']]
+        bm, cm = median(bt), median(ct)
+        ratio = max(cm, 0.01) / max(bm, 0.01)
+        s['log_ratio'] += math.log(ratio)
+        p = mann_whitney_p(bt, ct)
+        significant = (p is not None and p < opts.alpha) if not opts.no_significance else True
+        if b_solved and not c_solved:
+            regressions.append((f, bm, cm, p))
+            s['regressions'] += 1
+        elif c_solved and not b_solved:
+            improvements.append((f, bm, cm, p))
+            s['improvements'] += 1
+        elif abs(cm - bm) < opts.min_delta:
+            # small absolute differences are noise, whatever the ratio.
+            continue
+        elif significant and ratio > 1 + opts.threshold:
+            regressions.append((f, bm, cm, p))
+            s['regressions'] += 1
+        elif significant and ratio < 1 / (1 + opts.threshold):
+            improvements.append((f, bm, cm, p))
+            s['improvements'] += 1
+
+    print('baseline: %s (%s)' % (opts.baseline, base_data.get('version', '')))
+    print('results:  %s (%s)' % (opts.results, cur_data.get('version', '')))
+    print('%-16s %8s %14s %14s %10s %6s %6s' % ('logic', 'count', 'solved(base)', 'solved', 'time', 'worse', 'better'))
+    for logic in sorted(per_logic):
+        s = per_logic[logic]
+        print('%-16s %8d %14d %14d %9.3fx %6d %6d' % (logic, s['count'], s['base_solved'], s['solved'],
+                                                     math.exp(s['log_ratio'] / s['count']),
+                                                     s['regressions'], s['improvements']))
+
+    def fmt_p(p):
+        return 'n/a' if p is None else '%.4f' % p
+    for title, items in (('regressions', regressions), ('improvements', improvements)):
+        if items:
+            print('\n%s:' % title)
+            for f, bm, cm, p in items:
+                print('  %s %.3fs -> %.3fs (p=%s)' % (f, bm, cm, fmt_p(p)))
+    if mismatches:
+        print('\ndifferent answers:')
+        for f, ba, ca in mismatches:
+            print('  %s %s -> %s' % (f, ' '.join(ba), ' '.join(ca)))
+    missing = sorted(set(base) - set(cur))
+    if missing:
+        print('\n%d benchmarks of the baseline were not run' % len(missing))
+    return 1 if regressions or mismatches else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='End-to-end regression benchmarks for z3.')
+    sub = parser.add_subparsers(dest='command')
+    run = sub.add_parser('run', help='run benchmarks and record the results')
+    run.add_argument('paths', nargs='+', help='benchmark files or directories')
+    run.add_argument('-o', '--output', required=True, help='JSON file for the results')
+    run.add_argument('--z3', default='z3', help='z3 executable (default: z3 in PATH)')
+    run.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1, help='number of parallel runs')
+    run.add_argument('-t', '--timeout', type=int, default=60, help='timeout per run in seconds')
+    run.add_argument('-r', '--repeat', type=int, default=1, help='runs per benchmark, at least 3 for significance tests')
+    run.add_argument('-a', '--args', nargs=argparse.REMAINDER, default=[],
+                     help='further arguments passed to z3, must come last')
+    run.add_argument('-v', '--verbose', action='store_true')
+    cmp = sub.add_parser('compare', help='compare results with a baseline')
+    cmp.add_argument('baseline')
+    cmp.add_argument('results')
+    cmp.add_argument('--alpha', type=float, default=0.05, help='significance level (default 0.05)')
+    cmp.add_argument('--threshold', type=float, default=0.1,
+                     help='relative change of the median time that is reported (default 0.1)')
+    cmp.add_argument('--min-delta', type=float, default=0.05,
+                     help='ignore changes of less than this many seconds (default 0.05)')
+    cmp.add_argument('--no-significance', action='store_true',
+                     help='report changes above the threshold without significance test')
+    opts = parser.parse_args()
+    if opts.command == 'run':
+        return cmd_run(opts)
+    if opts.command == 'compare':
+        return cmd_compare(opts)
+    parser.print_help()
+    return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -44,7 +44,8 @@ public:
     
     //
     // Returns true iff model was successfully constructed.
-    // Conflicts are saved as a side effect.
+    // Conflicts are saved as a side effect: all congruences violated by
+    // the abstract model are collected, at most one per term.
     //
     bool check() {
         bool retv = true;
@@ -54,7 +55,7 @@ public:
             expr * const term  = _term ? _term : m.mk_const(c);
             if (!check_term(term)) retv = false;
         }
-        return retv;
+        return retv && m_conflicts.empty();
     }
     
     
@@ -279,19 +280,21 @@ private:
             sort * s = a_fd->get_range();
             value = m_abstr_model->get_some_value(s);
         }
-        // check congruence
+        // check congruence, the terms with the same argument values form a
+        // class represented by its first term.
         val_info vi;
         if(m_values2val.find(key,vi)) { // already is mapped to a value
             SASSERT(vi.source_term);
-            const bool ok =  vi.value == value;
-            if (!ok) {
+            if (vi.value != value) {
                 TRACE("model_constructor",
                       tout << "already mapped by(\n" << mk_ismt2_pp(vi.source_term, m, 2) << "\n->"
                       << mk_ismt2_pp(vi.value, m, 2) << ")\n"; );
                 m_conflicts.push_back(std::make_pair(a, vi.source_term));
             }
-            result = vi.value;
-            return ok;
+            // continue with the value of the abstract model, so that further
+            // conflicts are violated by the abstract model as well.
+            result = value;
+            return true;
         } 
         else {                        // new value
             result = value;
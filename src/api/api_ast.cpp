@@ -19,6 +19,7 @@ Revision History:
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
 #include "api/api_util.h"
+#include "api/api_ast_vector.h"
 #include "ast/well_sorted.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -26,6 +27,7 @@ Revision History:
 #include "ast/array_decl_plugin.h"
 #include "ast/pb_decl_plugin.h"
 #include "ast/ast_translation.h"
+#include "ast/ast_serialize.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_smt_pp.h"
@@ -40,6 +42,7 @@ Revision History:
 #include "util/cancel_eh.h"
 #include "util/scoped_timer.h"
 #include "ast/pp_params.hpp"
+#include "params/rewriter_params.hpp"
 #include "ast/expr_abstract.h"
 
 
@@ -179,6 +182,44 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_ast_vector Z3_API Z3_mk_app_batch(Z3_context c, unsigned num_terms, Z3_func_decl const decls[], unsigned const num_args[],
+                                         unsigned num_arg_indices, unsigned const arg_indices[],
+                                         unsigned num_inputs, Z3_ast const inputs[]) {
+        Z3_TRY;
+        LOG_Z3_mk_app_batch(c, num_terms, decls, num_args, num_arg_indices, arg_indices, num_inputs, inputs);
+        RESET_ERROR_CODE();
+        ast_manager& m = mk_c(c)->m();
+        ptr_vector<expr> terms;
+        for (unsigned i = 0; i < num_inputs; ++i) {
+            CHECK_IS_EXPR(to_ast(inputs[i]), nullptr);
+            terms.push_back(to_expr(inputs[i]));
+        }
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), m);
+        mk_c(c)->save_object(v);
+        ptr_buffer<expr> arg_list;
+        unsigned j = 0;
+        for (unsigned i = 0; i < num_terms; ++i) {
+            if (num_args[i] > num_arg_indices - j) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "insufficient argument indices");
+                RETURN_Z3(nullptr);
+            }
+            arg_list.reset();
+            for (unsigned k = 0; k < num_args[i]; ++k, ++j) {
+                if (arg_indices[j] >= terms.size()) {
+                    SET_ERROR_CODE(Z3_INVALID_ARG, "argument index out of range");
+                    RETURN_Z3(nullptr);
+                }
+                arg_list.push_back(terms[arg_indices[j]]);
+            }
+            app* a = m.mk_app(to_func_decl(decls[i]), arg_list.size(), arg_list.c_ptr());
+            v->m_ast_vector.push_back(a);
+            check_sorts(c, a);
+            terms.push_back(a);
+        }
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_ast Z3_API Z3_mk_const(Z3_context c, Z3_symbol s, Z3_sort ty) {
         Z3_TRY;
         LOG_Z3_mk_const(c, s, ty);
@@ -745,6 +786,8 @@ extern "C" {
         bool     use_ctrl_c  = p.get_bool("ctrl_c", false);
         th_rewriter m_rw(m, p);
         m_rw.set_solver(alloc(api::seq_expr_solver, m, p));
+        if (rewriter_params(p).persistent_cache())
+            m_rw.set_memo(&mk_c(c)->simplify_memo());
         expr_ref    result(m);
         cancel_eh<reslimit> eh(m.limit());
         api::context::set_interruptable si(*(mk_c(c)), eh);
@@ -944,6 +987,45 @@ extern "C" {
         Z3_CATCH_RETURN("");
     }
 
+    Z3_char_ptr Z3_API Z3_serialize_ast(Z3_context c, Z3_ast a, unsigned* length) {
+        Z3_TRY;
+        LOG_Z3_serialize_ast(c, a, length);
+        RESET_ERROR_CODE();
+        CHECK_IS_EXPR(a, "");
+        if (!length) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "length argument is null");
+            return "";
+        }
+        std::ostringstream out;
+        {
+            ast_binary_writer writer(mk_c(c)->m(), out);
+            writer(to_expr(a));
+        }
+        std::string const& str = out.str();
+        auto& buffer = mk_c(c)->m_char_buffer;
+        buffer.reset();
+        buffer.append(static_cast<unsigned>(str.size()), str.c_str());
+        *length = buffer.size();
+        return buffer.c_ptr();
+        Z3_CATCH_RETURN("");
+    }
+
+    Z3_ast Z3_API Z3_deserialize_ast(Z3_context c, unsigned length, Z3_string data) {
+        Z3_TRY;
+        LOG_Z3_deserialize_ast(c, length, data);
+        RESET_ERROR_CODE();
+        std::istringstream in(std::string(data, length));
+        ast_binary_reader reader(mk_c(c)->m(), in);
+        expr_ref result(mk_c(c)->m());
+        if (!reader(result)) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "no expression in serialized input");
+            RETURN_Z3(nullptr);
+        }
+        mk_c(c)->save_ast_trail(result);
+        RETURN_Z3(of_ast(result.get()));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_decl_kind Z3_API Z3_get_decl_kind(Z3_context c, Z3_func_decl d) {
         Z3_TRY;
         LOG_Z3_get_decl_kind(c, d);
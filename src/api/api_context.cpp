@@ -40,18 +40,21 @@ namespace api {
     void object::dec_ref() { SASSERT(m_ref_count > 0); m_ref_count--; if (m_ref_count == 0) m_context.del_object(this); }
     
     unsigned context::add_object(api::object* o) {
-        unsigned id = m_allocated_objects.size();
-        if (!m_free_object_ids.empty()) {
-            id = m_free_object_ids.back();
-            m_free_object_ids.pop_back();
+        if (m_free_object_ids.empty()) {
+            m_allocated_objects.push_back(o);
+            return m_allocated_objects.size() - 1;
         }
-        m_allocated_objects.insert(id, o);
+        unsigned id = m_free_object_ids.back();
+        m_free_object_ids.pop_back();
+        SASSERT(!m_allocated_objects[id]);
+        m_allocated_objects[id] = o;
         return id;
     }
 
     void context::del_object(api::object* o) {
+        SASSERT(m_allocated_objects[o->id()] == o);
         m_free_object_ids.push_back(o->id());
-        m_allocated_objects.remove(o->id());
+        m_allocated_objects[o->id()] = nullptr;
         dealloc(o);
     }
 
@@ -110,16 +113,45 @@ namespace api {
 
 
     context::~context() {
+        m_simplify_memo = nullptr;
         m_last_obj = nullptr;
-        for (auto& kv : m_allocated_objects) {
-            api::object* val = kv.m_value;
-            DEBUG_CODE(warning_msg("Uncollected memory: %d: %s", kv.m_key, typeid(*val).name()););
+        for (api::object* val : m_allocated_objects) {
+            if (!val) continue;
+            DEBUG_CODE(warning_msg("Uncollected memory: %d: %s", val->id(), typeid(*val).name()););
             dealloc(val);
         }
         if (m_params.owns_manager())
             m_manager.detach();
     }
 
+    void context::reset() {
+        m_simplify_memo = nullptr;
+        m_last_obj = nullptr;
+        m_cmd = nullptr;
+        ptr_vector<api::object> objects;
+        objects.swap(m_allocated_objects);
+        m_free_object_ids.reset();
+        for (api::object* val : objects) 
+            if (val) 
+                dealloc(val);
+        m_last_result.reset();
+        m_ast_trail.reset();
+        m_string_buffer.clear();
+        m_char_buffer.reset();
+        m_rcf_manager = nullptr;
+        m_error_code = Z3_OK;
+        m_exception_msg.clear();
+        m_searching = false;
+        m_limit.reset_cancel();
+        m().limit().reset_cancel();
+    }
+
+    th_rewriter_memo & context::simplify_memo() {
+        if (!m_simplify_memo)
+            m_simplify_memo = alloc(th_rewriter_memo, m());
+        return *m_simplify_memo;
+    }
+
     context::set_interruptable::set_interruptable(context & ctx, event_handler & i):
         m_ctx(ctx) {
         lock_guard lock(ctx.m_mux);
@@ -221,6 +253,8 @@ namespace api {
     void context::save_ast_trail(ast * n) {
         SASSERT(m().contains(n));
         if (m_user_ref_count) {
+            if (m_last_result.size() == 1 && m_last_result.get(0) == n)
+                return;
             // Corner case bug: n may be in m_last_result, and this is the only reference to n.
             // When, we execute reset() it is deleted
             // To avoid this bug, I bump the reference counter before resetting m_last_result
@@ -360,6 +394,14 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_context_reset(Z3_context c) {
+        Z3_TRY;
+        LOG_Z3_context_reset(c);
+        RESET_ERROR_CODE();
+        mk_c(c)->reset();
+        Z3_CATCH;
+    }
+
     void Z3_API Z3_interrupt(Z3_context c) {
         Z3_TRY;
         LOG_Z3_interrupt(c);
@@ -32,6 +32,7 @@ Revision History:
 #include "ast/recfun_decl_plugin.h"
 #include "ast/special_relations_decl_plugin.h"
 #include "ast/rewriter/seq_rewriter.h"
+#include "ast/rewriter/th_rewriter.h"
 #include "smt/params/smt_params.h"
 #include "smt/smt_kernel.h"
 #include "smt/smt_solver.h"
@@ -92,11 +93,13 @@ namespace api {
         smt_params                 m_fparams;
         // -------------------------------
 
+        scoped_ptr<th_rewriter_memo> m_simplify_memo; //!< results of previous simplify calls when rewriter.persistent_cache is set.
+
         ast_ref_vector             m_last_result; //!< used when m_user_ref_count == true
         ast_ref_vector             m_ast_trail;   //!< used when m_user_ref_count == false
 
         ref<api::object>           m_last_obj; //!< reference to the last API object returned by the APIs
-        u_map<api::object*>        m_allocated_objects; // !< table containing current set of allocated API objects
+        ptr_vector<api::object>    m_allocated_objects; // !< slots of allocated API objects indexed by identifier, nullptr for free slots
         unsigned_vector            m_free_object_ids;   // !< free list of identifiers available for allocated objects.
 
         family_id                  m_basic_fid;
@@ -138,6 +141,12 @@ namespace api {
         
         context(context_params * p, bool user_ref_count = false);
         ~context();
+
+        /**
+           \brief delete all API objects and release references kept by the context,
+           keeping the manager with its plugins and the tactic registrations.
+        */
+        void reset();
         ast_manager & m() const { return *(m_manager.get()); }
 
         context_params & params() { m_params.updt_params(); return m_params; }
@@ -251,6 +260,8 @@ namespace api {
         //
         // ------------------------
         smt_params & fparams() { return m_fparams; }
+
+        th_rewriter_memo & simplify_memo();
         
     };
     
@@ -16,14 +16,17 @@ Revision History:
 
 --*/
 #include<fstream>
+#include<sstream>
 #include "api/z3.h"
 #include "api/api_log_macros.h"
+#include "api/z3_log_binary.h"
 #include "util/util.h"
 #include "util/z3_version.h"
 #include "util/mutex.h"
 
 std::ostream * g_z3_log = nullptr;
 std::atomic<bool> g_z3_log_enabled;
+bool g_z3_log_binary = false;
 
 #ifdef Z3_LOG_SYNC
 static mutex g_log_mux;
@@ -32,12 +35,112 @@ static mutex g_log_mux;
 #define SCOPED_LOCK() {}
 #endif
 
+namespace z3_log_binary {
+
+    async_file_buf::async_file_buf(char const* file_name):
+        m_out(file_name, std::ios::out | std::ios::binary | std::ios::trunc) {
+        m_front.resize(buffer_size);
+        m_back.resize(buffer_size);
+        setp(m_front.c_ptr(), m_front.c_ptr() + buffer_size);
+#ifndef SINGLE_THREAD
+        if (is_open())
+            m_writer = std::thread([this]() { run(); });
+#endif
+    }
+
+    async_file_buf::~async_file_buf() {
+        sync();
+#ifndef SINGLE_THREAD
+        if (m_writer.joinable()) {
+            {
+                lock_guard lock(m_mux);
+                m_stop = true;
+            }
+            m_cv.notify_all();
+            m_writer.join();
+        }
+#endif
+    }
+
+#ifndef SINGLE_THREAD
+    void async_file_buf::run() {
+        std::unique_lock<std::mutex> lock(m_mux);
+        while (true) {
+            m_cv.wait(lock, [&] { return m_has_back || m_stop; });
+            if (!m_has_back)
+                return;
+            lock.unlock();
+            m_out.write(m_back.c_ptr(), m_back_size);
+            lock.lock();
+            m_has_back = false;
+            m_cv.notify_all();
+        }
+    }
+#endif
+
+    void async_file_buf::wait_written() {
+#ifndef SINGLE_THREAD
+        std::unique_lock<std::mutex> lock(m_mux);
+        m_cv.wait(lock, [&] { return !m_has_back; });
+#endif
+    }
+
+    void async_file_buf::hand_off() {
+        size_t n = pptr() - pbase();
+        if (n == 0)
+            return;
+#ifdef SINGLE_THREAD
+        m_out.write(pbase(), n);
+#else
+        if (!m_writer.joinable()) {
+            m_out.write(pbase(), n);
+        }
+        else {
+            std::unique_lock<std::mutex> lock(m_mux);
+            m_cv.wait(lock, [&] { return !m_has_back; });
+            m_front.swap(m_back);
+            m_back_size = n;
+            m_has_back = true;
+            m_cv.notify_all();
+        }
+#endif
+        setp(m_front.c_ptr(), m_front.c_ptr() + buffer_size);
+    }
+
+    async_file_buf::int_type async_file_buf::overflow(int_type c) {
+        hand_off();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int async_file_buf::sync() {
+        hand_off();
+        wait_written();
+        m_out.flush();
+        return m_out.fail() ? -1 : 0;
+    }
+
+    writer::writer(char const* file_name):
+        std::ostream(&m_buf),
+        m_buf(file_name) {
+    }
+
+    bool is_binary_log_name(char const* file_name) {
+        size_t n = strlen(file_name);
+        return n >= 4 && strcmp(file_name + n - 4, ".bin") == 0;
+    }
+};
+
 extern "C" {
     void Z3_close_log_unsafe(void) {
         if (g_z3_log != nullptr) {
             g_z3_log_enabled = false;
             dealloc(g_z3_log);
             g_z3_log = nullptr;
+            g_z3_log_binary = false;
         }
     }
 
@@ -47,6 +150,23 @@ extern "C" {
         SCOPED_LOCK();
         if (g_z3_log != nullptr)
             Z3_close_log_unsafe();
+        if (z3_log_binary::is_binary_log_name(filename)) {
+            z3_log_binary::writer* w = alloc(z3_log_binary::writer, filename);
+            if (!w->is_open()) {
+                dealloc(w);
+                return false;
+            }
+            w->write(z3_log_binary::log_magic, sizeof(z3_log_binary::log_magic));
+            w->put_uint(z3_log_binary::log_version);
+            std::stringstream strm;
+            strm << Z3_MAJOR_VERSION << "." << Z3_MINOR_VERSION << "." << Z3_BUILD_NUMBER << "." << Z3_REVISION_NUMBER;
+            w->put_tag('V');
+            w->put_string(strm.str().c_str());
+            g_z3_log = w;
+            g_z3_log_binary = true;
+            g_z3_log_enabled = true;
+            return true;
+        }
         g_z3_log = alloc(std::ofstream, filename);
         if (g_z3_log->bad() || g_z3_log->fail()) {
             dealloc(g_z3_log);
@@ -174,6 +174,78 @@ extern "C" {
         Z3_CATCH_RETURN(false);
     }
 
+    static bool eval_numeral(Z3_context c, model& mdl, Z3_ast t, rational& r) {
+        ast_manager& m = mk_c(c)->m();
+        expr_ref v = mdl(to_expr(t));
+        unsigned bv_size;
+        bool is_int;
+        if (mk_c(c)->autil().is_numeral(v, r, is_int) || mk_c(c)->bvutil().is_numeral(v, r, bv_size))
+            return true;
+        if (m.is_true(v) || m.is_false(v)) {
+            r = m.is_true(v) ? rational::one() : rational::zero();
+            return true;
+        }
+        return false;
+    }
+
+    static void init_model_eval(Z3_context c, Z3_model m) {
+        model * _m = to_model_ref(m);
+        if (!_m->has_solver()) {
+            params_ref p;
+            _m->set_solver(alloc(api::seq_expr_solver, mk_c(c)->m(), p));
+        }
+    }
+
+    bool Z3_API Z3_model_eval_int64s(Z3_context c, Z3_model m, unsigned num_terms, Z3_ast const terms[], bool model_completion, int64_t values[]) {
+        Z3_TRY;
+        RESET_ERROR_CODE();
+        CHECK_NON_NULL(m, false);
+        for (unsigned i = 0; i < num_terms; ++i) {
+            CHECK_IS_EXPR(terms[i], false);
+        }
+        init_model_eval(c, m);
+        model& _m = *to_model_ref(m);
+        model::scoped_model_completion _scm(_m, model_completion);
+        bool result = true;
+        rational r;
+        for (unsigned i = 0; i < num_terms; ++i) {
+            if (eval_numeral(c, _m, terms[i], r) && r.is_int64()) {
+                values[i] = r.get_int64();
+            }
+            else {
+                values[i] = 0;
+                result = false;
+            }
+        }
+        return result;
+        Z3_CATCH_RETURN(false);
+    }
+
+    Z3_string Z3_API Z3_model_eval_numerals(Z3_context c, Z3_model m, unsigned num_terms, Z3_ast const terms[], bool model_completion) {
+        Z3_TRY;
+        LOG_Z3_model_eval_numerals(c, m, num_terms, terms, model_completion);
+        RESET_ERROR_CODE();
+        CHECK_NON_NULL(m, nullptr);
+        for (unsigned i = 0; i < num_terms; ++i) {
+            CHECK_IS_EXPR(terms[i], nullptr);
+        }
+        init_model_eval(c, m);
+        model& _m = *to_model_ref(m);
+        model::scoped_model_completion _scm(_m, model_completion);
+        std::string result;
+        rational r;
+        for (unsigned i = 0; i < num_terms; ++i) {
+            if (i > 0)
+                result += ' ';
+            if (eval_numeral(c, _m, terms[i], r))
+                result += r.to_string();
+            else
+                result += '?';
+        }
+        return mk_c(c)->mk_external_string(std::move(result));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     unsigned Z3_API Z3_model_get_num_sorts(Z3_context c, Z3_model m) {
         Z3_TRY;
         LOG_Z3_model_get_num_sorts(c, m);
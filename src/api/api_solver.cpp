@@ -17,12 +17,19 @@ Revision History:
 
 --*/
 #include<iostream>
+#ifndef SINGLE_THREAD
+#include <deque>
+#include <functional>
+#include <thread>
+#endif
 #include "util/scoped_ctrl_c.h"
 #include "util/cancel_eh.h"
 #include "util/file_path.h"
 #include "util/scoped_timer.h"
 #include "util/file_path.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_pp_util.h"
+#include "ast/ast_serialize.h"
 #include "api/z3.h"
 #include "api/api_log_macros.h"
 #include "api/api_context.h"
@@ -35,6 +42,7 @@ Revision History:
 #include "smt/smt_solver.h"
 #include "smt/smt_implied_equalities.h"
 #include "solver/smt_logics.h"
+#include "solver/progress_metrics.h"
 #include "solver/tactic2solver.h"
 #include "solver/solver_params.hpp"
 #include "cmd_context/cmd_context.h"
@@ -128,6 +136,22 @@ extern "C" {
         if (m_eh) (*m_eh)(API_INTERRUPT_EH_CALLER);
     }
 
+    void Z3_solver_ref::wait_async() {
+#ifndef SINGLE_THREAD
+        std::unique_lock<std::mutex> lock(m_mux);
+        m_async_cv.wait(lock, [&] { return !m_async_running; });
+#endif
+    }
+
+    void Z3_solver_ref::finish_async(Z3_lbool r) {
+        lock_guard lock(m_mux);
+        m_async_result = r;
+        m_async_running = false;
+#ifndef SINGLE_THREAD
+        m_async_cv.notify_all();
+#endif
+    }
+
     void Z3_solver_ref::assert_expr(expr * e) {
         if (m_pp) m_pp->assert_expr(e);
         m_solver->assert_expr(e);
@@ -138,6 +162,31 @@ extern "C" {
         m_solver->assert_expr(e, t);
     }
 
+    /**
+       \brief Report a JSON sample of the statistics of the solver at regular intervals.
+    */
+    class api_progress_callback : public progress_callback {
+        Z3_solver_ref&   m_ref;
+        void*            m_user_context;
+        Z3_progress_eh*  m_eh;
+        unsigned         m_interval;
+        progress_metrics m_metrics;
+    public:
+        api_progress_callback(Z3_solver_ref& r, void* user_context, Z3_progress_eh* eh, unsigned interval):
+            m_ref(r), m_user_context(user_context), m_eh(eh), m_interval(interval) {}
+
+        unsigned slow_progress_interval() const override { return m_interval; }
+
+        void slow_progress_sample() override {
+            statistics st;
+            m_ref.m_solver->collect_statistics(st);
+            std::ostringstream strm;
+            m_metrics.display_json(strm, st);
+            std::string s = strm.str();
+            m_eh(m_user_context, s.c_str());
+        }
+    };
+
     static void init_solver_core(Z3_context c, Z3_solver _s) {
         Z3_solver_ref * s = to_solver(_s);
         bool proofs_enabled, models_enabled, unsat_core_enabled;
@@ -150,6 +199,8 @@ extern "C" {
         context_params::collect_solver_param_descrs(r);
         p.validate(r);
         s->m_solver->updt_params(p);
+        if (s->m_progress)
+            s->m_solver->set_progress_callback(s->m_progress.get());
     }
 
     static void init_solver(Z3_context c, Z3_solver s) {
@@ -325,6 +376,99 @@ extern "C" {
         Z3_CATCH;
     }
 
+    /*
+     * A snapshot starts with a header line that records the number of assertions,
+     * lemmas and the size of the model converter section. The model converter is stored
+     * as SMT2 commands, followed by the assertions and lemmas in the binary AST format.
+     */
+    static char const* snapshot_header = "; z3 snapshot";
+    static const unsigned snapshot_version = 1;
+
+    void Z3_API Z3_solver_to_snapshot(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_to_snapshot(c, s, file_name);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        solver& slv = *to_solver_ref(s);
+        ast_manager& m = slv.get_manager();
+        std::ofstream out(file_name, std::ios::binary);
+        if (!out) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        expr_ref_vector fmls = slv.get_assertions();
+        expr_ref_vector lemmas = slv.get_lemmas();
+        std::ostringstream mc_text;
+        model_converter_ref mc = slv.get_model_converter();
+        if (mc) {
+            ast_pp_util visitor(m);
+            mc->set_env(&visitor);
+            visitor.collect(fmls);
+            visitor.display_decls(mc_text);
+            mc->display(mc_text);
+            mc->set_env(nullptr);
+        }
+        std::string const& mc_str = mc_text.str();
+        out << snapshot_header << " " << snapshot_version << " " << fmls.size() << " " << lemmas.size() << " " << mc_str.size() << "\n";
+        out << mc_str;
+        ast_binary_writer writer(m, out);
+        for (expr* e : fmls)
+            writer(e);
+        for (expr* e : lemmas)
+            writer(e);
+        writer.finish();
+        if (!out)
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+        Z3_CATCH;
+    }
+
+    void Z3_API Z3_solver_from_snapshot(Z3_context c, Z3_solver s, Z3_string file_name) {
+        Z3_TRY;
+        LOG_Z3_solver_from_snapshot(c, s, file_name);
+        RESET_ERROR_CODE();
+        std::ifstream in(file_name, std::ios::binary);
+        if (!in) {
+            SET_ERROR_CODE(Z3_FILE_ACCESS_ERROR, nullptr);
+            return;
+        }
+        std::string line;
+        std::getline(in, line);
+        unsigned version = 0, num_fmls = 0, num_lemmas = 0, mc_size = 0;
+        std::istringstream header(line.size() > strlen(snapshot_header) ? line.substr(strlen(snapshot_header)) : std::string());
+        if (line.compare(0, strlen(snapshot_header), snapshot_header) != 0 ||
+            !(header >> version >> num_fmls >> num_lemmas >> mc_size) || version != snapshot_version) {
+            SET_ERROR_CODE(Z3_PARSER_ERROR, "not a solver snapshot");
+            return;
+        }
+        ast_manager& m = mk_c(c)->m();
+        std::string mc_str(mc_size, 0);
+        in.read(&mc_str[0], mc_size);
+        scoped_ptr<cmd_context> ctx = alloc(cmd_context, false, &m);
+        ctx->set_ignore_check(true);
+        std::stringstream errstrm;
+        ctx->set_regular_stream(errstrm);
+        std::istringstream mc_in(mc_str);
+        if (!parse_smt2_commands(*ctx.get(), mc_in)) {
+            SET_ERROR_CODE(Z3_PARSER_ERROR, errstrm.str());
+            return;
+        }
+        ast_binary_reader reader(m, in);
+        expr_ref_vector fmls(m);
+        expr_ref e(m);
+        while (reader(e))
+            fmls.push_back(e);
+        if (fmls.size() != num_fmls + num_lemmas) {
+            SET_ERROR_CODE(Z3_PARSER_ERROR, "truncated solver snapshot");
+            return;
+        }
+        init_solver(c, s);
+        for (expr* f : fmls)
+            to_solver(s)->assert_expr(f);
+        if (mc_size > 0)
+            to_solver_ref(s)->set_model_converter(ctx->get_model_converter());
+        Z3_CATCH;
+    }
+
     Z3_string Z3_API Z3_solver_get_help(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_help(c, s);
@@ -592,7 +736,12 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
-    static Z3_lbool _solver_check(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[]) {
+    /**
+       \brief when async is set, the check runs on a worker thread of Z3_solver_check_async.
+       Exceptions are then recorded in the solver and reported by Z3_solver_check_async_wait,
+       and Ctrl-C is not intercepted.
+    */
+    static Z3_lbool _solver_check(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[], bool async = false) {
         for (unsigned i = 0; i < num_assumptions; i++) {
             if (!is_expr(to_ast(assumptions[i]))) {
                 SET_ERROR_CODE(Z3_INVALID_ARG, "assumption is not an expression");
@@ -605,7 +754,7 @@ extern "C" {
         timeout              = to_solver(s)->m_params.get_uint("timeout", timeout);
         timeout              = sp.timeout() != UINT_MAX ? sp.timeout() : timeout;
         unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
-        bool     use_ctrl_c  = to_solver(s)->m_params.get_bool("ctrl_c", true);
+        bool     use_ctrl_c  = !async && to_solver(s)->m_params.get_bool("ctrl_c", true);
         cancel_eh<reslimit> eh(mk_c(c)->m().limit());
         to_solver(s)->set_eh(&eh);
         api::context::set_interruptable si(*(mk_c(c)), eh);
@@ -622,7 +771,16 @@ extern "C" {
                 to_solver_ref(s)->set_reason_unknown(eh);
                 to_solver(s)->set_eh(nullptr);
                 if (mk_c(c)->m().inc()) {
-                    mk_c(c)->handle_exception(ex);
+                    if (async) {
+                        Z3_solver_ref* r = to_solver(s);
+                        r->m_async_failed = true;
+                        r->m_async_has_code = ex.has_error_code();
+                        r->m_async_code = ex.has_error_code() ? ex.error_code() : 0;
+                        r->m_async_msg = ex.msg();
+                    }
+                    else {
+                        mk_c(c)->handle_exception(ex);
+                    }
                 }
                 return Z3_L_UNDEF;
             }
@@ -657,6 +815,165 @@ extern "C" {
         Z3_CATCH_RETURN(Z3_L_UNDEF);
     }
     
+#ifndef SINGLE_THREAD
+    /**
+       \brief process wide pool of workers for asynchronous checks.
+       Workers are created on demand, up to one per hardware thread,
+       and queued checks wait for a free worker.
+    */
+    class check_pool {
+        std::mutex                        m_mux;
+        std::condition_variable           m_cv;
+        std::deque<std::function<void()>> m_tasks;
+        std::vector<std::thread>          m_workers;
+        unsigned                          m_idle { 0 };
+        bool                              m_shutdown { false };
+
+        void run() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mux);
+                    ++m_idle;
+                    m_cv.wait(lock, [&] { return m_shutdown || !m_tasks.empty(); });
+                    --m_idle;
+                    if (m_tasks.empty())
+                        return;
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+    public:
+        ~check_pool() {
+            {
+                lock_guard lock(m_mux);
+                m_shutdown = true;
+            }
+            m_cv.notify_all();
+            for (auto& w : m_workers)
+                w.join();
+        }
+
+        static check_pool& instance() {
+            static check_pool pool;
+            return pool;
+        }
+
+        void submit(std::function<void()> const& task) {
+            {
+                lock_guard lock(m_mux);
+                m_tasks.push_back(task);
+                unsigned max_workers = std::max(1u, std::thread::hardware_concurrency());
+                if (m_idle < m_tasks.size() && m_workers.size() < max_workers) 
+                    m_workers.push_back(std::thread([this]() { run(); }));
+            }
+            m_cv.notify_one();
+        }
+    };
+#endif
+
+    void Z3_API Z3_solver_check_async(Z3_context c, Z3_solver s, unsigned num_assumptions, Z3_ast const assumptions[],
+                                      void* user_context, Z3_check_eh* check_eh) {
+        Z3_TRY;
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        for (unsigned i = 0; i < num_assumptions; i++) {
+            if (!is_expr(to_ast(assumptions[i]))) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "assumption is not an expression");
+                return;
+            }
+        }
+        Z3_solver_ref* r = to_solver(s);
+        {
+            lock_guard lock(r->m_mux);
+            if (r->m_async_running) {
+                SET_ERROR_CODE(Z3_INVALID_USAGE, "an asynchronous check is already running on the solver");
+                return;
+            }
+            r->m_async_running = true;
+            r->m_async_result = Z3_L_UNDEF;
+            r->m_async_failed = false;
+            r->m_async_msg.clear();
+        }
+        ast_manager& m = mk_c(c)->m();
+        svector<Z3_ast> asms(num_assumptions, assumptions);
+        for (Z3_ast a : asms)
+            m.inc_ref(to_ast(a));
+        auto task = [c, s, asms, user_context, check_eh]() {
+            Z3_lbool result = Z3_L_UNDEF;
+            try {
+                result = _solver_check(c, s, asms.size(), asms.c_ptr(), true);
+            }
+            catch (z3_exception& ex) {
+                Z3_solver_ref* r = to_solver(s);
+                r->m_async_failed = true;
+                r->m_async_has_code = ex.has_error_code();
+                r->m_async_code = ex.has_error_code() ? ex.error_code() : 0;
+                r->m_async_msg = ex.msg();
+            }
+            for (Z3_ast a : asms)
+                mk_c(c)->m().dec_ref(to_ast(a));
+            if (check_eh)
+                check_eh(user_context, result);
+            to_solver(s)->finish_async(result);
+        };
+#ifdef SINGLE_THREAD
+        task();
+#else
+        check_pool::instance().submit(task);
+#endif
+        Z3_CATCH;
+    }
+
+    void Z3_API Z3_solver_set_progress_callback(Z3_context c, Z3_solver s, void* user_context,
+                                                unsigned interval, Z3_progress_eh* progress_eh) {
+        Z3_TRY;
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        Z3_solver_ref* r = to_solver(s);
+        r->m_solver->set_progress_callback(nullptr);
+        r->m_progress = nullptr;
+        if (progress_eh) {
+            r->m_progress = alloc(api_progress_callback, *r, user_context, progress_eh, std::max(interval, 1u));
+            r->m_solver->set_progress_callback(r->m_progress.get());
+        }
+        Z3_CATCH;
+    }
+
+    bool Z3_API Z3_solver_check_async_done(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async_done(c, s);
+        Z3_solver_ref* r = to_solver(s);
+        lock_guard lock(r->m_mux);
+        return !r->m_async_running;
+        Z3_CATCH_RETURN(false);
+    }
+
+    Z3_lbool Z3_API Z3_solver_check_async_wait(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async_wait(c, s);
+        RESET_ERROR_CODE();
+        Z3_solver_ref* r = to_solver(s);
+        r->wait_async();
+        if (r->m_async_failed) {
+            r->m_async_failed = false;
+            if (r->m_async_has_code) {
+                z3_error ex(r->m_async_code);
+                mk_c(c)->handle_exception(ex);
+            }
+            else {
+                default_exception ex(std::move(r->m_async_msg));
+                mk_c(c)->handle_exception(ex);
+            }
+            return Z3_L_UNDEF;
+        }
+        return r->m_async_result;
+        Z3_CATCH_RETURN(Z3_L_UNDEF);
+    }
+
     Z3_model Z3_API Z3_solver_get_model(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_model(c, s);
@@ -888,6 +1205,122 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_ast_vector Z3_API Z3_solver_cubes(Z3_context c, Z3_solver s, Z3_ast_vector vs, unsigned cutoff, unsigned max_cubes) {
+        Z3_TRY;
+        LOG_Z3_solver_cubes(c, s, vs, cutoff, max_cubes);
+        ast_manager& m = mk_c(c)->m();
+        expr_ref_vector result(m), vars(m);
+        for (ast* a : to_ast_vector_ref(vs)) {
+            if (!is_expr(a)) {
+                SET_ERROR_CODE(Z3_INVALID_USAGE, "cube contains a non-expression");
+            }
+            else {
+                vars.push_back(to_expr(a));
+            }
+        }
+        unsigned timeout     = to_solver(s)->m_params.get_uint("timeout", mk_c(c)->get_timeout());
+        unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
+        bool     use_ctrl_c  = to_solver(s)->m_params.get_bool("ctrl_c", true);
+        cancel_eh<reslimit> eh(mk_c(c)->m().limit());
+        to_solver(s)->set_eh(&eh);
+        api::context::set_interruptable si(*(mk_c(c)), eh);
+        {
+            scoped_ctrl_c ctrlc(eh, false, use_ctrl_c);
+            scoped_timer timer(timeout, &eh);
+            scoped_rlimit _rlimit(mk_c(c)->m().limit(), rlimit);
+            try {
+                result.append(to_solver_ref(s)->cubes(vars, cutoff, max_cubes));
+            }
+            catch (z3_exception & ex) {
+                to_solver(s)->set_eh(nullptr);
+                mk_c(c)->handle_exception(ex);
+                return nullptr;
+            }
+            catch (...) {
+            }
+        }
+        to_solver(s)->set_eh(nullptr);
+        Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), mk_c(c)->m());
+        mk_c(c)->save_object(v);
+        for (expr* e : result) {
+            v->m_ast_vector.push_back(e);
+        }
+        to_ast_vector_ref(vs).reset();
+        for (expr* a : vars) {
+            to_ast_vector_ref(vs).push_back(a);
+        }
+        RETURN_Z3(of_ast_vector(v));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
+    Z3_lbool Z3_API Z3_solver_cube_literals(Z3_context c, Z3_solver s, Z3_ast_vector vs, Z3_ast_vector atoms, unsigned cutoff, 
+                                            unsigned max_lits, unsigned lits[], unsigned * num_lits) {
+        Z3_TRY;
+        LOG_Z3_solver_cube_literals(c, s, vs, atoms, cutoff, max_lits, lits, num_lits);
+        *num_lits = 0;
+        ast_manager& m = mk_c(c)->m();
+        expr_ref_vector result(m), vars(m);
+        for (ast* a : to_ast_vector_ref(vs)) {
+            if (!is_expr(a)) {
+                SET_ERROR_CODE(Z3_INVALID_USAGE, "cube contains a non-expression");
+            }
+            else {
+                vars.push_back(to_expr(a));
+            }
+        }
+        unsigned timeout     = to_solver(s)->m_params.get_uint("timeout", mk_c(c)->get_timeout());
+        unsigned rlimit      = to_solver(s)->m_params.get_uint("rlimit", mk_c(c)->get_rlimit());
+        bool     use_ctrl_c  = to_solver(s)->m_params.get_bool("ctrl_c", true);
+        cancel_eh<reslimit> eh(mk_c(c)->m().limit());
+        to_solver(s)->set_eh(&eh);
+        api::context::set_interruptable si(*(mk_c(c)), eh);
+        {
+            scoped_ctrl_c ctrlc(eh, false, use_ctrl_c);
+            scoped_timer timer(timeout, &eh);
+            scoped_rlimit _rlimit(mk_c(c)->m().limit(), rlimit);
+            try {
+                result.append(to_solver_ref(s)->cube(vars, cutoff));
+            }
+            catch (z3_exception & ex) {
+                to_solver(s)->set_eh(nullptr);
+                mk_c(c)->handle_exception(ex);
+                return Z3_L_UNDEF;
+            }
+            catch (...) {
+            }
+        }
+        to_solver(s)->set_eh(nullptr);
+        to_ast_vector_ref(vs).reset();
+        for (expr* a : vars) {
+            to_ast_vector_ref(vs).push_back(a);
+        }
+        if (result.size() == 1 && m.is_true(result.get(0))) 
+            return Z3_L_TRUE;
+        if (result.size() == 1 && m.is_false(result.get(0))) 
+            return Z3_L_FALSE;
+        if (result.size() > max_lits) {
+            SET_ERROR_CODE(Z3_INVALID_ARG, "cube has more than max_lits literals");
+            return Z3_L_UNDEF;
+        }
+        ast_ref_vector& atom_vector = to_ast_vector_ref(atoms);
+        obj_map<ast, unsigned> atom2idx;
+        for (unsigned i = 0; i < atom_vector.size(); ++i) 
+            atom2idx.insert_if_not_there(atom_vector.get(i), i);
+        for (expr* lit : result) {
+            expr* atom = lit;
+            bool sign = m.is_not(lit, atom);
+            unsigned idx = 0;
+            if (!atom2idx.find(atom, idx)) {
+                idx = atom_vector.size();
+                atom_vector.push_back(atom);
+                atom2idx.insert(atom, idx);
+            }
+            lits[(*num_lits)++] = 2 * idx + (sign ? 1 : 0);
+        }
+        return Z3_L_UNDEF;
+        Z3_CATCH_RETURN(Z3_L_UNDEF);
+    }
+
     class api_context_obj : public solver::context_obj {
         api::context* c;
     public:
@@ -929,6 +1362,17 @@ extern "C" {
         Z3_CATCH;        
     }
 
+    void Z3_API Z3_solver_propagate_fixed_batch(
+        Z3_context        c, 
+        Z3_solver         s,
+        Z3_fixed_batch_eh fixed_batch_eh) {
+        Z3_TRY;
+        RESET_ERROR_CODE();
+        solver::fixed_batch_eh_t _fixed = (void(*)(void*,solver::propagate_callback*,unsigned,unsigned const*,expr* const*))fixed_batch_eh; 
+        to_solver_ref(s)->user_propagate_register_fixed_batch(_fixed);
+        Z3_CATCH;        
+    }
+
     void Z3_API Z3_solver_propagate_final(
         Z3_context  c, 
         Z3_solver   s,
@@ -978,4 +1422,20 @@ extern "C" {
         Z3_CATCH;        
     }
 
+    void Z3_API Z3_solver_propagate_consequences(Z3_context c, Z3_solver_callback s, unsigned num_conseqs, Z3_ast const* conseqs, unsigned const* num_fixed, unsigned num_ids, unsigned const* fixed_ids) {
+        Z3_TRY;
+        LOG_Z3_solver_propagate_consequences(c, s, num_conseqs, conseqs, num_fixed, num_ids, fixed_ids);
+        RESET_ERROR_CODE();
+        unsigned offset = 0;
+        for (unsigned i = 0; i < num_conseqs; ++i) {
+            if (offset + num_fixed[i] > num_ids) {
+                SET_ERROR_CODE(Z3_INVALID_ARG, "more fixed identifiers are used than supplied");
+                return;
+            }
+            reinterpret_cast<solver::propagate_callback*>(s)->propagate(num_fixed[i], fixed_ids + offset, 0, nullptr, nullptr, to_expr(conseqs[i]));
+            offset += num_fixed[i];
+        }
+        Z3_CATCH;        
+    }
+
 };
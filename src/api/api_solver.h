@@ -18,6 +18,9 @@ Revision History:
 #pragma once
 
 #include "util/mutex.h"
+#ifndef SINGLE_THREAD
+#include <condition_variable>
+#endif
 #include "api/api_util.h"
 #include "solver/solver.h"
 
@@ -47,14 +50,30 @@ struct Z3_solver_ref : public api::object {
     mutex                      m_mux;
     event_handler*             m_eh;
 
+    // state of the check started by Z3_solver_check_async, protected by m_mux.
+#ifndef SINGLE_THREAD
+    std::condition_variable    m_async_cv;
+#endif
+    bool                       m_async_running { false };
+    Z3_lbool                   m_async_result { Z3_L_UNDEF };
+    bool                       m_async_failed { false };
+    bool                       m_async_has_code { false };
+    unsigned                   m_async_code { 0 };
+    std::string                m_async_msg;
+
+    // installed by Z3_solver_set_progress_callback.
+    scoped_ptr<progress_callback> m_progress;
+
     Z3_solver_ref(api::context& c, solver_factory * f): 
         api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr) {}
-    ~Z3_solver_ref() override {}
+    ~Z3_solver_ref() override { wait_async(); }
 
     void assert_expr(expr* e);
     void assert_expr(expr* e, expr* t);
     void set_eh(event_handler* eh);
     void set_cancel();
+    void wait_async();
+    void finish_async(Z3_lbool r);
 
 };
 
@@ -6047,6 +6047,43 @@ class ModelRef(Z3PPObject):
             return _to_expr_ref(r[0], self.ctx)
         raise Z3Exception("failed to evaluate expression in the model")
 
+    def eval_int64s(self, terms, model_completion=False):
+        """Evaluate the integer, bit-vector or Boolean terms `terms` in the model `self` using a single call.
+        The result is a ctypes array of 64-bit integers. It supports the buffer protocol, so it can be
+        wrapped without copying, e.g., using `numpy.frombuffer(r, dtype=numpy.int64)`.
+
+        >>> x, y = Ints('x y')
+        >>> s = Solver()
+        >>> s.add(x == 3, y == -x)
+        >>> s.check()
+        sat
+        >>> list(s.model().eval_int64s([x, y, x + y]))
+        [3, -3, 0]
+        """
+        _terms, sz = _to_ast_array(terms)
+        r = (ctypes.c_int64 * sz)()
+        if Z3_model_eval_int64s(self.ctx.ref(), self.model, sz, _terms, model_completion, r):
+            return r
+        raise Z3Exception("terms do not evaluate to 64-bit numerals, use eval_numerals")
+
+    def eval_numerals(self, terms, model_completion=False):
+        """Evaluate the numeral terms `terms` in the model `self` using a single call.
+        Return the values as a list of decimal strings. Rational values are printed as `p/q`,
+        and the values of terms that do not evaluate to numerals are `?`.
+
+        >>> x = Real('x')
+        >>> s = Solver()
+        >>> s.add(2*x == 1)
+        >>> s.check()
+        sat
+        >>> s.model().eval_numerals([x, 2*x])
+        ['1/2', '1']
+        """
+        _terms, sz = _to_ast_array(terms)
+        if sz == 0:
+            return []
+        return Z3_model_eval_numerals(self.ctx.ref(), self.model, sz, _terms, model_completion).split(' ')
+
     def evaluate(self, t, model_completion=False):
         """Alias for `eval`.
 
@@ -6809,6 +6846,29 @@ class Solver(Z3PPObject):
             if (len(r) == 0):
                 return
 
+    def cubes(self, vars = None, batch = 64):
+        """Get cubes in batches of at most `batch` cubes.
+        Each cube is returned as a conjunction. The method retrieves
+        cubes from the solver in batches to reduce the number of calls
+        into the solver when cubes are distributed to other workers.
+        """
+        self.cube_vs = AstVector(None, self.ctx)
+        if vars is not None:
+           for v in vars:
+               self.cube_vs.push(v)
+        while True:
+            lvl = self.backtrack_level
+            self.backtrack_level = 4000000000
+            r = AstVector(Z3_solver_cubes(self.ctx.ref(), self.solver, self.cube_vs.vector, lvl, batch), self.ctx)
+            if len(r) == 0:
+                return
+            for c in r:
+                if is_false(c):
+                    return
+                yield c
+                if is_true(c):
+                    return
+
     def cube_vars(self):
         """Access the set of variables that were touched by the most recently generated cube.
         This set of variables can be used as a starting point for additional cubes.
@@ -10559,6 +10619,12 @@ def user_prop_fixed(ctx, cb, id, value):
     prop.fixed(id, _to_expr_ref(ctypes.c_void_p(value), prop.ctx()))
     prop.cb = None
 
+def user_prop_fixed_batch(ctx, cb, num_fixed, ids, values):
+    prop = _prop_closures.get(ctx)
+    prop.cb = cb
+    prop.fixed_batch([(ids[i], _to_expr_ref(ctypes.c_void_p(values[i]), prop.ctx())) for i in range(num_fixed)])
+    prop.cb = None
+
 def user_prop_final(ctx, cb):
     prop = _prop_closures.get(ctx)
     prop.cb = cb
@@ -10581,6 +10647,7 @@ _user_prop_push  = push_eh_type(user_prop_push)
 _user_prop_pop   = pop_eh_type(user_prop_pop)
 _user_prop_fresh = fresh_eh_type(user_prop_fresh)
 _user_prop_fixed = fixed_eh_type(user_prop_fixed)
+_user_prop_fixed_batch = fixed_batch_eh_type(user_prop_fixed_batch)
 _user_prop_final = final_eh_type(user_prop_final)
 _user_prop_eq    = eq_eh_type(user_prop_eq)
 _user_prop_diseq = eq_eh_type(user_prop_diseq)
@@ -10602,6 +10669,7 @@ class UserPropagateBase:
         self.cb = None
         self.id = _prop_closures.insert(self)
         self.fixed = None
+        self.fixed_batch = None
         self.final = None
         self.eq    = None
         self.diseq = None
@@ -10638,6 +10706,16 @@ class UserPropagateBase:
         Z3_solver_propagate_fixed(self.ctx_ref(), self.solver.solver, _user_prop_fixed)
         self.fixed = fixed
  
+    #
+    # The callback receives the list of (id, value) pairs that were fixed
+    # in a propagation round, instead of one call per fixed value.
+    # 
+    def add_fixed_batch(self, fixed_batch):
+        assert not self.fixed_batch
+        assert not self._ctx
+        Z3_solver_propagate_fixed_batch(self.ctx_ref(), self.solver.solver, _user_prop_fixed_batch)
+        self.fixed_batch = fixed_batch
+
     def add_final(self, final):
         assert not self.final
         assert not self._ctx
@@ -10686,5 +10764,21 @@ class UserPropagateBase:
             _rhs[i] = eqs[i][1]
         Z3_solver_propagate_consequence(e.ctx.ref(), ctypes.c_void_p(self.cb), num_fixed, _ids, num_eqs, _lhs, _rhs, e.ast)
 
+    #
+    # Propagate a list of (e, ids) pairs in one call.
+    # 
+    def propagate_batch(self, props):
+        num = len(props)
+        if num == 0:
+            return
+        ids = [id for _, p_ids in props for id in p_ids]
+        _conseqs = (Ast * num)()
+        _num_fixed = (ctypes.c_uint * num)()
+        for i in range(num):
+            _conseqs[i] = props[i][0].as_ast()
+            _num_fixed[i] = len(props[i][1])
+        _ids = (ctypes.c_uint * len(ids))(*ids)
+        Z3_solver_propagate_consequences(props[0][0].ctx.ref(), ctypes.c_void_p(self.cb), num, _conseqs, _num_fixed, len(ids), _ids)
+
     def conflict(self, ids):
         self.propagate(BoolVal(False, self.ctx()), ids, eqs=[])
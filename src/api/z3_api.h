@@ -1422,9 +1422,20 @@ typedef void Z3_push_eh(void* ctx);
 typedef void Z3_pop_eh(void* ctx, unsigned num_scopes);
 typedef void* Z3_fresh_eh(void* ctx, Z3_context new_context);
 typedef void Z3_fixed_eh(void* ctx, Z3_solver_callback cb, unsigned id, Z3_ast value);
+typedef void Z3_fixed_batch_eh(void* ctx, Z3_solver_callback cb, unsigned num_fixed, unsigned const* ids, Z3_ast const* values);
 typedef void Z3_eq_eh(void* ctx, Z3_solver_callback cb, unsigned x, unsigned y);
 typedef void Z3_final_eh(void* ctx, Z3_solver_callback cb);
 
+/**
+   \brief completion callback for asynchronous satisfiability checks (See #Z3_solver_check_async).
+*/
+typedef void Z3_check_eh(void* ctx, Z3_lbool result);
+
+/**
+   \brief progress callback of a running check (See #Z3_solver_set_progress_callback).
+*/
+typedef void Z3_progress_eh(void* ctx, Z3_string metrics);
+
 /**
    \brief A Goal is essentially a set of formulas.
    Z3 provide APIs for building strategies/tactics for solving and transforming Goals.
@@ -1628,6 +1639,24 @@ extern "C" {
     */
     void Z3_API Z3_del_context(Z3_context c);
 
+    /**
+       \brief Reset the given logical context so that it can be reused for an
+       unrelated query, e.g., by a pool of contexts.
+
+       All objects created in the context (solvers, models, goals, ...) are deleted
+       and all references to terms kept by the context are released. Handles obtained
+       from the context before the reset must not be used afterwards. With contexts created
+       by #Z3_mk_context_rc, terms whose references are still held by the caller remain
+       allocated. The parameters, the registered theory plugins and tactics are kept, which
+       makes this much cheaper than creating a new context. Declarations of algebraic
+       datatypes and recursive functions are also kept.
+
+       \sa Z3_del_context
+
+       def_API('Z3_context_reset', VOID, (_in(CONTEXT),))
+    */
+    void Z3_API Z3_context_reset(Z3_context c);
+
     /**
        \brief Increment the reference counter of the given AST.
        The context \c c should have been created using #Z3_mk_context_rc.
@@ -2181,6 +2210,31 @@ extern "C" {
         unsigned num_args,
         Z3_ast const args[]);
 
+    /**
+       \brief Create a sequence of function applications in one call.
+
+       The terms are numbered starting with the \c num_inputs terms in \c inputs,
+       followed by the \c num_terms terms created by this call. The i-th created term
+       is the application of \c decls[i] to the next \c num_args[i] entries of
+       \c arg_indices, each of which refers to an input or to an earlier created term.
+       The created terms are returned in order.
+
+       \pre num_arg_indices is the sum of the entries of num_args.
+
+       \sa Z3_mk_app
+
+       def_API('Z3_mk_app_batch', AST_VECTOR, (_in(CONTEXT), _in(UINT), _in_array(1, FUNC_DECL), _in_array(1, UINT), _in(UINT), _in_array(4, UINT), _in(UINT), _in_array(6, AST)))
+    */
+    Z3_ast_vector Z3_API Z3_mk_app_batch(
+        Z3_context c,
+        unsigned num_terms,
+        Z3_func_decl const decls[],
+        unsigned const num_args[],
+        unsigned num_arg_indices,
+        unsigned const arg_indices[],
+        unsigned num_inputs,
+        Z3_ast const inputs[]);
+
     /**
        \brief Declare and create a constant.
 
@@ -5123,6 +5177,36 @@ extern "C" {
     */
     Z3_bool_opt Z3_API Z3_model_eval(Z3_context c, Z3_model m, Z3_ast t, bool model_completion, Z3_ast * v);
 
+    /**
+       \brief Evaluate the terms \c terms in the given model and store their values in \c values.
+       Return \c true if every term evaluates to an integer, bit-vector or Boolean
+       value that fits in 64 bits. Bit-vector values are read as unsigned numbers
+       and Boolean values as 0 and 1. The
+       entries of terms whose values are not such numerals are set to 0.
+
+       This function performs a single call for all terms, and \c values is a
+       caller owned buffer, so bindings can expose the result without converting
+       every value. The function has no \c def_API entry because the generator of
+       the bindings does not support output arrays of 64-bit integers.
+
+       \sa Z3_model_eval
+       \sa Z3_model_eval_numerals
+    */
+    bool Z3_API Z3_model_eval_int64s(Z3_context c, Z3_model m, unsigned num_terms, Z3_ast const terms[], bool model_completion, int64_t values[]);
+
+    /**
+       \brief Evaluate the terms \c terms in the given model and return their values
+       as a single string of decimal numerals separated by spaces.
+       Integer, bit-vector and Boolean values are printed as integers, and rational
+       values as \c p/q. The entry of a term whose value is not such a numeral is \c ?.
+
+       \sa Z3_model_eval
+       \sa Z3_model_eval_int64s
+
+       def_API('Z3_model_eval_numerals', STRING, (_in(CONTEXT), _in(MODEL), _in(UINT), _in_array(2, AST), _in(BOOL)))
+    */
+    Z3_string Z3_API Z3_model_eval_numerals(Z3_context c, Z3_model m, unsigned num_terms, Z3_ast const terms[], bool model_completion);
+
     /**
        \brief Return the interpretation (i.e., assignment) of constant \c a in the model \c m.
        Return \c NULL, if the model does not assign an interpretation for \c a.
@@ -5413,6 +5497,11 @@ extern "C" {
     /**
        \brief Log interaction to a file.
 
+       If \c filename ends with \c .bin, the log is written in a compact
+       binary format using buffered writes on a background thread. Buffered
+       records are written when the log is closed. Both formats are replayed
+       with \c z3 \c -log.
+
        extra_API('Z3_open_log', INT, (_in(STRING),))
     */
     bool Z3_API Z3_open_log(Z3_string filename);
@@ -5534,6 +5623,30 @@ extern "C" {
                                                    Z3_ast const assumptions[],
                                                    Z3_ast formula);
 
+    /**
+       \brief Serialize the expression \c a into a compact binary format that preserves
+       sharing of sub-terms. The length of the result is stored in \c length.
+
+       \warning The result buffer is statically allocated by Z3. It will
+       be automatically deallocated when #Z3_del_context is invoked.
+       So, the buffer is invalidated in the next call to \c Z3_serialize_ast.
+
+       \sa Z3_deserialize_ast
+
+       def_API('Z3_serialize_ast', CHAR_PTR, (_in(CONTEXT), _in(AST), _out(UINT)))
+    */
+    Z3_char_ptr Z3_API Z3_serialize_ast(Z3_context c, Z3_ast a, unsigned* length);
+
+    /**
+       \brief Create the expression serialized in the first \c length bytes of \c data
+       by #Z3_serialize_ast.
+
+       \sa Z3_serialize_ast
+
+       def_API('Z3_deserialize_ast', AST, (_in(CONTEXT), _in(UINT), _in(STRING)))
+    */
+    Z3_ast Z3_API Z3_deserialize_ast(Z3_context c, unsigned length, Z3_string data);
+
     /*@}*/
 
     /** @name Parser interface */
@@ -6462,6 +6575,30 @@ extern "C" {
     */
     void Z3_API Z3_solver_from_string(Z3_context c, Z3_solver s, Z3_string file_name);
 
+    /**
+       \brief Save a snapshot of the solver to a file.
+
+       The snapshot contains the assertions of the solver in the form it keeps
+       them after simplification, the lemmas the solver derived and the model
+       converter. Assertions and lemmas are stored in the binary format of
+       #Z3_serialize_ast.
+
+       \sa Z3_solver_from_snapshot
+
+       def_API('Z3_solver_to_snapshot', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_to_snapshot(Z3_context c, Z3_solver s, Z3_string file_name);
+
+    /**
+       \brief Load the assertions, lemmas and model converter of a snapshot created by
+       #Z3_solver_to_snapshot into the solver.
+
+       \sa Z3_solver_to_snapshot
+
+       def_API('Z3_solver_from_snapshot', VOID, (_in(CONTEXT), _in(SOLVER), _in(STRING)))
+    */
+    void Z3_API Z3_solver_from_snapshot(Z3_context c, Z3_solver s, Z3_string file_name);
+
     /**
        \brief Return the set of asserted formulas on the solver.
 
@@ -6550,6 +6687,18 @@ extern "C" {
 
     void Z3_API Z3_solver_propagate_fixed(Z3_context c, Z3_solver s, Z3_fixed_eh fixed_eh);
 
+    /**
+       \brief register a callback for the expressions bound to fixed values.
+       Instead of one call per fixed expression, the callback is invoked once per 
+       propagation round with the identifiers and values of the expressions that
+       were fixed in the round. It replaces a callback registered with 
+       \c Z3_solver_propagate_fixed.
+       The callback may use \c Z3_solver_propagate_consequences to propagate
+       several consequences in one call.
+     */
+
+    void Z3_API Z3_solver_propagate_fixed_batch(Z3_context c, Z3_solver s, Z3_fixed_batch_eh fixed_batch_eh);
+
     /**
        \brief register a callback on final check.
        This provides freedom to the propagator to delay actions or implement a branch-and bound solver.
@@ -6591,6 +6740,17 @@ extern "C" {
     
     void Z3_API Z3_solver_propagate_consequence(Z3_context c, Z3_solver_callback, unsigned num_fixed, unsigned const* fixed_ids, unsigned num_eqs, unsigned const* eq_lhs, unsigned const* eq_rhs, Z3_ast conseq);
 
+    /**
+       \brief propagate several consequences based on fixed values.
+       The i'th consequence \c conseqs[i] is justified by the next \c num_fixed[i] 
+       identifiers of \c fixed_ids, which holds \c num_ids identifiers in total.
+       A consequence that is \c false is a conflict.
+       
+       def_API('Z3_solver_propagate_consequences', VOID, (_in(CONTEXT), _in(SOLVER_CALLBACK), _in(UINT), _in_array(2, AST), _in_array(2, UINT), _in(UINT), _in_array(5, UINT)))
+    */
+    
+    void Z3_API Z3_solver_propagate_consequences(Z3_context c, Z3_solver_callback cb, unsigned num_conseqs, Z3_ast const* conseqs, unsigned const* num_fixed, unsigned num_ids, unsigned const* fixed_ids);
+
     /**
        \brief Check whether the assertions in a given solver are consistent or not.
 
@@ -6625,6 +6785,68 @@ extern "C" {
     Z3_lbool Z3_API Z3_solver_check_assumptions(Z3_context c, Z3_solver s,
                                                 unsigned num_assumptions, Z3_ast const assumptions[]);
 
+    /**
+       \brief Start checking the assertions in the given solver and the
+       optional assumptions on a background thread, and return immediately.
+
+       When the check completes, \c check_eh (if not null) is invoked from the
+       worker thread with \c user_context and the result. The result can also be
+       obtained with #Z3_solver_check_async_done and #Z3_solver_check_async_wait.
+       The check can be cancelled with #Z3_solver_interrupt or #Z3_interrupt,
+       and it honors the \c timeout and \c rlimit parameters of the solver.
+
+       Checks run on a shared pool with one worker per hardware thread.
+       The context is not thread safe: until the check completes, the only
+       functions that may be called on \c c are #Z3_solver_interrupt,
+       #Z3_interrupt, #Z3_solver_check_async_done and #Z3_solver_check_async_wait.
+       In particular the callback must not use the context.
+       Independent contexts can run checks concurrently.
+
+       \sa Z3_solver_check_assumptions
+    */
+    void Z3_API Z3_solver_check_async(Z3_context c, Z3_solver s,
+                                      unsigned num_assumptions, Z3_ast const assumptions[],
+                                      void* user_context, Z3_check_eh* check_eh);
+
+    /**
+       \brief Register a callback that reports the progress of checks of the given solver.
+
+       While a check runs, \c progress_eh is invoked every \c interval milliseconds
+       with \c user_context and a single line JSON object. The object contains
+       the elapsed time in seconds (\c time), the memory in use in megabytes
+       (\c memory, \c max-memory), the number of conflicts, decisions,
+       propagations and restarts per second since the previous sample
+       (\c rates), and the current statistics of the solver (\c stats),
+       including the number of learned clauses (\c lemmas).
+
+       The callback runs on the thread of the check. It may call
+       #Z3_solver_interrupt, but must not use the context otherwise.
+       Samples are produced by the SMT core; other solvers ignore the callback.
+       Passing a null \c progress_eh removes the callback.
+    */
+    void Z3_API Z3_solver_set_progress_callback(Z3_context c, Z3_solver s, void* user_context,
+                                                unsigned interval, Z3_progress_eh* progress_eh);
+
+    /**
+       \brief Return true if no asynchronous check is running on the given solver.
+
+       \sa Z3_solver_check_async
+
+       def_API('Z3_solver_check_async_done', BOOL, (_in(CONTEXT), _in(SOLVER)))
+    */
+    bool Z3_API Z3_solver_check_async_done(Z3_context c, Z3_solver s);
+
+    /**
+       \brief Wait for the asynchronous check started on the given solver to complete
+       and return its result. Errors raised by the check are reported by this call.
+       Returns \c Z3_L_UNDEF if no check was started.
+
+       \sa Z3_solver_check_async
+
+       def_API('Z3_solver_check_async_wait', INT, (_in(CONTEXT), _in(SOLVER)))
+    */
+    Z3_lbool Z3_API Z3_solver_check_async_wait(Z3_context c, Z3_solver s);
+
     /**
        \brief Retrieve congruence class representatives for terms.
 
@@ -6682,6 +6904,49 @@ extern "C" {
 
     Z3_ast_vector Z3_API Z3_solver_cube(Z3_context c, Z3_solver s, Z3_ast_vector vars, unsigned backtrack_level);
 
+    /**
+       \brief extract up to \c max_cubes cubes from a solver in a single call.
+       Each element of the result is the conjunction of the literals of one cube.
+       When the cube space is exhausted the last element is the constant \c true or \c false.
+       The result is empty if cubing was interrupted, for instance by a timeout or resource limit.
+       The state of the cuber is retained between calls, so subsequent calls continue
+       where the previous batch stopped.
+
+       The arguments \c vars and \c backtrack_level are used as in #Z3_solver_cube.
+       The vector \c vars is updated with the variables touched by the last cube of the batch.
+
+       \sa Z3_solver_cube
+
+       def_API('Z3_solver_cubes', AST_VECTOR, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR), _in(UINT), _in(UINT)))
+    */
+
+    Z3_ast_vector Z3_API Z3_solver_cubes(Z3_context c, Z3_solver s, Z3_ast_vector vars, unsigned backtrack_level, unsigned max_cubes);
+
+    /**
+       \brief extract a next cube for a solver as an array of literal identifiers.
+
+       Literals are identified by the atoms in \c atoms: the atom at position \c i
+       is identified by \c 2*i and its negation by \c 2*i+1. Atoms of the cube that 
+       are not yet in \c atoms are appended to it. A client that keeps a copy of 
+       \c atoms, for instance translated to the context of a worker, can then pass
+       cubes around as arrays of integers.
+
+       The result is \c Z3_L_UNDEF if a cube was written to \c lits, and \c num_lits is 
+       set to its number of literals. The cube is the constant \c true when the result is 
+       \c Z3_L_TRUE, and \c false when it is \c Z3_L_FALSE, in both cases \c num_lits is 0. 
+       If cubing was interrupted, or the cube has more than \c max_lits literals, 
+       the result is \c Z3_L_UNDEF and \c num_lits is 0.
+
+       The arguments \c vars and \c backtrack_level are used as in #Z3_solver_cube.
+
+       \sa Z3_solver_cube
+
+       def_API('Z3_solver_cube_literals', INT, (_in(CONTEXT), _in(SOLVER), _in(AST_VECTOR), _in(AST_VECTOR), _in(UINT), _in(UINT), _out_array(5, UINT), _out(UINT)))
+    */
+
+    Z3_lbool Z3_API Z3_solver_cube_literals(Z3_context c, Z3_solver s, Z3_ast_vector vars, Z3_ast_vector atoms, unsigned backtrack_level, 
+                                            unsigned max_lits, unsigned lits[], unsigned * num_lits);
+
     /**
        \brief Retrieve the model for the last #Z3_solver_check or #Z3_solver_check_assumptions
 
@@ -0,0 +1,120 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    z3_log_binary.h
+
+Abstract:
+
+    Compact binary format for interaction logs.
+
+    The binary log contains the same records as the text log (see
+    z3_logger.h and z3_replayer.cpp), but every record is a single tag
+    byte followed by its operands in binary: unsigned integers and
+    pointers as LEB128 varints, signed integers zig-zag encoded, doubles
+    and floats as raw little endian bytes, and strings as a varint length
+    followed by the characters. The stream starts with log_magic.
+
+    Writes go to a memory buffer that is handed to a background thread
+    when full, so the thread calling the API does not wait on the file.
+    Buffered records are written when the log is closed; a log of a
+    process that crashes may miss its last records.
+
+--*/
+#pragma once
+
+#include<iostream>
+#include<fstream>
+#include<cstring>
+#include "util/vector.h"
+#include "util/mutex.h"
+#ifndef SINGLE_THREAD
+#include<condition_variable>
+#include<thread>
+#endif
+
+namespace z3_log_binary {
+
+    const char log_magic[4] = { 0, 'Z', '3', 'B' };
+    const unsigned log_version = 1;
+
+    /**
+       \brief append only stream buffer that writes full buffers on a background thread.
+    */
+    class async_file_buf : public std::streambuf {
+        std::ofstream           m_out;
+        svector<char>           m_front;       // buffer being filled
+        svector<char>           m_back;        // buffer being written
+        size_t                  m_back_size { 0 };
+        bool                    m_has_back { false };
+#ifndef SINGLE_THREAD
+        std::mutex              m_mux;
+        std::condition_variable m_cv;
+        std::thread             m_writer;
+        bool                    m_stop { false };
+        void run();
+#endif
+        void hand_off();
+        void wait_written();
+
+    protected:
+        int_type overflow(int_type c) override;
+        int sync() override;
+
+    public:
+        static const unsigned buffer_size = 1 << 20;
+        async_file_buf(char const* file_name);
+        ~async_file_buf() override;
+        bool is_open() const { return m_out.is_open() && !m_out.fail(); }
+    };
+
+    class writer : public std::ostream {
+        async_file_buf m_buf;
+    public:
+        writer(char const* file_name);
+        bool is_open() const { return m_buf.is_open(); }
+
+        void put_tag(char t) { m_buf.sputc(t); }
+
+        void put_uint(uint64_t u) {
+            while (u >= 0x80) {
+                m_buf.sputc(static_cast<char>((u & 0x7f) | 0x80));
+                u >>= 7;
+            }
+            m_buf.sputc(static_cast<char>(u));
+        }
+
+        void put_int(int64_t i) {
+            put_uint((static_cast<uint64_t>(i) << 1) ^ static_cast<uint64_t>(i >> 63));
+        }
+
+        void put_ptr(void const* p) { put_uint(reinterpret_cast<uintptr_t>(p)); }
+
+        void put_double(double d) {
+            char bytes[sizeof(double)];
+            memcpy(bytes, &d, sizeof(double));
+            m_buf.sputn(bytes, sizeof(double));
+        }
+
+        void put_string(char const* s) {
+            size_t n = strlen(s);
+            put_uint(n);
+            m_buf.sputn(s, n);
+        }
+    };
+
+    /**
+       \brief return true if an interaction log with this name is written in the binary format.
+    */
+    bool is_binary_log_name(char const* file_name);
+};
+
+extern std::ostream * g_z3_log;
+
+/**
+   \brief set when g_z3_log is a z3_log_binary::writer.
+*/
+extern bool g_z3_log_binary;
+
+inline z3_log_binary::writer& z3_binary_log() { return *static_cast<z3_log_binary::writer*>(g_z3_log); }
@@ -18,17 +18,51 @@ Notes:
 --*/
 #include<iostream>
 #include "util/symbol.h"
+#include "api/z3_log_binary.h"
 struct ll_escaped { char const * m_str; ll_escaped(char const * str):m_str(str) {} };
 static std::ostream & operator<<(std::ostream & out, ll_escaped const & d);
 
-static void __declspec(noinline) R()  { *g_z3_log << "R\n"; g_z3_log->flush(); }
-static void __declspec(noinline) P(void * obj)  { *g_z3_log << "P " << obj << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) I(int64_t i)   { *g_z3_log << "I " << i << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) U(uint64_t u)   { *g_z3_log << "U " << u << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) D(double d)   { *g_z3_log << "D " << d << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) S(Z3_string str) { *g_z3_log << "S \"" << ll_escaped(str) << "\"\n"; g_z3_log->flush(); }
+static void __declspec(noinline) R()  { 
+    if (g_z3_log_binary) { z3_binary_log().put_tag('R'); return; }
+    *g_z3_log << "R\n"; g_z3_log->flush(); 
+}
+static void __declspec(noinline) P(void * obj)  { 
+    if (g_z3_log_binary) { z3_binary_log().put_tag('P'); z3_binary_log().put_ptr(obj); return; }
+    *g_z3_log << "P " << obj << "\n"; g_z3_log->flush(); 
+}
+static void __declspec(noinline) I(int64_t i)   { 
+    if (g_z3_log_binary) { z3_binary_log().put_tag('I'); z3_binary_log().put_int(i); return; }
+    *g_z3_log << "I " << i << "\n"; g_z3_log->flush(); 
+}
+static void __declspec(noinline) U(uint64_t u)   { 
+    if (g_z3_log_binary) { z3_binary_log().put_tag('U'); z3_binary_log().put_uint(u); return; }
+    *g_z3_log << "U " << u << "\n"; g_z3_log->flush(); 
+}
+static void __declspec(noinline) D(double d)   { 
+    if (g_z3_log_binary) { z3_binary_log().put_tag('D'); z3_binary_log().put_double(d); return; }
+    *g_z3_log << "D " << d << "\n"; g_z3_log->flush(); 
+}
+static void __declspec(noinline) S(Z3_string str) { 
+    if (g_z3_log_binary) { z3_binary_log().put_tag('S'); z3_binary_log().put_string(str); return; }
+    *g_z3_log << "S \"" << ll_escaped(str) << "\"\n"; g_z3_log->flush(); 
+}
 static void __declspec(noinline) Sy(Z3_symbol sym) { 
     symbol s = symbol::c_api_ext2symbol(sym);
+    if (g_z3_log_binary) {
+        z3_log_binary::writer& w = z3_binary_log();
+        if (s.is_null()) {
+            w.put_tag('N');
+        }
+        else if (s.is_numerical()) {
+            w.put_tag('#');
+            w.put_uint(s.get_num());
+        }
+        else {
+            w.put_tag('$');
+            w.put_string(s.bare_str());
+        }
+        return;
+    }
     if (s.is_null()) {
         *g_z3_log << "N\n";
     }
@@ -40,12 +74,37 @@ static void __declspec(noinline) Sy(Z3_symbol sym) {
     }
     g_z3_log->flush();
 }
-static void __declspec(noinline) Ap(unsigned sz) { *g_z3_log << "p " << sz << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) Au(unsigned sz) { *g_z3_log << "u " << sz << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) Ai(unsigned sz) { *g_z3_log << "i " << sz << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) Asy(unsigned sz) { *g_z3_log << "s " << sz << "\n"; g_z3_log->flush(); }
-static void __declspec(noinline) C(unsigned id)   { *g_z3_log << "C " << id << "\n"; g_z3_log->flush(); }
-void __declspec(noinline) _Z3_append_log(char const * msg) { *g_z3_log << "M \"" << ll_escaped(msg) << "\"\n"; g_z3_log->flush(); }
+static void __declspec(noinline) A(char tag, unsigned sz) {
+    if (g_z3_log_binary) { z3_binary_log().put_tag(tag); z3_binary_log().put_uint(sz); return; }
+    *g_z3_log << tag << " " << sz << "\n"; g_z3_log->flush();
+}
+static void __declspec(noinline) Ap(unsigned sz) { A('p', sz); }
+static void __declspec(noinline) Au(unsigned sz) { A('u', sz); }
+static void __declspec(noinline) Ai(unsigned sz) { A('i', sz); }
+static void __declspec(noinline) Asy(unsigned sz) { A('s', sz); }
+static void __declspec(noinline) C(unsigned id)   { 
+    if (g_z3_log_binary) { z3_binary_log().put_tag('C'); z3_binary_log().put_uint(id); return; }
+    *g_z3_log << "C " << id << "\n"; g_z3_log->flush(); 
+}
+void __declspec(noinline) _Z3_append_log(char const * msg) { 
+    if (g_z3_log_binary) { z3_binary_log().put_tag('M'); z3_binary_log().put_string(msg); return; }
+    *g_z3_log << "M \"" << ll_escaped(msg) << "\"\n"; g_z3_log->flush(); 
+}
+void SetR(void * obj) { 
+    if (g_z3_log_binary) { z3_binary_log().put_tag('='); z3_binary_log().put_ptr(obj); return; }
+    *g_z3_log << "= " << obj << "\n"; 
+}
+void SetO(void * obj, unsigned pos) { 
+    if (g_z3_log_binary) { z3_binary_log().put_tag('*'); z3_binary_log().put_ptr(obj); z3_binary_log().put_uint(pos); return; }
+    *g_z3_log << "* " << obj << " " << pos << "\n"; 
+}
+void SetAO(void * obj, unsigned pos, unsigned idx) { 
+    if (g_z3_log_binary) { 
+        z3_binary_log().put_tag('@'); z3_binary_log().put_ptr(obj); z3_binary_log().put_uint(pos); z3_binary_log().put_uint(idx); 
+        return; 
+    }
+    *g_z3_log << "@ " << obj << " " << pos << " " << idx << "\n"; 
+}
 
 static std::ostream & operator<<(std::ostream & out, ll_escaped const & d) {
     char const * s = d.m_str;
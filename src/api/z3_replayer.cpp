@@ -19,6 +19,7 @@ Notes:
 #include "util/vector.h"
 #include "util/map.h"
 #include "api/z3_replayer.h"
+#include "api/z3_log_binary.h"
 #include "util/stream_buffer.h"
 #include "util/symbol.h"
 #include "util/trace.h"
@@ -42,6 +43,7 @@ struct z3_replayer::imp {
     symbol                   m_id;
     int64_t                  m_int64;
     uint64_t                 m_uint64;
+    uint64_t                 m_idx;
     double                   m_double;
     float                    m_float;
     size_t                   m_ptr;
@@ -402,183 +404,314 @@ struct z3_replayer::imp {
 
 #define TICK_FREQUENCY 100000
 
-    void parse() {
-        memory::exit_when_out_of_memory(false, nullptr);
-        uint64_t counter = 0;
-        unsigned tick = 0;
+    uint64_t m_counter { 0 };
+    unsigned m_tick { 0 };
+
+    void tick() {
+        IF_VERBOSE(1, {
+            m_counter++; m_tick++;
+            if (m_tick >= TICK_FREQUENCY) {
+                std::cout << "[replayer] " << m_counter << " operations executed" << std::endl;
+                m_tick = 0;
+            }
+        });
+    }
+
+    /**
+       \brief execute the record with tag c. The operands are stored in
+       m_ptr, m_uint64, m_idx, m_int64, m_float, m_double, m_string and m_id
+       by the reader of the text or binary format.
+    */
+    void exec(int c) {
+        switch (c) {
+        case 'V':
+            // version
+            break;
+        case 'R':
+            // reset
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "R\n";);
+            reset();
+            break;
+        case 'P': {
+            // push pointer
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "P " << m_ptr << "\n";);
+            if (m_ptr == 0) {
+                m_args.push_back(nullptr);
+            }
+            else {
+                void * obj = nullptr;
+                if (!m_heap.find(m_ptr, obj))
+                    throw z3_replayer_exception("invalid pointer");
+                m_args.push_back(value(obj));
+                TRACE("z3_replayer_bug", tout << "args after 'P':\n"; display_args(tout); tout << "\n";);
+            }
+            break;
+        }
+        case 'S': {
+            // push string
+            TRACE("z3_replayer", tout << "[" << m_line << "] "  << "S " << m_string.begin() << "\n";);
+            symbol sym(m_string.begin()); // save string
+            m_args.push_back(value(STRING, sym.bare_str()));
+            break;
+        }
+        case 'N':
+            // push null symbol
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "N\n";);
+            m_args.push_back(value(SYMBOL, symbol::null));
+            break;
+        case '$': {
+            // push symbol
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "$ " << m_id << "\n";);
+            m_args.push_back(value(SYMBOL, m_id));
+            break;
+        }
+        case '#': {
+            // push numeral symbol
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "# " << m_uint64 << "\n";);
+            symbol sym(static_cast<unsigned>(m_uint64));
+            m_args.push_back(value(SYMBOL, sym));
+            break;
+        }
+        case 'I':
+            // push integer;
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "I " << m_int64 << "\n";);
+            m_args.push_back(value(INT64, m_int64));
+            break;
+        case 'U':
+            // push unsigned;
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "U " << m_uint64 << "\n";);
+            m_args.push_back(value(UINT64, m_uint64));
+            break;
+        case 'F':
+            // push float
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "F " << m_float << "\n";);
+            m_args.push_back(value(FLOAT, m_float));
+            break;
+        case 'D':
+            // push double
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "D " << m_double << "\n";);
+            m_args.push_back(value(DOUBLE, m_double));
+            break;
+        case 'p':
+        case 's':
+        case 'u':
+        case 'i':
+            // push array
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "A " << m_uint64 << "\n";);
+            if (c == 'p')
+                push_array(static_cast<unsigned>(m_uint64), OBJECT);
+            else if (c == 's')
+                push_array(static_cast<unsigned>(m_uint64), SYMBOL);
+            else if (c == 'i')
+                push_array(static_cast<unsigned>(m_uint64), INT64);
+            else
+                push_array(static_cast<unsigned>(m_uint64), UINT64);
+            break;
+        case 'C': {
+            // call procedure
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "C " << m_uint64 << "\n";);
+            unsigned idx = static_cast<unsigned>(m_uint64);
+            if (idx >= m_cmds.size())
+                throw z3_replayer_exception("invalid command");
+            try {
+                TRACE("z3_replayer_cmd", tout << idx << ":" << m_cmds_names[idx] << "\n";);
+                m_cmds[idx](m_owner);
+            }
+            catch (z3_error & ex) {
+                throw ex;
+            }
+            catch (z3_exception & ex) {
+                std::cout << "[z3 exception]: " << ex.msg() << std::endl;
+            }
+            break;
+        }
+        case '=':
+            // save result
+            // = obj_id
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "= " << m_ptr << "\n";);
+            m_heap.insert(m_ptr, m_result);
+            break;
+        case '*': {
+            // save out
+            // @ obj_id pos
+            unsigned pos = static_cast<unsigned>(m_uint64);
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "* " << m_ptr << " " << pos << "\n";);
+            check_arg(pos, OBJECT);
+            m_heap.insert(m_ptr, m_args[pos].m_obj);
+            break;
+        }
+        case '@': {
+            // save array out
+            // @ obj_id array_pos idx
+            unsigned pos = static_cast<unsigned>(m_uint64);
+            check_arg(pos, OBJECT_ARRAY);
+            unsigned aidx = static_cast<unsigned>(m_args[pos].m_uint);
+            ptr_vector<void> & v = m_obj_arrays[aidx];
+            unsigned idx = static_cast<unsigned>(m_idx);
+            if (idx >= v.size())
+                throw z3_replayer_exception("invalid array index");
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "@ " << m_ptr << " " << pos << " " << idx << "\n";);
+            TRACE("z3_replayer_bug", tout << "v[idx]: " << v[idx] << "\n";);
+            m_heap.insert(m_ptr, v[idx]);
+            break;
+        }
+        case 'M':
+            // user message
+            TRACE("z3_replayer", tout << "[" << m_line << "] " << "M " << m_string.begin() << "\n";);
+            std::cout << m_string.begin() << "\n"; std::cout.flush();
+            break;
+        default:
+            TRACE("z3_replayer", tout << "unknown command " << c << "\n";);
+            throw z3_replayer_exception("unknown log command");
+            break;
+        }
+    }
+
+    void parse_text() {
         while (true) {
-            IF_VERBOSE(1, {
-                counter++; tick++;
-                if (tick >= TICK_FREQUENCY) {
-                    std::cout << "[replayer] " << counter << " operations executed" << std::endl;
-                    tick = 0;
-                }
-            });
+            tick();
             skip_blank();
             int c = curr();
             if (c == EOF)
                 return;
+            next();
             switch (c) {
-            case 'V':
-                // version
-                next(); skip_blank(); read_string();
+            case 'V': case 'S': case 'M':
+                skip_blank(); read_string();
                 break;
-            case 'R':
-                // reset
-                next();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "R\n";);
-                reset();
+            case '$':
+                skip_blank(); read_quoted_symbol();
                 break;
-            case 'P': {
-                // push pointer
-                next(); skip_blank(); read_ptr();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "P " << m_ptr << "\n";);
-                if (m_ptr == 0) {
-                    m_args.push_back(nullptr);
-                }
-                else {
-                    void * obj = nullptr;
-                    if (!m_heap.find(m_ptr, obj))
-                        throw z3_replayer_exception("invalid pointer");
-                    m_args.push_back(value(obj));
-                    TRACE("z3_replayer_bug", tout << "args after 'P':\n"; display_args(tout); tout << "\n";);
-                }
+            case '#': case 'U': case 'C':
+            case 'p': case 's': case 'u': case 'i':
+                skip_blank(); read_uint64();
                 break;
-            }
-            case 'S': {
-                // push string
-                next(); skip_blank(); read_string();
-                TRACE("z3_replayer", tout << "[" << m_line << "] "  << "S " << m_string.begin() << "\n";);
-                symbol sym(m_string.begin()); // save string
-                m_args.push_back(value(STRING, sym.bare_str()));
+            case 'I':
+                skip_blank(); read_int64();
                 break;
-            }
-            case 'N':
-                // push null symbol
-                next();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "N\n";);
-                m_args.push_back(value(SYMBOL, symbol::null));
+            case 'F':
+                skip_blank(); read_float();
                 break;
-            case '$': {
-                // push symbol
-                next(); skip_blank(); read_quoted_symbol();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "$ " << m_id << "\n";);
-                m_args.push_back(value(SYMBOL, m_id));
+            case 'D':
+                skip_blank(); read_double();
                 break;
-            }
-            case '#': {
-                // push numeral symbol
-                next(); skip_blank(); read_uint64();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "# " << m_uint64 << "\n";);
-                symbol sym(static_cast<unsigned>(m_uint64));
-                m_args.push_back(value(SYMBOL, sym));
+            case 'P': case '=':
+                skip_blank(); read_ptr();
                 break;
-            }
-            case 'I':
-                // push integer;
-                next(); skip_blank(); read_int64();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "I " << m_int64 << "\n";);
-                m_args.push_back(value(INT64, m_int64));
+            case '*':
+                skip_blank(); read_ptr(); skip_blank(); read_uint64();
                 break;
-            case 'U':
-                // push unsigned;
-                next(); skip_blank(); read_uint64();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "U " << m_uint64 << "\n";);
-                m_args.push_back(value(UINT64, m_uint64));
+            case '@': {
+                skip_blank(); read_ptr(); skip_blank(); read_uint64();
+                uint64_t pos = m_uint64;
+                skip_blank(); read_uint64();
+                m_idx = m_uint64;
+                m_uint64 = pos;
                 break;
-            case 'F':
-                // push float
-                next(); skip_blank(); read_float();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "F " << m_float << "\n";);
-                m_args.push_back(value(FLOAT, m_float));
+            }
+            default:
                 break;
-            case 'D':
-                // push double
-                next(); skip_blank(); read_double();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "D " << m_double << "\n";);
-                m_args.push_back(value(DOUBLE, m_double));
+            }
+            exec(c);
+        }
+    }
+
+    int get_byte() {
+        int c = m_stream.get();
+        if (c == EOF)
+            throw z3_replayer_exception("unexpected end of file");
+        return c;
+    }
+
+    uint64_t read_varint() {
+        uint64_t r = 0;
+        for (unsigned shift = 0; ; shift += 7) {
+            if (shift >= 64)
+                throw z3_replayer_exception("invalid varint");
+            int c = get_byte();
+            r |= static_cast<uint64_t>(c & 0x7f) << shift;
+            if ((c & 0x80) == 0)
+                return r;
+        }
+    }
+
+    void read_bytes(char* out, size_t n) {
+        if (!m_stream.read(out, n))
+            throw z3_replayer_exception("unexpected end of file");
+    }
+
+    void read_binary_string() {
+        uint64_t n = read_varint();
+        m_string.reset();
+        m_string.resize(static_cast<unsigned>(n) + 1, 0);
+        if (n > 0)
+            read_bytes(m_string.begin(), static_cast<size_t>(n));
+    }
+
+    void parse_binary() {
+        char magic[sizeof(z3_log_binary::log_magic)];
+        magic[0] = static_cast<char>(curr());
+        read_bytes(magic + 1, sizeof(magic) - 1);
+        if (memcmp(magic, z3_log_binary::log_magic, sizeof(magic)) != 0)
+            throw z3_replayer_exception("invalid binary log header");
+        if (read_varint() != z3_log_binary::log_version)
+            throw z3_replayer_exception("unsupported binary log version");
+        while (true) {
+            tick();
+            int c = m_stream.get();
+            if (c == EOF)
+                return;
+            new_line();
+            switch (c) {
+            case 'V': case 'S': case 'M':
+                read_binary_string();
                 break;
-            case 'p':
-            case 's':
-            case 'u':
-            case 'i':
-                // push array
-                next(); skip_blank(); read_uint64();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "A " << m_uint64 << "\n";);
-                if (c == 'p')
-                    push_array(static_cast<unsigned>(m_uint64), OBJECT);
-                else if (c == 's')
-                    push_array(static_cast<unsigned>(m_uint64), SYMBOL);
-                else if (c == 'i')
-                    push_array(static_cast<unsigned>(m_uint64), INT64);
-                else
-                    push_array(static_cast<unsigned>(m_uint64), UINT64);
+            case '$':
+                read_binary_string();
+                m_id = m_string.begin();
                 break;
-            case 'C': {
-                // call procedure
-                next(); skip_blank(); read_uint64();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "C " << m_uint64 << "\n";);
-                unsigned idx = static_cast<unsigned>(m_uint64);
-                if (idx >= m_cmds.size())
-                    throw z3_replayer_exception("invalid command");
-                try {
-                    TRACE("z3_replayer_cmd", tout << idx << ":" << m_cmds_names[idx] << "\n";);
-                    m_cmds[idx](m_owner);
-                }
-                catch (z3_error & ex) {
-                    throw ex;
-                }
-                catch (z3_exception & ex) {
-                    std::cout << "[z3 exception]: " << ex.msg() << std::endl;
-                }
+            case '#': case 'U': case 'C':
+            case 'p': case 's': case 'u': case 'i':
+                m_uint64 = read_varint();
+                break;
+            case 'I': {
+                uint64_t u = read_varint();
+                m_int64 = static_cast<int64_t>(u >> 1) ^ -static_cast<int64_t>(u & 1);
                 break;
             }
-            case '=':
-                // save result
-                // = obj_id
-                next(); skip_blank(); read_ptr();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "= " << m_ptr << "\n";);
-                m_heap.insert(m_ptr, m_result);
+            case 'F':
+                read_bytes(reinterpret_cast<char*>(&m_float), sizeof(float));
                 break;
-            case '*': {
-                // save out
-                // @ obj_id pos
-                next(); skip_blank(); read_ptr(); skip_blank(); read_uint64();
-                unsigned pos = static_cast<unsigned>(m_uint64);
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "* " << m_ptr << " " << pos << "\n";);
-                check_arg(pos, OBJECT);
-                m_heap.insert(m_ptr, m_args[pos].m_obj);
+            case 'D':
+                read_bytes(reinterpret_cast<char*>(&m_double), sizeof(double));
                 break;
-            }
-            case '@': {
-                // save array out
-                // @ obj_id array_pos idx
-                next(); skip_blank(); read_ptr(); skip_blank(); read_uint64();
-                unsigned pos = static_cast<unsigned>(m_uint64);
-                check_arg(pos, OBJECT_ARRAY);
-                unsigned aidx = static_cast<unsigned>(m_args[pos].m_uint);
-                ptr_vector<void> & v = m_obj_arrays[aidx];
-                skip_blank(); read_uint64();
-                unsigned idx = static_cast<unsigned>(m_uint64);
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "@ " << m_ptr << " " << pos << " " << idx << "\n";);
-                TRACE("z3_replayer_bug", tout << "v[idx]: " << v[idx] << "\n";);
-                m_heap.insert(m_ptr, v[idx]);
+            case 'P': case '=':
+                m_ptr = static_cast<size_t>(read_varint());
                 break;
-            }
-            case 'M':
-                // user message
-                next(); skip_blank(); read_string();
-                TRACE("z3_replayer", tout << "[" << m_line << "] " << "M " << m_string.begin() << "\n";);
-                std::cout << m_string.begin() << "\n"; std::cout.flush();
+            case '*':
+                m_ptr = static_cast<size_t>(read_varint());
+                m_uint64 = read_varint();
+                break;
+            case '@':
+                m_ptr = static_cast<size_t>(read_varint());
+                m_uint64 = read_varint();
+                m_idx = read_varint();
                 break;
             default:
-                TRACE("z3_replayer", tout << "unknown command " << c << "\n";);
-                throw z3_replayer_exception("unknown log command");
                 break;
             }
+            exec(c);
         }
     }
 
+    void parse() {
+        memory::exit_when_out_of_memory(false, nullptr);
+        if (curr() == z3_log_binary::log_magic[0])
+            parse_binary();
+        else
+            parse_text();
+    }
+
     int get_int(unsigned pos) const {
         check_arg(pos, INT64);
         return static_cast<int>(m_args[pos].m_int);
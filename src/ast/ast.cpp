@@ -1373,7 +1373,7 @@ decl_plugin * user_sort_plugin::mk_fresh() {
 // -----------------------------------
 
 ast_manager::ast_manager(proof_gen_mode m, char const * trace_file, bool is_format_manager):
-    m_alloc("ast_manager"),
+    m_alloc("ast_manager", true),
     m_expr_array_manager(*this, m_alloc),
     m_expr_dependency_manager(*this, m_alloc),
     m_expr_dependency_array_manager(*this, m_alloc),
@@ -1396,7 +1396,7 @@ ast_manager::ast_manager(proof_gen_mode m, char const * trace_file, bool is_form
 }
 
 ast_manager::ast_manager(proof_gen_mode m, std::fstream * trace_stream, bool is_format_manager):
-    m_alloc("ast_manager"),
+    m_alloc("ast_manager", true),
     m_expr_array_manager(*this, m_alloc),
     m_expr_dependency_manager(*this, m_alloc),
     m_expr_dependency_array_manager(*this, m_alloc),
@@ -1413,7 +1413,7 @@ ast_manager::ast_manager(proof_gen_mode m, std::fstream * trace_stream, bool is_
 }
 
 ast_manager::ast_manager(ast_manager const & src, bool disable_proofs):
-    m_alloc("ast_manager"),
+    m_alloc("ast_manager", true),
     m_expr_array_manager(*this, m_alloc),
     m_expr_dependency_manager(*this, m_alloc),
     m_expr_dependency_array_manager(*this, m_alloc),
@@ -1434,6 +1434,7 @@ void ast_manager::update_fresh_id(ast_manager const& m) {
 
 
 void ast_manager::init() {
+    m_alloc.set_memory_tag(memory::TAG_AST);
     m_int_real_coercions = true;
     m_debug_ref_count = false;
     m_fresh_id = 0;
@@ -1483,6 +1484,8 @@ static void mark_array_ref(ast_mark& mark, unsigned sz, parameter const * a) {
 
 ast_manager::~ast_manager() {
     SASSERT(is_format_manager() || !m_family_manager.has_family(symbol("format")));
+    set_concurrent(false);
+    set_deletion_batch(0);
 
     dec_ref(m_bool_sort);
     dec_ref(m_proof_sort);
@@ -1564,6 +1567,62 @@ ast_manager::~ast_manager() {
         dealloc(m_trace_stream);
         m_trace_stream = nullptr;
     }
+    dealloc(m_concurrent_mux);
+}
+
+void ast_manager::set_concurrent(bool flag) {
+    if (flag == m_concurrent)
+        return;
+    if (flag) {
+        if (!m_concurrent_mux)
+            m_concurrent_mux = alloc(mutex);
+        m_concurrent = true;
+        return;
+    }
+    m_concurrent = false;
+    // A node may have been revived or recorded more than once, 
+    // so the deferred nodes are first pinned and then released.
+    ptr_vector<ast> todo;
+    todo.swap(m_deferred_dels);
+    for (ast* n : todo)
+        n->inc_ref();
+    for (ast* n : todo)
+        dec_ref(n);
+}
+
+void ast_manager::set_deletion_batch(unsigned batch) {
+    m_deletion_batch = batch;
+    if (batch == 0)
+        reclaim_deleted();
+}
+
+void ast_manager::queue_delete_node(ast * n) {
+    // The queue owns a reference, so a node that is revived before it is
+    // reclaimed is not queued a second time when it is released again.
+    n->inc_ref();
+    m_deletion_queue.push_back(n);
+}
+
+unsigned ast_manager::reclaim_deleted(unsigned max_nodes) {
+    flet<bool> _reclaiming(m_reclaiming, true);
+    for (unsigned i = 0; i < max_nodes && !m_deletion_queue.empty(); ++i) {
+        ast * n = m_deletion_queue.back();
+        m_deletion_queue.pop_back();
+        n->dec_ref();
+        if (n->get_ref_count() == 0)
+            delete_node_core(n);
+    }
+    return m_deletion_queue.size();
+}
+
+void ast_manager::defer_delete_node(ast * n) {
+    lock_guard lock(*m_concurrent_mux);
+    m_deferred_dels.push_back(n);
+}
+
+ast * ast_manager::register_node_concurrent(ast * n) {
+    lock_guard lock(*m_concurrent_mux);
+    return register_node_core(n);
 }
 
 void ast_manager::compact_memory() {
@@ -1814,7 +1873,8 @@ ast * ast_manager::register_node_core(ast * n) {
                    << "' and domain, but different range type is not permitted";
             throw ast_exception(buffer.str());
         }
-        deallocate_node(n, ::get_node_size(n));
+        // the allocator is used directly since the concurrent mode lock may be held.
+        m_alloc.deallocate(::get_node_size(n), n);
         return r;
     }
     else {
@@ -1914,6 +1974,16 @@ ast * ast_manager::register_node_core(ast * n) {
 }
 
 void ast_manager::delete_node(ast * n) {
+    if (m_deletion_batch != 0) {
+        queue_delete_node(n);
+        if (!m_reclaiming)
+            reclaim_deleted(m_deletion_batch);
+        return;
+    }
+    delete_node_core(n);
+}
+
+void ast_manager::delete_node_core(ast * n) {
     TRACE("delete_node_bug", tout << mk_ll_pp(n, *this) << "\n";);
 
     SASSERT(m_ast_table.contains(n));
@@ -1927,6 +1997,9 @@ void ast_manager::delete_node(ast * n) {
 
         SASSERT(!m_debug_ref_count || !m_debug_free_indices.contains(n->m_id));
 
+        if (m_proof_listener)
+            m_proof_listener->on_del_ast(n);
+
 #ifdef RECYCLE_FREE_AST_INDICES
         if (!m_debug_ref_count) {
             if (is_decl(n))
@@ -2240,6 +2313,9 @@ app * ast_manager::mk_app_core(func_decl * decl, unsigned num_args, expr * const
             r = register_node(new_node);
         }
 
+        if (m_proof_listener && r == new_node && is_proof(r))
+            m_proof_listener->on_mk_proof(r);
+
         if (m_trace_stream && r == new_node) {
             if (is_proof(r)) {
                 if (decl == mk_func_decl(m_basic_family_id, PR_UNDEF, 0, nullptr, 0, static_cast<expr * const *>(nullptr)))
@@ -46,6 +46,10 @@ Revision History:
 #include "util/z3_exception.h"
 #include "util/dependency.h"
 #include "util/rlimit.h"
+#include "util/mutex.h"
+#if defined(_MSC_VER) && !defined(SINGLE_THREAD)
+#include <intrin.h>
+#endif
 
 #define RECYCLE_FREE_AST_INDICES
 
@@ -488,6 +492,29 @@ protected:
         --m_ref_count;
     }
 
+    // thread-safe reference counting, used by managers in concurrent mode.
+    void inc_ref_concurrent() {
+        SASSERT(m_ref_count < UINT_MAX);
+#if defined(SINGLE_THREAD)
+        m_ref_count++;
+#elif defined(_MSC_VER)
+        _InterlockedIncrement(reinterpret_cast<long volatile*>(&m_ref_count));
+#else
+        __atomic_add_fetch(&m_ref_count, 1, __ATOMIC_RELAXED);
+#endif
+    }
+
+    unsigned dec_ref_concurrent() {
+        SASSERT(m_ref_count > 0);
+#if defined(SINGLE_THREAD)
+        return --m_ref_count;
+#elif defined(_MSC_VER)
+        return static_cast<unsigned>(_InterlockedDecrement(reinterpret_cast<long volatile*>(&m_ref_count)));
+#else
+        return __atomic_sub_fetch(&m_ref_count, 1, __ATOMIC_ACQ_REL);
+#endif
+    }
+
     ast(ast_kind k):m_id(UINT_MAX), m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false), m_ref_count(0) {
         DEBUG_CODE({
             m_mark1_owner = 0;
@@ -1463,6 +1490,19 @@ enum proof_gen_mode {
     PGM_ENABLED
 };
 
+/**
+   \brief Receives the proof objects created by an ast_manager, see
+   ast/proofs/proof_stream.h. The listener is also told about every ast
+   that is deleted, so that it can keep tables of asts without holding
+   references to them.
+*/
+class proof_listener {
+public:
+    virtual ~proof_listener() = default;
+    virtual void on_mk_proof(app * pr) = 0;
+    virtual void on_del_ast(ast * n) = 0;
+};
+
 // -----------------------------------
 //
 // ast_manager
@@ -1551,6 +1591,13 @@ protected:
 #endif
     ast_manager *             m_format_manager; // hack for isolating format objects in a different manager.
     symbol                    m_lambda_def;
+    bool                      m_concurrent { false };
+    mutex *                   m_concurrent_mux { nullptr };
+    ptr_vector<ast>           m_deferred_dels;  // nodes whose reference counter reached 0 in concurrent mode.
+    unsigned                  m_deletion_batch { 0 };
+    bool                      m_reclaiming { false };
+    ptr_vector<ast>           m_deletion_queue; // unreferenced nodes waiting for reclamation, each holds one reference.
+    proof_listener *          m_proof_listener { nullptr };
 
     void init();
 
@@ -1679,14 +1726,66 @@ public:
 
     void debug_ref_count() { m_debug_ref_count = true; }
 
+    /**
+       \brief Enable or disable concurrent mode.
+
+       In concurrent mode, several threads may create and reference count terms in this
+       manager: hash-consing and node allocation are serialized, reference counters are
+       updated atomically, and nodes whose reference counter drops to zero are only 
+       reclaimed when concurrent mode is disabled.
+
+       Decl plugins are not protected, so sorts and declarations used by the threads
+       should be created beforehand. The mode must only be changed when no other thread
+       is using the manager.
+    */
+    void set_concurrent(bool flag);
+
+    /**
+       \brief Bound the work done when reference counters drop to zero.
+
+       When \c batch is not zero, unreferenced nodes are queued instead of being
+       deleted together with all their unreferenced sub-terms. Every time a node
+       is queued at most \c batch queued nodes are reclaimed, and the children of
+       a reclaimed node are queued in turn. Releasing a large term, goal or scope
+       thus costs \c batch deletions per reference released, the rest is left
+       for later releases or for explicit calls to \c reclaim_deleted.
+       Setting \c batch to zero reclaims all queued nodes.
+
+       Queued nodes stay in the hash-consing table (and are counted by
+       \c get_num_asts) until they are reclaimed, so they are reused if an
+       equal term is created in the meantime.
+    */
+    void set_deletion_batch(unsigned batch);
+    unsigned get_deletion_batch() const { return m_deletion_batch; }
+
+    /**
+       \brief Reclaim at most \c max_nodes queued nodes. Return the number of
+       nodes still queued.
+    */
+    unsigned reclaim_deleted(unsigned max_nodes = UINT_MAX);
+    unsigned get_num_queued_deletions() const { return m_deletion_queue.size(); }
+
+    void set_proof_listener(proof_listener * l) { m_proof_listener = l; }
+    proof_listener * get_proof_listener() const { return m_proof_listener; }
+
+    bool is_concurrent() const { return m_concurrent; }
+
     void inc_ref(ast* n) {
         if (n) {
-            n->inc_ref();
+            if (m_concurrent)
+                n->inc_ref_concurrent();
+            else
+                n->inc_ref();
         }
     }
     
     void dec_ref(ast* n) {
         if (n) {
+            if (m_concurrent) {
+                if (n->dec_ref_concurrent() == 0)
+                    defer_delete_node(n);
+                return;
+            }
             n->dec_ref();
             if (n->get_ref_count() == 0)
                 delete_node(n);
@@ -1718,18 +1817,35 @@ public:
 protected:
     ast * register_node_core(ast * n);
 
+    ast * register_node_concurrent(ast * n);
+
     template<typename T>
     T * register_node(T * n) {
-        return static_cast<T *>(register_node_core(n));
+        return static_cast<T *>(m_concurrent ? register_node_concurrent(n) : register_node_core(n));
     }
 
     void delete_node(ast * n);
 
+    void delete_node_core(ast * n);
+
+    void queue_delete_node(ast * n);
+
+    void defer_delete_node(ast * n);
+
     void * allocate_node(unsigned size) {
+        if (m_concurrent) {
+            lock_guard lock(*m_concurrent_mux);
+            return m_alloc.allocate(size);
+        }
         return m_alloc.allocate(size);
     }
 
     void deallocate_node(ast * n, unsigned sz) {
+        if (m_concurrent) {
+            lock_guard lock(*m_concurrent_mux);
+            m_alloc.deallocate(sz, n);
+            return;
+        }
         m_alloc.deallocate(sz, n);
     }
 
@@ -2405,7 +2521,10 @@ private:
     void push_dec_ref(ast * n) {
         n->dec_ref();
         if (n->get_ref_count() == 0) {
-            m_ast_table.push_erase(n);
+            if (m_deletion_batch != 0)
+                queue_delete_node(n);
+            else
+                m_ast_table.push_erase(n);
         }
     }
 
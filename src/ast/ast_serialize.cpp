@@ -0,0 +1,549 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_serialize.cpp
+
+Abstract:
+
+    Binary serialization of expressions.
+
+--*/
+#include <cstring>
+#include "ast/ast_serialize.h"
+
+namespace {
+    const char     magic[4] = { 'Z', '3', 'A', 'B' };
+    const unsigned version = 1;
+
+    enum record_tag {
+        tag_end, tag_sort, tag_decl, tag_app, tag_var, tag_quantifier, tag_root
+    };
+
+    // symbol references: 0 is the null symbol, 1 and 2 introduce a new string
+    // or numerical symbol, and k + 3 refers to the k-th symbol of the stream.
+    enum symbol_tag {
+        sym_null, sym_string, sym_num, sym_ref
+    };
+
+    enum sort_size_tag {
+        size_finite, size_very_big, size_infinite
+    };
+
+    const unsigned num_decl_flags = 9;
+}
+
+ast_binary_writer::ast_binary_writer(ast_manager& m, std::ostream& out):
+    m(m),
+    m_out(out),
+    m_pinned(m) {
+    m_out.write(magic, sizeof(magic));
+    write_uint(version);
+}
+
+void ast_binary_writer::write_uint(uint64_t n) {
+    while (n >= 0x80) {
+        m_out.put(static_cast<char>((n & 0x7F) | 0x80));
+        n >>= 7;
+    }
+    m_out.put(static_cast<char>(n));
+}
+
+void ast_binary_writer::write_int(int64_t n) {
+    // zig-zag encoding keeps small negative numbers short
+    write_uint((static_cast<uint64_t>(n) << 1) ^ static_cast<uint64_t>(n >> 63));
+}
+
+void ast_binary_writer::write_string(std::string const& s) {
+    write_uint(s.size());
+    m_out.write(s.c_str(), s.size());
+}
+
+void ast_binary_writer::write_symbol(symbol const& s) {
+    unsigned idx;
+    if (s.is_null()) {
+        write_uint(sym_null);
+    }
+    else if (m_symbols.find(s, idx)) {
+        write_uint(sym_ref + idx);
+    }
+    else {
+        m_symbols.insert(s, m_symbols.size());
+        if (s.is_numerical()) {
+            write_uint(sym_num);
+            write_uint(s.get_num());
+        }
+        else {
+            write_uint(sym_string);
+            write_string(s.bare_str());
+        }
+    }
+}
+
+void ast_binary_writer::write_family(family_id fid) {
+    write_symbol(fid == null_family_id ? symbol::null : m.get_family_name(fid));
+}
+
+void ast_binary_writer::write_ref(ast* a) {
+    write_uint(m_ids[a]);
+}
+
+void ast_binary_writer::write_parameter(parameter const& p) {
+    write_uint(p.get_kind());
+    switch (p.get_kind()) {
+    case parameter::PARAM_INT:
+        write_int(p.get_int());
+        break;
+    case parameter::PARAM_AST:
+        write_ref(p.get_ast());
+        break;
+    case parameter::PARAM_SYMBOL:
+        write_symbol(p.get_symbol());
+        break;
+    case parameter::PARAM_RATIONAL:
+        write_string(p.get_rational().to_string());
+        break;
+    case parameter::PARAM_DOUBLE: {
+        double d = p.get_double();
+        char buffer[sizeof(double)];
+        memcpy(buffer, &d, sizeof(double));
+        m_out.write(buffer, sizeof(double));
+        break;
+    }
+    case parameter::PARAM_EXTERNAL:
+        throw default_exception("binary serialization does not support external parameters");
+    }
+}
+
+void ast_binary_writer::write_parameters(decl* d) {
+    write_uint(d->get_num_parameters());
+    for (parameter const& p : d->parameters())
+        write_parameter(p);
+}
+
+void ast_binary_writer::push_parameters(decl* d) {
+    for (parameter const& p : d->parameters())
+        if (p.is_ast() && !m_ids.contains(p.get_ast()))
+            m_todo.push_back(p.get_ast());
+}
+
+void ast_binary_writer::push_children(ast* n) {
+    switch (n->get_kind()) {
+    case AST_SORT:
+        push_parameters(to_sort(n));
+        break;
+    case AST_FUNC_DECL: {
+        func_decl* f = to_func_decl(n);
+        push_parameters(f);
+        for (sort* s : *f)
+            if (!m_ids.contains(s)) m_todo.push_back(s);
+        if (!m_ids.contains(f->get_range()))
+            m_todo.push_back(f->get_range());
+        break;
+    }
+    case AST_APP: {
+        app* a = to_app(n);
+        if (!m_ids.contains(a->get_decl()))
+            m_todo.push_back(a->get_decl());
+        for (expr* arg : *a)
+            if (!m_ids.contains(arg)) m_todo.push_back(arg);
+        break;
+    }
+    case AST_VAR:
+        if (!m_ids.contains(to_var(n)->get_sort()))
+            m_todo.push_back(to_var(n)->get_sort());
+        break;
+    case AST_QUANTIFIER: {
+        quantifier* q = to_quantifier(n);
+        for (unsigned i = 0; i < q->get_num_decls(); ++i)
+            if (!m_ids.contains(q->get_decl_sort(i))) m_todo.push_back(q->get_decl_sort(i));
+        for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+            if (!m_ids.contains(q->get_pattern(i))) m_todo.push_back(q->get_pattern(i));
+        for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+            if (!m_ids.contains(q->get_no_pattern(i))) m_todo.push_back(q->get_no_pattern(i));
+        if (!m_ids.contains(q->get_expr()))
+            m_todo.push_back(q->get_expr());
+        break;
+    }
+    }
+}
+
+void ast_binary_writer::write_ast(ast* n) {
+    switch (n->get_kind()) {
+    case AST_SORT: {
+        sort* s = to_sort(n);
+        sort_info* info = s->get_info();
+        write_uint(tag_sort);
+        write_symbol(s->get_name());
+        write_uint(info != nullptr);
+        if (info) {
+            write_family(info->get_family_id());
+            write_uint(info->get_decl_kind());
+            sort_size const& sz = info->get_num_elements();
+            if (sz.is_infinite())
+                write_uint(size_infinite);
+            else if (sz.is_very_big())
+                write_uint(size_very_big);
+            else {
+                write_uint(size_finite);
+                write_uint(sz.size());
+            }
+            write_uint(s->private_parameters());
+            write_parameters(s);
+        }
+        break;
+    }
+    case AST_FUNC_DECL: {
+        func_decl* f = to_func_decl(n);
+        func_decl_info* info = f->get_info();
+        write_uint(tag_decl);
+        write_symbol(f->get_name());
+        write_uint(f->get_arity());
+        for (sort* s : *f)
+            write_ref(s);
+        write_ref(f->get_range());
+        write_uint(info != nullptr);
+        if (info) {
+            write_family(info->get_family_id());
+            write_uint(info->get_decl_kind());
+            bool flags[num_decl_flags] = {
+                info->is_left_associative(), info->is_right_associative(), info->is_flat_associative(),
+                info->is_commutative(), info->is_chainable(), info->is_pairwise(),
+                info->is_injective(), info->is_skolem(), info->is_idempotent()
+            };
+            unsigned mask = 0;
+            for (unsigned i = 0; i < num_decl_flags; ++i)
+                if (flags[i]) mask |= (1u << i);
+            write_uint(mask);
+            write_parameters(f);
+        }
+        break;
+    }
+    case AST_APP: {
+        app* a = to_app(n);
+        write_uint(tag_app);
+        write_ref(a->get_decl());
+        write_uint(a->get_num_args());
+        for (expr* arg : *a)
+            write_ref(arg);
+        break;
+    }
+    case AST_VAR:
+        write_uint(tag_var);
+        write_uint(to_var(n)->get_idx());
+        write_ref(to_var(n)->get_sort());
+        break;
+    case AST_QUANTIFIER: {
+        quantifier* q = to_quantifier(n);
+        write_uint(tag_quantifier);
+        write_uint(q->get_kind());
+        write_uint(q->get_num_decls());
+        for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+            write_symbol(q->get_decl_name(i));
+            write_ref(q->get_decl_sort(i));
+        }
+        write_int(q->get_weight());
+        write_symbol(q->get_qid());
+        write_symbol(q->get_skid());
+        write_uint(q->get_num_patterns());
+        for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+            write_ref(q->get_pattern(i));
+        write_uint(q->get_num_no_patterns());
+        for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+            write_ref(q->get_no_pattern(i));
+        write_ref(q->get_expr());
+        break;
+    }
+    }
+    m_ids.insert(n, m_pinned.size());
+    m_pinned.push_back(n);
+}
+
+void ast_binary_writer::visit(ast* n) {
+    m_todo.push_back(n);
+    while (!m_todo.empty()) {
+        ast* a = m_todo.back();
+        if (m_ids.contains(a)) {
+            m_todo.pop_back();
+            continue;
+        }
+        unsigned sz = m_todo.size();
+        push_children(a);
+        if (sz == m_todo.size()) {
+            m_todo.pop_back();
+            write_ast(a);
+        }
+    }
+}
+
+void ast_binary_writer::operator()(expr* e) {
+    SASSERT(!m_finished);
+    visit(e);
+    write_uint(tag_root);
+    write_ref(e);
+}
+
+void ast_binary_writer::finish() {
+    if (m_finished)
+        return;
+    m_finished = true;
+    write_uint(tag_end);
+    m_out.flush();
+}
+
+ast_binary_reader::ast_binary_reader(ast_manager& m, std::istream& in):
+    m(m),
+    m_in(in),
+    m_asts(m) {
+    char header[sizeof(magic)];
+    m_in.read(header, sizeof(magic));
+    if (m_in.gcount() != sizeof(magic) || memcmp(header, magic, sizeof(magic)) != 0)
+        throw default_exception("input is not a binary serialized expression");
+    uint64_t v = read_uint();
+    if (v != version)
+        throw default_exception("unsupported version of binary serialized expression");
+}
+
+uint64_t ast_binary_reader::read_uint() {
+    uint64_t r = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        int c = m_in.get();
+        if (c == EOF)
+            throw default_exception("unexpected end of binary serialized expression");
+        r |= static_cast<uint64_t>(c & 0x7F) << shift;
+        if ((c & 0x80) == 0)
+            return r;
+    }
+    throw default_exception("malformed integer in binary serialized expression");
+}
+
+int64_t ast_binary_reader::read_int() {
+    uint64_t n = read_uint();
+    return static_cast<int64_t>(n >> 1) ^ -static_cast<int64_t>(n & 1);
+}
+
+unsigned ast_binary_reader::read_unsigned() {
+    uint64_t n = read_uint();
+    if (n > UINT_MAX)
+        throw default_exception("integer out of range in binary serialized expression");
+    return static_cast<unsigned>(n);
+}
+
+std::string ast_binary_reader::read_string() {
+    unsigned sz = read_unsigned();
+    std::string s(sz, 0);
+    m_in.read(&s[0], sz);
+    if (static_cast<unsigned>(m_in.gcount()) != sz)
+        throw default_exception("unexpected end of binary serialized expression");
+    return s;
+}
+
+symbol ast_binary_reader::read_symbol() {
+    unsigned n = read_unsigned();
+    switch (n) {
+    case sym_null:
+        return symbol::null;
+    case sym_string:
+        m_symbols.push_back(symbol(read_string().c_str()));
+        return m_symbols.back();
+    case sym_num:
+        m_symbols.push_back(symbol(read_unsigned()));
+        return m_symbols.back();
+    default:
+        n -= sym_ref;
+        if (n >= m_symbols.size())
+            throw default_exception("invalid symbol reference in binary serialized expression");
+        return m_symbols[n];
+    }
+}
+
+ast* ast_binary_reader::read_ref() {
+    unsigned n = read_unsigned();
+    if (n >= m_asts.size())
+        throw default_exception("invalid reference in binary serialized expression");
+    return m_asts.get(n);
+}
+
+sort* ast_binary_reader::read_sort_ref() {
+    ast* a = read_ref();
+    if (!is_sort(a))
+        throw default_exception("sort expected in binary serialized expression");
+    return to_sort(a);
+}
+
+expr* ast_binary_reader::read_expr_ref() {
+    ast* a = read_ref();
+    if (!is_expr(a))
+        throw default_exception("expression expected in binary serialized expression");
+    return to_expr(a);
+}
+
+family_id ast_binary_reader::read_family() {
+    symbol name = read_symbol();
+    if (name.is_null())
+        return null_family_id;
+    family_id fid = m.get_family_id(name);
+    if (fid == null_family_id)
+        throw default_exception(std::string("unknown theory ") + name.str() + " in binary serialized expression");
+    return fid;
+}
+
+void ast_binary_reader::read_parameters(vector<parameter>& ps) {
+    unsigned n = read_unsigned();
+    for (unsigned i = 0; i < n; ++i) {
+        switch (read_unsigned()) {
+        case parameter::PARAM_INT:
+            ps.push_back(parameter(static_cast<int>(read_int())));
+            break;
+        case parameter::PARAM_AST:
+            ps.push_back(parameter(read_ref()));
+            break;
+        case parameter::PARAM_SYMBOL:
+            ps.push_back(parameter(read_symbol()));
+            break;
+        case parameter::PARAM_RATIONAL:
+            ps.push_back(parameter(rational(read_string().c_str())));
+            break;
+        case parameter::PARAM_DOUBLE: {
+            char buffer[sizeof(double)];
+            m_in.read(buffer, sizeof(double));
+            if (m_in.gcount() != sizeof(double))
+                throw default_exception("unexpected end of binary serialized expression");
+            double d;
+            memcpy(&d, buffer, sizeof(double));
+            ps.push_back(parameter(d));
+            break;
+        }
+        default:
+            throw default_exception("invalid parameter in binary serialized expression");
+        }
+    }
+}
+
+void ast_binary_reader::read_sort() {
+    symbol name = read_symbol();
+    sort* s = nullptr;
+    if (read_unsigned() == 0) {
+        s = m.mk_uninterpreted_sort(name);
+    }
+    else {
+        family_id fid = read_family();
+        decl_kind k = read_unsigned();
+        sort_size sz;
+        switch (read_unsigned()) {
+        case size_finite:   sz = sort_size::mk_finite(read_uint()); break;
+        case size_very_big: sz = sort_size::mk_very_big(); break;
+        case size_infinite: sz = sort_size::mk_infinite(); break;
+        default: throw default_exception("invalid sort size in binary serialized expression");
+        }
+        bool private_parameters = read_unsigned() != 0;
+        vector<parameter> ps;
+        read_parameters(ps);
+        if (fid == m.get_user_sort_family_id())
+            s = m.mk_uninterpreted_sort(name, ps.size(), ps.c_ptr());
+        else
+            s = m.mk_sort(name, sort_info(fid, k, sz, ps.size(), ps.c_ptr(), private_parameters));
+    }
+    m_asts.push_back(s);
+}
+
+void ast_binary_reader::read_decl() {
+    symbol name = read_symbol();
+    unsigned arity = read_unsigned();
+    ptr_vector<sort> domain;
+    for (unsigned i = 0; i < arity; ++i)
+        domain.push_back(read_sort_ref());
+    sort* range = read_sort_ref();
+    func_decl* f = nullptr;
+    if (read_unsigned() == 0) {
+        f = m.mk_func_decl(name, arity, domain.c_ptr(), range);
+    }
+    else {
+        family_id fid = read_family();
+        decl_kind k = read_unsigned();
+        unsigned mask = read_unsigned();
+        vector<parameter> ps;
+        read_parameters(ps);
+        func_decl_info info(fid, k, ps.size(), ps.c_ptr());
+        info.set_left_associative((mask & (1u << 0)) != 0);
+        info.set_right_associative((mask & (1u << 1)) != 0);
+        info.set_flat_associative((mask & (1u << 2)) != 0);
+        info.set_commutative((mask & (1u << 3)) != 0);
+        info.set_chainable((mask & (1u << 4)) != 0);
+        info.set_pairwise((mask & (1u << 5)) != 0);
+        info.set_injective((mask & (1u << 6)) != 0);
+        info.set_skolem((mask & (1u << 7)) != 0);
+        info.set_idempotent((mask & (1u << 8)) != 0);
+        f = m.mk_func_decl(name, arity, domain.c_ptr(), range, info);
+    }
+    m_asts.push_back(f);
+}
+
+void ast_binary_reader::read_app() {
+    ast* d = read_ref();
+    if (!is_func_decl(d))
+        throw default_exception("declaration expected in binary serialized expression");
+    func_decl* f = to_func_decl(d);
+    unsigned n = read_unsigned();
+    ptr_vector<expr> args;
+    for (unsigned i = 0; i < n; ++i)
+        args.push_back(read_expr_ref());
+    m_asts.push_back(m.mk_app(f, n, args.c_ptr()));
+}
+
+void ast_binary_reader::read_var() {
+    unsigned idx = read_unsigned();
+    m_asts.push_back(m.mk_var(idx, read_sort_ref()));
+}
+
+void ast_binary_reader::read_quantifier() {
+    unsigned k = read_unsigned();
+    if (k > lambda_k)
+        throw default_exception("invalid quantifier in binary serialized expression");
+    unsigned num_decls = read_unsigned();
+    ptr_vector<sort> sorts;
+    svector<symbol> names;
+    for (unsigned i = 0; i < num_decls; ++i) {
+        names.push_back(read_symbol());
+        sorts.push_back(read_sort_ref());
+    }
+    int weight = static_cast<int>(read_int());
+    symbol qid = read_symbol();
+    symbol skid = read_symbol();
+    ptr_vector<expr> patterns, no_patterns;
+    unsigned n = read_unsigned();
+    for (unsigned i = 0; i < n; ++i)
+        patterns.push_back(read_expr_ref());
+    n = read_unsigned();
+    for (unsigned i = 0; i < n; ++i)
+        no_patterns.push_back(read_expr_ref());
+    expr* body = read_expr_ref();
+    quantifier* q = nullptr;
+    if (k == lambda_k)
+        q = m.mk_lambda(num_decls, sorts.c_ptr(), names.c_ptr(), body);
+    else
+        q = m.mk_quantifier(static_cast<quantifier_kind>(k), num_decls, sorts.c_ptr(), names.c_ptr(), body,
+                            weight, qid, skid, patterns.size(), patterns.c_ptr(), no_patterns.size(), no_patterns.c_ptr());
+    m_asts.push_back(q);
+}
+
+bool ast_binary_reader::operator()(expr_ref& result) {
+    while (true) {
+        if (m_in.peek() == EOF)
+            return false;
+        switch (read_unsigned()) {
+        case tag_end:    return false;
+        case tag_sort:   read_sort(); break;
+        case tag_decl:   read_decl(); break;
+        case tag_app:    read_app(); break;
+        case tag_var:    read_var(); break;
+        case tag_quantifier: read_quantifier(); break;
+        case tag_root:
+            result = read_expr_ref();
+            return true;
+        default:
+            throw default_exception("invalid record in binary serialized expression");
+        }
+    }
+}
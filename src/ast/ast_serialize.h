@@ -0,0 +1,107 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_serialize.h
+
+Abstract:
+
+    Binary serialization of expressions.
+
+    The format is a versioned stream of records. Every sort, declaration
+    and expression is written once, and later records refer to it by its
+    position in the stream, so sharing is preserved. Symbols are defined
+    inline the first time they are used and referenced by index afterwards.
+    Integers are written as LEB128 varints.
+
+    Both classes are streaming: a writer can be fed many roots that share
+    sub-terms, and a reader returns the roots in order.
+
+Notes:
+
+    Parameters of kind PARAM_EXTERNAL (e.g., floating point and algebraic
+    numerals) are not supported. Datatype sorts must be declared in the
+    manager that reads the stream.
+
+--*/
+#pragma once
+
+#include <iostream>
+#include "ast/ast.h"
+#include "util/obj_hashtable.h"
+
+class ast_binary_writer {
+    ast_manager&           m;
+    std::ostream&          m_out;
+    obj_map<ast, unsigned> m_ids;
+    map<symbol, unsigned, symbol_hash_proc, symbol_eq_proc> m_symbols;
+    ast_ref_vector         m_pinned;
+    ptr_vector<ast>        m_todo;
+    bool                   m_finished { false };
+
+    void write_uint(uint64_t n);
+    void write_int(int64_t n);
+    void write_string(std::string const& s);
+    void write_symbol(symbol const& s);
+    void write_family(family_id fid);
+    void write_ref(ast* a);
+    void write_parameter(parameter const& p);
+    void write_parameters(decl* d);
+    void push_parameters(decl* d);
+    void push_children(ast* n);
+    void write_ast(ast* n);
+    void visit(ast* n);
+
+public:
+    ast_binary_writer(ast_manager& m, std::ostream& out);
+
+    ~ast_binary_writer() { finish(); }
+
+    /**
+       \brief write e, preceded by the sub-terms that were not written before.
+    */
+    void operator()(expr* e);
+
+    /**
+       \brief write the end marker. No roots can be added afterwards.
+    */
+    void finish();
+};
+
+class ast_binary_reader {
+    ast_manager&     m;
+    std::istream&    m_in;
+    ast_ref_vector   m_asts;
+    vector<symbol>   m_symbols;
+
+    uint64_t read_uint();
+    int64_t read_int();
+    unsigned read_unsigned();
+    std::string read_string();
+    symbol read_symbol();
+    ast* read_ref();
+    sort* read_sort_ref();
+    expr* read_expr_ref();
+    family_id read_family();
+    void read_parameters(vector<parameter>& ps);
+    void read_sort();
+    void read_decl();
+    void read_app();
+    void read_var();
+    void read_quantifier();
+
+public:
+    /**
+       \brief check the header of the stream. Throws default_exception if the
+       input is not in the binary format or uses an unsupported version.
+    */
+    ast_binary_reader(ast_manager& m, std::istream& in);
+
+    /**
+       \brief read the next root. Returns false when the end of the stream is reached.
+       Throws default_exception on malformed input.
+    */
+    bool operator()(expr_ref& result);
+};
+
@@ -36,23 +36,27 @@ namespace euf {
     const theory_id null_theory_id = -1;
 
     class enode {
-        expr* m_expr{ nullptr };
+        // Fields used by find, merge and congruence checking come first so they
+        // share a cache line. Fields only used for explanations, theory
+        // variables and proof production follow.
+        enode*        m_root{ nullptr };
+        enode*        m_next{ nullptr };
+        expr*         m_expr{ nullptr };
+        unsigned      m_class_size{ 1 };
+        unsigned      m_num_args{ 0 };
+        unsigned      m_table_id{ UINT_MAX };
         bool          m_mark1{ false };
         bool          m_mark2{ false };
         bool          m_commutative{ false };
         bool          m_update_children{ false };
         bool          m_interpreted{ false };
         bool          m_merge_enabled{ true };
-        unsigned      m_class_size{ 1 };
-        unsigned      m_table_id{ UINT_MAX };
         enode_vector  m_parents;
-        enode* m_next{ nullptr };
-        enode* m_root{ nullptr };
-        enode* m_target{ nullptr };
-        th_var_list   m_th_vars;
+        // cold fields
+        enode*        m_target{ nullptr };
         justification m_justification;
-        unsigned      m_num_args{ 0 };
-        enode* m_args[0];
+        th_var_list   m_th_vars;
+        enode*        m_args[0];
 
         friend class enode_args;
         friend class enode_parents;
@@ -684,6 +684,38 @@ void fpa2bv_converter::mk_add(sort * s, expr_ref & rm, expr_ref & x, expr_ref &
     TRACE("fpa2bv_add", tout << "ADD = " << mk_ismt2_pp(result, m) << std::endl; );
 }
 
+/**
+   \brief convert the arithmetic operation f on the converted arguments.
+   Occurrences with the same format, rounding mode and arguments share
+   one circuit; the arguments of fp.add and fp.mul and the factors of
+   fp.fma are ordered first, so commuted occurrences share it as well.
+*/
+void fpa2bv_converter::mk_shared_op(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+    ptr_buffer<expr> sargs;
+    sargs.append(num, args);
+    decl_kind k = f->get_decl_kind();
+    if ((k == OP_FPA_ADD || k == OP_FPA_MUL || k == OP_FPA_FMA) && sargs[1]->get_id() > sargs[2]->get_id())
+        std::swap(sargs[1], sargs[2]);
+    app_ref key(m.mk_app(f, num, sargs.c_ptr()), m);
+    expr * r = nullptr;
+    if (m_op_cache.find(key, r)) {
+        result = r;
+        return;
+    }
+    switch (k) {
+    case OP_FPA_ADD: mk_add(f, num, sargs.c_ptr(), result); break;
+    case OP_FPA_SUB: mk_sub(f, num, sargs.c_ptr(), result); break;
+    case OP_FPA_MUL: mk_mul(f, num, sargs.c_ptr(), result); break;
+    case OP_FPA_DIV: mk_div(f, num, sargs.c_ptr(), result); break;
+    case OP_FPA_FMA: mk_fma(f, num, sargs.c_ptr(), result); break;
+    case OP_FPA_SQRT: mk_sqrt(f, num, sargs.c_ptr(), result); break;
+    default: UNREACHABLE();
+    }
+    m.inc_ref(key);
+    m.inc_ref(result);
+    m_op_cache.insert(key, result);
+}
+
 void fpa2bv_converter::mk_sub(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
     SASSERT(num == 3);
     expr_ref rm(m), x(m), y(m);
@@ -4238,6 +4270,7 @@ void fpa2bv_converter::reset() {
         m.dec_ref(kv.m_value.first);
         m.dec_ref(kv.m_value.second);
     }
+    dec_ref_map_key_values(m, m_op_cache);
     m_uf2bvuf.reset();
     m_min_max_ufs.reset();
     m_extra_assertions.reset();
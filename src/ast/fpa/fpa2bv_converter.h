@@ -53,6 +53,7 @@ protected:
     const2bv_t                 m_rm_const2bv;
     uf2bvuf_t                  m_uf2bvuf;
     special_t                  m_min_max_ufs;
+    obj_map<app, expr*>        m_op_cache;    // canonical operation on converted arguments -> circuit
 
     friend class fpa2bv_model_converter;
     friend class bv2fpa_converter;
@@ -106,6 +107,7 @@ public:
     void mk_sqrt(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_round_to_integral(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_abs(sort * s, expr_ref & x, expr_ref & result);
+    void mk_shared_op(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
 
     void mk_float_eq(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
     void mk_float_lt(func_decl * f, unsigned num, expr * const * args, expr_ref & result);
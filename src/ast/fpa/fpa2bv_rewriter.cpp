@@ -115,17 +115,17 @@ br_status fpa2bv_rewriter_cfg::reduce_app(func_decl * f, unsigned num, expr * co
         case OP_FPA_PLUS_ZERO: m_conv.mk_pzero(f, result); return BR_DONE;
         case OP_FPA_MINUS_ZERO: m_conv.mk_nzero(f, result); return BR_DONE;
         case OP_FPA_NAN: m_conv.mk_nan(f, result); return BR_DONE;
-        case OP_FPA_ADD: m_conv.mk_add(f, num, args, result); return BR_DONE;
-        case OP_FPA_SUB: m_conv.mk_sub(f, num, args, result); return BR_DONE;
+        case OP_FPA_ADD: m_conv.mk_shared_op(f, num, args, result); return BR_DONE;
+        case OP_FPA_SUB: m_conv.mk_shared_op(f, num, args, result); return BR_DONE;
         case OP_FPA_NEG: m_conv.mk_neg(f, num, args, result); return BR_DONE;
-        case OP_FPA_MUL: m_conv.mk_mul(f, num, args, result); return BR_DONE;
-        case OP_FPA_DIV: m_conv.mk_div(f, num, args, result); return BR_DONE;
+        case OP_FPA_MUL: m_conv.mk_shared_op(f, num, args, result); return BR_DONE;
+        case OP_FPA_DIV: m_conv.mk_shared_op(f, num, args, result); return BR_DONE;
         case OP_FPA_REM: m_conv.mk_rem(f, num, args, result); return BR_DONE;
         case OP_FPA_ABS: m_conv.mk_abs(f, num, args, result); return BR_DONE;
         case OP_FPA_MIN: m_conv.mk_min(f, num, args, result); return BR_DONE;
         case OP_FPA_MAX: m_conv.mk_max(f, num, args, result); return BR_DONE;
-        case OP_FPA_FMA: m_conv.mk_fma(f, num, args, result); return BR_DONE;
-        case OP_FPA_SQRT: m_conv.mk_sqrt(f, num, args, result); return BR_DONE;
+        case OP_FPA_FMA: m_conv.mk_shared_op(f, num, args, result); return BR_DONE;
+        case OP_FPA_SQRT: m_conv.mk_shared_op(f, num, args, result); return BR_DONE;
         case OP_FPA_ROUND_TO_INTEGRAL: m_conv.mk_round_to_integral(f, num, args, result); return BR_DONE;
         case OP_FPA_EQ: m_conv.mk_float_eq(f, num, args, result); return BR_DONE;
         case OP_FPA_LT: m_conv.mk_float_lt(f, num, args, result); return BR_DONE;
@@ -10,6 +10,9 @@ Copyright (c) 2015 Microsoft Corporation
 #include "ast/arith_decl_plugin.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/rewriter/var_subst.h"
+#include "ast/ast_translation.h"
+#include "util/parallel_executor.h"
+#include "util/scoped_ptr_vector.h"
 
 #define IS_EQUIV(_e_) m.is_eq(_e_)
 
@@ -83,7 +86,7 @@ void proof_checker::hyp_decl_plugin::get_sort_names(svector<builtin_name> & sort
     }
 }
 
-proof_checker::proof_checker(ast_manager& m) : m(m), m_todo(m), m_marked(), m_pinned(m), m_nil(m),
+proof_checker::proof_checker(ast_manager& m) : m(m), m_todo(m), m_marked(), m_pinned(m), m_checked_pinned(m), m_nil(m),
                                                m_dump_lemmas(false), m_logic("AUFLIRA"), m_proof_lemma_id(0) {
     symbol fam_name("proof_hypothesis");
     if (!m.has_plugin(fam_name)) {
@@ -96,18 +99,24 @@ proof_checker::proof_checker(ast_manager& m) : m(m), m_todo(m), m_marked(), m_pi
 
 bool proof_checker::check(proof* p, expr_ref_vector& side_conditions) {
     proof_ref curr(m);
+    ptr_vector<proof> visited;
     m_todo.push_back(p);
 
     bool result = true;
     while (result && !m_todo.empty()) {
         curr = m_todo.back();
         m_todo.pop_back();
+        if (m_checked.is_marked(curr))
+            continue;
+        visited.push_back(curr);
         result = check1(curr.get(), side_conditions);
         if (!result) {
             IF_VERBOSE(0, ast_ll_pp(verbose_stream() << "Proof check failed\n", m, curr.get()););
             UNREACHABLE();
         }
     }
+    if (result)
+        mark_checked(visited);
 
     m_hypotheses.reset();
     m_pinned.reset();
@@ -117,6 +126,151 @@ bool proof_checker::check(proof* p, expr_ref_vector& side_conditions) {
     return result;
 }
 
+void proof_checker::mark_checked(ptr_vector<proof> const& steps) {
+    for (proof* s : steps) {
+        if (!m_checked.is_marked(s)) {
+            m_checked.mark(s, true);
+            m_checked_pinned.push_back(s);
+        }
+    }
+}
+
+bool proof_checker::check_parallel(proof* p, expr_ref_vector& side_conditions, unsigned num_threads) {
+    // collect the steps to check, premises before the steps using them.
+    ptr_vector<proof> steps, todo;
+    expr_mark visited;
+    todo.push_back(p);
+    while (!todo.empty()) {
+        proof* q = todo.back();
+        if (visited.is_marked(q) || m_checked.is_marked(q)) {
+            todo.pop_back();
+            continue;
+        }
+        bool ready = true;
+        for (unsigned i = 0; i < m.get_num_parents(q); ++i) {
+            proof* r = m.get_parent(q, i);
+            if (!visited.is_marked(r) && !m_checked.is_marked(r)) {
+                todo.push_back(r);
+                ready = false;
+            }
+        }
+        if (ready) {
+            todo.pop_back();
+            visited.mark(q, true);
+            steps.push_back(q);
+        }
+    }
+    // parallel checking pays off only if each thread gets a fair number of steps.
+    num_threads = std::min(num_threads, steps.size() / 64);
+    if (num_threads <= 1 || m_dump_lemmas)
+        return check(p, side_conditions);
+
+    // the hypotheses of the premises are computed up front, as they depend on the whole subproof.
+    expr_ref_vector ante(m);
+    for (proof* q : steps) {
+        for (unsigned i = 0; i < m.get_num_parents(q); ++i) {
+            proof* r = m.get_parent(q, i);
+            if (!m_hypotheses.contains(r)) {
+                ante.reset();
+                get_hypotheses(r, ante);
+            }
+        }
+        expr* h = mk_step_hyps(q);
+        m_pinned.push_back(h);
+        m_hypotheses.insert(q, h);
+    }
+
+    scoped_ptr_vector<ast_manager> managers;
+    scoped_limits scl(m.limit());
+    vector<proof_ref_vector> thread_steps;
+    vector<expr_ref_vector> premise_hyps, thread_side_conditions;
+    vector<unsigned_vector> hyps_offset;
+    for (unsigned t = 0; t < num_threads; ++t) {
+        ast_manager* new_m = alloc(ast_manager, m, false);
+        managers.push_back(new_m);
+        scl.push_child(&new_m->limit());
+        ast_translation tr(m, *new_m);
+        thread_steps.push_back(proof_ref_vector(*new_m));
+        premise_hyps.push_back(expr_ref_vector(*new_m));
+        thread_side_conditions.push_back(expr_ref_vector(*new_m));
+        hyps_offset.push_back(unsigned_vector());
+        expr_ref_vector args(*new_m);
+        for (unsigned i = t * steps.size() / num_threads; i < (t + 1) * steps.size() / num_threads; ++i) {
+            proof* q = steps[i];
+            args.reset();
+            hyps_offset.back().push_back(premise_hyps.back().size());
+            for (expr* arg : *q) {
+                if (m.is_proof(arg)) {
+                    proof* r = to_app(arg);
+                    args.push_back(m.has_fact(r) ? new_m->mk_app(m.get_basic_family_id(), PR_ASSERTED, tr(m.get_fact(r))) : new_m->mk_app(m.get_basic_family_id(), PR_UNDEF));
+                    premise_hyps.back().push_back(tr(m_hypotheses[r]));
+                }
+                else {
+                    args.push_back(tr(arg));
+                }
+            }
+            thread_steps.back().push_back(new_m->mk_app(tr(q->get_decl()), args.size(), args.c_ptr()));
+        }
+    }
+
+    unsigned_vector failed(num_threads, UINT_MAX);
+    parallel_executor::run(num_threads, [&](unsigned t) {
+        proof_checker checker(*managers[t]);
+        expr_ref hyps(*managers[t]);
+        for (unsigned i = 0; i < thread_steps[t].size(); ++i) {
+            if (!checker.check_step(thread_steps[t].get(i), premise_hyps[t].c_ptr() + hyps_offset[t][i], hyps, thread_side_conditions[t])) {
+                failed[t] = i;
+                break;
+            }
+        }
+    });
+
+    bool result = true;
+    for (unsigned t = 0; t < num_threads; ++t) {
+        ast_translation tr(*managers[t], m);
+        for (expr* e : thread_side_conditions[t])
+            side_conditions.push_back(tr(e));
+        if (result && failed[t] != UINT_MAX) {
+            result = false;
+            IF_VERBOSE(0, ast_ll_pp(verbose_stream() << "Proof check failed\n", m, steps[t * steps.size() / num_threads + failed[t]]););
+            UNREACHABLE();
+        }
+    }
+    if (result)
+        mark_checked(steps);
+
+    m_hypotheses.reset();
+    m_pinned.reset();
+    return result;
+}
+
+expr* proof_checker::mk_step_hyps(proof* p) {
+    expr* fact = nullptr;
+    if (is_hypothesis(p) && match_fact(p, fact))
+        return mk_atom(fact);
+    if (m.is_lemma(p))
+        return mk_nil();
+    ptr_buffer<expr> hyps;
+    for (unsigned i = 0; i < m.get_num_parents(p); ++i)
+        hyps.push_back(m_hypotheses[m.get_parent(p, i)]);
+    return mk_hyp(hyps.size(), hyps.c_ptr());
+}
+
+bool proof_checker::check_step(proof* p, expr * const* premise_hyps, expr_ref& hyps, expr_ref_vector& side_conditions) {
+    unsigned num_parents = m.get_num_parents(p);
+    for (unsigned i = 0; i < num_parents; ++i) 
+        m_hypotheses.insert(m.get_parent(p, i), premise_hyps[i]);
+    hyps = mk_step_hyps(p);
+
+    bool result = check1(p, side_conditions);
+
+    m_hypotheses.reset();
+    m_pinned.reset();
+    m_todo.reset();
+    m_marked.reset();
+    return result;
+}
+
 bool proof_checker::check1(proof* p, expr_ref_vector& side_conditions) {
     if (p->get_family_id() == m.get_basic_family_id()) {
         return check1_basic(p, side_conditions);
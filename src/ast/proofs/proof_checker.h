@@ -27,6 +27,8 @@ class proof_checker {
     expr_mark        m_marked;
     expr_ref_vector  m_pinned;
     obj_map<expr, expr*> m_hypotheses;
+    expr_mark        m_checked;         // proofs whose subproofs have all been checked.
+    proof_ref_vector m_checked_pinned;
     family_id        m_hyp_fid;
     // family_id        m_spc_fid;
     app_ref          m_nil;
@@ -70,6 +72,33 @@ public:
     proof_checker(ast_manager& m);
     void set_dump_lemmas(char const * logic = "AUFLIA") { m_dump_lemmas = true; m_logic = logic; } 
     bool check(proof* p, expr_ref_vector& side_conditions);
+
+    /**
+       \brief Check p like check, but verify the steps on up to num_threads
+       threads. Each thread checks its share of the steps in a copy of the
+       manager, with stand-ins for the premises of each step.
+    */
+    bool check_parallel(proof* p, expr_ref_vector& side_conditions, unsigned num_threads);
+
+    /**
+       \brief Forget the proofs checked by previous calls. Subproofs that
+       were checked successfully are not checked again until then.
+    */
+    void reset_checked() { m_checked.reset(); m_checked_pinned.reset(); }
+
+    /**
+       \brief Check the inference of the proof step p alone, assuming that
+       its premises are correct. premise_hyps holds the hypotheses of the
+       premises of p, as computed by previous calls for them, and hyps is set
+       to the hypotheses p depends on. The premises of p are only inspected
+       for their facts, so they can be stand-ins for the actual subproofs.
+    */
+    bool check_step(proof* p, expr * const* premise_hyps, expr_ref& hyps, expr_ref_vector& side_conditions);
+
+    /**
+       \brief Return true if the hypotheses computed by check_step are empty.
+    */
+    bool is_closed(expr* hyps) const { return match_nil(hyps); }
 private:
     bool check1(proof* p, expr_ref_vector& side_conditions);
     bool check1_basic(proof* p, expr_ref_vector& side_conditions);
@@ -78,6 +107,8 @@ private:
     bool check_arith_literal(bool is_pos, app* lit, rational const& coeff, expr_ref& sum, bool& is_strict);
     bool match_fact(proof const* p, expr*& fact) const;
     void add_premise(proof* p);
+    void mark_checked(ptr_vector<proof> const& steps);
+    expr* mk_step_hyps(proof* p);
     bool match_proof(proof const* p) const;
     bool match_proof(proof const* p, proof*& p0) const;
     bool match_proof(proof const* p, proof*& p0, proof*& p1) const;
@@ -0,0 +1,487 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    proof_stream.cpp
+
+Abstract:
+
+    Streaming of proof objects.
+
+--*/
+#include <iomanip>
+#include "ast/proofs/proof_stream.h"
+#include "ast/ast_pp.h"
+
+proof_stream_writer::proof_stream_writer(ast_manager & m, std::ostream & out):
+    m(m),
+    m_out(out),
+    m_prev(m.get_proof_listener()) {
+    m.set_proof_listener(this);
+}
+
+proof_stream_writer::~proof_stream_writer() {
+    m.set_proof_listener(m_prev);
+    m_out.flush();
+}
+
+void proof_stream_writer::push_children(ast * n) {
+    auto push = [&](ast * c) {
+        if (!m_index.contains(c))
+            m_todo.push_back(c);
+    };
+    auto push_params = [&](decl * d) {
+        for (parameter const & p : d->parameters())
+            if (p.is_ast())
+                push(p.get_ast());
+    };
+    switch (n->get_kind()) {
+    case AST_SORT:
+        push_params(to_sort(n));
+        break;
+    case AST_FUNC_DECL: {
+        func_decl * f = to_func_decl(n);
+        push_params(f);
+        for (sort * s : *f)
+            push(s);
+        push(f->get_range());
+        break;
+    }
+    case AST_APP:
+        push(to_app(n)->get_decl());
+        for (expr * arg : *to_app(n))
+            push(arg);
+        break;
+    case AST_VAR:
+        push(to_var(n)->get_sort());
+        break;
+    case AST_QUANTIFIER: {
+        quantifier * q = to_quantifier(n);
+        for (unsigned i = 0; i < q->get_num_decls(); ++i)
+            push(q->get_decl_sort(i));
+        push(q->get_expr());
+        for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+            push(q->get_pattern(i));
+        for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+            push(q->get_no_pattern(i));
+        break;
+    }
+    default:
+        UNREACHABLE();
+    }
+}
+
+unsigned proof_stream_writer::write(ast * n) {
+    unsigned idx = 0;
+    if (m_index.find(n, idx))
+        return idx;
+    m_todo.push_back(n);
+    while (!m_todo.empty()) {
+        ast * a = m_todo.back();
+        if (m_index.contains(a)) {
+            m_todo.pop_back();
+            continue;
+        }
+        unsigned sz = m_todo.size();
+        push_children(a);
+        if (sz == m_todo.size()) {
+            m_todo.pop_back();
+            write_node(a);
+        }
+    }
+    return m_index[n];
+}
+
+void proof_stream_writer::write_root(proof * pr) {
+    unsigned idx = write(pr);
+    m_out << "r " << idx << "\n";
+    m_out.flush();
+}
+
+void proof_stream_writer::write_symbol(symbol const & s) {
+    m_out << " ";
+    if (s == symbol::null) {
+        m_out << "-";
+        return;
+    }
+    if (s.is_numerical()) {
+        m_out << ":" << s.get_num();
+        return;
+    }
+    m_out << "|";
+    for (char const * c = s.bare_str(); *c; ++c) {
+        if (*c == '|' || *c == '\\')
+            m_out << "\\";
+        m_out << *c;
+    }
+    m_out << "|";
+}
+
+void proof_stream_writer::write_family(family_id fid) {
+    if (fid == null_family_id)
+        m_out << " -";
+    else
+        write_symbol(m.get_family_name(fid));
+}
+
+void proof_stream_writer::write_parameters(unsigned num_params, parameter const * params) {
+    m_out << " " << num_params;
+    for (unsigned i = 0; i < num_params; ++i) {
+        parameter const & p = params[i];
+        switch (p.get_kind()) {
+        case parameter::PARAM_INT:
+            m_out << " i " << p.get_int();
+            break;
+        case parameter::PARAM_AST:
+            m_out << " a";
+            write_ref(p.get_ast());
+            break;
+        case parameter::PARAM_SYMBOL:
+            m_out << " s";
+            write_symbol(p.get_symbol());
+            break;
+        case parameter::PARAM_RATIONAL:
+            m_out << " r " << p.get_rational().to_string();
+            break;
+        case parameter::PARAM_DOUBLE:
+            m_out << " d " << std::setprecision(17) << p.get_double();
+            break;
+        case parameter::PARAM_EXTERNAL:
+            // plugin specific values cannot be read back, the checker rejects them.
+            m_out << " x " << p.get_ext_id();
+            break;
+        }
+    }
+}
+
+void proof_stream_writer::write_node(ast * n) {
+    unsigned idx = m_next_index++;
+    switch (n->get_kind()) {
+    case AST_SORT: {
+        sort * s = to_sort(n);
+        m_out << "s " << idx;
+        write_family(m.is_uninterp(s) ? null_family_id : s->get_family_id());
+        m_out << " " << (m.is_uninterp(s) ? null_decl_kind : s->get_decl_kind());
+        write_symbol(s->get_name());
+        write_parameters(s->get_num_parameters(), s->get_parameters());
+        break;
+    }
+    case AST_FUNC_DECL: {
+        func_decl * f = to_func_decl(n);
+        m_out << "d " << idx;
+        write_family(f->get_family_id());
+        m_out << " " << f->get_decl_kind();
+        write_symbol(f->get_name());
+        write_parameters(f->get_num_parameters(), f->get_parameters());
+        m_out << " " << f->get_arity();
+        for (sort * s : *f)
+            write_ref(s);
+        write_ref(f->get_range());
+        break;
+    }
+    case AST_APP: {
+        app * a = to_app(n);
+        m_out << "a " << idx;
+        write_ref(a->get_decl());
+        m_out << " " << a->get_num_args();
+        for (expr * arg : *a)
+            write_ref(arg);
+        break;
+    }
+    case AST_VAR:
+        m_out << "v " << idx << " " << to_var(n)->get_idx();
+        write_ref(to_var(n)->get_sort());
+        break;
+    case AST_QUANTIFIER: {
+        quantifier * q = to_quantifier(n);
+        m_out << "q " << idx << " " << static_cast<unsigned>(q->get_kind()) << " " << q->get_weight();
+        write_symbol(q->get_qid());
+        write_symbol(q->get_skid());
+        m_out << " " << q->get_num_decls();
+        for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+            write_symbol(q->get_decl_name(i));
+            write_ref(q->get_decl_sort(i));
+        }
+        write_ref(q->get_expr());
+        m_out << " " << q->get_num_patterns();
+        for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+            write_ref(q->get_pattern(i));
+        m_out << " " << q->get_num_no_patterns();
+        for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+            write_ref(q->get_no_pattern(i));
+        break;
+    }
+    default:
+        UNREACHABLE();
+    }
+    m_out << "\n";
+    m_index.insert(n, idx);
+}
+
+namespace {
+    class proof_stream_reader {
+        std::istream& m_in;
+        std::string   m_token;
+
+        void skip_space() {
+            while (m_in && std::isspace(m_in.peek()))
+                m_in.get();
+        }
+
+    public:
+        proof_stream_reader(std::istream & in): m_in(in) {}
+
+        bool eof() {
+            skip_space();
+            return m_in.peek() == EOF;
+        }
+
+        std::string const & token() {
+            skip_space();
+            m_token.clear();
+            while (m_in && m_in.peek() != EOF && !std::isspace(m_in.peek()))
+                m_token.push_back(static_cast<char>(m_in.get()));
+            if (m_token.empty())
+                throw default_exception("unexpected end of proof stream");
+            return m_token;
+        }
+
+        char kind() {
+            std::string const & t = token();
+            if (t.size() != 1)
+                throw default_exception("unexpected token in proof stream: " + t);
+            return t[0];
+        }
+
+        int64_t integer() {
+            std::string const & t = token();
+            char * end = nullptr;
+            long long r = strtoll(t.c_str(), &end, 10);
+            if (*end != 0)
+                throw default_exception("integer expected in proof stream: " + t);
+            return r;
+        }
+
+        unsigned num() {
+            int64_t r = integer();
+            if (r < 0 || r > UINT_MAX)
+                throw default_exception("unsigned integer expected in proof stream");
+            return static_cast<unsigned>(r);
+        }
+
+        symbol sym() {
+            skip_space();
+            if (m_in.peek() != '|') {
+                std::string const & t = token();
+                if (t == "-")
+                    return symbol::null;
+                if (t.size() > 1 && t[0] == ':')
+                    return symbol(static_cast<unsigned>(strtoul(t.c_str() + 1, nullptr, 10)));
+                throw default_exception("symbol expected in proof stream: " + t);
+            }
+            m_in.get();
+            std::string s;
+            int c;
+            while ((c = m_in.get()) != '|') {
+                if (c == '\\')
+                    c = m_in.get();
+                if (c == EOF)
+                    throw default_exception("unterminated symbol in proof stream");
+                s.push_back(static_cast<char>(c));
+            }
+            return symbol(s.c_str());
+        }
+    };
+}
+
+proof_stream_checker::proof_stream_checker(ast_manager & m):
+    m(m),
+    m_checker(m),
+    m_asts(m),
+    m_hyps(m) {
+}
+
+void proof_stream_checker::set(unsigned idx, ast * n) {
+    if (idx != m_asts.size())
+        throw default_exception("proof stream records are not consecutive");
+    if (!n)
+        throw default_exception("proof stream contains an unsupported declaration");
+    m_asts.push_back(n);
+    m_hyps.push_back(nullptr);
+}
+
+bool proof_stream_checker::add_step(unsigned idx, func_decl * d, unsigned num_args, unsigned const * arg_idx, expr_ref_vector & side_conditions) {
+    expr_ref_buffer args(m), premise_hyps(m);
+    for (unsigned i = 0; i < num_args; ++i) {
+        expr * arg = to_expr(m_asts.get(arg_idx[i]));
+        args.push_back(arg);
+        if (m.is_proof(arg))
+            premise_hyps.push_back(m_hyps.get(arg_idx[i]));
+    }
+    proof_ref pr(m.mk_app(d, args.size(), args.c_ptr()), m);
+    if (premise_hyps.size() != m.get_num_parents(pr))
+        throw default_exception("malformed proof step in proof stream");
+    expr_ref hyps(m);
+    ++m_num_steps;
+    if (!m_checker.check_step(pr, premise_hyps.c_ptr(), hyps, side_conditions)) {
+        IF_VERBOSE(0, verbose_stream() << "proof stream step " << idx << " does not check:\n" << mk_pp(pr, m) << "\n");
+        return false;
+    }
+    // later steps only need the fact of pr.
+    set(idx, m.has_fact(pr) ? m.mk_app(m.get_basic_family_id(), PR_ASSERTED, m.get_fact(pr)) : m.mk_app(m.get_basic_family_id(), PR_UNDEF));
+    m_hyps.set(idx, hyps);
+    return true;
+}
+
+bool proof_stream_checker::check(std::istream & in, expr_ref_vector & side_conditions) {
+    proof_stream_reader r(in);
+    sort_ref_vector sorts(m);
+    expr_ref_vector args(m);
+    svector<symbol> names;
+    vector<parameter> params;
+
+    unsigned_vector arg_idx;
+    unsigned last_ref = 0;
+
+    auto get = [&](unsigned i) -> ast * {
+        if (i >= m_asts.size())
+            throw default_exception("proof stream refers to an undefined record");
+        last_ref = i;
+        return m_asts.get(i);
+    };
+    auto get_sort = [&]() -> sort * {
+        ast * n = get(r.num());
+        if (!is_sort(n))
+            throw default_exception("sort expected in proof stream");
+        return to_sort(n);
+    };
+    auto get_expr = [&]() -> expr * {
+        ast * n = get(r.num());
+        if (!is_expr(n))
+            throw default_exception("expression expected in proof stream");
+        return to_expr(n);
+    };
+    auto get_family = [&]() -> family_id {
+        symbol s = r.sym();
+        if (s == symbol::null)
+            return null_family_id;
+        family_id fid = m.get_family_id(s);
+        if (fid == null_family_id)
+            throw default_exception("unknown family in proof stream");
+        return fid;
+    };
+    auto get_params = [&]() {
+        params.reset();
+        unsigned n = r.num();
+        for (unsigned i = 0; i < n; ++i) {
+            switch (r.kind()) {
+            case 'i': params.push_back(parameter(static_cast<int>(r.integer()))); break;
+            case 'a': params.push_back(parameter(get(r.num()))); break;
+            case 's': params.push_back(parameter(r.sym())); break;
+            case 'r': params.push_back(parameter(rational(r.token().c_str()))); break;
+            case 'd': params.push_back(parameter(strtod(r.token().c_str(), nullptr))); break;
+            default: throw default_exception("unsupported parameter in proof stream");
+            }
+        }
+    };
+
+    while (!r.eof()) {
+        char k = r.kind();
+        unsigned idx = r.num();
+        switch (k) {
+        case 's': {
+            family_id fid = get_family();
+            decl_kind dk = static_cast<decl_kind>(r.integer());
+            symbol name = r.sym();
+            get_params();
+            if (fid == null_family_id)
+                set(idx, m.mk_uninterpreted_sort(name, params.size(), params.c_ptr()));
+            else
+                set(idx, m.mk_sort(fid, dk, params.size(), params.c_ptr()));
+            break;
+        }
+        case 'd': {
+            family_id fid = get_family();
+            decl_kind dk = static_cast<decl_kind>(r.integer());
+            symbol name = r.sym();
+            get_params();
+            sorts.reset();
+            unsigned arity = r.num();
+            for (unsigned i = 0; i < arity; ++i)
+                sorts.push_back(get_sort());
+            sort * range = get_sort();
+            if (fid == null_family_id)
+                set(idx, m.mk_func_decl(name, arity, sorts.c_ptr(), range));
+            else
+                set(idx, m.mk_func_decl(fid, dk, params.size(), params.c_ptr(), arity, sorts.c_ptr(), range));
+            break;
+        }
+        case 'a': {
+            ast * d = get(r.num());
+            if (!is_func_decl(d))
+                throw default_exception("declaration expected in proof stream");
+            args.reset();
+            arg_idx.reset();
+            unsigned n = r.num();
+            for (unsigned i = 0; i < n; ++i) {
+                args.push_back(get_expr());
+                arg_idx.push_back(last_ref);
+            }
+            if (to_func_decl(d)->get_range() == m.mk_proof_sort()) {
+                if (!add_step(idx, to_func_decl(d), arg_idx.size(), arg_idx.c_ptr(), side_conditions))
+                    return false;
+            }
+            else {
+                set(idx, m.mk_app(to_func_decl(d), args.size(), args.c_ptr()));
+            }
+            break;
+        }
+        case 'v': {
+            unsigned vidx = r.num();
+            set(idx, m.mk_var(vidx, get_sort()));
+            break;
+        }
+        case 'q': {
+            quantifier_kind qk = static_cast<quantifier_kind>(r.num());
+            int weight = static_cast<int>(r.integer());
+            symbol qid = r.sym();
+            symbol skid = r.sym();
+            unsigned n = r.num();
+            sorts.reset();
+            names.reset();
+            for (unsigned i = 0; i < n; ++i) {
+                names.push_back(r.sym());
+                sorts.push_back(get_sort());
+            }
+            expr_ref body(get_expr(), m);
+            args.reset();
+            unsigned num_patterns = r.num();
+            for (unsigned i = 0; i < num_patterns; ++i)
+                args.push_back(get_expr());
+            unsigned num_no_patterns = r.num();
+            for (unsigned i = 0; i < num_no_patterns; ++i)
+                args.push_back(get_expr());
+            if (qk == lambda_k)
+                set(idx, m.mk_lambda(n, sorts.c_ptr(), names.c_ptr(), body));
+            else if (qk == forall_k || qk == exists_k)
+                set(idx, m.mk_quantifier(qk, n, sorts.c_ptr(), names.c_ptr(), body, weight, qid, skid,
+                                         num_patterns, args.c_ptr(), num_no_patterns, args.c_ptr() + num_patterns));
+            else
+                throw default_exception("unknown quantifier kind in proof stream");
+            break;
+        }
+        case 'r': {
+            ast * p = get(idx);
+            m_refutation =
+                m_hyps.get(idx) != nullptr &&
+                m.has_fact(to_app(p)) && m.is_false(m.get_fact(to_app(p))) &&
+                m_checker.is_closed(m_hyps.get(idx));
+            break;
+        }
+        default:
+            throw default_exception("unknown record in proof stream");
+        }
+    }
+    return true;
+}
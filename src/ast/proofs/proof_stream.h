@@ -0,0 +1,113 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    proof_stream.h
+
+Abstract:
+
+    Streaming of proof objects.
+
+    proof_stream_writer installs itself as the proof listener of an
+    ast_manager and writes every proof step to a stream when the step is
+    created, so that a proof can be recorded and checked without keeping
+    the proof DAG for get_proof.
+
+    Sorts, declarations and expressions are hash-consed: each one is
+    written once, as a record of its own, and referred to by the index of
+    its record afterwards. The writer does not hold references, an ast
+    that is deleted is forgotten and written again if it is recreated.
+    The records are:
+
+       s <i> <family> <kind> <name> <params>                      sort
+       d <i> <family> <kind> <name> <params> <n> <sort>^n <sort>  declaration
+       a <i> <decl> <n> <expr>^n                                  application
+       v <i> <idx> <sort>                                         variable
+       q <i> <kind> <weight> <qid> <skid> <n> (<name> <sort>)^n <body>
+             <n> <pattern>^n <n> <no-pattern>^n                   quantifier
+       r <i>                                                      final proof
+
+    where <params> is the number of parameters followed by the parameters,
+    each prefixed by its kind (i: integer, a: ast, s: symbol, r: rational,
+    d: double). Families are written by name, '-' stands for uninterpreted
+    sorts and declarations. Symbols are either '-' (the null symbol),
+    ':<n>' for numerical symbols or quoted with '|'. Proof steps are
+    applications of proof declarations.
+
+    proof_stream_checker checks the steps of a stream one by one with the
+    proof_checker. It keeps the terms of the stream, but of each proof
+    step only its fact and its hypotheses.
+
+--*/
+#pragma once
+
+#include <iostream>
+#include "ast/ast.h"
+#include "ast/proofs/proof_checker.h"
+#include "util/obj_hashtable.h"
+
+class proof_stream_writer : public proof_listener {
+    ast_manager&           m;
+    std::ostream&          m_out;
+    proof_listener*        m_prev;
+    obj_map<ast, unsigned> m_index;
+    unsigned               m_next_index { 0 };
+    ptr_vector<ast>        m_todo;
+
+    void push_children(ast * n);
+    void write_node(ast * n);
+    void write_symbol(symbol const & s);
+    void write_family(family_id fid);
+    void write_parameters(unsigned num_params, parameter const * params);
+    void write_ref(ast * n) { m_out << " " << m_index[n]; }
+
+public:
+    proof_stream_writer(ast_manager & m, std::ostream & out);
+    ~proof_stream_writer() override;
+
+    /**
+       \brief Write n, and the asts it contains that were not written yet.
+       Return the index of its record.
+    */
+    unsigned write(ast * n);
+
+    /**
+       \brief Mark pr as the final proof of the stream.
+    */
+    void write_root(proof * pr);
+
+    unsigned num_records() const { return m_next_index; }
+
+    void on_mk_proof(app * pr) override { write(pr); }
+    void on_del_ast(ast * n) override { m_index.erase(n); }
+};
+
+class proof_stream_checker {
+    ast_manager&     m;
+    proof_checker    m_checker;
+    ast_ref_vector   m_asts;       // record index -> ast, proof steps are replaced by stand-ins for their facts.
+    expr_ref_vector  m_hyps;       // record index -> hypotheses of proof steps.
+    unsigned         m_num_steps { 0 };
+    bool             m_refutation { false };
+
+    void set(unsigned idx, ast * n);
+    bool add_step(unsigned idx, func_decl * d, unsigned num_args, unsigned const * arg_idx, expr_ref_vector & side_conditions);
+
+public:
+    proof_stream_checker(ast_manager & m);
+
+    /**
+       \brief Check the proof steps of the stream in. Return false if a step
+       does not check. Throws default_exception if the stream is malformed.
+    */
+    bool check(std::istream & in, expr_ref_vector & side_conditions);
+
+    unsigned num_steps() const { return m_num_steps; }
+
+    /**
+       \brief Return true if the final proof of the stream derives false
+       without hypotheses.
+    */
+    bool is_refutation() const { return m_refutation; }
+};
@@ -692,7 +692,7 @@ br_status arith_rewriter::mk_eq_core(expr * arg1, expr * arg2, expr_ref & result
 }
 
 expr_ref arith_rewriter::neg_monomial(expr* e) const {
-    expr_ref_vector args(m());
+    expr_ref_buffer args(m());
     rational a1;
     if (is_app(e) && m_util.is_mul(e)) {
         if (is_numeral(to_app(e)->get_arg(0), a1)) {
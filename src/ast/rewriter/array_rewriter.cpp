@@ -172,8 +172,21 @@ br_status array_rewriter::mk_select_core(unsigned num_args, expr * const * args,
             return BR_DONE;
         case l_false: {
             // select(store(a, I, v), J) --> select(a, J) if I != J
+            // skip the stores of the chain below a at indices distinct from J,
+            // so that no intermediate select terms are created.
+            expr* a = to_app(args[0])->get_arg(0);
+            while (m_util.is_store(a)) {
+                lbool r = compare_args<true>(num_args - 1, args+1, to_app(a)->get_args()+1);
+                if (r == l_true) {
+                    result = to_app(a)->get_arg(num_args);
+                    return BR_DONE;
+                }
+                if (r == l_undef)
+                    break;
+                a = to_app(a)->get_arg(0);
+            }
             ptr_buffer<expr> new_args;
-            new_args.push_back(to_app(args[0])->get_arg(0));
+            new_args.push_back(a);
             new_args.append(num_args-1, args+1);
             result = m().mk_app(get_fid(), OP_SELECT, num_args, new_args.c_ptr());
             return BR_REWRITE1;
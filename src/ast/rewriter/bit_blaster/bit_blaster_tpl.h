@@ -51,6 +51,8 @@ public:
         m_max_memory = max_memory;
     }
 
+    void set_use_wtm(bool f) { m_use_wtm = f; }
+
     
     // Cfg required API
     ast_manager & m() const { return Cfg::m(); }
@@ -195,6 +195,16 @@ void bit_blaster_tpl<Cfg>::mk_multiplier(unsigned sz, expr * const * a_bits, exp
         SASSERT(sz == out_bits.size());
         return;
     }
+    // multiplication is commutative: order the arguments by the ids of their bits
+    // so that mk_multiplier(a, b) and mk_multiplier(b, a) produce the same circuit
+    // and partial products are shared between commuted occurrences.
+    for (unsigned i = sz; i-- > 0; ) {
+        if (a_bits[i] == b_bits[i])
+            continue;
+        if (a_bits[i]->get_id() > b_bits[i]->get_id())
+            std::swap(a_bits, b_bits);
+        break;
+    }
     out_bits.reset();
     if (!m_use_wtm) {
 #if 0
@@ -1401,7 +1401,7 @@ br_status bv_rewriter::mk_bv2int(expr * arg, expr_ref & result) {
             result = m_autil.mk_int(0);
             return BR_DONE;
         }
-        expr_ref_vector args(m());        
+        expr_ref_buffer args(m());
         
         unsigned num_args = to_app(arg)->get_num_args();
         for (expr* x : *to_app(arg)) {
@@ -1409,24 +1409,21 @@ br_status bv_rewriter::mk_bv2int(expr * arg, expr_ref & result) {
         }
         unsigned sz = get_bv_size(to_app(arg)->get_arg(num_args-1));
         for (unsigned i = num_args - 1; i > 0; ) {
-            expr_ref tmp(m());
             --i;
-            tmp = args[i].get();
-            tmp = m_autil.mk_mul(m_autil.mk_numeral(power(numeral(2), sz), true), tmp);
-            args[i] = std::move(tmp);
+            args.set(i, m_autil.mk_mul(m_autil.mk_numeral(power(numeral(2), sz), true), args[i]));
             sz += get_bv_size(to_app(arg)->get_arg(i));
         }
         result = m_autil.mk_add(args.size(), args.c_ptr());
         return BR_REWRITE2;
     }
     if (is_mul_no_overflow(arg)) {
-        expr_ref_vector args(m());
+        expr_ref_buffer args(m());
         for (expr* x : *to_app(arg)) args.push_back(m_util.mk_bv2int(x));
         result = m_autil.mk_mul(args.size(), args.c_ptr());
         return BR_REWRITE2;
     }
     if (is_add_no_overflow(arg)) {
-        expr_ref_vector args(m());
+        expr_ref_buffer args(m());
         for (expr* x : *to_app(arg)) args.push_back(m_util.mk_bv2int(x));
         result = m_autil.mk_add(args.size(), args.c_ptr());
         return BR_REWRITE2;
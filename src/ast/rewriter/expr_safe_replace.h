@@ -22,13 +22,14 @@ Revision History:
 #pragma once
 
 #include "ast/ast.h"
+#include "util/swiss_hashtable.h"
 
 class expr_safe_replace {
     ast_manager& m;
     expr_ref_vector m_src;
     expr_ref_vector m_dst;
     obj_map<expr, expr*> m_subst;
-    obj_map<expr,expr*> m_cache;
+    obj_map<expr, expr*, swiss_hashtable> m_cache;
     ptr_vector<expr> m_todo, m_args;
     expr_ref_vector m_refs;
 
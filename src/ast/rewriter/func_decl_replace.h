@@ -21,11 +21,12 @@ Revision History:
 #pragma once
 
 #include "ast/ast.h"
+#include "util/swiss_hashtable.h"
 
 class func_decl_replace {
     ast_manager& m;
     obj_map<func_decl, func_decl*> m_subst;
-    obj_map<expr, expr*> m_cache;
+    obj_map<expr, expr*, swiss_hashtable> m_cache;
     ptr_vector<expr>     m_todo, m_args;
     expr_ref_vector      m_refs;
     func_decl_ref_vector m_funs;
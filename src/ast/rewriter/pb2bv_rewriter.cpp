@@ -41,6 +41,7 @@ struct pb2bv_rewriter::imp {
     unsigned                  m_num_translated;
     unsigned                  m_compile_bv;
     unsigned                  m_compile_card;
+    unsigned                  m_num_shared;
 
     struct card2bv_rewriter {               
         typedef expr* pliteral;
@@ -58,6 +59,8 @@ struct pb2bv_rewriter::imp {
         bool m_keep_cardinality_constraints;
         symbol m_pb_solver;
         unsigned m_min_arity;
+        obj_map<expr, expr*> m_shared[2];   // sorted cardinality constraint -> encoding, for partial and full encodings.
+        expr_ref_vector m_shared_trail;
 
         template<lbool is_le>
         expr_ref mk_le_ge(expr_ref_vector& fmls, expr* a, expr* b, expr* bound) {
@@ -721,9 +724,16 @@ struct pb2bv_rewriter::imp {
             m_args(m),
             m_keep_cardinality_constraints(false),
             m_pb_solver(symbol("solver")),
-            m_min_arity(9)
+            m_min_arity(9),
+            m_shared_trail(m)
         {}
 
+        void reset_shared() {
+            m_shared[0].reset();
+            m_shared[1].reset();
+            m_shared_trail.reset();
+        }
+
         void set_pb_solver(symbol const& s) { m_pb_solver = s; }
 
         bool mk_app(bool full, func_decl * f, unsigned sz, expr * const* args, expr_ref & result) {
@@ -841,9 +851,73 @@ struct pb2bv_rewriter::imp {
             return false;
         }
 
+        /**
+           \brief Select an encoding for each constraint (pb.solver=auto).
+
+           Cardinality constraints over fewer than min_arity literals, or
+           whose bound is at most 2 away from 0 or from the number of
+           literals, are compiled to sorting networks. Other cardinality 
+           constraints are kept for the native solver. PB constraints with
+           a bound of at most 20 over at most 20 literals use the totalizer
+           encoding, PB constraints with larger coefficients than the
+           native solver supports are bit-blasted and the others are kept.
+        */
+        bool mk_pb_auto(bool full, func_decl * f, unsigned sz, expr * const* args, expr_ref & result) {
+            if (is_or(f) || !pb.get_k(f).is_unsigned()) {
+                flet<symbol> _solver(m_pb_solver, symbol("sorting"));
+                return mk_pb(full, f, sz, args, result);
+            }
+            unsigned k = pb.get_k(f).get_unsigned();
+            if (pb.is_at_most_k(f) || pb.is_at_least_k(f) || pb.has_unit_coefficients(f)) {
+                unsigned k1 = std::min(k, sz > k ? sz - k : 0);
+                if (sz >= m_min_arity && k1 > 2) 
+                    return false;
+                return mk_card_shared(full, f, sz, args, result);
+            }
+            if (!has_small_coefficients(f)) {
+                result = mk_bv(f, sz, args);
+                return true;
+            }
+            if (k <= 20 && sz <= 20 && !pb.is_eq(f)) {
+                flet<symbol> _solver(m_pb_solver, symbol("totalizer"));
+                result = mk_bv(f, sz, args);
+                return true;
+            }
+            return false;
+        }
+
+        /**
+           \brief Compile a cardinality constraint with sorting networks.
+           The literals are sorted, so that constraints over the same 
+           literals and with the same bound share their encoding.
+        */
+        bool mk_card_shared(bool full, func_decl * f, unsigned sz, expr * const* args, expr_ref & result) {
+            ptr_buffer<expr> sorted;
+            sorted.append(sz, args);
+            std::sort(sorted.begin(), sorted.end(), ast_lt_proc());
+            expr_ref key(m.mk_app(f, sz, sorted.c_ptr()), m);
+            expr* r = nullptr;
+            if (m_shared[full].find(key, r)) {
+                ++m_imp.m_num_shared;
+                result = r;
+                return true;
+            }
+            flet<symbol> _solver(m_pb_solver, symbol("sorting"));
+            flet<bool> _keep(m_keep_cardinality_constraints, false);
+            if (!mk_pb(full, f, sz, sorted.c_ptr(), result))
+                return false;
+            m_shared_trail.push_back(key);
+            m_shared_trail.push_back(result);
+            m_shared[full].insert(key, result);
+            return true;
+        }
+
         bool mk_pb(bool full, func_decl * f, unsigned sz, expr * const* args, expr_ref & result) {
             SASSERT(f->get_family_id() == pb.get_family_id());
-            if (is_or(f)) {
+            if (m_pb_solver == "auto") {
+                return mk_pb_auto(full, f, sz, args, result);
+            }
+            else if (is_or(f)) {
                 result = m.mk_or(sz, args);
             }
             else if (pb.is_at_most_k(f) && pb.get_k(f).is_unsigned()) {
@@ -1027,6 +1101,7 @@ struct pb2bv_rewriter::imp {
         updt_params(p);
         m_compile_bv = 0;
         m_compile_card = 0;
+        m_num_shared = 0;
     }
 
     void updt_params(params_ref const & p) {
@@ -1039,7 +1114,7 @@ struct pb2bv_rewriter::imp {
 
     void collect_param_descrs(param_descrs& r) const {
         r.insert("keep_cardinality_constraints", CPK_BOOL, "(default: false) retain cardinality constraints (don't bit-blast them) and use built-in cardinality solver");
-        r.insert("pb.solver", CPK_SYMBOL, "(default: solver) retain pb constraints (don't bit-blast them) and use built-in pb solver");
+        r.insert("pb.solver", CPK_SYMBOL, "(default: solver) retain pb constraints (don't bit-blast them) and use built-in pb solver, auto selects an encoding per constraint");
         r.insert("cardinality.encoding", CPK_SYMBOL, "(default: none) grouped, bimander, ordered, unate, circuit");
     }
 
@@ -1062,6 +1137,7 @@ struct pb2bv_rewriter::imp {
             m_fresh_lim.resize(new_sz);
         }
         m_rw.reset();
+        m_rw.m_cfg.m_r.reset_shared();
     }
 
     void flush_side_constraints(expr_ref_vector& side_constraints) { 
@@ -1072,6 +1148,7 @@ struct pb2bv_rewriter::imp {
     void collect_statistics(statistics & st) const {
         st.update("pb-compile-bv", m_compile_bv);
         st.update("pb-compile-card", m_compile_card);
+        st.update("pb-shared-encodings", m_num_shared);
         st.update("pb-aux-variables", m_fresh.size());
         st.update("pb-aux-clauses", m_rw.m_cfg.m_r.m_sort.m_stats.m_num_compiled_clauses);
     }
@@ -379,6 +379,9 @@ struct default_rewriter_cfg {
     bool max_frames_exceeded(unsigned num_frames) const { return false; }
     bool max_steps_exceeded(unsigned num_steps) const { return false; }
     bool pre_visit(expr * t) { return true; }
+    // Return true if reduce_app fails on every application of f. The rewriter then keeps
+    // constants and applications of f whose arguments did not change without calling reduce_app.
+    bool is_unchanged(func_decl * f) const { return false; }
     br_status reduce_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result, proof_ref & result_pr) { return BR_FAILED; }
     bool reduce_quantifier(quantifier * old_q, 
                            expr * new_body, 
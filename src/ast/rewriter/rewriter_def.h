@@ -192,6 +192,12 @@ bool rewriter_tpl<Config>::visit(expr * t, unsigned max_depth) {
     switch (t->get_kind()) {
     case AST_APP:
         if (to_app(t)->get_num_args() == 0) {
+            if (m_cfg.is_unchanged(to_app(t)->get_decl())) {
+                result_stack().push_back(t);
+                if (ProofGen)
+                    result_pr_stack().push_back(nullptr); // implicit reflexivity
+                return true;
+            }
             if (process_const<ProofGen>(to_app(t))) 
                 return true; 
             TRACE("rewriter", tout << "process const: " << mk_bounded_pp(t, m()) << " -> " << mk_bounded_pp(m_r,m()) << "\n";);
@@ -300,7 +306,7 @@ void rewriter_tpl<Config>::process_app(app * t, frame & fr) {
                 SASSERT(rewrites_to(new_t, m_pr));
             }
         }
-        br_status st = m_cfg.reduce_app(f, new_num_args, new_args, m_r, m_pr2);       
+        br_status st = m_cfg.is_unchanged(f) ? BR_FAILED : m_cfg.reduce_app(f, new_num_args, new_args, m_r, m_pr2);
         
         CTRACE("reduce_app", true || st != BR_FAILED || new_t,
                tout << mk_bounded_pp(t, m()) << "\n";
@@ -541,24 +547,25 @@ void rewriter_tpl<Config>::process_quantifier(quantifier * q, frame & fr) {
     expr * new_body   = *it;
     unsigned num_pats = q->get_num_patterns();
     unsigned num_no_pats = q->get_num_no_patterns();
-    expr_ref_vector new_pats(m_manager, num_pats, q->get_patterns());
-    expr_ref_vector new_no_pats(m_manager, num_no_pats, q->get_no_patterns());
+    // quantifiers rarely have more than a few patterns, keep them on the stack.
+    expr_ref_buffer new_pats(m_manager);
+    expr_ref_buffer new_no_pats(m_manager);
     if (rewrite_patterns()) {
         TRACE("reduce_quantifier_bug", tout << "rewrite patterns\n";);
         expr * const * np  = it + 1;
         expr * const * nnp = np + num_pats;
-        unsigned j = 0;
         for (unsigned i = 0; i < num_pats; i++)
             if (m_manager.is_pattern(np[i]))
-                new_pats[j++] = np[i];
-        new_pats.shrink(j);
-        num_pats = j;
-        j = 0;
+                new_pats.push_back(np[i]);
+        num_pats = new_pats.size();
         for (unsigned i = 0; i < num_no_pats; i++)
             if (m_manager.is_pattern(nnp[i]))
-                new_no_pats[j++] = nnp[i];
-        new_no_pats.shrink(j);
-        num_no_pats = j;
+                new_no_pats.push_back(nnp[i]);
+        num_no_pats = new_no_pats.size();
+    }
+    else {
+        new_pats.append(num_pats, q->get_patterns());
+        new_no_pats.append(num_no_pats, q->get_no_patterns());
     }
     if (ProofGen) {
         quantifier_ref new_q(m().update_quantifier(q, num_pats, new_pats.c_ptr(), num_no_pats, new_no_pats.c_ptr(), new_body), m());
@@ -743,8 +750,9 @@ template<typename Config>
 template<bool ProofGen>
 void rewriter_tpl<Config>::resume_core(expr_ref & result, proof_ref & result_pr) {
     SASSERT(!frame_stack().empty());
+    rlimit_budget budget(m().limit());
     while (!frame_stack().empty()) {
-        if (!m().inc()) {
+        if (!budget.inc()) {
             if (m_cancel_check) {
                 reset();
                 throw rewriter_exception(m().limit().get_cancel_msg());
@@ -800,6 +808,7 @@ void rewriter_tpl<Config>::resume_core(expr_ref & result, proof_ref & result_pr)
 
 template<typename Config>
 void rewriter_tpl<Config>::operator()(expr * t, expr_ref & result, proof_ref & result_pr) {
+    memory::scoped_tag _tag(memory::TAG_REWRITER);
     if (!frame_stack().empty() || m_cache != m_cache_stack[0]) {
         frame_stack().reset();
         result_stack().reset();
@@ -86,10 +86,13 @@ class sym_expr_boolean_algebra : public boolean_algebra<sym_expr*> {
     ast_manager& m;
     expr_solver& m_solver;
     expr_ref     m_var;
+    expr_ref_vector        m_sat_trail;
+    obj_map<expr, lbool>   m_sat_cache;  // satisfiability of predicates checked by m_solver
+    unsigned               m_max_sat_cache { 10000 };
     typedef sym_expr* T;
 public:
     sym_expr_boolean_algebra(ast_manager& m, expr_solver& s): 
-        m(m), m_solver(s), m_var(m) {}
+        m(m), m_solver(s), m_var(m), m_sat_trail(m) {}
 
     T mk_false() override {
         expr_ref fml(m.mk_false(), m);
@@ -224,13 +227,43 @@ public:
         if (m.is_false(fml)) {
             return l_false;
         }
-        return m_solver.check_sat(fml);
+        lbool r;
+        if (m_sat_cache.find(fml, r))
+            return r;
+        r = m_solver.check_sat(fml);
+        if (r != l_undef) {
+            if (m_sat_trail.size() >= m_max_sat_cache) {
+                m_sat_trail.reset();
+                m_sat_cache.reset();
+            }
+            m_sat_trail.push_back(fml);
+            m_sat_cache.insert(fml, r);
+        }
+        return r;
     }
 
     T mk_not(T x) override {
         return sym_expr::mk_not(m, x);    
     }
 
+    bool is_interval(T x, unsigned& lo, unsigned& hi) override {
+        seq_util u(m);
+        if (x->is_char() && u.is_const_char(x->get_char(), lo)) {
+            hi = lo;
+            return true;
+        }
+        return x->is_range() && u.is_const_char(x->get_lo(), lo) && u.is_const_char(x->get_hi(), hi);
+    }
+
+    T mk_interval(unsigned lo, unsigned hi) override {
+        seq_util u(m);
+        expr_ref _start(u.mk_char(lo), m);
+        if (lo == hi)
+            return sym_expr::mk_char(_start);
+        expr_ref _stop(u.mk_char(hi), m);
+        return sym_expr::mk_range(_start, _stop);
+    }
+
 };
 
 re2automaton::re2automaton(ast_manager& m): m(m), u(m), m_ba(nullptr), m_sa(nullptr) {}
@@ -35,6 +35,8 @@ Notes:
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 #include "ast/well_sorted.h"
+#include "util/gparams.h"
+#include <sstream>
 
 namespace {
 struct th_rewriter_cfg : public default_rewriter_cfg {
@@ -620,6 +622,11 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         m().trace_stream().flush();
     }
 
+    // reduce_app_core and push_ite ignore uninterpreted functions, pull_ite does not.
+    bool is_unchanged(func_decl * f) const {
+        return f->get_family_id() == null_family_id && !m_pull_cheap_ite;
+    }
+
     br_status reduce_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result, proof_ref & result_pr) {
         result_pr = nullptr;
         br_status st = reduce_app_core(f, num, args, result);
@@ -806,8 +813,43 @@ struct th_rewriter::imp : public rewriter_tpl<th_rewriter_cfg> {
     }
 };
 
+th_rewriter_memo::th_rewriter_memo(ast_manager & m, unsigned max_size):
+    m(m),
+    m_pinned(m),
+    m_max_size(max_size) {
+}
+
+void th_rewriter_memo::set_config(std::string const & config) {
+    if (config != m_config) {
+        reset();
+        m_config = config;
+    }
+}
+
+bool th_rewriter_memo::find(expr * t, expr_ref & result) const {
+    expr * r = nullptr;
+    if (!m_results.find(t->get_id(), r))
+        return false;
+    result = r;
+    return true;
+}
+
+void th_rewriter_memo::insert(expr * t, expr * result) {
+    if (m_results.size() >= m_max_size)
+        reset();
+    m_pinned.push_back(t);
+    m_pinned.push_back(result);
+    m_results.insert(t->get_id(), result);
+}
+
+void th_rewriter_memo::reset() {
+    m_results.reset();
+    m_pinned.reset();
+}
+
 th_rewriter::th_rewriter(ast_manager & m, params_ref const & p):
-    m_params(p) {
+    m_params(p),
+    m_memo(nullptr) {
     m_imp = alloc(imp, m, p);
 }
 
@@ -818,6 +860,27 @@ ast_manager & th_rewriter::m() const {
 void th_rewriter::updt_params(params_ref const & p) {
     m_params = p;
     m_imp->cfg().updt_params(p);
+    updt_memo_config();
+}
+
+void th_rewriter::set_memo(th_rewriter_memo * memo) {
+    SASSERT(!memo || &memo->get_manager() == &m());
+    m_memo = memo;
+    updt_memo_config();
+}
+
+void th_rewriter::updt_memo_config() {
+    if (!m_memo)
+        return;
+    std::ostringstream strm;
+    m_params.display(strm);
+    strm << "|";
+    gparams::get_module("rewriter").display(strm);
+    m_memo->set_config(strm.str());
+}
+
+bool th_rewriter::use_memo() const {
+    return m_memo && !m().proofs_enabled() && !m_imp->cfg().m_subst;
 }
 
 void th_rewriter::get_param_descrs(param_descrs & r) {
@@ -854,12 +917,16 @@ void th_rewriter::reset() {
 
 void th_rewriter::operator()(expr_ref & term) {
     expr_ref result(term.get_manager());
-    m_imp->operator()(term, result);
+    operator()(term, result);
     term = std::move(result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result) {
+    if (use_memo() && m_memo->find(t, result))
+        return;
     m_imp->operator()(t, result);
+    if (use_memo())
+        m_memo->insert(t, result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr) {
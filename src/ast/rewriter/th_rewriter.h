@@ -26,10 +26,38 @@ class expr_substitution;
 
 class expr_solver;
 
+/**
+   \brief Table of rewriting results that survives th_rewriter instances and
+   calls to th_rewriter::cleanup and th_rewriter::reset.
+
+   Entries are keyed on expression ids, and the keys are pinned so
+   that ids are not recycled while the entries are alive. The table is flushed 
+   when it is attached to a rewriter using a different configuration, 
+   or when it grows beyond the given number of entries.
+*/
+class th_rewriter_memo {
+    ast_manager &   m;
+    expr_ref_vector m_pinned;
+    u_map<expr*>    m_results;
+    std::string     m_config;
+    unsigned        m_max_size;
+public:
+    th_rewriter_memo(ast_manager & m, unsigned max_size = 1000000);
+    ast_manager & get_manager() const { return m; }
+    void set_config(std::string const & config);
+    bool find(expr * t, expr_ref & result) const;
+    void insert(expr * t, expr * result);
+    void reset();
+    unsigned size() const { return m_results.size(); }
+};
+
 class th_rewriter {
     struct     imp;
     imp *      m_imp;
     params_ref m_params;
+    th_rewriter_memo * m_memo;
+    bool use_memo() const;
+    void updt_memo_config();
 public:
     th_rewriter(ast_manager & m, params_ref const & p = params_ref());
     ~th_rewriter();
@@ -69,5 +97,11 @@ public:
 
     void set_solver(expr_solver* solver);
 
+    /**
+       \brief Use the given table for memoizing the results of top-level rewriting calls.
+       The table is not used when proofs are enabled or when a substitution is set.
+    */
+    void set_memo(th_rewriter_memo * memo);
+
 };
 
@@ -163,17 +163,54 @@ static bool is_escape_char(char const *& s, unsigned& result) {
     return false;
 }
 
+void zstring::init(svector<unsigned>& s) {
+    SASSERT(!m_chars);
+    m_offset = 0;
+    m_length = s.size();
+    if (s.empty())
+        return;
+    m_chars = alloc(chars);
+    m_chars->m_data.swap(s);
+    m_chars->m_ref = 1;
+}
+
+void zstring::dec_ref() {
+    if (m_chars && --m_chars->m_ref == 0)
+        dealloc(m_chars);
+    m_chars = nullptr;
+}
+
+zstring& zstring::operator=(zstring const& other) {
+    if (m_chars != other.m_chars) {
+        zstring tmp(other);
+        dec_ref();
+        std::swap(m_chars, tmp.m_chars);
+    }
+    m_offset = other.m_offset;
+    m_length = other.m_length;
+    return *this;
+}
+
 zstring::zstring(char const* s) {
+    svector<unsigned> buffer;
     while (*s) {
         unsigned ch = 0;
         if (is_escape_char(s, ch)) {
-            m_buffer.push_back(ch);
+            buffer.push_back(ch);
         }
         else {
-            m_buffer.push_back(*s);
+            buffer.push_back(*s);
             ++s;
         }
     }
+    init(buffer);
+    SASSERT(well_formed());
+}
+
+zstring::zstring(unsigned sz, unsigned const* s) {
+    svector<unsigned> buffer;
+    buffer.append(sz, s);
+    init(buffer);
     SASSERT(well_formed());
 }
 
@@ -183,54 +220,48 @@ zstring::zstring(unsigned num_bits, bool const* ch) {
     for (unsigned i = 0; i < num_bits; ++i) {
         n |= (((unsigned)ch[i]) << i);
     }
-    m_buffer.push_back(n);
+    svector<unsigned> buffer;
+    buffer.push_back(n);
+    init(buffer);
     SASSERT(well_formed());
 }
 
 bool zstring::well_formed() const {
-    for (unsigned ch : m_buffer) {
-        if (ch > max_char())
+    for (unsigned i = 0; i < length(); ++i) {
+        if ((*this)[i] > max_char())
             return false;
     }
     return true;
 }
 
 zstring::zstring(unsigned ch) {
-    m_buffer.push_back(ch);
+    svector<unsigned> buffer;
+    buffer.push_back(ch);
+    init(buffer);
 }
 
 zstring zstring::reverse() const {
-    zstring result;
+    svector<unsigned> buffer;
     for (unsigned i = length(); i-- > 0; ) {
-        result.m_buffer.push_back(m_buffer[i]);
+        buffer.push_back((*this)[i]);
     }
+    zstring result;
+    result.init(buffer);
     return result;
 }
 
 zstring zstring::replace(zstring const& src, zstring const& dst) const {
-    zstring result;
     if (length() < src.length()) {
         return zstring(*this);
     }
     if (src.length() == 0) {
         return dst + zstring(*this);
     }
-    bool found = false;
-    for (unsigned i = 0; i < length(); ++i) {
-        bool eq = !found && i + src.length() <= length();
-        for (unsigned j = 0; eq && j < src.length(); ++j) {
-            eq = m_buffer[i+j] == src[j];
-        }
-        if (eq) {
-            result.m_buffer.append(dst.m_buffer);
-            found = true;
-            i += src.length() - 1;
-        }
-        else {
-            result.m_buffer.push_back(m_buffer[i]);
-        }
+    int i = indexofu(src, 0);
+    if (i < 0) {
+        return zstring(*this);
     }
-    return result;
+    return extract(0, i) + dst + extract(i + src.length(), length());
 }
 
 static const char esc_table[32][6] =
@@ -243,8 +274,8 @@ std::string zstring::encode() const {
     char buffer[100];
     unsigned offset = 0;
 #define _flush() if (offset > 0) { buffer[offset] = 0; strm << buffer; offset = 0; }
-    for (unsigned i = 0; i < m_buffer.size(); ++i) {
-        unsigned ch = m_buffer[i];
+    for (unsigned i = 0; i < length(); ++i) {
+        unsigned ch = (*this)[i];
         if (0 <= ch && ch < 32) {
             _flush();
             strm << esc_table[ch];
@@ -276,7 +307,7 @@ bool zstring::suffixof(zstring const& other) const {
     if (length() > other.length()) return false;
     bool suffix = true;
     for (unsigned i = 0; suffix && i < length(); ++i) {
-        suffix = m_buffer[length()-i-1] == other[other.length()-i-1];
+        suffix = (*this)[length()-i-1] == other[other.length()-i-1];
     }
     return suffix;
 }
@@ -285,7 +316,7 @@ bool zstring::prefixof(zstring const& other) const {
     if (length() > other.length()) return false;
     bool prefix = true;
     for (unsigned i = 0; prefix && i < length(); ++i) {
-        prefix = m_buffer[i] == other[i];
+        prefix = (*this)[i] == other[i];
     }
     return prefix;
 }
@@ -297,7 +328,7 @@ bool zstring::contains(zstring const& other) const {
     for (unsigned i = 0; !cont && i <= last; ++i) {
         cont = true;
         for (unsigned j = 0; cont && j < other.length(); ++j) {
-            cont = other[j] == m_buffer[j+i];
+            cont = other[j] == (*this)[j+i];
         }
     }
     return cont;
@@ -312,7 +343,7 @@ int zstring::indexofu(zstring const& other, unsigned offset) const {
     for (unsigned i = offset; i <= last; ++i) {
         bool prefix = true;
         for (unsigned j = 0; prefix && j < other.length(); ++j) {
-            prefix = m_buffer[i + j] == other[j];
+            prefix = (*this)[i + j] == other[j];
         }
         if (prefix) {
             return static_cast<int>(i);
@@ -327,7 +358,7 @@ int zstring::last_indexof(zstring const& other) const {
     for (unsigned last = length() - other.length(); last-- > 0; ) {
         bool suffix = true;
         for (unsigned j = 0; suffix && j < other.length(); ++j) {
-            suffix = m_buffer[last + j] == other[j];
+            suffix = (*this)[last + j] == other[j];
         }
         if (suffix) {
             return static_cast<int>(last);
@@ -338,17 +369,30 @@ int zstring::last_indexof(zstring const& other) const {
 
 zstring zstring::extract(unsigned offset, unsigned len) const {
     zstring result;
-    if (offset + len < offset) return result;
-    int last = std::min(offset+len, length());
-    for (int i = offset; i < last; ++i) {
-        result.m_buffer.push_back(m_buffer[i]);
-    }
+    if (offset + len < offset || offset >= length()) return result;
+    len = std::min(len, length() - offset);
+    if (len == 0) return result;
+    result.m_chars = m_chars;
+    result.m_offset = m_offset + offset;
+    result.m_length = len;
+    result.inc_ref();
     return result;
 }
 
 zstring zstring::operator+(zstring const& other) const {
-    zstring result(*this);
-    result.m_buffer.append(other.m_buffer);
+    if (other.empty()) return *this;
+    if (empty()) return other;
+    // other extends this in the shared array
+    if (m_chars == other.m_chars && m_offset + m_length == other.m_offset) {
+        zstring result(*this);
+        result.m_length += other.m_length;
+        return result;
+    }
+    svector<unsigned> buffer;
+    buffer.append(length(), data());
+    buffer.append(other.length(), other.data());
+    zstring result;
+    result.init(buffer);
     return result;
 }
 
@@ -357,8 +401,12 @@ bool zstring::operator==(const zstring& other) const {
     if (length() != other.length()) {
         return false;
     }
+    if (m_chars == other.m_chars && m_offset == other.m_offset) {
+        return true;
+    }
+    unsigned const* a = data(), *b = other.data();
     for (unsigned i = 0; i < length(); ++i) {
-        if (m_buffer[i] != other[i]) {
+        if (a[i] != b[i]) {
             return false;
         }
     }
@@ -1027,8 +1075,24 @@ app* seq_decl_plugin::mk_string(symbol const& s) {
     return m_manager->mk_const(f);
 }
 
+void seq_decl_plugin::cache_string(symbol const& s, zstring const& str) {
+    if (m_strings.size() >= m_max_strings)
+        m_strings.reset();
+    m_strings.insert(s, str);
+}
+
+zstring seq_decl_plugin::get_string(symbol const& s) {
+    zstring result;
+    if (m_strings.find(s, result))
+        return result;
+    result = zstring(s.bare_str());
+    cache_string(s, result);
+    return result;
+}
+
 app* seq_decl_plugin::mk_string(zstring const& s) {
     symbol sym(s.encode());
+    cache_string(sym, s);
     parameter param(sym);
     func_decl* f = m_manager->mk_const_decl(m_stringc_sym, m_string,
                                             func_decl_info(m_family_id, OP_STRING_CONST, 1, &param));
@@ -1206,7 +1270,7 @@ app* seq_util::mk_lt(expr* ch1, expr* ch2) const {
 
 bool seq_util::str::is_string(func_decl const* f, zstring& s) const {
     if (is_string(f)) {
-        s = zstring(f->get_parameter(0).get_symbol().bare_str());
+        s = u.seq.get_string(f->get_parameter(0).get_symbol());
         return true;
     }
     else {
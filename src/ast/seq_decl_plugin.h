@@ -26,6 +26,7 @@ Revision History:
 #include "ast/bv_decl_plugin.h"
 #include <string>
 #include "util/lbool.h"
+#include "util/mutex.h"
 
 #define Z3_USE_UNICODE 0
 
@@ -116,24 +117,48 @@ enum seq_op_kind {
 };
 
 
+/**
+   \brief Immutable string of characters.
+
+   The characters are stored in a reference counted array that is shared
+   by copies and by substrings, so copying and extract take constant time.
+*/
 class zstring {
 private:
-    buffer<unsigned> m_buffer;
+    struct chars {
+        atomic<unsigned>  m_ref;
+        svector<unsigned> m_data;
+        chars(): m_ref(0) {}
+    };
+    chars*   m_chars { nullptr };
+    unsigned m_offset { 0 };
+    unsigned m_length { 0 };
+
+    void init(svector<unsigned>& s);
+    void inc_ref() { if (m_chars) m_chars->m_ref++; }
+    void dec_ref();
+    unsigned const* data() const { return m_chars ? m_chars->m_data.c_ptr() + m_offset : nullptr; }
     bool well_formed() const;
 public:
     static unsigned max_char() { return 196607; }
     zstring() {}
     zstring(char const* s);
     zstring(const std::string &str) : zstring(str.c_str()) {}
-    zstring(unsigned sz, unsigned const* s) { m_buffer.append(sz, s); SASSERT(well_formed()); }
+    zstring(unsigned sz, unsigned const* s);
     zstring(unsigned num_bits, bool const* ch);
     zstring(unsigned ch);
+    zstring(zstring const& other): m_chars(other.m_chars), m_offset(other.m_offset), m_length(other.m_length) { inc_ref(); }
+    zstring(zstring&& other) noexcept: m_chars(other.m_chars), m_offset(other.m_offset), m_length(other.m_length) {
+        other.m_chars = nullptr; other.m_offset = 0; other.m_length = 0;
+    }
+    ~zstring() { dec_ref(); }
+    zstring& operator=(zstring const& other);
     zstring replace(zstring const& src, zstring const& dst) const;
     zstring reverse() const;
     std::string encode() const;
-    unsigned length() const { return m_buffer.size(); }
-    unsigned operator[](unsigned i) const { return m_buffer[i]; }
-    bool empty() const { return m_buffer.empty(); }
+    unsigned length() const { return m_length; }
+    unsigned operator[](unsigned i) const { SASSERT(i < m_length); return m_chars->m_data[m_offset + i]; }
+    bool empty() const { return m_length == 0; }
     bool suffixof(zstring const& other) const;
     bool prefixof(zstring const& other) const;
     bool contains(zstring const& other) const;
@@ -174,6 +199,10 @@ class seq_decl_plugin : public decl_plugin {
     sort*            m_reglan;
     bool             m_has_re;
     bool             m_has_seq;
+    // decoded string constants, indexed by their encoding
+    map<symbol, zstring, symbol_hash_proc, symbol_eq_proc> m_strings;
+    unsigned         m_max_strings { 1 << 16 };
+    void cache_string(symbol const& s, zstring const& str);
 
     void match(psig& sig, unsigned dsz, sort* const* dom, sort* range, sort_ref& rng);
 
@@ -224,6 +253,7 @@ public:
 
     app* mk_string(symbol const& s);
     app* mk_string(zstring const& s);
+    zstring get_string(symbol const& s);
     app* mk_char(unsigned ch);
 
     bool has_re() const { return m_has_re; }
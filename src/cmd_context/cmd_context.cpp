@@ -752,6 +752,12 @@ void cmd_context::init_manager() {
         m_check_sat_result = nullptr;
         m_manager  = m_params.mk_ast_manager();
         m_pmanager = alloc(pdecl_manager, *m_manager);
+        if (m_manager->proofs_enabled() && !m_params.m_proof_stream_file.empty()) {
+            m_proof_stream_out = alloc(std::ofstream, m_params.m_proof_stream_file);
+            if (!*m_proof_stream_out)
+                throw cmd_exception("could not open proof stream file ", symbol(m_params.m_proof_stream_file.c_str()));
+            m_proof_stream = alloc(proof_stream_writer, *m_manager, *m_proof_stream_out);
+        }
         init_manager_core(true);
     }
 }
@@ -1296,6 +1302,8 @@ void cmd_context::reset(bool finalize) {
         dealloc(m_pmanager);
         m_pmanager = nullptr;
         if (m_own_manager) {
+            m_proof_stream = nullptr;
+            m_proof_stream_out = nullptr;
             dealloc(m_manager);
             m_manager = nullptr;
             m_manager_initialized = false;
@@ -1579,6 +1587,11 @@ void cmd_context::check_sat(unsigned num_assumptions, expr * const * assumptions
         validate_model();
     }
     validate_check_sat_result(r);
+    if (r == l_false && m_proof_stream) {
+        proof_ref pr(m_check_sat_result->get_proof(), m());
+        if (pr)
+            m_proof_stream->write_root(pr);
+    }
     model_ref md;
     if (r == l_true && m_params.m_dump_models && is_model_available(md)) {
         display_model(md);
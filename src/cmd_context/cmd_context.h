@@ -21,6 +21,7 @@ Notes:
 #pragma once
 
 #include<sstream>
+#include<fstream>
 #include<vector>
 #include "util/stopwatch.h"
 #include "util/cmd_context_types.h"
@@ -33,6 +34,7 @@ Notes:
 #include "ast/datatype_decl_plugin.h"
 #include "ast/recfun_decl_plugin.h"
 #include "ast/rewriter/seq_rewriter.h"
+#include "ast/proofs/proof_stream.h"
 #include "tactic/generic_model_converter.h"
 #include "solver/solver.h"
 #include "solver/progress_callback.h"
@@ -264,6 +266,9 @@ protected:
     scoped_ptr<pp_env>            m_pp_env;
     pp_env & get_pp_env() const;
 
+    scoped_ptr<std::ofstream>       m_proof_stream_out;
+    scoped_ptr<proof_stream_writer> m_proof_stream;
+
     void register_builtin_sorts(decl_plugin * p);
     void register_builtin_ops(decl_plugin * p);
     void load_plugin(symbol const & name, bool install_names, svector<family_id>& fids);
@@ -40,5 +40,11 @@ class boolean_algebra : public positive_boolean_algebra<T> {
 public:
     ~boolean_algebra() override {}
     virtual T mk_not(T x) = 0;
+
+    // Algebras over ordered domains, such as characters, can expose
+    // predicates that denote an interval [lo, hi] of the domain.
+    // Min-terms of intervals are then computed without satisfiability checks.
+    virtual bool is_interval(T x, unsigned& lo, unsigned& hi) { return false; }
+    virtual T mk_interval(unsigned lo, unsigned hi) { UNREACHABLE(); return this->mk_false(); }
 };
 
@@ -21,6 +21,8 @@ Revision History:
 #pragma once
 
 
+#include <algorithm>
+#include "util/map.h"
 #include "math/automata/automaton.h"
 #include "math/automata/boolean_algebra.h"
 
@@ -109,14 +111,89 @@ private:
     
     vector<std::pair<vector<bool>, ref_t> > generate_min_terms(vector<ref_t> &constraints) {
         vector<std::pair<vector<bool>, ref_t> > min_terms;
-        
+        if (generate_interval_min_terms(constraints, min_terms))
+            return min_terms;
+
+        // split on each distinct constraint once
+        vector<ref_t> distinct;
+        unsigned_vector idx;
+        ptr_addr_map<T, unsigned> c2idx;
+        for (ref_t& c : constraints) {
+            unsigned j;
+            if (!c2idx.find(c.get(), j)) {
+                j = distinct.size();
+                c2idx.insert(c.get(), j);
+                distinct.push_back(c);
+            }
+            idx.push_back(j);
+        }
+
         ref_t curr_pred(m_ba.mk_true(), m);
         vector<bool> curr_bv;
         
-        generate_min_terms_rec(constraints, min_terms, 0, curr_bv, curr_pred);
+        generate_min_terms_rec(distinct, min_terms, 0, curr_bv, curr_pred);
+        if (distinct.size() < constraints.size()) {
+            for (auto& mt : min_terms) {
+                vector<bool> bv;
+                for (unsigned j : idx)
+                    bv.push_back(mt.first[j]);
+                mt.first = bv;
+            }
+        }
         
         return min_terms;
     }
+
+    /**
+       \brief min-terms of interval constraints: the end points of the
+       intervals split the domain into elementary intervals, each contained
+       in or disjoint from every constraint. Return false if some constraint
+       is not an interval.
+    */
+    bool generate_interval_min_terms(vector<ref_t> &constraints, vector<std::pair<vector<bool>, ref_t> > &min_terms) {
+        if (constraints.empty())
+            return false;
+        svector<unsigned_pair> ivs;
+        unsigned_vector pts;
+        for (ref_t& c : constraints) {
+            unsigned lo, hi;
+            if (!m_ba.is_interval(c.get(), lo, hi) || lo > hi || hi == UINT_MAX)
+                return false;
+            ivs.push_back(unsigned_pair(lo, hi));
+            pts.push_back(lo);
+            pts.push_back(hi + 1);
+        }
+        std::sort(pts.begin(), pts.end());
+        unsigned j = 0;
+        for (unsigned p : pts)
+            if (j == 0 || pts[j - 1] != p)
+                pts[j++] = p;
+        pts.shrink(j);
+        for (unsigned k = 0; k + 1 < pts.size(); ++k) {
+            unsigned lo = pts[k], hi = pts[k + 1] - 1;
+            vector<bool> bv;
+            bool covered = false;
+            for (unsigned_pair const& iv : ivs) {
+                bool in = iv.first <= lo && hi <= iv.second;
+                bv.push_back(in);
+                covered |= in;
+            }
+            if (covered)
+                min_terms.push_back(std::pair<vector<bool>, ref_t>(bv, ref_t(m_ba.mk_interval(lo, hi), m)));
+        }
+        // the complement of all constraints
+        refs_t cs(m);
+        for (ref_t& c : constraints)
+            cs.push_back(c);
+        ref_t none(m_ba.mk_not(m_ba.mk_or(cs.size(), cs.c_ptr())), m);
+        lbool is_sat = m_ba.is_sat(none);
+        if (is_sat == l_undef)
+            throw default_exception("incomplete theory: unable to generate min-terms");
+        if (is_sat == l_true)
+            min_terms.push_back(std::pair<vector<bool>, ref_t>(vector<bool>(constraints.size(), false), none));
+        return true;
+    }
+
     void generate_min_terms_rec(vector<ref_t> &constraints, vector<std::pair<vector<bool>, ref_t> > &min_terms, unsigned i, vector<bool> &curr_bv, ref_t &curr_pred) {
         lbool is_sat = m_ba.is_sat(curr_pred);
         if (is_sat == l_undef)
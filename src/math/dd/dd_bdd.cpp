@@ -202,6 +202,10 @@ namespace dd {
             result->m_op = op;
         }
         else {
+            // keep the operation cache proportional to the node table.
+            if (m_op_cache.size() > std::max(1024u, 2 * m_nodes.size())) {
+                flush_op_cache();
+            }
             void * mem = m_alloc.allocate(sizeof(op_entry));
             result = new (mem) op_entry(l, r, op);
         }
@@ -209,6 +213,31 @@ namespace dd {
         return result;
     }
 
+    /**
+       remove the completed entries from the operation cache.
+       Entries of operations that are still in progress are kept.
+     */
+    void bdd_manager::flush_op_cache() {
+        m_stats.m_max_op_cache = std::max(m_stats.m_max_op_cache, m_op_cache.size());
+        m_stats.m_num_cache_flush++;
+        ptr_vector<op_entry> to_delete, to_keep;
+        for (auto* e : m_op_cache) {            
+            if (e->m_result != null_bdd) {
+                to_delete.push_back(e);
+            }
+            else {
+                to_keep.push_back(e);
+            }
+        }
+        m_op_cache.reset();
+        for (op_entry* e : to_delete) {
+            m_alloc.deallocate(sizeof(*e), e);
+        }
+        for (op_entry* e : to_keep) {
+            m_op_cache.insert(e);
+        }
+    }
+
     void bdd_manager::push_entry(op_entry* e) {
         SASSERT(!m_spare_entry);
         m_spare_entry = e;
@@ -240,6 +269,7 @@ namespace dd {
                 throw mem_out();
             }
             alloc_free_nodes(m_nodes.size()/2);
+            m_stats.m_max_num_nodes = std::max(m_stats.m_max_num_nodes, m_nodes.size());
         }
 
         SASSERT(!m_free_nodes.empty());
@@ -263,6 +293,7 @@ namespace dd {
 
     void bdd_manager::try_reorder() {
         gc();        
+        m_stats.m_num_reorder++;
         for (auto* e : m_op_cache) {
             m_alloc.deallocate(sizeof(*e), e);
         }
@@ -746,6 +777,7 @@ namespace dd {
     }
 
     void bdd_manager::gc() {
+        m_stats.m_num_gc++;
         m_free_nodes.reset();
         IF_VERBOSE(13, verbose_stream() << "(bdd :gc " << m_nodes.size() << ")\n";);
         bool_vector reachable(m_nodes.size(), false);
@@ -784,22 +816,7 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
-        ptr_vector<op_entry> to_delete, to_keep;
-        for (auto* e : m_op_cache) {            
-            if (e->m_result != null_bdd) {
-                to_delete.push_back(e);
-            }
-            else {
-                to_keep.push_back(e);
-            }
-        }
-        m_op_cache.reset();
-        for (op_entry* e : to_delete) {
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        for (op_entry* e : to_keep) {
-            m_op_cache.insert(e);
-        }
+        flush_op_cache();
 
         m_node_table.reset();
         // re-populate node cache
@@ -812,6 +829,17 @@ namespace dd {
         SASSERT(well_formed());
     }
 
+    void bdd_manager::collect_statistics(statistics& st) const {
+        st.update("bdd nodes", m_nodes.size() - m_free_nodes.size());
+        st.update("bdd max nodes", std::max(m_stats.m_max_num_nodes, m_nodes.size()));
+        st.update("bdd op cache", m_op_cache.size());
+        st.update("bdd max op cache", std::max(m_stats.m_max_op_cache, m_op_cache.size()));
+        st.update("bdd gc", m_stats.m_num_gc);
+        st.update("bdd reorder", m_stats.m_num_reorder);
+        st.update("bdd cache flush", m_stats.m_num_cache_flush);
+        st.update("bdd memory kb", static_cast<unsigned>((m_nodes.size() * sizeof(bdd_node) + m_alloc.get_allocation_size()) >> 10));
+    }
+
     void bdd_manager::init_mark() {
         m_mark.resize(m_nodes.size());
         ++m_mark_level;
@@ -21,6 +21,8 @@ Revision History:
 #include "util/vector.h"
 #include "util/map.h"
 #include "util/small_object_allocator.h"
+#include "util/statistics.h"
+#include <cstring>
 
 namespace dd {
 
@@ -101,7 +103,7 @@ namespace dd {
 
         struct eq_entry {
             bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_bdd1 == b->m_bdd2 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
+                return a->m_bdd1 == b->m_bdd1 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
             }
         };
 
@@ -130,6 +132,17 @@ namespace dd {
         cost_metric                m_cost_metric;
         BDD                        m_cost_bdd;
 
+        struct stats {
+            unsigned m_num_gc;
+            unsigned m_num_reorder;
+            unsigned m_num_cache_flush;
+            unsigned m_max_num_nodes;
+            unsigned m_max_op_cache;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+        stats                      m_stats;
+
         BDD make_node(unsigned level, BDD l, BDD r);
         bool is_new_node() const { return m_is_new_node; }
 
@@ -148,6 +161,7 @@ namespace dd {
 
         op_entry* pop_entry(BDD l, BDD r, BDD op);
         void push_entry(op_entry* e);
+        void flush_op_cache();
         bool check_result(op_entry*& e1, op_entry const* e2, BDD a, BDD b, BDD c);
         
         double count(BDD b, unsigned z);
@@ -225,6 +239,9 @@ namespace dd {
         void gc();
         void try_reorder();
         void try_cnf_reorder(bdd const& b);
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics() { m_stats.reset(); }
     };
 
     class bdd {
@@ -160,12 +160,15 @@ namespace dd {
         switch (op) {
         case pdd_sub_op:
             if (is_zero(q)) return p;
+            if (p == q) return zero_pdd;
             if (is_val(p) && is_val(q)) return imk_val(val(p) - val(q));
             if (m_semantics != mod2_e) break;
             op = pdd_add_op;
         case pdd_add_op:
             if (is_zero(p)) return q;
             if (is_zero(q)) return p;
+            // over GF(2) p + p = 0
+            if (p == q && m_semantics == mod2_e) return zero_pdd;
             if (is_val(p) && is_val(q)) return imk_val(val(p) + val(q));
             if (is_val(p)) std::swap(p, q);
             else if (!is_val(q) && level(p) < level(q)) std::swap(p, q);            
@@ -174,6 +177,8 @@ namespace dd {
             if (is_zero(p) || is_zero(q)) return zero_pdd;
             if (is_one(p)) return q;
             if (is_one(q)) return p;
+            // over GF(2) with 0/1 variables p * p = p
+            if (p == q && m_semantics == mod2_e) return p;
             if (is_val(p) && is_val(q)) return imk_val(val(p) * val(q));
             if (is_val(p)) std::swap(p, q);
             else if (!is_val(q) && level(p) < level(q)) std::swap(p, q);            
@@ -306,25 +306,32 @@ namespace dd {
         m_levelp1 = m_level2var.size();
     }
 
+    /*
+      pick the simplest equation whose leading variable has the highest level below m_levelp1.
+      A single pass over m_to_simplify finds it, instead of one pass per level.
+     */
     solver::equation* solver::pick_next() {
-        while (m_levelp1 > 0) {
-            unsigned v = m_level2var[m_levelp1-1];
-            equation* eq = nullptr;
-            for (equation* curr : m_to_simplify) {
-                SASSERT(curr->idx() != UINT_MAX);
-                pdd const& p = curr->poly();
-                if (curr->state() == to_simplify && p.var() == v) {
-                    if (!eq || is_simpler(*curr, *eq))
-                        eq = curr;
-                }
+        equation* eq = nullptr;
+        unsigned eq_level = 0;
+        for (equation* curr : m_to_simplify) {
+            SASSERT(curr->idx() != UINT_MAX);
+            if (curr->state() != to_simplify) 
+                continue;
+            unsigned l = m_var2level[curr->poly().var()];
+            if (l >= m_levelp1)
+                continue;
+            if (!eq || l > eq_level || (l == eq_level && is_simpler(*curr, *eq))) {
+                eq = curr;
+                eq_level = l;
             }
-            if (eq) {
-                pop_equation(eq);
-                return eq;
-            }
-            --m_levelp1;
         }
-        return nullptr;
+        if (!eq) {
+            m_levelp1 = 0;
+            return nullptr;
+        }
+        m_levelp1 = eq_level + 1;
+        pop_equation(eq);
+        return eq;
     }
 
     solver::equation_vector const& solver::equations() {
@@ -651,7 +651,10 @@ hilbert_basis::hilbert_basis(reslimit& lim):
     m_limit(lim),
     m_use_support(true),
     m_use_ordered_support(true),
-    m_use_ordered_subsumption(true)
+    m_use_ordered_subsumption(true),
+    m_current_ineq(0),
+    m_num_saturated(0),
+    m_store_ineqs(0)
 {
     m_index = alloc(index, *this);
     m_passive = alloc(passive, *this);
@@ -692,7 +695,7 @@ void hilbert_basis::reset() {
     }
     m_ints.reset();
     m_current_ineq = 0;
-    
+    m_num_saturated = 0;
 }
 
 void hilbert_basis::collect_statistics(statistics& st) const {
@@ -756,6 +759,7 @@ void hilbert_basis::set_is_int(unsigned var_index) {
     // coefficient. Shift indices by 1.
     //
     m_ints.push_back(var_index+1);
+    m_num_saturated = 0;
 }
 
 bool hilbert_basis::get_is_int(unsigned var_index) const {    
@@ -780,6 +784,7 @@ void hilbert_basis::init_basis() {
     m_basis.reset();
     m_store.reset();
     m_free_list.reset();
+    m_store_ineqs = m_ineqs.size();
     unsigned nv = get_num_vars();
     for (unsigned i = 0; i < nv; ++i) {
         add_unit_vector(i, numeral(1));
@@ -789,6 +794,29 @@ void hilbert_basis::init_basis() {
     }
 }
  
+/**
+   \brief Move the basis to a store laid out for the current number of
+   inequalities. The weights are recomputed by saturate.
+*/
+void hilbert_basis::extend_basis() {
+    num_vector store;
+    svector<offset_t> basis;
+    store.swap(m_store);
+    basis.swap(m_basis);
+    m_free_list.reset();
+    unsigned old_ineqs = m_store_ineqs;
+    m_store_ineqs = m_ineqs.size();
+    unsigned nv = get_num_vars();
+    for (offset_t offs : basis) {
+        offset_t idx = alloc_vector();
+        values v = vec(idx);
+        for (unsigned j = 0; j < nv; ++j) {
+            v[j] = store[offs.m_offset + old_ineqs + j];
+        }
+        m_basis.push_back(idx);
+    }
+}
+
 void hilbert_basis::add_unit_vector(unsigned i, numeral const& e) {
     unsigned num_vars = get_num_vars();
     num_vector w(num_vars, numeral(0));
@@ -802,8 +830,14 @@ void hilbert_basis::add_unit_vector(unsigned i, numeral const& e) {
 }
 
 lbool hilbert_basis::saturate() {
-    init_basis();
-    m_current_ineq = 0;
+    if (m_num_saturated == 0) {
+        init_basis();
+    }
+    else if (m_store_ineqs != m_ineqs.size()) {
+        extend_basis();
+    }
+    m_current_ineq = m_num_saturated;
+    m_num_saturated = 0;
     while (checkpoint() && m_current_ineq < m_ineqs.size()) {
         select_inequality();
         stopwatch sw;
@@ -826,6 +860,7 @@ lbool hilbert_basis::saturate() {
     if (!checkpoint()) {
         return l_undef;
     }
+    m_num_saturated = m_current_ineq;
     return l_true;
 }
 
@@ -101,6 +101,8 @@ class hilbert_basis {
     index*             m_index;      // index of generated vectors
     unsigned_vector    m_ints;       // indices that can be both positive and negative
     unsigned           m_current_ineq;
+    unsigned           m_num_saturated;  // number of inequalities the current basis is saturated for.
+    unsigned           m_store_ineqs;    // number of inequalities when the vectors in the store were allocated.
     
     bool               m_use_support;             // parameter: (associativity) resolve only against vectors that are initially in basis.
     bool               m_use_ordered_support;     // parameter: (commutativity) resolve in order
@@ -124,6 +126,7 @@ class hilbert_basis {
     lbool saturate(num_vector const& ineq, bool is_eq);
     lbool saturate_orig(num_vector const& ineq, bool is_eq);
     void init_basis();
+    void extend_basis();
     void select_inequality();
     unsigned get_num_nonzeros(num_vector const& ineq);
     unsigned get_ineq_product(num_vector const& ineq);
@@ -184,6 +187,12 @@ public:
     void set_is_int(unsigned var_index);
     bool get_is_int(unsigned var_index) const;
 
+    /**
+       \brief Compute the Hilbert basis of the inequalities.
+       The basis of a previous successful call is reused when inequalities
+       were only added since then, and only the new inequalities are
+       saturated.
+    */
     lbool saturate();
 
     unsigned get_basis_size() const { return m_basis.size(); }
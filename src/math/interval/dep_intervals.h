@@ -24,6 +24,7 @@
 #include "util/region.h"
 #include "util/rational.h"
 #include "util/rlimit.h"
+#include "util/map.h"
 #include "math/interval/interval.h"
 
 class dep_intervals {
@@ -146,12 +147,20 @@ public:
     mutable u_dependency_manager        m_dep_manager;
     im_config                           m_config;
     mutable interval_manager<im_config> m_imanager;
+    u_map<u_dependency*>                m_leaves; // leaves allocated since the last reset, shared by all intervals
 
 
     unsynch_mpq_manager& num_manager() { return m_num_manager; }
     const unsynch_mpq_manager& num_manager() const { return m_num_manager; }
     
-    u_dependency* mk_leaf(unsigned d) { return m_dep_manager.mk_leaf(d); }
+    u_dependency* mk_leaf(unsigned d) { 
+        u_dependency* r = nullptr;
+        if (!m_leaves.find(d, r)) {
+            r = m_dep_manager.mk_leaf(d);
+            m_leaves.insert(d, r);
+        }
+        return r;
+    }
     u_dependency* mk_join(u_dependency* a, u_dependency* b) { return m_dep_manager.mk_join(a, b); }
 
 
@@ -342,7 +351,7 @@ public:
             expl.push_back(ci);
     }
 
-    void reset() { m_dep_manager.reset(); }
+    void reset() { m_dep_manager.reset(); m_leaves.reset(); }
 
     void del(interval& i) { m_imanager.del(i); }
     
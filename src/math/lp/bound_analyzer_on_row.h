@@ -35,6 +35,11 @@ class bound_analyzer_on_row {
     // -1 means that such a value is not found, -2 means that at least two of such monoids were found
     int                                m_column_of_l; // index of an unlimited from below monoid
     impq                               m_rs;
+    // sums of the maximal (minimal) values of the monoids that are bounded from above (below),
+    // and the number of strict bounds in each sum
+    mpq                                m_sum_max, m_sum_min;
+    int                                m_strict_max, m_strict_min;
+    mpq                                m_coeff_of_u, m_coeff_of_l;
 
 public :
     // constructor
@@ -50,7 +55,9 @@ public :
         m_row_index(row_or_term_index),
         m_column_of_u(-1),
         m_column_of_l(-1),
-        m_rs(rs)
+        m_rs(rs),
+        m_strict_max(0),
+        m_strict_min(0)
     {}
 
     
@@ -65,11 +72,27 @@ public :
 
 private:
 
+    // A single pass over the row finds the unbounded monoids and sums up the bounded ones,
+    // so limit_monoid_u_from_below and limit_monoid_l_from_above need no further pass
+    // and limit_all_monoids_from_below/above need one pass each.
     void analyze() {
         for (const auto & c : m_row) {
             if ((m_column_of_l == -2) && (m_column_of_u == -2))
                 return;
-            analyze_bound_on_var_on_coeff(c.var(), c.coeff());
+            unsigned j = c.var();
+            const mpq & a = c.coeff();
+            analyze_bound_on_var_on_coeff(j, a);
+            bool str;
+            if (m_column_of_u != -2 && (is_pos(a) ? upper_bound_is_available(j) : lower_bound_is_available(j))) {
+                m_sum_max += monoid_max(a, j, str);
+                if (str)
+                    m_strict_max++;
+            }
+            if (m_column_of_l != -2 && (is_pos(a) ? lower_bound_is_available(j) : upper_bound_is_available(j))) {
+                m_sum_min += monoid_min(a, j, str);
+                if (str)
+                    m_strict_min++;
+            }
         }
         if (m_column_of_u >= 0)
             limit_monoid_u_from_below();
@@ -165,16 +188,8 @@ private:
     
     mpq m_total, m_bound;
     void limit_all_monoids_from_above() {
-        int strict = 0;
-        m_total.reset();
-        lp_assert(is_zero(m_total));
-        for (const auto& p : m_row) {
-            bool str;
-            m_total -= monoid_min(p.coeff(), p.var(), str);
-            if (str)
-                strict++;
-        }
-        
+        int strict = m_strict_min;
+        m_total = -m_sum_min;
         for (const auto &p : m_row) {
             bool str;
             bool a_is_pos = is_pos(p.coeff());
@@ -191,16 +206,8 @@ private:
     }
 
     void limit_all_monoids_from_below() {
-        int strict = 0;
-        m_total.reset();
-        lp_assert(is_zero(m_total));
-        for (const auto &p : m_row) {
-            bool str;
-            m_total -= monoid_max(p.coeff(), p.var(), str);
-            if (str)
-                strict++;
-        }
-
+        int strict = m_strict_max;
+        m_total = -m_sum_max;
         for (const auto& p : m_row) {
             bool str;
             bool a_is_pos = is_pos(p.coeff());
@@ -221,22 +228,10 @@ private:
     void limit_monoid_u_from_below() {
         // we are going to limit from below the monoid m_column_of_u,
         // every other monoid is impossible to limit from below
-        mpq u_coeff;
-        unsigned j;
+        const mpq & u_coeff = m_coeff_of_u;
         m_bound = -m_rs.x;
-        bool strict = false;
-        for (const auto& p : m_row) {
-            j = p.var();
-            if (j == static_cast<unsigned>(m_column_of_u)) {
-                u_coeff = p.coeff();
-                continue;
-            }
-            bool str;
-            m_bound -= monoid_max(p.coeff(), j, str);
-            if (str)
-                strict = true;
-        }
-
+        m_bound -= m_sum_max;
+        bool strict = m_strict_max > 0;
         m_bound /= u_coeff;
         
         if (u_coeff.is_pos()) {
@@ -250,22 +245,10 @@ private:
     void limit_monoid_l_from_above() {
         // we are going to limit from above the monoid m_column_of_l,
         // every other monoid is impossible to limit from above
-        mpq l_coeff;
-        unsigned j;
+        const mpq & l_coeff = m_coeff_of_l;
         m_bound = -m_rs.x;
-        bool strict = false;
-        for (const auto &p : m_row) {
-            j = p.var();
-            if (j == static_cast<unsigned>(m_column_of_l)) {
-                l_coeff = p.coeff();
-                continue;
-            }
-
-            bool str;
-            m_bound -= monoid_min(p.coeff(), j, str);
-            if (str)
-                strict = true;
-        }
+        m_bound -= m_sum_min;
+        bool strict = m_strict_min > 0;
         m_bound /= l_coeff;
         if (is_pos(l_coeff)) {
             limit_j(m_column_of_l, m_bound, true, false, strict);
@@ -297,31 +280,41 @@ private:
         m_bp.try_add_bound(u, j, is_lower_bound, coeff_before_j_is_pos, m_row_index, strict);
     }
     
-    void advance_u(unsigned j) {
-        m_column_of_u = (m_column_of_u == -1) ? j : -2;
+    void advance_u(unsigned j, const mpq & a) {
+        if (m_column_of_u == -1) {
+            m_column_of_u = j;
+            m_coeff_of_u = a;
+        }
+        else
+            m_column_of_u = -2;
     }
     
-    void advance_l(unsigned j) {
-        m_column_of_l = (m_column_of_l == -1) ? j : -2;
+    void advance_l(unsigned j, const mpq & a) {
+        if (m_column_of_l == -1) {
+            m_column_of_l = j;
+            m_coeff_of_l = a;
+        }
+        else
+            m_column_of_l = -2;
     }
     
     void analyze_bound_on_var_on_coeff(int j, const mpq &a) {
         switch (m_bp.get_column_type(j)) {
         case column_type::lower_bound:
             if (numeric_traits<mpq>::is_pos(a))
-                advance_u(j);
+                advance_u(j, a);
             else 
-                advance_l(j);
+                advance_l(j, a);
             break;
         case column_type::upper_bound:
             if (numeric_traits<mpq>::is_neg(a))
-                advance_u(j);
+                advance_u(j, a);
             else
-                advance_l(j);
+                advance_l(j, a);
             break;
         case column_type::free_column:
-            advance_u(j);
-            advance_l(j);
+            advance_u(j, a);
+            advance_l(j, a);
             break;
         default:
             break;
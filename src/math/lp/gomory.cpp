@@ -21,6 +21,8 @@
 #include "math/lp/int_solver.h"
 #include "math/lp/lar_solver.h"
 #include "math/lp/lp_utils.h"
+#include <algorithm>
+#include <cmath>
 
 #define SMALL_CUTS 1
 namespace lp {
@@ -287,6 +289,14 @@ public:
         out << "inf_col = " << m_inf_col << std::endl;
     }
 
+    // the cut is t >= k, so it has to cut off the current solution
+    bool current_solution_is_inf_on_cut() const {
+        impq v;
+        for (const auto & p : m_t)
+            v += get_value(p.column().index()) * p.coeff();
+        return v < impq(m_k);
+    }
+
     lia_move cut() {
         TRACE("gomory_cut", dump(tout););
         
@@ -346,7 +356,7 @@ public:
         if (some_int_columns)
             adjust_term_and_k_for_some_ints_case_gomory();
         TRACE("gomory_cut_detail", dump_cut_and_constraints_as_smt_lemma(tout););
-        lp_assert(lia.current_solution_is_inf_on_cut());  // checks that indices are columns
+        lp_assert(current_solution_is_inf_on_cut());
         TRACE("gomory_cut", print_linear_combination_of_column_indices_only(m_t.coeffs_as_vector(), tout << "gomory cut:"); tout << " <= " << m_k << std::endl;);
         return lia_move::cut;
     }
@@ -384,70 +394,90 @@ bool gomory::is_gomory_cut_target(const row_strip<mpq>& row) {
     return true;
 }
 
-int gomory::find_basic_var() {
-    int result = -1;
-    unsigned n = 0;
-    unsigned min_row_size = UINT_MAX;
-#if 0
-    bool boxed = false;
-    mpq min_range;
-#endif
-
-
-    // Prefer smaller row size
-    // Prefer boxed to non-boxed
-    // Prefer smaller ranges
-
+/**
+   Collect up to max_num basic integer infeasible columns whose rows are
+   Gomory cut targets, preferring short rows.
+*/
+void gomory::find_basic_vars(unsigned max_num, unsigned_vector& result) {
+    svector<std::pair<unsigned, unsigned>> cands; // (row size, column)
     for (unsigned j : lra.r_basis()) {
         if (!lia.column_is_int_inf(j))
             continue;
         const row_strip<mpq>& row = lra.get_row(lia.row_of_basic_column(j));
         if (!is_gomory_cut_target(row)) 
             continue;
+        cands.push_back(std::make_pair(row.size(), j));
+    }
+    // random tie breaking among rows of equal size
+    for (unsigned i = cands.size(); i > 1; --i)
+        std::swap(cands[i - 1], cands[lia.random() % i]);
+    unsigned n = std::min(max_num, cands.size());
+    std::partial_sort(cands.begin(), cands.begin() + n, cands.end(),
+                      [](std::pair<unsigned, unsigned> const& a, std::pair<unsigned, unsigned> const& b) { return a.first < b.first; });
+    for (unsigned i = 0; i < n; ++i)
+        result.push_back(cands[i].second);
+}
 
-#if 0
-        if (is_boxed(j) && (min_row_size == UINT_MAX || 4*row.size() < 5*min_row_size)) {
-            lar_core_solver & lcs = lra.m_mpq_lar_core_solver;
-            auto new_range = lclia.m_r_upper_bounds()[j].x - lclia.m_r_lower_bounds()[j].x;
-            if (!boxed) {
-                result = j;
-                n = 1;
-                min_row_size = row.size();
-                boxed = true;
-                min_range = new_range;
-                continue;
-            }
-            if (min_range > 2*new_range || ((5*min_range > 4*new_range && (random() % (++n)) == 0))) { 
-                result = j;
-                n = 1;
-                min_row_size = row.size();
-                min_range = std::min(min_range, new_range);
-                continue;
-            }
-        }
-#endif
-
-        if (min_row_size == UINT_MAX || 
-            2*row.size() < min_row_size || 
-            (4*row.size() < 5*min_row_size && lia.random() % (++n) == 0)) {
-            result = j;
-            n = 1;
-            min_row_size = std::min(min_row_size, row.size());
-        }
+/**
+   The distance between the current solution, which violates t >= k, and the cut hyperplane.
+*/
+double gomory::efficacy(const lar_term & t, const mpq & k) const {
+    mpq val(0);
+    double norm = 0;
+    for (const auto & p : t) {
+        val += p.coeff() * lia.get_value(p.column().index()).x;
+        double c = p.coeff().get_double();
+        norm += c * c;
     }
-    return result;
+    if (norm == 0)
+        return 0;
+    return (k - val).get_double() / std::sqrt(norm);
 }
-    
-lia_move gomory::operator()() {
-    lra.move_non_basic_columns_to_bounds();
-    int j = find_basic_var();
-    if (j == -1) return lia_move::undef;
-    unsigned r = lia.row_of_basic_column(j);
+
+lia_move gomory::cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j) {
+    unsigned r = lia.row_of_basic_column(basic_inf_int_j);
     const row_strip<mpq>& row = lra.get_row(r);
     SASSERT(lra.row_is_correct(r));
     SASSERT(is_gomory_cut_target(row));
+    return cut(t, k, ex, basic_inf_int_j, row);
+}
+
+/**
+   Create cuts from several candidate rows and return the one with
+   the largest efficacy. A conflict found on any row is returned at once.
+*/
+lia_move gomory::operator()() {
+    const unsigned max_candidates = 4;
+    lra.move_non_basic_columns_to_bounds();
+    unsigned_vector cands;
+    find_basic_vars(max_candidates, cands);
+    if (cands.empty()) return lia_move::undef;
     lia.m_upper = false;
-    return cut(lia.m_t, lia.m_k, lia.m_ex, j, row);
+    if (cands.size() == 1)
+        return cut(lia.m_t, lia.m_k, lia.m_ex, cands[0]);
+    int best = -1;
+    double best_efficacy = 0;
+    lar_term t;
+    mpq k;
+    explanation ex;
+    for (unsigned j : cands) {
+        ex.clear();
+        lia_move r = cut(t, k, &ex, j);
+        if (r == lia_move::conflict) 
+            return cut(lia.m_t, lia.m_k, lia.m_ex, j);
+        if (r != lia_move::cut)
+            continue;
+        double e = efficacy(t, k);
+        TRACE("gomory_cut", tout << "column " << j << " efficacy " << e << "\n";);
+        if (best == -1 || e > best_efficacy) {
+            best = j;
+            best_efficacy = e;
+        }
+    }
+    if (best == -1)
+        return lia_move::undef;
+    lia.m_ex->clear();
+    return cut(lia.m_t, lia.m_k, lia.m_ex, best);
 }
 
 
@@ -27,9 +27,11 @@ namespace lp {
     class gomory {
         class int_solver& lia;
         class lar_solver& lra;
-        int find_basic_var();
+        void find_basic_vars(unsigned max_num, unsigned_vector& result);
         bool is_gomory_cut_target(const row_strip<mpq>& row);
         lia_move cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j, const row_strip<mpq>& row);
+        lia_move cut(lar_term & t, mpq & k, explanation* ex, unsigned basic_inf_int_j);
+        double efficacy(const lar_term & t, const mpq & k) const;
     public:
         gomory(int_solver& lia);
         ~gomory() {}
@@ -67,6 +67,42 @@ bool horner::row_is_interesting(const T& row) const {
     return false;
 }
 
+unsigned horner::bounds_hash(lpvar j) const {
+    const lp::lar_solver& s = c().m_lar_solver;
+    unsigned h = j;
+    if (s.column_has_lower_bound(j)) {
+        const auto& b = s.get_lower_bound(j);
+        h = combine_hash(h, combine_hash(b.x.hash(), b.y.hash()));
+    }
+    else
+        h = combine_hash(h, 1);
+    if (s.column_has_upper_bound(j)) {
+        const auto& b = s.get_upper_bound(j);
+        h = combine_hash(h, combine_hash(b.x.hash(), b.y.hash()));
+    }
+    else
+        h = combine_hash(h, 2);
+    return h;
+}
+
+// The intervals of a row depend only on its coefficients and on the bounds of the variables
+// of its monomials. A row with an unchanged signature gives the same intervals.
+template <typename T>
+unsigned horner::row_signature(const T& row) const {
+    unsigned h = row.size();
+    for (const auto& p : row) {
+        lpvar j = p.var();
+        h = combine_hash(h, combine_hash(j, p.coeff().hash()));
+        if (!c().is_monic_var(j)) {
+            h = combine_hash(h, bounds_hash(j));
+            continue;
+        }
+        for (lpvar k : c().emons()[j].vars())
+            h = combine_hash(h, bounds_hash(k));
+    }
+    return h;
+}
+
 bool horner::lemmas_on_expr(cross_nested& cn, nex_sum* e) {
     TRACE("nla_horner", tout << "e = " << *e << "\n";);
     cn.run(e);
@@ -122,10 +158,19 @@ bool horner::horner_lemmas() {
     bool conflict = false;
     for (unsigned i = 0; i < sz && !conflict; i++) {
         m_row_index = rows[(i + r) % sz];
-        if (lemmas_on_row(matrix.m_rows[m_row_index])) {
+        const auto& row = matrix.m_rows[m_row_index];
+        unsigned sig = row_signature(row), old_sig;
+        if (m_row_signatures.find(m_row_index, old_sig) && old_sig == sig) {
+            c().lp_settings().stats().m_horner_rows_skipped++;
+            continue;
+        }
+        if (lemmas_on_row(row)) {
             c().lp_settings().stats().m_horner_conflicts++;
+            m_row_signatures.erase(m_row_index);
             conflict = true;
         }
+        else
+            m_row_signatures.insert(m_row_index, sig);
     }
     return conflict;
 }
@@ -32,6 +32,11 @@ class core;
 class horner : common {
     nex_creator::sum_factory  m_row_sum;
     unsigned         m_row_index;                      
+    // rows on which the last run found no lemma, with their signature at that time
+    u_map<unsigned>  m_row_signatures;
+    unsigned bounds_hash(lpvar j) const;
+    template <typename T>
+    unsigned row_signature(const T& row) const;
 public:
     typedef intervals::interval interv;
     horner(core *core);
@@ -228,7 +228,8 @@ public:
     }
 
     bool need_to_presolve_with_double_solver() const {
-        return settings().simplex_strategy() == simplex_strategy_enum::lu;
+        return settings().simplex_strategy() == simplex_strategy_enum::lu &&
+            settings().presolve_with_double_solver_for_lar;
     }
 
     template <typename L>
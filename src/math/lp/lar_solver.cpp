@@ -187,6 +187,7 @@ lp_status lar_solver::get_status() const { return m_status; }
 void lar_solver::set_status(lp_status s) { m_status = s; }
 
 lp_status lar_solver::find_feasible_solution() {
+    memory::scoped_tag _tag(memory::TAG_LP);
     m_settings.stats().m_make_feasible++;
     if (A_r().column_count() > m_settings.stats().m_max_cols)
         m_settings.stats().m_max_cols = A_r().column_count();
@@ -1329,15 +1330,14 @@ void lar_solver::remove_last_row_and_column_from_tableau(unsigned j) {
     lp_assert(last_row.size() == 0);
     lp_assert(A_r().m_columns[j].size() == 0);
     A_r().m_rows.pop_back();
-    A_r().m_columns.pop_back();
+    A_r().pop_last_column();
 	CASSERT("check_static_matrix", A_r().is_correct());
     slv.m_b.pop_back();
 }
 
 void lar_solver::remove_last_column_from_A() {
     // the last column has to be empty
-    lp_assert(A_r().m_columns.back().size() == 0);
-    A_r().m_columns.pop_back();
+    A_r().pop_last_column();
 }
 
 void lar_solver::remove_last_column_from_basis_tableau(unsigned j) {
@@ -1516,6 +1516,7 @@ unsigned lar_solver::external_to_column_index(unsigned ext_j) const {
 }
 
 var_index lar_solver::add_var(unsigned ext_j, bool is_int) {
+    memory::scoped_tag _tag(memory::TAG_LP);
     TRACE("add_var", tout << "adding var " << ext_j << (is_int? " int" : " nonint") << std::endl;);
     var_index local_j;    
     SASSERT(!m_term_register.external_is_used(ext_j));
@@ -1551,7 +1552,7 @@ void lar_solver::add_non_basic_var_to_core_fields(unsigned ext_j, bool is_int) {
     m_mpq_lar_core_solver.m_column_types.push_back(column_type::free_column);
     m_columns_with_changed_bound.increase_size_by_one();
     add_new_var_to_core_fields_for_mpq(false); // false for not adding a row
-    if (use_lu())
+    if (m_mpq_lar_core_solver.need_to_presolve_with_double_solver())
         add_new_var_to_core_fields_for_doubles(false);
 }
 
@@ -1652,6 +1653,7 @@ bool lar_solver::all_vars_are_registered(const vector<std::pair<mpq, var_index>>
 
 // do not register in m_var_register this term if ext_i == UINT_MAX
 var_index lar_solver::add_term(const vector<std::pair<mpq, var_index>> & coeffs, unsigned ext_i) {
+    memory::scoped_tag _tag(memory::TAG_LP);
     TRACE("lar_solver_terms", print_linear_combination_of_column_indices_only(coeffs, tout) << ", ext_i =" << ext_i << "\n";);
     SASSERT(!m_var_register.external_is_used(ext_i));
     m_term_register.add_var(ext_i, term_is_int(coeffs));   
@@ -1694,7 +1696,7 @@ void lar_solver::add_row_from_term_no_constraint(const lar_term * term, unsigned
         fill_last_row_of_A_r(A_r(), term);
     }
     m_mpq_lar_core_solver.m_r_solver.update_x(j, get_basic_var_value_from_row(A_r().row_count() - 1));
-    if (use_lu())
+    if (m_mpq_lar_core_solver.need_to_presolve_with_double_solver())
         fill_last_row_of_A_d(A_d(), term);
     for (const auto & c : *term) {
         unsigned j = c.column();
@@ -1731,6 +1733,7 @@ constraint_index lar_solver::add_var_bound_check_on_equal(var_index j, lconstrai
 }
 
 constraint_index lar_solver::add_var_bound(var_index j, lconstraint_kind kind, const mpq & right_side) {
+    memory::scoped_tag _tag(memory::TAG_LP);
     constraint_index ci = mk_var_bound(j, kind, right_side);
     activate(ci);
     return ci;
@@ -492,6 +492,23 @@ public:
         return j;
     }
 
+    // dual simplex pricing: the basic column with the largest bound violation leaves the basis
+    int find_greatest_error_inf_column() {
+        int j = -1;
+        X max_error, error;
+        for (unsigned k : this->inf_set()) {
+            if (this->x_below_low_bound(k))
+                error = this->m_lower_bounds[k] - this->m_x[k];
+            else
+                error = this->m_x[k] - this->m_upper_bounds[k];
+            if (j == -1 || error > max_error || (error == max_error && k < static_cast<unsigned>(j))) {
+                j = k;
+                max_error = error;
+            }
+        }
+        return j;
+    }
+
     const X& get_val_for_leaving(unsigned j) const {
         lp_assert(!this->column_is_feasible(j));
         switch (this->m_column_types[j]) {
@@ -515,7 +532,8 @@ public:
     
     
     void one_iteration_tableau_rows() {
-        int leaving = find_smallest_inf_column();
+        int leaving = this->m_settings.greatest_error_pivot() && !m_bland_mode_tableau ?
+            find_greatest_error_inf_column() : find_smallest_inf_column();
         if (leaving == -1) {
             this->set_status(lp_status::OPTIMAL);
             return;
@@ -120,6 +120,7 @@ struct statistics {
     unsigned m_nla_calls;
     unsigned m_horner_calls;
     unsigned m_horner_conflicts;
+    unsigned m_horner_rows_skipped;
     unsigned m_cross_nested_forms;
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
@@ -217,11 +218,14 @@ private:
     bool             m_enable_hnf;
     bool             m_print_external_var_name;
     bool             m_cheap_eqs;
+    bool             m_greatest_error_pivot;
 public:
     bool print_external_var_name() const { return m_print_external_var_name; }
     bool& print_external_var_name() { return m_print_external_var_name; }
     bool cheap_eqs() const { return m_cheap_eqs;}
     bool& cheap_eqs() { return m_cheap_eqs;}
+    bool greatest_error_pivot() const { return m_greatest_error_pivot; }
+    bool& greatest_error_pivot() { return m_greatest_error_pivot; }
     unsigned hnf_cut_period() const { return m_hnf_cut_period; }
     void set_hnf_cut_period(unsigned period) { m_hnf_cut_period = period;  }
     unsigned random_next() { return m_rand(); }
@@ -286,8 +290,8 @@ public:
                     limit_on_rows_for_hnf_cutter(75),
                     limit_on_columns_for_hnf_cutter(150),
                     m_enable_hnf(true),
-                    m_print_external_var_name(false)
-                    
+                    m_print_external_var_name(false),
+                    m_greatest_error_pivot(false)
     {}
 
     void set_resource_limit(lp_resource_limit& lim) { m_resource_limit = &lim; }
@@ -61,10 +61,10 @@ unsigned common::random() {
 
 void common::add_deps_of_fixed(lpvar j, u_dependency*& dep) {
     unsigned lc, uc;
-    auto& dep_manager = c().m_intervals.get_dep_intervals().dep_manager();
+    auto& di = c().m_intervals.get_dep_intervals();
     c().m_lar_solver.get_bound_constraint_witnesses_for_column(j, lc, uc);
-    dep = dep_manager.mk_join(dep, dep_manager.mk_leaf(lc));
-    dep = dep_manager.mk_join(dep, dep_manager.mk_leaf(uc));                    
+    dep = di.mk_join(dep, di.mk_leaf(lc));
+    dep = di.mk_join(dep, di.mk_leaf(uc));                    
 }
 
 
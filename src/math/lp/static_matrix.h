@@ -136,6 +136,18 @@ public:
         m_vector_of_row_offsets.push_back(-1);
     }
 
+    // remove the last column, which has to be empty, together with its work vector entry
+    void pop_last_column() {
+        lp_assert(m_columns.back().size() == 0);
+        m_columns.pop_back();
+        shrink_vector_of_row_offsets();
+    }
+
+    void shrink_vector_of_row_offsets() {
+        if (m_vector_of_row_offsets.size() > column_count())
+            m_vector_of_row_offsets.shrink(column_count());
+    }
+
     void forget_last_columns(unsigned how_many_to_forget);
 
     void remove_last_column(unsigned j);
@@ -266,6 +278,7 @@ public:
                 m_columns.pop_back(); // delete the last column
             m_stack.pop();
         }
+        shrink_vector_of_row_offsets();
         lp_assert(is_correct());
     }
 
@@ -84,6 +84,19 @@ namespace algebraic_numbers {
         polynomial::var          m_x;
         polynomial::var          m_y;
 
+        // Roots of recently isolated univariate polynomials.
+        // The multivariate isolate_roots reduces p and the assignment to a univariate
+        // polynomial, so an entry also covers repeated queries under the same assignment.
+        struct root_cache_entry {
+            unsigned       m_hash;
+            unsigned       m_stamp;
+            upoly          m_p;
+            numeral_vector m_roots;
+        };
+        static const unsigned    m_root_cache_capacity = 128;
+        ptr_vector<root_cache_entry> m_root_cache;
+        unsigned                 m_root_cache_stamp;
+
         // configuration
         int                        m_min_magnitude;
         bool                       m_factor;
@@ -95,6 +108,9 @@ namespace algebraic_numbers {
         unsigned                 m_compare_sturm;
         unsigned                 m_compare_refine;
         unsigned                 m_compare_poly_eq;
+        unsigned                 m_root_cache_hits;
+        unsigned                 m_root_cache_misses;
+        unsigned                 m_eval_sign_enclosure;
 
         imp(reslimit& lim, manager & w, unsynch_mpq_manager & m, params_ref const & p, small_object_allocator & a):
             m_limit(lim),
@@ -114,7 +130,8 @@ namespace algebraic_numbers {
             m_isolate_roots(bqm()),
             m_isolate_lowers(bqm()),
             m_isolate_uppers(bqm()),
-            m_add_tmp(upm()) {
+            m_add_tmp(upm()),
+            m_root_cache_stamp(0) {
             updt_params(p);
             reset_statistics();
             m_x = pm().mk_var();
@@ -122,6 +139,66 @@ namespace algebraic_numbers {
         }
 
         ~imp() {
+            reset_root_cache();
+        }
+
+        void reset_root_cache() {
+            for (root_cache_entry * e : m_root_cache) {
+                upm().reset(e->m_p);
+                for (numeral & r : e->m_roots)
+                    del(r);
+                dealloc(e);
+            }
+            m_root_cache.reset();
+        }
+
+        unsigned root_cache_hash(upoly const & up) {
+            unsigned h = up.size();
+            for (auto const & c : up) 
+                h = combine_hash(h, upm().m().hash(c));
+            return h;
+        }
+
+        bool find_cached_roots(upoly const & up, unsigned h, numeral_vector & roots) {
+            for (root_cache_entry * e : m_root_cache) {
+                if (e->m_hash == h && upm().eq(e->m_p.size(), e->m_p.c_ptr(), up.size(), up.c_ptr())) {
+                    e->m_stamp = ++m_root_cache_stamp;
+                    for (numeral const & r : e->m_roots) {
+                        roots.push_back(numeral());
+                        set(roots.back(), r);
+                    }
+                    m_root_cache_hits++;
+                    return true;
+                }
+            }
+            m_root_cache_misses++;
+            return false;
+        }
+
+        void cache_roots(upoly const & up, unsigned h, numeral_vector const & roots) {
+            root_cache_entry * e;
+            if (m_root_cache.size() < m_root_cache_capacity) {
+                e = alloc(root_cache_entry);
+                m_root_cache.push_back(e);
+            }
+            else {
+                // evict the least recently used entry
+                e = m_root_cache[0];
+                for (root_cache_entry * f : m_root_cache)
+                    if (f->m_stamp < e->m_stamp)
+                        e = f;
+                upm().reset(e->m_p);
+                for (numeral & r : e->m_roots)
+                    del(r);
+                e->m_roots.reset();
+            }
+            e->m_hash = h;
+            e->m_stamp = ++m_root_cache_stamp;
+            upm().set(up.size(), up.c_ptr(), e->m_p);
+            for (numeral const & r : roots) {
+                e->m_roots.push_back(numeral());
+                set(e->m_roots.back(), r);
+            }
         }
 
         bool acell_inv(algebraic_cell const& c) {
@@ -139,6 +216,9 @@ namespace algebraic_numbers {
             m_compare_sturm   = 0;
             m_compare_refine  = 0;
             m_compare_poly_eq = 0;
+            m_root_cache_hits = 0;
+            m_root_cache_misses = 0;
+            m_eval_sign_enclosure = 0;
         }
 
         void collect_statistics(statistics & st) {
@@ -147,6 +227,9 @@ namespace algebraic_numbers {
             st.update("algebraic compare sturm", m_compare_sturm);
             st.update("algebraic compare refine", m_compare_refine);
             st.update("algebraic compare poly", m_compare_poly_eq);
+            st.update("algebraic root cache hits", m_root_cache_hits);
+            st.update("algebraic root cache misses", m_root_cache_misses);
+            st.update("algebraic eval sign enclosure", m_eval_sign_enclosure);
 #endif
         }
 
@@ -158,6 +241,8 @@ namespace algebraic_numbers {
             m_factor_params.m_p_trials = p.factor_num_primes();
             m_factor_params.m_max_search_size = p.factor_search_size();
             m_zero_accuracy            = -static_cast<int>(p.zero_accuracy());
+            // cached roots depend on the factorization settings
+            reset_root_cache();
         }
 
         unsynch_mpq_manager & qm() {
@@ -607,6 +692,19 @@ namespace algebraic_numbers {
             TRACE("algebraic", upm().display(tout, up); tout << "\n";);
             if (up.empty())
                 return; // ignore the zero polynomial
+            if (!roots.empty()) {
+                isolate_roots_core(up, roots);
+                return;
+            }
+            unsigned h = root_cache_hash(up);
+            if (find_cached_roots(up, h, roots))
+                return;
+            isolate_roots_core(up, roots);
+            if (m_limit.inc())
+                cache_roots(up, h, roots);
+        }
+
+        void isolate_roots_core(scoped_upoly const & up, numeral_vector & roots) {
             factors & fs = m_isolate_factors;
             fs.reset();
             bool full_fact;
@@ -2051,6 +2149,60 @@ namespace algebraic_numbers {
             }
         };
 
+        /**
+           \brief Mapping from every assigned variable to an enclosure of its value:
+           the isolating interval of algebraic values, and an interval of width at most 2^{-k+1}
+           around rational values, where k = log2(denominator) + 32.
+        */
+        struct var2enclosure : public polynomial::var2mpbqi {
+            imp & m_imp;
+            polynomial::var2anum const & m_x2v;
+            ptr_vector<mpbqi> m_enclosures;
+            var2enclosure(imp & i, polynomial::var2anum const & x2v, polynomial::var_vector const & xs):m_imp(i), m_x2v(x2v) {
+                scoped_mpz z(i.qm());
+                unsigned shift;
+                scoped_mpbq l(i.bqm()), u(i.bqm());
+                for (polynomial::var x : xs) {
+                    SASSERT(x2v.contains(x));
+                    anum const & v = x2v(x);
+                    if (!v.is_basic())
+                        continue;
+                    mpq const & q = i.basic_value(v);
+                    unsigned k = i.qm().log2(q.denominator()) + 32;
+                    // z = floor(q * 2^k), then q is in (z-1, z+1)/2^k, or in (z, z+1)/2^k if q*2^k is not an integer
+                    i.qm().mul2k(q.numerator(), k, z);
+                    i.qm().div(z, q.denominator(), z);
+                    bool exact = i.qm().is_power_of_two(q.denominator(), shift);
+                    if (exact)
+                        i.qm().dec(z);
+                    i.bqm().set(l, z, k);
+                    i.qm().add(z, mpz(exact ? 2 : 1), z);
+                    i.bqm().set(u, z, k);
+                    m_enclosures.reserve(x + 1, nullptr);
+                    mpbqi * r = alloc(mpbqi);
+                    i.bqim().set(*r, l, u);
+                    m_enclosures[x] = r;
+                }
+            }
+            ~var2enclosure() {
+                for (mpbqi * r : m_enclosures) {
+                    if (r) {
+                        m_imp.bqim().del(*r);
+                        dealloc(r);
+                    }
+                }
+            }
+            mpbqi_manager & m() const override { return m_imp.bqim(); }
+            bool contains(polynomial::var x) const override { return m_x2v.contains(x); }
+            mpbqi const & operator()(polynomial::var x) const override {
+                anum const & v = m_x2v(x);
+                if (!v.is_basic())
+                    return v.to_algebraic()->m_interval;
+                SASSERT(x < m_enclosures.size() && m_enclosures[x]);
+                return *m_enclosures[x];
+            }
+        };
+
         polynomial::var_vector m_eval_sign_vars;
         sign eval_sign_at(polynomial_ref const & p, polynomial::var2anum const & x2v) {
             polynomial::manager & ext_pm = p.m();
@@ -2069,6 +2221,22 @@ namespace algebraic_numbers {
                     // continue
                 }
 
+                // Cheap filter: evaluate p on enclosures of all assigned values.
+                // If the result does not contain zero, the substitution of the rational values is not needed.
+                {
+                    polynomial::var_vector & xs = m_eval_sign_vars;
+                    xs.reset();
+                    ext_pm.vars(p, xs);
+                    var2enclosure x2v_enclosure(*this, x2v, xs);
+                    scoped_mpbqi ri(bqim());
+                    ext_pm.eval(p, x2v_enclosure, ri);
+                    TRACE("anum_eval_sign", tout << "evaluating using enclosures: " << ri << "\n";);
+                    if (!bqim().contains_zero(ri)) {
+                        m_eval_sign_enclosure++;
+                        return bqim().is_pos(ri) ? sign_pos : sign_neg;
+                    }
+                }
+
                 // Eliminate rational values from p
                 polynomial_ref p_prime(ext_pm);
                 var2basic x2v_basic(*this, x2v);
@@ -1857,6 +1857,7 @@ namespace polynomial {
         unsigned_vector          m_degree2pos;
         bool                     m_use_sparse_gcd;
         bool                     m_use_prs_gcd;
+        bool                     m_use_modular_resultant;
 
         // Debugging method: check if the coefficients of p are in the numeral_manager.
         bool consistent_coeffs(polynomial const * p) {
@@ -2338,6 +2339,7 @@ namespace polynomial {
             inc_ref(m_unit_poly);
             m_use_sparse_gcd = true;
             m_use_prs_gcd = false;
+            m_use_modular_resultant = true;
         }
 
         imp(reslimit& lim, manager & w, unsynch_mpz_manager & m, monomial_manager * mm):
@@ -3392,13 +3394,7 @@ namespace polynomial {
                 m_manager.set(a, p->a(0));
                 return;
             }
-            m_manager.set(a, p->a(0));
-            unsigned sz = p->size();
-            for (unsigned i = 1; i < sz; i++) {
-                if (m_manager.is_one(a))
-                    return;
-                m_manager.gcd(a, p->a(i), a);
-            }
+            m_manager.gcd(p->size(), p->as(), a);
         }
 
         /**
@@ -5397,7 +5393,7 @@ namespace polynomial {
                  if d*n <  m-r
                     Res(A, B) = (-1)^(m*n) * mul(Res(R, B), lc^(m - r - d * n))
         */
-        void resultant(polynomial const * p, polynomial const * q, var x, polynomial_ref & result) {
+        void prs_resultant(polynomial const * p, polynomial const * q, var x, polynomial_ref & result) {
             polynomial_ref A(pm());
             polynomial_ref B(pm());
             A = const_cast<polynomial*>(p);
@@ -5507,6 +5503,80 @@ namespace polynomial {
             }
         }
 
+        void resultant(polynomial const * p, polynomial const * q, var x, polynomial_ref & result) {
+            if (!m().modular() && m_use_modular_resultant && mod_resultant(p, q, x, result))
+                return;
+            prs_resultant(p, q, x, result);
+        }
+
+        /**
+           \brief Modular resultant: compute Res(p, q, x) modulo big primes and combine the
+           images using the Chinese Remainder theorem.
+
+           The Sylvester matrix has deg(q) rows with the coefficients of p, and deg(p) rows
+           with the coefficients of q. So the sum of absolute values of the coefficients of
+           the resultant is bounded by |p|^deg(q) * |q|^deg(p), where |.| is the sum of the
+           absolute values of the coefficients (abs_norm). The images are combined until the
+           product of the primes exceeds twice this bound.
+           Primes where the leading coefficient of p or q vanishes are skipped.
+
+           Return false if the inputs are too small to benefit, or there are not enough primes
+           for the bound; the caller then uses the subresultant PRS.
+        */
+        bool mod_resultant(polynomial const * p, polynomial const * q, var x, polynomial_ref & result) {
+            SASSERT(!m().modular());
+            if (is_const(p) || is_const(q))
+                return false;
+            unsigned d_p = degree(p, x);
+            unsigned d_q = degree(q, x);
+            if (d_p < 2 || d_q < 2)
+                return false;
+            scoped_numeral n_p(m()), n_q(m()), bound(m()), tmp(m());
+            abs_norm(p, n_p);
+            abs_norm(q, n_q);
+            // each big prime contributes at least 15 bits to the modulus.
+            uint64_t bits = static_cast<uint64_t>(d_q) * (m().log2(n_p) + 1) + static_cast<uint64_t>(d_p) * (m().log2(n_q) + 1) + 1;
+            if (bits >= 15 * static_cast<uint64_t>(NUM_BIG_PRIMES))
+                return false;
+            m().power(n_p, d_q, bound);
+            m().power(n_q, d_p, tmp);
+            m().mul(bound, tmp, bound);
+            m().mul(bound, mpz(2), bound);
+            TRACE("mresultant", tout << "p: "; p->display(tout, m_manager); tout << "\nq: "; q->display(tout, m_manager); tout << "\nbound: " << bound << "\n";);
+
+            polynomial_ref p_Zp(m_wrapper), q_Zp(m_wrapper);
+            polynomial_ref r_Zp(m_wrapper), C_star(m_wrapper);
+            scoped_numeral modulus(m());
+            scoped_numeral prime(m());
+            for (unsigned i = 0; i < NUM_BIG_PRIMES; i++) {
+                checkpoint();
+                m().set(prime, g_big_primes[i]);
+                {
+                    scoped_set_zp setZp(m_wrapper, prime);
+                    p_Zp = normalize(p);
+                    q_Zp = normalize(q);
+                    if (degree(p_Zp, x) < d_p || degree(q_Zp, x) < d_q) {
+                        TRACE("mresultant", tout << "bad prime, leading coefficient vanished\n";);
+                        continue;
+                    }
+                    prs_resultant(p_Zp, q_Zp, x, r_Zp);
+                }
+                if (C_star.get() == nullptr) {
+                    C_star = r_Zp;
+                    m().set(modulus, prime);
+                }
+                else {
+                    CRA_combine_images(r_Zp, prime, C_star, modulus, C_star);
+                }
+                if (m().gt(modulus, bound)) {
+                    TRACE("mresultant", tout << "result: " << C_star << "\n";);
+                    result = C_star;
+                    return true;
+                }
+            }
+            return false;
+        }
+
         /**
            \brief Return the discriminant of p with respect to x.
 
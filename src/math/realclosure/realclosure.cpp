@@ -296,6 +296,19 @@ namespace realclosure {
         mpbqi & iso_interval() { return m_iso_interval; }
     };
 
+    /**
+       \brief Sign of q(x) for an algebraic extension x, where q is a polynomial
+       with coefficients in the field below x. Used to avoid repeating Tarski queries
+       for polynomials that are structurally equal.
+    */
+    struct sign_cache_entry {
+        unsigned     m_hash;
+        algebraic *  m_x;
+        polynomial   m_q;
+        int          m_sign;
+        sign_cache_entry(unsigned h, algebraic * x, int s):m_hash(h), m_x(x), m_sign(s) {}
+    };
+
     struct transcendental : public extension {
         symbol        m_name;
         symbol        m_pp_name;
@@ -385,6 +398,8 @@ namespace realclosure {
         value *                        m_e;
         ptr_vector<value>              m_to_restore; //!< Set of values v s.t. v->m_old_interval != 0
         ptr_vector<extension>          m_ex_to_restore;
+        ptr_vector<sign_cache_entry>   m_sign_cache;      //!< Signs computed by expensive_algebraic_poly_interval
+        unsigned                       m_sign_cache_head; //!< Next entry to be replaced when the cache is full
 
         // Parameters
         bool                           m_use_prem; //!< use pseudo-remainder when computing sturm sequences
@@ -515,12 +530,14 @@ namespace realclosure {
 
             m_in_aux_values = false;
 
+            m_sign_cache_head = 0;
 
             updt_params(p);
         }
 
         ~imp() {
             restore_saved_intervals(); // to free memory
+            reset_sign_cache();
             dec_ref(m_one);
             dec_ref(m_pi);
             dec_ref(m_e);
@@ -4560,6 +4577,69 @@ namespace realclosure {
             }
         }
 
+        // ---------------------------------
+        //
+        // Cache for signs of polynomials at algebraic extensions
+        //
+        // ---------------------------------
+
+        static const unsigned max_sign_cache_size = 256;
+
+        unsigned value_hash(value * v) const {
+            if (v == nullptr)
+                return 0;
+            if (v->is_rational())
+                return qm().hash(to_mpq(v));
+            rational_function_value * rf = to_rational_function(v);
+            return hash_u_u(rf->ext()->idx(), hash_u_u(rf->num().size(), rf->den().size()));
+        }
+
+        unsigned sign_cache_hash(polynomial const & q, algebraic * x) const {
+            unsigned h = x->idx();
+            for (unsigned i = 0; i < q.size(); i++)
+                h = hash_u_u(h, value_hash(q[i]));
+            return h;
+        }
+
+        bool find_cached_sign(unsigned h, polynomial const & q, algebraic * x, int & s) const {
+            for (sign_cache_entry * e : m_sign_cache) {
+                if (e->m_hash == h && e->m_x == x && struct_eq(e->m_q, q)) {
+                    s = e->m_sign;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void del_sign_cache_entry(sign_cache_entry * e) {
+            reset_p(e->m_q);
+            dec_ref(e->m_x);
+            allocator().deallocate(sizeof(sign_cache_entry), e);
+        }
+
+        void cache_sign(unsigned h, polynomial const & q, algebraic * x, int s) {
+            if (q.empty())
+                return;
+            sign_cache_entry * e = new (allocator()) sign_cache_entry(h, x, s);
+            inc_ref(x);
+            set_p(e->m_q, q.size(), q.c_ptr());
+            if (m_sign_cache.size() < max_sign_cache_size) {
+                m_sign_cache.push_back(e);
+            }
+            else {
+                del_sign_cache_entry(m_sign_cache[m_sign_cache_head]);
+                m_sign_cache[m_sign_cache_head] = e;
+                m_sign_cache_head = (m_sign_cache_head + 1) % max_sign_cache_size;
+            }
+        }
+
+        void reset_sign_cache() {
+            for (sign_cache_entry * e : m_sign_cache)
+                del_sign_cache_entry(e);
+            m_sign_cache.reset();
+            m_sign_cache_head = 0;
+        }
+
         /**
            \brief If q(x) != 0, return true and store in r an interval that contains the value q(x), but does not contain 0.
                   If q(x) == 0, return false
@@ -4574,6 +4654,30 @@ namespace realclosure {
                 }
                 return true;
             }
+            unsigned h = sign_cache_hash(q, x);
+            int s;
+            if (find_cached_sign(h, q, x, s)) {
+                if (s == 0)
+                    return false; // q(x) is zero
+                if (!depends_on_infinitesimals(q, x))
+                    refine_until_sign_determined(q, x, r);
+                else if (s > 0)
+                    set_lower_zero(r);
+                else
+                    set_upper_zero(r);
+                SASSERT(!contains_zero(r));
+                return true;
+            }
+            bool r_nz = expensive_algebraic_poly_interval_core(q, x, r);
+            cache_sign(h, q, x, !r_nz ? 0 : (bqim().is_P(r) ? 1 : -1));
+            return r_nz;
+        }
+
+        /**
+           \brief Auxiliary method for expensive_algebraic_poly_interval.
+           It is only invoked when the interval of q(x) contains zero. The result is not cached.
+        */
+        bool expensive_algebraic_poly_interval_core(polynomial const & q, algebraic * x, mpbqi & r) {
             int num_roots = x->num_roots_inside_interval();
             SASSERT(x->sdt() != 0 || num_roots == 1);
             polynomial const & p = x->p();
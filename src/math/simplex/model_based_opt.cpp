@@ -353,16 +353,11 @@ namespace opt {
         bound_row_index = UINT_MAX;
         rational lub_val;
         rational const& x_val = m_var2value[x];
-        unsigned_vector const& row_ids = m_var2row_ids[x];
-        uint_set visited;
+        unsigned_vector const& row_ids = compact_row_ids(x);
         m_above.reset();
         m_below.reset();
         for (unsigned row_id : row_ids) {
             SASSERT(row_id != m_objective_id);
-            if (visited.contains(row_id)) {
-                continue;
-            }
-            visited.insert(row_id);
             row& r = m_rows[row_id];
             if (r.m_alive) {
                 rational a = get_coefficient(row_id, x);
@@ -401,6 +396,28 @@ namespace opt {
         m_retired_rows.push_back(row_id);
     }
 
+    /**
+       \brief remove duplicates, retired rows and rows where x no longer
+       occurs from the occurrence list of x, in place. Rows that get x back
+       are added again by mul_add and set_row.
+    */
+    unsigned_vector const& model_based_opt::compact_row_ids(unsigned x) {
+        unsigned_vector& row_ids = m_var2row_ids[x];
+        std::sort(row_ids.begin(), row_ids.end());
+        unsigned j = 0, prev = UINT_MAX;
+        for (unsigned row_id : row_ids) {
+            if (row_id == prev) {
+                continue;
+            }
+            prev = row_id;
+            if (m_rows[row_id].m_alive && !get_coefficient(row_id, x).is_zero()) {
+                row_ids[j++] = row_id;
+            }
+        }
+        row_ids.shrink(j);
+        return row_ids;
+    }
+
     rational model_based_opt::eval(unsigned x) const {
         return m_var2value[x];
     }
@@ -924,8 +941,7 @@ namespace opt {
         bool     lub_strict = false, glb_strict = false;
         rational lub_val, glb_val;
         rational const& x_val = m_var2value[x];
-        unsigned_vector const& row_ids = m_var2row_ids[x];
-        uint_set visited;
+        unsigned_vector const& row_ids = compact_row_ids(x);
         lub_rows.reset();
         glb_rows.reset();
         mod_rows.reset();
@@ -933,18 +949,8 @@ namespace opt {
         unsigned eq_row = UINT_MAX;
         // select the lub and glb.
         for (unsigned row_id : row_ids) {
-            if (visited.contains(row_id)) {
-                continue;
-            }
-            visited.insert(row_id);
             row& r = m_rows[row_id];
-            if (!r.m_alive) {
-                continue;
-            }
             rational a = get_coefficient(row_id, x);
-            if (a.is_zero()) {
-                continue;
-            }
             if (r.m_type == t_eq) {
                 eq_row = row_id;
                 continue;
@@ -1111,15 +1117,11 @@ namespace opt {
         rational new_val = (val_x - u) / D;
         SASSERT(new_val.is_int());
         unsigned y = add_var(new_val, true);
-        unsigned_vector const& row_ids = m_var2row_ids[x];
-        uint_set visited;
+        unsigned_vector const& row_ids = compact_row_ids(x);
         for (unsigned row_id : row_ids) {           
-            if (!visited.contains(row_id)) {
-                // x |-> D*y + u
-                replace_var(row_id, x, D, y, u);
-                visited.insert(row_id);
-                normalize(row_id);
-            }
+            // x |-> D*y + u
+            replace_var(row_id, x, D, y, u);
+            normalize(row_id);
         }
         TRACE("opt1", display(tout << "tableau after replace x by y := v" << y << "\n"););
         def result = project(y, compute_def);
@@ -1196,27 +1198,22 @@ namespace opt {
             rational c = r1.m_coeff;
             add_divides(coeffs, c, a);
         }
-        unsigned_vector const& row_ids = m_var2row_ids[x];
-        uint_set visited;
-        visited.insert(row_id1);
+        unsigned_vector const& row_ids = compact_row_ids(x);
         for (unsigned row_id2 : row_ids) {
-            if (!visited.contains(row_id2)) {                
-                visited.insert(row_id2);                
-                b = get_coefficient(row_id2, x);
-                if (!b.is_zero()) {
-                    row& dst = m_rows[row_id2];
-                    switch (dst.m_type) {
-                    case t_eq:                        
-                    case t_lt:
-                    case t_le:
-                        solve(row_id1, a, row_id2, x);
-                        break;
-                    case t_mod:
-                        // mod reduction already done.
-                        UNREACHABLE();
-                        break;
-                    }
-                }
+            if (row_id2 == row_id1) {
+                continue;
+            }
+            row& dst = m_rows[row_id2];
+            switch (dst.m_type) {
+            case t_eq:                        
+            case t_lt:
+            case t_le:
+                solve(row_id1, a, row_id2, x);
+                break;
+            case t_mod:
+                // mod reduction already done.
+                UNREACHABLE();
+                break;
             }
         }
         def result;
@@ -152,6 +152,8 @@ namespace opt {
 
         void retire_row(unsigned row_id);
 
+        unsigned_vector const& compact_row_ids(unsigned x);
+
     public:
 
         model_based_opt();
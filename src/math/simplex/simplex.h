@@ -90,7 +90,6 @@ namespace simplex {
             {}
         };
 
-        static const var_t null_var;
         reslimit&                   m_limit;
         mutable manager             m;
         mutable eps_manager         em;
@@ -122,6 +121,8 @@ namespace simplex {
         typedef typename matrix::row_iterator row_iterator;
         typedef typename matrix::col_iterator col_iterator;
 
+        static const var_t null_var;
+
         void  ensure_var(var_t v);
         row   add_row(var_t base, unsigned num_vars, var_t const* vars, numeral const* coeffs);
         row   get_infeasible_row();
@@ -402,13 +402,13 @@ namespace simplex {
 
         col_iterator it = M.col_begin(x_j), end = M.col_end(x_j);
         scoped_numeral a_kj(m), g(m);
+        M.begin_pivot(row(r_i));
         for (; it != end; ++it) {
             row r_k = it.get_row();
             if (r_k.id() != r_i) {
                 a_kj = it.get_row_entry().m_coeff;
                 a_kj.neg();
-                M.mul(r_k, a_ij);
-                M.add(r_k, a_kj, row(r_i));
+                M.pivot_row(r_k, a_ij, a_kj);
                 var_t s = m_row2base[r_k.id()];
                 numeral& coeff = m_vars[s].m_base_coeff;
                 m.mul(coeff, a_ij, coeff);
@@ -419,6 +419,7 @@ namespace simplex {
                 SASSERT(well_formed_row(row(r_k)));
             }
         }
+        M.end_pivot();
         SASSERT(well_formed());
     }
 
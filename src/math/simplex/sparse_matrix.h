@@ -135,6 +135,8 @@ namespace simplex {
         vector<column>          m_columns;          // per var
         svector<int>            m_var_pos;          // temporary map from variables to positions in row
         unsigned_vector         m_var_pos_idx;      // indices in m_var_pos
+        unsigned                m_pivot_src;        // row scattered into m_var_pos by begin_pivot
+        bool_vector             m_pivot_seen;       // positions of the pivot row that occur in the current row
         stats                   m_stats;
 
         bool well_formed_row(unsigned row_id) const;
@@ -144,7 +146,7 @@ namespace simplex {
 
     public:
 
-        sparse_matrix(manager& _m): m(_m) {}
+        sparse_matrix(manager& _m): m(_m), m_pivot_src(UINT_MAX) {}
         ~sparse_matrix();
         void reset();
         
@@ -168,6 +170,17 @@ namespace simplex {
         void neg(row r);
         void del(row r);
 
+        /**
+           \brief Batch update of rows with the same source row, as in pivoting.
+           begin_pivot scatters the positions of src in a workspace that is
+           shared by the subsequent calls to pivot_row, each of which sets
+           r <- a*r + n*src in a single pass over r and src.
+           add shares the workspace and may not be used before end_pivot.
+        */
+        void begin_pivot(row src);
+        void pivot_row(row r, numeral const& a, numeral const& n);
+        void end_pivot();
+
         void gcd_normalize(row const& r, scoped_numeral& g);
 
         class row_iterator {
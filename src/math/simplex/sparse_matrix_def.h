@@ -383,6 +383,73 @@ namespace simplex {
     }
     
 
+    template<typename Ext>
+    void sparse_matrix<Ext>::begin_pivot(row src) {
+        SASSERT(m_pivot_src == UINT_MAX && m_var_pos_idx.empty());
+        m_pivot_src = src.id();
+        _row const& r = m_rows[m_pivot_src];
+        r.save_var_pos(m_var_pos, m_var_pos_idx);
+        m_pivot_seen.reset();
+        m_pivot_seen.resize(r.num_entries(), false);
+    }
+
+    /**
+       \brief Set row1 <- row1 * a + src * n, where src is the row of begin_pivot.
+    */
+    template<typename Ext>
+    void sparse_matrix<Ext>::pivot_row(row row1, numeral const& a, numeral const& n) {
+        SASSERT(m_pivot_src != UINT_MAX && row1.id() != m_pivot_src);
+        m_stats.m_add_rows++;
+        _row & r1 = m_rows[row1.id()];
+        _row const & r2 = m_rows[m_pivot_src];
+        scoped_numeral tmp(m);
+        bool a_is_one = m.is_one(a);
+        for (unsigned i = 0; i < r1.num_entries(); ++i) {
+            _row_entry & r_entry = r1.m_entries[i];
+            if (r_entry.is_dead()) 
+                continue;
+            if (!a_is_one)
+                m.mul(r_entry.m_coeff, a, r_entry.m_coeff);
+            int pos = m_var_pos[r_entry.m_var];
+            if (pos == -1) 
+                continue;
+            m_pivot_seen[pos] = true;
+            m.mul(r2.m_entries[pos].m_coeff, n, tmp);
+            m.add(r_entry.m_coeff, tmp, r_entry.m_coeff);
+            if (m.is_zero(r_entry.m_coeff)) 
+                del_row_entry(r1, i);
+        }
+        for (unsigned pos = 0; pos < r2.num_entries(); ++pos) {
+            if (m_pivot_seen[pos]) {
+                m_pivot_seen[pos] = false;
+                continue;
+            }
+            _row_entry const & src = r2.m_entries[pos];
+            if (src.is_dead())
+                continue;
+            unsigned row_idx;
+            _row_entry & r_entry = r1.add_row_entry(row_idx);
+            r_entry.m_var = src.m_var;
+            m.mul(src.m_coeff, n, r_entry.m_coeff);
+            column & c = m_columns[src.m_var];
+            int col_idx;
+            col_entry & c_entry = c.add_col_entry(col_idx);
+            r_entry.m_col_idx = col_idx;
+            c_entry.m_row_id  = row1.id();
+            c_entry.m_row_idx = row_idx;
+        }
+        r1.compress_if_needed(m, m_columns);
+    }
+
+    template<typename Ext>
+    void sparse_matrix<Ext>::end_pivot() {
+        for (unsigned v : m_var_pos_idx) {
+            m_var_pos[v] = -1;
+        }
+        m_var_pos_idx.reset();
+        m_pivot_src = UINT_MAX;
+    }
+
     template<typename Ext>
     void sparse_matrix<Ext>::del_row_entry(_row& r, unsigned pos) {
         _row_entry & r_entry   = r.m_entries[pos];     
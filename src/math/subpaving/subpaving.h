@@ -107,6 +107,11 @@ public:
 
     virtual void operator()() = 0;
 
+    /**
+       \brief Return true if operator() showed that the constraints are unsatisfiable.
+    */
+    virtual bool is_infeasible() const = 0;
+
     virtual void display_bounds(std::ostream & out) const = 0;
 };
 
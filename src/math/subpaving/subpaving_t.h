@@ -843,6 +843,13 @@ public:
     void collect_statistics(statistics & st) const;
 
     void operator()();
+
+    /**
+       \brief Return true if all leaves of the paving tree are inconsistent.
+       That is, the constraints are unsatisfiable.
+       The result is only meaningful after operator() was executed.
+    */
+    bool is_infeasible() const;
 };
 
 };
@@ -1854,6 +1854,16 @@ void context_t<C>::operator()() {
     TRACE("subpaving_stats", statistics st; collect_statistics(st); tout << "statistics:\n"; st.display_smt2(tout););
 }
 
+template<typename C>
+bool context_t<C>::is_infeasible() const {
+    if (m_root == nullptr)
+        return false;
+    // collect_leaves skips inconsistent leaves
+    ptr_vector<node> leaves;
+    collect_leaves(leaves);
+    return leaves.empty();
+}
+
 template<typename C>
 void context_t<C>::display_bounds(std::ostream & out) const {
     ptr_vector<node> leaves;
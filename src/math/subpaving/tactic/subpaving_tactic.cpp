@@ -121,6 +121,10 @@ class subpaving_tactic : public tactic {
             m_ctx->collect_statistics(st);
         }
 
+        bool is_infeasible() const {
+            return m_ctx->is_infeasible();
+        }
+
         void reset_statistics() {
             m_ctx->reset_statistics();
         }
@@ -247,6 +251,16 @@ public:
             m_imp->process(*in);
             m_imp->collect_statistics(m_stats);
             result.reset();
+            if (m_imp->is_infeasible() && !in->proofs_enabled()) {
+                // the bounds are sound, so every leaf of the paving being inconsistent refutes the goal
+                ast_manager & m = m_imp->m();
+                expr_dependency * lcore = nullptr;
+                if (in->unsat_core_enabled()) {
+                    for (unsigned i = 0; i < in->size(); i++)
+                        lcore = m.mk_join(lcore, in->dep(i));
+                }
+                in->assert_expr(m.mk_false(), nullptr, lcore);
+            }
             result.push_back(in.get());
         }
         catch (z3_exception & ex) {
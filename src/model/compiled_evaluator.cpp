@@ -0,0 +1,397 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    compiled_evaluator.cpp
+
+Abstract:
+
+    Evaluate a fixed set of expressions in many models.
+
+--*/
+#include "model/compiled_evaluator.h"
+#include "model/model_core.h"
+
+// integers are kept below 2^62 in magnitude, so sums of two of them do not overflow.
+static const int64_t s_int_bound = (int64_t)1 << 62;
+// factors below 2^31 in magnitude have a product below 2^62.
+static const int64_t s_factor_bound = (int64_t)1 << 31;
+
+static bool is_small_int(int64_t v) {
+    return -s_int_bound < v && v < s_int_bound;
+}
+
+static uint64_t bv_mask(unsigned width) {
+    return width == 64 ? ~(uint64_t)0 : ((uint64_t)1 << width) - 1;
+}
+
+static int64_t bv_signed(uint64_t v, unsigned width) {
+    if (width < 64 && (v & ((uint64_t)1 << (width - 1)))) {
+        v |= ~bv_mask(width);
+    }
+    return (int64_t)v;
+}
+
+compiled_evaluator::compiled_evaluator(ast_manager& m):
+    m(m),
+    m_arith(m),
+    m_bv(m),
+    m_model_completion(false),
+    m_exprs(m),
+    m_leaves(m) {
+}
+
+bool compiled_evaluator::get_kind(sort* s, kind& k, unsigned& width) const {
+    width = 0;
+    if (m.is_bool(s)) {
+        k = K_BOOL;
+        return true;
+    }
+    if (m_bv.is_bv_sort(s)) {
+        width = m_bv.get_bv_size(s);
+        k = K_BV;
+        return 0 < width && width <= 64;
+    }
+    if (m_arith.is_int(s)) {
+        k = K_INT;
+        return true;
+    }
+    return false;
+}
+
+/**
+   \brief determine the instruction computing t from its arguments.
+   Terms without an instruction are leaves.
+*/
+bool compiled_evaluator::get_opcode(app* t, opcode& op, uint64_t& imm) const {
+    kind k, ka;
+    unsigned width, wa;
+    imm = 0;
+    if (!get_kind(m.get_sort(t), k, width)) {
+        return false;
+    }
+    for (expr* arg : *t) {
+        if (!get_kind(m.get_sort(arg), ka, wa)) {
+            return false;
+        }
+    }
+    rational r;
+    unsigned sz;
+    if (m.is_true(t) || m.is_false(t)) {
+        op = I_CONST;
+        imm = m.is_true(t) ? 1 : 0;
+        return true;
+    }
+    if (m_bv.is_numeral(t, r, sz)) {
+        op = I_CONST;
+        imm = r.get_uint64();
+        return true;
+    }
+    if (m_arith.is_numeral(t, r)) {
+        if (!r.is_int64() || !is_small_int(r.get_int64())) {
+            return false;
+        }
+        op = I_CONST;
+        imm = (uint64_t)r.get_int64();
+        return true;
+    }
+    if (t->get_num_args() == 0) {
+        return false;
+    }
+    if (t->get_family_id() == m.get_basic_family_id()) {
+        switch (t->get_decl_kind()) {
+        case OP_NOT: op = I_NOT; return true;
+        case OP_AND: op = I_AND; return true;
+        case OP_OR: op = I_OR; return true;
+        case OP_XOR: op = I_XOR; return t->get_num_args() == 2;
+        case OP_IMPLIES: op = I_IMPLIES; return t->get_num_args() == 2;
+        case OP_ITE: op = I_ITE; return true;
+        case OP_EQ: op = I_EQ; return true;
+        default: return false;
+        }
+    }
+    if (t->get_family_id() == m_bv.get_fid()) {
+        switch (t->get_decl_kind()) {
+        case OP_BADD: op = I_BV_ADD; return true;
+        case OP_BSUB: op = I_BV_SUB; return t->get_num_args() == 2;
+        case OP_BMUL: op = I_BV_MUL; return true;
+        case OP_BNEG: op = I_BV_NEG; return true;
+        case OP_BAND: op = I_BV_AND; return true;
+        case OP_BOR: op = I_BV_OR; return true;
+        case OP_BXOR: op = I_BV_XOR; return true;
+        case OP_BNOT: op = I_BV_NOT; return true;
+        case OP_ULEQ: op = I_BV_ULE; return true;
+        case OP_ULT: op = I_BV_ULT; return true;
+        case OP_UGEQ: op = I_BV_UGE; return true;
+        case OP_UGT: op = I_BV_UGT; return true;
+        case OP_SLEQ: op = I_BV_SLE; return true;
+        case OP_SLT: op = I_BV_SLT; return true;
+        case OP_SGEQ: op = I_BV_SGE; return true;
+        case OP_SGT: op = I_BV_SGT; return true;
+        case OP_CONCAT: op = I_BV_CONCAT; return true;
+        case OP_EXTRACT: op = I_BV_EXTRACT; imm = m_bv.get_extract_low(t); return true;
+        case OP_ZERO_EXT: op = I_BV_ZERO_EXT; return true;
+        case OP_SIGN_EXT: op = I_BV_SIGN_EXT; return true;
+        case OP_BSHL: op = I_BV_SHL; return true;
+        case OP_BLSHR: op = I_BV_LSHR; return true;
+        default: return false;
+        }
+    }
+    if (t->get_family_id() == m_arith.get_family_id()) {
+        switch (t->get_decl_kind()) {
+        case OP_ADD: op = I_INT_ADD; return k == K_INT;
+        case OP_SUB: op = I_INT_SUB; return k == K_INT;
+        case OP_MUL: op = I_INT_MUL; return k == K_INT;
+        case OP_UMINUS: op = I_INT_UMINUS; return k == K_INT;
+        case OP_LE: op = I_INT_LE; return get_kind(m.get_sort(t->get_arg(0)), ka, wa) && ka == K_INT;
+        case OP_LT: op = I_INT_LT; return get_kind(m.get_sort(t->get_arg(0)), ka, wa) && ka == K_INT;
+        case OP_GE: op = I_INT_GE; return get_kind(m.get_sort(t->get_arg(0)), ka, wa) && ka == K_INT;
+        case OP_GT: op = I_INT_GT; return get_kind(m.get_sort(t->get_arg(0)), ka, wa) && ka == K_INT;
+        default: return false;
+        }
+    }
+    return false;
+}
+
+void compiled_evaluator::emit(expr* t) {
+    instr i;
+    unsigned width = 0;
+    kind k = K_BOOL;
+    uint64_t imm = 0;
+    opcode op = I_LEAF;
+    if (!get_kind(m.get_sort(t), k, width)) {
+        k = K_NONE;
+    }
+    if (k == K_NONE || !is_app(t) || !get_opcode(to_app(t), op, imm)) {
+        op = I_LEAF;
+        imm = m_leaves.size();
+        m_leaves.push_back(t);
+    }
+    i.m_op = op;
+    i.m_kind = k;
+    i.m_width = width;
+    i.m_imm = imm;
+    i.m_arg_begin = m_args.size();
+    i.m_num_args = 0;
+    if (op != I_LEAF && op != I_CONST) {
+        for (expr* arg : *to_app(t)) {
+            m_args.push_back(m_expr2reg[arg]);
+        }
+        i.m_num_args = to_app(t)->get_num_args();
+    }
+    m_expr2reg.insert(t, m_code.size());
+    m_exprs.push_back(t);
+    m_code.push_back(i);
+}
+
+unsigned compiled_evaluator::compile(expr* t) {
+    unsigned r;
+    if (m_expr2reg.find(t, r)) {
+        return r;
+    }
+    ptr_vector<expr> todo;
+    todo.push_back(t);
+    while (!todo.empty()) {
+        expr* e = todo.back();
+        if (m_expr2reg.contains(e)) {
+            todo.pop_back();
+            continue;
+        }
+        opcode op;
+        uint64_t imm;
+        bool pushed = false;
+        if (is_app(e) && get_opcode(to_app(e), op, imm) && op != I_CONST) {
+            for (expr* arg : *to_app(e)) {
+                if (!m_expr2reg.contains(arg)) {
+                    todo.push_back(arg);
+                    pushed = true;
+                }
+            }
+        }
+        if (!pushed) {
+            todo.pop_back();
+            emit(e);
+        }
+    }
+    return m_expr2reg[t];
+}
+
+bool compiled_evaluator::load_leaf(expr* t, kind k, unsigned width, uint64_t& v) {
+    expr_ref val(m);
+    if (k == K_NONE || !m_eval->eval(t, val, m_model_completion)) {
+        return false;
+    }
+    rational r;
+    unsigned sz;
+    switch (k) {
+    case K_BOOL:
+        if (m.is_true(val)) { v = 1; return true; }
+        if (m.is_false(val)) { v = 0; return true; }
+        return false;
+    case K_BV:
+        if (!m_bv.is_numeral(val, r, sz)) return false;
+        v = r.get_uint64();
+        return true;
+    case K_INT:
+        if (!m_arith.is_numeral(val, r) || !r.is_int64() || !is_small_int(r.get_int64())) return false;
+        v = (uint64_t)r.get_int64();
+        return true;
+    case K_NONE:
+        return false;
+    }
+    return false;
+}
+
+/**
+   \brief execute instruction i whose arguments are valid.
+   Return false if the result cannot be represented.
+*/
+bool compiled_evaluator::exec(instr const& i, uint64_t& v) const {
+    unsigned const* args = m_args.c_ptr() + i.m_arg_begin;
+    unsigned n = i.m_num_args;
+    auto arg = [&](unsigned j) { return m_regs[args[j]]; };
+    auto iarg = [&](unsigned j) { return (int64_t)m_regs[args[j]]; };
+    unsigned w = i.m_width;
+    uint64_t mask = bv_mask(w);
+    switch (i.m_op) {
+    case I_LEAF:
+    case I_CONST:
+        UNREACHABLE();
+        return false;
+    case I_NOT: v = !arg(0); return true;
+    case I_AND: v = 1; for (unsigned j = 0; j < n; ++j) v &= arg(j); return true;
+    case I_OR: v = 0; for (unsigned j = 0; j < n; ++j) v |= arg(j); return true;
+    case I_XOR: v = arg(0) ^ arg(1); return true;
+    case I_IMPLIES: v = !arg(0) || arg(1); return true;
+    case I_EQ: v = 1; for (unsigned j = 1; j < n; ++j) v &= arg(0) == arg(j); return true;
+    case I_BV_ADD: v = 0; for (unsigned j = 0; j < n; ++j) v += arg(j); v &= mask; return true;
+    case I_BV_SUB: v = (arg(0) - arg(1)) & mask; return true;
+    case I_BV_MUL: v = 1; for (unsigned j = 0; j < n; ++j) v *= arg(j); v &= mask; return true;
+    case I_BV_NEG: v = (0 - arg(0)) & mask; return true;
+    case I_BV_AND: v = mask; for (unsigned j = 0; j < n; ++j) v &= arg(j); return true;
+    case I_BV_OR: v = 0; for (unsigned j = 0; j < n; ++j) v |= arg(j); return true;
+    case I_BV_XOR: v = 0; for (unsigned j = 0; j < n; ++j) v ^= arg(j); return true;
+    case I_BV_NOT: v = ~arg(0) & mask; return true;
+    case I_BV_ULE: v = arg(0) <= arg(1); return true;
+    case I_BV_ULT: v = arg(0) < arg(1); return true;
+    case I_BV_UGE: v = arg(0) >= arg(1); return true;
+    case I_BV_UGT: v = arg(0) > arg(1); return true;
+    case I_BV_SLE:
+    case I_BV_SLT:
+    case I_BV_SGE:
+    case I_BV_SGT: {
+        unsigned wa = m_code[args[0]].m_width;
+        int64_t a = bv_signed(arg(0), wa), b = bv_signed(arg(1), wa);
+        switch (i.m_op) {
+        case I_BV_SLE: v = a <= b; break;
+        case I_BV_SLT: v = a < b; break;
+        case I_BV_SGE: v = a >= b; break;
+        default: v = a > b; break;
+        }
+        return true;
+    }
+    case I_BV_CONCAT:
+        v = 0;
+        for (unsigned j = 0; j < n; ++j) {
+            unsigned wa = m_code[args[j]].m_width;
+            v = (wa == 64 ? 0 : v << wa) | arg(j);
+        }
+        return true;
+    case I_BV_EXTRACT: v = (arg(0) >> i.m_imm) & mask; return true;
+    case I_BV_ZERO_EXT: v = arg(0); return true;
+    case I_BV_SIGN_EXT: v = (uint64_t)bv_signed(arg(0), m_code[args[0]].m_width) & mask; return true;
+    case I_BV_SHL: v = arg(1) >= w ? 0 : (arg(0) << arg(1)) & mask; return true;
+    case I_BV_LSHR: v = arg(1) >= w ? 0 : arg(0) >> arg(1); return true;
+    case I_INT_ADD: {
+        int64_t r = 0;
+        for (unsigned j = 0; j < n; ++j) {
+            r += iarg(j);
+            if (!is_small_int(r)) return false;
+        }
+        v = (uint64_t)r;
+        return true;
+    }
+    case I_INT_SUB: {
+        int64_t r = iarg(0);
+        for (unsigned j = 1; j < n; ++j) {
+            r -= iarg(j);
+            if (!is_small_int(r)) return false;
+        }
+        v = (uint64_t)r;
+        return true;
+    }
+    case I_INT_MUL: {
+        int64_t r = 1;
+        for (unsigned j = 0; j < n; ++j) {
+            int64_t a = iarg(j);
+            if (r <= -s_factor_bound || r >= s_factor_bound || a <= -s_factor_bound || a >= s_factor_bound) return false;
+            r *= a;
+        }
+        v = (uint64_t)r;
+        return true;
+    }
+    case I_INT_UMINUS: v = (uint64_t)(-iarg(0)); return true;
+    case I_INT_LE: v = iarg(0) <= iarg(1); return true;
+    case I_INT_LT: v = iarg(0) < iarg(1); return true;
+    case I_INT_GE: v = iarg(0) >= iarg(1); return true;
+    case I_INT_GT: v = iarg(0) > iarg(1); return true;
+    case I_ITE:
+        UNREACHABLE();
+        return false;
+    }
+    return false;
+}
+
+void compiled_evaluator::eval(model_core& mdl) {
+    m_eval = alloc(model_evaluator, mdl);
+    m_eval->set_model_completion(m_model_completion);
+    unsigned sz = m_code.size();
+    m_regs.reset();
+    m_regs.resize(sz, 0);
+    m_valid.reset();
+    m_valid.resize(sz, false);
+    for (unsigned r = 0; r < sz; ++r) {
+        instr const& i = m_code[r];
+        uint64_t v = 0;
+        bool valid = true;
+        if (i.m_op == I_LEAF) {
+            valid = load_leaf(m_leaves.get((unsigned)i.m_imm), i.m_kind, i.m_width, v);
+        }
+        else if (i.m_op == I_CONST) {
+            v = i.m_imm;
+        }
+        else if (i.m_op == I_ITE) {
+            unsigned const* args = m_args.c_ptr() + i.m_arg_begin;
+            unsigned src = m_regs[args[0]] ? args[1] : args[2];
+            valid = m_valid[args[0]] && m_valid[src];
+            v = m_regs[src];
+        }
+        else {
+            for (unsigned j = 0; valid && j < i.m_num_args; ++j) {
+                valid = m_valid[m_args[i.m_arg_begin + j]];
+            }
+            valid = valid && exec(i, v);
+        }
+        m_regs[r] = v;
+        m_valid[r] = valid;
+    }
+}
+
+expr_ref compiled_evaluator::get_value(unsigned r) {
+    SASSERT(m_eval);
+    instr const& i = m_code[r];
+    if (!m_valid[r]) {
+        expr_ref result(m);
+        (*m_eval)(m_exprs.get(r), result);
+        return result;
+    }
+    switch (i.m_kind) {
+    case K_BOOL:
+        return expr_ref(m_regs[r] ? m.mk_true() : m.mk_false(), m);
+    case K_BV:
+        return expr_ref(m_bv.mk_numeral(m_regs[r], i.m_width), m);
+    default:
+        return expr_ref(m_arith.mk_int(rational((int64_t)m_regs[r], rational::i64())), m);
+    }
+}
@@ -0,0 +1,97 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    compiled_evaluator.h
+
+Abstract:
+
+    Evaluate a fixed set of expressions in many models.
+
+    The expressions are compiled once into a straight-line program over
+    registers that hold native values: Booleans, bit-vectors of at most
+    64 bits and integers of small magnitude. Sub-terms that are not
+    covered by the program, such as uninterpreted constants and
+    functions, are leaves that are evaluated with model_evaluator for
+    each model. A register whose value cannot be represented natively,
+    for example because a leaf is not a numeral or an integer operation
+    overflows, is invalid; its value is then obtained by evaluating the
+    original expression with model_evaluator.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "util/obj_hashtable.h"
+#include "model/model_evaluator.h"
+
+class compiled_evaluator {
+    enum opcode {
+        I_LEAF, I_CONST,
+        I_NOT, I_AND, I_OR, I_XOR, I_IMPLIES, I_ITE, I_EQ,
+        I_BV_ADD, I_BV_SUB, I_BV_MUL, I_BV_NEG,
+        I_BV_AND, I_BV_OR, I_BV_XOR, I_BV_NOT,
+        I_BV_ULE, I_BV_ULT, I_BV_UGE, I_BV_UGT,
+        I_BV_SLE, I_BV_SLT, I_BV_SGE, I_BV_SGT,
+        I_BV_CONCAT, I_BV_EXTRACT, I_BV_ZERO_EXT, I_BV_SIGN_EXT,
+        I_BV_SHL, I_BV_LSHR,
+        I_INT_ADD, I_INT_SUB, I_INT_MUL, I_INT_UMINUS,
+        I_INT_LE, I_INT_LT, I_INT_GE, I_INT_GT
+    };
+
+    enum kind { K_BOOL, K_BV, K_INT, K_NONE };
+
+    struct instr {
+        opcode   m_op;
+        kind     m_kind;
+        unsigned m_width;       // width of bit-vector results
+        unsigned m_arg_begin;   // arguments are m_args[m_arg_begin .. m_arg_begin + m_num_args)
+        unsigned m_num_args;
+        uint64_t m_imm;         // constant value, low bit of extract, or leaf index
+    };
+
+    ast_manager&              m;
+    arith_util                m_arith;
+    bv_util                   m_bv;
+    bool                      m_model_completion;
+    svector<instr>            m_code;
+    unsigned_vector           m_args;
+    expr_ref_vector           m_exprs;    // expression computed by each register
+    expr_ref_vector           m_leaves;
+    obj_map<expr, unsigned>   m_expr2reg;
+    svector<uint64_t>         m_regs;
+    bool_vector               m_valid;
+    scoped_ptr<model_evaluator> m_eval;
+
+    bool get_kind(sort* s, kind& k, unsigned& width) const;
+    bool get_opcode(app* t, opcode& op, uint64_t& imm) const;
+    void emit(expr* t);
+    bool load_leaf(expr* t, kind k, unsigned width, uint64_t& v);
+    bool exec(instr const& i, uint64_t& v) const;
+
+public:
+    compiled_evaluator(ast_manager& m);
+
+    void set_model_completion(bool f) { m_model_completion = f; }
+
+    /**
+       \brief compile t into the program and return the register holding its value.
+    */
+    unsigned compile(expr* t);
+
+    /**
+       \brief evaluate all compiled expressions in mdl.
+       The model must remain alive while values are retrieved.
+    */
+    void eval(model_core& mdl);
+
+    /**
+       \brief value of register r in the model of the last call to eval.
+    */
+    expr_ref get_value(unsigned r);
+
+    unsigned size() const { return m_code.size(); }
+};
@@ -22,6 +22,7 @@ Revision History:
 #include "ast/ast_util.h"
 #include "model/func_interp.h"
 #include "ast/array_decl_plugin.h"
+#include "ast/arith_decl_plugin.h"
 
 func_entry::func_entry(ast_manager & m, unsigned arity, expr * const * args, expr * result):
     m_args_are_values(true),
@@ -76,7 +77,8 @@ func_interp::func_interp(ast_manager & m, unsigned arity):
     m_else(nullptr),
     m_args_are_values(true),
     m_interp(nullptr),
-    m_array_interp(nullptr) {
+    m_array_interp(nullptr),
+    m_has_index(false) {
 }
 
 func_interp::~func_interp() {
@@ -176,13 +178,77 @@ bool func_interp::is_constant() const {
    args_are_values to true if for all entries e e.args_are_values() is true.
 */
 func_entry * func_interp::get_entry(expr * const * args) const {
-    for (func_entry* curr : m_entries) {
-        if (curr->eq_args(m(), m_arity, args))
-            return curr;
+    if (!m_has_index && m_entries.size() >= index_threshold)
+        build_index();
+    if (!m_has_index) {
+        for (func_entry* curr : m_entries) {
+            if (curr->eq_args(m(), m_arity, args))
+                return curr;
+        }
+        return nullptr;
+    }
+    unsigned idx;
+    if (m_index.find(hash_args(args), idx)) {
+        for (; idx != UINT_MAX; idx = m_index_next[idx]) {
+            func_entry * curr = m_entries[idx];
+            if (curr->eq_args(m(), m_arity, args))
+                return curr;
+        }
+    }
+    for (unsigned i : m_unindexed) {
+        if (m_entries[i]->eq_args(m(), m_arity, args))
+            return m_entries[i];
     }
     return nullptr;
 }
 
+unsigned func_interp::hash_args(expr * const * args) const {
+    unsigned h = m_arity;
+    for (unsigned i = 0; i < m_arity; i++)
+        h = hash_u_u(h, args[i]->get_id());
+    return h;
+}
+
+void func_interp::reset_index() {
+    m_has_index = false;
+    m_index.reset();
+    m_index_next.reset();
+    m_unindexed.reset();
+}
+
+void func_interp::build_index() const {
+    m_index.reset();
+    m_index_next.reset();
+    m_unindexed.reset();
+    arith_util autil(m());
+    for (unsigned i = 0; i < m_entries.size(); i++)
+        add_to_index(autil, i);
+    m_has_index = true;
+}
+
+/**
+   \brief Add m_entries[idx] to the index.
+   Terms that are equal according to m().are_equal are identical except for
+   irrational algebraic numbers, so entries with such arguments cannot be
+   found by hashing argument identities.
+*/
+void func_interp::add_to_index(arith_util & autil, unsigned idx) const {
+    SASSERT(idx == m_index_next.size());
+    func_entry * curr = m_entries[idx];
+    for (unsigned i = 0; i < m_arity; i++) {
+        if (autil.is_irrational_algebraic_numeral(curr->get_arg(i))) {
+            m_index_next.push_back(UINT_MAX);
+            m_unindexed.push_back(idx);
+            return;
+        }
+    }
+    unsigned h = hash_args(curr->get_args());
+    unsigned prev = UINT_MAX;
+    m_index.find(h, prev);
+    m_index_next.push_back(prev);
+    m_index.insert(h, idx);
+}
+
 void func_interp::insert_entry(expr * const * args, expr * r) {
     reset_interp_cache();
     func_entry * entry = get_entry(args);
@@ -213,6 +279,10 @@ void func_interp::insert_new_entry(expr * const * args, expr * r) {
     if (!new_entry->args_are_values())
         m_args_are_values = false;
     m_entries.push_back(new_entry);
+    if (m_has_index) {
+        arith_util autil(m());
+        add_to_index(autil, m_entries.size() - 1);
+    }
 }
 
 bool func_interp::eval_else(expr * const * args, expr_ref & result) const {
@@ -255,6 +325,7 @@ void func_interp::compress() {
         return; // nothing to be done
     if (!is_ground(m_else))
         return; // forall entries e in m_entries e.get_result() is ground
+    reset_index();
     unsigned j = 0;
     m_args_are_values = true;
     for (func_entry * curr : m_entries) {
@@ -31,8 +31,10 @@ Revision History:
 
 #include "ast/ast.h"
 #include "ast/ast_translation.h"
+#include "util/map.h"
 
 class func_interp;
+class arith_util;
 
 class func_entry {
     bool   m_args_are_values; //!< true if is_value(m_args[i]) is true for all i in [0, arity)
@@ -74,8 +76,23 @@ class func_interp {
 
     expr *                 m_array_interp; // <! interp with lambda abstraction
 
+    // Hash index on argument tuples, built lazily by get_entry once the
+    // number of entries reaches index_threshold. Entries are indexed by the
+    // identities of their arguments; entries whose arguments may be equal to
+    // a different term (irrational algebraic numbers) are kept in m_unindexed.
+    static const unsigned  index_threshold = 16;
+    mutable bool            m_has_index;
+    mutable u_map<unsigned> m_index;       //!< hash of arguments -> index of the last entry with this hash
+    mutable unsigned_vector m_index_next;  //!< index of entry -> index of the previous entry with the same hash
+    mutable unsigned_vector m_unindexed;
+
     void reset_interp_cache();
 
+    void reset_index();
+    void build_index() const;
+    void add_to_index(arith_util & autil, unsigned idx) const;
+    unsigned hash_args(expr * const * args) const;
+
     expr * get_interp_core() const;
 
     expr_ref get_array_interp_core(func_decl * f) const;
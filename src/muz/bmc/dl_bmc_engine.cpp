@@ -483,7 +483,13 @@ namespace datalog {
             q_at_level = m.mk_implies(q, p);
             b.assert_expr(q_at_level);
             expr* qr = q.get();
-            return b.m_solver->check_sat(1, &qr);
+            lbool is_sat = b.m_solver->check_sat(1, &qr);
+            if (is_sat == l_false) {
+                // retire the activation literal of the query, the solver 
+                // can then remove the clauses it guards.
+                b.assert_expr(m.mk_not(q));
+            }
+            return is_sat;
         }
 
         proof_ref get_proof(model_ref& md, func_decl* pred, app* prop, unsigned level) {
@@ -1303,7 +1309,13 @@ namespace datalog {
         lbool check(unsigned level) {
             expr_ref level_query = mk_level_predicate(b.m_query_pred, level);
             expr* q = level_query.get();
-            return b.m_solver->check_sat(1, &q);
+            lbool is_sat = b.m_solver->check_sat(1, &q);
+            if (is_sat == l_false) {
+                // the query is unreachable at this level, keep this 
+                // as a lemma for the deeper levels.
+                b.assert_expr(m.mk_not(q));
+            }
+            return is_sat;
         }
 
         expr_ref mk_level_predicate(func_decl* p, unsigned level) {
@@ -366,7 +366,8 @@ namespace datalog {
         bool perform(execution_context & ctx) override {
             log_verbose(ctx);            
             ++ctx.m_stats.m_join;
-            if (!ctx.reg(m_rel1) || !ctx.reg(m_rel2)) {
+            if (!ctx.reg(m_rel1) || !ctx.reg(m_rel2) ||
+                ctx.reg(m_rel1)->fast_empty() || ctx.reg(m_rel2)->fast_empty()) {
                 ctx.make_empty(m_res);
                 return true;
             }
@@ -824,7 +825,8 @@ namespace datalog {
         }
         bool perform(execution_context & ctx) override {
             log_verbose(ctx);            
-            if (!ctx.reg(m_rel1) || !ctx.reg(m_rel2)) {
+            if (!ctx.reg(m_rel1) || !ctx.reg(m_rel2) ||
+                ctx.reg(m_rel1)->fast_empty() || ctx.reg(m_rel2)->fast_empty()) {
                 ctx.make_empty(m_res);
                 return true;
             }
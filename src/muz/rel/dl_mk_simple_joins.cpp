@@ -35,7 +35,7 @@ namespace datalog {
     }
 
     class join_planner {
-        typedef float cost;
+        typedef double cost;
 
         class pair_info {
             cost m_total_cost;
@@ -64,7 +64,7 @@ namespace datalog {
                 SASSERT(m_consumers > 0);
                 cost amortized = m_total_cost/m_consumers;
                 if (m_stratified) {
-                    return amortized * ( (amortized > 0) ? (1/16.0f) : 16.0f);
+                    return amortized * ( (amortized > 0) ? (1/16.0) : 16.0);
                 }
                 else {
                     return amortized;
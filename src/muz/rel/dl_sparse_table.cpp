@@ -81,6 +81,30 @@ namespace datalog {
         m_reserve=last_ofs;
     }
 
+    void entry_storage::reserve_index(unsigned n) {
+        if (m_data_indexer.size() > 0 || n >= (1u << 30) || m_data_indexer.capacity() >= 2 * n) {
+            return;
+        }
+        storage_indexer indexer(next_power_of_two(2 * n),
+            offset_hash_proc(m_data, m_unique_part_size), offset_eq_proc(m_data, m_unique_part_size));
+        m_data_indexer.swap(indexer);
+    }
+
+    void entry_storage::reserve_entries(unsigned n) {
+        if (entry_count() > 0) {
+            return;
+        }
+        size_t sz = m_data_size;
+        size_t new_sz = sz + static_cast<size_t>(n) * m_entry_size;
+        if (m_entry_size != 0 && (new_sz - sz) / m_entry_size != n) {
+            throw default_exception("multiplication overflow");
+        }
+        // growing and shrinking back keeps the capacity of m_data
+        resize_data(new_sz);
+        resize_data(sz);
+        reserve_index(n);
+    }
+
     unsigned entry_storage::get_size_estimate_bytes() const {
         size_t sz = m_data.capacity();
         sz += m_data_indexer.capacity()*sizeof(storage_indexer::entry);
@@ -913,6 +937,7 @@ namespace datalog {
         const unsigned m_inp_col_cnt;
         const unsigned m_removed_col_cnt;
         const unsigned m_result_col_cnt;
+        unsigned_vector m_kept_cols;
     public:
         project_fn(const table_signature & orig_sig, unsigned removed_col_cnt, const unsigned * removed_cols) 
             : convenient_table_project_fn(orig_sig, removed_col_cnt, removed_cols), 
@@ -920,26 +945,26 @@ namespace datalog {
             m_removed_col_cnt(removed_col_cnt),
             m_result_col_cnt(orig_sig.size()-removed_col_cnt) {
                 SASSERT(removed_col_cnt>0);
-        }
-
-        virtual void transform_row(const char * src, char * tgt, 
-            const sparse_table::column_layout & src_layout, 
-            const sparse_table::column_layout & tgt_layout) {
                 unsigned r_idx=0;
-                unsigned tgt_i=0;
                 for (unsigned i=0; i<m_inp_col_cnt; i++) {
                     if (r_idx!=m_removed_col_cnt && i == m_removed_cols[r_idx]) {
-                        SASSERT(r_idx<m_removed_col_cnt);
                         r_idx++;
                         continue;
                     }
-                    tgt_layout.set(tgt, tgt_i, src_layout.get(src, i));
-                    tgt_i++;
+                    m_kept_cols.push_back(i);
                 }
-                SASSERT(tgt_i == m_result_col_cnt);
+                SASSERT(m_kept_cols.size() == m_result_col_cnt);
                 SASSERT(r_idx == m_removed_col_cnt);
         }
 
+        virtual void transform_row(const char * src, char * tgt, 
+            const sparse_table::column_layout & src_layout, 
+            const sparse_table::column_layout & tgt_layout) {
+                for (unsigned tgt_i=0; tgt_i<m_result_col_cnt; tgt_i++) {
+                    tgt_layout.set(tgt, tgt_i, src_layout.get(src, m_kept_cols[tgt_i]));
+                }
+        }
+
         table_base * operator()(const table_base & tb) override {
             verbose_action  _va("project");
             const sparse_table & t = get(tb);
@@ -952,6 +977,9 @@ namespace datalog {
             const sparse_table::column_layout & src_layout = t.m_column_layout;
             const sparse_table::column_layout & tgt_layout = res->m_column_layout;
 
+            // the projection has at most as many rows as t
+            res->m_data.reserve_entries(t.m_data.entry_count());
+
             const char* t_ptr = t.m_data.begin();
             const char* t_end = t.m_data.after_last();
             for (; t_ptr!=t_end; t_ptr+=t_fact_size) {
@@ -1087,6 +1115,7 @@ namespace datalog {
                 throw default_exception("multiplication overflow");
             }
 
+            res->m_data.reserve_entries(t.row_count());
             res->m_data.resize_data(res_data_size);
 
             //here we can separate data creating and insertion into hashmap, since we know
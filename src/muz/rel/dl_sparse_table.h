@@ -185,6 +185,7 @@ namespace datalog {
         
         entry_storage & operator=(const entry_storage & o) {
             m_data_indexer.reset();
+            reserve_index(o.entry_count());
             m_entry_size = o.m_entry_size;
             m_unique_part_size = o.m_unique_part_size;
             m_data_size = o.m_data_size;
@@ -298,6 +299,14 @@ namespace datalog {
         bool insert_offset(store_offset ofs) {
             return m_data_indexer.insert_if_not_there(ofs)==ofs;
         }
+
+        /**
+           \brief Make room for \c n entries in an empty storage, so that bulk
+           additions do not repeatedly grow the data and rehash the index.
+        */
+        void reserve_entries(unsigned n);
+    private:
+        void reserve_index(unsigned n);
     };
 
     class sparse_table : public table_base {
@@ -98,7 +98,8 @@ namespace datalog {
           m_answer(m), 
           m_last_result_relation(nullptr),
           m_ectx(ctx),
-          m_sw(0) {
+          m_sw(0),
+          m_saturated_rules(ctx.get_rule_manager()) {
 
         // register plugins for builtin tables
 
@@ -229,9 +230,54 @@ namespace datalog {
         return result;
     }
  
+    /**
+       Saturation marks of a previous query remain valid as long as the rules
+       are unchanged and no facts were added to the predicates the marked ones
+       depend on. Only the strata that are affected by new facts are then
+       recompiled and re-evaluated.
+    */
+    void rel_context::reset_stale_saturated_marks() {
+        relation_manager& rm = get_rmanager();
+        rule_set const& rules = m_context.get_rules();
+        bool same_rules = m_saturated_rules.size() == rules.get_num_rules();
+        for (unsigned i = 0; same_rules && i < rules.get_num_rules(); ++i) {
+            same_rules = m_saturated_rules.get(i) == rules.get_rule(i);
+        }
+        if (!same_rules) {
+            rm.reset_saturated_marks();
+            m_saturated_rules.reset();
+            m_saturated_rules.append(rules.get_num_rules(), rules.begin());
+        }
+        else if (!m_modified_preds.empty()) {
+            // invalidate the marks of all predicates that depend on modified ones.
+            bool change = true;
+            while (change) {
+                change = false;
+                for (rule* r : rules) {
+                    func_decl* head = r->get_decl();
+                    if (m_modified_preds.contains(head)) {
+                        continue;
+                    }
+                    unsigned tsz = r->get_uninterpreted_tail_size();
+                    for (unsigned k = 0; k < tsz; ++k) {
+                        if (m_modified_preds.contains(r->get_tail(k)->get_decl())) {
+                            m_modified_preds.insert(head);
+                            change = true;
+                            break;
+                        }
+                    }
+                }
+            }
+            for (func_decl* p : m_modified_preds) {
+                rm.reset_saturated_mark(p);
+            }
+        }
+        m_modified_preds.reset();
+    }
+ 
     lbool rel_context::query(unsigned num_rels, func_decl * const* rels) {
         setup_default_relation();
-        get_rmanager().reset_saturated_marks();
+        reset_stale_saturated_marks();
         scoped_query _scoped_query(m_context);
         for (unsigned i = 0; i < num_rels; ++i) {
             m_context.set_output_predicate(rels[i]);
@@ -332,7 +378,11 @@ namespace datalog {
 
     lbool rel_context::query(expr* query) {
         setup_default_relation();
+        // the query rules and magic set transformation make the marks
+        // specific to this query.
         get_rmanager().reset_saturated_marks();
+        m_saturated_rules.reset();
+        m_modified_preds.reset();
         scoped_query _scoped_query(m_context);
         rule_manager& rm = m_context.get_rule_manager();
         func_decl_ref query_pred(m);
@@ -443,6 +493,7 @@ namespace datalog {
                 TRACE("dl", tout << "Resetting: " << mk_ismt2_pp(pred, m) << "\n";);
                 rel.reset();
             }
+            get_rmanager().reset_saturated_mark(pred);
         }
     }
 
@@ -550,7 +601,7 @@ namespace datalog {
     }
  
     void rel_context::add_fact(func_decl* pred, relation_fact const& fact) {
-        get_rmanager().reset_saturated_marks();
+        m_modified_preds.insert(pred);
         get_relation(pred).add_fact(fact);
         if (!m_context.print_aig().is_null()) {
             m_table_facts.push_back(std::make_pair(pred, fact));
@@ -558,7 +609,7 @@ namespace datalog {
     }
 
     void rel_context::add_fact(func_decl* pred, table_fact const& fact) {
-        get_rmanager().reset_saturated_marks();
+        m_modified_preds.insert(pred);
         relation_base & rel0 = get_relation(pred);
         if (rel0.from_table()) {
             table_relation & rel = static_cast<table_relation &>(rel0);
@@ -580,6 +631,7 @@ namespace datalog {
     }
 
     void rel_context::store_relation(func_decl * pred, relation_base * rel) {
+        m_modified_preds.insert(pred);
         get_rmanager().store_relation(pred, rel);
     }
 
@@ -212,8 +212,26 @@ tbv& tbv_manager::set_or(tbv& dst,  tbv const& src) const {
     return dst;
 }
 bool tbv_manager::set_and(tbv& dst,  tbv const& src) const {
-    m.set_and(dst, src); 
-    return is_well_formed(dst);
+    return set_and(dst, src, dst);
+}
+
+// dst := a & b, return true if dst is well formed.
+// Conjunction and well-formedness check are done in a single pass.
+bool tbv_manager::set_and(tbv const& a, tbv const& b, tbv& dst) const {
+    unsigned nw = m.num_words();
+    if (nw == 0) return true;
+    unsigned ok = 0xFFFFFFFF;
+    unsigned w;
+    for (unsigned i = 0; i + 1 < nw; ++i) {
+        w = a.m_data[i] & b.m_data[i];
+        dst.m_data[i] = w;
+        ok &= w | (w << 1) | 0x55555555;
+    }
+    w = a.m_data[nw-1] & b.m_data[nw-1];
+    dst.m_data[nw-1] = w;
+    w &= m.get_mask();
+    ok &= w | (w << 1) | 0x55555555 | ~m.get_mask();
+    return ok == 0xFFFFFFFF;
 }
 
 bool tbv_manager::is_well_formed(tbv const& dst) const {
@@ -274,8 +292,7 @@ bool tbv_manager::contains(tbv const& a, unsigned_vector const& colsa,
 }
 
 bool tbv_manager::intersect(tbv const& a, tbv const& b, tbv& result) {
-    copy(result, a);
-    return set_and(result, b);
+    return set_and(a, b, result);
 }
 
 std::ostream& tbv_manager::display(std::ostream& out, tbv const& b, unsigned hi, unsigned lo) const {
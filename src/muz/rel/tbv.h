@@ -67,6 +67,7 @@ public:
     tbv& fill1(tbv& bv) const;
     tbv& fillX(tbv& bv) const;
     bool set_and(tbv& dst,  tbv const& src) const;
+    bool set_and(tbv const& a, tbv const& b, tbv& dst) const;
     tbv& set_or(tbv& dst,  tbv const& src) const;
     void complement(tbv const& src, ptr_vector<tbv>& result);
     bool equals(tbv const& a, tbv const& b) const;
@@ -183,9 +183,25 @@ void pob_queue::push(pob &n) {
         n.set_in_queue(true);
         m_data.push (&n);
         n.get_context().new_pob_eh(&n);
+        if (m_data.size() >= m_compact_lim) { compact(); }
     }
 }
 
+/// remove closed pobs that are below the top of the queue.
+/// Pobs are closed without being removed from the queue, and with
+/// many predicates they accumulate and slow down every push and pop.
+void pob_queue::compact() {
+    ptr_buffer<pob> live;
+    while (!m_data.empty()) {
+        pob *p = m_data.top();
+        m_data.pop();
+        if (p->is_closed() && !is_root(*p)) { p->set_in_queue(false); }
+        else { live.push_back(p); }
+    }
+    for (pob *p : live) { m_data.push(p); }
+    m_compact_lim = std::max(1024u, 2 * static_cast<unsigned>(m_data.size()));
+}
+
 // ----------------
 // derivation
 
@@ -1982,62 +1998,61 @@ bool pred_transformer::frames::add_lemma(lemma *new_lemma)
         return true;
     }
 
-    unsigned i = 0;
-    for (auto *old_lemma : m_lemmas) {
-        if (old_lemma->get_expr() == new_lemma->get_expr()) {
-            m_pt.get_context().new_lemma_eh(m_pt, new_lemma);
+    lemma *old_lemma = nullptr;
+    if (m_expr2lemma.find(new_lemma->get_expr(), old_lemma)) {
+        m_pt.get_context().new_lemma_eh(m_pt, new_lemma);
 
-            // register existing lemma with the pob
-            if (new_lemma->has_pob()) {
-                pob_ref &pob = new_lemma->get_pob();
-                if (!pob->lemmas().contains(old_lemma))
-                    pob->add_lemma(old_lemma);
-            }
+        // register existing lemma with the pob
+        if (new_lemma->has_pob()) {
+            pob_ref &pob = new_lemma->get_pob();
+            if (!pob->lemmas().contains(old_lemma))
+                pob->add_lemma(old_lemma);
+        }
 
-            // extend bindings if needed
+        // extend bindings if needed
+        if (!new_lemma->get_bindings().empty()) {
+            old_lemma->add_binding(new_lemma->get_bindings());
+        }
+        // if the lemma is at a higher level, skip it,
+        if (old_lemma->level() >= new_lemma->level()) {
+            TRACE("spacer", tout << "Already at a higher level: "
+                  << pp_level(old_lemma->level()) << "\n";);
+            // but, since the instances might be new, assert the
+            // instances that have been copied into m_lemmas[i]
             if (!new_lemma->get_bindings().empty()) {
-                old_lemma->add_binding(new_lemma->get_bindings());
+                m_pt.add_lemma_core(old_lemma, true);
             }
-            // if the lemma is at a higher level, skip it,
-            if (old_lemma->level() >= new_lemma->level()) {
-                TRACE("spacer", tout << "Already at a higher level: "
-                      << pp_level(old_lemma->level()) << "\n";);
-                // but, since the instances might be new, assert the
-                // instances that have been copied into m_lemmas[i]
-                if (!new_lemma->get_bindings().empty()) {
-                    m_pt.add_lemma_core(old_lemma, true);
-                }
-                if (is_infty_level(old_lemma->level())) {
-                    old_lemma->bump();
-                    if (old_lemma->get_bumped() >= 100) {
-                        IF_VERBOSE(1, verbose_stream() << "Adding lemma to oo "
-                                   << old_lemma->get_bumped() << " "
-                                   << mk_pp(old_lemma->get_expr(),
-                                            m_pt.get_ast_manager()) << "\n";);
-                        throw default_exception("Stuck on a lemma");
-                    }
+            if (is_infty_level(old_lemma->level())) {
+                old_lemma->bump();
+                if (old_lemma->get_bumped() >= 100) {
+                    IF_VERBOSE(1, verbose_stream() << "Adding lemma to oo "
+                               << old_lemma->get_bumped() << " "
+                               << mk_pp(old_lemma->get_expr(),
+                                        m_pt.get_ast_manager()) << "\n";);
+                    throw default_exception("Stuck on a lemma");
                 }
-                // no new lemma added
-                return false;
             }
+            // no new lemma added
+            return false;
+        }
 
-            // update level of the existing lemma
-            old_lemma->set_level(new_lemma->level());
-            // assert lemma in the solver
-            m_pt.add_lemma_core(old_lemma, false);
-            // move the lemma to its new place to maintain sortedness
-            unsigned sz = m_lemmas.size();
-            for (unsigned j = i;
-                 (j + 1) < sz && m_lt(m_lemmas[j + 1], m_lemmas[j]); ++j) {
-                m_lemmas.swap (j, j+1);
-            }
-            return true;
+        // update level of the existing lemma
+        old_lemma->set_level(new_lemma->level());
+        // assert lemma in the solver
+        m_pt.add_lemma_core(old_lemma, false);
+        // move the lemma to its new place to maintain sortedness
+        unsigned i = 0, sz = m_lemmas.size();
+        while (m_lemmas.get(i) != old_lemma) ++i;
+        for (unsigned j = i;
+             (j + 1) < sz && m_lt(m_lemmas[j + 1], m_lemmas[j]); ++j) {
+            m_lemmas.swap (j, j+1);
         }
-        i++;
+        return true;
     }
 
     // new_lemma is really new
     m_lemmas.push_back(new_lemma);
+    m_expr2lemma.insert(new_lemma->get_expr(), new_lemma);
     // XXX because m_lemmas is reduced, keep secondary vector of all lemmas
     // XXX so that pob can refer to its lemmas without creating reference cycles
     m_pinned_lemmas.push_back(new_lemma);
@@ -2202,6 +2217,8 @@ void pred_transformer::frames::simplify_formulas ()
     if (new_lemmas.size() < m_lemmas.size()) {
         m_lemmas.reset();
         m_lemmas.append(new_lemmas);
+        m_expr2lemma.reset();
+        for (lemma *l : m_lemmas) { m_expr2lemma.insert(l->get_expr(), l); }
         m_sorted = false;
         sort();
     }
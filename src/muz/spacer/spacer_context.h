@@ -224,6 +224,7 @@ class pred_transformer {
         lemma_ref_vector m_pinned_lemmas;  // all created lemmas
         lemma_ref_vector m_lemmas;         // active lemmas
         lemma_ref_vector m_bg_invs;        // background (assumed) invariants
+        obj_map<expr, lemma*> m_expr2lemma; // active lemma of each lemma expression
         unsigned m_size;                   // num of frames
 
         bool m_sorted;                     // true if m_lemmas is sorted by m_lt
@@ -819,11 +820,14 @@ class pob_queue {
     pob_ref  m_root;
     unsigned m_max_level;
     unsigned m_min_depth;
+    unsigned m_compact_lim;
 
     pob_queue_ty  m_data;
 
+    void compact();
+
 public:
-    pob_queue(): m_root(nullptr), m_max_level(0), m_min_depth(0) {}
+    pob_queue(): m_root(nullptr), m_max_level(0), m_min_depth(0), m_compact_lim(1024) {}
     ~pob_queue() {}
 
     void reset();
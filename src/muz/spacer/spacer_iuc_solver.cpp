@@ -103,9 +103,54 @@ namespace spacer {
         return m_first_assumption;
     }
     
+    /// keep m_model a model of all assertions: definitions of fresh
+    /// proxies extend it, any other assertion it does not satisfy drops it.
+    void iuc_solver::update_model (expr *t) {
+        if (!m_model) return;
+        expr *p = nullptr;
+        if (m.is_or(t) && to_app(t)->get_num_args() == 2 &&
+            m.is_not(to_app(t)->get_arg(0), p) && is_uninterp_const(p) &&
+            !m_model->has_interpretation(to_app(p)->get_decl())) {
+            bool val = m_model->is_true(to_app(t)->get_arg(1));
+            m_model->register_decl(to_app(p)->get_decl(), val ? m.mk_true() : m.mk_false());
+            m_model->reset_eval_cache();
+            return;
+        }
+        if (!m_model->is_true(t)) { m_model = nullptr; }
+    }
+
+    /// return true if m_model satisfies the background and the given assumptions
+    bool iuc_solver::reuse_model (unsigned num_assumptions, expr * const *assumptions) {
+        m_use_model = false;
+        if (!m_model) return false;
+        for (expr *a : m_assumptions)
+            if (!m_model->is_true(a)) return false;
+        for (unsigned i = 0; i < num_assumptions; ++i)
+            if (!m_model->is_true(assumptions[i])) return false;
+        m_use_model = true;
+        ++m_num_reused_models;
+        return true;
+    }
+
+    void iuc_solver::get_model_core (model_ref &mdl) {
+        if (m_use_model) {
+            mdl = m_model;
+            return;
+        }
+        m_solver.get_model(mdl);
+        m_model = mdl;
+    }
+
     lbool iuc_solver::check_sat_core (unsigned num_assumptions, expr * const *assumptions) {
         // -- remove any old assumptions
         m_assumptions.shrink(m_first_assumption);
+
+        // -- a model of a previous query may already satisfy this one
+        if (reuse_model(num_assumptions, assumptions)) {
+            m_assumptions.append(num_assumptions, assumptions);
+            m_is_proxied = false;
+            return set_status(l_true);
+        }
         
         // -- replace theory literals in background assumptions with proxies
         mk_proxies (m_assumptions);
@@ -125,6 +170,7 @@ namespace spacer {
         
         // -- remove any old assumptions
         m_assumptions.shrink(m_first_assumption);
+        m_use_model = false;
         
         // -- replace theory literals in background assumptions with proxies
         mk_proxies(m_assumptions);
@@ -193,6 +239,7 @@ namespace spacer {
         st.update ("time.iuc_solver.get_iuc.learn_core", m_learn_core_sw.get_seconds());
         
         st.update("iuc_solver.num_proxies", m_proxies.size());
+        st.update("iuc_solver.num_reused_models", m_num_reused_models);
     }
     
     void iuc_solver::reset_statistics () {
@@ -200,6 +247,7 @@ namespace spacer {
         m_hyp_reduce1_sw.reset();
         m_hyp_reduce2_sw.reset();
         m_learn_core_sw.reset();
+        m_num_reused_models = 0;
     }
     
     void iuc_solver::get_unsat_core (expr_ref_vector &core) {
@@ -51,6 +51,10 @@ private:
     expr_ref_vector     m_assumptions;
     unsigned            m_first_assumption;
     bool                m_is_proxied;
+    // -- model of all current assertions, reused by queries it satisfies
+    model_ref           m_model;
+    bool                m_use_model;
+    unsigned            m_num_reused_models;
 
     stopwatch m_iuc_sw;
     stopwatch m_hyp_reduce1_sw;
@@ -68,6 +72,8 @@ private:
     app* mk_proxy(expr *v);
     app* fresh_proxy();
     void elim_proxies(expr_ref_vector &v);
+    void update_model(expr *t);
+    bool reuse_model(unsigned num_assumptions, expr * const *assumptions);
 public:
     iuc_solver(solver &solver, unsigned iuc, unsigned iuc_arith,
                bool print_farkas_stats, bool old_hyp_reducer,
@@ -80,6 +86,8 @@ public:
         m_assumptions(m),
         m_first_assumption(0),
         m_is_proxied(false),
+        m_use_model(false),
+        m_num_reused_models(0),
         m_elim_proxies_sub(m, false, true),
         m_split_literals(split_literals),
         m_iuc(iuc),
@@ -118,7 +126,7 @@ public:
     void pop_params() override { m_solver.pop_params(); }
     void collect_param_descrs(param_descrs &r) override  { m_solver.collect_param_descrs(r); }
     void set_produce_models(bool f) override  { m_solver.set_produce_models(f); }
-    void assert_expr_core(expr *t) override  { m_solver.assert_expr(t); }
+    void assert_expr_core(expr *t) override  { update_model(t); m_solver.assert_expr(t); }
     void assert_expr_core2(expr *t, expr *a) override   { NOT_IMPLEMENTED_YET(); }
     expr_ref_vector cube(expr_ref_vector&, unsigned) override { return expr_ref_vector(m); }
     void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) override { m_solver.get_levels(vars, depth); }
@@ -150,7 +158,7 @@ public:
     virtual void reset_statistics();
 
     void get_unsat_core(expr_ref_vector &r) override;
-    void get_model_core(model_ref &m) override {m_solver.get_model(m);}
+    void get_model_core(model_ref &m) override;
     proof *get_proof() override {return m_solver.get_proof();}
     std::string reason_unknown() const override { return m_solver.reason_unknown(); }
     void set_reason_unknown(char const* msg) override { m_solver.set_reason_unknown(msg); }
@@ -29,7 +29,7 @@ Revision History:
 
 using namespace spacer;
 
-sym_mux::sym_mux(ast_manager & m) : m(m) {}
+sym_mux::sym_mux(ast_manager & m) : m(m), m_shift_pinned(m) {}
 sym_mux::~sym_mux() {
     for (auto &entry : m_entries) {
         dealloc(entry.m_value);
@@ -159,12 +159,34 @@ public:
 };
 }
 
+sym_mux::shift_cache &sym_mux::get_shift_cache(unsigned src_idx,
+                                                unsigned tgt_idx) const {
+    for (shift_cache *c : m_shift_caches) {
+        if (c->m_src_idx == src_idx && c->m_tgt_idx == tgt_idx) { return *c; }
+    }
+    m_shift_caches.push_back(alloc(shift_cache, src_idx, tgt_idx));
+    return *m_shift_caches.back();
+}
+
 void sym_mux::shift_expr(expr * f, unsigned src_idx, unsigned tgt_idx,
                          expr_ref & res, bool homogenous) const {
-    if (src_idx == tgt_idx) {res = f;}
-    else {
-        conv_rewriter_cfg r_cfg(*this, src_idx, tgt_idx, homogenous);
-        rewriter_tpl<conv_rewriter_cfg> rwr(m, false, r_cfg);
-        rwr(f, res);
+    if (src_idx == tgt_idx) {res = f; return;}
+    shift_cache &cache = get_shift_cache(src_idx, tgt_idx);
+    expr *shifted = nullptr;
+    if (cache.m_shifted.find(f, shifted)) {res = shifted; return;}
+
+    // res may hold the only reference to f
+    expr_ref src(f, m);
+    conv_rewriter_cfg r_cfg(*this, src_idx, tgt_idx, homogenous);
+    rewriter_tpl<conv_rewriter_cfg> rwr(m, false, r_cfg);
+    rwr(src, res);
+
+    // bound the memory held by the caches
+    if (m_shift_pinned.size() >= 1 << 16) {
+        for (shift_cache *c : m_shift_caches) { c->m_shifted.reset(); }
+        m_shift_pinned.reset();
     }
+    m_shift_pinned.push_back(src);
+    m_shift_pinned.push_back(res);
+    cache.m_shifted.insert(src, res);
 }
@@ -26,6 +26,7 @@ Revision History:
 #include "ast/ast.h"
 #include "util/map.h"
 #include "util/vector.h"
+#include "util/scoped_ptr_vector.h"
 
 namespace spacer {
 class sym_mux {
@@ -40,12 +41,24 @@ private:
     typedef obj_map<func_decl, sym_mux_entry*> decl2entry_map;
     typedef obj_map<func_decl, std::pair<sym_mux_entry*, unsigned> > mux2entry_map;
 
+    // results of shift_expr from src_idx to tgt_idx
+    struct shift_cache {
+        unsigned m_src_idx;
+        unsigned m_tgt_idx;
+        obj_map<expr, expr*> m_shifted;
+        shift_cache(unsigned src_idx, unsigned tgt_idx) :
+            m_src_idx(src_idx), m_tgt_idx(tgt_idx) {}
+    };
+
     ast_manager &m;
     mutable decl2entry_map m_entries;
     mutable mux2entry_map m_muxes;
+    mutable scoped_ptr_vector<shift_cache> m_shift_caches;
+    mutable expr_ref_vector m_shift_pinned;
 
     func_decl_ref mk_variant(func_decl *fdecl, unsigned i) const;
     void ensure_capacity(sym_mux_entry &entry, unsigned sz) const;
+    shift_cache &get_shift_cache(unsigned src_idx, unsigned tgt_idx) const;
 
 public:
     sym_mux(ast_manager & m);
@@ -81,7 +94,8 @@ public:
     /**
       \brief Convert src_idx symbols in formula f variant into
       tgt_idx.  If homogenous is true, formula cannot contain symbols
-      of other variants.
+      of other variants. Lemmas and transition relations are shifted 
+      repeatedly, so the results are cached.
     */
     void shift_expr(expr * f, unsigned src_idx, unsigned tgt_idx,
                     expr_ref & res, bool homogenous = true) const;
@@ -39,6 +39,7 @@ namespace nlsat {
         polynomial_ref_vector   m_ps2;
         polynomial_ref_vector   m_psc_tmp;
         polynomial_ref_vector   m_factors;
+        polynomial_ref_vector   m_derivatives;  // derivative of p w.r.t. max_var(p), indexed by the id of cached p
         scoped_anum_vector      m_roots_tmp;
         bool                    m_simplify_cores;
         bool                    m_full_dimensional;
@@ -142,6 +143,7 @@ namespace nlsat {
             m_ps2(m_pm),
             m_psc_tmp(m_pm),
             m_factors(m_pm),
+            m_derivatives(m_pm),
             m_roots_tmp(m_am),
             m_todo(u),
             m_core1(s),
@@ -229,10 +231,35 @@ namespace nlsat {
            \brief Wrapper for psc chain computation
         */
         void psc_chain(polynomial_ref & p, polynomial_ref & q, unsigned x, polynomial_ref_vector & result) {
-            // TODO caching
             SASSERT(max_var(p) == max_var(q));
             SASSERT(max_var(p) == x);
-            m_cache.psc_chain(p, q, x, result);
+            // The chains of (p, q) and (q, p) coincide up to sign, and only their
+            // zeros and factors are used. So, the pair is ordered before consulting
+            // the cache to reuse the chain independently of the order of the projection set.
+            poly * a = m_cache.mk_unique(p);
+            poly * b = m_cache.mk_unique(q);
+            if (m_pm.id(a) > m_pm.id(b))
+                std::swap(a, b);
+            m_cache.psc_chain(a, b, x, result);
+        }
+
+        /**
+           \brief Return the derivative of p with respect to its maximal variable x.
+           The derivatives are memoized across explanations.
+        */
+        poly * derivative_max_var(polynomial_ref const & p, var x) {
+            SASSERT(max_var(p) == x);
+            poly * u = m_cache.mk_unique(p);
+            unsigned id = m_pm.id(u);
+            poly * d = m_derivatives.get(id, nullptr);
+            if (d == nullptr) {
+                polynomial_ref r(m_pm);
+                r = m_pm.derivative(u, x);
+                d = m_cache.mk_unique(r);
+                m_derivatives.reserve(id + 1);
+                m_derivatives.set(id, d);
+            }
+            return d;
         }
         
         /**
@@ -688,7 +715,7 @@ namespace nlsat {
                 p = ps.get(i);
                 if (degree(p, x) < 2)
                     continue;
-                p_prime = derivative(p, x);
+                p_prime = derivative_max_var(p, x);
                 psc(p, p_prime, x);
             }
         }
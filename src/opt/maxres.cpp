@@ -430,25 +430,29 @@ public:
     }
 
     struct compare_asm {
-        maxres& mr;
-        compare_asm(maxres& mr):mr(mr) {}
-        bool operator()(expr* a, expr* b) const {
-            rational w1 = mr.get_weight(a);
-            rational w2 = mr.get_weight(b);
-            return w1 > w2 || (w1 == w2 && a->get_id() > b->get_id());
+        bool operator()(std::pair<rational, expr*> const& a, std::pair<rational, expr*> const& b) const {
+            return a.first > b.first || (a.first == b.first && a.second->get_id() > b.second->get_id());
         }
     };
 
+    /**
+       Sort assumptions by decreasing weight.
+       Weights are looked up once per assumption instead of once per comparison.
+    */
     void sort_assumptions(expr_ref_vector& _asms) {
-        compare_asm comp(*this);
-        exprs asms(_asms.size(), _asms.c_ptr());
+        vector<std::pair<rational, expr*>> asms;
+        for (expr* a : _asms) {
+            asms.push_back(std::make_pair(get_weight(a), a));
+        }
         expr_ref_vector trail(_asms);
-        std::sort(asms.begin(), asms.end(), comp);
+        std::sort(asms.begin(), asms.end(), compare_asm());
         _asms.reset();
-        _asms.append(asms.size(), asms.c_ptr());
+        for (auto const& p : asms) {
+            _asms.push_back(p.second);
+        }
         DEBUG_CODE(
             for (unsigned i = 0; i + 1 < asms.size(); ++i) {
-                SASSERT(get_weight(asms[i]) >= get_weight(asms[i+1]));
+                SASSERT(asms[i].first >= asms[i+1].first);
             });
     }
 
@@ -836,6 +840,7 @@ public:
         m_found_feasible_optimum = false;
         m_last_index = 0;
         add_upper_bound_block();
+        enable_sls(false);
         m_csmodel = nullptr;
         m_correction_set_size = 0;
         return l_true;
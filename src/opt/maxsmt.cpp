@@ -25,6 +25,7 @@ Notes:
 #include "opt/maxsmt.h"
 #include "opt/maxres.h"
 #include "opt/maxlex.h"
+#include "opt/oll.h"
 #include "opt/wmax.h"
 #include "opt/opt_params.hpp"
 #include "opt/opt_context.h"
@@ -250,6 +251,9 @@ namespace opt {
         else if (maxsat_engine == symbol("sortmax")) {
             m_msolver = mk_sortmax(m_c, m_weights, m_soft_constraints);
         }
+        else if (maxsat_engine == symbol("oll")) {
+            m_msolver = mk_oll(m_c, m_weights, m_soft_constraints);
+        }
         else {
             auto str = maxsat_engine.str();
             warning_msg("solver %s is not recognized, using default 'maxres'", str.c_str());
@@ -0,0 +1,325 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    oll.cpp
+
+Abstract:
+
+    OLL core-guided (weighted) max-sat algorithm.
+
+    Every soft constraint is represented by an assumption literal.
+    Given an unsatisfiable core C of assumptions with minimal weight w,
+    the lower bound is increased by w and the weights of the assumptions
+    in C are decreased by w. Instead of re-encoding the relaxed core,
+    a totalizer is built over the negations of the literals in C and the
+    new assumption "at most 1 of C is false" is added with weight w.
+    When a totalizer assumption "at most k of C are false" occurs in a
+    later core, the totalizer is extended by one more output and
+    "at most k+1 of C are false" is assumed with weight w.
+
+    Totalizers are built incrementally: a node only defines the outputs
+    up to the bound that is currently needed, so extending a bound adds
+    the clauses for one more output instead of encoding the whole sum.
+    Only the direction from inputs to outputs is encoded, which
+    suffices because outputs are only assumed to be false.
+
+--*/
+
+#include "ast/ast_pp.h"
+#include "ast/ast_util.h"
+#include "solver/solver.h"
+#include "solver/mus.h"
+#include "opt/maxsmt.h"
+#include "opt/oll.h"
+#include "opt/opt_context.h"
+
+namespace opt {
+
+    class oll : public maxsmt_solver_base {
+
+        /**
+           Node of a totalizer. m_outs[i] is implied when at least i+1 of
+           the inputs below the node are true.
+        */
+        struct node {
+            unsigned         m_size;
+            node*            m_left;
+            node*            m_right;
+            expr_ref_vector  m_outs;
+            node(ast_manager& m, unsigned sz, node* l, node* r):
+                m_size(sz), m_left(l), m_right(r), m_outs(m) {}
+        };
+
+        /**
+           Assumption that at most m_bound inputs of the totalizer m_root are true.
+        */
+        struct sum {
+            node*    m_root;
+            unsigned m_bound;
+            sum(node* r, unsigned b): m_root(r), m_bound(b) {}
+        };
+
+        struct stats {
+            unsigned m_num_cores;
+            unsigned m_num_totalizers;
+            unsigned m_num_extensions;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
+        expr_ref_vector           m_asms;
+        obj_map<expr, rational>   m_asm2weight;
+        obj_map<expr, unsigned>   m_asm2sum;
+        vector<sum>               m_sums;
+        scoped_ptr_vector<node>   m_nodes;
+        mus                       m_mus;
+        expr_ref_vector           m_new_core;
+        stats                     m_stats;
+
+    public:
+        oll(maxsat_context& c, weights_t& ws, expr_ref_vector const& soft):
+            maxsmt_solver_base(c, ws, soft),
+            m_asms(m),
+            m_mus(c.get_solver()),
+            m_new_core(m) {}
+
+        ~oll() override {}
+
+        lbool operator()() override {
+            if (!init()) {
+                return l_undef;
+            }
+            lbool is_sat = init_local();
+            if (is_sat != l_true) {
+                return is_sat;
+            }
+            while (m_lower < m_upper) {
+                trace_bounds("oll");
+                is_sat = s().check_sat(m_asms);
+                if (!m.inc()) {
+                    return l_undef;
+                }
+                switch (is_sat) {
+                case l_true:
+                    s().get_model(m_model);
+                    update_assignment();
+                    m_lower = m_upper;
+                    break;
+                case l_false:
+                    is_sat = process_core();
+                    if (is_sat != l_true) {
+                        return is_sat;
+                    }
+                    break;
+                default:
+                    return l_undef;
+                }
+            }
+            trace_bounds("oll");
+            return l_true;
+        }
+
+        void collect_statistics(statistics& st) const override {
+            st.update("oll-cores", m_stats.m_num_cores);
+            st.update("oll-totalizers", m_stats.m_num_totalizers);
+            st.update("oll-totalizer-extensions", m_stats.m_num_extensions);
+        }
+
+    private:
+
+        lbool init_local() {
+            m_lower.reset();
+            obj_map<expr, rational> new_soft;
+            lbool is_sat = find_mutexes(new_soft);
+            if (is_sat != l_true) {
+                return is_sat;
+            }
+            for (auto const& kv : new_soft) {
+                add_soft(kv.m_key, kv.m_value);
+            }
+            update_assignment();
+            return l_true;
+        }
+
+        bool is_literal(expr* l) {
+            return
+                is_uninterp_const(l) ||
+                (m.is_not(l, l) && is_uninterp_const(l));
+        }
+
+        void add_soft(expr* e, rational const& w) {
+            rational weight;
+            if (m_asm2weight.find(e, weight)) {
+                m_asm2weight.insert(e, weight + w);
+                return;
+            }
+            expr_ref asum(e, m);
+            if (!is_literal(e)) {
+                asum = mk_fresh_bool("soft");
+                s().assert_expr(m.mk_implies(asum, e));
+            }
+            new_assumption(asum, w);
+        }
+
+        void new_assumption(expr* e, rational const& w) {
+            TRACE("opt", tout << "assume: " << mk_pp(e, m) << " : " << w << "\n";);
+            m_asm2weight.insert(e, w);
+            m_asms.push_back(e);
+            m_trail.push_back(e);
+        }
+
+        void update_assignment() {
+            rational upper(0);
+            for (soft& s : m_soft) {
+                s.set_value(m_model->is_true(s.s));
+                if (!s.is_true()) {
+                    upper += s.weight;
+                }
+            }
+            m_upper = upper;
+        }
+
+        lbool minimize_core(expr_ref_vector& core) {
+            if (core.empty() || m_c.sat_enabled()) {
+                return l_true;
+            }
+            m_mus.reset();
+            m_mus.add_soft(core.size(), core.c_ptr());
+            lbool is_sat = m_mus.get_mus(m_new_core);
+            if (is_sat != l_true) {
+                return is_sat;
+            }
+            core.reset();
+            core.append(m_new_core);
+            return l_true;
+        }
+
+        lbool process_core() {
+            expr_ref_vector core(m);
+            s().get_unsat_core(core);
+            lbool is_sat = minimize_core(core);
+            if (is_sat != l_true) {
+                return is_sat;
+            }
+            ++m_stats.m_num_cores;
+            if (core.empty()) {
+                m_lower = m_upper;
+                return l_true;
+            }
+            rational w = m_asm2weight[core.get(0)];
+            for (expr* a : core) {
+                if (m_asm2weight[a] < w) {
+                    w = m_asm2weight[a];
+                }
+            }
+            m_lower += w;
+            IF_VERBOSE(2, verbose_stream() << "(opt.oll :core-size " << core.size() << " :weight " << w << ")\n";);
+
+            for (expr* a : core) {
+                m_asm2weight[a] -= w;
+            }
+            unsigned j = 0;
+            for (expr* a : m_asms) {
+                if (m_asm2weight[a].is_pos()) {
+                    m_asms[j++] = a;
+                }
+            }
+            m_asms.shrink(j);
+
+            for (expr* a : core) {
+                unsigned idx;
+                if (m_asm2sum.find(a, idx)) {
+                    ++m_stats.m_num_extensions;
+                    assume_sum(m_sums[idx].m_root, m_sums[idx].m_bound + 1, w);
+                }
+            }
+
+            if (core.size() > 1) {
+                expr_ref_vector ins(m);
+                for (expr* a : core) {
+                    ins.push_back(mk_not(m, a));
+                }
+                ++m_stats.m_num_totalizers;
+                assume_sum(mk_totalizer(0, ins.size(), ins), 1, w);
+            }
+            return l_true;
+        }
+
+        /**
+           Assume that at most bound inputs of the totalizer are true.
+           Assumptions that already exist accumulate the weight.
+        */
+        void assume_sum(node* root, unsigned bound, rational const& w) {
+            if (bound >= root->m_size) {
+                return;
+            }
+            ensure_outputs(root, bound + 1);
+            expr_ref a(mk_not(m, root->m_outs.get(bound)), m);
+            rational wa;
+            if (m_asm2weight.find(a, wa) && wa.is_pos()) {
+                m_asm2weight.insert(a, wa + w);
+                return;
+            }
+            if (!m_asm2sum.contains(a)) {
+                m_asm2sum.insert(a, m_sums.size());
+                m_sums.push_back(sum(root, bound));
+            }
+            new_assumption(a, w);
+        }
+
+        node* mk_totalizer(unsigned lo, unsigned hi, expr_ref_vector const& ins) {
+            node* n;
+            if (hi - lo == 1) {
+                n = alloc(node, m, 1, nullptr, nullptr);
+                n->m_outs.push_back(ins.get(lo));
+            }
+            else {
+                unsigned mid = (lo + hi) / 2;
+                node* l = mk_totalizer(lo, mid, ins);
+                node* r = mk_totalizer(mid, hi, ins);
+                n = alloc(node, m, hi - lo, l, r);
+            }
+            m_nodes.push_back(n);
+            return n;
+        }
+
+        /**
+           Define the outputs of n up to index k - 1.
+           Outputs that are already defined keep their clauses: all
+           combinations of child outputs that sum up to an existing index
+           were encoded when the index was created.
+        */
+        void ensure_outputs(node* n, unsigned k) {
+            k = std::min(k, n->m_size);
+            if (n->m_outs.size() >= k) {
+                return;
+            }
+            node* l = n->m_left, *r = n->m_right;
+            ensure_outputs(l, k);
+            ensure_outputs(r, k);
+            expr_ref_vector lits(m);
+            for (unsigned i = n->m_outs.size() + 1; i <= k; ++i) {
+                expr* out = mk_fresh_bool("tot");
+                n->m_outs.push_back(out);
+                for (unsigned a = 0; a <= i; ++a) {
+                    unsigned b = i - a;
+                    if (a > l->m_outs.size() || b > r->m_outs.size()) {
+                        continue;
+                    }
+                    lits.reset();
+                    if (a > 0) lits.push_back(mk_not(m, l->m_outs.get(a - 1)));
+                    if (b > 0) lits.push_back(mk_not(m, r->m_outs.get(b - 1)));
+                    lits.push_back(out);
+                    s().assert_expr(mk_or(lits));
+                }
+            }
+        }
+    };
+
+    maxsmt_solver_base* mk_oll(maxsat_context& c, weights_t& ws, expr_ref_vector const& soft) {
+        return alloc(oll, c, ws, soft);
+    }
+
+}
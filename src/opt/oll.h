@@ -0,0 +1,21 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    oll.h
+
+Abstract:
+
+    OLL core-guided (weighted) max-sat algorithm by Morgado, Dodaro
+    and Marques-Silva, CP 2014, using incremental totalizers.
+
+--*/
+
+#pragma once
+
+namespace opt {
+
+    maxsmt_solver_base* mk_oll(maxsat_context& c, weights_t & ws, expr_ref_vector const& soft);
+
+};
@@ -696,11 +696,22 @@ namespace opt {
         m_solver = m_sat_solver.get();
     }
 
+    /**
+       Run local search next to CDCL in the SAT solver used for MaxSAT.
+       ddfw handles pure clausal problems and the generic local search
+       also handles cardinality and PB constraints. Models found by local
+       search on the current assumptions are returned as satisfying
+       assignments, which improve the upper bound, and both share their
+       phases with the CDCL solver.
+    */
     void context::enable_sls(bool force) {
+#ifndef SINGLE_THREAD
         if ((force || m_enable_sls) && m_sat_solver.get()) {
-            m_params.set_bool("optimize_model", true);
+            m_params.set_uint("ddfw.threads", 1);
+            m_params.set_uint("local_search_threads", 1);
             m_sat_solver->updt_params(m_params);
         }
+#endif
     }
 
     struct context::is_bv {
@@ -32,27 +32,30 @@ namespace opt {
         expr_ref fml(m);
         lbool is_sat = m_solver->check_sat(0, nullptr);
         if (is_sat == l_true) {
-            {
-                m_solver->get_model(m_model);
-                solver::scoped_push _s(*m_solver.get());
-                while (is_sat == l_true) {
-                    if (!m.inc()) {
-                        return l_undef;
-                    }
-                    if (!m_model)
-                        return l_undef;
-                    m_solver->get_labels(m_labels);                    
-                    m_model->set_model_completion(true);
-                    IF_VERBOSE(1,
-                               model_ref mdl(m_model);
-                               cb.fix_model(mdl); 
-                               model_smt2_pp(verbose_stream() << "new model:\n", m, *mdl, 0););
-                    // TBD: we can also use local search to tune solution coordinate-wise.
-                    mk_dominates();
-                    is_sat = m_solver->check_sat(0, nullptr);
-                    if (is_sat == l_true) m_solver->get_model(m_model);
+            // The dominance constraints of this point are guarded by an
+            // assumption instead of a scope, so that lemmas learned while
+            // climbing are kept for the following points.
+            app_ref guard(m.mk_fresh_const("pareto", m.mk_bool_sort()), m);
+            cb.fm().hide(guard);
+            expr* asms[1] = { guard.get() };
+            m_solver->get_model(m_model);
+            while (is_sat == l_true) {
+                if (!m.inc() || !m_model) {
+                    is_sat = l_undef;
+                    break;
                 }
+                m_solver->get_labels(m_labels);                    
+                m_model->set_model_completion(true);
+                IF_VERBOSE(1,
+                           model_ref mdl(m_model);
+                           cb.fix_model(mdl); 
+                           model_smt2_pp(verbose_stream() << "new model:\n", m, *mdl, 0););
+                // TBD: we can also use local search to tune solution coordinate-wise.
+                mk_dominates(guard);
+                is_sat = m_solver->check_sat(1, asms);
+                if (is_sat == l_true) m_solver->get_model(m_model);
             }
+            m_solver->assert_expr(m.mk_not(guard));
             if (is_sat == l_undef) {
                 return l_undef;
             }
@@ -63,7 +66,7 @@ namespace opt {
         return is_sat;
     }
 
-    void pareto_base::mk_dominates() {
+    void pareto_base::mk_dominates(expr* guard) {
         unsigned sz = cb.num_objectives();
         expr_ref fml(m);
         expr_ref_vector gt(m), fmls(m);
@@ -72,7 +75,7 @@ namespace opt {
             gt.push_back(cb.mk_gt(i, m_model));
         }
         fmls.push_back(mk_or(gt));
-        fml = mk_and(fmls);
+        fml = m.mk_implies(guard, mk_and(fmls));
         IF_VERBOSE(10, verbose_stream() << "dominates: " << fml << "\n";);
         TRACE("opt", model_smt2_pp(tout << fml << "\n", m, *m_model, 0););
         m_solver->assert_expr(fml);        
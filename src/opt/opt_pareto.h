@@ -21,6 +21,7 @@ Notes:
 
 #include "solver/solver.h"
 #include "model/model.h"
+#include "tactic/generic_model_converter.h"
 
 namespace opt {
    
@@ -31,6 +32,7 @@ namespace opt {
         virtual expr_ref mk_ge(unsigned i, model_ref& model) = 0;
         virtual expr_ref mk_le(unsigned i, model_ref& model) = 0;
         virtual void fix_model(model_ref& m) = 0;
+        virtual generic_model_converter& fm() = 0;
     };
     class pareto_base {
     protected:
@@ -74,7 +76,7 @@ namespace opt {
 
     protected:
 
-        void mk_dominates();
+        void mk_dominates(expr* guard);
 
         void mk_not_dominated_by();            
     };
@@ -207,6 +207,10 @@ namespace opt {
         unsigned step_incs = 0;
         rational delta_per_step(1);
         unsigned num_scopes = 0;
+        // once a step fails, the objective is known to be below hi and
+        // the steps bisect the remaining interval.
+        bool has_hi = false, has_last = false;
+        rational hi, last_value;
 
         while (m.inc()) {
             SASSERT(delta_per_step.is_int());
@@ -222,9 +226,20 @@ namespace opt {
                 SASSERT(m_model);
                 inf_eps obj = m_s->saved_objective_value(obj_index);
                 update_lower_lex(obj_index, obj, is_maximize);
+                bool is_int_value = is_int && obj.is_rational() && obj.get_rational().is_int();
+                if (has_hi && !is_int_value) {
+                    has_hi = false;
+                }
+                if (has_hi && obj.get_rational() + rational::one() >= hi) {
+                    // no better value below hi.
+                    break;
+                }
                 if (!is_int || !m_lower[obj_index].is_finite()) {
                     delta_per_step = rational(1);
                 }
+                else if (has_hi) {
+                    delta_per_step = div(hi - obj.get_rational(), rational(2));
+                }
                 else if (steps > step_incs) {
                     delta_per_step *= rational(2);
                     ++step_incs;
@@ -237,6 +252,10 @@ namespace opt {
                     m_s->push();
                     ++num_scopes;
                     bound = m_s->mk_ge(obj_index, obj + inf_eps(delta_per_step));
+                    has_last = is_int_value;
+                    if (has_last) {
+                        last_value = obj.get_rational();
+                    }
                 }
                 TRACE("opt", tout << "delta: " << delta_per_step << " " << bound << "\n";);
                 if (bound == last_bound) {
@@ -246,6 +265,10 @@ namespace opt {
                 last_bound = bound;
             }
             else if (is_sat == l_false && delta_per_step > rational::one()) {
+                if (has_last) {
+                    hi = last_value + delta_per_step;
+                    has_hi = true;
+                }
                 steps = 0;
                 step_incs = 0;
                 delta_per_step = rational::one();
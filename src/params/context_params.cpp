@@ -104,6 +104,9 @@ void context_params::set(char const * param, char const * value) {
     else if (p == "dot_proof_file") {
         m_dot_proof_file = value;  
     }
+    else if (p == "proof_stream_file") {
+        m_proof_stream_file = value;
+    }
     else if (p == "unsat_core") {
         if (!m_unsat_core) 
             set_bool(m_unsat_core, param, value);
@@ -141,6 +144,7 @@ void context_params::updt_params(params_ref const & p) {
     m_trace             = p.get_bool("trace", m_trace);
     m_trace_file_name   = p.get_str("trace_file_name", "z3.log");
     m_dot_proof_file    = p.get_str("dot_proof_file", "proof.dot");
+    m_proof_stream_file = p.get_str("proof_stream_file", m_proof_stream_file.c_str());
     m_unsat_core        |= p.get_bool("unsat_core", m_unsat_core);
     m_debug_ref_count   = p.get_bool("debug_ref_count", m_debug_ref_count);
     m_smtlib2_compliant = p.get_bool("smtlib2_compliant", m_smtlib2_compliant);
@@ -158,6 +162,7 @@ void context_params::collect_param_descrs(param_descrs & d) {
     d.insert("trace", CPK_BOOL, "trace generation for VCC", "false");
     d.insert("trace_file_name", CPK_STRING, "trace out file name (see option 'trace')", "z3.log");
     d.insert("dot_proof_file", CPK_STRING, "file in which to output graphical proofs", "proof.dot");
+    d.insert("proof_stream_file", CPK_STRING, "file to which proof steps are written as they are created, it requires proof generation", "");
     d.insert("debug_ref_count", CPK_BOOL, "debug support for AST reference counting", "false");
     d.insert("smtlib2_compliant", CPK_BOOL, "enable/disable SMT-LIB 2.0 compliance", "false");
     d.insert("stats", CPK_BOOL, "enable/disable statistics", "false");
@@ -33,6 +33,7 @@ public:
     bool        m_auto_config { true };
     bool        m_proof { false };
     std::string m_dot_proof_file;
+    std::string m_proof_stream_file;
     bool        m_debug_ref_count { false };
     bool        m_trace { false };
     std::string m_trace_file_name;
@@ -32,6 +32,11 @@ Revision History:
 #include "parsers/util/pattern_validation.h"
 #include "parsers/util/parser_params.hpp"
 #include<sstream>
+#ifndef SINGLE_THREAD
+#include<condition_variable>
+#include<mutex>
+#include<thread>
+#endif
 
 namespace smt2 {
     typedef cmd_exception parser_exception;
@@ -3174,7 +3179,151 @@ namespace smt2 {
     };
 };
 
+#ifndef SINGLE_THREAD
+namespace smt2 {
+
+    /**
+       \brief stream buffer that reads its source on a background thread.
+
+       The reader frames the input into blocks that end at the close of a
+       top-level command, tracking strings, quoted symbols and comments, and
+       hands complete blocks to the parser while it reads ahead. The parser sees
+       the same characters as it would from the source; framing only decides
+       where blocks are cut. A block without a command boundary is passed on whole.
+    */
+    class pipelined_streambuf : public std::streambuf {
+        static const unsigned   block_size = 1 << 20;
+        enum class state { normal, string, quoted, comment };
+        std::istream&           m_source;
+        svector<char>           m_current, m_ready;
+        bool                    m_has_ready { false };
+        bool                    m_eof { false };
+        bool                    m_done { false };
+        std::mutex              m_mux;
+        std::condition_variable m_cv;
+        std::thread             m_thread;
+        // framing state of the reader thread
+        state                   m_state { state::normal };
+        unsigned                m_depth { 0 };
+        bool                    m_escape { false };
+
+        // return the position after the last top-level command in [begin, end).
+        unsigned frame(char const* buffer, unsigned begin, unsigned end) {
+            unsigned boundary = 0;
+            for (unsigned i = begin; i < end; ++i) {
+                char c = buffer[i];
+                switch (m_state) {
+                case state::normal:
+                    if (c == '(') 
+                        ++m_depth;
+                    else if (c == ')' && m_depth > 0 && --m_depth == 0) 
+                        boundary = i + 1;
+                    else if (c == '"') 
+                        m_state = state::string;
+                    else if (c == '|') 
+                        m_state = state::quoted;
+                    else if (c == ';') 
+                        m_state = state::comment;
+                    break;
+                case state::string:
+                    if (c == '"') m_state = state::normal;
+                    break;
+                case state::quoted:
+                    if (c == '|' && !m_escape) m_state = state::normal;
+                    m_escape = (c == '\\');
+                    break;
+                case state::comment:
+                    if (c == '\n') m_state = state::normal;
+                    break;
+                }
+            }
+            return boundary;
+        }
+
+        bool hand_off(svector<char>& block) {
+            std::unique_lock<std::mutex> lock(m_mux);
+            m_cv.wait(lock, [&]() { return !m_has_ready || m_done; });
+            if (m_done) 
+                return false;
+            m_ready.swap(block);
+            m_has_ready = true;
+            m_cv.notify_all();
+            return true;
+        }
+
+        void run() {
+            svector<char> block, carry;
+            while (true) {
+                unsigned sz = carry.size();
+                block.reset();
+                block.append(carry);
+                carry.reset();
+                block.resize(sz + block_size);
+                m_source.read(block.c_ptr() + sz, block_size);
+                unsigned n = static_cast<unsigned>(m_source.gcount());
+                block.shrink(sz + n);
+                if (n == 0) {
+                    if (!block.empty()) 
+                        hand_off(block);
+                    break;
+                }
+                unsigned boundary = frame(block.c_ptr(), sz, sz + n);
+                if (boundary > 0) {
+                    carry.append(block.size() - boundary, block.c_ptr() + boundary);
+                    block.shrink(boundary);
+                }
+                if (!hand_off(block)) 
+                    return;
+            }
+            std::lock_guard<std::mutex> lock(m_mux);
+            m_eof = true;
+            m_cv.notify_all();
+        }
+
+    protected:
+        int_type underflow() override {
+            if (gptr() < egptr()) 
+                return traits_type::to_int_type(*gptr());
+            {
+                std::unique_lock<std::mutex> lock(m_mux);
+                m_cv.wait(lock, [&]() { return m_has_ready || m_eof; });
+                if (!m_has_ready) 
+                    return traits_type::eof();
+                m_current.swap(m_ready);
+                m_has_ready = false;
+            }
+            m_cv.notify_all();
+            setg(m_current.begin(), m_current.begin(), m_current.end());
+            return traits_type::to_int_type(*gptr());
+        }
+
+    public:
+        pipelined_streambuf(std::istream& source): m_source(source) {
+            m_thread = std::thread([&]() { run(); });
+        }
+
+        ~pipelined_streambuf() override {
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                m_done = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+        }
+    };
+};
+#endif
+
 bool parse_smt2_commands(cmd_context & ctx, std::istream & is, bool interactive, params_ref const & ps, char const * filename) {
+#ifndef SINGLE_THREAD
+    parser_params pp(ps);
+    if (!interactive && pp.pipeline()) {
+        smt2::pipelined_streambuf buf(is);
+        std::istream in(&buf);
+        smt2::parser p(ctx, in, interactive, ps, filename);
+        return p();
+    }
+#endif
     smt2::parser p(ctx, is, interactive, ps, filename);
     return p();
 }
@@ -21,7 +21,30 @@ Revision History:
 
 namespace smt2 {
 
-    void scanner::next() {
+    /**
+       \brief digits of numerals are accumulated in a machine word and folded
+       into the rational only when the word would overflow.
+    */
+    static void fold_digits(rational& r, uint64_t& acc, uint64_t& scale) {
+        if (r.is_zero()) {
+            r = rational(acc, rational::ui64());
+        }
+        else {
+            r *= rational(scale, rational::ui64());
+            r += rational(acc, rational::ui64());
+        }
+        acc = 0;
+        scale = 1;
+    }
+
+    static void push_digit(rational& r, uint64_t& acc, uint64_t& scale, unsigned base, unsigned d) {
+        if (scale > UINT64_MAX / base)
+            fold_digits(r, acc, scale);
+        acc = acc * base + d;
+        scale *= base;
+    }
+
+    void scanner::next_core() {
         if (m_cache_input)
             m_cache.push_back(m_curr);
         if (m_at_eof)
@@ -36,7 +59,7 @@ namespace smt2 {
             m_bpos++;
         }
         else {
-            m_stream.read(m_buffer, SCANNER_BUFFER_SIZE);
+            m_stream.read(m_buffer.c_ptr(), SCANNER_BUFFER_SIZE);
             m_bend = static_cast<unsigned>(m_stream.gcount());
             m_bpos = 0;
             if (m_bpos == m_bend) {
@@ -146,16 +169,23 @@ namespace smt2 {
     scanner::token scanner::read_number() {
         SASSERT('0' <= curr() && curr() <= '9');
         rational q(1);
-        m_number = rational(curr() - '0');
+        uint64_t acc = 0, scale = 1, qscale = 1;
+        m_number = rational::zero();
+        push_digit(m_number, acc, scale, 10, curr() - '0');
         next();
         bool is_float = false;
 
         while (!m_at_eof) {
             char c = curr();
             if ('0' <= c && c <= '9') {
-                m_number = rational(10)*m_number + rational(c - '0');
-                if (is_float)
-                    q *= rational(10);
+                push_digit(m_number, acc, scale, 10, c - '0');
+                if (is_float) {
+                    if (qscale > UINT64_MAX / 10) {
+                        q *= rational(qscale, rational::ui64());
+                        qscale = 1;
+                    }
+                    qscale *= 10;
+                }
                 next();
             }
             else if (c == '.') {
@@ -168,8 +198,11 @@ namespace smt2 {
                 break;
             }
         }
-        if (is_float)
+        fold_digits(m_number, acc, scale);
+        if (is_float) {
+            q *= rational(qscale, rational::ui64());
             m_number /= q;
+        }
         TRACE("scanner", tout << "new number: " << m_number << "\n";);
         return is_float ? FLOAT_TOKEN : INT_TOKEN;
     }
@@ -222,22 +255,21 @@ namespace smt2 {
             c = curr();
             m_number  = rational(0);
             m_bv_size = 0;
+            uint64_t acc = 0, scale = 1;
             while (true) {
                 if ('0' <= c && c <= '9') {
-                    m_number *= rational(16);
-                    m_number += rational(c - '0');
+                    push_digit(m_number, acc, scale, 16, c - '0');
                 }
                 else if ('a' <= c && c <= 'f') {
-                    m_number *= rational(16);
-                    m_number += rational(10 + (c - 'a'));
+                    push_digit(m_number, acc, scale, 16, 10 + (c - 'a'));
                 }
                 else if ('A' <= c && c <= 'F') {
-                    m_number *= rational(16);
-                    m_number += rational(10 + (c - 'A'));
+                    push_digit(m_number, acc, scale, 16, 10 + (c - 'A'));
                 }
                 else {
                     if (m_bv_size == 0)
                         throw scanner_exception("invalid empty bit-vector literal", m_line, m_spos);
+                    fold_digits(m_number, acc, scale);
                     return BV_TOKEN;
                 }
                 m_bv_size += 4;
@@ -250,15 +282,16 @@ namespace smt2 {
             c = curr();
             m_number  = rational(0);
             m_bv_size = 0;
+            uint64_t acc = 0, scale = 1;
             while (c == '0' || c == '1') {
-                m_number *= rational(2);
-                m_number += rational(c - '0');
+                push_digit(m_number, acc, scale, 2, c - '0');
                 m_bv_size++;
                 next();
                 c = curr();
             }
             if (m_bv_size == 0)
                 throw scanner_exception("invalid empty bit-vector literal", m_line, m_spos);
+            fold_digits(m_number, acc, scale);
             return BV_TOKEN;
         }
         else if (c == '|') {
@@ -284,6 +317,7 @@ namespace smt2 {
         m_stream(stream),
         m_cache_input(false) {
 
+        m_buffer.resize(SCANNER_BUFFER_SIZE);
 
         for (int i = 0; i < 256; ++i) {
             m_normalized[i] = (signed char) i;
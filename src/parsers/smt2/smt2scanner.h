@@ -44,8 +44,8 @@ namespace smt2 {
         unsigned           m_bv_size;
         // end of data
         signed char        m_normalized[256];
-#define SCANNER_BUFFER_SIZE 1024
-        char               m_buffer[SCANNER_BUFFER_SIZE];
+#define SCANNER_BUFFER_SIZE (1 << 16)
+        svector<char>      m_buffer;
         unsigned           m_bpos;
         unsigned           m_bend;
         svector<char>      m_string;
@@ -58,7 +58,18 @@ namespace smt2 {
         
         char curr() const { return m_curr; }
         void new_line() { m_line++; m_spos = 0; }
-        void next();
+        void next_core();
+
+        void next() {
+            // fast path: the next character is available in the current block.
+            if (m_bpos < m_bend && !m_cache_input && !m_interactive) {
+                m_curr = m_buffer[m_bpos++];
+                m_spos++;
+            }
+            else {
+                next_core();
+            }
+        }
         
     public:
         
@@ -110,6 +110,15 @@ namespace qe {
 
         ~term() {}
 
+        // -- remove this term from the parents of its children (inverse of the constructor)
+        void del_from_parents() {
+            for (unsigned i = m_children.size(); i-- > 0; ) {
+                term& r = m_children[i]->get_root();
+                SASSERT(r.m_parents.back() == this);
+                r.m_parents.pop_back();
+            }
+        }
+
         class parents {
             term const& t;
         public:
@@ -170,6 +179,8 @@ namespace qe {
         void set_root(term &r) {m_root = &r;}
         term &get_next() const {return *m_next;}
         void add_parent(term* p) { m_parents.push_back(p); }
+        unsigned get_num_parents() const { return m_parents.size(); }
+        void shrink_parents(unsigned n) { m_parents.shrink(n); }
 
         unsigned get_class_size() const {return m_class_size;}
 
@@ -180,6 +191,20 @@ namespace qe {
             b.m_class_size = 0;
         }
 
+        // -- split off the class of b that was merged into this class.
+        void unmerge_eq_class(term &b, unsigned b_size) {
+            SASSERT(is_root());
+            std::swap(this->m_next, b.m_next);
+            m_class_size -= b_size;
+            b.m_class_size = b_size;
+            term *curr = &b;
+            do {
+                curr->set_root(b);
+                curr = &curr->get_next();
+            }
+            while (curr != &b);
+        }
+
         // -- make this term the root of its equivalence class
         void mk_root() {
             if (is_root()) return;
@@ -313,6 +338,8 @@ namespace qe {
 
         m_terms.push_back(t);
         m_app2term.insert(a->get_id(), t);
+        if (!m_trail_lim.empty())
+            m_trail.push_back(undo(undo::add_term_k, t));
         return t;
     }
 
@@ -385,6 +412,8 @@ namespace qe {
         if (a->get_class_size() > b->get_class_size()) {
             std::swap(a, b);
         }
+        if (!m_trail_lim.empty())
+            m_trail.push_back(undo(undo::merge_k, a, b, a->get_num_parents(), b->get_class_size()));
 
         // Remove parents of b from the cg table.
         for (term* p : term::parents(b)) {
@@ -525,6 +554,8 @@ namespace qe {
         // -- if found something better, make it the new root
         if (r != &t) {
             r->mk_root();
+            if (!m_trail_lim.empty())
+                m_trail.push_back(undo(undo::new_root_k, r, &t));
         }
     }
 
@@ -577,6 +608,60 @@ namespace qe {
         m_terms.reset();
         m_lits.reset();
         m_cg_table.reset();
+        m_trail.reset();
+        m_trail_lim.reset();
+        m_lits_lim.reset();
+    }
+
+    void term_graph::push() {
+        SASSERT(m_merge.empty());
+        m_trail_lim.push_back(m_trail.size());
+        m_lits_lim.push_back(m_lits.size());
+    }
+
+    void term_graph::pop(unsigned num_scopes) {
+        if (num_scopes == 0)
+            return;
+        SASSERT(num_scopes <= m_trail_lim.size());
+        unsigned lvl = m_trail_lim.size() - num_scopes;
+        unsigned trail_lim = m_trail_lim[lvl];
+        for (unsigned i = m_trail.size(); i-- > trail_lim; ) {
+            undo const& u = m_trail[i];
+            switch (u.m_kind) {
+            case undo::add_term_k:
+                SASSERT(m_terms.back() == u.m_a);
+                u.m_a->del_from_parents();
+                m_app2term.remove(u.m_a->get_id());
+                m_terms.pop_back();
+                dealloc(u.m_a);
+                break;
+            case undo::merge_k:
+                u.m_a->shrink_parents(u.m_num);
+                u.m_a->unmerge_eq_class(*u.m_b, u.m_size);
+                break;
+            case undo::new_root_k:
+                u.m_b->mk_root();
+                break;
+            }
+        }
+        m_trail.shrink(trail_lim);
+        m_lits.shrink(m_lits_lim[lvl]);
+        m_trail_lim.shrink(lvl);
+        m_lits_lim.shrink(lvl);
+
+        // -- cached representatives and congruence table entries
+        // -- refer to the retracted classes.
+        m_term2app.reset();
+        m_pinned.reset();
+        m_cg_table.reset();
+        for (term* t : m_terms)
+            if (t->get_num_args() > 0)
+                m_cg_table.insert_if_not_there(t);
+        m_is_var.reset_solved();
+        expr* v = nullptr;
+        for (expr* lit : m_lits)
+            if (is_pure_def(lit, v))
+                m_is_var.mark_solved(v);
     }
 
     class term_graph::projector {
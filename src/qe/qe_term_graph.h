@@ -57,6 +57,21 @@ namespace qe {
         ptr_hashtable<term, term_hash, term_eq> m_cg_table;
         vector<std::pair<term*,term*>> m_merge;
 
+        // -- undo trail for scoped additions
+        struct undo {
+            enum kind { add_term_k, merge_k, new_root_k };
+            kind     m_kind;
+            term*    m_a;
+            term*    m_b;
+            unsigned m_num; // number of parents of m_a before merge
+            unsigned m_size; // class size of m_b before merge
+            undo(kind k, term* a, term* b = nullptr, unsigned n = 0, unsigned sz = 0):
+                m_kind(k), m_a(a), m_b(b), m_num(n), m_size(sz) {}
+        };
+        svector<undo>      m_trail;
+        unsigned_vector    m_trail_lim;
+        unsigned_vector    m_lits_lim;
+
         term_graph::is_variable_proc m_is_var;
         void merge(term &t1, term &t2);
         void merge_flush();
@@ -101,6 +116,14 @@ namespace qe {
 
         void reset();
 
+        /**
+         * Scoped additions: literals added after push are retracted by pop,
+         * congruence classes of literals added before push are kept.
+         */
+        void push();
+        void pop(unsigned num_scopes);
+        unsigned get_num_scopes() const { return m_trail_lim.size(); }
+
         // deprecate?
         void to_lits(expr_ref_vector &lits, bool all_equalities = false);
         expr_ref to_expr();
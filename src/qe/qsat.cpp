@@ -20,6 +20,7 @@ Notes:
 
 --*/
 
+#include "util/scoped_ptr_vector.h"
 #include "ast/expr_abstract.h"
 #include "ast/ast_util.h"
 #include "ast/occurs.h"
@@ -599,6 +600,7 @@ namespace qe {
         
         struct stats {
             unsigned m_num_rounds;        
+            unsigned m_num_cached_projections;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };        
@@ -626,6 +628,17 @@ namespace qe {
         expr_ref                   m_gt;
         opt::inf_eps               m_value_save;
 
+        // projections of cubes, they are kept between calls.
+        struct projection {
+            app_ref_vector  m_vars;
+            expr_ref_vector m_proj;
+            projection(ast_manager& m): m_vars(m), m_proj(m) {}
+        };
+        obj_map<expr, unsigned>        m_cube2proj;   // sorted conjunction of a cube -> index in m_projections
+        scoped_ptr_vector<projection>  m_projections;
+        expr_ref_vector                m_cubes;
+        static const unsigned          m_max_projections = 10000;
+
         
         /**
            \brief check alternating satisfiability.
@@ -740,6 +753,49 @@ namespace qe {
             m_ex.clear();                    
         }
 
+        /**
+           \brief project m_avars from the cube core using mdl.
+           A projection computed for the same cube and variables with an
+           earlier model is reused when it holds in mdl: it implies the
+           projection of the cube and it is satisfied by the model, which
+           is what model based projection guarantees.
+        */
+        void mbp(model& mdl, expr_ref_vector& core) {
+            expr_ref_vector lits(core);
+            std::sort(lits.c_ptr(), lits.c_ptr() + lits.size(), ast_lt_proc());
+            expr_ref cube = mk_and(lits);
+            unsigned idx;
+            if (m_cube2proj.find(cube, idx)) {
+                projection const& p = *m_projections[idx];
+                if (p.m_vars == m_avars && mdl.is_true(p.m_proj)) {
+                    ++m_stats.m_num_cached_projections;
+                    core.reset();
+                    core.append(p.m_proj);
+                    m_avars.reset();
+                    return;
+                }
+            }
+            app_ref_vector vars(m_avars);
+            m_mbp(force_elim(), m_avars, mdl, core);
+            if (!m_avars.empty())
+                return;
+            if (m_projections.size() >= m_max_projections) {
+                m_cube2proj.reset();
+                m_projections.reset();
+                m_cubes.reset();
+            }
+            projection* p = alloc(projection, m);
+            p->m_vars.append(vars);
+            p->m_proj.append(core);
+            if (m_cube2proj.find(cube, idx)) {
+                m_projections.set(idx, p);
+                return;
+            }
+            m_cube2proj.insert(cube, m_projections.size());
+            m_projections.push_back(p);
+            m_cubes.push_back(cube);
+        }
+
         void reset() override {
             clear();
             m_fa.init();
@@ -912,7 +968,7 @@ namespace qe {
             SASSERT(validate_core(mdl, core));
             get_vars(m_level);
             SASSERT(validate_assumptions(mdl, core));
-            m_mbp(force_elim(), m_avars, mdl, core);
+            mbp(mdl, core);
             SASSERT(validate_defs("project_qe"));
             if (m_mode == qsat_maximize) {
                 maximize_core(core, mdl);
@@ -937,7 +993,7 @@ namespace qe {
             SASSERT(validate_core(mdl, core));
             get_vars(m_level-1);
             SASSERT(validate_project(mdl, core));
-            m_mbp(force_elim(), m_avars, mdl, core);
+            mbp(mdl, core);
             TRACE("qe", tout << "aux vars: " << m_avars << "\n";);
             for (app* v : m_avars) m_pred_abs.ensure_expr_level(v, m_level-1);
             m_free_vars.append(m_avars);
@@ -1251,7 +1307,8 @@ namespace qe {
             m_objective(nullptr),
             m_value(nullptr),
             m_was_sat(false),
-            m_gt(m)
+            m_gt(m),
+            m_cubes(m)
         {
         }
         
@@ -1349,6 +1406,7 @@ namespace qe {
             m_ex.collect_statistics(st);        
             m_pred_abs.collect_statistics(st);
             st.update("qsat num rounds", m_stats.m_num_rounds); 
+            st.update("qsat cached projections", m_stats.m_num_cached_projections);
             m_pred_abs.collect_statistics(st);
         }
         
@@ -16,6 +16,17 @@ Author:
 Revision History:
 
 --*/
+#include <fstream>
+#include <sstream>
+#ifndef _WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 #include "sat/dimacs.h"
 #undef max
 #undef min
@@ -142,6 +153,176 @@ bool parse_dimacs(std::istream & in, std::ostream& err, sat::solver & solver) {
     return parse_dimacs_core(_in, err, solver);
 }
 
+namespace {
+
+    /**
+       \brief buffer over a character range, with the same interface as dimacs::stream_buffer.
+    */
+    class memory_buffer {
+        char const* m_curr;
+        char const* m_end;
+        unsigned    m_line;
+    public:
+        memory_buffer(char const* begin, char const* end): m_curr(begin), m_end(end), m_line(0) {}
+
+        int operator*() const {
+            return m_curr < m_end ? static_cast<unsigned char>(*m_curr) : EOF;
+        }
+
+        void operator++() {
+            ++m_curr;
+            if (m_curr < m_end && *m_curr == '\n') ++m_line;
+        }
+
+        unsigned line() const { return m_line; }
+    };
+
+    /**
+       \brief read-only mapping of a file into memory.
+    */
+    class mapped_file {
+        char const* m_data { nullptr };
+        size_t      m_size { 0 };
+        bool        m_mapped { false };
+    public:
+        mapped_file(char const* file_name) {
+#ifndef _WINDOWS
+            int fd = open(file_name, O_RDONLY);
+            if (fd < 0)
+                return;
+            struct stat st;
+            if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+                m_size = static_cast<size_t>(st.st_size);
+                if (m_size == 0) 
+                    m_mapped = true;
+                else {
+                    void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (data != MAP_FAILED) {
+                        madvise(data, m_size, MADV_SEQUENTIAL);
+                        m_data = static_cast<char const*>(data);
+                        m_mapped = true;
+                    }
+                }
+            }
+            close(fd);
+#endif
+        }
+
+        ~mapped_file() {
+#ifndef _WINDOWS
+            if (m_data)
+                munmap(const_cast<char*>(m_data), m_size);
+#endif
+        }
+
+        bool is_mapped() const { return m_mapped; }
+        char const* begin() const { return m_data; }
+        char const* end() const { return m_data + m_size; }
+        size_t size() const { return m_size; }
+    };
+
+    /**
+       \brief tokenize a range that begins at the start of a line into a sequence of
+       literals where 0 terminates clauses. Clauses may straddle ranges.
+    */
+    bool tokenize_dimacs(char const* begin, char const* end, std::ostream& err, svector<int>& lits) {
+        memory_buffer in(begin, end);
+        try {
+            while (true) {
+                skip_whitespace(in);
+                if (*in == EOF) 
+                    break;
+                else if (*in == 'c' || *in == 'p') 
+                    skip_line(in);
+                else 
+                    lits.push_back(parse_int(in, err));
+            }
+        }
+        catch (dimacs::lex_error) {
+            return false;
+        }
+        return true;
+    }
+
+    const size_t min_chunk_size = 1 << 23;
+
+    /**
+       \brief split the input at line boundaries, tokenize the pieces in parallel and add
+       the clauses in order. Returns l_false if the input is not well-formed.
+    */
+    lbool parse_dimacs_parallel(char const* begin, char const* end, sat::solver& solver) {
+#ifdef SINGLE_THREAD
+        return l_undef;
+#else
+        size_t size = end - begin;
+        unsigned num_chunks = std::min(std::thread::hardware_concurrency(), static_cast<unsigned>(size / min_chunk_size));
+        if (num_chunks <= 1) 
+            return l_undef;
+        ptr_vector<char const> bounds;
+        bounds.push_back(begin);
+        for (unsigned i = 1; i < num_chunks; ++i) {
+            char const* p = std::max(bounds.back(), begin + i * (size / num_chunks));
+            while (p < end && *p != '\n') ++p;
+            bounds.push_back(p < end ? p + 1 : end);
+        }
+        bounds.push_back(end);
+        vector<svector<int>> lits(num_chunks);
+        svector<bool> ok(num_chunks, true);
+        vector<std::thread> threads;
+        for (unsigned i = 0; i < num_chunks; ++i) {
+            threads.push_back(std::thread([&, i]() {
+                std::ostringstream err;
+                ok[i] = tokenize_dimacs(bounds[i], bounds[i + 1], err, lits[i]);
+            }));
+        }
+        for (std::thread& t : threads) 
+            t.join();
+        int max_var = 0;
+        for (unsigned i = 0; i < num_chunks; ++i) {
+            if (!ok[i])
+                return l_false;
+            for (int l : lits[i]) 
+                max_var = std::max(max_var, abs(l));
+        }
+        if (!lits.back().empty() && lits.back().back() != 0) 
+            return l_false;
+        while (static_cast<unsigned>(max_var) >= solver.num_vars())
+            solver.mk_var();
+        sat::literal_vector clause;
+        for (svector<int>& ls : lits) {
+            for (int l : ls) {
+                if (l == 0) {
+                    solver.mk_clause(clause.size(), clause.c_ptr());
+                    clause.reset();
+                }
+                else {
+                    clause.push_back(sat::literal(abs(l), l < 0));
+                }
+            }
+            ls.finalize();
+        }
+        return l_true;
+#endif
+    }
+}
+
+bool parse_dimacs(char const* file_name, std::ostream& err, sat::solver & solver) {
+    mapped_file f(file_name);
+    if (!f.is_mapped()) {
+        std::ifstream in(file_name);
+        if (in.bad() || in.fail()) {
+            err << "(error \"failed to open file '" << file_name << "'\")" << std::endl;
+            return false;
+        }
+        return parse_dimacs(in, err, solver);
+    }
+    // malformed input is parsed again sequentially to report the location of the error.
+    if (parse_dimacs_parallel(f.begin(), f.end(), solver) == l_true)
+        return true;
+    memory_buffer in(f.begin(), f.end());
+    return parse_dimacs_core(in, err, solver);
+}
+
 
 namespace dimacs {
 
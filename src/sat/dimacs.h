@@ -25,6 +25,12 @@ Revision History:
 
 bool parse_dimacs(std::istream & s, std::ostream& err, sat::solver & solver);
 
+/**
+   \brief parse the DIMACS file file_name. The file is memory mapped where supported,
+   and large files are tokenized in parallel before the clauses are added to the solver.
+*/
+bool parse_dimacs(char const* file_name, std::ostream& err, sat::solver & solver);
+
 namespace dimacs {
     struct lex_error {};
 
@@ -109,8 +109,12 @@ namespace sat {
             return false;
         }
         while (cs.size() >= max_cutset_size(v)) {
-            // never evict the first entry, it is used for the starting point
+            // never evict the first entry, it is used for the starting point.
+            // Otherwise evict a widest cut, starting from a random position to break ties.
             unsigned idx = 1 + (m_rand() % (cs.size() - 1));
+            for (unsigned i = 1; i < cs.size(); ++i) 
+                if (cs[i].size() > cs[idx].size()) 
+                    idx = i;
             evict(cs, idx);
         }
         return true;
@@ -426,18 +430,26 @@ namespace sat {
         if (changed && (n.is_and() || n.is_xor())) {
             std::sort(m_literals.c_ptr() + n.offset(), m_literals.c_ptr() + n.offset() + n.size());
         }
+        // the fanin changed, so the cuts of var are recomputed in this round.
+        if (changed) 
+            touch(var);
         return true;
     }
 
     void aig_cuts::flush_roots(to_root const& to_root, cut_set& cs) {
+        bool evicted = false;
         for (unsigned j = 0; j < cs.size(); ++j) {
             for (unsigned v : cs[j]) {
                 if (to_root[v] != literal(v, false)) {
                     evict(cs, j--);
+                    evicted = true;
                     break;
                 }
             }
         }
+        // cuts were lost, so the fanouts of the node recompute theirs.
+        if (evicted && cs.var() != UINT_MAX) 
+            touch(cs.var());
     }
 
     lbool aig_cuts::get_value(bool_var v) const {
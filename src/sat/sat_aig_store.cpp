@@ -0,0 +1,164 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_aig_store.cpp
+
+Abstract:
+
+    Structurally hashed and-inverter graph with a direct encoding into
+    CNF.
+
+--*/
+#include "sat/sat_aig_store.h"
+#include "sat/sat_solver.h"
+
+namespace sat {
+
+    aig_store::aig_store() {
+        reset();
+    }
+
+    void aig_store::reset() {
+        m_nodes.reset();
+        m_table.reset();
+        m_node2var.reset();
+        m_nodes.push_back({ null_child, null_child });
+        m_node2var.push_back(null_bool_var);
+    }
+
+    aig_store::lit aig_store::mk_input() {
+        unsigned n = m_nodes.size();
+        m_nodes.push_back({ null_child, null_child });
+        m_node2var.push_back(null_bool_var);
+        return 2 * n;
+    }
+
+    aig_store::lit aig_store::mk_and(lit a, lit b) {
+        if (a > b)
+            std::swap(a, b);
+        if (a == false_lit)
+            return false_lit;
+        if (a == true_lit || a == b)
+            return b;
+        if (a == mk_not(b))
+            return false_lit;
+        // a & (a & y) = a & y, ~a & (a & y) = false
+        for (unsigned i = 0; i < 2; ++i) {
+            lit x = i == 0 ? a : b, y = i == 0 ? b : a;
+            if (is_neg(x) || !is_and(x))
+                continue;
+            if (y == left(x) || y == right(x))
+                return x;
+            if (y == mk_not(left(x)) || y == mk_not(right(x)))
+                return false_lit;
+        }
+        // (x & y) & (~x & z) = false
+        if (!is_neg(a) && is_and(a) && !is_neg(b) && is_and(b)) {
+            if (left(a) == mk_not(left(b)) || left(a) == mk_not(right(b)) ||
+                right(a) == mk_not(left(b)) || right(a) == mk_not(right(b)))
+                return false_lit;
+        }
+        unsigned n;
+        if (m_table.find(key(a, b), n))
+            return 2 * n;
+        n = m_nodes.size();
+        m_nodes.push_back({ a, b });
+        m_node2var.push_back(null_bool_var);
+        m_table.insert(key(a, b), n);
+        return 2 * n;
+    }
+
+    aig_store::lit aig_store::mk_xor(lit a, lit b) {
+        if (a > b)
+            std::swap(a, b);
+        if (a == false_lit)
+            return b;
+        if (a == true_lit)
+            return mk_not(b);
+        if (a == b)
+            return false_lit;
+        if (a == mk_not(b))
+            return true_lit;
+        // share the gates of x ^ y between the four sign combinations.
+        bool neg = is_neg(a) != is_neg(b);
+        a &= ~1u;
+        b &= ~1u;
+        lit r = mk_or(mk_and(a, mk_not(b)), mk_and(mk_not(a), b));
+        return neg ? mk_not(r) : r;
+    }
+
+    aig_store::lit aig_store::mk_ite(lit c, lit t, lit e) {
+        if (c == true_lit || t == e)
+            return t;
+        if (c == false_lit)
+            return e;
+        if (t == mk_not(e))
+            return mk_iff(c, t);
+        if (t == true_lit)
+            return mk_or(c, e);
+        if (t == false_lit)
+            return mk_and(mk_not(c), e);
+        if (e == true_lit)
+            return mk_or(mk_not(c), t);
+        if (e == false_lit)
+            return mk_and(c, t);
+        return mk_or(mk_and(c, t), mk_and(mk_not(c), e));
+    }
+
+    aig_store::lit aig_store::mk_maj(lit a, lit b, lit c) {
+        return mk_or(mk_and(a, b), mk_and(c, mk_or(a, b)));
+    }
+
+    literal aig_store::to_sat(lit a, solver_core & s) {
+        unsigned root = get_node(a);
+        if (!is_encoded(root)) {
+            m_todo.push_back(root);
+            while (!m_todo.empty()) {
+                unsigned n = m_todo.back();
+                if (is_encoded(n)) {
+                    m_todo.pop_back();
+                    continue;
+                }
+                node const & nd = m_nodes[n];
+                if (nd.m_left == null_child) {
+                    m_todo.pop_back();
+                    m_node2var[n] = s.add_var(n != 0);
+                    if (n == 0) {
+                        literal f(m_node2var[n], true);
+                        s.add_clause(1, &f, status::asserted());
+                    }
+                    continue;
+                }
+                unsigned l = get_node(nd.m_left), r = get_node(nd.m_right);
+                if (!is_encoded(l) || !is_encoded(r)) {
+                    if (!is_encoded(l))
+                        m_todo.push_back(l);
+                    if (!is_encoded(r))
+                        m_todo.push_back(r);
+                    continue;
+                }
+                m_todo.pop_back();
+                literal v(s.add_var(false), false);
+                literal la(m_node2var[l], is_neg(nd.m_left));
+                literal lb(m_node2var[r], is_neg(nd.m_right));
+                s.add_clause(~v, la, status::asserted());
+                s.add_clause(~v, lb, status::asserted());
+                s.add_clause(v, ~la, ~lb, status::asserted());
+                m_node2var[n] = v.var();
+            }
+        }
+        return literal(m_node2var[root], is_neg(a));
+    }
+
+    bool aig_store::value(lit a, model const & mdl) const {
+        unsigned n = get_node(a);
+        if (n == 0 || !is_encoded(n)) {
+            SASSERT(n == 0 || is_input(a));
+            return is_neg(a);
+        }
+        return (value_at(m_node2var[n], mdl) == l_true) != is_neg(a);
+    }
+
+}
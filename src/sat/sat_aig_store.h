@@ -0,0 +1,99 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_aig_store.h
+
+Abstract:
+
+    Structurally hashed and-inverter graph with a direct encoding into
+    CNF.
+
+    Nodes are identified by their index. A literal is twice the index of
+    its node plus its sign, so a literal and its negation differ in the
+    lowest bit. Node 0 is the constant false, inputs are nodes without
+    children, and every other node is the conjunction of two literals.
+    A node takes two unsigned words, and structural hashing maps each
+    pair of children to the node that conjoins them.
+
+    mk_and normalizes its arguments and applies the one and two level
+    rewrites that do not create nodes: constants, idempotence,
+    contradiction, and absorption or contradiction with the children of
+    an argument that is itself a conjunction.
+
+    to_sat encodes the cone of a literal into a SAT solver. Each and node
+    is encoded once with the three Tseitin clauses of its definition, so
+    literals can be encoded and asserted incrementally.
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include "util/map.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+
+    class solver_core;
+
+    class aig_store {
+    public:
+        typedef unsigned lit;
+        static const lit false_lit = 0;
+        static const lit true_lit  = 1;
+        static const unsigned null_child = UINT_MAX;
+
+    private:
+        struct node {
+            lit m_left;    // null_child for inputs and the constant.
+            lit m_right;
+        };
+        svector<node>      m_nodes;
+        u64_map<unsigned>  m_table;     // (left, right) -> and node
+        svector<bool_var>  m_node2var;  // encoding of nodes into the SAT solver, null_bool_var if not encoded.
+        unsigned_vector    m_todo;
+
+        static uint64_t key(lit a, lit b) { return (static_cast<uint64_t>(a) << 32) | b; }
+
+        bool is_encoded(unsigned n) const { return m_node2var[n] != null_bool_var; }
+
+    public:
+        aig_store();
+
+        static lit mk_not(lit a) { return a ^ 1; }
+        static unsigned get_node(lit a) { return a >> 1; }
+        static bool is_neg(lit a) { return (a & 1) != 0; }
+        static bool is_const(lit a) { return a <= true_lit; }
+
+        unsigned num_nodes() const { return m_nodes.size(); }
+        bool is_input(lit a) const { return get_node(a) != 0 && m_nodes[get_node(a)].m_left == null_child; }
+        bool is_and(lit a) const { return m_nodes[get_node(a)].m_left != null_child; }
+        lit left(lit a) const { SASSERT(is_and(a)); return m_nodes[get_node(a)].m_left; }
+        lit right(lit a) const { SASSERT(is_and(a)); return m_nodes[get_node(a)].m_right; }
+
+        lit mk_input();
+        lit mk_and(lit a, lit b);
+        lit mk_or(lit a, lit b) { return mk_not(mk_and(mk_not(a), mk_not(b))); }
+        lit mk_xor(lit a, lit b);
+        lit mk_iff(lit a, lit b) { return mk_not(mk_xor(a, b)); }
+        lit mk_ite(lit c, lit t, lit e);
+        lit mk_maj(lit a, lit b, lit c);
+
+        /**
+           \brief Return the literal of the SAT solver s that encodes a.
+           The nodes of the cone of a that are not encoded yet are encoded
+           with their defining clauses.
+        */
+        literal to_sat(lit a, solver_core & s);
+
+        /**
+           \brief Value of a constant, an input or an encoded literal in a
+           model of the SAT solver. Inputs that were never encoded are false.
+        */
+        bool value(lit a, model const & mdl) const;
+
+        void reset();
+    };
+
+}
@@ -21,11 +21,21 @@ Revision History:
 #include "util/vector.h"
 #include "util/machine.h"
 
+/**
+   Objects smaller than LARGE_OBJ_SIZE are bump allocated in the chunks and
+   recycled using free lists. Objects smaller than SMALL_OBJ_SIZE have a free
+   list per pointer aligned size, larger ones are rounded up to a multiple of
+   MID_OBJ_ALIGN bytes and have a free list per rounded size.
+   Copying live objects into a fresh allocator produces a contiguous arena.
+*/
 class sat_allocator {
     static const unsigned CHUNK_SIZE     = (1 << 16) - sizeof(char*);
     static const unsigned SMALL_OBJ_SIZE = 512;
+    static const unsigned LARGE_OBJ_SIZE = (CHUNK_SIZE >> 2);
     static const unsigned MASK = ((1 << PTR_ALIGNMENT) - 1);
     static const unsigned NUM_FREE = 1 + (SMALL_OBJ_SIZE >> PTR_ALIGNMENT);
+    static const unsigned MID_OBJ_ALIGN = 6;
+    static const unsigned NUM_MID_FREE = 1 + ((LARGE_OBJ_SIZE + (1 << MID_OBJ_ALIGN) - 1) >> MID_OBJ_ALIGN);
     struct chunk {
         char  * m_curr;
         char    m_data[CHUNK_SIZE];
@@ -33,9 +43,11 @@ class sat_allocator {
     };
     char const *              m_id;
     size_t                    m_alloc_size;
+    size_t                    m_wasted_size; // size of freed objects that are not yet reused.
     ptr_vector<chunk>         m_chunks;
     void *                    m_chunk_ptr;
     ptr_vector<void>          m_free[NUM_FREE];
+    ptr_vector<void>          m_mid_free[NUM_MID_FREE];
 
     unsigned align_size(size_t sz) const {
         return  free_slot_id(sz) << PTR_ALIGNMENT;
@@ -43,25 +55,41 @@ class sat_allocator {
     unsigned free_slot_id(size_t size) const {
         return (static_cast<unsigned>(size >> PTR_ALIGNMENT) + ((0 != (size & MASK)) ? 1u : 0u));
     }
+    unsigned mid_slot_id(size_t size) const {
+        return static_cast<unsigned>((size + (1 << MID_OBJ_ALIGN) - 1) >> MID_OBJ_ALIGN);
+    }
+    unsigned mid_align_size(size_t size) const {
+        return mid_slot_id(size) << MID_OBJ_ALIGN;
+    }
+    ptr_vector<void> & free_list(size_t size) {
+        return size < SMALL_OBJ_SIZE ? m_free[free_slot_id(size)] : m_mid_free[mid_slot_id(size)];
+    }
+    unsigned block_size(size_t size) const {
+        return size < SMALL_OBJ_SIZE ? align_size(size) : mid_align_size(size);
+    }
 public:
-    sat_allocator(char const * id = "unknown"): m_id(id), m_alloc_size(0), m_chunk_ptr(nullptr) {}
+    sat_allocator(char const * id = "unknown"): m_id(id), m_alloc_size(0), m_wasted_size(0), m_chunk_ptr(nullptr) {}
     ~sat_allocator() { reset(); }
     void reset() {
         for (chunk * ch : m_chunks) dealloc(ch);
         m_chunks.reset();
         for (unsigned i = 0; i < NUM_FREE; ++i) m_free[i].reset();
+        for (unsigned i = 0; i < NUM_MID_FREE; ++i) m_mid_free[i].reset();
         m_alloc_size = 0;
+        m_wasted_size = 0;
         m_chunk_ptr = nullptr;
     }
     void * allocate(size_t size) {
         m_alloc_size += size;
-        if (size >= SMALL_OBJ_SIZE) {
+        if (size >= LARGE_OBJ_SIZE) {
             return memory::allocate(size);
         }
-        unsigned slot_id = free_slot_id(size);
-        if (!m_free[slot_id].empty()) {
-            void* result = m_free[slot_id].back();
-            m_free[slot_id].pop_back();
+        unsigned sz = block_size(size);
+        ptr_vector<void> & fl = free_list(size);
+        if (!fl.empty()) {
+            void* result = fl.back();
+            fl.pop_back();
+            m_wasted_size -= sz;
             return result;
         }
         if (m_chunks.empty()) {
@@ -69,7 +97,6 @@ public:
             m_chunk_ptr = m_chunks.back();
         }
         
-        unsigned sz = align_size(size);
         if ((char*)m_chunk_ptr + sz > (char*)m_chunks.back() + CHUNK_SIZE) {
             m_chunks.push_back(alloc(chunk));
             m_chunk_ptr = m_chunks.back();            
@@ -81,14 +108,16 @@ public:
 
     void deallocate(size_t size, void * p) {
         m_alloc_size -= size;
-        if (size >= SMALL_OBJ_SIZE) {
+        if (size >= LARGE_OBJ_SIZE) {
             memory::deallocate(p);
         }
         else {
-            m_free[free_slot_id(size)].push_back(p);
+            free_list(size).push_back(p);
+            m_wasted_size += block_size(size);
         }
     }
     size_t get_allocation_size() const { return m_alloc_size; }
+    size_t get_wasted_size() const { return m_wasted_size; }
 
     char const* id() const { return m_id; }
 };
@@ -32,6 +32,7 @@ namespace sat {
         updt_params(p);
         reset_statistics();
         m_calls = 0;
+        m_restarts = 0;
         m_touch_index = 0;
     }
 
@@ -203,6 +204,105 @@ namespace sat {
 
     }
 
+    struct clause_glue_lt {
+        bool operator()(clause const* c1, clause const* c2) const {
+            if (c1->glue() != c2->glue()) return c1->glue() < c2->glue();
+            return c1->size() < c2->size();
+        }
+    };
+
+    /**
+       \brief vivify learned clauses at base level. It is invoked on restarts
+       and runs every asymm_branch.vivify.restarts restarts.
+       Clauses are processed by increasing (glue, size), so the clauses that 
+       are most likely to be used are vivified first within the budget.
+    */
+    void asymm_branch::vivify_learned() {
+        if (!m_vivify || !s.at_base_lvl() || ++m_restarts < m_vivify_restarts)
+            return;
+        m_restarts = 0;
+        s.propagate(false); 
+        if (s.m_inconsistent)
+            return;
+        unsigned elim0 = m_vivify_literals;
+        int64_t counter0 = m_counter;
+        clause_vector& clauses = s.m_learned;
+        std::stable_sort(clauses.begin(), clauses.end(), clause_glue_lt());
+        clause_vector::iterator it  = clauses.begin();
+        clause_vector::iterator it2 = it;
+        clause_vector::iterator end = clauses.end();
+        try {
+            for (; it != end; ++it) {
+                clause & c = *(*it);
+                if (s.inconsistent() || counter0 - m_counter > m_vivify_limit || c.was_removed() || c.frozen()) {
+                    *it2 = *it;
+                    ++it2;
+                    continue;
+                }
+                s.checkpoint();
+                if (!vivify(c)) 
+                    continue; // clause was removed
+                *it2 = *it;
+                ++it2;
+            }
+            clauses.set_end(it2);
+        }
+        catch (solver_exception & ex) {
+            for (; it != end; ++it, ++it2) {
+                *it2 = *it;
+            }
+            clauses.set_end(it2);
+            m_counter = counter0;
+            throw ex;
+        }
+        m_counter = counter0;
+        IF_VERBOSE(4, if (m_vivify_literals > elim0) 
+                          verbose_stream() << "(sat-vivify :elim " << m_vivify_literals - elim0 << ")\n";);
+    }
+
+    /**
+       \brief assign the negation of the literals of c in order, until a
+       conflict occurs or a literal is implied. Literals implied false are
+       removed, and the literals after the conflict or the implied literal
+       are removed.
+    */
+    bool asymm_branch::vivify(clause& c) {
+        SASSERT(s.scope_lvl() == 0);
+        unsigned sz = c.size();
+        for (literal l : c) {
+            if (s.value(l) == l_true) {
+                s.detach_clause(c);
+                s.del_clause(c);
+                return false;
+            }
+        }
+        m_counter -= sz;
+        scoped_detach scoped_d(s, c);
+        unsigned_vector& keep = m_vivify_keep;
+        keep.reset();
+        s.push();
+        for (unsigned i = 0; i < sz; ++i) {
+            literal l = c[i];
+            lbool val = s.value(l);
+            if (val == l_false)
+                continue;
+            keep.push_back(i);
+            if (val == l_true)
+                break;
+            s.assign_scoped(~l);
+            s.propagate_core(false);
+            if (s.inconsistent())
+                break;
+        }
+        s.pop(1);
+        if (keep.size() == sz)
+            return true;
+        for (unsigned k = 0; k < keep.size(); ++k) 
+            std::swap(c[k], c[keep[k]]);
+        m_vivify_literals += sz - keep.size();
+        return re_attach(scoped_d, c, keep.size());
+    }
+
     /**
        \brief try asymmetric branching on all literals in clause.        
     */
@@ -477,6 +577,9 @@ namespace sat {
         m_asymm_branch_sampled = p.asymm_branch_sampled();
         m_asymm_branch_limit   = p.asymm_branch_limit();
         m_asymm_branch_all     = p.asymm_branch_all();
+        m_vivify               = p.asymm_branch_vivify();
+        m_vivify_restarts      = p.asymm_branch_vivify_restarts();
+        m_vivify_limit         = p.asymm_branch_vivify_limit();
         if (m_asymm_branch_limit > UINT_MAX)
             m_asymm_branch_limit = UINT_MAX;
     }
@@ -488,12 +591,14 @@ namespace sat {
     void asymm_branch::collect_statistics(statistics & st) const {
         st.update("sat elim literals", m_elim_literals);
         st.update("sat tr", m_tr);
+        st.update("sat vivify literals", m_vivify_literals);
     }
 
     void asymm_branch::reset_statistics() {
         m_elim_literals = 0;
         m_elim_learned_literals = 0;
         m_tr = 0;
+        m_vivify_literals = 0;
     }
 
 };
@@ -44,16 +44,22 @@ namespace sat {
         bool       m_asymm_branch_sampled;
         bool       m_asymm_branch_all;
         int64_t    m_asymm_branch_limit;
+        bool       m_vivify;
+        unsigned   m_vivify_restarts;
+        int64_t    m_vivify_limit;
+        unsigned   m_restarts;
 
         // stats
         unsigned   m_elim_literals;
         unsigned   m_elim_learned_literals;
         unsigned   m_tr;
+        unsigned   m_vivify_literals;
 
         literal_vector m_pos, m_neg; // literals (complements of literals) in clauses sorted by discovery time (m_left in BIG).
         svector<std::pair<literal, unsigned>> m_pos1, m_neg1;
         literal_vector m_to_delete;
         literal_vector m_tmp;
+        unsigned_vector m_vivify_keep;
        
         struct compare_left;
 
@@ -90,18 +96,22 @@ namespace sat {
 
         bool propagate_literal(clause const& c, literal l);
 
+        bool vivify(clause& c);
+
     public:
         asymm_branch(solver & s, params_ref const & p);
 
         void operator()(bool force);
 
+        void vivify_learned();
+
         void updt_params(params_ref const & p);
         static void collect_param_descrs(param_descrs & d);
 
         void collect_statistics(statistics & st) const;
         void reset_statistics();
 
-        void init_search() { m_calls = 0; }
+        void init_search() { m_calls = 0; m_restarts = 0; }
 
         inline void dec(unsigned c) { m_counter -= c; }
     };
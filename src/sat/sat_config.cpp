@@ -172,11 +172,14 @@ namespace sat {
             m_gc_strategy = GC_PSM;
         else if (s == symbol("psm_glue"))
             m_gc_strategy = GC_PSM_GLUE;
+        else if (s == symbol("tiered"))
+            m_gc_strategy = GC_TIERED;
         else 
             throw sat_param_exception("invalid gc strategy");
         m_gc_initial      = p.gc_initial();
         m_gc_increment    = p.gc_increment();
         m_gc_small_lbd    = p.gc_small_lbd();
+        m_gc_tier2_lbd    = p.gc_tier2_lbd();
         m_gc_k            = std::min(255u, p.gc_k());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
@@ -185,6 +188,7 @@ namespace sat {
 
         m_backtrack_scopes = p.backtrack_scopes();
         m_backtrack_init_conflicts = p.backtrack_conflicts();
+        m_backtrack_reuse_trail = p.backtrack_reuse_trail();
 
         m_minimize_lemmas = p.minimize_lemmas();
         m_core_minimize   = p.core_minimize();
@@ -194,6 +198,7 @@ namespace sat {
         m_drat_file       = p.drat_file();
         m_drat            = (m_drat_check_unsat || m_drat_file != symbol("") || m_drat_check_sat) && p.threads() == 1;
         m_drat_binary     = p.drat_binary();
+        m_drat_async      = p.drat_async();
         m_drat_activity   = p.drat_activity();
         m_dyn_sub_res     = p.dyn_sub_res();
 
@@ -221,9 +226,10 @@ namespace sat {
             s != symbol("sorting") && 
             s != symbol("totalizer") && 
             s != symbol("solver") &&
+            s != symbol("auto") &&
             s != symbol("segmented") &&
             s != symbol("binary_merge")) {
-            throw sat_param_exception("invalid PB solver: solver, totalizer, circuit, sorting, segmented, binary_merge");
+            throw sat_param_exception("invalid PB solver: solver, auto, totalizer, circuit, sorting, segmented, binary_merge");
         }
 
         s = p.pb_resolve();
@@ -43,7 +43,8 @@ namespace sat {
         GC_PSM,
         GC_GLUE,
         GC_GLUE_PSM,
-        GC_PSM_GLUE
+        GC_PSM_GLUE,
+        GC_TIERED
     };
 
     enum branching_heuristic {
@@ -157,6 +158,7 @@ namespace sat {
         unsigned           m_gc_initial;
         unsigned           m_gc_increment;
         unsigned           m_gc_small_lbd;
+        unsigned           m_gc_tier2_lbd;
         unsigned           m_gc_k;
         bool               m_gc_burst;
         bool               m_gc_defrag;
@@ -166,6 +168,7 @@ namespace sat {
         // backtracking
         unsigned           m_backtrack_scopes;
         unsigned           m_backtrack_init_conflicts;
+        bool               m_backtrack_reuse_trail;
 
         bool               m_minimize_lemmas;
         bool               m_dyn_sub_res;
@@ -175,6 +178,7 @@ namespace sat {
         // drat proofs
         bool               m_drat;
         bool               m_drat_binary;
+        bool               m_drat_async;
         symbol             m_drat_file;
         bool               m_drat_check_unsat;
         bool               m_drat_check_sat;
@@ -398,6 +398,14 @@ namespace sat {
             }
             m_par->to_solver(*this);
         }
+        unsigned num_unsat = m_min_sz;
+        if (m_best_values.size() == num_vars() && m_par->exchange_best(num_unsat, m_best_values)) {
+            // continue from the best assignment found by another thread.
+            for (unsigned v = 0; v < num_vars(); ++v) 
+                value(v) = m_best_values[v];
+            init_clause_data();
+            save_best_values();
+        }
         ++m_parsync_count;
         m_parsync_next *= 3;
         m_parsync_next /= 2;
@@ -410,6 +418,11 @@ namespace sat {
                 m_model[i] = to_lbool(value(i));
             }
         }
+        if (m_unsat.size() < m_min_sz && m_par) {
+            m_best_values.reset();
+            for (unsigned v = 0; v < num_vars(); ++v) 
+                m_best_values.push_back(value(v));
+        }
         if (m_unsat.size() < m_min_sz) {
             m_models.reset();
             // skip saving the first model.
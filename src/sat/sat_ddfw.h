@@ -82,6 +82,7 @@ namespace sat {
         svector<double>      m_probs;       // var -> probability of flipping
         svector<double>      m_scores;      // reward -> score
         model                m_model;       // var -> best assignment
+        bool_vector          m_best_values; // var -> assignment with fewest unsatisfied clauses
         
         vector<unsigned_vector> m_use_list;
         unsigned_vector  m_flat_use_list;
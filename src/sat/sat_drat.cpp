@@ -19,13 +19,102 @@ Author:
 Notes:
 
 --*/
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "sat_solver.h"
 #include "sat_drat.h"
 
 
 namespace sat {
+
+    /**
+       \brief stream buffer that hands full blocks of proof output to a
+       background thread, which writes them to the proof file.
+       The solver only blocks when the writer falls a full block behind.
+    */
+    class drat_writer : public std::streambuf {
+        static const unsigned   block_size = 1 << 20;
+        std::ofstream           m_file;
+        svector<char>           m_buffer, m_pending;
+        bool                    m_has_pending { false };
+        bool                    m_done { false };
+        std::mutex              m_mux;
+        std::condition_variable m_cv;
+        std::thread             m_thread;
+
+        void run() {
+            std::unique_lock<std::mutex> lock(m_mux);
+            while (true) {
+                m_cv.wait(lock, [&]() { return m_has_pending || m_done; });
+                if (m_has_pending) {
+                    lock.unlock();
+                    m_file.write(m_pending.c_ptr(), m_pending.size());
+                    lock.lock();
+                    m_has_pending = false;
+                    m_cv.notify_all();
+                }
+                else {
+                    m_file.flush();
+                    return;
+                }
+            }
+        }
+
+        void hand_off() {
+            m_buffer.shrink(static_cast<unsigned>(pptr() - pbase()));
+            {
+                std::unique_lock<std::mutex> lock(m_mux);
+                m_cv.wait(lock, [&]() { return !m_has_pending; });
+                m_pending.swap(m_buffer);
+                m_has_pending = true;
+            }
+            m_cv.notify_all();
+            m_buffer.resize(block_size);
+            setp(m_buffer.begin(), m_buffer.end());
+        }
+
+    protected:
+        int_type overflow(int_type ch) override {
+            hand_off();
+            if (ch != traits_type::eof()) {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override {
+            hand_off();
+            std::unique_lock<std::mutex> lock(m_mux);
+            m_cv.wait(lock, [&]() { return !m_has_pending; });
+            m_file.flush();
+            return m_file ? 0 : -1;
+        }
+
+    public:
+        drat_writer(char const* file, std::ios_base::openmode mode):
+            m_file(file, mode) {
+            m_buffer.resize(block_size);
+            setp(m_buffer.begin(), m_buffer.end());
+            m_thread = std::thread([&]() { run(); });
+        }
+
+        ~drat_writer() override {
+            hand_off();
+            {
+                std::unique_lock<std::mutex> lock(m_mux);
+                m_cv.wait(lock, [&]() { return !m_has_pending; });
+                m_done = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+        }
+    };
+
     drat::drat(solver& s) :
         s(s),
+        m_writer(nullptr),
         m_out(nullptr),
         m_bout(nullptr),
         m_inconsistent(false),
@@ -36,7 +125,12 @@ namespace sat {
     {
         if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
-            m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
+            if (s.get_config().m_drat_async) {
+                m_writer = alloc(drat_writer, s.get_config().m_drat_file.bare_str(), mode);
+                m_out = alloc(std::ostream, m_writer);
+            }
+            else 
+                m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
             if (s.get_config().m_drat_binary) {
                 std::swap(m_out, m_bout);
             }
@@ -48,6 +142,7 @@ namespace sat {
         if (m_bout) m_bout->flush();
         dealloc(m_out);
         dealloc(m_bout);
+        dealloc(m_writer);
         for (unsigned i = 0; i < m_proof.size(); ++i) {
             clause* c = m_proof[i];
             if (c) {
@@ -59,6 +59,7 @@ Notes:
 namespace sat {
     class justification;
     class clause;
+    class drat_writer;
 
     class drat {
         struct stats {
@@ -77,6 +78,7 @@ namespace sat {
         typedef svector<unsigned> watch;
         solver& s;
         clause_allocator        m_alloc;
+        drat_writer*            m_writer;
         std::ostream*           m_out;
         std::ostream*           m_bout;
         ptr_vector<clause>      m_proof;
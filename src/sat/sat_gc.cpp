@@ -57,6 +57,9 @@ namespace sat {
         case GC_PSM_GLUE:
             gc_psm_glue();
             break;
+        case GC_TIERED:
+            gc_tiered();
+            break;
         case GC_DYN_PSM:
             if (!m_assumptions.empty()) {
                 gc_glue_psm();
@@ -146,6 +149,50 @@ namespace sat {
         gc_half("psm-glue");
     }
 
+    /**
+       \brief GC with three tiers of learned clauses.
+       Core clauses, with glue at most gc.small_lbd, are kept.
+       Tier2 clauses, with glue at most gc.tier2_lbd, are kept until they have
+       not been used for gc.k rounds, after which they are treated as local.
+       Local clauses used since the last round survive it; among the other
+       local clauses the half with the largest (glue, size) is deleted.
+       Glue is lowered when clauses propagate, which promotes them.
+    */
+    void solver::gc_tiered() {
+        unsigned sz = m_learned.size();
+        unsigned j = 0;
+        clause_vector local;
+        for (clause* cp : m_learned) {
+            clause& c = *cp;
+            bool used = c.was_used();
+            c.unmark_used();
+            if (used)
+                c.reset_inact_rounds();
+            else if (c.inact_rounds() < 255)
+                c.inc_inact_rounds();
+            if (used || 
+                c.glue() <= m_config.m_gc_small_lbd ||
+                (c.glue() <= m_config.m_gc_tier2_lbd && c.inact_rounds() <= m_config.m_gc_k))
+                m_learned[j++] = cp;
+            else
+                local.push_back(cp);
+        }
+        m_learned.shrink(j);
+        std::stable_sort(local.begin(), local.end(), glue_lt());
+        unsigned keep = local.size() / 2;
+        for (unsigned i = 0; i < local.size(); ++i) {
+            clause& c = *local[i];
+            if (i < keep || !can_delete(c))
+                m_learned.push_back(&c);
+            else {
+                detach_clause(c);
+                del_clause(c);
+            }
+        }
+        m_stats.m_gc_clause += sz - m_learned.size();
+        IF_VERBOSE(SAT_VB_LVL, verbose_stream() << "(sat-gc :strategy tiered :local " << local.size() << " :deleted " << (sz - m_learned.size()) << ")\n";);
+    }
+
     /**
        \brief Compute the psm of all learned clauses.
     */
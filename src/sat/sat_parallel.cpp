@@ -90,7 +90,7 @@ namespace sat {
         return false;
     }
 
-    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
+    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_best_unsat(UINT_MAX), m_scoped_rlimit(s.rlimit()) {}
 
     parallel::~parallel() {
         for (unsigned i = 0; i < m_solvers.size(); ++i) {            
@@ -145,37 +145,53 @@ namespace sat {
         }
     }
 
+    // number of buffered literals that triggers publishing exported clauses.
+    static const unsigned EXPORT_BATCH_SIZE = 1024;
+
+    void parallel::export_vector(unsigned owner, unsigned n, literal const* lits) {
+        // the export buffer is only accessed by the owner thread.
+        unsigned_vector& buffer = m_exports[owner];
+        buffer.push_back(n);
+        for (unsigned i = 0; i < n; ++i) 
+            buffer.push_back(lits[i].index());
+        if (buffer.size() >= EXPORT_BATCH_SIZE) {
+            lock_guard lock(m_pool_mux);
+            publish_exports(owner);
+        }
+    }
+
+    void parallel::publish_exports(unsigned owner) {
+        unsigned_vector& buffer = m_exports[owner];
+        for (unsigned i = 0; i < buffer.size(); i += buffer[i] + 1) {
+            unsigned n = buffer[i];
+            m_pool.begin_add_vector(owner, n);
+            for (unsigned j = 1; j <= n; ++j) 
+                m_pool.add_vector_elem(buffer[i + j]);
+            m_pool.end_add_vector();
+        }
+        buffer.reset();
+    }
+
     void parallel::share_clause(solver& s, literal l1, literal l2) {        
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
-        {
-            lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
-            m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
-            m_pool.end_add_vector();
-        }        
+        literal lits[2] = { l1, l2 };
+        export_vector(s.m_par_id, 2, lits);
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
         if (s.get_config().m_num_threads == 1 || !enable_add(c) || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        unsigned n = c.size();
-        unsigned owner = s.m_par_id;
-        IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
-        lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
-        for (unsigned i = 0; i < n; ++i) {
-            m_pool.add_vector_elem(c[i].index());
-        }
-        m_pool.end_add_vector();        
+        IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  c << "\n";);
+        export_vector(s.m_par_id, c.size(), c.begin());
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
-        lock_guard lock(m_mux);
+        lock_guard lock(m_pool_mux);
+        publish_exports(s.m_par_id);
         _get_clauses(s);        
     }
 
@@ -263,6 +279,28 @@ namespace sat {
         _to_solver(s);               
     }
 
+    /**
+       \brief publish values if they falsify fewer clauses than the shared best 
+       assignment. Otherwise, if the shared assignment is strictly better, 
+       copy it into values and num_unsat and return true.
+    */
+    bool parallel::exchange_best(unsigned& num_unsat, bool_vector& values) {
+        lock_guard lock(m_mux);
+        if (num_unsat < m_best_unsat) {
+            m_best_unsat = num_unsat;
+            m_best_values.reset();
+            m_best_values.append(values);
+            return false;
+        }
+        if (m_best_unsat < num_unsat && m_best_values.size() == values.size()) {
+            num_unsat = m_best_unsat;
+            values.reset();
+            values.append(m_best_values);
+            return true;
+        }
+        return false;
+    }
+
     bool parallel::copy_solver(solver& s) {
         bool copied = false;
         {
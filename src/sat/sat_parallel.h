@@ -50,6 +50,8 @@ namespace sat {
         };
 
         bool enable_add(clause const& c) const;
+        void export_vector(unsigned owner, unsigned n, literal const* lits);
+        void publish_exports(unsigned owner);
         void _get_clauses(solver& s);
         void _from_solver(solver& s);
         bool _to_solver(solver& s);
@@ -61,13 +63,19 @@ namespace sat {
         index_set      m_unit_set;
         literal_vector m_lits;
         vector_pool    m_pool;
-        mutex          m_mux;
+        mutex          m_pool_mux;  // protects m_pool and m_lits
+        mutex          m_mux;       // protects units and the exchange with local search
+        // clauses exported by each owner that are not yet published in m_pool.
+        // Each clause is stored as its size followed by its literals.
+        vector<unsigned_vector> m_exports;
 
         // for exchange with local search:
         unsigned           m_num_clauses;
         scoped_ptr<solver> m_solver_copy;
         bool               m_consumer_ready;
         svector<double>    m_priorities;
+        unsigned           m_best_unsat;
+        bool_vector        m_best_values;
 
         scoped_limits      m_scoped_rlimit;
         vector<reslimit>   m_limits;
@@ -84,7 +92,7 @@ namespace sat {
         void push_child(reslimit& rl);
 
         // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); m_exports.reset(); m_exports.resize(num_owners); }
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
@@ -107,6 +115,9 @@ namespace sat {
         
         bool from_solver(i_local_search& s);
         void to_solver(i_local_search& s);
+
+        // exchange the best assignment between local search threads.
+        bool exchange_best(unsigned& num_unsat, bool_vector& values);
         
         bool copy_solver(solver& s);
     };
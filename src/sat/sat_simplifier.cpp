@@ -1948,16 +1948,20 @@ namespace sat {
         TRACE("sat_simplifier", tout << "collecting number of after_clauses\n";);
         unsigned before_clauses = num_pos + num_neg;
         unsigned after_clauses  = 0;
-        for (clause_wrapper& c1 : m_pos_cls) {
-            for (clause_wrapper& c2 : m_neg_cls) {
-                m_new_cls.reset();
-                if (resolve(c1, c2, pos_l, m_new_cls)) {
-                    TRACE("sat_simplifier", tout << c1 << "\n" << c2 << "\n-->\n";
-                          for (literal l : m_new_cls) tout << l << " "; tout << "\n";);
-                    after_clauses++;
-                    if (after_clauses > before_clauses) {
-                        TRACE("sat_simplifier", tout << "too many after clauses: " << after_clauses << "\n";);
-                        return false;
+        // there are at most |pos| * |neg| resolvents. When that does not exceed the 
+        // number of clauses, the elimination is within bounds and counting is skipped.
+        if (m_pos_cls.size() * m_neg_cls.size() > before_clauses) {
+            for (clause_wrapper& c1 : m_pos_cls) {
+                for (clause_wrapper& c2 : m_neg_cls) {
+                    m_new_cls.reset();
+                    if (resolve(c1, c2, pos_l, m_new_cls)) {
+                        TRACE("sat_simplifier", tout << c1 << "\n" << c2 << "\n-->\n";
+                              for (literal l : m_new_cls) tout << l << " "; tout << "\n";);
+                        after_clauses++;
+                        if (after_clauses > before_clauses) {
+                            TRACE("sat_simplifier", tout << "too many after clauses: " << after_clauses << "\n";);
+                            return false;
+                        }
                     }
                 }
             }
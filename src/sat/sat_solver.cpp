@@ -491,8 +491,8 @@ namespace sat {
         else if (has_variables_to_reinit(l1, l2))
             push_reinit_stack(l1, l2);
         m_stats.m_mk_bin_clause++;
-        get_wlist(~l1).push_back(watched(l2, redundant));
-        get_wlist(~l2).push_back(watched(l1, redundant));
+        push_binary_watch(get_wlist(~l1), watched(l2, redundant));
+        push_binary_watch(get_wlist(~l2), watched(l1, redundant));
     }
 
     bool solver::has_variables_to_reinit(clause const& c) const {
@@ -703,7 +703,11 @@ namespace sat {
 
     bool solver::should_defrag() {
         if (m_defrag_threshold > 0) --m_defrag_threshold;
-        return m_defrag_threshold == 0 && m_config.m_gc_defrag;
+        if (!m_config.m_gc_defrag)
+            return false;
+        // compact as soon as the holes in the clause arena outweigh the live clauses.
+        clause_allocator const& a = cls_allocator();
+        return m_defrag_threshold == 0 || a.get_wasted_size() > a.get_allocation_size();
     }
 
     void solver::defrag_clauses() {
@@ -1070,6 +1074,23 @@ namespace sat {
                     *it2 = *it;                 \
                 wlist.set_end(it2);             \
             }
+        // binary clauses are usually at the front of the watch list.
+        // They are never removed from the watch list, so it2 does not move.
+        for (; it != end && it->is_binary_clause(); ++it) {
+            l1 = it->get_literal();
+            switch (value(l1)) {
+            case l_false:
+                set_conflict(justification(curr_level, not_l), ~l1);
+                return false;
+            case l_undef:
+                m_stats.m_bin_propagate++;
+                assign_core(l1, justification(curr_level, not_l));
+                break;
+            case l_true:
+                break; // skip
+            }
+        }
+        it2 = it;
         for (; it != end; ++it) {
             switch (it->get_kind()) {
             case watched::BINARY:
@@ -1272,6 +1293,7 @@ namespace sat {
     //
     // -----------------------
     lbool solver::check(unsigned num_lits, literal const* lits) {
+        memory::scoped_tag _tag(memory::TAG_SAT);
         init_reason_unknown();
         pop_to_base_level();
         m_stats.m_units = init_trail_size();
@@ -1471,7 +1493,7 @@ namespace sat {
 #define IS_MAIN_SOLVER(i)  (i == main_solver_offset)
 
         sat::parallel par(*this);
-        par.reserve(num_threads, 1 << 12);
+        par.reserve(num_threads, num_threads << 12);
         par.init_solvers(*this, num_extra_solvers);
         for (unsigned i = 0; i < ls.size(); ++i) {
             par.push_child(ls[i]->rlimit());
@@ -2269,6 +2291,7 @@ namespace sat {
         IF_VERBOSE(30, display_status(verbose_stream()););
         TRACE("sat", tout << "restart " << restart_level(to_base) << "\n";);
         pop_reinit(restart_level(to_base));
+        m_asymm_branch.vivify_learned();
         set_next_restart();
     }
 
@@ -2441,6 +2464,7 @@ namespace sat {
                 break;
             case justification::CLAUSE: {
                 clause & c = get_clause(js);
+                c.mark_used();
                 unsigned i = 0;
                 if (consequent != null_literal) {
                     SASSERT(c[0] == consequent || c[1] == consequent);
@@ -2557,6 +2581,12 @@ namespace sat {
         
         if (use_backjumping(num_scopes)) {
             ++m_stats.m_backjumps;
+            if (m_config.m_backtrack_reuse_trail) {
+                unsigned reuse_lvl = reuse_trail_level(backjump_lvl, backtrack_lvl);
+                if (reuse_lvl > backjump_lvl)
+                    ++m_stats.m_trail_reuse;
+                num_scopes = m_scope_lvl - reuse_lvl;
+            }
             pop_reinit(num_scopes);
         }
         else {
@@ -2583,6 +2613,26 @@ namespace sat {
             (num_scopes <= m_config.m_backtrack_scopes || !allow_backtracking());
     }
 
+    /**
+       \brief trail reuse: keep the decision levels above the backjump level
+       whose decision variables are more active than the next decision variable.
+       They would most likely be re-decided in the same order after backjumping.
+       The lemma asserts its first literal out of order at the backjump level,
+       as with chronological backtracking.
+    */
+    unsigned solver::reuse_trail_level(unsigned backjump_lvl, unsigned backtrack_lvl) {
+        // assigned variables are re-inserted into the queue when they are unassigned.
+        while (!m_case_split_queue.empty() && value(m_case_split_queue.min_var()) != l_undef)
+            m_case_split_queue.next_var();
+        if (m_case_split_queue.empty())
+            return backjump_lvl;
+        bool_var next = m_case_split_queue.min_var();
+        unsigned lvl = backjump_lvl;
+        while (lvl + 1 < backtrack_lvl && m_case_split_queue.more_active(scope_literal(lvl).var(), next))
+            ++lvl;
+        return lvl;
+    }
+
     bool solver::allow_backtracking() const {
         return m_conflicts_since_init > m_config.m_backtrack_init_conflicts;
     }
@@ -4771,6 +4821,7 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat trail reuse", m_trail_reuse);
     }
 
     void stats::reset() {
@@ -74,6 +74,7 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_trail_reuse;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -546,6 +547,7 @@ namespace sat {
         void save_psm();
         void gc_half(char const * st_name);
         void gc_dyn_psm();
+        void gc_tiered();
         bool activate_frozen_clause(clause & c);
         unsigned psm(clause const & c) const;
         bool can_delete(clause const & c) const;
@@ -584,6 +586,7 @@ namespace sat {
         literal_vector m_lemma;
         literal_vector m_ext_antecedents;
         bool use_backjumping(unsigned num_scopes) const;
+        unsigned reuse_trail_level(unsigned backjump_lvl, unsigned backtrack_lvl);
         bool allow_backtracking() const;
         bool resolve_conflict();
         lbool resolve_conflict_core();
@@ -370,6 +370,33 @@ public:
         return result;
     }
 
+    expr_ref_vector get_lemmas() override {
+        expr_ref_vector result = solver::get_lemmas();
+        expr_ref_vector lit2expr(m);
+        lit2expr.resize(m_solver.num_vars() * 2);
+        m_map.mk_inv(lit2expr);
+        expr_ref_vector lits(m);
+        auto add_clause = [&](unsigned n, sat::literal const* ls) {
+            lits.reset();
+            for (unsigned i = 0; i < n; ++i) {
+                expr* e = lit2expr.get(ls[i].index());
+                if (!e) return;
+                lits.push_back(e);
+            }
+            result.push_back(::mk_or(lits));
+        };
+        svector<sat::solver::bin_clause> bins;
+        m_solver.collect_bin_clauses(bins, true, true);
+        for (auto const& b : bins) {
+            sat::literal ls[2] = { b.first, b.second };
+            add_clause(2, ls);
+        }
+        for (sat::clause* c : m_solver.learned()) 
+            if (!c->was_removed()) 
+                add_clause(c->size(), c->begin());
+        return result;
+    }
+
     proof * get_proof() override {
         return nullptr;
     }
@@ -394,6 +421,35 @@ public:
     }
 
     expr_ref_vector cube(expr_ref_vector& vs, unsigned backtrack_level) override {
+        expr_ref_vector lit2expr(m);
+        return cube_core(vs, backtrack_level, true, lit2expr);
+    }
+
+    expr_ref_vector cubes(expr_ref_vector& vs, unsigned backtrack_level, unsigned max_cubes) override {
+        expr_ref_vector result(m), lit2expr(m);
+        bool first = true;
+        while (result.size() < max_cubes) {
+            expr_ref_vector c = cube_core(vs, backtrack_level, first, lit2expr);
+            first = false;
+            backtrack_level = UINT_MAX;
+            if (c.empty())
+                break;
+            if (c.size() == 1 && (m.is_true(c.get(0)) || m.is_false(c.get(0)))) {
+                result.push_back(c.get(0));
+                break;
+            }
+            result.push_back(mk_and(c));
+        }
+        return result;
+    }
+
+    /**
+       \brief produce the next cube. The variable filter is only used when
+       \c restrict_vars is set, the cuber ignores it after its first call.
+       \c lit2expr is filled on demand and reused across calls that produce
+       cubes of the same batch.
+    */
+    expr_ref_vector cube_core(expr_ref_vector& vs, unsigned backtrack_level, bool restrict_vars, expr_ref_vector& lit2expr) {
         if (!is_internalized()) {
             lbool r = internalize_formulas();
             if (r != l_true) {
@@ -404,19 +460,23 @@ public:
         convert_internalized();
         if (m_solver.inconsistent())
             return last_cube(false);
-        obj_hashtable<expr> _vs;
-        for (expr* v : vs) _vs.insert(v);
         sat::bool_var_vector vars;
-        for (auto& kv : m_map) {
-            if (_vs.empty() || _vs.contains(kv.m_key))
-                vars.push_back(kv.m_value);
+        if (restrict_vars) {
+            obj_hashtable<expr> _vs;
+            for (expr* v : vs) _vs.insert(v);
+            for (auto& kv : m_map) {
+                if (_vs.empty() || _vs.contains(kv.m_key))
+                    vars.push_back(kv.m_value);
+            }
         }
         sat::literal_vector lits;
         lbool result = m_solver.cube(vars, lits, backtrack_level);
         expr_ref_vector fmls(m);
-        expr_ref_vector lit2expr(m);
-        lit2expr.resize(m_solver.num_vars() * 2);
-        m_map.mk_inv(lit2expr);
+        if (lit2expr.size() != m_solver.num_vars() * 2) {
+            lit2expr.reset();
+            lit2expr.resize(m_solver.num_vars() * 2);
+            m_map.mk_inv(lit2expr);
+        }
         for (sat::literal l : lits) {
             expr* e = lit2expr.get(l.index());
             SASSERT(e);
@@ -694,6 +754,10 @@ private:
             m_asms.shrink(0);
             return l_true;
         }
+        if (internalize_known_assumptions(sz, asms)) {
+            extract_assumptions(sz, asms);
+            return l_true;
+        }
         goal_ref g = alloc(goal, m, true, true); // models and cores are enabled.
         for (unsigned i = 0; i < sz; ++i) {
             g->assert_expr(asms[i], m.mk_leaf(asms[i]));
@@ -708,6 +772,43 @@ private:
         return res;
     }
 
+    /**
+       \brief map assumptions that are literals over atoms already known to the
+       sat solver directly to sat literals. It bypasses the pre-processor and 
+       goal2sat, which would produce the same literals, on repeated calls with 
+       changing assumptions.
+    */
+    bool internalize_known_assumptions(unsigned sz, expr* const* asms) {
+        sat::literal lit;
+        for (unsigned i = 0; i < sz; ++i) 
+            if (!is_known_assumption(asms[i], lit))
+                return false;
+        for (unsigned i = 0; i < get_num_assumptions(); ++i) 
+            if (!is_known_assumption(get_assumption(i), lit))
+                return false;
+        for (unsigned i = 0; i < sz; ++i) {
+            VERIFY(is_known_assumption(asms[i], lit));
+            m_dep2asm.insert(asms[i], lit);
+        }
+        for (unsigned i = 0; i < get_num_assumptions(); ++i) {
+            VERIFY(is_known_assumption(get_assumption(i), lit));
+            m_dep2asm.insert(get_assumption(i), lit);
+        }
+        return true;
+    }
+
+    bool is_known_assumption(expr* a, sat::literal& lit) {
+        expr* atom = a;
+        bool sign = m.is_not(a, atom);
+        if (!is_uninterp_const(atom))
+            return false;
+        sat::bool_var v = m_map.to_bool_var(atom);
+        if (v == sat::null_bool_var || m_solver.was_eliminated(v))
+            return false;
+        lit = sat::literal(v, sign);
+        return true;
+    }
+
     lbool internalize_vars(expr_ref_vector const& vars, sat::bool_var_vector& bvars) {
         for (expr* v : vars) {
             internalize_var(v, bvars);
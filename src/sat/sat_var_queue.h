@@ -29,7 +29,7 @@ namespace sat {
             lt(svector<unsigned> & act):m_activity(act) {}
             bool operator()(bool_var v1, bool_var v2) const { return m_activity[v1] > m_activity[v2]; }
         };
-        heap<lt>  m_queue;
+        heap<lt, 4> m_queue; // activities are bumped far more often than variables are picked.
     public:
         var_queue(svector<unsigned> & act):m_queue(128, lt(act)) {}
         
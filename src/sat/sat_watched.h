@@ -133,6 +133,23 @@ namespace sat {
 
     typedef vector<watched> watch_list;
 
+    /**
+       \brief Add a binary clause watch while preserving that binary clauses
+       are at the beginning of the watch list. 
+       The solver propagates this section of watch lists in a dedicated loop.
+    */
+    inline void push_binary_watch(watch_list & wlist, watched const& w) {
+        SASSERT(w.is_binary_clause());
+        wlist.push_back(w);
+        unsigned sz = wlist.size();
+        if (sz > 1 && !wlist[sz - 2].is_binary_clause()) {
+            unsigned i = 0;
+            while (wlist[i].is_binary_clause()) 
+                ++i;
+            std::swap(wlist[i], wlist[sz - 1]);
+        }
+    }
+
     watched* find_binary_watch(watch_list & wlist, literal l);
     watched const* find_binary_watch(watch_list const & wlist, literal l);
     bool erase_clause_watch(watch_list & wlist, clause_offset c);
@@ -452,6 +452,49 @@ namespace array {
         return unit_propagate();
     }
 
+    bool solver::is_lazy_select_store(axiom_record const& r) const {
+        return get_config().m_array_lazy_select &&
+            r.m_kind == axiom_record::kind_t::is_select &&
+            a.is_store(r.n->get_expr());
+    }
+
+    /**
+     * The axiom for select(b, j), b ~ store(a, i, v) holds in the current
+     * candidate model if i = j, or if select(a, j) is in the class of select(b, j).
+     */
+    bool solver::is_satisfied_select_store(axiom_record const& r) {
+        app* select = r.select->get_app();
+        app* store = to_app(r.n->get_expr());
+        unsigned num_args = select->get_num_args();
+        bool same_index = true;
+        for (unsigned i = 1; same_index && i < num_args; i++)
+            same_index = expr2enode(store->get_arg(i))->get_root() == r.select->get_arg(i)->get_root();
+        if (same_index)
+            return true;
+        ptr_buffer<expr> sel_args;
+        sel_args.push_back(store->get_arg(0));
+        for (unsigned i = 1; i < num_args; i++)
+            sel_args.push_back(select->get_arg(i));
+        expr_ref sel(a.mk_select(sel_args), m);
+        euf::enode* n = expr2enode(sel);
+        return n && n->get_root() == r.select->get_root();
+    }
+
+    /**
+     * Assert the delayed select over store axioms that the candidate model violates.
+     */
+    bool solver::add_violated_axioms() {
+        bool prop = false;
+        for (unsigned i = 0; i < m_delayed_axioms.size() && !s().inconsistent(); ++i) {
+            unsigned idx = m_delayed_axioms[i];
+            if (m_axioms.contains(idx) || is_satisfied_select_store(m_axiom_trail[idx]))
+                continue;
+            if (assert_axiom(idx))
+                prop = true;
+        }
+        return prop;
+    }
+
     bool solver::add_interface_equalities() {
         sbuffer<theory_var> roots;
         collect_shared_vars(roots);
@@ -94,6 +94,8 @@ namespace array {
             else if (!turn[idx] && add_interface_equalities())
                 return sat::check_result::CR_CONTINUE;
         }
+        if (add_violated_axioms())
+            return sat::check_result::CR_CONTINUE;
         return sat::check_result::CR_DONE;
     }
 
@@ -164,9 +166,15 @@ namespace array {
         force_push();
         bool prop = false;
         ctx.push(value_trail<euf::solver, unsigned>(m_qhead));
-        for (; m_qhead < m_axiom_trail.size() && !s().inconsistent(); ++m_qhead)
-            if (assert_axiom(m_qhead))
+        for (; m_qhead < m_axiom_trail.size() && !s().inconsistent(); ++m_qhead) {
+            if (is_lazy_select_store(m_axiom_trail[m_qhead])) {
+                ++m_stats.m_num_select_store_axiom_delayed;
+                m_delayed_axioms.push_back(m_qhead);
+                ctx.push(push_back_vector<euf::solver, unsigned_vector>(m_delayed_axioms));
+            }
+            else if (assert_axiom(m_qhead))
                 prop = true;
+        }
         return prop;
     }
 
@@ -121,8 +121,12 @@ namespace array {
         axiom_table_t         m_axioms;
         svector<axiom_record> m_axiom_trail;
         unsigned              m_qhead { 0 };
+        unsigned_vector       m_delayed_axioms;   // select over store axioms checked against the model in final check
         void push_axiom(axiom_record const& r);
         bool assert_axiom(unsigned idx);
+        bool is_lazy_select_store(axiom_record const& r) const;
+        bool is_satisfied_select_store(axiom_record const& r);
+        bool add_violated_axioms();
 
         axiom_record select_axiom(euf::enode* s, euf::enode* n) { return axiom_record(axiom_record::kind_t::is_select, n, s); }
         axiom_record default_axiom(euf::enode* n) { return axiom_record(axiom_record::kind_t::is_default, n); }
@@ -41,21 +41,26 @@ namespace ba {
         pb_base(tag_t::pb_t, id, lit, wlits.size(), get_obj_size(wlits.size()), k),
         m_slack(0),
         m_num_watch(0),
-        m_max_sum(0) {
+        m_max_sum(0),
+        m_max_coeff(0) {
         for (unsigned i = 0; i < size(); ++i) {
             m_wlits[i] = wlits[i];
         }
+        // literals with larger coefficients are watched first.
+        std::stable_sort(m_wlits, m_wlits + size(), [](wliteral const& a, wliteral const& b) { return a.first > b.first; });
         update_max_sum();
     }
 
     void pb::update_max_sum() {
         m_max_sum = 0;
+        m_max_coeff = 0;
         for (unsigned i = 0; i < size(); ++i) {
             m_wlits[i].first = std::min(k(), m_wlits[i].first);
             if (m_max_sum + m_wlits[i].first < m_max_sum) {
                 throw default_exception("addition of pb coefficients overflows");
             }
             m_max_sum += m_wlits[i].first;
+            m_max_coeff = std::max(m_max_coeff, m_wlits[i].first);
         }
     }
 
@@ -119,7 +124,9 @@ namespace ba {
     }
 
 
-    // watch a prefix of literals, such that the slack of these is >= k
+    // watch a prefix of literals, such that the slack of these is >= k.
+    // The non-false literals keep their order, so the literals with the
+    // largest coefficients are watched.
     bool pb::init_watch(solver_interface& s) {
         auto& p = *this;
         clear_watch(s);
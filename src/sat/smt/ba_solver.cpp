@@ -291,15 +291,24 @@ namespace sat {
         SASSERT(num_watch <= sz);
         SASSERT(num_watch > 0);
         unsigned index = 0;
+        while (index < num_watch && p[index].second != alit) 
+            ++index;
+
+        // the slack stays above the bound plus the largest coefficient: 
+        // nothing propagates and no literal has to be watched instead.
+        if (index < num_watch && slack >= bound + p.max_coeff() + p[index].first) {
+            --num_watch;
+            p.set_slack(slack - p[index].first);
+            p.set_num_watch(num_watch);
+            p.swap(num_watch, index);
+            SASSERT(validate_watch(p, alit));
+            return l_undef;
+        }
+
         m_a_max = 0;
         m_pb_undef.reset();
-        for (; index < num_watch; ++index) {
-            literal lit = p[index].second;
-            if (lit == alit) {
-                break;
-            }
-            add_index(p, index, lit);
-        }
+        for (unsigned i = 0; i < index; ++i) 
+            add_index(p, i, p[i].second);
         if (index == num_watch || num_watch == 0) {
             _bad_id = p.id();
             BADLOG(
@@ -2054,6 +2063,7 @@ namespace sat {
             unit_strengthen();
             extract_xor();
             merge_xor();
+            gaussian_xor();
             cleanup_clauses();
             cleanup_constraints();
             update_pure();
@@ -3285,6 +3295,7 @@ namespace sat {
         st.update("ba overflow", m_stats.m_num_overflow);
         st.update("ba big strengthenings", m_stats.m_num_big_strengthenings);
         st.update("ba lemmas", m_stats.m_num_lemmas);
+        st.update("ba gauss", m_stats.m_num_gauss);
         st.update("ba subsumes", m_stats.m_num_bin_subsumes + m_stats.m_num_clause_subsumes + m_stats.m_num_pb_subsumes);
     }
 
@@ -62,6 +62,7 @@ namespace sat {
             unsigned m_num_gc;
             unsigned m_num_overflow;
             unsigned m_num_lemmas;
+            unsigned m_num_gauss;
             stats() { reset(); }
             void reset() { memset(this, 0, sizeof(*this)); }
         };
@@ -245,6 +246,7 @@ namespace sat {
         void simplify(xr& x);
         void extract_xor();
         void merge_xor();
+        void gaussian_xor();
         bool clausify(xr& x);
         void flush_roots(xr& x);
         lbool eval(xr const& x) const;
@@ -124,6 +124,11 @@ namespace bv {
         theory_var v = mk_var(n);
         SASSERT(n->is_attached_to(get_id()));
 
+        if (should_delay(a)) {
+            internalize_delayed(a);
+            return true;
+        }
+
         std::function<void(unsigned sz, expr* const* xs, expr* const* ys, expr_ref_vector& bits)> bin;
         std::function<void(unsigned sz, expr* const* xs, expr* const* ys, expr_ref& bit)> ebin;
         std::function<void(unsigned sz, expr* const* xs, expr_ref_vector& bits)> un;
@@ -413,6 +418,105 @@ namespace bv {
         add_def(def, expr2literal(n));
     }
 
+    /**
+       \brief With bv.delay, multiplication, unsigned division and unsigned
+       remainder over two non-constant arguments are not bit-blasted when they
+       are internalized. They get fresh bits, and check_delayed() only adds
+       the circuit when a final check finds the assignment violates the
+       operator.
+    */
+    bool solver::should_delay(app* n) const {
+        if (!get_config().m_bv_delay || n->get_num_args() != 2)
+            return false;
+        if (!bv.is_bv_mul(n) && !bv.is_bv_udivi(n) && !bv.is_bv_uremi(n))
+            return false;
+        return !bv.is_numeral(n->get_arg(0)) && !bv.is_numeral(n->get_arg(1));
+    }
+
+    void solver::internalize_delayed(app* n) {
+        euf::enode* e = expr2enode(n);
+        get_arg_var(e, 0);
+        get_arg_var(e, 1);
+        mk_bits(e->get_th_var(get_id()));
+        ctx.push(push_back_trail<euf::solver, app*, false>(m_delayed));
+        m_delayed.push_back(n);
+        ++m_stats.m_num_delayed;
+    }
+
+    bool solver::get_value(theory_var v, numeral& r) const {
+        r.reset();
+        unsigned i = 0;
+        for (literal l : m_bits[v]) {
+            lbool b = s().value(l);
+            if (b == l_undef)
+                return false;
+            if (b == l_true)
+                r += power2(i);
+            ++i;
+        }
+        return true;
+    }
+
+    /**
+       \brief check that the assignment to the bits of a delayed term agrees
+       with the operator applied to the assignment of its arguments.
+       Division by zero follows the circuit: udiv returns all ones
+       and urem returns the dividend.
+    */
+    bool solver::check_delayed(app* n) {
+        euf::enode* e = expr2enode(n);
+        numeral x, y, z;
+        if (!get_value(get_arg_var(e, 0), x) || !get_value(get_arg_var(e, 1), y) || !get_value(get_var(e), z))
+            return false;
+        if (bv.is_bv_mul(n))
+            return z == mod(x * y, power2(get_bv_size(e)));
+        if (bv.is_bv_udivi(n))
+            return y.is_zero() ? z == power2(get_bv_size(e)) - 1 : z == div(x, y);
+        SASSERT(bv.is_bv_uremi(n));
+        return y.is_zero() ? z == x : z == mod(x, y);
+    }
+
+    void solver::blast_delayed(app* n) {
+        flet<bool> _is_redundant(m_is_redundant, false);
+        expr_ref_vector arg1_bits(m), arg2_bits(m), bits(m);
+        get_arg_bits(n, 0, arg1_bits);
+        get_arg_bits(n, 1, arg2_bits);
+        unsigned sz = arg1_bits.size();
+        if (bv.is_bv_mul(n))
+            m_bb.mk_multiplier(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits);
+        else if (bv.is_bv_udivi(n))
+            m_bb.mk_udiv(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits);
+        else
+            m_bb.mk_urem(sz, arg1_bits.c_ptr(), arg2_bits.c_ptr(), bits);
+        theory_var v = get_var(expr2enode(n));
+        SASSERT(m_bits[v].size() == sz);
+        for (unsigned i = 0; i < sz; ++i) {
+            literal def = ctx.internalize(bits.get(i), false, false, m_is_redundant);
+            add_clause(~def, m_bits[v][i]);
+            add_clause(def, ~m_bits[v][i]);
+        }
+        ctx.push(insert_obj_trail<euf::solver, app>(m_delay_blasted, n));
+        m_delay_blasted.insert(n);
+        ++m_stats.m_num_delay_blasted;
+    }
+
+    /**
+       \brief bit-blast the delayed terms whose assignment is inconsistent.
+       Return false if some circuit was added.
+    */
+    bool solver::check_delayed() {
+        bool consistent = true;
+        for (unsigned i = 0; i < m_delayed.size(); ++i) {
+            app* n = m_delayed[i];
+            if (m_delay_blasted.contains(n) || check_delayed(n))
+                continue;
+            TRACE("bv", tout << "blast " << mk_bounded_pp(n, m) << "\n";);
+            blast_delayed(n);
+            consistent = false;
+        }
+        return consistent;
+    }
+
     void solver::internalize_carry(app* n) {
         SASSERT(n->get_num_args() == 3);
         literal r = expr2literal(n);
@@ -453,6 +453,8 @@ namespace bv {
     sat::check_result solver::check() {
         force_push();
         SASSERT(m_prop_queue.size() == m_prop_queue_head);
+        if (!check_delayed())
+            return sat::check_result::CR_CONTINUE;
         return sat::check_result::CR_DONE;
     }
 
@@ -587,6 +589,8 @@ namespace bv {
         st.update("bv bit2eq", m_stats.m_num_th2core_eq);
         st.update("bv bit2ne", m_stats.m_num_th2core_diseq);
         st.update("bv ackerman", m_stats.m_ackerman);
+        st.update("bv delayed", m_stats.m_num_delayed);
+        st.update("bv delay blasted", m_stats.m_num_delay_blasted);
     }
 
     sat::extension* solver::copy(sat::solver* s) { UNREACHABLE(); return nullptr; }
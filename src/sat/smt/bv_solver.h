@@ -46,6 +46,7 @@ namespace bv {
             unsigned   m_num_diseq_static, m_num_diseq_dynamic,  m_num_conflicts;
             unsigned   m_num_bit2core, m_num_th2core_eq, m_num_th2core_diseq, m_num_nbit2core;
             unsigned   m_ackerman;
+            unsigned   m_num_delayed, m_num_delay_blasted;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -215,6 +216,8 @@ namespace bv {
         svector<propagation_item>  m_prop_queue;
         unsigned_vector            m_prop_queue_lim;
         unsigned                   m_prop_queue_head { 0 };
+        ptr_vector<app>            m_delayed;         // terms whose circuit is created on demand (bv.delay)
+        obj_hashtable<app>         m_delay_blasted;   // delayed terms that have been bit-blasted
 
 
         sat::solver* m_solver;
@@ -269,6 +272,14 @@ namespace bv {
         void assert_int2bv_axiom(app* n);
         void assert_ackerman(theory_var v1, theory_var v2);
 
+        // delayed bit-blasting
+        bool should_delay(app* n) const;
+        void internalize_delayed(app* n);
+        bool get_value(theory_var v, numeral& r) const;
+        bool check_delayed(app* n);
+        void blast_delayed(app* n);
+        bool check_delayed();
+
         // solving
         theory_var find(theory_var v) const { return m_find.find(v); }
         void find_wpos(theory_var v);
@@ -21,6 +21,7 @@ Revision History:
 #include "sat/smt/ba_solver.h"
 #include "sat/sat_simplifier_params.hpp"
 #include "sat/sat_xor_finder.h"
+#include "math/simplex/bit_matrix.h"
 
 
 namespace sat {
@@ -402,6 +403,97 @@ namespace sat {
         }
     }
 
+    /**
+       \brief Gauss-Jordan elimination over GF(2) on the xor constraints
+       at base level. Rows of the solved matrix with at most two variables
+       are added as the empty clause, units or binary equivalences.
+    */
+    void ba_solver::gaussian_xor() {
+        if (get_config().m_drat || s().inconsistent())
+            return;
+        ptr_vector<xr> xors;
+        for (constraint* c : m_constraints) 
+            if (c->is_xr() && !c->was_removed() && c->lit() == null_literal)
+                xors.push_back(&c->to_xr());
+        if (xors.size() < 2)
+            return;
+        unsigned_vector var2col;
+        bool_var_vector col2var;
+        for (xr* x : xors) {
+            for (literal l : *x) {
+                if (value(l) != l_undef)
+                    continue;
+                var2col.reserve(l.var() + 1, UINT_MAX);
+                if (var2col[l.var()] == UINT_MAX) {
+                    var2col[l.var()] = col2var.size();
+                    col2var.push_back(l.var());
+                }
+            }
+        }
+        // bound the cost of the dense elimination.
+        unsigned const_col = col2var.size();
+        uint64_t num_rows = xors.size();
+        if (num_rows * num_rows * (const_col / 64 + 1) > (1ull << 28))
+            return;
+
+        bit_matrix bm;
+        bm.reset(const_col + 1);
+        for (xr* x : xors) {
+            auto row = bm.add_row();
+            // the literals of x sum to 1.
+            bool parity = true;
+            for (literal l : *x) {
+                if (value(l) != l_undef) {
+                    if (value(l) == l_true)
+                        parity = !parity;
+                    continue;
+                }
+                if (l.sign())
+                    parity = !parity;
+                unsigned c = var2col[l.var()];
+                row.set(c, !row[c]);
+            }
+            if (parity)
+                row.set(const_col);
+        }
+        bm.solve();
+
+        for (auto const& r : bm) {
+            unsigned num_vars = 0;
+            bool_var vs[2];
+            for (unsigned c : r) {
+                if (c == const_col || num_vars > 2)
+                    break;
+                if (num_vars < 2)
+                    vs[num_vars] = col2var[c];
+                ++num_vars;
+            }
+            bool rhs = r[const_col];
+            if (num_vars == 0 && rhs) {
+                IF_VERBOSE(2, verbose_stream() << "(sat.gauss inconsistent)\n";);
+                ++m_stats.m_num_gauss;
+                s().mk_clause(0, nullptr, status::th(false, get_id()));
+                return;
+            }
+            if (num_vars == 1) {
+                literal lit(vs[0], !rhs);
+                IF_VERBOSE(10, verbose_stream() << "(sat.gauss unit " << lit << ")\n";);
+                ++m_stats.m_num_gauss;
+                s().mk_clause(1, &lit, status::th(false, get_id()));
+            }
+            else if (num_vars == 2) {
+                // vs[0] xor vs[1] = rhs
+                literal a(vs[0], false), b(vs[1], rhs);
+                IF_VERBOSE(10, verbose_stream() << "(sat.gauss eq " << a << " " << b << ")\n";);
+                ++m_stats.m_num_gauss;
+                s().mk_clause(~a, b, status::th(false, get_id()));
+                s().mk_clause(a, ~b, status::th(false, get_id()));
+            }
+            if (s().inconsistent())
+                return;
+        }
+    }
+
     void ba_solver::extract_xor() {
         xor_finder xf(s());
         std::function<void (literal_vector const&)> f = [this](literal_vector const& l) { add_xr(l, false); };
@@ -0,0 +1,577 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    aig_sat_tactic.cpp
+
+Abstract:
+
+    Tactic that bit-blasts quantifier-free bit-vector goals into an
+    and-inverter graph and solves them with the SAT solver.
+
+    bit_blaster_tactic creates an expression for every gate of the
+    blasted circuit, and goal2sat encodes the expressions. Here the bits
+    of terms are literals of a sat::aig_store, so the gates are two
+    words each and never become expressions. The cone of every assertion
+    is encoded into the SAT solver directly.
+
+    The tactic supports the Boolean connectives and the bit-vector
+    operations up to unsigned division with the interpretation of
+    division by zero. Other operations, quantifiers, and uninterpreted
+    functions make it fail, so it can be combined with or_else.
+
+--*/
+#include <sstream>
+#include "ast/ast_ll_pp.h"
+#include "ast/bv_decl_plugin.h"
+#include "model/model.h"
+#include "tactic/tactical.h"
+#include "sat/sat_aig_store.h"
+#include "sat/sat_solver.h"
+#include "sat/tactic/aig_sat_tactic.h"
+
+namespace {
+
+    class bv2aig {
+        typedef sat::aig_store::lit lit;
+        typedef svector<lit> bits;
+
+        ast_manager &           m;
+        bv_util                 bv;
+        sat::aig_store &        m_aig;
+        obj_map<expr, unsigned> m_cache;    // term -> offset of its bits in m_bits
+        unsigned_vector         m_bits;     // bits of blasted terms, least significant first
+        ptr_vector<expr>        m_todo;
+        ptr_vector<app>         m_inputs;   // uninterpreted constants
+        bits                    m_r;
+
+        lit mk_true() const { return sat::aig_store::true_lit; }
+        lit mk_false() const { return sat::aig_store::false_lit; }
+        lit mk_not(lit a) const { return sat::aig_store::mk_not(a); }
+
+        unsigned get_size(expr * e) const {
+            return m.is_bool(e) ? 1 : bv.get_bv_size(e);
+        }
+
+        lit const * get_bits(expr * e) const {
+            return m_bits.c_ptr() + m_cache[e];
+        }
+
+        lit get_bit(expr * e) const {
+            return *get_bits(e);
+        }
+
+        void get_bits(expr * e, bits & r) const {
+            r.reset();
+            r.append(get_size(e), get_bits(e));
+        }
+
+        void unsupported(expr * e) {
+            std::ostringstream strm;
+            strm << "qfbv-aig does not support " << mk_bounded_pp(e, m, 2);
+            throw tactic_exception(strm.str());
+        }
+
+        lit mk_xor3(lit a, lit b, lit c) {
+            return m_aig.mk_xor(m_aig.mk_xor(a, b), c);
+        }
+
+        void mk_adder(bits const & a, bits const & b, lit carry, bits & r) {
+            r.reset();
+            for (unsigned i = 0; i < a.size(); ++i) {
+                r.push_back(mk_xor3(a[i], b[i], carry));
+                carry = m_aig.mk_maj(a[i], b[i], carry);
+            }
+        }
+
+        void mk_not(bits const & a, bits & r) {
+            r.reset();
+            for (lit l : a)
+                r.push_back(mk_not(l));
+        }
+
+        void mk_sub(bits const & a, bits const & b, bits & r) {
+            bits nb;
+            mk_not(b, nb);
+            mk_adder(a, nb, mk_true(), r);
+        }
+
+        void mk_multiplier(bits const & a, bits const & b, bits & r) {
+            unsigned n = a.size();
+            r.reset();
+            r.resize(n, mk_false());
+            for (unsigned i = 0; i < n; ++i) {
+                if (b[i] == mk_false())
+                    continue;
+                lit carry = mk_false();
+                for (unsigned j = i; j < n; ++j) {
+                    lit p = m_aig.mk_and(a[j - i], b[i]);
+                    lit s = mk_xor3(r[j], p, carry);
+                    carry = m_aig.mk_maj(r[j], p, carry);
+                    r[j] = s;
+                }
+            }
+        }
+
+        lit mk_eq(bits const & a, bits const & b) {
+            lit r = mk_true();
+            for (unsigned i = 0; i < a.size(); ++i)
+                r = m_aig.mk_and(r, m_aig.mk_iff(a[i], b[i]));
+            return r;
+        }
+
+        lit mk_ult(bits const & a, bits const & b) {
+            lit lt = mk_false();
+            for (unsigned i = 0; i < a.size(); ++i)
+                lt = m_aig.mk_or(m_aig.mk_and(mk_not(a[i]), b[i]), m_aig.mk_and(m_aig.mk_iff(a[i], b[i]), lt));
+            return lt;
+        }
+
+        lit mk_slt(bits a, bits b) {
+            // flipping the sign bits maps the signed order to the unsigned order.
+            a.back() = mk_not(a.back());
+            b.back() = mk_not(b.back());
+            return mk_ult(a, b);
+        }
+
+        void mk_ite(lit c, bits const & t, bits const & e, bits & r) {
+            r.reset();
+            for (unsigned i = 0; i < t.size(); ++i)
+                r.push_back(m_aig.mk_ite(c, t[i], e[i]));
+        }
+
+        /**
+           \brief Barrel shifter. kind is OP_BSHL, OP_BLSHR or OP_BASHR.
+        */
+        void mk_shift(decl_kind kind, bits const & a, bits const & b, bits & r) {
+            unsigned n = a.size();
+            lit fill = kind == OP_BASHR ? a.back() : mk_false();
+            bits cur(a), next;
+            lit overflow = mk_false();
+            for (unsigned k = 0; k < n; ++k) {
+                if (k >= 31 || (1u << k) >= n) {
+                    overflow = m_aig.mk_or(overflow, b[k]);
+                    continue;
+                }
+                unsigned shift = 1u << k;
+                next.reset();
+                for (unsigned i = 0; i < n; ++i) {
+                    lit shifted;
+                    if (kind == OP_BSHL)
+                        shifted = i >= shift ? cur[i - shift] : fill;
+                    else
+                        shifted = i + shift < n ? cur[i + shift] : fill;
+                    next.push_back(m_aig.mk_ite(b[k], shifted, cur[i]));
+                }
+                cur.swap(next);
+            }
+            r.reset();
+            for (unsigned i = 0; i < n; ++i)
+                r.push_back(m_aig.mk_ite(overflow, fill, cur[i]));
+        }
+
+        /**
+           \brief Restoring division. Division by zero produces the quotient
+           with all bits set and the dividend as remainder.
+        */
+        void mk_udiv_urem(bits const & a, bits const & b, bits & q, bits & rem) {
+            unsigned n = a.size();
+            bits b1(b), shifted, diff;
+            b1.push_back(mk_false());
+            rem.reset();
+            rem.resize(n, mk_false());
+            q.reset();
+            q.resize(n, mk_false());
+            for (unsigned i = n; i-- > 0; ) {
+                shifted.reset();
+                shifted.push_back(a[i]);
+                shifted.append(rem);
+                lit ge = mk_not(mk_ult(shifted, b1));
+                mk_sub(shifted, b1, diff);
+                for (unsigned j = 0; j < n; ++j)
+                    rem[j] = m_aig.mk_ite(ge, diff[j], shifted[j]);
+                q[i] = ge;
+            }
+        }
+
+        void mk_input(app * a) {
+            if (!m.is_bool(a) && !bv.is_bv(a))
+                unsupported(a);
+            m_inputs.push_back(a);
+            for (unsigned i = get_size(a); i-- > 0; )
+                m_r.push_back(m_aig.mk_input());
+        }
+
+        void reduce_basic(app * a) {
+            switch (a->get_decl_kind()) {
+            case OP_TRUE:
+                m_r.push_back(mk_true());
+                break;
+            case OP_FALSE:
+                m_r.push_back(mk_false());
+                break;
+            case OP_NOT:
+                m_r.push_back(mk_not(get_bit(a->get_arg(0))));
+                break;
+            case OP_AND: {
+                lit r = mk_true();
+                for (expr * arg : *a)
+                    r = m_aig.mk_and(r, get_bit(arg));
+                m_r.push_back(r);
+                break;
+            }
+            case OP_OR: {
+                lit r = mk_false();
+                for (expr * arg : *a)
+                    r = m_aig.mk_or(r, get_bit(arg));
+                m_r.push_back(r);
+                break;
+            }
+            case OP_XOR: {
+                lit r = mk_false();
+                for (expr * arg : *a)
+                    r = m_aig.mk_xor(r, get_bit(arg));
+                m_r.push_back(r);
+                break;
+            }
+            case OP_IMPLIES:
+                m_r.push_back(m_aig.mk_or(mk_not(get_bit(a->get_arg(0))), get_bit(a->get_arg(1))));
+                break;
+            case OP_EQ: {
+                bits x, y;
+                get_bits(a->get_arg(0), x);
+                get_bits(a->get_arg(1), y);
+                m_r.push_back(mk_eq(x, y));
+                break;
+            }
+            case OP_DISTINCT: {
+                bits x, y;
+                lit r = mk_true();
+                for (unsigned i = 0; i < a->get_num_args(); ++i) {
+                    get_bits(a->get_arg(i), x);
+                    for (unsigned j = i + 1; j < a->get_num_args(); ++j) {
+                        get_bits(a->get_arg(j), y);
+                        r = m_aig.mk_and(r, mk_not(mk_eq(x, y)));
+                    }
+                }
+                m_r.push_back(r);
+                break;
+            }
+            case OP_ITE: {
+                bits t, e;
+                get_bits(a->get_arg(1), t);
+                get_bits(a->get_arg(2), e);
+                mk_ite(get_bit(a->get_arg(0)), t, e, m_r);
+                break;
+            }
+            default:
+                unsupported(a);
+            }
+        }
+
+        void reduce_bv(app * a) {
+            rational val;
+            unsigned sz;
+            bits x, y, t;
+            unsigned num_args = a->get_num_args();
+            if (num_args > 0)
+                get_bits(a->get_arg(0), x);
+            if (num_args > 1)
+                get_bits(a->get_arg(1), y);
+            decl_kind k = a->get_decl_kind();
+            switch (k) {
+            case OP_BV_NUM:
+                VERIFY(bv.is_numeral(a, val, sz));
+                for (unsigned i = 0; i < sz; ++i) {
+                    m_r.push_back(val.is_even() ? mk_false() : mk_true());
+                    val = div(val, rational(2));
+                }
+                break;
+            case OP_BIT0:
+                m_r.push_back(mk_false());
+                break;
+            case OP_BIT1:
+                m_r.push_back(mk_true());
+                break;
+            case OP_BNOT:
+                mk_not(x, m_r);
+                break;
+            case OP_BAND:
+            case OP_BOR:
+            case OP_BXOR:
+            case OP_BNAND:
+            case OP_BNOR:
+            case OP_BXNOR:
+                for (unsigned i = 1; i < num_args; ++i) {
+                    get_bits(a->get_arg(i), y);
+                    for (unsigned j = 0; j < x.size(); ++j) {
+                        if (k == OP_BXOR || k == OP_BXNOR)
+                            x[j] = m_aig.mk_xor(x[j], y[j]);
+                        else if (k == OP_BOR || k == OP_BNOR)
+                            x[j] = m_aig.mk_or(x[j], y[j]);
+                        else
+                            x[j] = m_aig.mk_and(x[j], y[j]);
+                    }
+                }
+                if (k == OP_BNAND || k == OP_BNOR || k == OP_BXNOR)
+                    mk_not(x, m_r);
+                else
+                    m_r.append(x);
+                break;
+            case OP_BNEG:
+                mk_not(x, t);
+                y.reset();
+                y.resize(x.size(), mk_false());
+                mk_adder(t, y, mk_true(), m_r);
+                break;
+            case OP_BADD:
+                for (unsigned i = 1; i < num_args; ++i) {
+                    get_bits(a->get_arg(i), y);
+                    mk_adder(x, y, mk_false(), t);
+                    x.swap(t);
+                }
+                m_r.append(x);
+                break;
+            case OP_BSUB:
+                mk_sub(x, y, m_r);
+                break;
+            case OP_BMUL:
+                for (unsigned i = 1; i < num_args; ++i) {
+                    get_bits(a->get_arg(i), y);
+                    mk_multiplier(x, y, t);
+                    x.swap(t);
+                }
+                m_r.append(x);
+                break;
+            case OP_BUDIV_I:
+                mk_udiv_urem(x, y, m_r, t);
+                break;
+            case OP_BUREM_I:
+                mk_udiv_urem(x, y, t, m_r);
+                break;
+            case OP_ULEQ:
+                m_r.push_back(mk_not(mk_ult(y, x)));
+                break;
+            case OP_UGEQ:
+                m_r.push_back(mk_not(mk_ult(x, y)));
+                break;
+            case OP_ULT:
+                m_r.push_back(mk_ult(x, y));
+                break;
+            case OP_UGT:
+                m_r.push_back(mk_ult(y, x));
+                break;
+            case OP_SLEQ:
+                m_r.push_back(mk_not(mk_slt(y, x)));
+                break;
+            case OP_SGEQ:
+                m_r.push_back(mk_not(mk_slt(x, y)));
+                break;
+            case OP_SLT:
+                m_r.push_back(mk_slt(x, y));
+                break;
+            case OP_SGT:
+                m_r.push_back(mk_slt(y, x));
+                break;
+            case OP_CONCAT:
+                for (unsigned i = num_args; i-- > 0; ) {
+                    get_bits(a->get_arg(i), t);
+                    m_r.append(t);
+                }
+                break;
+            case OP_EXTRACT:
+                for (unsigned i = bv.get_extract_low(a); i <= bv.get_extract_high(a); ++i)
+                    m_r.push_back(x[i]);
+                break;
+            case OP_ZERO_EXT:
+            case OP_SIGN_EXT:
+                m_r.append(x);
+                for (int i = a->get_decl()->get_parameter(0).get_int(); i > 0; --i)
+                    m_r.push_back(k == OP_ZERO_EXT ? mk_false() : x.back());
+                break;
+            case OP_REPEAT:
+                for (int i = a->get_decl()->get_parameter(0).get_int(); i > 0; --i)
+                    m_r.append(x);
+                break;
+            case OP_ROTATE_LEFT:
+            case OP_ROTATE_RIGHT: {
+                unsigned n = x.size();
+                unsigned s = a->get_decl()->get_parameter(0).get_int() % n;
+                if (k == OP_ROTATE_LEFT)
+                    s = (n - s) % n;
+                for (unsigned i = 0; i < n; ++i)
+                    m_r.push_back(x[(i + s) % n]);
+                break;
+            }
+            case OP_BSHL:
+            case OP_BLSHR:
+            case OP_BASHR:
+                mk_shift(k, x, y, m_r);
+                break;
+            case OP_BREDOR: {
+                lit r = mk_false();
+                for (lit l : x)
+                    r = m_aig.mk_or(r, l);
+                m_r.push_back(r);
+                break;
+            }
+            case OP_BREDAND: {
+                lit r = mk_true();
+                for (lit l : x)
+                    r = m_aig.mk_and(r, l);
+                m_r.push_back(r);
+                break;
+            }
+            case OP_BCOMP:
+                m_r.push_back(mk_eq(x, y));
+                break;
+            case OP_BIT2BOOL:
+                m_r.push_back(x[a->get_decl()->get_parameter(0).get_int()]);
+                break;
+            default:
+                unsupported(a);
+            }
+        }
+
+        void reduce(app * a) {
+            m_r.reset();
+            if (is_uninterp_const(a))
+                mk_input(a);
+            else if (a->get_family_id() == m.get_basic_family_id())
+                reduce_basic(a);
+            else if (a->get_family_id() == bv.get_family_id())
+                reduce_bv(a);
+            else
+                unsupported(a);
+            SASSERT(m_r.size() == get_size(a));
+            m_cache.insert(a, m_bits.size());
+            m_bits.append(m_r);
+        }
+
+    public:
+        bv2aig(ast_manager & m, sat::aig_store & aig): m(m), bv(m), m_aig(aig) {}
+
+        /**
+           \brief Blast the Boolean formula e and return its literal.
+        */
+        lit operator()(expr * e) {
+            m_todo.push_back(e);
+            while (!m_todo.empty()) {
+                expr * t = m_todo.back();
+                if (m_cache.contains(t)) {
+                    m_todo.pop_back();
+                    continue;
+                }
+                if (!is_app(t))
+                    unsupported(t);
+                bool visited = true;
+                for (expr * arg : *to_app(t)) {
+                    if (!m_cache.contains(arg)) {
+                        m_todo.push_back(arg);
+                        visited = false;
+                    }
+                }
+                if (!visited)
+                    continue;
+                m_todo.pop_back();
+                reduce(to_app(t));
+            }
+            return get_bit(e);
+        }
+
+        ptr_vector<app> const & inputs() const { return m_inputs; }
+
+        expr_ref get_value(app * c, sat::model const & mdl) const {
+            lit const * b = get_bits(c);
+            if (m.is_bool(c))
+                return expr_ref(m.mk_bool_val(m_aig.value(b[0], mdl)), m);
+            unsigned sz = get_size(c);
+            rational val(0);
+            for (unsigned i = sz; i-- > 0; ) {
+                val *= rational(2);
+                if (m_aig.value(b[i], mdl))
+                    val += rational(1);
+            }
+            return expr_ref(bv.mk_numeral(val, sz), m);
+        }
+    };
+
+}
+
+class aig_sat_tactic : public tactic {
+    params_ref m_params;
+    statistics m_stats;
+
+public:
+    aig_sat_tactic(params_ref const & p): m_params(p) {}
+
+    tactic * translate(ast_manager & m) override {
+        return alloc(aig_sat_tactic, m_params);
+    }
+
+    void updt_params(params_ref const & p) override {
+        m_params = p;
+    }
+
+    void collect_param_descrs(param_descrs & r) override {
+        sat::solver::collect_param_descrs(r);
+    }
+
+    void operator()(goal_ref const & g, goal_ref_buffer & result) override {
+        fail_if_proof_generation("qfbv-aig", g);
+        fail_if_unsat_core_generation("qfbv-aig", g);
+        ast_manager & m = g->m();
+        tactic_report report("qfbv-aig", *g);
+        if (g->inconsistent()) {
+            result.push_back(g.get());
+            return;
+        }
+        sat::aig_store aig;
+        bv2aig blast(m, aig);
+        sat::solver s(m_params, m.limit());
+        lbool r = l_undef;
+        try {
+            for (unsigned i = 0; !s.inconsistent() && i < g->size(); ++i) {
+                sat::literal l = aig.to_sat(blast(g->form(i)), s);
+                s.add_clause(1, &l, sat::status::input());
+            }
+            m_stats.update("aig nodes", aig.num_nodes());
+            r = s.check();
+            s.collect_statistics(m_stats);
+        }
+        catch (sat::solver_exception & ex) {
+            s.collect_statistics(m_stats);
+            throw tactic_exception(ex.msg());
+        }
+        if (r == l_undef)
+            throw tactic_exception(s.get_reason_unknown());
+        bool produce_models = g->models_enabled();
+        g->reset();
+        if (r == l_false) {
+            g->assert_expr(m.mk_false(), nullptr, nullptr);
+        }
+        else if (produce_models) {
+            model_ref md = alloc(model, m);
+            for (app * c : blast.inputs())
+                md->register_decl(c->get_decl(), blast.get_value(c, s.get_model()));
+            g->add(model2model_converter(md.get()));
+        }
+        g->inc_depth();
+        result.push_back(g.get());
+    }
+
+    void cleanup() override {}
+
+    void collect_statistics(statistics & st) const override {
+        st.copy(m_stats);
+    }
+
+    void reset_statistics() override {
+        m_stats.reset();
+    }
+};
+
+tactic * mk_aig_sat_tactic(ast_manager & m, params_ref const & p) {
+    return clean(alloc(aig_sat_tactic, p));
+}
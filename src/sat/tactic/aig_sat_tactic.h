@@ -0,0 +1,24 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    aig_sat_tactic.h
+
+Abstract:
+
+    Tactic that bit-blasts quantifier-free bit-vector goals into an
+    and-inverter graph and solves them with the SAT solver.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+class ast_manager;
+class tactic;
+
+tactic * mk_aig_sat_tactic(ast_manager & m, params_ref const & p = params_ref());
+
+/*
+  ADD_TACTIC('qfbv-aig', 'bit-blast a quantifier-free bit-vector goal into a structurally hashed and-inverter graph, bypassing the ast_manager, and solve it with the SAT solver.', 'mk_aig_sat_tactic(m, p)')
+*/
@@ -45,6 +45,7 @@ Notes:
 #include "sat/smt/euf_solver.h"
 #include "sat/smt/sat_th.h"
 #include "sat/sat_params.hpp"
+#include "util/parallel_executor.h"
 #include<sstream>
 
 struct goal2sat::imp : public sat::sat_internalizer {
@@ -69,6 +70,8 @@ struct goal2sat::imp : public sat::sat_internalizer {
     obj_map<expr, sat::bool_var>* m_expr2var_replay { nullptr };
     sat::literal                m_true;
     bool                        m_ite_extra;
+    unsigned                    m_cnf_threads;
+    unsigned                    m_cnf_threshold;
     unsigned long long          m_max_memory;
     expr_ref_vector             m_trail;
     func_decl_ref_vector        m_unhandled_funs;
@@ -99,6 +102,8 @@ struct goal2sat::imp : public sat::sat_internalizer {
     void updt_params(params_ref const & p) {
         sat_params sp(p);
         m_ite_extra  = p.get_bool("ite_extra", true);
+        m_cnf_threads = p.get_uint("cnf_threads", 1);
+        m_cnf_threshold = p.get_uint("cnf_threshold", 100000);
         m_max_memory = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         m_xor_solver = p.get_bool("xor_solver", false);
         m_euf = sp.euf();
@@ -819,6 +824,220 @@ struct goal2sat::imp : public sat::sat_internalizer {
         m_result_stack.pop_back();
     }
 
+    bool is_cnf_leaf(expr* e) const {
+        return is_uninterp_const(e) || m.is_true(e) || m.is_false(e);
+    }
+
+    bool is_cnf_gate(expr* e) const {
+        if (!is_app(e) || to_app(e)->get_family_id() != m.get_basic_family_id())
+            return false;
+        app* t = to_app(e);
+        switch (t->get_decl_kind()) {
+        case OP_OR:
+        case OP_AND:
+        case OP_ITE:
+        case OP_IMPLIES:
+            return true;
+        case OP_XOR:
+            return t->get_num_args() == 2;
+        case OP_EQ:
+            return m.is_bool(t->get_arg(0)) && !is_xor(t);
+        default:
+            return false;
+        }
+    }
+
+    /**
+       \brief Collect the sub-formulas of the goal in post-order, except for the
+       root gates that are not sub-formulas of other formulas when they are
+       reached. Return false if the goal contains formulas that are not
+       handled by convert_parallel.
+    */
+    bool collect_cnf(goal const& g, ptr_vector<app>& order, ptr_vector<expr>& roots, bool_vector& signs, bool_vector& is_unit) {
+        expr_mark visited;
+        ptr_vector<expr> todo;
+        for (unsigned idx = 0; idx < g.size(); ++idx) {
+            expr* r = g.form(idx);
+            bool sign = false;
+            while (m.is_not(r, r))
+                sign = !sign;
+            bool unit = visited.is_marked(r) || !is_cnf_gate(r);
+            if (unit)
+                todo.push_back(r);
+            else
+                todo.append(to_app(r)->get_num_args(), to_app(r)->get_args());
+            roots.push_back(r);
+            signs.push_back(sign);
+            is_unit.push_back(unit);
+            while (!todo.empty()) {
+                expr* e = todo.back();
+                if (visited.is_marked(e)) {
+                    todo.pop_back();
+                    continue;
+                }
+                if (!is_cnf_leaf(e)) {
+                    if (!m.is_not(e) && !is_cnf_gate(e))
+                        return false;
+                    bool done = true;
+                    for (expr* arg : *to_app(e)) {
+                        if (!visited.is_marked(arg)) {
+                            todo.push_back(arg);
+                            done = false;
+                        }
+                    }
+                    if (!done)
+                        continue;
+                }
+                visited.mark(e, true);
+                order.push_back(to_app(e));
+                todo.pop_back();
+            }
+        }
+        return true;
+    }
+
+    sat::literal cnf_lit(expr* e) const {
+        sat::literal l;
+        VERIFY(m_cache.find(to_app(e), l));
+        return l;
+    }
+
+    /**
+       \brief Append the clauses defining the literal of the gate t to out,
+       each clause is terminated by a null literal.
+       It only reads the cache and is invoked concurrently by convert_parallel.
+    */
+    void mk_gate_clauses(app* t, sat::literal_vector& out) const {
+        auto clause = [&](std::initializer_list<sat::literal> lits) {
+            out.append(static_cast<unsigned>(lits.size()), lits.begin());
+            out.push_back(sat::null_literal);
+        };
+        sat::literal l = cnf_lit(t);
+        switch (t->get_decl_kind()) {
+        case OP_OR:
+            for (expr* arg : *t)
+                clause({ ~cnf_lit(arg), l });
+            out.push_back(~l);
+            for (expr* arg : *t)
+                out.push_back(cnf_lit(arg));
+            out.push_back(sat::null_literal);
+            break;
+        case OP_AND:
+            for (expr* arg : *t)
+                clause({ ~l, cnf_lit(arg) });
+            out.push_back(l);
+            for (expr* arg : *t)
+                out.push_back(~cnf_lit(arg));
+            out.push_back(sat::null_literal);
+            break;
+        case OP_ITE: {
+            sat::literal c = cnf_lit(t->get_arg(0)), th = cnf_lit(t->get_arg(1)), el = cnf_lit(t->get_arg(2));
+            clause({ ~l, ~c, th });
+            clause({ ~l,  c, el });
+            clause({ l,  ~c, ~th });
+            clause({ l,   c, ~el });
+            if (m_ite_extra) {
+                clause({ ~th, ~el, l });
+                clause({ th,  el, ~l });
+            }
+            break;
+        }
+        case OP_IMPLIES: {
+            sat::literal l1 = cnf_lit(t->get_arg(0)), l2 = cnf_lit(t->get_arg(1));
+            clause({ ~l, ~l1, l2 });
+            clause({ l1, l });
+            clause({ ~l2, l });
+            break;
+        }
+        case OP_EQ:
+        case OP_XOR: {
+            sat::literal l1 = cnf_lit(t->get_arg(0)), l2 = cnf_lit(t->get_arg(1));
+            if (t->get_decl_kind() == OP_XOR)
+                l = ~l;
+            clause({ ~l, l1, ~l2 });
+            clause({ ~l, ~l1, l2 });
+            clause({ l,  l1, l2 });
+            clause({ l, ~l1, ~l2 });
+            break;
+        }
+        default:
+            UNREACHABLE();
+        }
+    }
+
+    /**
+       \brief Convert a large, purely Boolean goal using m_cnf_threads threads.
+       Variables are allocated sequentially for all sub-formulas, then the
+       gates are partitioned and their defining clauses are created
+       concurrently into one buffer per thread, and finally the buffers are
+       added to the solver. Return false, without side effects, if the goal
+       is not eligible.
+    */
+    bool convert_parallel(goal const& g) {
+        if (m_cnf_threads <= 1 || g.unsat_core_enabled() || m_euf || m_aig || m_drat || m_expr2var_replay || m_is_redundant)
+            return false;
+        ptr_vector<app> order, gates;
+        ptr_vector<expr> roots;
+        bool_vector signs, is_unit;
+        if (!collect_cnf(g, order, roots, signs, is_unit) || order.size() < m_cnf_threshold)
+            return false;
+        TRACE("goal2sat", tout << "parallel cnf of " << order.size() << " sub-formulas\n";);
+        for (app* t : order) {
+            if (memory::get_allocation_size() > m_max_memory)
+                throw tactic_exception(TACTIC_MAX_MEMORY_MSG);
+            if (m.is_not(t))
+                m_cache.insert(t, ~cnf_lit(t->get_arg(0)));
+            else if (is_cnf_gate(t)) {
+                m_cache.insert(t, sat::literal(add_var(false, t), false));
+                gates.push_back(t);
+            }
+            else {
+                convert_atom(t, false, false);
+                m_cache.insert(t, m_result_stack.back());
+                m_result_stack.pop_back();
+            }
+        }
+        if (!m.inc())
+            throw tactic_exception(m.limit().get_cancel_msg());
+
+        unsigned num_threads = std::max(1u, std::min(m_cnf_threads, gates.size()));
+        vector<sat::literal_vector> buffers(num_threads);
+        unsigned sz = gates.size();
+        parallel_executor::run(num_threads, [&](unsigned i) {
+            for (unsigned j = i * sz / num_threads; j < (i + 1) * sz / num_threads; ++j) {
+                if (j % 1024 == 0 && m.limit().is_canceled())
+                    return;
+                mk_gate_clauses(gates[j], buffers[i]);
+            }
+        });
+        if (!m.inc())
+            throw tactic_exception(m.limit().get_cancel_msg());
+
+        for (sat::literal_vector& buffer : buffers) {
+            unsigned start = 0;
+            for (unsigned j = 0; j < buffer.size(); ++j) {
+                if (buffer[j] != sat::null_literal)
+                    continue;
+                mk_clause(j - start, buffer.c_ptr() + start);
+                start = j + 1;
+            }
+            buffer.finalize();
+        }
+        for (unsigned i = 0; i < roots.size(); ++i) {
+            expr* r = roots[i];
+            if (is_unit[i]) {
+                sat::literal l = cnf_lit(r);
+                mk_root_clause(signs[i] ? ~l : l);
+                continue;
+            }
+            VERIFY(m_result_stack.empty());
+            for (expr* arg : *to_app(r))
+                m_result_stack.push_back(cnf_lit(arg));
+            convert(to_app(r), true, signs[i]);
+        }
+        return true;
+    }
+
     void operator()(goal const & g) {
         struct scoped_reset {
             imp& i;
@@ -830,6 +1049,8 @@ struct goal2sat::imp : public sat::sat_internalizer {
         };
         scoped_reset _reset(*this);
         collect_boolean_interface(g, m_interface_vars);
+        if (convert_parallel(g))
+            return;
         unsigned size = g.size();
         expr_ref f(m), d_new(m);
         ptr_vector<expr> deps;
@@ -916,6 +1137,8 @@ goal2sat::~goal2sat() {
 void goal2sat::collect_param_descrs(param_descrs & r) {
     insert_max_memory(r);
     r.insert("ite_extra", CPK_BOOL, "(default: true) add redundant clauses (that improve unit propagation) when encoding if-then-else formulas");
+    r.insert("cnf_threads", CPK_UINT, "(default: 1) number of threads used to create the clauses of purely Boolean goals");
+    r.insert("cnf_threshold", CPK_UINT, "(default: 100000) minimal number of sub-formulas of a goal for creating its clauses with multiple threads");
 }
 
 
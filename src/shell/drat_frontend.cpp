@@ -5,6 +5,8 @@ Copyright (c) 2020 Microsoft Corporation
 
 #include<iostream>
 #include<fstream>
+#include<cstring>
+#include<unordered_map>
 #include "ast/bv_decl_plugin.h"
 #include "util/memory_manager.h"
 #include "util/statistics.h"
@@ -225,6 +227,314 @@ public:
     }
 };
 
+/**
+   \brief Backward DRUP checker for propositional DRAT proofs of DIMACS problems.
+
+   The proof is replayed forward without checking until the empty clause.
+   Lemmas are then checked in reverse order, and only those that were used
+   to justify the empty clause or a later checked lemma are checked.
+   Unit propagation visits used (core) clauses before the remaining clauses,
+   so that justifications tend to stay within the core.
+*/
+class drup_checker {
+    struct proof_step {
+        unsigned m_id;
+        bool     m_deleted;
+        proof_step(unsigned id, bool deleted): m_id(id), m_deleted(deleted) {}
+    };
+    struct stats {
+        unsigned m_num_lemmas { 0 };
+        unsigned m_num_checked { 0 };
+        unsigned m_num_core { 0 };
+        unsigned m_num_propagations { 0 };
+    };
+    vector<sat::literal_vector>  m_clauses;
+    bool_vector                  m_active, m_core, m_is_lemma;
+    svector<proof_step>          m_proof;
+    vector<unsigned_vector>      m_watches;
+    unsigned_vector              m_units;
+    std::unordered_multimap<unsigned, unsigned> m_table;
+    svector<lbool>               m_assignment;
+    unsigned_vector              m_reason;
+    bool_vector                  m_seen;
+    sat::literal_vector          m_trail;
+    unsigned                     m_core_head { 0 }, m_head { 0 };
+    bool                         m_has_empty { false };
+    stats                        m_stats;
+
+    static unsigned hash(sat::literal_vector const& lits) {
+        unsigned h = 17;
+        for (sat::literal l : lits)
+            h = h * 31 + l.index();
+        return h;
+    }
+
+    lbool value(sat::literal l) const {
+        lbool r = m_assignment[l.var()];
+        return l.sign() ? ~r : r;
+    }
+
+    void reserve(sat::bool_var v) {
+        if (v < m_assignment.size())
+            return;
+        m_assignment.resize(v + 1, l_undef);
+        m_reason.resize(v + 1, UINT_MAX);
+        m_seen.resize(v + 1, false);
+        m_watches.resize(2 * v + 2);
+    }
+
+    void normalize(sat::literal_vector& lits) {
+        std::sort(lits.begin(), lits.end());
+        unsigned j = 0;
+        for (unsigned i = 0; i < lits.size(); ++i)
+            if (j == 0 || lits[j - 1] != lits[i])
+                lits[j++] = lits[i];
+        lits.shrink(j);
+    }
+
+    void watch(unsigned id) {
+        sat::literal_vector const& c = m_clauses[id];
+        if (c.size() == 1)
+            m_units.push_back(id);
+        else if (c.size() > 1) {
+            m_watches[(~c[0]).index()].push_back(id);
+            m_watches[(~c[1]).index()].push_back(id);
+        }
+    }
+
+    void add(sat::literal_vector lits, bool is_lemma) {
+        normalize(lits);
+        for (sat::literal l : lits)
+            reserve(l.var());
+        unsigned id = m_clauses.size();
+        m_table.emplace(hash(lits), id);
+        m_clauses.push_back(lits);
+        m_active.push_back(true);
+        m_core.push_back(false);
+        m_is_lemma.push_back(is_lemma);
+        m_proof.push_back(proof_step(id, false));
+        watch(id);
+        if (lits.empty())
+            m_has_empty = true;
+    }
+
+    void del(sat::literal_vector lits) {
+        normalize(lits);
+        auto range = m_table.equal_range(hash(lits));
+        for (auto it = range.first; it != range.second; ++it) {
+            unsigned id = it->second;
+            if (m_active[id] && m_clauses[id] == lits) {
+                m_active[id] = false;
+                m_proof.push_back(proof_step(id, true));
+                m_table.erase(it);
+                return;
+            }
+        }
+    }
+
+    void assign(sat::literal l, unsigned reason) {
+        m_assignment[l.var()] = l.sign() ? l_false : l_true;
+        m_reason[l.var()] = reason;
+        m_trail.push_back(l);
+    }
+
+    void reset_assignment() {
+        for (sat::literal l : m_trail) {
+            m_assignment[l.var()] = l_undef;
+            m_reason[l.var()] = UINT_MAX;
+        }
+        m_trail.reset();
+        m_core_head = m_head = 0;
+    }
+
+    /**
+       \brief propagate the clauses watching ~l. Only core clauses are
+       visited if core is true, and only non-core clauses otherwise.
+       Return the id of a conflict clause or UINT_MAX.
+    */
+    unsigned propagate(sat::literal l, bool core) {
+        unsigned_vector& ws = m_watches[l.index()];
+        unsigned j = 0, sz = ws.size();
+        unsigned conflict = UINT_MAX;
+        for (unsigned i = 0; i < sz; ++i) {
+            unsigned id = ws[i];
+            sat::literal_vector& c = m_clauses[id];
+            if (!m_active[id])
+                continue;
+            if (c[0] == ~l)
+                std::swap(c[0], c[1]);
+            if (c[1] != ~l)
+                continue;
+            if (conflict != UINT_MAX || m_core[id] != core || value(c[0]) == l_true) {
+                ws[j++] = id;
+                continue;
+            }
+            bool found = false;
+            for (unsigned k = 2; k < c.size(); ++k) {
+                if (value(c[k]) != l_false) {
+                    std::swap(c[1], c[k]);
+                    m_watches[(~c[1]).index()].push_back(id);
+                    found = true;
+                    break;
+                }
+            }
+            if (found)
+                continue;
+            ws[j++] = id;
+            if (value(c[0]) == l_false)
+                conflict = id;
+            else {
+                ++m_stats.m_num_propagations;
+                assign(c[0], id);
+            }
+        }
+        ws.shrink(j);
+        return conflict;
+    }
+
+    unsigned propagate() {
+        for (unsigned id : m_units) {
+            if (!m_active[id])
+                continue;
+            sat::literal u = m_clauses[id][0];
+            if (value(u) == l_false)
+                return id;
+            if (value(u) == l_undef)
+                assign(u, id);
+        }
+        while (true) {
+            while (m_core_head < m_trail.size()) {
+                unsigned conflict = propagate(m_trail[m_core_head++], true);
+                if (conflict != UINT_MAX)
+                    return conflict;
+            }
+            if (m_head == m_trail.size())
+                return UINT_MAX;
+            unsigned conflict = propagate(m_trail[m_head++], false);
+            if (conflict != UINT_MAX)
+                return conflict;
+        }
+    }
+
+    void mark_core(unsigned id) {
+        if (!m_core[id]) {
+            m_core[id] = true;
+            if (m_is_lemma[id])
+                ++m_stats.m_num_core;
+        }
+    }
+
+    /**
+       \brief mark the clauses used to derive the conflict.
+    */
+    void analyze(unsigned conflict) {
+        mark_core(conflict);
+        for (sat::literal l : m_clauses[conflict])
+            m_seen[l.var()] = true;
+        for (unsigned i = m_trail.size(); i-- > 0; ) {
+            sat::bool_var v = m_trail[i].var();
+            if (!m_seen[v])
+                continue;
+            m_seen[v] = false;
+            unsigned r = m_reason[v];
+            if (r == UINT_MAX)
+                continue;
+            mark_core(r);
+            for (sat::literal l : m_clauses[r])
+                m_seen[l.var()] = true;
+        }
+    }
+
+    bool is_rup(unsigned id) {
+        reset_assignment();
+        for (sat::literal l : m_clauses[id]) {
+            // a tautology contains l and ~l
+            if (value(l) == l_true)
+                return true;
+            assign(~l, UINT_MAX);
+        }
+        unsigned conflict = propagate();
+        if (conflict == UINT_MAX)
+            return false;
+        analyze(conflict);
+        return true;
+    }
+
+public:
+
+    void add(dimacs::drat_record const& r) {
+        if (m_has_empty || r.m_tag != dimacs::drat_record::tag_t::is_clause)
+            return;
+        if (r.m_status.is_deleted())
+            del(r.m_lits);
+        else {
+            ++m_stats.m_num_lemmas;
+            add(r.m_lits, r.m_status.is_redundant());
+        }
+    }
+
+    void add_input(sat::literal_vector const& lits) {
+        add(lits, false);
+        m_proof.pop_back();
+    }
+
+    bool check() {
+        // the empty clause is derived from the final clause set.
+        reset_assignment();
+        unsigned conflict = propagate();
+        if (conflict == UINT_MAX) {
+            std::cout << "c no conflict by unit propagation at the end of the proof\n";
+            return false;
+        }
+        analyze(conflict);
+        for (unsigned i = m_proof.size(); i-- > 0; ) {
+            proof_step const& st = m_proof[i];
+            if (st.m_deleted) {
+                m_active[st.m_id] = true;
+                watch(st.m_id);
+                continue;
+            }
+            m_active[st.m_id] = false;
+            if (!m_core[st.m_id] || !m_is_lemma[st.m_id] || m_clauses[st.m_id].empty())
+                continue;
+            ++m_stats.m_num_checked;
+            if (!is_rup(st.m_id)) {
+                std::cout << "c lemma " << m_clauses[st.m_id] << " is not RUP\n";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void display_statistics(std::ostream& out) const {
+        out << "c lemmas:       " << m_stats.m_num_lemmas << "\n";
+        out << "c checked:      " << m_stats.m_num_checked << "\n";
+        out << "c core lemmas:  " << m_stats.m_num_core << "\n";
+        out << "c propagations: " << m_stats.m_num_propagations << "\n";
+    }
+};
+
+static unsigned verify_dimacs(char const* drat_file, char const* cnf_file) {
+    drup_checker checker;
+    std::ifstream cnf_in(cnf_file);
+    if (!cnf_in) {
+        std::cerr << "could not read file " << cnf_file << "\n";
+        return 1;
+    }
+    dimacs::drat_parser cnf(cnf_in, std::cerr);
+    for (auto const& r : cnf)
+        if (r.m_tag == dimacs::drat_record::tag_t::is_clause)
+            checker.add_input(r.m_lits);
+    std::ifstream ins(drat_file);
+    dimacs::drat_parser drat(ins, std::cerr);
+    for (auto const& r : drat)
+        checker.add(r);
+    bool ok = checker.check();
+    checker.display_statistics(std::cout);
+    std::cout << (ok ? "s VERIFIED\n" : "s NOT VERIFIED\n");
+    return ok ? 0 : 1;
+}
+
 static void verify_smt(char const* drat_file, char const* smt_file) {
     cmd_context ctx;
     ctx.set_ignore_check(true);
@@ -328,9 +638,12 @@ static void verify_smt(char const* drat_file, char const* smt_file) {
 
 unsigned read_drat(char const* drat_file, char const* problem_file) {
     if (!problem_file) {
-        std::cerr << "No smt2 file provided to checker\n";
+        std::cerr << "No smt2 or cnf file provided to checker\n";
         return -1;
     }
+    char const* ext = strrchr(problem_file, '.');
+    if (ext && (strcmp(ext, ".cnf") == 0 || strcmp(ext, ".dimacs") == 0))
+        return verify_dimacs(drat_file, problem_file);
     verify_smt(drat_file, problem_file);
     return 0;
 }
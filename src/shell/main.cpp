@@ -50,6 +50,7 @@ static std::string  g_aux_input_file;
 static char const * g_input_file          = nullptr;
 static char const * g_drat_input_file     = nullptr;
 static bool         g_standard_input      = false;
+static bool         g_server              = false;
 static input_kind   g_input_kind          = IN_UNSPECIFIED;
 bool                g_display_statistics  = false;
 bool                g_display_model       = false;
@@ -87,6 +88,7 @@ void display_usage() {
     std::cout << "  -lp         use parser for a modest subset of CPLEX LP input format.\n";
     std::cout << "  -log        use parser for Z3 log input format.\n";
     std::cout << "  -in         read formula from standard input.\n";
+    std::cout << "  -server     serve SMT 2 sessions over standard input and output.\n";
     std::cout << "  -model      display model for satisfiable SMT.\n";
     std::cout << "\nMiscellaneous:\n";
     std::cout << "  -h, -?      prints this message.\n";
@@ -193,6 +195,11 @@ static void parse_cmd_line_args(int argc, char ** argv) {
             else if (strcmp(opt_name, "in") == 0) {
                 g_standard_input = true;
             }
+            else if (strcmp(opt_name, "server") == 0) {
+                g_server = true;
+                g_standard_input = true;
+                g_input_kind = IN_SMTLIB_2;
+            }
             else if (strcmp(opt_name, "dimacs") == 0) {
                 g_input_kind = IN_DIMACS;
             }
@@ -369,7 +376,10 @@ int STD_CALL main(int argc, char ** argv) {
         switch (g_input_kind) {
         case IN_SMTLIB_2:
             memory::exit_when_out_of_memory(true, "(error \"out of memory\")");
-            return_value = read_smtlib2_commands(g_input_file);
+            if (g_server)
+                return_value = serve_smtlib2_sessions();
+            else
+                return_value = read_smtlib2_commands(g_input_file);
             break;
         case IN_DIMACS:
             return_value = read_dimacs(g_input_file);
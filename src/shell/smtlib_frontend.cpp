@@ -21,8 +21,15 @@ Revision History:
 #include<iostream>
 #include<time.h>
 #include<signal.h>
+#include<condition_variable>
+#include<deque>
+#include<limits>
+#include<sstream>
+#include<thread>
+#include<unordered_map>
 #include "util/timeout.h"
 #include "util/mutex.h"
+#include "util/parallel_executor.h"
 #include "parsers/smt2/smt2parser.h"
 #include "muz/fp/dl_cmds.h"
 #include "cmd_context/extra_cmds/dbg_cmds.h"
@@ -115,12 +122,7 @@ void help_probes() {
         std::cout << "- " << cmd->get_name() << " " << cmd->get_descr() << "\n";
 }
 
-unsigned read_smtlib2_commands(char const * file_name) {
-    g_start_time = clock();
-    register_on_timeout_proc(on_timeout);
-    signal(SIGINT, on_ctrl_c);
-    cmd_context ctx;
-
+static void install_cmds(cmd_context & ctx) {
     ctx.set_solver_factory(mk_smt_strategic_solver_factory());
     install_dl_cmds(ctx);
     install_dbg_cmds(ctx);
@@ -128,6 +130,14 @@ unsigned read_smtlib2_commands(char const * file_name) {
     install_subpaving_cmds(ctx);
     install_opt_cmds(ctx);
     install_smt2_extra_cmds(ctx);
+}
+
+unsigned read_smtlib2_commands(char const * file_name) {
+    g_start_time = clock();
+    register_on_timeout_proc(on_timeout);
+    signal(SIGINT, on_ctrl_c);
+    cmd_context ctx;
+    install_cmds(ctx);
 
     g_cmd_context = &ctx;
     signal(SIGINT, on_ctrl_c);
@@ -151,3 +161,171 @@ unsigned read_smtlib2_commands(char const * file_name) {
     return result ? 0 : 1;
 }
 
+
+namespace {
+    struct smt2_session {
+        std::string              m_id;
+        std::ostringstream       m_out;
+        cmd_context              m_ctx;
+        std::deque<std::string>  m_requests;
+        bool                     m_closed { false };    // no more requests after the queued ones.
+        bool                     m_scheduled { false }; // queued or being served by a worker.
+
+        smt2_session(std::string const & id): m_id(id), m_ctx(false) {
+            install_cmds(m_ctx);
+            m_ctx.set_regular_stream(m_out);
+            m_ctx.set_diagnostic_stream(m_out);
+        }
+
+        std::string run(std::string const & request) {
+            m_out.str(std::string());
+            m_out.clear();
+            std::istringstream in(request);
+            try {
+                parse_smt2_commands(m_ctx, in);
+            }
+            catch (z3_exception & ex) {
+                m_out << "(error \"" << ex.msg() << "\")" << std::endl;
+            }
+            return m_out.str();
+        }
+    };
+
+    class smt2_server {
+        std::mutex                                       m_mux;
+        std::condition_variable                          m_cv;
+        std::mutex                                       m_out_mux;
+        std::unordered_map<std::string, smt2_session*>   m_sessions;
+        std::deque<smt2_session*>                        m_ready;
+        bool                                             m_eof { false };
+
+        void respond(std::string const & id, std::string const & out) {
+            std::lock_guard<std::mutex> lock(m_out_mux);
+            std::cout << id << " " << out.size() << "\n" << out;
+            std::cout.flush();
+        }
+
+        void schedule(smt2_session * s) {
+            if (!s->m_scheduled) {
+                s->m_scheduled = true;
+                m_ready.push_back(s);
+                m_cv.notify_one();
+            }
+        }
+
+        void worker() {
+            std::unique_lock<std::mutex> lock(m_mux);
+            while (true) {
+                m_cv.wait(lock, [&]() { return m_eof || !m_ready.empty(); });
+                if (m_ready.empty())
+                    return;
+                smt2_session * s = m_ready.front();
+                m_ready.pop_front();
+                if (s->m_requests.empty()) {
+                    // only the close request is left.
+                    SASSERT(s->m_closed);
+                    lock.unlock();
+                    respond(s->m_id, std::string());
+                    dealloc(s);
+                    lock.lock();
+                    continue;
+                }
+                std::string request = std::move(s->m_requests.front());
+                s->m_requests.pop_front();
+                lock.unlock();
+                respond(s->m_id, s->run(request));
+                lock.lock();
+                if (s->m_requests.empty() && !s->m_closed)
+                    s->m_scheduled = false;
+                else {
+                    m_ready.push_back(s);
+                    m_cv.notify_one();
+                }
+            }
+        }
+
+        void add_request(std::string const & id, std::string && request) {
+            std::lock_guard<std::mutex> lock(m_mux);
+            auto it = m_sessions.find(id);
+            smt2_session * s = nullptr;
+            if (it != m_sessions.end())
+                s = it->second;
+            else if (request.empty()) {
+                respond(id, std::string());
+                return;
+            }
+            else {
+                s = alloc(smt2_session, id);
+                m_sessions.emplace(id, s);
+            }
+            if (request.empty()) {
+                s->m_closed = true;
+                m_sessions.erase(id);
+            }
+            else
+                s->m_requests.push_back(std::move(request));
+            schedule(s);
+        }
+
+    public:
+        unsigned serve(std::istream & in) {
+            unsigned num_workers = std::max(1u, parallel_executor::max_threads());
+            std::vector<std::thread> workers;
+            for (unsigned i = 0; i < num_workers; ++i)
+                workers.push_back(std::thread([&]() { worker(); }));
+
+            unsigned result = 0;
+            std::string id;
+            size_t n;
+            while (in >> id >> n) {
+                in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::string request(n, '\0');
+                if (n > 0 && !in.read(&request[0], n)) {
+                    std::cerr << "(error \"truncated request of session " << id << "\")" << std::endl;
+                    result = 1;
+                    break;
+                }
+                add_request(id, std::move(request));
+            }
+            if (!in.eof()) {
+                std::cerr << "(error \"malformed request header\")" << std::endl;
+                result = 1;
+            }
+
+            // serve the pending requests, then close the remaining sessions.
+            {
+                std::lock_guard<std::mutex> lock(m_mux);
+                for (auto const & kv : m_sessions) {
+                    kv.second->m_closed = true;
+                    schedule(kv.second);
+                }
+                m_sessions.clear();
+                m_eof = true;
+                m_cv.notify_all();
+            }
+            for (auto & w : workers)
+                w.join();
+            return result;
+        }
+    };
+}
+
+/**
+   \brief Serve independent SMT 2 sessions over standard input and output.
+
+   A request is a header line "<session> <n>" followed by n bytes of SMT 2
+   commands. The commands are executed in the context of the session,
+   which is created by its first request and kept until a request with
+   n = 0 closes it. Every request is answered by "<session> <n>" followed
+   by the n bytes of output of its commands.
+
+   Requests of the same session are executed in order, requests of
+   different sessions are executed concurrently by a pool of
+   parallel_executor::max_threads() workers. Resource limits
+   (:reproducible-resource-limit) and statistics (get-info :all-statistics)
+   are per session.
+*/
+unsigned serve_smtlib2_sessions() {
+    smt2_server server;
+    return server.serve(std::cin);
+}
@@ -20,6 +20,7 @@ Revision History:
 
 unsigned read_smtlib_file(char const * benchmark_file);
 unsigned read_smtlib2_commands(char const * command_file);
+unsigned serve_smtlib2_sessions();
 void help_tactics();
 void help_probes();
 void help_tactic(char const* name);
@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 #include "util/warning.h"
+#include "util/profiler.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_pp.h"
 #include "ast/for_each_expr.h"
@@ -42,6 +43,7 @@ asserted_formulas::asserted_formulas(ast_manager & m, smt_params & sp, params_re
     m_bv_sharing(m),
     m_inconsistent(false),
     m_has_quantifiers(false),
+    m_depth_pinned(m),
     m_reduce_asserted_formulas(*this),
     m_distribute_forall(*this),
     m_pattern_inference(*this),
@@ -229,11 +231,13 @@ void asserted_formulas::pop_scope(unsigned num_scopes) {
     m_formulas.shrink(s.m_formulas_lim);
     m_qhead    = s.m_formulas_lim;
     m_scopes.shrink(new_lvl);
+    reset_depth();
     flush_cache();
     TRACE("asserted_formulas_scopes", tout << "after pop " << num_scopes << "\n";);
 }
 
 void asserted_formulas::reset() {
+    reset_depth();
     m_defined_names.reset();
     m_qhead = 0;
     m_formulas.reset();
@@ -264,6 +268,7 @@ void asserted_formulas::reduce() {
         return;
     if (!m_has_quantifiers && !m_smt_params.m_preprocess)
         return;
+    scoped_profile _profile("smt.preprocess");
     if (m_macro_manager.has_macros())
         invoke(m_find_macros);
 
@@ -317,7 +322,10 @@ unsigned asserted_formulas::get_formulas_last_level() const {
 bool asserted_formulas::invoke(simplify_fmls& s) {
     if (!s.should_apply()) return true;
     IF_VERBOSE(10, verbose_stream() << "(smt." << s.id() << ")\n";);
-    s();
+    {
+        scoped_profile _profile(s.id());
+        s();
+    }
     IF_VERBOSE(10000, verbose_stream() << "total size: " << get_total_size() << "\n";);
     TRACE("reduce_step_ll", ast_mark visited; display_ll(tout, visited););
     CASSERT("well_sorted",check_well_sorted());
@@ -514,7 +522,6 @@ void asserted_formulas::commit() {
 
 void asserted_formulas::commit(unsigned new_qhead) {
     m_macro_manager.mark_forbidden(new_qhead - m_qhead, m_formulas.c_ptr() + m_qhead);
-    m_expr2depth.reset();
     for (unsigned i = m_qhead; i < new_qhead; ++i) {
         justified_expr const& j = m_formulas[i];
         update_substitution(j.get_fml(), j.get_proof());
@@ -528,7 +535,6 @@ void asserted_formulas::propagate_values() {
     unsigned num_prop = 0;
     unsigned delta_prop = m_formulas.size();
     while (!inconsistent() && m_formulas.size()/20 < delta_prop) {
-        m_expr2depth.reset();
         m_scoped_substitution.push();
         unsigned prop = num_prop;
         TRACE("propagate_values", display(tout << "before:\n"););
@@ -539,7 +545,6 @@ void asserted_formulas::propagate_values() {
         }
         flush_cache();
         m_scoped_substitution.pop(1);
-        m_expr2depth.reset();
         m_scoped_substitution.push();
         TRACE("propagate_values", tout << "middle:\n"; display(tout););
         i = sz;
@@ -677,6 +682,7 @@ void asserted_formulas::compute_depth(expr* e) {
         }
         todo.pop_back();
         m_expr2depth.insert(e, d + 1);
+        m_depth_pinned.push_back(e);
     }
 }
 
@@ -62,7 +62,8 @@ class asserted_formulas {
         bool                    m_inconsistent_old;
     };
     svector<scope>              m_scopes;
-    obj_map<expr, unsigned>     m_expr2depth;
+    obj_map<expr, unsigned>     m_expr2depth;    // depth is structural, so entries stay valid across rounds and checks.
+    expr_ref_vector             m_depth_pinned;  // keeps the keys of m_expr2depth alive.
 
     class simplify_fmls {
     protected:
@@ -231,6 +232,7 @@ class asserted_formulas {
     bool update_substitution(expr* n, proof* p);
     bool is_gt(expr* lhs, expr* rhs);
     void compute_depth(expr* e);
+    void reset_depth() { m_expr2depth.reset(); m_depth_pinned.reset(); }
     unsigned depth(expr* e) { return m_expr2depth[e]; }
 
     void init(unsigned num_formulas, expr * const * formulas, proof * const * prs);
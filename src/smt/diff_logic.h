@@ -204,6 +204,17 @@ class dl_graph {
     unsigned                m_last_enabled_edge;
     edge_id_vector          m_enabled_edges;
 
+    // Goldberg-Radzik relaxation used by enable_edges
+    struct gr_frame {
+        dl_var   m_var;
+        unsigned m_idx;      // next out edge to visit
+        edge_id  m_in_edge;  // edge used to reach m_var
+    };
+    svector<char>           m_gr_state;  // per var: 0 not visited, 1 on the DFS stack, 2 finished.
+    dl_var_vector           m_gr_roots;
+    dl_var_vector           m_gr_order;
+    svector<gr_frame>       m_gr_stack;
+
     // SCC for cheap equality propagation --
     svector<char>           m_unfinished_set; // per var
     int_vector              m_dfs_time;       // per var
@@ -432,6 +443,171 @@ private:
         }
     }
 
+    // The labels of the batch relaxation are stored in m_gamma for the variables marked as DL_FOUND,
+    // the label of all other variables is 0.
+    void gr_touch(dl_var v) {
+        if (m_mark[v] == DL_UNMARKED) {
+            m_mark[v]   = DL_FOUND;
+            m_gamma[v].reset();
+            m_parent[v] = null_edge_id;
+            m_visited.push_back(v);
+        }
+    }
+
+    // weight of e relative to the current assignment and labels.
+    void gr_reduced_cost(edge const & e, numeral & r) {
+        dl_var s = e.get_source(), t = e.get_target();
+        set_gamma(e, r);
+        if (m_mark[s] != DL_UNMARKED)
+            r += m_gamma[s];
+        if (m_mark[t] != DL_UNMARKED)
+            r -= m_gamma[t];
+    }
+
+    // Store in m_gr_order, in post-order, the variables reachable from m_gr_roots
+    // through edges of negative reduced cost. A cycle of such edges is negative, 
+    // in this case its edges are stored in m_parent and the edge closing it is returned.
+    edge_id gr_topological_sort() {
+        numeral r;
+        m_gr_order.reset();
+        for (dl_var root : m_gr_roots) {
+            if (m_gr_state[root] != 0)
+                continue;
+            m_gr_state[root] = 1;
+            m_gr_stack.push_back({ root, 0, null_edge_id });
+            while (!m_gr_stack.empty()) {
+                gr_frame & f = m_gr_stack.back();
+                dl_var v = f.m_var;
+                edge_id_vector const & out = m_out_edges[v];
+                bool pushed = false;
+                while (!pushed && f.m_idx < out.size()) {
+                    edge_id e_id = out[f.m_idx++];
+                    edge const & e = m_edges[e_id];
+                    if (!e.is_enabled())
+                        continue;
+                    gr_reduced_cost(e, r);
+                    if (!r.is_neg())
+                        continue;
+                    dl_var t = e.get_target();
+                    if (m_gr_state[t] == 1) {
+                        unsigned i = m_gr_stack.size();
+                        while (m_gr_stack[--i].m_var != t) 
+                            m_parent[m_gr_stack[i].m_var] = m_gr_stack[i].m_in_edge;
+                        m_parent[t] = e_id;
+                        for (gr_frame const & f2 : m_gr_stack) 
+                            m_gr_state[f2.m_var] = 0;
+                        for (dl_var w : m_gr_order) 
+                            m_gr_state[w] = 0;
+                        m_gr_stack.reset();
+                        return e_id;
+                    }
+                    if (m_gr_state[t] == 0) {
+                        m_gr_state[t] = 1;
+                        m_gr_stack.push_back({ t, 0, e_id });
+                        pushed = true;
+                    }
+                }
+                if (!pushed) {
+                    m_gr_state[v] = 2;
+                    m_gr_order.push_back(v);
+                    m_gr_stack.pop_back();
+                }
+            }
+        }
+        return null_edge_id;
+    }
+
+    // Return an edge on a cycle of m_parent reachable from v, or null_edge_id.
+    edge_id gr_find_parent_cycle(dl_var v) {
+        dl_var_vector path;
+        edge_id result = null_edge_id;
+        while (m_mark[v] != DL_UNMARKED && m_parent[v] != null_edge_id) {
+            if (m_gr_state[v] == 1) {
+                result = m_parent[v];
+                break;
+            }
+            m_gr_state[v] = 1;
+            path.push_back(v);
+            v = m_edges[m_parent[v]].get_source();
+        }
+        for (dl_var w : path) 
+            m_gr_state[w] = 0;
+        return result;
+    }
+
+    // Restore feasibility after several edges were enabled, using passes of 
+    // Bellman-Ford relaxation in topological order (Goldberg-Radzik).
+    // m_gr_roots contains the sources of the infeasible edges.
+    bool make_feasible_batch() {
+        SASSERT(m_visited.empty());
+        numeral r;
+        edge_id cycle_edge = null_edge_id;
+        unsigned num_passes = 0;
+        for (dl_var v : m_gr_roots)
+            gr_touch(v);
+        while (!m_gr_roots.empty()) {
+            if (++num_passes > m_assignment.size()) {
+                // labels keep decreasing, the relaxation went around a negative cycle.
+                for (dl_var v : m_gr_roots) {
+                    cycle_edge = gr_find_parent_cycle(v);
+                    if (cycle_edge != null_edge_id)
+                        break;
+                }
+                if (cycle_edge != null_edge_id)
+                    break;
+            }
+            cycle_edge = gr_topological_sort();
+            if (cycle_edge != null_edge_id)
+                break;
+            m_gr_roots.reset();
+            for (unsigned i = m_gr_order.size(); i-- > 0; ) {
+                dl_var u = m_gr_order[i];
+                m_gr_state[u] = 0;
+                ++m_stats.m_propagation_cost;
+                for (edge_id e_id : m_out_edges[u]) {
+                    edge const & e = m_edges[e_id];
+                    if (!e.is_enabled())
+                        continue;
+                    gr_reduced_cost(e, r);
+                    if (!r.is_neg())
+                        continue;
+                    dl_var t = e.get_target();
+                    gr_touch(t);
+                    m_gamma[t]  += r;
+                    m_parent[t]  = e_id;
+                    m_gr_roots.push_back(t);
+                }
+            }
+        }
+        m_gr_roots.reset();
+        if (cycle_edge == null_edge_id) {
+            for (dl_var v : m_visited)
+                m_assignment[v] += m_gamma[v];
+            reset_marks();
+            SASSERT(is_feasible_dbg());
+            return true;
+        }
+        // The assignment was not changed, so the cycle contains an infeasible edge.
+        // traverse_neg_cycle starts from it.
+        edge_id last_id = cycle_edge;
+        edge_id e_id = cycle_edge;
+        numeral weight;
+        do {
+            if (!is_feasible(m_edges[e_id]))
+                last_id = e_id;
+            weight += m_edges[e_id].get_weight();
+            e_id = m_parent[m_edges[e_id].get_source()];
+        }
+        while (e_id != cycle_edge);
+        SASSERT(weight.is_neg());
+        SASSERT(!is_feasible(m_edges[last_id]));
+        reset_marks();
+        m_gamma[m_edges[last_id].get_source()] = weight;
+        m_last_enabled_edge = last_id;
+        SASSERT(check_gamma(last_id));
+        return false;
+    }
+
     edge const* find_relaxed_edge(edge const* e, numeral & gamma) {
         SASSERT(gamma.is_neg());
         dl_var src = e->get_source();
@@ -481,6 +657,7 @@ public:
             m_gamma      .push_back(numeral());
             m_mark       .push_back(DL_UNMARKED);
             m_parent     .push_back(null_edge_id);
+            m_gr_state   .push_back(0);
         }
         if (static_cast<unsigned>(v) >= m_heap.get_bounds()) {
             m_heap.set_bounds(v+1);
@@ -530,6 +707,41 @@ public:
     }
 
 
+    // Enable several edges at once. Return false if the resultant graph has a 
+    // negative cycle, which can be extracted using traverse_neg_cycle.
+    // If more than one of the edges is infeasible, the assignment is repaired 
+    // in a single batch relaxation instead of one search per edge.
+    bool enable_edges(unsigned num_edges, edge_id const * ids) {
+        SASSERT(is_feasible_dbg());
+        unsigned old_sz = m_enabled_edges.size();
+        for (unsigned i = 0; i < num_edges; ++i) {
+            edge & e = m_edges[ids[i]];
+            if (!e.is_enabled()) {
+                e.enable(m_timestamp);
+                m_last_enabled_edge = ids[i];
+                m_timestamp++;
+                m_enabled_edges.push_back(ids[i]);
+            }
+        }
+        edge_id infeasible = null_edge_id;
+        m_gr_roots.reset();
+        for (unsigned i = old_sz; i < m_enabled_edges.size(); ++i) {
+            edge const & e = m_edges[m_enabled_edges[i]];
+            if (!is_feasible(e)) {
+                infeasible = m_enabled_edges[i];
+                m_gr_roots.push_back(e.get_source());
+            }
+        }
+        if (m_gr_roots.empty())
+            return true;
+        if (m_gr_roots.size() == 1) {
+            m_gr_roots.reset();
+            m_last_enabled_edge = infeasible;
+            return make_feasible(infeasible);
+        }
+        return make_feasible_batch();
+    }
+
     // This method should only be invoked when add_edge returns false.
     // That is, there is a negative cycle in the graph.
     // It will apply the functor f on every explanation attached to the edges
@@ -1181,6 +1393,7 @@ public:
         m_gamma             .reset();
         m_mark              .reset();
         m_parent            .reset();
+        m_gr_state          .reset();
         m_visited           .reset();
         m_heap              .reset();
         m_enabled_edges     .reset();
@@ -1492,7 +1705,7 @@ private:
         assignment    m_delta;
         int_vector    m_visited;
         int_vector    m_parent;
-        heap<hp_lt>   m_heap;
+        heap<hp_lt, 4> m_heap;
         unsigned      m_num_edges;
         dfs_state(char_vector& mark): m_heap(1024, hp_lt(m_delta, mark)), m_num_edges(0) {}
 
@@ -185,6 +185,7 @@ namespace smt {
 
     void dyn_ack_manager::init_search_eh() {
         m_app_pair2num_occs.reset();
+        m_sketch.reset();
         reset_app_pairs();
         m_to_instantiate.reset();
         m_qhead = 0;
@@ -192,11 +193,26 @@ namespace smt {
         m_num_propagations_since_last_gc = 0;
 
         m_triple.m_app2num_occs.reset();
+        m_triple.m_sketch.reset();
         reset_app_triples();
         m_triple.m_to_instantiate.reset();
         m_triple.m_qhead = 0;
     }
 
+    /**
+       \brief Count an occurrence of a candidate that is not tracked exactly yet.
+       Candidates are only tracked exactly once they occurred in half of the 
+       threshold conflicts according to the sketch, so the tables do not grow
+       with the many candidates that are used once or twice.
+    */
+    bool dyn_ack_manager::admit(count_min_sketch& sketch, unsigned key, unsigned& num_occs) {
+        unsigned est = sketch.inc(key);
+        if (2 * est < m_params.m_dack_threshold)
+            return false;
+        num_occs = std::min(est, m_params.m_dack_threshold);
+        return true;
+    }
+
     void dyn_ack_manager::cg_eh(app * n1, app * n2) {
         SASSERT(n1->get_decl() == n2->get_decl());
         SASSERT(n1->get_num_args() == n2->get_num_args());
@@ -215,12 +231,14 @@ namespace smt {
             TRACE("dyn_ack", tout << "used_cg_eh:\n" << mk_pp(n1, m) << "\n" << mk_pp(n2, m) << "\nnum_occs: " << num_occs << "\n";);
             num_occs++;
         }
-        else {
-            num_occs = 1;
+        else if (admit(m_sketch, hash_u_u(n1->get_id(), n2->get_id()), num_occs)) {
             m.inc_ref(n1);
             m.inc_ref(n2);
             m_app_pairs.push_back(p);
         }
+        else {
+            return;
+        }
         SASSERT(num_occs > 0);
         m_app_pair2num_occs.insert(n1, n2, num_occs);
 #ifdef Z3DEBUG
@@ -251,13 +269,15 @@ namespace smt {
                   << mk_pp(r, m) << "\n" << "\nnum_occs: " << num_occs << "\n";);
             num_occs++;
         }
-        else {
-            num_occs = 1;
+        else if (admit(m_triple.m_sketch, combine_hash(hash_u_u(n1->get_id(), n2->get_id()), hash_u(r->get_id())), num_occs)) {
             m.inc_ref(n1);
             m.inc_ref(n2);
             m.inc_ref(r);
             m_triple.m_apps.push_back(tr);
         }
+        else {
+            return;
+        }
         SASSERT(num_occs > 0);
         m_triple.m_app2num_occs.insert(n1, n2, r, num_occs);
 #ifdef Z3DEBUG
@@ -298,6 +318,7 @@ namespace smt {
         unsigned num_deleted = 0;
         m_to_instantiate.reset();
         m_qhead = 0;
+        m_sketch.decay(m_params.m_dack_gc_inv_decay);
         svector<app_pair>::iterator it  = m_app_pairs.begin();
         svector<app_pair>::iterator end = m_app_pairs.end();
         svector<app_pair>::iterator it2 = it;
@@ -524,6 +545,7 @@ namespace smt {
         unsigned num_deleted = 0;
         m_triple.m_to_instantiate.reset();
         m_triple.m_qhead = 0;
+        m_triple.m_sketch.decay(m_params.m_dack_gc_inv_decay);
         svector<app_triple>::iterator it  = m_triple.m_apps.begin();
         svector<app_triple>::iterator end = m_triple.m_apps.end();
         svector<app_triple>::iterator it2 = it;
@@ -23,6 +23,7 @@ Revision History:
 #include "util/obj_hashtable.h"
 #include "util/obj_pair_hashtable.h"
 #include "util/obj_triple_hashtable.h"
+#include "util/count_min_sketch.h"
 #include "smt/smt_clause.h"
 
 namespace smt {
@@ -53,6 +54,7 @@ namespace smt {
         unsigned                                   m_num_propagations_since_last_gc;
         app_pair_set                               m_instantiated;
         clause2app_pair                            m_clause2app_pair;
+        count_min_sketch                           m_sketch;  // occurrences of pairs not yet in m_app_pair2num_occs
 
         struct _triple {
             app_triple2num_occs                    m_app2num_occs;
@@ -63,6 +65,7 @@ namespace smt {
             unsigned                               m_num_propagations_since_last_gc;
             app_triple_set                         m_instantiated;
             clause2app_triple                      m_clause2apps;
+            count_min_sketch                       m_sketch;
         };
         _triple                                    m_triple;
         
@@ -80,6 +83,7 @@ namespace smt {
         void instantiate(app * n1, app * n2, app* r);
         void reset_app_triples();
         void gc_triples();
+        bool admit(count_min_sketch& sketch, unsigned key, unsigned& num_occs);
         
     public:
         dyn_ack_manager(context & ctx, dyn_ack_params & p);
@@ -20,6 +20,7 @@ Revision History:
 
 #include "util/pool.h"
 #include "util/trail.h"
+#include "util/obj_pair_hashtable.h"
 #include "util/stopwatch.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -1857,6 +1858,7 @@ namespace {
         enode_vector        m_registers;
         enode_vector        m_bindings;
         enode_vector        m_args;
+        enode_vector        m_batch;
         backtrack_stack     m_backtrack_stack;
         unsigned            m_top;
         const instruction * m_pc;
@@ -2022,32 +2024,93 @@ namespace {
                 m_backtrack_stack.resize(t->get_num_choices());
         }
 
+        /**
+           \brief Remove the candidates that fail the straight-line prefix of the code tree t.
+
+           The prefix is the initialization instruction followed by the COMPARE, CHECK and
+           filter instructions that precede the first choice point. These instructions only
+           read the registers set by the initialization instruction, and a failure at the 
+           top-level means the candidate produces no match. Each instruction is evaluated over
+           the whole batch before execute_core is invoked on the remaining candidates, so the
+           instruction is dispatched once per batch instead of once per candidate.
+        */
+        void filter_batch(code_tree * t, enode_vector & batch) {
+            unsigned num_args = t->expected_num_args();
+            unsigned j = 0;
+            for (enode* app : batch) 
+                if (app->get_num_args() == num_args)
+                    batch[j++] = app;
+            batch.shrink(j);
+            auto reg = [&](enode* app, unsigned r) { return r == 0 ? app : app->get_arg(r - 1); };
+            for (instruction const* pc = t->get_root()->m_next; pc && !batch.empty(); pc = pc->m_next) {
+                j = 0;
+                switch (pc->m_opcode) {
+                case COMPARE: {
+                    unsigned r1 = static_cast<const compare *>(pc)->m_reg1;
+                    unsigned r2 = static_cast<const compare *>(pc)->m_reg2;
+                    if (r1 > num_args || r2 > num_args)
+                        return;
+                    for (enode* app : batch) 
+                        if (reg(app, r1)->get_root() == reg(app, r2)->get_root())
+                            batch[j++] = app;
+                    break;
+                }
+                case CHECK: {
+                    unsigned r = static_cast<const check *>(pc)->m_reg;
+                    enode* n = static_cast<const check *>(pc)->m_enode->get_root();
+                    if (r > num_args)
+                        return;
+                    for (enode* app : batch) 
+                        if (reg(app, r)->get_root() == n)
+                            batch[j++] = app;
+                    break;
+                }
+                case CFILTER:
+                case FILTER: 
+                case PFILTER: {
+                    filter const* f = static_cast<const filter *>(pc);
+                    unsigned r = f->m_reg;
+                    bool plbls = pc->m_opcode == PFILTER;
+                    if (r > num_args)
+                        return;
+                    for (enode* app : batch) {
+                        enode* n = reg(app, r)->get_root();
+                        if (!f->m_lbl_set.empty_intersection(plbls ? n->get_plbls() : n->get_lbls()))
+                            batch[j++] = app;
+                    }
+                    break;
+                }
+                default:
+                    return;
+                }
+                batch.shrink(j);
+            }
+        }
+
         void execute(code_tree * t) {
             TRACE("trigger_bug", tout << "execute for code tree:\n"; t->display(tout););
             init(t);
+            m_batch.reset();
             if (t->filter_candidates()) {
                 for (enode* app : t->get_candidates()) {
-                    TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_owner(), m) << "\n";);
                     if (!app->is_marked() && app->is_cgr()) {
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
-                            return;
                         app->set_mark();
+                        m_batch.push_back(app);
                     }
                 }
-                for (enode* app : t->get_candidates()) {
-                    if (app->is_marked())
-                        app->unset_mark();
-                }
+                for (enode* app : m_batch) 
+                    app->unset_mark();
             }
             else {
-                for (enode* app : t->get_candidates()) {
-                    TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_owner(), m) << "\n";);
-                    if (app->is_cgr()) {
-                        TRACE("trigger_bug", tout << "is_cgr\n";);
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
-                            return;
-                    }
-                }
+                for (enode* app : t->get_candidates()) 
+                    if (app->is_cgr()) 
+                        m_batch.push_back(app);
+            }
+            filter_batch(t, m_batch);
+            for (enode* app : m_batch) {
+                TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_owner(), m) << "\n";);
+                if (m_context.resource_limits_exceeded() || !execute_core(t, app))
+                    return;
             }
         }
 
@@ -3038,6 +3101,7 @@ namespace {
         code_tree *    m_code;
         approx_set     m_filter;
         path_tree *    m_sibling;
+        path_tree *    m_next_same_label; // next sibling with the same label
         path_tree *    m_first_child;
         enode_vector * m_todo; // temporary field used to collect candidates
 #ifdef _PROFILE_PATH_TREE
@@ -3056,6 +3120,7 @@ namespace {
             m_code(nullptr),
             m_filter(h(p->m_label)),
             m_sibling(nullptr),
+            m_next_same_label(nullptr),
             m_first_child(nullptr),
             m_todo(nullptr) {
 #ifdef _PROFILE_PATH_TREE
@@ -3066,6 +3131,10 @@ namespace {
 #endif
         }
 
+        unsigned hash() const {
+            return static_cast<unsigned>(reinterpret_cast<size_t>(this) >> 3);
+        }
+
         void display(std::ostream & out, unsigned indent) {
             path_tree * curr = this;
             while (curr != nullptr) {
@@ -3087,6 +3156,26 @@ namespace {
 
     typedef std::pair<path_tree *, path_tree *> path_tree_pair;
 
+    /**
+       \brief Exact index (head, f) -> first sibling of head labeled with f.
+       The siblings with the same label are linked using m_next_same_label.
+       The approximated filter stored at head may contain false positives, this index
+       is used to avoid traversing the siblings that cannot match a parent.
+    */
+    typedef obj_pair_map<path_tree, func_decl, path_tree *> path_index;
+
+    class mam_impl;
+
+    class insert_path_index_trail : public trail<mam_impl> {
+        path_index & m_index;
+        path_tree *  m_head;
+        func_decl *  m_lbl;
+    public:
+        insert_path_index_trail(path_index & index, path_tree * head, func_decl * lbl):
+            m_index(index), m_head(head), m_lbl(lbl) {}
+        void undo(mam_impl & ctx) override { m_index.erase(m_head, m_lbl); }
+    };
+
     // ------------------------------------
     //
     // Matching Abstract Machine Implementation
@@ -3123,6 +3212,7 @@ namespace {
         region &                    m_region;
         region                      m_tmp_region;
         path_tree_pair              m_pp[APPROX_SET_CAPACITY][APPROX_SET_CAPACITY];
+        path_index                  m_path_index;
         path_tree *                 m_pc[APPROX_SET_CAPACITY][APPROX_SET_CAPACITY];
         pool<enode_vector>          m_pool;
 
@@ -3269,6 +3359,11 @@ namespace {
             m_compiler.insert(t->m_code, qa, mp, pat_idx, false);
         }
 
+        void add_path_index(path_tree * head, path_tree * t) {
+            m_path_index.insert(head, t->m_label, t);
+            m_trail_stack.push(insert_path_index_trail(m_path_index, head, t->m_label));
+        }
+
         path_tree * mk_path_tree(path * p, quantifier * qa, app * mp) {
             SASSERT(m.is_pattern(mp));
             SASSERT(p != nullptr);
@@ -3278,6 +3373,7 @@ namespace {
             path_tree * prev = nullptr;
             while (p != nullptr) {
                 curr = new (m_region) path_tree(p, m_lbl_hasher);
+                add_path_index(curr, curr);
                 if (prev)
                     prev->m_first_child = curr;
                 if (!head)
@@ -3294,10 +3390,12 @@ namespace {
             SASSERT(m.is_pattern(mp));
             path_tree * head = t;
             path_tree * prev_sibling = nullptr;
+            path_tree * last_same_label = nullptr;
             bool found_label = false;
             while (t != nullptr) {
                 if (t->m_label == p->m_label) {
                     found_label = true;
+                    last_same_label = t;
                     if (t->m_arg_idx == p->m_arg_idx &&
                         t->m_ground_arg == p->m_ground_arg &&
                         t->m_ground_arg_idx == p->m_ground_arg_idx
@@ -3336,7 +3434,12 @@ namespace {
             }
             m_trail_stack.push(set_ptr_trail<mam_impl, path_tree>(prev_sibling->m_sibling));
             prev_sibling->m_sibling = mk_path_tree(p, qa, mp);
-            if (!found_label) {
+            if (found_label) {
+                m_trail_stack.push(set_ptr_trail<mam_impl, path_tree>(last_same_label->m_next_same_label));
+                last_same_label->m_next_same_label = prev_sibling->m_sibling;
+            }
+            else {
+                add_path_index(head, prev_sibling->m_sibling);
                 m_trail_stack.push(value_trail<mam_impl, approx_set>(head->m_filter));
                 head->m_filter.insert(m_lbl_hasher(p->m_label));
             }
@@ -3611,14 +3714,16 @@ namespace {
                         enode * curr_parent_cg     = curr_parent->get_cg();
                         TRACE("mam_path_tree", tout << "processing parent:\n" << mk_pp(curr_parent->get_owner(), m) << "\n";);
                         TRACE("mam_path_tree", tout << "parent is marked: " << curr_parent->is_marked() << "\n";);
+                        path_tree * curr_tree = nullptr;
                         if (filter.may_contain(m_lbl_hasher(lbl)) &&
+                            m_path_index.find(t, lbl, curr_tree) &&
                             !curr_parent->is_marked() &&
                             (curr_parent_cg == curr_parent || !is_eq(curr_parent_cg, curr_parent_root)) &&
                             m_context.is_relevant(curr_parent)
                             ) {
-                            path_tree * curr_tree = t;
                             while (curr_tree) {
-                                if (curr_tree->m_label == lbl &&
+                                SASSERT(curr_tree->m_label == lbl);
+                                if (
                                     // Starting at Z3 3.0, some associative operators (e.g., + and *) are represented using n-ary applications.
                                     // In this cases, we say the declarations is is_flat_assoc().
                                     // The MAM was implemented in Z3 2.0 when the following invariant was true:
@@ -3653,7 +3758,7 @@ namespace {
                                         }
                                     }
                                 }
-                                curr_tree = curr_tree->m_sibling;
+                                curr_tree = curr_tree->m_next_same_label;
                             }
                             curr_parent->set_mark();
                             to_unmark->push_back(curr_parent);
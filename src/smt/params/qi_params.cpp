@@ -29,8 +29,11 @@ void qi_params::updt_params(params_ref const & _p) {
     m_mbqi_force_template = p.mbqi_force_template();
     m_mbqi_id = p.mbqi_id();
     m_qi_profile = p.qi_profile();
+    m_qi_feedback = p.qi_feedback();
     m_qi_profile_freq = p.qi_profile_freq();
     m_qi_max_instances = p.qi_max_instances();
+    m_qi_max_instances_per_quantifier = p.qi_max_instances_per_quantifier();
+    m_qi_max_rate = p.qi_max_rate();
     m_qi_eager_threshold = p.qi_eager_threshold();
     m_qi_lazy_threshold = p.qi_lazy_threshold();
     m_qi_cost = p.qi_cost();
@@ -48,11 +51,14 @@ void qi_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_qi_max_eager_multipatterns);
     DISPLAY_PARAM(m_qi_max_lazy_multipattern_matching);
     DISPLAY_PARAM(m_qi_profile);
+    DISPLAY_PARAM(m_qi_feedback);
     DISPLAY_PARAM(m_qi_profile_freq);
     DISPLAY_PARAM(m_qi_quick_checker);
     DISPLAY_PARAM(m_qi_lazy_quick_checker);
     DISPLAY_PARAM(m_qi_promote_unsat);
     DISPLAY_PARAM(m_qi_max_instances);
+    DISPLAY_PARAM(m_qi_max_instances_per_quantifier);
+    DISPLAY_PARAM(m_qi_max_rate);
     DISPLAY_PARAM(m_qi_lazy_instantiation);
     DISPLAY_PARAM(m_qi_conservative_final_check);
     DISPLAY_PARAM(m_mbqi);
@@ -35,11 +35,14 @@ struct qi_params {
     unsigned           m_qi_max_eager_multipatterns;
     unsigned           m_qi_max_lazy_multipattern_matching;
     bool               m_qi_profile;
+    bool               m_qi_feedback;
     unsigned           m_qi_profile_freq;
     quick_checker_mode m_qi_quick_checker;
     bool               m_qi_lazy_quick_checker;
     bool               m_qi_promote_unsat;
     unsigned           m_qi_max_instances;
+    unsigned           m_qi_max_instances_per_quantifier;
+    unsigned           m_qi_max_rate;
     bool               m_qi_lazy_instantiation;
     bool               m_qi_conservative_final_check;
 
@@ -84,11 +87,14 @@ struct qi_params {
         m_qi_max_eager_multipatterns(0),
         m_qi_max_lazy_multipattern_matching(2),
         m_qi_profile(false),
+        m_qi_feedback(false),
         m_qi_profile_freq(UINT_MAX),
         m_qi_quick_checker(MC_NO),
         m_qi_lazy_quick_checker(true),
         m_qi_promote_unsat(true),
         m_qi_max_instances(UINT_MAX),
+        m_qi_max_instances_per_quantifier(UINT_MAX),
+        m_qi_max_rate(0),
         m_qi_lazy_instantiation(false),
         m_qi_conservative_final_check(false),
         m_mbqi(true), // enabled by default
@@ -25,13 +25,16 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_auto_config = p.auto_config() && gparams::get_value("auto_config") == "true"; // auto-config is not scoped by smt in gparams.
     m_random_seed = p.random_seed();
     m_relevancy_lvl = p.relevancy();
+    m_lazy_ite = p.lazy_ite();
     m_ematching   = p.ematching();
     m_induction   = p.induction();
     m_clause_proof = p.clause_proof();
+    m_restore_var_state = p.restore_var_state();
     m_phase_selection = static_cast<phase_selection>(p.phase_selection());
     if (m_phase_selection > PS_THEORY) throw default_exception("illegal phase selection numeral");
     m_phase_caching_on = p.phase_caching_on();
     m_phase_caching_off = p.phase_caching_off();
+    m_deferred_lemma_minimization = p.minimize_lemmas_deferred();
     m_restart_strategy = static_cast<restart_strategy>(p.restart_strategy());
     if (m_restart_strategy > RS_ARITHMETIC) throw default_exception("illegal restart strategy numeral");
     m_restart_factor = p.restart_factor();
@@ -99,6 +102,7 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_binary_clause_opt);
     DISPLAY_PARAM(m_relevancy_lvl);
     DISPLAY_PARAM(m_relevancy_lemma);
+    DISPLAY_PARAM(m_lazy_ite);
     DISPLAY_PARAM(m_random_seed);
     DISPLAY_PARAM(m_random_var_freq);
     DISPLAY_PARAM(m_inv_decay);
@@ -108,6 +112,7 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_phase_caching_on);
     DISPLAY_PARAM(m_phase_caching_off);
     DISPLAY_PARAM(m_minimize_lemmas);
+    DISPLAY_PARAM(m_deferred_lemma_minimization);
     DISPLAY_PARAM(m_max_conflicts);
     DISPLAY_PARAM(m_cube_depth);
     DISPLAY_PARAM(m_threads);
@@ -120,6 +125,7 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_ematching);
     DISPLAY_PARAM(m_induction);
     DISPLAY_PARAM(m_clause_proof);
+    DISPLAY_PARAM(m_restore_var_state);
 
     DISPLAY_PARAM(m_case_split_strategy);
     DISPLAY_PARAM(m_rel_case_split_order);
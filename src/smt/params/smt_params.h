@@ -69,7 +69,9 @@ enum case_split_strategy {
     CS_RELEVANCY, // case split based on relevancy
     CS_RELEVANCY_ACTIVITY, // case split based on relevancy and activity
     CS_RELEVANCY_GOAL, // based on relevancy and the current goal
-    CS_ACTIVITY_THEORY_AWARE_BRANCHING // activity-based case split, but theory solvers can manipulate activity
+    CS_ACTIVITY_THEORY_AWARE_BRANCHING, // activity-based case split, but theory solvers can manipulate activity
+    CS_CHB, // case split based on conflict history (CHB)
+    CS_CHB_ACTIVITY_SWITCH // alternate between CHB and activity by restart phase
 };
 
 struct smt_params : public preprocessor_params,
@@ -90,6 +92,7 @@ struct smt_params : public preprocessor_params,
     bool             m_binary_clause_opt;
     unsigned         m_relevancy_lvl;
     bool             m_relevancy_lemma;
+    bool             m_lazy_ite;
     unsigned         m_random_seed;
     double           m_random_var_freq;
     double           m_inv_decay;
@@ -99,6 +102,7 @@ struct smt_params : public preprocessor_params,
     unsigned         m_phase_caching_on;
     unsigned         m_phase_caching_off;
     bool             m_minimize_lemmas;
+    bool             m_deferred_lemma_minimization;
     unsigned         m_max_conflicts;
     unsigned         m_restart_max;
     unsigned         m_cube_depth;
@@ -112,6 +116,7 @@ struct smt_params : public preprocessor_params,
     bool             m_ematching;
     bool             m_induction;
     bool             m_clause_proof;
+    bool             m_restore_var_state;
 
     // -----------------------------------
     //
@@ -246,6 +251,7 @@ struct smt_params : public preprocessor_params,
         m_binary_clause_opt(true),
         m_relevancy_lvl(2),
         m_relevancy_lemma(false),
+        m_lazy_ite(false),
         m_random_seed(0),
         m_random_var_freq(0.01),
         m_inv_decay(1.052),
@@ -255,6 +261,7 @@ struct smt_params : public preprocessor_params,
         m_phase_caching_on(700),
         m_phase_caching_off(100),
         m_minimize_lemmas(true),
+        m_deferred_lemma_minimization(false),
         m_max_conflicts(UINT_MAX),
         m_cube_depth(1),
         m_threads(1),
@@ -267,6 +274,7 @@ struct smt_params : public preprocessor_params,
         m_ematching(true),
         m_induction(false),
         m_clause_proof(false),
+        m_restore_var_state(false),
         m_case_split_strategy(case_split_strategy::CS_ACTIVITY_DELAY_NEW),
         m_rel_case_split_order(0),
         m_lookahead_diseq(false),
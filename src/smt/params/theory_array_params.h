@@ -35,6 +35,7 @@ struct theory_array_params {
     bool            m_array_extensional;
     unsigned        m_array_laziness;
     bool            m_array_delay_exp_axiom;
+    bool            m_array_lazy_select;
     bool            m_array_cg;
     bool            m_array_always_prop_upward;
     bool            m_array_lazy_ieq;
@@ -49,6 +50,7 @@ struct theory_array_params {
         m_array_extensional(true),
         m_array_laziness(1),
         m_array_delay_exp_axiom(true),
+        m_array_lazy_select(false),
         m_array_cg(false),
         m_array_always_prop_upward(true), // UPWARDs filter is broken... TODO: fix it
         m_array_lazy_ieq(false),
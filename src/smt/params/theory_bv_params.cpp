@@ -27,6 +27,8 @@ void theory_bv_params::updt_params(params_ref const & _p) {
     m_bv_reflect = p.bv_reflect();
     m_bv_enable_int2bv2int = p.bv_enable_int2bv(); 
     m_bv_eq_axioms = p.bv_eq_axioms();
+    m_bv_delay = p.bv_delay();
+    m_bv_bound_propagation = p.bv_bound_propagation();
 }
 
 #define DISPLAY_PARAM(X) out << #X"=" << X << std::endl;
@@ -40,4 +42,6 @@ void theory_bv_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_bv_eq_axioms);
     DISPLAY_PARAM(m_bv_blast_max_size);
     DISPLAY_PARAM(m_bv_enable_int2bv2int);
+    DISPLAY_PARAM(m_bv_delay);
+    DISPLAY_PARAM(m_bv_bound_propagation);
 }
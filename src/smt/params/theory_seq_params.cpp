@@ -20,6 +20,7 @@ Revision History:
 void theory_seq_params::updt_params(params_ref const & _p) {
     smt_params_helper p(_p);
     m_split_w_len = p.seq_split_w_len();
+    m_seq_length_abstraction = p.seq_length_abstraction();
     m_seq_validate = p.seq_validate();
     m_seq_use_unicode = p.seq_use_unicode();
 }
@@ -23,12 +23,17 @@ struct theory_seq_params {
      * Enable splitting guided by length constraints
      */
     bool m_split_w_len;
+    /*
+     * Constrain the lengths of both sides of word equations up front
+     */
+    bool m_seq_length_abstraction;
     bool m_seq_validate;
     bool m_seq_use_unicode;
 
 
     theory_seq_params(params_ref const & p = params_ref()):
         m_split_w_len(false),
+        m_seq_length_abstraction(false),
         m_seq_validate(false),
         m_seq_use_unicode(false)
     {
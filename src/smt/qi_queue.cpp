@@ -16,6 +16,7 @@ Author:
 Revision History:
 
 --*/
+#include <cmath>
 #include "util/warning.h"
 #include "util/stats.h"
 #include "ast/ast_pp.h"
@@ -37,9 +38,10 @@ namespace smt {
         m_parser(m),
         m_evaluator(m),
         m_subst(m),
-        m_instances(m) {
+        m_instances(m),
+        m_true_instances_pinned(m) {
         init_parser_vars();
-        m_vals.resize(15, 0.0f);
+        m_vals.resize(16, 0.0f);
     }
 
     qi_queue::~qi_queue() {
@@ -66,6 +68,8 @@ namespace smt {
     }
 
     void qi_queue::init_parser_vars() {
+#define CONFLICTS 15
+        m_parser.add_var("conflicts");
 #define COST 14
         m_parser.add_var("cost");
 #define MIN_TOP_GENERATION 13
@@ -115,6 +119,7 @@ namespace smt {
         m_vals[SCOPE]              = static_cast<float>(m_context.get_scope_level());
         m_vals[NESTED_QUANTIFIERS] = static_cast<float>(stat->get_num_nested_quantifiers());
         m_vals[CS_FACTOR]          = static_cast<float>(stat->get_case_split_factor());
+        m_vals[CONFLICTS]          = static_cast<float>(stat->get_num_instances_conflict());
         TRACE("qi_queue_detail", for (unsigned i = 0; i < m_vals.size(); i++) { tout << m_vals[i] << " "; } tout << "\n";);
         return stat;
     }
@@ -122,6 +127,11 @@ namespace smt {
     float qi_queue::get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation) {
         quantifier_stat * stat = set_values(q, pat, generation, min_top_generation, max_top_generation, 0);
         float r = m_evaluator(m_cost_function, m_vals.size(), m_vals.c_ptr());
+        if (m_params.m_qi_feedback) {
+            // demote quantifiers whose instances rarely conflict with the assignment.
+            float n = static_cast<float>(stat->get_num_instances());
+            r += std::log2((1.0f + n) / (1.0f + m_vals[CONFLICTS]));
+        }
         stat->update_max_cost(r);
         return r;
     }
@@ -157,12 +167,12 @@ namespace smt {
             quantifier * qa    = static_cast<quantifier*>(f->get_data());
 
             if (curr.m_cost <= m_eager_cost_threshold) {
-                instantiate(curr);
+                stage(curr);
             }
             else if (m_params.m_qi_promote_unsat && m_checker.is_unsat(qa->get_expr(), f->get_num_args(), f->get_args())) {
                 // do not delay instances that produce a conflict.
                 TRACE("qi_unsat", tout << "promoting instance that produces a conflict\n" << mk_pp(qa, m) << "\n";);
-                instantiate(curr);
+                stage(curr);
             }
             else {
                 TRACE("qi_queue", tout << "delaying quantifier instantiation... " << f << "\n" << mk_pp(qa, m) << "\ncost: " << curr.m_cost << "\n";);
@@ -178,9 +188,26 @@ namespace smt {
             }
         }
         m_new_entries.reset();
+        // The instances are internalized only after all of them were created,
+        // cheaper instances first.
+        std::stable_sort(m_staged.begin(), m_staged.end(), 
+                         [](staged_instance const& a, staged_instance const& b) { return a.m_cost < b.m_cost; });
+        for (staged_instance const& inst : m_staged) {
+            if (m_context.get_cancel_flag()) {
+                break;
+            }
+            add_instance(inst);
+        }
+        m_staged.reset();
         TRACE("new_entries_bug", tout << "[qi:instantiate]\n";);
     }
 
+    void qi_queue::stage(entry & ent) {
+        staged_instance inst;
+        if (mk_instance(ent, inst))
+            m_staged.push_back(inst);
+    }
+
     void qi_queue::display_instance_profile(fingerprint * f, quantifier * q, unsigned num_bindings, enode * const * bindings, unsigned proof_id, unsigned generation) {
         if (m.has_trace_stream()) {
             m.trace_stream() << "[instance] ";
@@ -193,6 +220,16 @@ namespace smt {
     }
 
     void qi_queue::instantiate(entry & ent) {
+        staged_instance inst;
+        if (mk_instance(ent, inst))
+            add_instance(inst);
+    }
+
+    /**
+       \brief Create the instance for the given entry. The instance is not internalized.
+       Return false if the instance is already satisfied or simplifies to true.
+    */
+    bool qi_queue::mk_instance(entry & ent, staged_instance & inst) {
         fingerprint * f          = ent.m_qb;
         quantifier * q           = static_cast<quantifier*>(f->get_data());
         unsigned generation      = ent.m_generation;
@@ -217,7 +254,7 @@ namespace smt {
             // in this way smt.qi.profile=true coincides with the axiom profiler
             stat->inc_num_instances_checker_sat();
             disable_trace("coming_from_quant");
-            return;
+            return false;
         }
 
         STRACE("instance", tout << "### " << static_cast<void*>(f) <<", " << q->get_qid()  << "\n";);
@@ -225,6 +262,14 @@ namespace smt {
         expr_ref instance(m);
         m_subst(q, num_bindings, bindings, instance);
 
+        if (!m.has_trace_stream() && m_true_instances.contains(instance)) {
+            TRACE("qi_queue", tout << "instance is known to simplify to true\n";);
+            m_stats.m_num_true_instances_skipped++;
+            stat->inc_num_instances_simplify_true();
+            disable_trace("coming_from_quant");
+            return false;
+        }
+
         TRACE("qi_queue", tout << "new instance:\n" << mk_pp(instance, m) << "\n";);
         TRACE("qi_queue_instance", tout << "new instance:\n" << mk_pp(instance, m) << "\n";);
         expr_ref  s_instance(m);
@@ -236,16 +281,22 @@ namespace smt {
 
             STRACE("instance", tout <<  "Instance reduced to true\n";);
             stat -> inc_num_instances_simplify_true();
+            if (m_true_instances_pinned.size() < MAX_TRUE_INSTANCES) {
+                m_true_instances.insert(instance);
+                m_true_instances_pinned.push_back(instance);
+            }
             if (m.has_trace_stream()) {
                 display_instance_profile(f, q, num_bindings, bindings, pr ? pr->get_id() : 0, generation);
                 m.trace_stream() << "[end-of-instance]\n";
             }
 
             disable_trace("coming_from_quant");
-            return;
+            return false;
         }
         TRACE("qi_queue", tout << "simplified instance:\n" << s_instance << "\n";);
         stat->inc_num_instances();
+        if (m_params.m_qi_feedback && m_checker.is_unsat(q->get_expr(), num_bindings, bindings))
+            stat->inc_num_instances_conflict();
         if (stat->get_num_instances() % m_params.m_qi_profile_freq == 0) {
             m_qm.display_stats(verbose_stream(), q);
         }
@@ -295,9 +346,27 @@ namespace smt {
         }
         TRACE("qi_queue", tout << mk_pp(lemma, m) << "\n#" << lemma->get_id() << ":=\n" << mk_ll_pp(lemma, m););
         m_stats.m_num_instances++;
-        unsigned gen = get_new_gen(q, generation, ent.m_cost);
-        display_instance_profile(f, q, num_bindings, bindings, proof_id, gen);
-        m_context.internalize_instance(lemma, pr1, gen);
+        inst.m_qb       = f;
+        inst.m_lemma    = lemma;
+        inst.m_proof    = pr1;
+        inst.m_cost     = ent.m_cost;
+        inst.m_gen      = get_new_gen(q, generation, ent.m_cost);
+        inst.m_proof_id = proof_id;
+        disable_trace("coming_from_quant");
+        return true;
+    }
+
+    /**
+       \brief Internalize an instance created using mk_instance.
+    */
+    void qi_queue::add_instance(staged_instance const & inst) {
+        fingerprint * f = inst.m_qb;
+        quantifier * q  = static_cast<quantifier*>(f->get_data());
+        expr * lemma    = inst.m_lemma;
+        // NEVER remove coming_from_quant
+        enable_trace("coming_from_quant");
+        display_instance_profile(f, q, f->get_num_args(), f->get_args(), inst.m_proof_id, inst.m_gen);
+        m_context.internalize_instance(lemma, inst.m_proof, inst.m_gen);
         if (f->get_def()) {
             m_context.internalize(f->get_def(), true);
         }
@@ -317,7 +386,7 @@ namespace smt {
                     }
                 }
                 if (true_child && has_unassigned) {
-                    TRACE("qi_queue_profile_detail", tout << "missed:\n" << mk_ll_pp(s_instance, m) << "\n#" << true_child->get_id() << "\n";);
+                    TRACE("qi_queue_profile_detail", tout << "missed:\n" << mk_ll_pp(lemma, m) << "\n#" << true_child->get_id() << "\n";);
                     num_useless++;
                     if (num_useless % 10 == 0) {
                         TRACE("qi_queue_profile", tout << "num useless: " << num_useless << "\n";);
@@ -363,6 +432,8 @@ namespace smt {
         m_delayed_entries.reset();
         m_instances.reset();
         m_scopes.reset();
+        m_true_instances.reset();
+        m_true_instances_pinned.reset();
     }
 
     void qi_queue::init_search_eh() {
@@ -476,6 +547,7 @@ namespace smt {
     void qi_queue::collect_statistics(::statistics & st) const {
         st.update("quant instantiations", m_stats.m_num_instances);
         st.update("lazy quant instantiations", m_stats.m_num_lazy_instances);
+        st.update("skipped true quant instantiations", m_stats.m_num_true_instances_skipped);
         st.update("missed quant instantiations", m_delayed_entries.size());
         float min, max;
         get_min_max_costs(min, max);
@@ -33,7 +33,7 @@ namespace smt {
     class context;
 
     struct qi_queue_stats {
-        unsigned m_num_instances, m_num_lazy_instances;
+        unsigned m_num_instances, m_num_lazy_instances, m_num_true_instances_skipped;
         void reset() { memset(this, 0, sizeof(qi_queue_stats)); }
         qi_queue_stats() { reset(); }
     };
@@ -59,7 +59,18 @@ namespace smt {
             unsigned      m_instantiated:1;
             entry(fingerprint * f, float c, unsigned g):m_qb(f), m_cost(c), m_generation(g), m_instantiated(false) {}
         };
+        // instance created but not yet internalized.
+        // m_lemma and m_proof are kept alive by m_instances.
+        struct staged_instance {
+            fingerprint * m_qb;
+            expr *        m_lemma;
+            proof *       m_proof;
+            float         m_cost;
+            unsigned      m_gen;
+            unsigned      m_proof_id;
+        };
         svector<entry>                m_new_entries;
+        svector<staged_instance>      m_staged;
         svector<entry>                m_delayed_entries;
         expr_ref_vector               m_instances;
         unsigned_vector               m_instantiated_trail;
@@ -69,12 +80,21 @@ namespace smt {
             unsigned   m_instantiated_trail_lim;
         };
         svector<scope>                m_scopes;
+        // Instances that were simplified to true. Unlike the fingerprints, this set 
+        // is not reset on backtracking, so the rewriter is not invoked again on
+        // the same instance after a restart.
+        static const unsigned         MAX_TRUE_INSTANCES = 1 << 20;
+        obj_hashtable<expr>           m_true_instances;
+        expr_ref_vector               m_true_instances_pinned;
 
         void init_parser_vars();
         quantifier_stat * set_values(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation, float cost);
         float get_cost(quantifier * q, app * pat, unsigned generation, unsigned min_top_generation, unsigned max_top_generation);
         unsigned get_new_gen(quantifier * q, unsigned generation, float cost);
         void instantiate(entry & ent);
+        void stage(entry & ent);
+        bool mk_instance(entry & ent, staged_instance & inst);
+        void add_instance(staged_instance const & inst);
         void get_min_max_costs(float & min, float & max) const;
         void display_instance_profile(fingerprint * f, quantifier * q, unsigned num_bindings, enode * const * bindings, unsigned proof_id, unsigned generation);
 
@@ -26,7 +26,9 @@ namespace smt {
         ctx(th.get_context()),
         m(th.get_manager()),
         m_state_to_expr(m),
-        m_state_graph(state_graph::state_pp(this, pp_state)) { }
+        m_state_graph(state_graph::state_pp(this, pp_state)),
+        m_deriv_trail(m),
+        m_succ(m) { }
 
     seq_util& seq_regex::u() { return th.m_util; }
     class seq_util::rex& seq_regex::re() { return th.m_util.re; }
@@ -452,16 +454,15 @@ namespace smt {
     expr_ref seq_regex::derivative_wrapper(expr* hd, expr* r) {
         STRACE("seq_regex", tout << "derivative(" << mk_pp(hd, m) << "): " << mk_pp(r, m) << std::endl;);
 
-        // Use canonical variable for head
-        expr_ref hd_canon(m.mk_var(0, m.get_sort(hd)), m);
-        expr_ref result(re().mk_derivative(hd_canon, r), m);
-        rewrite(result);
+        expr_ref result(canonical_derivative(r), m);
 
         // Substitute with real head
-        var_subst subst(m);
-        expr_ref_vector sub(m);
-        sub.push_back(hd);
-        result = subst(result, sub);
+        if (!is_ground(result)) {
+            var_subst subst(m);
+            expr_ref_vector sub(m);
+            sub.push_back(hd);
+            result = subst(result, sub);
+        }
 
         STRACE("seq_regex", tout << "derivative result: " << mk_pp(result, m) << std::endl;);
         STRACE("seq_regex_brief", tout << "d(" << state_str(r) << ")="
@@ -470,6 +471,33 @@ namespace smt {
         return result;
     }
 
+    /*
+        Derivative of r by the canonical variable for the head,
+        computed once per regex.
+    */
+    expr* seq_regex::canonical_derivative(expr* r) {
+        expr* d = nullptr;
+        if (m_deriv_cache.find(r, d))
+            return d;
+        if (m_deriv_trail.size() >= m_max_deriv_cache_size) {
+            STRACE("seq_regex", tout << "Derivative cache reset" << std::endl;);
+            m_deriv_trail.reset();
+            m_deriv_cache.reset();
+            m_succ.reset();
+            m_succ_cache.reset();
+        }
+        sort* seq_sort = nullptr, *ele_sort = nullptr;
+        VERIFY(u().is_re(r, seq_sort));
+        VERIFY(u().is_seq(seq_sort, ele_sort));
+        expr_ref hd_canon(m.mk_var(0, ele_sort), m);
+        expr_ref result(re().mk_derivative(hd_canon, r), m);
+        rewrite(result);
+        m_deriv_trail.push_back(r);
+        m_deriv_trail.push_back(result);
+        m_deriv_cache.insert(r, result);
+        return result;
+    }
+
     void seq_regex::propagate_eq(expr* r1, expr* r2) {
         TRACE("seq_regex", tout << "propagate EQ: " << mk_pp(r1, m) << ", " << mk_pp(r2, m) << std::endl;);
         STRACE("seq_regex_brief", tout << "PEQ ";);
@@ -692,35 +720,62 @@ namespace smt {
         but not soundness.
     */
     void seq_regex::get_all_derivatives(expr* r, expr_ref_vector& results) {
-        // Get derivative
-        sort* seq_sort = nullptr;
-        VERIFY(u().is_re(r, seq_sort));
-        expr_ref n(m.mk_fresh_const("re.char", seq_sort), m);
-        expr_ref hd = mk_first(r, n);
-        expr_ref d(m);
-        d = derivative_wrapper(hd, r);
+        std::pair<unsigned, unsigned> range;
+        if (m_succ_cache.find(r, range)) {
+            for (unsigned i = range.first; i < range.second; ++i)
+                results.push_back(m_succ.get(i));
+            STRACE("seq_regex_brief", tout << "#derivs=" << results.size() << " ";);
+            return;
+        }
 
-        // DFS
-        vector<expr*> to_visit;
-        to_visit.push_back(d);
-        obj_map<expr, bool> visited; // set<expr> (bool is used as a unit type)
-        while (to_visit.size() > 0) {
-            expr* e = to_visit.back();
-            to_visit.pop_back();
-            if (visited.contains(e)) continue;
-            visited.insert(e, true);
-            expr* econd = nullptr, *e1 = nullptr, *e2 = nullptr;
-            if (m.is_ite(e, econd, e1, e2) ||
-                re().is_union(e, e1, e2)) {
-                to_visit.push_back(e1);
-                to_visit.push_back(e2);
-            }
-            else if (!re().is_empty(e)) {
-                results.push_back(e);
-                STRACE("seq_regex_verbose", tout
-                    << "get_all_derivatives: added deriv: "
-                    << mk_pp(e, m) << std::endl;);
+        auto collect_leaves = [&](expr* d) {
+            // DFS
+            vector<expr*> to_visit;
+            to_visit.push_back(d);
+            obj_map<expr, bool> visited; // set<expr> (bool is used as a unit type)
+            while (to_visit.size() > 0) {
+                expr* e = to_visit.back();
+                to_visit.pop_back();
+                if (visited.contains(e)) continue;
+                visited.insert(e, true);
+                expr* econd = nullptr, *e1 = nullptr, *e2 = nullptr;
+                if (m.is_ite(e, econd, e1, e2) ||
+                    re().is_union(e, e1, e2)) {
+                    to_visit.push_back(e1);
+                    to_visit.push_back(e2);
+                }
+                else if (!re().is_empty(e)) {
+                    results.push_back(e);
+                    STRACE("seq_regex_verbose", tout
+                        << "get_all_derivatives: added deriv: "
+                        << mk_pp(e, m) << std::endl;);
+                }
             }
+        };
+
+        // Get derivative by the canonical head. When its leaves do not
+        // depend on the head they are the successor states of r.
+        unsigned start = results.size();
+        expr_ref d(canonical_derivative(r), m);
+        collect_leaves(d);
+        bool ground = true;
+        for (unsigned i = start; ground && i < results.size(); ++i)
+            ground = is_ground(results.get(i));
+        if (ground) {
+            unsigned lo = m_succ.size();
+            for (unsigned i = start; i < results.size(); ++i)
+                m_succ.push_back(results.get(i));
+            m_deriv_trail.push_back(r);
+            m_succ_cache.insert(r, std::make_pair(lo, m_succ.size()));
+        }
+        else {
+            results.shrink(start);
+            sort* seq_sort = nullptr;
+            VERIFY(u().is_re(r, seq_sort));
+            expr_ref n(m.mk_fresh_const("re.char", seq_sort), m);
+            expr_ref hd = mk_first(r, n);
+            d = derivative_wrapper(hd, r);
+            collect_leaves(d);
         }
 
         STRACE("seq_regex", tout << "Number of derivatives: "
@@ -126,6 +126,20 @@ namespace smt {
         // Update the graph
         bool update_state_graph(expr* r);
 
+        /*
+            Memoized derivatives. m_deriv_cache maps a regex to its
+            symbolic derivative by the canonical head (var 0), m_succ_cache
+            maps a regex to the range in m_succ of the leaves of its
+            derivative, that is, its successor states. Both persist across
+            scopes and are reset together when they grow too large.
+        */
+        expr_ref_vector                m_deriv_trail;
+        obj_map<expr, expr*>           m_deriv_cache;
+        expr_ref_vector                m_succ;
+        obj_map<expr, std::pair<unsigned, unsigned>> m_succ_cache;
+        unsigned                       m_max_deriv_cache_size { 100000 };
+        expr* canonical_derivative(expr* r);
+
         // Printing expressions for seq_regex_brief
         std::string state_str(expr* e);
         std::string expr_id_str(expr* e);
@@ -19,6 +19,7 @@ Author:
 #include "smt/smt_context.h"
 #include "smt/smt_arith_value.h"
 #include "util/trail.h"
+#include "util/uint_set.h"
 
 namespace smt {
 
@@ -38,6 +39,7 @@ namespace smt {
         dl.init_var(v2);
         ctx().push_trail(push_back_vector<context, svector<theory_var>>(m_asserted_edges));
         m_asserted_edges.push_back(dl.add_edge(v1, v2, s_integer(0), lit));
+        assign_bound(v1, v2, 0, lit);
     }
 
     // < atomic constraint on characters
@@ -46,6 +48,112 @@ namespace smt {
         dl.init_var(v2);
         ctx().push_trail(push_back_vector<context, svector<theory_var>>(m_asserted_edges));
         m_asserted_edges.push_back(dl.add_edge(v1, v2, s_integer(1), lit));
+        assign_bound(v1, v2, 1, lit);
+    }
+
+    bool seq_unicode::is_const_char(theory_var v, unsigned& c) {
+        return seq.is_const_char(th.get_expr(v), c);
+    }
+
+    // v1 + offset <= v2, where one side may be a character constant
+    void seq_unicode::assign_bound(theory_var v1, theory_var v2, unsigned offset, literal lit) {
+        unsigned c = 0;
+        if (is_const_char(v2, c)) {
+            if (c < offset) {
+                literal_vector lits;
+                lits.push_back(lit);
+                set_conflict(lits);
+            }
+            else
+                set_upper(v1, c - offset, lit);
+        }
+        else if (is_const_char(v1, c))
+            set_lower(v2, c + offset, lit);
+    }
+
+    void seq_unicode::init_range(theory_var v) {
+        if (static_cast<unsigned>(v) >= m_ranges.size())
+            m_ranges.resize(v + 1);
+    }
+
+    void seq_unicode::set_lower(theory_var v, unsigned k, literal lit) {
+        init_range(v);
+        if (k <= m_ranges[v].m_lo)
+            return;
+        ctx().push_trail(vector_value_trail<context, range, false>(m_ranges, v));
+        m_ranges[v].m_lo = k;
+        m_ranges[v].m_lo_lit = lit;
+        check_range(v);
+    }
+
+    void seq_unicode::set_upper(theory_var v, unsigned k, literal lit) {
+        init_range(v);
+        if (k >= m_ranges[v].m_hi)
+            return;
+        ctx().push_trail(vector_value_trail<context, range, false>(m_ranges, v));
+        m_ranges[v].m_hi = k;
+        m_ranges[v].m_hi_lit = lit;
+        check_range(v);
+    }
+
+    void seq_unicode::exclude(theory_var v, unsigned k, literal lit) {
+        init_range(v);
+        range const& r = m_ranges[v];
+        if (k < r.m_lo || k > r.m_hi)
+            return;
+        ctx().push_trail(vector_value_trail<context, range, false>(m_ranges, v));
+        ctx().push_trail(push_back_vector<context, svector<exclusion>>(m_exclusions));
+        m_exclusions.push_back(exclusion(k, lit, r.m_excluded));
+        m_ranges[v].m_excluded = m_exclusions.size() - 1;
+        check_range(v);
+    }
+
+    /**
+       Set a conflict if the range of v is empty.
+       Exclusions are only inspected when the interval has
+       no more values than there are exclusions.
+    */
+    void seq_unicode::check_range(theory_var v) {
+        if (ctx().inconsistent())
+            return;
+        range const& r = m_ranges[v];
+        literal_vector lits;
+        if (r.m_lo > r.m_hi) {
+            lits.push_back(r.m_lo_lit);
+            lits.push_back(r.m_hi_lit);
+            set_conflict(lits);
+            return;
+        }
+        unsigned width = r.m_hi - r.m_lo + 1;
+        uint_set covered;
+        unsigned num_covered = 0;
+        for (unsigned i = r.m_excluded; i != UINT_MAX && num_covered < width; i = m_exclusions[i].m_next) {
+            exclusion const& e = m_exclusions[i];
+            if (e.m_value < r.m_lo || e.m_value > r.m_hi || covered.contains(e.m_value))
+                continue;
+            covered.insert(e.m_value);
+            lits.push_back(e.m_lit);
+            ++num_covered;
+        }
+        if (num_covered < width)
+            return;
+        lits.push_back(r.m_lo_lit);
+        lits.push_back(r.m_hi_lit);
+        set_conflict(lits);
+    }
+
+    void seq_unicode::set_conflict(literal_vector const& _lits) {
+        literal_vector lits;
+        for (literal l : _lits)
+            if (l != null_literal)
+                lits.push_back(l);
+        TRACE("seq", tout << "character range conflict " << lits << "\n";);
+        ctx().set_conflict(
+            ctx().mk_justification(
+                ext_theory_conflict_justification(
+                    th.get_id(), ctx().get_region(),
+                    lits.size(), lits.c_ptr(),
+                    0, nullptr)));
     }
 
     literal seq_unicode::mk_literal(expr* e) { 
@@ -68,11 +176,30 @@ namespace smt {
     // = on characters
     void seq_unicode::new_eq_eh(theory_var v1, theory_var v2) {
         adapt_eq(v1, v2);
+        unsigned c = 0;
+        if (is_const_char(v1, c))
+            std::swap(v1, v2);
+        if (is_const_char(v2, c) && !is_const_char(v1, c)) {
+            literal eq = th.mk_eq(th.get_expr(v1), th.get_expr(v2), false);
+            if (ctx().get_assignment(eq) != l_true)
+                return;
+            set_lower(v1, c, eq);
+            if (!ctx().inconsistent())
+                set_upper(v1, c, eq);
+        }
     }
 
     // != on characters
     void seq_unicode::new_diseq_eh(theory_var v1, theory_var v2) {  
         adapt_eq(v1, v2);
+        unsigned c = 0;
+        if (is_const_char(v1, c))
+            std::swap(v1, v2);
+        if (is_const_char(v2, c) && !is_const_char(v1, c)) {
+            literal eq = th.mk_eq(th.get_expr(v1), th.get_expr(v2), false);
+            if (ctx().get_assignment(eq) == l_false)
+                exclude(v1, c, ~eq);
+        }
     }
 
     bool seq_unicode::final_check() {
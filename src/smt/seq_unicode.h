@@ -60,6 +60,27 @@ namespace smt {
 
         typedef int_hashtable<var_value_hash, var_value_eq> var_value_table;
 
+        /*
+            Range of a character variable, [m_lo, m_hi] minus the excluded
+            constants in the list starting at m_excluded. Bounds and
+            exclusions come from constraints against character constants
+            and are justified by the literals of these constraints.
+        */
+        struct range {
+            unsigned m_lo { 0 };
+            unsigned m_hi { zstring::max_char() };
+            literal  m_lo_lit { null_literal };
+            literal  m_hi_lit { null_literal };
+            unsigned m_excluded { UINT_MAX };
+        };
+
+        struct exclusion {
+            unsigned m_value;
+            literal  m_lit;
+            unsigned m_next;
+            exclusion(unsigned v, literal l, unsigned n): m_value(v), m_lit(l), m_next(n) {}
+        };
+
         theory&          th;
         ast_manager&     m;
         seq_util         seq;
@@ -71,6 +92,8 @@ namespace smt {
         var_value_eq     m_var_value_eq;
         var_value_table  m_var_value_table;
         std::function<void(literal, literal, literal)> m_add_axiom;
+        svector<range>     m_ranges;
+        svector<exclusion> m_exclusions;
 
         context& ctx() const { return th.get_context(); }
 
@@ -84,6 +107,15 @@ namespace smt {
 
         literal mk_literal(expr* e);
 
+        void init_range(theory_var v);
+        void set_lower(theory_var v, unsigned k, literal lit);
+        void set_upper(theory_var v, unsigned k, literal lit);
+        void exclude(theory_var v, unsigned k, literal lit);
+        void check_range(theory_var v);
+        void set_conflict(literal_vector const& lits);
+        bool is_const_char(theory_var v, unsigned& c);
+        void assign_bound(theory_var v1, theory_var v2, unsigned offset, literal lit);
+
     public:
 
         seq_unicode(theory& th);
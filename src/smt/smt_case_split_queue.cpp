@@ -39,7 +39,7 @@ namespace {
         }
     };
 
-    typedef heap<bool_var_act_lt> bool_var_act_queue;
+    typedef heap<bool_var_act_lt, 4> bool_var_act_queue;
 
     struct theory_aware_act_lt {
         svector<double> const & m_activity;
@@ -1247,6 +1247,155 @@ namespace {
 
         ~theory_aware_branching_queue() override {};
     };
+
+    struct bool_var_score_lt {
+        svector<double> const & m_score;
+        bool_var_score_lt(svector<double> const & s):m_score(s) {}
+        bool operator()(bool_var v1, bool_var v2) const {
+            return m_score[v1] > m_score[v2];
+        }
+    };
+
+    typedef heap<bool_var_score_lt> bool_var_score_queue;
+
+    /**
+       \brief Case split queue based on conflict history (CHB).
+
+       Each variable has a score Q in [0, 1]. When a variable becomes unassigned,
+       Q is moved towards the reward 1/(c - l + 1), where c is the current number
+       of conflicts and l the last conflict the variable participated in.
+       The step size decays from 0.4 to 0.06 as conflicts accumulate.
+       Scores never grow beyond 1, so no rescaling is needed.
+
+       When m_switch is set, the queue alternates between CHB and the
+       activity (VSIDS) order of act_case_split_queue by restart phase.
+       The phases grow geometrically in the number of restarts.
+    */
+    class chb_case_split_queue : public act_case_split_queue {
+        svector<double>      m_score;
+        unsigned_vector      m_last_conflict;
+        bool_var_score_queue m_chb_queue;
+        double               m_step_size;
+        unsigned             m_num_conflicts;
+        bool                 m_switch;
+        bool                 m_use_chb;
+        unsigned             m_phase_restarts;
+        unsigned             m_phase_length;
+
+        static constexpr double step_size_init = 0.40;
+        static constexpr double step_size_dec  = 0.000001;
+        static constexpr double step_size_min  = 0.06;
+
+        void update_step_size() {
+            unsigned c = m_context.get_num_conflicts();
+            if (c == m_num_conflicts)
+                return;
+            // the conflict counter is reset by each check
+            unsigned delta = c > m_num_conflicts ? c - m_num_conflicts : c;
+            m_num_conflicts = c;
+            m_step_size -= step_size_dec * delta;
+            if (m_step_size < step_size_min)
+                m_step_size = step_size_min;
+        }
+
+    public:
+        chb_case_split_queue(context & ctx, smt_params & p, bool switch_phases):
+            act_case_split_queue(ctx, p),
+            m_chb_queue(1024, bool_var_score_lt(m_score)),
+            m_step_size(step_size_init),
+            m_num_conflicts(0),
+            m_switch(switch_phases),
+            m_use_chb(true),
+            m_phase_restarts(0),
+            m_phase_length(1) {
+        }
+
+        void activity_increased_eh(bool_var v) override {
+            act_case_split_queue::activity_increased_eh(v);
+            m_last_conflict[v] = m_context.get_num_conflicts();
+        }
+
+        void mk_var_eh(bool_var v) override {
+            act_case_split_queue::mk_var_eh(v);
+            m_score.reserve(v+1, 0.0);
+            m_last_conflict.reserve(v+1, 0);
+            m_score[v] = 0.0;
+            m_last_conflict[v] = m_context.get_num_conflicts();
+            m_chb_queue.reserve(v+1);
+            SASSERT(!m_chb_queue.contains(v));
+            m_chb_queue.insert(v);
+        }
+
+        void del_var_eh(bool_var v) override {
+            act_case_split_queue::del_var_eh(v);
+            if (m_chb_queue.contains(v))
+                m_chb_queue.erase(v);
+        }
+
+        void unassign_var_eh(bool_var v) override {
+            act_case_split_queue::unassign_var_eh(v);
+            update_step_size();
+            unsigned c = m_context.get_num_conflicts();
+            unsigned age = c >= m_last_conflict[v] ? c - m_last_conflict[v] : c;
+            double reward = 1.0 / (age + 1);
+            double old_score = m_score[v];
+            m_score[v] = m_step_size * reward + (1.0 - m_step_size) * old_score;
+            if (!m_chb_queue.contains(v))
+                m_chb_queue.insert(v);
+            else if (m_score[v] > old_score)
+                m_chb_queue.decreased(v);
+            else if (m_score[v] < old_score)
+                m_chb_queue.increased(v);
+        }
+
+        void restart_eh() override {
+            if (!m_switch)
+                return;
+            if (++m_phase_restarts < m_phase_length)
+                return;
+            m_phase_restarts = 0;
+            m_use_chb = !m_use_chb;
+            if (m_use_chb)
+                m_phase_length *= 2;
+            TRACE("case_split", tout << "switch to " << (m_use_chb ? "chb" : "vsids") << "\n";);
+        }
+
+        void reset() override {
+            act_case_split_queue::reset();
+            m_chb_queue.reset();
+            m_score.reset();
+            m_last_conflict.reset();
+            m_step_size = step_size_init;
+            m_num_conflicts = 0;
+            m_use_chb = true;
+            m_phase_restarts = 0;
+            m_phase_length = 1;
+        }
+
+        void next_case_split(bool_var & next, lbool & phase) override {
+            if (!m_use_chb) {
+                act_case_split_queue::next_case_split(next, phase);
+                return;
+            }
+            phase = l_undef;
+
+            if (m_context.get_random_value() < static_cast<int>(m_params.m_random_var_freq * random_gen::max_value())) {
+                next = m_context.get_random_value() % m_context.get_num_b_internalized();
+                if (m_context.get_assignment(next) == l_undef)
+                    return;
+            }
+
+            while (!m_chb_queue.empty()) {
+                next = m_chb_queue.erase_min();
+                if (m_context.get_assignment(next) == l_undef)
+                    return;
+            }
+
+            next = null_bool_var;
+        }
+
+        ~chb_case_split_queue() override {};
+    };
 }
 
 namespace smt {
@@ -1274,6 +1423,10 @@ namespace smt {
             return alloc(rel_goal_case_split_queue, ctx, p);
         case CS_ACTIVITY_THEORY_AWARE_BRANCHING:
             return alloc(theory_aware_branching_queue, ctx, p);
+        case CS_CHB:
+            return alloc(chb_case_split_queue, ctx, p, false);
+        case CS_CHB_ACTIVITY_SWITCH:
+            return alloc(chb_case_split_queue, ctx, p, true);
         default:
             return alloc(act_case_split_queue, ctx, p);
         }
@@ -39,6 +39,7 @@ namespace smt {
         virtual void relevant_eh(expr * n) = 0;
         virtual void init_search_eh() = 0;
         virtual void end_search_eh() = 0;
+        virtual void restart_eh() {}
         virtual void internalize_instance_eh(expr * e, unsigned gen) {}
         virtual void reset() = 0;
         virtual void push_scope() = 0;
@@ -20,7 +20,6 @@ Revision History:
 
 #include "smt/smt_enode.h"
 #include "util/hashtable.h"
-#include "util/chashtable.h"
 
 namespace smt {
 
@@ -48,7 +47,7 @@ namespace smt {
             }
         };
 
-        typedef chashtable<enode *, cg_unary_hash, cg_unary_eq> unary_table;
+        typedef core_hashtable<default_hash_entry<enode*>, cg_unary_hash, cg_unary_eq> unary_table;
         
         struct cg_binary_hash {
             unsigned operator()(enode * n) const {
@@ -68,7 +67,7 @@ namespace smt {
             }
         };
 
-        typedef chashtable<enode*, cg_binary_hash, cg_binary_eq> binary_table;
+        typedef core_hashtable<default_hash_entry<enode*>, cg_binary_hash, cg_binary_eq> binary_table;
         
         struct cg_comm_hash {
             unsigned operator()(enode * n) const {
@@ -103,7 +102,7 @@ namespace smt {
             }
         };
 
-        typedef chashtable<enode*, cg_comm_hash, cg_comm_eq> comm_table;
+        typedef core_hashtable<default_hash_entry<enode*>, cg_comm_hash, cg_comm_eq> comm_table;
 
         struct cg_hash {
             unsigned operator()(enode * n) const;
@@ -113,7 +112,7 @@ namespace smt {
             bool operator()(enode * n1, enode * n2) const;
         };
 
-        typedef chashtable<enode*, cg_hash, cg_eq> table;
+        typedef core_hashtable<default_hash_entry<enode*>, cg_hash, cg_eq> table;
 
         ast_manager &                 m_manager;
         bool                          m_commutativity; //!< true if the last found congruence used commutativity
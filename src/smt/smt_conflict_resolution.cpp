@@ -445,7 +445,7 @@ namespace smt {
 
         TRACE("conflict_verbose",m_ctx.display_literals_verbose(tout << "before minimization:\n", m_lemma) << "\n";);
 
-        if (m_params.m_minimize_lemmas)
+        if (m_params.m_minimize_lemmas && !m_params.m_deferred_lemma_minimization)
             minimize_lemma();
 
         TRACE("conflict", m_ctx.display_literals(tout << "after minimization:\n", m_lemma) << "\n";);
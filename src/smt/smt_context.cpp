@@ -20,7 +20,9 @@ Revision History:
 #include "util/luby.h"
 #include "util/warning.h"
 #include "util/timeit.h"
+#include "util/profiler.h"
 #include "util/union_find.h"
+#include "util/parallel_executor.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_smt2_pp.h"
@@ -75,6 +77,7 @@ namespace smt {
         m_qhead(0),
         m_simp_qhead(0),
         m_simp_counter(0),
+        m_strengthen_qhead(0),
         m_bvar_inc(1.0),
         m_phase_cache_on(true),
         m_phase_counter(0),
@@ -83,6 +86,8 @@ namespace smt {
         m_not_l(null_literal),
         m_conflict_resolution(mk_conflict_resolution(m, *this, m_dyn_ack_manager, p, m_assigned_literals, m_watches)),
         m_unsat_proof(m),
+        m_saved_var_exprs(m),
+        m_save_var_state(false),
         m_dyn_ack_manager(*this, p),
         m_unknown("unknown"),
         m_unsat_core(m),
@@ -192,6 +197,7 @@ namespace smt {
     }
 
     context::~context() {
+        dealloc(m_par);
         flush();
         m_asserted_formulas.finalize();
     }
@@ -1670,6 +1676,7 @@ namespace smt {
             m_qhead != m_assigned_literals.size() ||
             m_relevancy_propagator->can_propagate() ||
             !m_atom_propagation_queue.empty() ||
+            !m_lazy_ite_queue.empty() ||
             m_qmanager->can_propagate() ||
             can_theories_propagate() ||
             !m_eq_propagation_queue.empty() ||
@@ -1693,6 +1700,7 @@ namespace smt {
        congruences cannot be retracted to a consistent state.
      */
     bool context::propagate() {
+        scoped_profile _profile("smt.propagate");
         TRACE("propagate", tout << "propagating... " << m_qhead << ":" << m_assigned_literals.size() << "\n";);
         while (true) {
             if (inconsistent())
@@ -1708,6 +1716,8 @@ namespace smt {
                 propagate_relevancy(qhead);
                 if (inconsistent())
                     return false;
+                if (!propagate_lazy_ites())
+                    return false;
                 if (!propagate_atoms())
                     return false;
                 if (!propagate_eqs())
@@ -2436,7 +2446,10 @@ namespace smt {
 
             m_fingerprints.pop_scope(num_scopes);
             unassign_vars(s.m_assigned_literals_lim);
-            undo_trail_stack(s.m_trail_stack_lim);
+            {
+                flet<bool> _save(m_save_var_state, m_fparams.m_restore_var_state && new_lvl < m_base_lvl);
+                undo_trail_stack(s.m_trail_stack_lim);
+            }
 
             for (theory* th : m_theory_set) 
                 th->pop_scope_eh(num_scopes);
@@ -2451,6 +2464,7 @@ namespace smt {
             m_th_eq_propagation_queue.reset();
             m_th_diseq_propagation_queue.reset();
             m_atom_propagation_queue.reset();
+            m_lazy_ite_queue.reset();
             m_region.pop_scope(num_scopes);
             m_scopes.shrink(new_lvl);
             m_conflict_resolution->reset();
@@ -2704,6 +2718,69 @@ namespace smt {
         SASSERT(check_clauses(m_lemmas) && check_clauses(m_aux_clauses));
     }
 
+    /**
+       \brief Remove literals l from cls such that a binary clause (~l or l') exists
+       for some other literal l' of cls. The watched literals are not removed.
+       Return true if cls was modified. Each inspected binary clause consumes budget.
+    */
+    bool context::strengthen_lemma(clause & cls, unsigned & budget) {
+        unsigned sz = cls.get_num_literals();
+        for (unsigned i = 0; i < sz; ++i) 
+            m_strengthen_marks[cls[i].index()] = true;
+        unsigned j = 2;
+        for (unsigned i = 2; i < sz; ++i) {
+            literal l = cls[i];
+            bool implied = false;
+            // the watch list of l contains the literals l' of the binary clauses (~l or l').
+            watch_list const & wl = m_watches[l.index()];
+            for (literal const * it = wl.begin_literals(), * end = wl.end_literals(); !implied && budget > 0 && it != end; ++it) {
+                implied = *it != l && m_strengthen_marks[it->index()];
+                --budget;
+            }
+            if (implied) {
+                m_strengthen_marks[l.index()] = false;
+                dec_ref(l);
+                continue;
+            }
+            if (i != j) 
+                cls.swap_lits(i, j);
+            ++j;
+        }
+        for (unsigned i = 0; i < sz; ++i) 
+            m_strengthen_marks[cls[i].index()] = false;
+        if (j == sz)
+            return false;
+        m_stats.m_num_strengthened_lits += sz - j;
+        m_clause_proof.shrink(cls, j);
+        cls.set_num_literals(j);
+        return true;
+    }
+
+    /**
+       \brief Strengthen the lemmas created since the last call using binary clauses.
+       This is a cheaper replacement for the recursive minimization performed
+       during conflict resolution, see smt.minimize_lemmas.deferred.
+       
+       Binary clauses are only created when there are no user scopes,
+       and they are never deleted. So the strengthened lemmas remain consequences
+       of the clauses that are alive.
+    */
+    void context::strengthen_lemmas() {
+        if (m_base_lvl > 0 || m.proofs_enabled() || m_scope_lvl > m_search_lvl || !binary_clause_opt_enabled())
+            return;
+        unsigned budget = 1 << 16;
+        if (m_strengthen_qhead > m_lemmas.size())
+            m_strengthen_qhead = 0;
+        m_strengthen_marks.reserve(2 * get_num_bool_vars(), false);
+        for (; m_strengthen_qhead < m_lemmas.size() && budget > 0; ++m_strengthen_qhead) {
+            clause * cls = m_lemmas[m_strengthen_qhead];
+            if (cls->deleted() || !cls->is_learned() || cls->in_reinit_stack() || cls->reinternalize_atoms() || cls->get_num_literals() <= 2)
+                continue;
+            strengthen_lemma(*cls, budget);
+        }
+        TRACE("strengthen_lemmas", tout << "qhead: " << m_strengthen_qhead << " lemmas: " << m_lemmas.size() << "\n";);
+    }
+
     struct clause_lt {
         bool operator()(clause * cls1, clause * cls2) const { return cls1->get_activity() > cls2->get_activity(); }
     };
@@ -3492,9 +3569,9 @@ namespace smt {
         setup_context(m_fparams.m_auto_config);
 
         if (m_fparams.m_threads > 1 && !m.has_trace_stream()) {
-            parallel p(*this);
+            if (!m_par) m_par = alloc(parallel, *this);
             expr_ref_vector asms(m);
-            return p(asms);
+            return (*m_par)(asms);
         }
 
         internalize_assertions();
@@ -3549,13 +3626,14 @@ namespace smt {
     }
 
     lbool context::check(unsigned num_assumptions, expr * const * assumptions, bool reset_cancel) {
+        memory::scoped_tag _tag(memory::TAG_SMT);
         if (!check_preamble(reset_cancel)) return l_undef;
         SASSERT(at_base_level());
         setup_context(false);
         if (m_fparams.m_threads > 1 && !m.has_trace_stream()) {            
             expr_ref_vector asms(m, num_assumptions, assumptions);
-            parallel p(*this);
-            return p(asms);
+            if (!m_par) m_par = alloc(parallel, *this);
+            return (*m_par)(asms);
         }
         lbool r;
         do {
@@ -3575,6 +3653,7 @@ namespace smt {
     }
 
     lbool context::check(expr_ref_vector const& cube, vector<expr_ref_vector> const& clauses) {
+        memory::scoped_tag _tag(memory::TAG_SMT);
         if (!check_preamble(true)) return l_undef;
         TRACE("before_search", display(tout););
         setup_context(false);
@@ -3668,6 +3747,7 @@ namespace smt {
         if (get_cancel_flag())
             return l_undef;
         timeit tt(get_verbosity_level() >= 100, "smt.stats");
+        scoped_profile _profile("smt.search");
         reset_model();
         SASSERT(at_search_level());
         TRACE("search", display(tout); display_enodes_lbls(tout););
@@ -3746,6 +3826,7 @@ namespace smt {
                 pop_scope(m_scope_lvl - curr_lvl);
                 SASSERT(at_search_level());
             }
+            m_case_split_queue->restart_eh();
             for (theory* th : m_theory_set) {
                 if (!inconsistent()) th->restart_eh();
             }
@@ -3766,6 +3847,8 @@ namespace smt {
         }
         if (m_fparams.m_simplify_clauses)
             simplify_clauses();
+        if (m_fparams.m_deferred_lemma_minimization)
+            strengthen_lemmas();
         if (m_fparams.m_lemma_gc_strategy == LGC_AT_RESTART)
             del_inactive_lemmas();
 
@@ -3883,9 +3966,12 @@ namespace smt {
 
             if (m_progress_callback) {
                 m_progress_callback->fast_progress_sample();
-                if (m_fparams.m_progress_sampling_freq > 0 && m_timer.ms_timeout(m_next_progress_sample + 1)) {
+                unsigned freq = m_progress_callback->slow_progress_interval();
+                if (freq == 0)
+                    freq = m_fparams.m_progress_sampling_freq;
+                if (freq > 0 && m_timer.ms_timeout(m_next_progress_sample + 1)) {
                     m_progress_callback->slow_progress_sample();
-                    m_next_progress_sample = (unsigned)(m_timer.get_seconds() * 1000) + m_fparams.m_progress_sampling_freq;
+                    m_next_progress_sample = (unsigned)(m_timer.get_seconds() * 1000) + freq;
                 }
             }
         }
@@ -3904,6 +3990,7 @@ namespace smt {
     }
 
     final_check_status context::final_check() {
+        scoped_profile _profile("smt.final_check");
         TRACE("final_check", tout << "final_check inconsistent: " << inconsistent() << "\n"; display(tout); display_normalized_enodes(tout););
         CASSERT("relevancy", check_relevancy());
         
@@ -3935,6 +4022,7 @@ namespace smt {
             if (m_final_check_idx < num_th) {
                 theory * th = m_theory_set[m_final_check_idx];
                 IF_VERBOSE(100, verbose_stream() << "(smt.final-check \"" << th->get_name() << "\")\n";);
+                scoped_profile _profile(th->get_name());
                 ok = th->final_check_eh();
                 TRACE("final_check_step", tout << "final check '" << th->get_name() << " ok: " << ok << " inconsistent " << inconsistent() << "\n";);
                 if (ok == FC_GIVEUP) {
@@ -3981,7 +4069,7 @@ namespace smt {
         if (m.proofs_enabled() && m_fparams.m_check_proof) {
             proof_checker pf(m);
             expr_ref_vector side_conditions(m);
-            pf.check(pr, side_conditions);
+            pf.check_parallel(pr, side_conditions, parallel_executor::max_threads());
         }
     }
 
@@ -4015,6 +4103,7 @@ namespace smt {
             m_fparams.m_phase_selection == PS_CACHING_CONSERVATIVE2)
             forget_phase_of_vars_in_current_level();
         m_atom_propagation_queue.reset();
+        m_lazy_ite_queue.reset();
         m_eq_propagation_queue.reset();
         m_th_eq_propagation_queue.reset();
         m_th_diseq_propagation_queue.reset();
@@ -4505,7 +4594,7 @@ namespace smt {
     }
 
     void context::mk_proto_model() {
-        if (m_model || m_proto_model || has_case_splits()) return;
+        if (m_model || (m_proto_model && !m_model_generator->is_partial()) || has_case_splits()) return;
         TRACE("get_model",
               display(tout);
               display_normalized_enodes(tout);
@@ -4518,8 +4607,13 @@ namespace smt {
         }     
         else if (m_fparams.m_model || m_fparams.m_model_on_final_check || 
                  (m_qmanager->has_quantifiers() && m_qmanager->model_based())) {
-            m_model_generator->reset();
-            m_proto_model = m_model_generator->mk_model();
+            if (m_proto_model) {
+                m_proto_model = m_model_generator->complete_model();
+            }
+            else {
+                m_model_generator->reset();
+                m_proto_model = m_model_generator->mk_model();
+            }
             m_qmanager->adjust_model(m_proto_model.get());
             TRACE("mbqi_bug", tout << "before complete_partial_funcs:\n"; model_pp(tout, *m_proto_model););
             m_proto_model->complete_partial_funcs(false);
@@ -4568,6 +4662,28 @@ namespace smt {
         }
     }
 
+    /**
+       \brief Return a model that only interprets the uninterpreted constants in consts.
+       The values are recorded in the model generator, so that a later call to 
+       get_model finishes the model instead of building it from scratch.
+    */
+    void context::get_model(expr_ref_vector const& consts, model_ref & mdl) {
+        if (m_model || (m_proto_model && !m_model_generator->is_partial())) {
+            get_model(mdl);
+            return;
+        }
+        mdl = nullptr;
+        if (inconsistent() || !m.inc() || !m_fparams.m_model || has_case_splits())
+            return;
+        failure fl = get_last_search_failure();
+        if (fl == MEMOUT || fl == CANCELED || fl == NUM_CONFLICTS || fl == RESOURCE_LIMIT) 
+            return;
+        if (!m_proto_model) 
+            m_model_generator->reset();
+        m_proto_model = m_model_generator->mk_partial_model(consts);
+        mdl = m_proto_model->mk_model();
+    }
+
     void context::get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) {
         unsigned sz = vars.size(); 
         depth.resize(sz);
@@ -183,6 +183,8 @@ namespace smt {
         unsigned                    m_qhead;
         unsigned                    m_simp_qhead;
         int                         m_simp_counter; //!< can become negative
+        unsigned                    m_strengthen_qhead; //!< lemmas in m_lemmas before this position were already strengthened
+        bool_vector                 m_strengthen_marks;
         scoped_ptr<case_split_queue> m_case_split_queue;
         scoped_ptr<induction>       m_induction;
         double                      m_bvar_inc;
@@ -203,7 +205,23 @@ namespace smt {
 
         literal_vector              m_atom_propagation_queue;
 
+        // branches of if-then-else terms that still need to be internalized,
+        // and the branches (2*id + is_then) that are already defined. See smt.lazy_ite.
+        svector<std::pair<app *, bool>> m_lazy_ite_queue;
+        uint_set                    m_lazy_ite_defined;
+
         obj_map<expr, unsigned>     m_cached_generation;
+
+        // activity and phase of Boolean variables removed when popping user scopes.
+        // See smt.restore_var_state.
+        struct var_state {
+            double   m_activity;
+            bool     m_phase_available;
+            bool     m_phase;
+        };
+        obj_map<expr, var_state>    m_saved_var_state;
+        expr_ref_vector             m_saved_var_exprs;
+        bool                        m_save_var_state;
         obj_hashtable<expr>         m_cache_generation_visited;
         dyn_ack_manager             m_dyn_ack_manager;
 
@@ -601,7 +619,7 @@ namespace smt {
         //
         // -----------------------------------
     protected:
-        typedef ptr_vector<trail<context> >   trail_stack;
+        typedef trail_log<context>            trail_stack;
         trail_stack                           m_trail_stack;
 #ifdef Z3DEBUG
         bool                                  m_trail_enabled;
@@ -611,11 +629,11 @@ namespace smt {
         template<typename TrailObject>
         void push_trail(const TrailObject & obj) {
             SASSERT(m_trail_enabled);
-            m_trail_stack.push_back(new (m_region) TrailObject(obj));
+            m_trail_stack.push(obj, m_region);
         }
 
         void push_trail_ptr(trail<context> * ptr) {
-            m_trail_stack.push_back(ptr);
+            m_trail_stack.push_ptr(ptr);
         }
 
     protected:
@@ -789,6 +807,8 @@ namespace smt {
 
         void internalize_ite_term(app * n);
 
+        void internalize_lazy_ite_term(app * n);
+
         bool internalize_theory_term(app * n);
 
         void internalize_uninterpreted(app * n);
@@ -801,6 +821,8 @@ namespace smt {
         mk_bool_var_trail   m_mk_bool_var_trail;
         void undo_mk_bool_var();
 
+        void save_var_state(expr * n, bool_var v);
+
         friend class mk_enode_trail;
         class mk_enode_trail : public trail<context> {
         public:
@@ -1159,6 +1181,10 @@ namespace smt {
 
         void simplify_clauses();
 
+        bool strengthen_lemma(clause & cls, unsigned & budget);
+
+        void strengthen_lemmas();
+
         /**
            \brief Return true if the give clause is justifying some literal.
         */
@@ -1245,6 +1271,8 @@ namespace smt {
 
         bool propagate_atoms();
 
+        bool propagate_lazy_ites();
+
         void push_new_th_diseqs(enode * r, theory_var v, theory * th);
 
         void propagate_bool_var_enode(bool_var v);
@@ -1298,6 +1326,10 @@ namespace smt {
         void add_rel_watch(literal l, relevancy_eh * eh) { m_relevancy_propagator->add_watch(bool_var2expr(l.var()), !l.sign(), eh); }
         void add_rel_watch(literal l, expr * n) { m_relevancy_propagator->add_watch(bool_var2expr(l.var()), !l.sign(), n); }
 
+        bool lazy_ite() const { return m_fparams.m_lazy_ite && relevancy(); }
+
+        void push_lazy_ite_branch(app * n, bool is_then) { m_lazy_ite_queue.push_back(std::make_pair(n, is_then)); }
+
     protected:
         lbool get_assignment_core(expr * n) const;
 
@@ -1662,6 +1694,8 @@ namespace smt {
 
         void get_model(model_ref & m);
 
+        void get_model(expr_ref_vector const& consts, model_ref & m);
+
         void set_model(model* m) { m_model = m; }
 
         bool update_model(bool refinalize);
@@ -1702,6 +1736,12 @@ namespace smt {
                 throw default_exception("user propagator must be initialized");
             m_user_propagator->register_fixed(fixed_eh);
         }
+
+        void user_propagate_register_fixed_batch(solver::fixed_batch_eh_t& fixed_batch_eh) {
+            if (!m_user_propagator) 
+                throw default_exception("user propagator must be initialized");
+            m_user_propagator->register_fixed_batch(fixed_batch_eh);
+        }
         
         void user_propagate_register_eq(solver::eq_eh_t& eq_eh) {
             if (!m_user_propagator) 
@@ -376,6 +376,7 @@ namespace smt {
         st.update("propagations", m_stats.m_num_propagations + m_stats.m_num_bin_propagations);
         st.update("binary propagations", m_stats.m_num_bin_propagations);
         st.update("restarts", m_stats.m_num_restarts);
+        st.update("lemmas", m_lemmas.size());
         st.update("final checks", m_stats.m_num_final_checks);
         st.update("added eqs", m_stats.m_num_add_eq);
         st.update("mk clause", m_stats.m_num_mk_clause);
@@ -384,6 +385,7 @@ namespace smt {
         st.update("interface eqs", m_stats.m_num_interface_eqs);
         st.update("max generation", m_stats.m_max_generation);
         st.update("minimized lits", m_stats.m_num_minimized_lits);
+        st.update("strengthened lits", m_stats.m_num_strengthened_lits);
         st.update("num checks", m_stats.m_num_checks);
         st.update("mk bool var", m_stats.m_num_mk_bool_var);
 
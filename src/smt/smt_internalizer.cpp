@@ -138,8 +138,10 @@ namespace smt {
 
         if (m.is_term_ite(n)) {
             ts_visit_child(to_app(n)->get_arg(0), true, todo, visited);
-            ts_visit_child(to_app(n)->get_arg(1), false, todo, visited);
-            ts_visit_child(to_app(n)->get_arg(2), false, todo, visited);
+            if (!lazy_ite()) {
+                ts_visit_child(to_app(n)->get_arg(1), false, todo, visited);
+                ts_visit_child(to_app(n)->get_arg(2), false, todo, visited);
+            }
             return visited;
         }
         bool new_gate_ctx = m.is_bool(n) && (is_gate(m, n) || m.is_not(n));
@@ -601,7 +603,7 @@ namespace smt {
         if (!e_internalized(lam_name)) internalize_uninterpreted(lam_name);
         m_app2enode.setx(q->get_id(), get_enode(lam_name), nullptr);
         m_l_internalized_stack.push_back(q);
-        m_trail_stack.push_back(&m_mk_lambda_trail);
+        m_trail_stack.push_ptr(&m_mk_lambda_trail);
     }
 
     /**
@@ -820,6 +822,10 @@ namespace smt {
     */
     void context::internalize_ite_term(app * n) {
         SASSERT(!e_internalized(n));
+        if (lazy_ite()) {
+            internalize_lazy_ite_term(n);
+            return;
+        }
         expr * c  = n->get_arg(0);
         expr * t  = n->get_arg(1);
         expr * e  = n->get_arg(2);
@@ -857,6 +863,55 @@ namespace smt {
         SASSERT(e_internalized(n));
     }
 
+    /**
+       \brief Internalize only the condition of the if-then-else term n.
+       The branches and their defining clauses are created by propagate_lazy_ites
+       once n is relevant and its condition is assigned.
+    */
+    void context::internalize_lazy_ite_term(app * n) {
+        expr * c = n->get_arg(0);
+        mk_enode(n, 
+                 true /* suppress arguments, I don't want to apply CC on ite terms */,
+                 false /* it is a term, so it should not be merged with true/false */,
+                 false /* CC is not enabled */);
+        internalize_rec(c, true);
+        literal c_lit = get_literal(c);
+        relevancy_eh * eh = m_relevancy_propagator->mk_lazy_term_ite_relevancy_eh(n);
+        add_rel_watch(c_lit, eh);
+        add_rel_watch(~c_lit, eh);
+        add_relevancy_eh(n, eh);
+        SASSERT(e_internalized(n));
+    }
+
+    /**
+       \brief Internalize the branches of if-then-else terms selected by their
+       condition, and add the clause c => n = t (or ~c => n = e).
+       Branches internalized above the base level are removed again on backtracking,
+       and recreated when the condition is reassigned.
+    */
+    bool context::propagate_lazy_ites() {
+        for (unsigned i = 0; i < m_lazy_ite_queue.size() && !inconsistent(); ++i) {
+            app * n      = m_lazy_ite_queue[i].first;
+            bool is_then = m_lazy_ite_queue[i].second;
+            unsigned key = 2 * n->get_id() + (is_then ? 1 : 0);
+            if (m_lazy_ite_defined.contains(key))
+                continue;
+            m_lazy_ite_defined.insert(key);
+            push_trail(insert_map<context, uint_set, unsigned>(m_lazy_ite_defined, key));
+            expr * b = n->get_arg(is_then ? 1 : 2);
+            app_ref eq(mk_eq_atom(n, b), m);
+            internalize(b, false);
+            internalize(eq, true);
+            literal c_lit  = get_literal(n->get_arg(0));
+            literal eq_lit = get_literal(eq);
+            TRACE("lazy_ite", tout << "#" << n->get_id() << " " << c_lit << " " << eq_lit << "\n";);
+            mk_gate_clause(is_then ? ~c_lit : c_lit, eq_lit);
+            mark_as_relevant(eq.get());
+        }
+        m_lazy_ite_queue.reset();
+        return !inconsistent();
+    }
+
     /** 
         \brief Try to internalize a theory term. That is, a theory (plugin)
         will be invoked to internalize n. Return true if succeeded.
@@ -923,14 +978,36 @@ namespace smt {
             m_activity[v]      = -((m_random() % 1000) / 1000.0); 
         else
             m_activity[v]      = 0.0;
+        var_state st;
+        if (!m_saved_var_state.empty() && m_saved_var_state.find(n, st)) {
+            m_activity[v]          = st.m_activity;
+            data.m_phase_available = st.m_phase_available;
+            data.m_phase           = st.m_phase;
+        }
         m_case_split_queue->mk_var_eh(v);
         m_b_internalized_stack.push_back(n);
-        m_trail_stack.push_back(&m_mk_bool_var_trail);
+        m_trail_stack.push_ptr(&m_mk_bool_var_trail);
         m_stats.m_num_mk_bool_var++;
         SASSERT(check_bool_var_vector_sizes());
         return v;
     }
     
+    void context::save_var_state(expr * n, bool_var v) {
+        static const unsigned max_saved_var_state = 1 << 20;
+        if (m_saved_var_exprs.size() >= max_saved_var_state) {
+            m_saved_var_state.reset();
+            m_saved_var_exprs.reset();
+        }
+        bool_var_data const & d = m_bdata[v];
+        var_state st;
+        st.m_activity        = m_activity[v];
+        st.m_phase_available = d.m_phase_available;
+        st.m_phase           = d.m_phase;
+        if (!m_saved_var_state.contains(n))
+            m_saved_var_exprs.push_back(n);
+        m_saved_var_state.insert(n, st);
+    }
+
     void context::undo_mk_bool_var() {
         SASSERT(!m_b_internalized_stack.empty());
         m_stats.m_num_del_bool_var++;
@@ -942,6 +1019,8 @@ namespace smt {
               << " m_assignment.size: " << m_assignment.size() << "\n";);
         TRACE("mk_var_bug", tout << "undo_mk_bool: " << v << "\n";);
         // bool_var_data & d     = m_bdata[v];
+        if (m_save_var_state) 
+            save_var_state(n, v);
         m_case_split_queue->del_var_eh(v);
         if (is_quantifier(n))
             m_qmanager->del(to_quantifier(n));
@@ -975,7 +1054,7 @@ namespace smt {
         TRACE("generation", tout << "mk_enode: " << id << " " << generation << "\n";);
         m_app2enode.setx(id, e, nullptr);
         m_e_internalized_stack.push_back(n);
-        m_trail_stack.push_back(&m_mk_enode_trail);
+        m_trail_stack.push_ptr(&m_mk_enode_trail);
         m_enodes.push_back(e);
         if (e->get_num_args() > 0) {
             if (e->is_true_eq()) {
@@ -148,6 +148,10 @@ namespace smt {
             m_kernel.get_model(m);
         }
 
+        void get_model(expr_ref_vector const& consts, model_ref & m) {
+            m_kernel.get_model(consts, m);
+        }
+
         proof * get_proof() {
             return m_kernel.get_proof();
         }
@@ -248,6 +252,10 @@ namespace smt {
         void user_propagate_register_fixed(solver::fixed_eh_t& fixed_eh) {
             m_kernel.user_propagate_register_fixed(fixed_eh);
         }
+
+        void user_propagate_register_fixed_batch(solver::fixed_batch_eh_t& fixed_batch_eh) {
+            m_kernel.user_propagate_register_fixed_batch(fixed_batch_eh);
+        }
         
         void user_propagate_register_eq(solver::eq_eh_t& eq_eh) {
             m_kernel.user_propagate_register_eq(eq_eh);
@@ -364,6 +372,10 @@ namespace smt {
         m_imp->get_model(m);
     }
 
+    void kernel::get_model(expr_ref_vector const& consts, model_ref & m) {
+        m_imp->get_model(consts, m);
+    }
+
     proof * kernel::get_proof() {
         return m_imp->get_proof();
     }
@@ -484,6 +496,10 @@ namespace smt {
     void kernel::user_propagate_register_fixed(solver::fixed_eh_t& fixed_eh) {
         m_imp->user_propagate_register_fixed(fixed_eh);
     }
+
+    void kernel::user_propagate_register_fixed_batch(solver::fixed_batch_eh_t& fixed_batch_eh) {
+        m_imp->user_propagate_register_fixed_batch(fixed_batch_eh);
+    }
     
     void kernel::user_propagate_register_final(solver::final_eh_t& final_eh) {
         m_imp->user_propagate_register_final(final_eh);
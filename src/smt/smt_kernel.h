@@ -155,6 +155,14 @@ namespace smt {
         */
         void get_model(model_ref & m);
 
+        /**
+           \brief Return a partial model of the last check command that only 
+           interprets the uninterpreted constants in consts. Only the values 
+           needed for these constants are built. A later call to get_model 
+           finishes the model.
+        */
+        void get_model(expr_ref_vector const& consts, model_ref & m);
+
         /**
            \brief Return the proof of unsatisfiability associated with the last check command.
         */
@@ -296,6 +304,8 @@ namespace smt {
 
         void user_propagate_register_fixed(solver::fixed_eh_t& fixed_eh);
 
+        void user_propagate_register_fixed_batch(solver::fixed_batch_eh_t& fixed_batch_eh);
+
         void user_propagate_register_final(solver::final_eh_t& final_eh);
         
         void user_propagate_register_eq(solver::eq_eh_t& eq_eh);
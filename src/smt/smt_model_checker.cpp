@@ -49,6 +49,7 @@ namespace smt {
         m_iteration_idx(0),
         m_curr_model(nullptr),
         m_fresh_exprs(m),
+        m_satisfied_pinned(m),
         m_pinned_exprs(m) {
     }
 
@@ -160,19 +161,40 @@ namespace smt {
        \brief Assert the negation of q after applying the interpretation in m_curr_model to the uninterpreted symbols in q.
 
        The variables are replaced by skolem constants. These constants are stored in sks.
+       key is set to the asserted formula over the variables of q, formulas are identical
+       across rounds when the model did not change for q. Return false, without asserting
+       anything, if key was unsatisfiable in an earlier check.
     */
 
-    void model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks) {
+    bool model_checker::assert_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref & key) {
         expr_ref tmp(m);
         
         TRACE("model_checker", tout << "curr_model:\n"; model_pp(tout, *m_curr_model););
 
         if (!m_curr_model->eval(q->get_expr(), tmp, true)) {
-            return;
+            return true;
         }
         TRACE("model_checker", tout << "q after applying interpretation:\n" << mk_ismt2_pp(tmp, m) << "\n";);
-        ptr_buffer<expr> subst_args;
         unsigned num_decls = q->get_num_decls();
+        expr_ref_vector conjs(m);
+        conjs.push_back(m.mk_not(tmp));
+        for (unsigned i = 0; i < num_decls; i++) {
+            sort * s = q->get_decl_sort(num_decls - i - 1);
+            if (m_curr_model->is_finite(s)) {
+                expr_ref v(m.mk_var(i, s), m);
+                ptr_buffer<expr> eqs;
+                for (expr * e : m_curr_model->get_known_universe(s))
+                    eqs.push_back(m.mk_eq(v, e));
+                conjs.push_back(m.mk_or(eqs.size(), eqs.c_ptr()));
+            }
+        }
+        key = mk_and(conjs);
+        if (m_satisfied.contains(key)) {
+            TRACE("model_checker", tout << "satisfied in an earlier round\n";);
+            return false;
+        }
+
+        ptr_buffer<expr> subst_args;
         subst_args.resize(num_decls, nullptr);
         sks.resize(num_decls, nullptr);
         for (unsigned i = 0; i < num_decls; i++) {
@@ -191,6 +213,16 @@ namespace smt {
         r = m.mk_not(sk_body);
         TRACE("model_checker", tout << "mk_neg_q_m:\n" << mk_ismt2_pp(r, m) << "\n";);
         m_aux_context->assert_expr(r);
+        return true;
+    }
+
+    void model_checker::add_satisfied(expr * key) {
+        if (m_satisfied_pinned.size() >= m_max_satisfied) {
+            m_satisfied.reset();
+            m_satisfied_pinned.reset();
+        }
+        m_satisfied_pinned.push_back(key);
+        m_satisfied.insert(key);
     }
 
     bool model_checker::add_instance(quantifier * q, model * cex, expr_ref_vector & sks, bool use_inv) {
@@ -332,14 +364,18 @@ namespace smt {
         quantifier * flat_q = get_flat_quantifier(q);
         TRACE("model_checker", tout << "model checking:\n" << expr_ref(flat_q->get_expr(), m) << "\n";);
         expr_ref_vector sks(m);
+        expr_ref key(m);
 
-        assert_neg_q_m(flat_q, sks);
+        if (!assert_neg_q_m(flat_q, sks, key))
+            return true;
         TRACE("model_checker", tout << "skolems:\n" << sks << "\n";);
 
         flet<bool> l(m_aux_context->get_fparams().m_array_fake_support, true);
         lbool r = m_aux_context->check();
         
         TRACE("model_checker", tout << "[complete] model-checker result: " << to_sat_str(r) << "\n";);
+        if (r == l_false && key)
+            add_satisfied(key);
         if (r != l_true) {
             return r == l_false; // quantifier is satisfied by m_curr_model
         }
@@ -53,6 +53,11 @@ namespace smt {
         proto_model *                               m_curr_model;
         obj_map<expr, expr *>                       m_value2expr;
         expr_ref_vector                             m_fresh_exprs;
+        // restricted negations of quantifiers that were found unsatisfiable,
+        // they are skipped in later rounds.
+        obj_hashtable<expr>                         m_satisfied;
+        expr_ref_vector                             m_satisfied_pinned;
+        static const unsigned                       m_max_satisfied = 10000;
 
         friend class instantiation_set;
 
@@ -62,7 +67,8 @@ namespace smt {
         expr * get_type_compatible_term(expr * val);
         expr_ref replace_value_from_ctx(expr * e);
         void restrict_to_universe(expr * sk, obj_hashtable<expr> const & universe);
-        void assert_neg_q_m(quantifier * q, expr_ref_vector & sks);
+        bool assert_neg_q_m(quantifier * q, expr_ref_vector & sks, expr_ref & key);
+        void add_satisfied(expr * key);
         bool add_blocking_clause(model * cex, expr_ref_vector & sks);
         bool check(quantifier * q);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 #include "util/backtrackable_set.h"
+#include "util/uint_set.h"
 #include "ast/ast_util.h"
 #include "ast/macros/macro_util.h"
 #include "ast/arith_decl_plugin.h"
@@ -416,6 +417,10 @@ namespace smt {
 
             ptr_vector<node>          m_root_nodes;
 
+            // ids of the A_f_i nodes that were populated with the arguments
+            // of the relevant f-applications.
+            uint_set                  m_populated;
+
             expr_ref_vector *         m_new_constraints;
 
             void reset_sort2k() {
@@ -498,9 +503,21 @@ namespace smt {
                 m_uvars.reset();
                 m_A_f_is.reset();
                 m_root_nodes.reset();
+                m_populated.reset();
                 reset_sort2k();
             }
 
+            /**
+               \brief Return true if A_f_i was not populated before. Quantifiers
+               sharing f(..., x_i, ...) then scan the f-applications only once.
+            */
+            bool mark_populated(node * A_f_i) {
+                if (m_populated.contains(A_f_i->get_id()))
+                    return false;
+                m_populated.insert(A_f_i->get_id());
+                return true;
+            }
+
             void set_model(proto_model * m) {
                 reset_eval_cache();
                 m_model = m;
@@ -1183,6 +1200,8 @@ namespace smt {
 
             void populate_inst_sets(quantifier * q, auf_solver & s, context * ctx) override {
                 node * A_f_i = s.get_A_f_i(m_f, m_arg_i);
+                if (!s.mark_populated(A_f_i))
+                    return;
                 for (enode * n : ctx->enodes_of(m_f)) {
                     if (ctx->is_relevant(n)) {
                         // Remark: it is incorrect to use
@@ -43,7 +43,8 @@ namespace smt {
         m_context(nullptr),
         m_fresh_idx(1),
         m_asts(m),
-        m_model(nullptr) {
+        m_model(nullptr),
+        m_partial(false) {
     }
 
     model_generator::~model_generator() {
@@ -56,6 +57,7 @@ namespace smt {
         m_root2value.reset();
         m_asts.reset();
         m_model = nullptr;
+        m_partial = false;
     }
 
     void model_generator::init_model() {
@@ -86,48 +88,61 @@ namespace smt {
     }
 
     /**
-       \brief Create the mapping root2proc: enode-root -> model_value_proc, and roots.
-       Store the new model_value_proc at procs.
+       \brief Collect the relevant roots.
     */
-    void model_generator::mk_value_procs(obj_map<enode, model_value_proc *> & root2proc, ptr_vector<enode> & roots, 
-                                         ptr_vector<model_value_proc> & procs) {
+    void model_generator::mk_roots(ptr_vector<enode> & roots) {
         for (enode * r : m_context->enodes()) {
-            if (r == r->get_root() && m_context->is_relevant(r)) {
+            if (r == r->get_root() && m_context->is_relevant(r)) 
                 roots.push_back(r);
-                sort * s      = m.get_sort(r->get_owner());
-                model_value_proc * proc = nullptr;
-                if (m.is_bool(s)) {
-                    CTRACE("model", m_context->get_assignment(r) == l_undef, 
-                           tout << mk_pp(r->get_owner(), m) << "\n";);
-                    SASSERT(m_context->get_assignment(r) != l_undef);
-                    if (m_context->get_assignment(r) == l_true)
-                        proc = alloc(expr_wrapper_proc, m.mk_true());
-                    else
-                        proc = alloc(expr_wrapper_proc, m.mk_false());
+        }
+    }
+
+    /**
+       \brief Return the model_value_proc of the root r, creating it if necessary.
+       Roots that already have a value, because they were built for a partial 
+       model, just return that value.
+    */
+    model_value_proc * model_generator::get_proc(enode * r) {
+        SASSERT(r == r->get_root());
+        model_value_proc * proc = nullptr;
+        if (m_root2proc.find(r, proc))
+            return proc;
+        app * val = nullptr;
+        sort * s  = m.get_sort(r->get_owner());
+        if (m_root2value.find(r, val)) {
+            proc = alloc(expr_wrapper_proc, val);
+        }
+        else if (m.is_bool(s)) {
+            CTRACE("model", m_context->get_assignment(r) == l_undef, 
+                   tout << mk_pp(r->get_owner(), m) << "\n";);
+            SASSERT(m_context->get_assignment(r) != l_undef);
+            if (m_context->get_assignment(r) == l_true)
+                proc = alloc(expr_wrapper_proc, m.mk_true());
+            else
+                proc = alloc(expr_wrapper_proc, m.mk_false());
+        }
+        else {
+            family_id fid = s->get_family_id();
+            theory * th   = m_context->get_theory(fid);
+            if (th && th->build_models()) {
+                if (r->get_th_var(th->get_id()) != null_theory_var) {
+                    proc = th->mk_value(r, *this);
+                    SASSERT(proc);
                 }
                 else {
-                    family_id fid = s->get_family_id();
-                    theory * th   = m_context->get_theory(fid);
-                    if (th && th->build_models()) {
-                        if (r->get_th_var(th->get_id()) != null_theory_var) {
-                            proc = th->mk_value(r, *this);
-                            SASSERT(proc);
-                        }
-                        else {
-                            TRACE("model", tout << "creating fresh value for #" << r->get_owner_id() << "\n";);
-                            proc = alloc(fresh_value_proc, mk_extra_fresh_value(m.get_sort(r->get_owner())));
-                        }
-                    }
-                    else {
-                        proc = mk_model_value(r);
-                        SASSERT(proc);
-                    }
+                    TRACE("model", tout << "creating fresh value for #" << r->get_owner_id() << "\n";);
+                    proc = alloc(fresh_value_proc, mk_extra_fresh_value(m.get_sort(r->get_owner())));
                 }
+            }
+            else {
+                proc = mk_model_value(r);
                 SASSERT(proc);
-                procs.push_back(proc);
-                root2proc.insert(r, proc);
             }
         }
+        SASSERT(proc);
+        m_procs.push_back(proc);
+        m_root2proc.insert(r, proc);
+        return proc;
     }
     
     model_value_proc* model_generator::mk_model_value(enode* r) {
@@ -167,7 +182,6 @@ namespace smt {
     
     bool model_generator::visit_children(source const & src, 
                                          ptr_vector<enode> const & roots, 
-                                         obj_map<enode, model_value_proc *> const & root2proc, 
                                          source2color & colors, 
                                          obj_hashtable<sort> & already_traversed, 
                                          svector<source> & todo) {
@@ -184,7 +198,7 @@ namespace smt {
                 if (m.get_sort(r->get_owner()) != s)
                     continue;
                 SASSERT(r == r->get_root());
-                if (root2proc[r]->is_fresh()) 
+                if (get_proc(r)->is_fresh()) 
                     continue; // r is associated with a fresh value...
                 TRACE("mg_top_sort", tout << "fresh!" << src.get_value()->get_idx() << " -> #" << r->get_owner_id() << " " << mk_pp(m.get_sort(r->get_owner()), m) << "\n";);
                 visit_child(source(r), colors, todo, visited);
@@ -199,7 +213,7 @@ namespace smt {
         enode * n = src.get_enode();
         SASSERT(n == n->get_root());
         bool visited = true;
-        model_value_proc * proc = root2proc[n];
+        model_value_proc * proc = get_proc(n);
         buffer<model_value_dependency> dependencies;
         proc->get_dependencies(dependencies);
         for (model_value_dependency const& dep : dependencies) {
@@ -217,7 +231,6 @@ namespace smt {
 
     void model_generator::process_source(source const & src,
                                          ptr_vector<enode> const & roots, 
-                                         obj_map<enode, model_value_proc *> const & root2proc, 
                                          source2color & colors, 
                                          obj_hashtable<sort> & already_traversed, 
                                          svector<source> & todo,
@@ -237,10 +250,10 @@ namespace smt {
             switch (get_color(colors, curr)) {
             case White:
                 set_color(colors, curr, Grey);
-                visit_children(curr, roots, root2proc, colors, already_traversed, todo);
+                visit_children(curr, roots, colors, already_traversed, todo);
                 break;
             case Grey:
-                // SASSERT(visit_children(curr, roots, root2proc, colors, already_traversed, todo));
+                // SASSERT(visit_children(curr, roots, colors, already_traversed, todo));
                 set_color(colors, curr, Black);
                 TRACE("mg_top_sort", tout << "append " << curr << "\n";);
                 sorted_sources.push_back(curr);
@@ -257,9 +270,11 @@ namespace smt {
 
     /**
        \brief Topological sort of 'sources'. Store result in sorted_sources.
+       If targets is not null, then only the sources needed to build the 
+       values of the targets are sorted.
     */
     void model_generator::top_sort_sources(ptr_vector<enode> const & roots, 
-                                           obj_map<enode, model_value_proc *> const & root2proc, 
+                                           ptr_vector<enode> const * targets,
                                            svector<source> & sorted_sources) {
         
         svector<source>     todo;
@@ -270,32 +285,43 @@ namespace smt {
 
         // topological sort
 
+        if (targets) {
+            for (enode * r : *targets) {
+                process_source(source(r), roots, colors, already_traversed, todo, sorted_sources);
+            }
+            return;
+        }
+
+        // create all value procs, so that all extra fresh values are known.
+        for (enode * r : roots) {
+            get_proc(r);
+        }
+
         // traverse all extra fresh values...
         for (extra_fresh_value * f : m_extra_fresh_values) {
-            process_source(source(f), roots, root2proc, colors, already_traversed, todo, sorted_sources);
+            process_source(source(f), roots, colors, already_traversed, todo, sorted_sources);
         }
 
         // traverse all enodes that are associated with fresh values...
         for (enode* r : roots) {
-            if (root2proc[r]->is_fresh()) {
-                process_source(source(r), roots, root2proc, colors, already_traversed, todo, sorted_sources);
+            if (get_proc(r)->is_fresh()) {
+                process_source(source(r), roots, colors, already_traversed, todo, sorted_sources);
             }
         }
 
         for (enode * r : roots) {
-            process_source(source(r), roots, root2proc, colors, already_traversed, todo, sorted_sources);
+            process_source(source(r), roots, colors, already_traversed, todo, sorted_sources);
         }
     }
 
-    void model_generator::mk_values() {
-        obj_map<enode, model_value_proc *> root2proc;
+    void model_generator::mk_values(ptr_vector<enode> const * targets) {
         ptr_vector<enode> roots;
-        ptr_vector<model_value_proc> procs;
         svector<source> sources;
         buffer<model_value_dependency> dependencies;
         expr_ref_vector dependency_values(m);
-        mk_value_procs(root2proc, roots, procs);
-        top_sort_sources(roots, root2proc, sources);
+        scoped_reset _scoped_reset(*this);
+        mk_roots(roots);
+        top_sort_sources(roots, targets, sources);
         TRACE("sorted_sources",
               for (source const& curr : sources) {
                   if (curr.is_fresh_value()) {
@@ -307,14 +333,12 @@ namespace smt {
                       tout << mk_pp(n->get_owner(), m) << "\n";
                       sort * s = m.get_sort(n->get_owner());
                       tout << curr << " " << mk_pp(s, m);
-                      tout << " is_fresh: " << root2proc[n]->is_fresh() << "\n";
+                      tout << " is_fresh: " << get_proc(n)->is_fresh() << "\n";
                   }
               }
               m_context->display(tout);
               );
 
-        scoped_reset _scoped_reset(*this, procs);
-
         for (source const& curr : sources) {
             if (curr.is_fresh_value()) {
                 sort * s = curr.get_value()->get_sort();
@@ -330,8 +354,7 @@ namespace smt {
                 TRACE("mg_top_sort", tout << curr << "\n";);
                 dependencies.reset();
                 dependency_values.reset();
-                model_value_proc * proc = root2proc[n];
-                SASSERT(proc);
+                model_value_proc * proc = get_proc(n);
                 proc->get_dependencies(dependencies);
                 for (model_value_dependency const& d : dependencies) {
                     if (d.is_fresh_value()) {
@@ -354,6 +377,8 @@ namespace smt {
                 m_root2value.insert(n, val);
             }
         }        
+        if (targets) 
+            return;
         // send model
         for (enode * n : m_context->enodes()) {
             if (is_uninterp_const(n->get_owner()) && m_context->is_relevant(n)) {
@@ -366,11 +391,13 @@ namespace smt {
         }
     }
 
-    model_generator::scoped_reset::scoped_reset(model_generator& mg, ptr_vector<model_value_proc>& procs): 
-        mg(mg), procs(procs) {}
+    model_generator::scoped_reset::scoped_reset(model_generator& mg): 
+        mg(mg) {}
 
     model_generator::scoped_reset::~scoped_reset() {
-        std::for_each(procs.begin(), procs.end(), delete_proc<model_value_proc>());
+        std::for_each(mg.m_procs.begin(), mg.m_procs.end(), delete_proc<model_value_proc>());
+        mg.m_procs.reset();
+        mg.m_root2proc.reset();
         std::for_each(mg.m_extra_fresh_values.begin(), mg.m_extra_fresh_values.end(), delete_proc<extra_fresh_value>());
         mg.m_extra_fresh_values.reset();
     }
@@ -497,7 +524,54 @@ namespace smt {
         init_model();
         register_existing_model_values();
         mk_bool_model();
-        mk_values();
+        mk_values(nullptr);
+        mk_func_interps();
+        finalize_theory_models();
+        register_macros();
+        TRACE("model", model_v2_pp(tout, *m_model, true););        
+        return m_model.get();
+    }
+
+    proto_model * model_generator::mk_partial_model(expr_ref_vector const & consts) {
+        SASSERT(!m_model || m_partial);
+        if (!m_model) {
+            init_model();
+            register_existing_model_values();
+        }
+        ptr_vector<enode> targets;
+        ptr_vector<app> target_consts;
+        for (expr * c : consts) {
+            if (!is_uninterp_const(c) || m_hidden_ufs.contains(to_app(c)->get_decl()))
+                continue;
+            if (m.is_bool(c)) {
+                if (m_context->b_internalized(c) && m_context->is_relevant(c)) {
+                    lbool val = m_context->get_assignment(c);
+                    m_model->register_decl(to_app(c)->get_decl(), val == l_true ? m.mk_true() : m.mk_false());
+                }
+            }
+            else if (m_context->e_internalized(c) && m_context->is_relevant(c)) {
+                targets.push_back(m_context->get_enode(c)->get_root());
+                target_consts.push_back(to_app(c));
+            }
+        }
+        mk_values(&targets);
+        for (unsigned i = 0; i < targets.size(); ++i) {
+            m_model->register_decl(target_consts[i]->get_decl(), get_value(targets[i]));
+        }
+        m_partial = true;
+        TRACE("model", model_v2_pp(tout, *m_model, true););        
+        return m_model.get();
+    }
+
+    /**
+       \brief Finish a model created by mk_partial_model.
+       Values that were already built are kept.
+    */
+    proto_model * model_generator::complete_model() {
+        SASSERT(m_model && m_partial);
+        m_partial = false;
+        mk_bool_model();
+        mk_values(nullptr);
         mk_func_interps();
         finalize_theory_models();
         register_macros();
@@ -186,10 +186,16 @@ namespace smt {
         ref<proto_model>              m_model;
         obj_hashtable<func_decl>      m_hidden_ufs;
 
+        // value procedures of the roots, created on demand while values are built.
+        obj_map<enode, model_value_proc *> m_root2proc;
+        ptr_vector<model_value_proc>  m_procs;
+        bool                          m_partial;
+
         void init_model();
         void mk_bool_model();
-        void mk_value_procs(obj_map<enode, model_value_proc *> & root2proc, ptr_vector<enode> & roots,  ptr_vector<model_value_proc> & procs);
-        void mk_values();
+        void mk_roots(ptr_vector<enode> & roots);
+        model_value_proc * get_proc(enode * r);
+        void mk_values(ptr_vector<enode> const * targets);
         bool include_func_interp(func_decl * f) const;
         void mk_func_interps();
         void finalize_theory_models();
@@ -197,18 +203,17 @@ namespace smt {
         void register_existing_model_values();
         void register_macros();
 
-        bool visit_children(source const & src, ptr_vector<enode> const & roots, obj_map<enode, model_value_proc *> const & root2proc, 
+        bool visit_children(source const & src, ptr_vector<enode> const & roots, 
                             source2color & colors, obj_hashtable<sort> & already_traversed, svector<source> & todo);
 
-        void process_source(source const & src, ptr_vector<enode> const & roots, obj_map<enode, model_value_proc *> const & root2proc, 
+        void process_source(source const & src, ptr_vector<enode> const & roots, 
                             source2color & colors, obj_hashtable<sort> & already_traversed, svector<source> & todo, svector<source> & sorted_sources);
 
-        void top_sort_sources(ptr_vector<enode> const & roots, obj_map<enode, model_value_proc *> const & root2proc, svector<source> & sorted_sources);
+        void top_sort_sources(ptr_vector<enode> const & roots, ptr_vector<enode> const * targets, svector<source> & sorted_sources);
 
         struct scoped_reset {
             model_generator& mg;
-            ptr_vector<model_value_proc>& procs;
-            scoped_reset(model_generator& mg, ptr_vector<model_value_proc>& procs);
+            scoped_reset(model_generator& mg);
             ~scoped_reset();            
         };
 
@@ -228,6 +233,17 @@ namespace smt {
         ast_manager & get_manager() { return m; }
         proto_model* mk_model();
 
+        /**
+           \brief Create a partial model that only interprets the uninterpreted
+           constants in consts. Values are built only for the roots these
+           constants depend on. Repeated calls extend the partial model.
+           The model can be finished later using
+           complete_model, as long as the logical context is not modified.
+        */
+        proto_model* mk_partial_model(expr_ref_vector const & consts);
+        proto_model* complete_model();
+        bool is_partial() const { return m_partial; }
+
         obj_map<enode, app *> const & get_root2value() const { return m_root2value; }
         app * get_value(enode * n) const;
 
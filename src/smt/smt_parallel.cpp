@@ -17,6 +17,7 @@ Author:
 
 
 #include "util/scoped_ptr_vector.h"
+#include "util/parallel_executor.h"
 #include "ast/ast_util.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -24,6 +25,19 @@ Author:
 #include "smt/smt_parallel.h"
 #include "smt/smt_lookahead.h"
 
+namespace smt {
+
+    void parallel::reset() {
+        m_pctxs.reset();
+        m_pms.reset();
+        m_smt_params.reset();
+        m_synced.reset();
+        m_synced_lim.reset();
+        m_num_threads = 0;
+    }
+
+}
+
 #ifdef SINGLE_THREAD
 
 namespace smt {
@@ -35,9 +49,81 @@ namespace smt {
 
 #else
 
+#include <atomic>
 #include <thread>
 
 namespace smt {
+
+    /**
+       \brief Create fresh worker contexts as copies of the main context.
+    */
+    void parallel::init(unsigned num_threads) {
+        reset();
+        ast_manager& m = ctx.m;
+        for (unsigned i = 0; i < num_threads; ++i) {
+            m_smt_params.push_back(ctx.get_fparams());
+        }
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ast_manager* new_m = alloc(ast_manager, m, true);
+            m_pms.push_back(new_m);
+            m_pctxs.push_back(alloc(context, *new_m, m_smt_params[i], ctx.get_params())); 
+            context& new_ctx = *m_pctxs.back();
+            context::copy(ctx, new_ctx, true);
+            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
+        }
+        asserted_formulas& af = ctx.m_asserted_formulas;
+        for (unsigned i = 0; i < af.get_num_formulas(); ++i) 
+            m_synced.push_back(af.get_formula(i));
+        m_num_threads = num_threads;
+    }
+
+    /**
+       \brief Bring the worker contexts up to date with the assertions of the main context.
+
+       Formulas copied to the workers after their creation are asserted in a fresh 
+       worker scope. Scopes that contain formulas that are no longer asserted in the
+       main context are popped, so lemmas learned by the workers under the remaining
+       formulas are retained. Return false if the workers have to be recreated.
+    */
+    bool parallel::sync() {
+        asserted_formulas& af = ctx.m_asserted_formulas;
+        ast_manager& m = ctx.m;
+        if (m.proofs_enabled())
+            return false;
+        unsigned sz = af.get_num_formulas();
+        unsigned p = 0;
+        while (p < sz && p < m_synced.size() && m_synced.get(p) == af.get_formula(p))
+            ++p;
+        unsigned base_sz = m_synced_lim.empty() ? m_synced.size() : m_synced_lim[0];
+        if (p < base_sz) 
+            return false;
+        unsigned num_scopes = 0;
+        while (m_synced.size() > p) {
+            m_synced.shrink(m_synced_lim.back());
+            m_synced_lim.pop_back();
+            ++num_scopes;
+        }
+        for (unsigned i = 0; i < m_num_threads; ++i) {
+            context& pctx = *m_pctxs[i];
+            ast_manager& pm = *m_pms[i];
+            pm.limit().reset_cancel();
+            if (num_scopes > 0)
+                pctx.pop(num_scopes);
+            if (sz == m_synced.size())
+                continue;
+            pctx.push();
+            ast_translation tr(m, pm);
+            for (unsigned j = m_synced.size(); j < sz; ++j) 
+                pctx.assert_expr(tr(af.get_formula(j)));
+        }
+        if (sz > m_synced.size()) {
+            m_synced_lim.push_back(m_synced.size());
+            for (unsigned j = m_synced.size(); j < sz; ++j) 
+                m_synced.push_back(af.get_formula(j));
+        }
+        IF_VERBOSE(2, verbose_stream() << "(smt.parallel :sync " << sz << " :scopes " << m_synced_lim.size() << ")\n";);
+        return true;
+    }
     
     lbool parallel::operator()(expr_ref_vector const& asms) {
 
@@ -60,116 +146,186 @@ namespace smt {
             ERROR_EX
         };
 
-        vector<smt_params> smt_params;
-        scoped_ptr_vector<ast_manager> pms;
-        scoped_ptr_vector<context> pctxs;
-        vector<expr_ref_vector> pasms;
-
         ast_manager& m = ctx.m;
         scoped_limits sl(m.limit());
         unsigned finished_id = UINT_MAX;
         std::string        ex_msg;
         par_exception_kind ex_kind = DEFAULT_EX;
         unsigned error_code = 0;
-        bool done = false;
-        unsigned num_rounds = 0;
+        std::atomic<bool> done(false);
         if (m.has_trace_stream())
             throw default_exception("trace streams have to be off in parallel mode");
 
-        
-        for (unsigned i = 0; i < num_threads; ++i) {
-            smt_params.push_back(ctx.get_fparams());
-        }
+        if (num_threads != m_num_threads || !sync())
+            init(num_threads);
+
+        auto& pms = m_pms;
+        auto& pctxs = m_pctxs;
+        vector<expr_ref_vector> pasms;
         for (unsigned i = 0; i < num_threads; ++i) {
-            ast_manager* new_m = alloc(ast_manager, m, true);
-            pms.push_back(new_m);
-            pctxs.push_back(alloc(context, *new_m, smt_params[i], ctx.get_params())); 
-            context& new_ctx = *pctxs.back();
-            context::copy(ctx, new_ctx, true);
-            new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
-            ast_translation tr(m, *new_m);
+            ast_manager& pm = *pms[i];
+            pm.limit().reset_cancel();
+            ast_translation tr(m, pm);
             pasms.push_back(tr(asms));
-            sl.push_child(&(new_m->limit()));
+            sl.push_child(&(pm.limit()));
         }
 
-        auto cube = [](context& ctx, expr_ref_vector& lasms, expr_ref& c) {
-            lookahead lh(ctx);
-            c = lh.choose();
-            if (c) {
-                if ((ctx.get_random_value() % 2) == 0) 
-                    c = c.get_manager().mk_not(c);
-                lasms.push_back(c);
+        // Workers run asynchronously. Each worker repeatedly takes a cube from the shared
+        // work queue, or solves the original problem if the queue is empty. When the conflict
+        // budget for a cube runs out, the cube is split using lookahead and the two new cubes
+        // are added to the queue. Refuted cubes become lemmas, and lemmas and units are shared 
+        // through a trail in the manager of the main context.
+        // All accesses to the main manager are protected by mux.
+
+        std::mutex mux;
+        vector<expr_ref_vector> cubes;               // queue of cubes over ctx.m
+        unsigned const max_cubes = 2 * num_threads;  // cubes are only split if the queue is smaller.
+        expr_ref_vector shared_trail(ctx.m);         // units and lemmas over ctx.m
+        unsigned_vector shared_owner;                // worker that produced the shared formula
+        obj_hashtable<expr> shared_set;              // formulas in the shared trail
+        unsigned_vector shared_lim(num_threads, 0u); // prefix of the shared trail imported by each worker
+
+        auto cancel_others = [&](unsigned i) {
+            for (unsigned j = 0; j < num_threads; ++j) 
+                if (j != i) 
+                    pms[j]->limit().cancel();
+        };
+
+        // export base level literals of pctx and import formulas shared by other workers.
+        auto exchange = [&](unsigned i, unsigned& unit_lim) {
+            context& pctx = *pctxs[i];
+            ast_manager& pm = *pms[i];
+            pctx.pop_to_base_lvl();
+            std::lock_guard<std::mutex> lock(mux);
+            ast_translation tr(pm, ctx.m);
+            unsigned sz = pctx.assigned_literals().size();
+            for (unsigned j = unit_lim; j < sz; ++j) {
+                literal lit = pctx.assigned_literals()[j];
+                expr_ref e(pctx.bool_var2expr(lit.var()), pm);
+                if (!e)
+                    continue;
+                if (lit.sign()) e = pm.mk_not(e);
+                expr_ref ce(tr(e.get()), ctx.m);
+                if (shared_set.contains(ce))
+                    continue;
+                shared_set.insert(ce);
+                shared_trail.push_back(ce);
+                shared_owner.push_back(i);
+            }
+            unit_lim = sz;
+            ast_translation tr2(ctx.m, pm);
+            for (unsigned j = shared_lim[i]; j < shared_trail.size(); ++j) {
+                if (shared_owner[j] != i) 
+                    pctx.assert_expr(tr2(shared_trail.get(j)));
             }
+            shared_lim[i] = shared_trail.size();
         };
 
-        obj_hashtable<expr> unit_set;
-        expr_ref_vector unit_trail(ctx.m);
-        unsigned_vector unit_lim;
-        for (unsigned i = 0; i < num_threads; ++i) unit_lim.push_back(0);
+        auto share_lemma = [&](unsigned i, expr* lemma) {
+            std::lock_guard<std::mutex> lock(mux);
+            ast_translation tr(*pms[i], ctx.m);
+            shared_trail.push_back(tr(lemma));
+            shared_owner.push_back(i);
+        };
 
-        std::function<void(void)> collect_units = [&,this]() {
-            for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
-                pctx.pop_to_base_lvl();
-                ast_translation tr(pctx.m, ctx.m);
-                unsigned sz = pctx.assigned_literals().size();
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
-                    literal lit = pctx.assigned_literals()[j];
-                    expr_ref e(pctx.bool_var2expr(lit.var()), pctx.m);
-                    if (lit.sign()) e = pctx.m.mk_not(e);
-                    expr_ref ce(tr(e.get()), ctx.m);
-                    if (!unit_set.contains(ce)) {
-                        unit_set.insert(ce);
-                        unit_trail.push_back(ce);
-                    }
-                }
-            }
+        // take the most recent cube (depth first), or return the empty cube.
+        auto take_cube = [&](unsigned i, expr_ref_vector& cube) {
+            std::lock_guard<std::mutex> lock(mux);
+            cube.reset();
+            if (cubes.empty())
+                return;
+            ast_translation tr(ctx.m, *pms[i]);
+            for (expr* e : cubes.back()) 
+                cube.push_back(tr(e));
+            cubes.pop_back();
+        };
 
-            unsigned sz = unit_trail.size();
-            for (unsigned i = 0; i < num_threads; ++i) {
-                context& pctx = *pctxs[i];
-                ast_translation tr(ctx.m, pctx.m);
-                for (unsigned j = unit_lim[i]; j < sz; ++j) {
-                    expr_ref src(ctx.m), dst(pctx.m);
-                    dst = tr(unit_trail.get(j));
-                    pctx.assert_expr(dst);
-                }
-                unit_lim[i] = sz;
+        // split cube using a lookahead literal. Return false if no split is performed.
+        auto split_cube = [&](unsigned i, expr_ref_vector const& cube) {
+            context& pctx = *pctxs[i];
+            ast_manager& pm = *pms[i];
+            {
+                std::lock_guard<std::mutex> lock(mux);
+                if (cubes.size() >= max_cubes)
+                    return false;
             }
-            IF_VERBOSE(1, verbose_stream() << "(smt.thread :units " << sz << ")\n");
+            lookahead lh(pctx);
+            expr_ref c(lh.choose(), pm);
+            if (!c)
+                return false;
+            IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :split " << mk_bounded_pp(c, pm, 3) << ")\n";);
+            std::lock_guard<std::mutex> lock(mux);
+            ast_translation tr(pm, ctx.m);
+            expr_ref_vector c1(ctx.m), c2(ctx.m);
+            for (expr* e : cube) {
+                c1.push_back(tr(e));
+                c2.push_back(c1.back());
+            }
+            c1.push_back(tr(c.get()));
+            c2.push_back(ctx.m.mk_not(c1.back()));
+            if ((pctx.get_random_value() % 2) == 0) 
+                std::swap(c1, c2);
+            cubes.push_back(c1);
+            cubes.push_back(c2);
+            return true;
         };
 
-        std::mutex mux;
+        auto in_core = [](context& pctx, expr_ref_vector const& cube) {
+            for (expr* c : cube)
+                if (pctx.unsat_core().contains(c))
+                    return true;
+            return false;
+        };
 
         auto worker_thread = [&](int i) {
             try {
                 context& pctx = *pctxs[i];
                 ast_manager& pm = *pms[i];
-                expr_ref_vector lasms(pasms[i]);
-                expr_ref c(pm);
-
-                pctx.get_fparams().m_max_conflicts = std::min(thread_max_conflicts, max_conflicts);
-                if (num_rounds > 0 && (pctx.get_fparams().m_threads_cube_frequency % num_rounds) == 0) {
-                    cube(pctx, lasms, c);
-                }
-                IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i; 
-                           if (num_rounds > 0) verbose_stream() << " :round " << num_rounds;
-                           if (c) verbose_stream() << " :cube " << mk_bounded_pp(c, pm, 3);
-                           verbose_stream() << ")\n";);
-                lbool r = pctx.check(lasms.size(), lasms.c_ptr());
-                
-                if (r == l_undef && pctx.m_num_conflicts >= max_conflicts) {
-                    // no-op
+                expr_ref_vector cube(pm);
+                unsigned conflicts = thread_max_conflicts;
+                unsigned remaining = max_conflicts;
+                pctx.pop_to_base_lvl();
+                unsigned unit_lim = pctx.assigned_literals().size();
+                bool need_cube = true;
+                lbool r = l_undef;
+                while (true) {
+                    if (done)
+                        return;
+                    exchange(i, unit_lim);
+                    if (need_cube) {
+                        take_cube(i, cube);
+                        conflicts = thread_max_conflicts;
+                    }
+                    expr_ref_vector lasms(pasms[i]);
+                    lasms.append(cube);
+                    pctx.get_fparams().m_max_conflicts = std::min(conflicts, remaining);
+                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :cube-size " << cube.size() 
+                               << " :conflicts " << pctx.get_fparams().m_max_conflicts << ")\n";);
+                    r = pctx.check(lasms.size(), lasms.c_ptr());
+                    remaining -= std::min(remaining, pctx.m_num_conflicts);
+
+                    if (r == l_undef && remaining == 0) {
+                        break;
+                    }
+                    else if (r == l_undef && pctx.m_num_conflicts >= pctx.get_fparams().m_max_conflicts) {
+                        if (pm.limit().is_canceled())
+                            return;
+                        exchange(i, unit_lim);
+                        need_cube = split_cube(i, cube);
+                        if (!need_cube)
+                            conflicts *= 2;
+                        continue;
+                    }
+                    else if (r == l_false && in_core(pctx, cube)) {
+                        expr_ref lemma(mk_not(mk_and(pctx.unsat_core())), pm);
+                        IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :learn " << mk_bounded_pp(lemma, pm, 3) << ")\n";);
+                        pctx.assert_expr(lemma);
+                        share_lemma(i, lemma);
+                        need_cube = true;
+                        continue;
+                    }
+                    break;
                 }
-                else if (r == l_undef && pctx.m_num_conflicts >= thread_max_conflicts) {
-                    return;
-                }                
-                else if (r == l_false && pctx.unsat_core().contains(c)) {
-                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :learn " << mk_bounded_pp(c, pm, 3) << ")");
-                    pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
-                    return;
-                } 
-                
 
                 bool first = false;
                 {
@@ -186,41 +342,31 @@ namespace smt {
                     }
                     else if (!first) return;
                 }
-
-                for (ast_manager* m : pms) {
-                    if (m != &pm) m->limit().cancel();
-                }
-
+                cancel_others(i);
             }
             catch (z3_error & err) {
-                error_code = err.error_code();
-                ex_kind = ERROR_EX;                
+                {
+                    std::lock_guard<std::mutex> lock(mux);
+                    error_code = err.error_code();
+                    ex_kind = ERROR_EX;
+                }
                 done = true;
+                cancel_others(i);
             }
             catch (z3_exception & ex) {
-                ex_msg = ex.msg();
-                ex_kind = DEFAULT_EX;    
+                {
+                    std::lock_guard<std::mutex> lock(mux);
+                    ex_msg = ex.msg();
+                    ex_kind = DEFAULT_EX;
+                }
                 done = true;
+                cancel_others(i);
             }
         };
 
         // for debugging:  num_threads = 1;
 
-        while (true) {
-            vector<std::thread> threads(num_threads);
-            for (unsigned i = 0; i < num_threads; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
-            for (auto & th : threads) {
-                th.join();
-            }
-            if (done) break;
-
-            collect_units();
-            ++num_rounds;
-            max_conflicts = (max_conflicts < thread_max_conflicts) ? 0 : (max_conflicts - thread_max_conflicts);
-            thread_max_conflicts *= 2;            
-        }
+        parallel_executor::run(num_threads, [&](unsigned i) { worker_thread(i); });
 
         for (context* c : pctxs) {
             c->collect_statistics(ctx.m_aux_stats);
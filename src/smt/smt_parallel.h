@@ -18,14 +18,34 @@ Revision History:
 --*/
 #pragma once
 
+#include "util/scoped_ptr_vector.h"
 #include "smt/smt_context.h"
 
 namespace smt {
 
+    /**
+       \brief Parallel solver for a context.
+       
+       The worker contexts are kept between calls so that lemmas learned
+       during one check can be reused in subsequent incremental checks.
+    */
     class parallel {
-        context& ctx;
+        context&                       ctx;
+        unsigned                       m_num_threads;
+        vector<smt_params>             m_smt_params;
+        scoped_ptr_vector<ast_manager> m_pms;
+        scoped_ptr_vector<context>     m_pctxs;
+        expr_ref_vector                m_synced;     // formulas of ctx asserted in the workers.
+        unsigned_vector                m_synced_lim; // size of m_synced when a worker scope was created.
+
+        void reset();
+        void init(unsigned num_threads);
+        bool sync();
+
     public:
-        parallel(context& ctx): ctx(ctx) {}
+        parallel(context& ctx): ctx(ctx), m_num_threads(0), m_synced(ctx.m) {}
+
+        ~parallel() { reset(); }
 
         lbool operator()(expr_ref_vector const& asms);
 
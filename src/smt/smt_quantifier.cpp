@@ -16,6 +16,8 @@ Author:
 Revision History:
 
 --*/
+#include "util/profiler.h"
+#include "util/stopwatch.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "smt/smt_quantifier.h"
@@ -134,6 +136,8 @@ namespace smt {
         ptr_vector<quantifier>                 m_quantifiers;
         scoped_ptr<quantifier_manager_plugin>  m_plugin;
         unsigned                               m_num_instances;
+        unsigned                               m_num_throttled;
+        stopwatch                              m_watch;
 
         imp(quantifier_manager & wrapper, context & ctx, smt_params & p, quantifier_manager_plugin * plugin):
             m_wrapper(wrapper),
@@ -143,6 +147,7 @@ namespace smt {
             m_qstat_gen(ctx.get_manager(), ctx.get_region()),
             m_plugin(plugin) {
             m_num_instances = 0;
+            m_num_throttled = 0;
             m_qi_queue.setup();
         }
 
@@ -300,6 +305,10 @@ namespace smt {
             if (m_num_instances > m_params.m_qi_max_instances) {
                 return false;
             }
+            if (is_throttled(q)) {
+                m_num_throttled++;
+                return false;
+            }
             get_stat(q)->update_max_generation(max_generation);
             fingerprint * f = m_context.add_fingerprint(q, q->get_id(), num_bindings, bindings, def);
             if (f) {
@@ -324,10 +333,20 @@ namespace smt {
             return f != nullptr;
         }
 
+        bool is_throttled(quantifier * q) {
+            if (m_params.m_qi_max_instances_per_quantifier == UINT_MAX && m_params.m_qi_max_rate == 0)
+                return false;
+            double now = m_params.m_qi_max_rate == 0 ? 0 : m_watch.get_current_seconds();
+            return get_stat(q)->throttle(now, m_params.m_qi_max_instances_per_quantifier, m_params.m_qi_max_rate);
+        }
+
         void init_search_eh() {
             m_num_instances = 0;
+            m_watch.reset();
+            m_watch.start();
             for (quantifier * q : m_quantifiers) {
                 get_stat(q)->reset_num_instances_curr_search();
+                get_stat(q)->reset_throttle();
             }
             m_qi_queue.init_search_eh();
             m_plugin->init_search_eh();
@@ -564,6 +583,7 @@ namespace smt {
 
     void quantifier_manager::collect_statistics(::statistics & st) const {
         m_imp->m_qi_queue.collect_statistics(st);
+        st.update("quant instances throttled", m_imp->m_num_throttled);
     }
 
     void quantifier_manager::reset_statistics() {
@@ -748,6 +768,7 @@ namespace smt {
         void propagate() override {
             if (!m_active)
                 return;
+            scoped_profile _profile("smt.mam");
             m_mam->match();
             if (!m_context->relevancy() && use_ematching()) {
                 ptr_vector<enode>::const_iterator it  = m_context->begin_enodes();
@@ -29,10 +29,40 @@ namespace smt {
         m_num_instances(0),
         m_num_instances_checker_sat(0),
         m_num_instances_simplify_true(0),
+        m_num_instances_conflict(0),
         m_num_instances_curr_search(0),
         m_num_instances_curr_branch(0),
         m_max_generation(0),
-        m_max_cost(0.0f) {
+        m_max_cost(0.0f),
+        m_num_throttled(0),
+        m_window_instances(0),
+        m_window_start(0),
+        m_suspended_until(0),
+        m_backoff(0) {
+    }
+
+    bool quantifier_stat::throttle(double now, unsigned max_instances, unsigned max_rate) {
+        if (m_num_instances_curr_search >= max_instances || now < m_suspended_until) {
+            m_num_throttled++;
+            return true;
+        }
+        if (max_rate == 0)
+            return false;
+        if (now >= m_window_start + 1.0) {
+            // the quantifier stayed within its rate for a whole window.
+            if (m_window_instances <= max_rate)
+                m_backoff = 0;
+            m_window_start = now;
+            m_window_instances = 0;
+        }
+        if (++m_window_instances <= max_rate)
+            return false;
+        m_suspended_until = now + 0.1 * (1u << std::min(m_backoff, 10u));
+        m_backoff++;
+        m_window_start = m_suspended_until;
+        m_window_instances = 0;
+        m_num_throttled++;
+        return true;
     }
 
     quantifier_stat_gen::quantifier_stat_gen(ast_manager & m, region & r):
@@ -38,10 +38,16 @@ namespace smt {
         unsigned m_num_instances;
         unsigned m_num_instances_checker_sat;
         unsigned m_num_instances_simplify_true;
+        unsigned m_num_instances_conflict;   //!< instances that were false in the assignment when they were created
         unsigned m_num_instances_curr_search;
         unsigned m_num_instances_curr_branch; //!< only updated if QI_TRACK_INSTANCES is true
         unsigned m_max_generation; //!< max. generation of an instance
         float    m_max_cost;
+        unsigned m_num_throttled;            //!< instances dropped because of the budget or the rate limit
+        unsigned m_window_instances;         //!< instances in the current rate window
+        double   m_window_start;
+        double   m_suspended_until;
+        unsigned m_backoff;                  //!< number of consecutive suspensions
 
         friend class quantifier_stat_gen;
 
@@ -77,6 +83,9 @@ namespace smt {
         unsigned get_num_instances_checker_sat() const {
             return m_num_instances_checker_sat;
         }
+        unsigned get_num_instances_conflict() const {
+            return m_num_instances_conflict;
+        }
 
         unsigned get_num_instances_curr_search() const {
             return m_num_instances_curr_search;
@@ -93,6 +102,10 @@ namespace smt {
         void inc_num_instances_checker_sat() {
             m_num_instances_checker_sat++;
         }
+
+        void inc_num_instances_conflict() {
+            m_num_instances_conflict++;
+        }
         
         void inc_num_instances() {
             m_num_instances++;
@@ -124,6 +137,29 @@ namespace smt {
         float get_max_cost() const {
             return m_max_cost;
         }
+
+        unsigned get_num_throttled() const {
+            return m_num_throttled;
+        }
+
+        /**
+           \brief Return true if a new instance of the quantifier must be dropped
+           because it exceeds the budget of max_instances instances in the
+           current search, or the rate of max_rate instances per second (0 for
+           no limit) at time now, in seconds.
+
+           A quantifier that exceeds its rate is suspended, for 0.1 seconds the
+           first time and twice as long each time it exceeds its rate again
+           right after a suspension.
+        */
+        bool throttle(double now, unsigned max_instances, unsigned max_rate);
+
+        void reset_throttle() {
+            m_window_instances = 0;
+            m_window_start = 0;
+            m_suspended_until = 0;
+            m_backoff = 0;
+        }
     };
 
     /**
@@ -82,6 +82,14 @@ namespace smt {
         void operator()(relevancy_propagator & rp) override;
     };
 
+    class lazy_ite_term_relevancy_eh : public relevancy_eh {
+        app  * m_parent;
+    public:
+        lazy_ite_term_relevancy_eh(app * p):m_parent(p) {}
+        ~lazy_ite_term_relevancy_eh() override {}
+        void operator()(relevancy_propagator & rp) override;
+    };
+
     relevancy_propagator::relevancy_propagator(context & ctx):
         m_context(ctx) {
     }
@@ -125,6 +133,10 @@ namespace smt {
     relevancy_eh * relevancy_propagator::mk_term_ite_relevancy_eh(app * c, app * t, app * e) {
         return mk_relevancy_eh(ite_term_relevancy_eh(c, t, e));
     }
+
+    relevancy_eh * relevancy_propagator::mk_lazy_term_ite_relevancy_eh(app * n) {
+        return mk_relevancy_eh(lazy_ite_term_relevancy_eh(n));
+    }
     
     struct relevancy_propagator_imp : public relevancy_propagator {
         unsigned                       m_qhead;
@@ -143,9 +155,14 @@ namespace smt {
             expr * get_node() const { return m_node; }
         };
         svector<eh_trail>              m_trail;
+        // ids of relevant or-applications (and-applications) assigned to true (false) 
+        // that already have a relevant child assigned to true (false).
+        uint_set                       m_justified;
+        unsigned_vector                m_justified_trail;
         struct scope {
             unsigned m_relevant_exprs_lim;
             unsigned m_trail_lim;
+            unsigned m_justified_lim;
         };
         svector<scope>                 m_scopes;
         bool                           m_propagating;
@@ -253,6 +270,7 @@ namespace smt {
             scope & s                  = m_scopes.back();
             s.m_relevant_exprs_lim     = m_relevant_exprs.size();
             s.m_trail_lim              = m_trail.size();
+            s.m_justified_lim          = m_justified_trail.size();
         }
 
         void pop(unsigned num_scopes) override {
@@ -263,6 +281,9 @@ namespace smt {
             scope & s        = m_scopes[new_lvl];
             unmark_relevant_exprs(s.m_relevant_exprs_lim);
             undo_trail(s.m_trail_lim);
+            for (unsigned i = s.m_justified_lim; i < m_justified_trail.size(); ++i)
+                m_justified.remove(m_justified_trail[i]);
+            m_justified_trail.shrink(s.m_justified_lim);
             m_scopes.shrink(new_lvl);
         }
 
@@ -302,6 +323,13 @@ namespace smt {
             m_trail.shrink(old_lim);
         }
 
+        void set_justified(app * n) {
+            if (!m_justified.contains(n->get_id())) {
+                m_justified.insert(n->get_id());
+                m_justified_trail.push_back(n->get_id());
+            }
+        }
+
         void set_relevant(expr * n) {
             m_is_relevant.insert(n->get_id());
             m_relevant_exprs.push_back(n);
@@ -376,19 +404,25 @@ namespace smt {
             case l_undef:
                 break;
             case l_true: {
+                if (m_justified.contains(n->get_id()))
+                    return;
                 expr * true_arg = nullptr;
                 unsigned num_args = n->get_num_args();
                 for (unsigned i = 0; i < num_args; i++) {
                     expr * arg  = n->get_arg(i);
                     if (m_context.find_assignment(arg) == l_true) {
-                        if (is_relevant_core(arg))
+                        if (is_relevant_core(arg)) {
+                            set_justified(n);
                             return;
+                        }
                         else if (!true_arg)
                             true_arg = arg;
                     }
                 }
-                if (true_arg)
+                if (true_arg) {
                     mark_as_relevant(true_arg);
+                    set_justified(n);
+                }
                 break;
             } }
         }
@@ -400,19 +434,25 @@ namespace smt {
             lbool val    = m_context.find_assignment(n);
             switch (val) {
             case l_false: {
+                if (m_justified.contains(n->get_id()))
+                    return;
                 expr * false_arg = nullptr;
                 unsigned num_args = n->get_num_args();
                 for (unsigned i = 0; i < num_args; i++) {
                     expr * arg  = n->get_arg(i);
                     if (m_context.find_assignment(arg) == l_false) {
-                        if (is_relevant_core(arg))
+                        if (is_relevant_core(arg)) {
+                            set_justified(n);
                             return; 
+                        }
                         else if (!false_arg)
                             false_arg = arg;
                     }
                 }
-                if (false_arg)
+                if (false_arg) {
                     mark_as_relevant(false_arg);
+                    set_justified(n);
+                }
                 break;
             }
             case l_undef:
@@ -671,6 +711,25 @@ namespace smt {
         }
     }
 
+    void lazy_ite_term_relevancy_eh::operator()(relevancy_propagator & rp) {
+        if (!rp.is_relevant(m_parent))
+            return;
+        rp.mark_as_relevant(m_parent->get_arg(0));
+        context & ctx = rp.get_context();
+        switch (ctx.get_assignment(m_parent->get_arg(0))) {
+        case l_false:
+            TRACE("ite_term_relevancy", tout << "defining else: #" << m_parent->get_id() << "\n";);
+            ctx.push_lazy_ite_branch(m_parent, false);
+            break;
+        case l_undef:
+            break;
+        case l_true:
+            TRACE("ite_term_relevancy", tout << "defining then: #" << m_parent->get_id() << "\n";);
+            ctx.push_lazy_ite_branch(m_parent, true);
+            break;
+        }
+    }
+
     relevancy_propagator * mk_relevancy_propagator(context & ctx) { return alloc(relevancy_propagator_imp, ctx); }
 };
 
@@ -194,6 +194,7 @@ namespace smt {
         relevancy_eh * mk_and_relevancy_eh(app * n);
         relevancy_eh * mk_ite_relevancy_eh(app * n);
         relevancy_eh * mk_term_ite_relevancy_eh(app * c, app * t, app * e);
+        relevancy_eh * mk_lazy_term_ite_relevancy_eh(app * n);
     };
 
     relevancy_propagator * mk_relevancy_propagator(context & ctx);
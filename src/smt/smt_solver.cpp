@@ -220,6 +220,10 @@ namespace {
             m_context.user_propagate_register_fixed(fixed_eh);
         }
 
+        void user_propagate_register_fixed_batch(solver::fixed_batch_eh_t& fixed_batch_eh) override {
+            m_context.user_propagate_register_fixed_batch(fixed_batch_eh);
+        }
+
         void user_propagate_register_final(solver::final_eh_t& final_eh) override {
             m_context.user_propagate_register_final(final_eh);
         }
@@ -44,6 +44,7 @@ namespace smt {
         unsigned m_num_interface_eqs;
         unsigned m_max_generation;
         unsigned m_num_minimized_lits;
+        unsigned m_num_strengthened_lits;
         unsigned m_num_checks;
         unsigned m_num_simplifications;
         unsigned m_num_del_clauses;
@@ -33,6 +33,7 @@ namespace smt {
         m_bits.push_back(literal_vector());
         m_wpos.push_back(0);
         m_zero_one_bits.push_back(zero_one_bits());
+        m_bound_occs.push_back(nullptr);
         ctx.attach_th_var(n, this, r);
         return r;
     }
@@ -507,6 +508,12 @@ namespace smt {
         }
     }
 
+    theory_bv::numeral const & theory_bv::power2(unsigned i) const {
+        for (unsigned j = m_power2.size(); j <= i; ++j) 
+            m_power2.push_back(m_bb.power(j));
+        return m_power2[i];
+    }
+
     bool theory_bv::get_fixed_value(theory_var v, numeral & result)  const {
         result.reset();
         unsigned i = 0;
@@ -977,6 +984,8 @@ namespace smt {
             ctx.mk_th_axiom(get_id(),  l, ~def);
             ctx.mk_th_axiom(get_id(), ~l,  def);
         }
+        if (params().m_bv_bound_propagation) 
+            add_bound_atom(l.var(), get_var(ctx.get_enode(n->get_arg(0))), get_var(ctx.get_enode(n->get_arg(1))), Signed);
     }
 
     bool theory_bv::internalize_carry(app * n, bool gate_ctx) {
@@ -1228,6 +1237,8 @@ namespace smt {
             if (val == l_undef) {
                 continue;
             }
+            if (m_bound_occs[v])
+                m_bound_queue.push_back(v);
             theory_var v2         = next(v);
             TRACE("bv", tout << "propagating v" << v << " #" << get_enode(v)->get_owner_id() << "[" << idx << "] = " << val << " " << ctx.get_scope_level() << "\n";);
             literal antecedent = bit;
@@ -1373,6 +1384,8 @@ namespace smt {
         m_bits.shrink(num_old_vars);
         m_wpos.shrink(num_old_vars);
         m_zero_one_bits.shrink(num_old_vars);
+        m_bound_occs.shrink(num_old_vars);
+        m_bound_queue.reset();
         unsigned old_trail_sz = m_diseq_watch_lim[m_diseq_watch_lim.size()-num_scopes];
         for (unsigned i = m_diseq_watch_trail.size(); i-- > old_trail_sz;) {
             if (!m_diseq_watch[m_diseq_watch_trail[i]].empty()) {
@@ -1561,6 +1574,93 @@ namespace smt {
             }
             m_replay_diseq.reset();
         }
+        propagate_bounds();
+    }
+
+    class add_bound_occ_trail : public trail<theory_bv> {
+        theory_var m_var;
+    public:
+        add_bound_occ_trail(theory_var v):m_var(v) {}
+        void undo(theory_bv & th) override {
+            SASSERT(th.m_bound_occs[m_var]);
+            th.m_bound_occs[m_var] = th.m_bound_occs[m_var]->m_next;
+        }
+    };
+
+    void theory_bv::add_bound_atom(bool_var b, theory_var v1, theory_var v2, bool is_signed) {
+        unsigned idx = m_bound_atoms.size();
+        m_bound_atoms.push_back(bound_atom(b, v1, v2, is_signed));
+        m_trail_stack.push(push_back_trail<theory_bv, bound_atom, false>(m_bound_atoms));
+        add_bound_occ(v1, idx);
+        if (v2 != v1)
+            add_bound_occ(v2, idx);
+        m_bound_queue.push_back(v1);
+    }
+
+    void theory_bv::add_bound_occ(theory_var v, unsigned idx) {
+        m_bound_occs[v] = new (get_region()) bound_occ(idx, m_bound_occs[v]);
+        m_trail_stack.push(add_bound_occ_trail(v));
+    }
+
+    /**
+       \brief compute the interval [lo, hi] of values of v that agree with the
+       assigned bits of v. For signed comparisons the sign bit is flipped, 
+       which maps the signed order onto the unsigned order.
+    */
+    void theory_bv::get_bit_bounds(theory_var v, bool is_signed, numeral & lo, numeral & hi) const {
+        lo.reset();
+        hi.reset();
+        literal_vector const & bits = m_bits[v];
+        unsigned sz = bits.size();
+        for (unsigned i = 0; i < sz; ++i) {
+            lbool val = ctx.get_assignment(bits[i]);
+            if (is_signed && i + 1 == sz)
+                val = ~val;
+            if (val == l_true)
+                lo += power2(i);
+            if (val != l_false)
+                hi += power2(i);
+        }
+    }
+
+    /**
+       \brief v1 <= v2 is true if hi(v1) <= lo(v2) and false if lo(v1) > hi(v2).
+       The justification is the set of assigned bits of v1 and v2.
+    */
+    void theory_bv::propagate_bound(bound_atom const & a) {
+        numeral lo1, hi1, lo2, hi2;
+        get_bit_bounds(a.m_v1, a.m_signed, lo1, hi1);
+        get_bit_bounds(a.m_v2, a.m_signed, lo2, hi2);
+        literal consequent(a.m_var);
+        if (lo1 > hi2)
+            consequent.neg();
+        else if (hi1 > lo2)
+            return;
+        if (ctx.get_assignment(consequent) == l_true)
+            return;
+        literal_vector & lits = m_tmp_literals;
+        lits.reset();
+        for (theory_var v : { a.m_v1, a.m_v2 }) {
+            for (literal b : m_bits[v]) {
+                lbool val = ctx.get_assignment(b);
+                if (val == l_undef || b.var() == true_bool_var)
+                    continue;
+                lits.push_back(val == l_true ? b : ~b);
+            }
+        }
+        TRACE("bv", tout << "bound propagation: " << consequent << " ";
+              ctx.display_literals_verbose(tout, lits) << "\n";);
+        m_stats.m_num_bound_prop++;
+        ctx.assign(consequent, 
+                   ctx.mk_justification(ext_theory_propagation_justification(get_id(), ctx.get_region(), lits.size(), lits.c_ptr(), 0, nullptr, consequent)));
+    }
+
+    void theory_bv::propagate_bounds() {
+        for (unsigned i = 0; i < m_bound_queue.size() && !ctx.inconsistent(); ++i) {
+            for (bound_occ * occ = m_bound_occs[m_bound_queue[i]]; occ && !ctx.inconsistent(); occ = occ->m_next) 
+                propagate_bound(m_bound_atoms[occ->m_atom]);
+        }
+        m_bound_queue.reset();
     }
 
     class bit_eq_justification : public justification {
@@ -1768,6 +1868,7 @@ namespace smt {
         st.update("bv bit2core", m_stats.m_num_bit2core);
         st.update("bv->core eq", m_stats.m_num_th2core_eq);
         st.update("bv dynamic eqs", m_stats.m_num_eq_dynamic);
+        st.update("bv bound propagations", m_stats.m_num_bound_prop);
     }
 
     bool theory_bv::check_assignment(theory_var v) {
@@ -30,7 +30,7 @@ namespace smt {
     
     struct theory_bv_stats {
         unsigned   m_num_diseq_static, m_num_diseq_dynamic, m_num_bit2core, m_num_th2core_eq, m_num_conflicts;
-        unsigned   m_num_eq_dynamic;
+        unsigned   m_num_eq_dynamic, m_num_bound_prop;
         void reset() { memset(this, 0, sizeof(theory_bv_stats)); }
         theory_bv_stats() { reset(); }
     };
@@ -69,6 +69,25 @@ namespace smt {
             bool is_bit() const override { return false; }
         };
 
+        /**
+           \brief comparison atom (bvule or bvsle) whose truth value is propagated
+           from the intervals spanned by the known bits of its arguments.
+        */
+        struct bound_atom {
+            bool_var   m_var;
+            theory_var m_v1;
+            theory_var m_v2;
+            bool       m_signed;
+            bound_atom(bool_var b, theory_var v1, theory_var v2, bool is_signed):
+                m_var(b), m_v1(v1), m_v2(v2), m_signed(is_signed) {}
+        };
+
+        struct bound_occ {
+            unsigned    m_atom;
+            bound_occ * m_next;
+            bound_occ(unsigned a, bound_occ * next):m_atom(a), m_next(next) {}
+        };
+
         /**
            \brief Structure used to store the position of a bitvector variable that
            contains the true_literal/false_literal.
@@ -133,6 +152,9 @@ namespace smt {
 
         literal_vector           m_tmp_literals;
         svector<var_pos>         m_prop_queue;
+        svector<bound_atom>      m_bound_atoms;
+        ptr_vector<bound_occ>    m_bound_occs;  // per var, the bound atoms it is an argument of.
+        svector<theory_var>      m_bound_queue;
         bool                     m_approximates_large_bvs;
 
         theory_var find(theory_var v) const { return m_find.find(v); }
@@ -173,6 +195,13 @@ namespace smt {
         void fixed_var_eh(theory_var v);
         void add_fixed_eq(theory_var v1, theory_var v2);
         bool get_fixed_value(theory_var v, numeral & result) const;
+        numeral const & power2(unsigned i) const;
+        friend class add_bound_occ_trail;
+        void add_bound_atom(bool_var b, theory_var v1, theory_var v2, bool is_signed);
+        void add_bound_occ(theory_var v, unsigned idx);
+        void get_bit_bounds(theory_var v, bool is_signed, numeral & lo, numeral & hi) const;
+        void propagate_bound(bound_atom const & a);
+        void propagate_bounds();
         bool internalize_term_core(app * term);
         void internalize_num(app * n);
         void internalize_add(app * n);
@@ -240,7 +269,7 @@ namespace smt {
         bool include_func_interp(func_decl* f) override;
         svector<theory_var>   m_merge_aux[2]; //!< auxiliary vector used in merge_zero_one_bits
         bool merge_zero_one_bits(theory_var r1, theory_var r2);
-        bool can_propagate() override { return !m_replay_diseq.empty(); }
+        bool can_propagate() override { return !m_replay_diseq.empty() || !m_bound_queue.empty(); }
         void propagate() override;
 
         // -----------------------------------
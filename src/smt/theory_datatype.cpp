@@ -268,6 +268,12 @@ namespace smt {
         ctx.attach_th_var(n, this, r);
         if (is_constructor(n)) {
             d->m_constructor = n;
+            m_oc_touched.push_back(r);
+            for (enode * arg : enode::args(n)) {
+                sort * s = m.get_sort(arg->get_owner());
+                if (m_autil.is_array(s) && m_util.is_datatype(get_array_range(s)))
+                    m_oc_arrays = true;
+            }
             assert_accessor_axioms(n);
         }
         else if (is_update_field(n)) {
@@ -468,6 +474,11 @@ namespace smt {
             return;
         m_trail_stack.pop_scope(num_scopes);
         unsigned num_old_vars = get_old_num_vars(num_scopes);
+        unsigned j = 0;
+        for (theory_var v : m_oc_touched)
+            if (static_cast<unsigned>(v) < num_old_vars)
+                m_oc_touched[j++] = v;
+        m_oc_touched.shrink(j);
         std::for_each(m_var_data.begin() + num_old_vars, m_var_data.end(), delete_proc<var_data>());
         m_var_data.shrink(num_old_vars);
         theory::pop_scope_eh(num_scopes);
@@ -480,10 +491,18 @@ namespace smt {
         int num_vars = get_num_vars();
         final_check_status r = FC_DONE;
         final_check_st _guard(this); 
+        bool full = m_oc_full || m_oc_arrays;
+        if (!full) {
+            for (theory_var v : m_oc_touched) {
+                enode * node = get_enode(m_find.find(v));
+                if (!oc_cycle_free(node) && occurs_check(node))
+                    return FC_CONTINUE;
+            }
+        }
         for (int v = 0; v < num_vars; v++) {
             if (v == static_cast<int>(m_find.find(v))) {
                 enode * node = get_enode(v);
-                if (!oc_cycle_free(node) && occurs_check(node)) {
+                if (full && !oc_cycle_free(node) && occurs_check(node)) {
                     // conflict was detected... 
                     // return...
                     return FC_CONTINUE;
@@ -499,6 +518,8 @@ namespace smt {
                 }
             }
         }
+        m_oc_touched.reset();
+        m_oc_full = false;
         return r;
     }
 
@@ -679,6 +700,8 @@ namespace smt {
         m_trail_stack.reset();
         std::for_each(m_var_data.begin(), m_var_data.end(), delete_proc<var_data>());
         m_var_data.reset();
+        m_oc_touched.reset();
+        m_oc_full = true;
         theory::reset_eh();
         m_util.reset();
         m_stats.reset();
@@ -784,6 +807,7 @@ namespace smt {
         // v1 is the new root
         TRACE("datatype", tout << "merging v" << v1 << " v" << v2 << "\n";);
         SASSERT(v1 == static_cast<int>(m_find.find(v1)));
+        m_oc_touched.push_back(v1);
         var_data * d1 = m_var_data[v1];
         var_data * d2 = m_var_data[v2];
         if (d2->m_constructor != nullptr) {
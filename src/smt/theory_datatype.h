@@ -80,6 +80,11 @@ namespace smt {
         enode_pair_vector     m_used_eqs; // conflict, if any
         parent_tbl            m_parent; // parent explanation for occurs_check
         svector<stack_entry>  m_stack; // stack for DFS for occurs_check
+        // a new cycle passes through a class that was merged or received a
+        // constructor since the last final check without cycles.
+        svector<theory_var>   m_oc_touched;
+        bool                  m_oc_full { true };     // check all classes
+        bool                  m_oc_arrays { false };  // constructors with arrays of datatypes, edges also change with array selects
 
         void clear_mark();
 
@@ -99,11 +99,11 @@ namespace smt {
         };
         
         struct cell_trail {
-            unsigned short m_source;
-            unsigned short m_target;
+            theory_var     m_source;
+            theory_var     m_target;
             edge_id        m_old_edge_id;
             numeral        m_old_distance;
-            cell_trail(unsigned short s, unsigned short t, edge_id old_edge_id, numeral const & old_distance):
+            cell_trail(theory_var s, theory_var t, edge_id old_edge_id, numeral const & old_distance):
                 m_source(s), m_target(t), m_old_edge_id(old_edge_id), m_old_distance(old_distance) {}
         };
         
@@ -123,6 +123,11 @@ namespace smt {
         atoms                 m_bv2atoms;
         edges                 m_edges;  // list of asserted edges
         matrix                m_matrix;
+        // m_reach_succs[v] (m_reach_preds[v]) contains the variables w != v such that the cell of (v, w) 
+        // (of (w, v)) has an edge, in the order in which the cells were connected. 
+        // Cells are disconnected in reverse order by restore_cells, so the lists are stacks.
+        vector<int_vector>    m_reach_succs;
+        vector<int_vector>    m_reach_preds;
         bool_vector         m_is_int;
         vector<cell_trail>    m_cell_trail;
         svector<scope>        m_scopes;
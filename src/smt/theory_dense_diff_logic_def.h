@@ -54,6 +54,8 @@ namespace smt {
         bool is_int  = m_autil.is_int(n->get_owner());
         m_is_int.push_back(is_int);
         m_f_targets.push_back(f_target());
+        m_reach_succs.push_back(int_vector());
+        m_reach_preds.push_back(int_vector());
         for (auto& rows : m_matrix) {
             rows.push_back(cell());
         }
@@ -332,6 +334,12 @@ namespace smt {
             i--;
             cell_trail & t = m_cell_trail[i];
             cell & c       = m_matrix[t.m_source][t.m_target];
+            if (t.m_old_edge_id == null_edge_id) {
+                SASSERT(m_reach_succs[t.m_source].back() == t.m_target);
+                SASSERT(m_reach_preds[t.m_target].back() == t.m_source);
+                m_reach_succs[t.m_source].pop_back();
+                m_reach_preds[t.m_target].pop_back();
+            }
             c.m_edge_id    = t.m_old_edge_id;
             c.m_distance   = t.m_old_distance;
         }
@@ -369,6 +377,8 @@ namespace smt {
         if (num_vars != static_cast<int>(old_num_vars)) {
             m_is_int.shrink(old_num_vars);
             m_f_targets.shrink(old_num_vars);
+            m_reach_succs.shrink(old_num_vars);
+            m_reach_preds.shrink(old_num_vars);
             m_matrix.shrink(old_num_vars);
             for (auto& cells : m_matrix) {
                 cells.shrink(old_num_vars);
@@ -421,6 +431,8 @@ namespace smt {
         m_bv2atoms   .reset();
         m_edges      .reset();
         m_matrix     .reset();
+        m_reach_succs.reset();
+        m_reach_preds.reset();
         m_is_int     .reset();
         m_f_targets  .reset();
         m_cell_trail .reset();
@@ -476,17 +488,19 @@ namespace smt {
         // Compute set F of nodes such that:
         // x in F iff
         //    k + d(t, x) < d(s, x)
+        // Only t and the nodes reachable from t are candidates.
         
         numeral new_dist;
         row & t_row                = m_matrix[t];
-        typename row::iterator it           = t_row.begin();
-        typename row::iterator end          = t_row.end();
+        int_vector const & t_succs = m_reach_succs[t];
         typename f_targets::iterator fbegin = m_f_targets.begin();
         typename f_targets::iterator target = fbegin;
-        for (theory_var x = 0; it != end; ++it, ++x) {
-            if (it->m_edge_id != null_edge_id && x != s) {
+        for (unsigned i = 0, sz = t_succs.size(); i <= sz; ++i) {
+            theory_var x = i == sz ? t : t_succs[i];
+            if (x != s) {
+                SASSERT(t_row[x].m_edge_id != null_edge_id);
                 new_dist    = k;
-                new_dist   += it->m_distance;
+                new_dist   += t_row[x].m_distance;
                 cell & s_x  = m_matrix[s][x];
                 TRACE("ddl", 
                       tout << "s: #" << get_enode(s)->get_owner_id() << " x: #" << get_enode(x)->get_owner_id() << " new_dist: " << new_dist << "\n";
@@ -503,28 +517,32 @@ namespace smt {
         
         // For each node y such that y --> s, and for each node x in F,
         // check whether d(y, s) + new_dist(x) < d(y, x).
-        typename matrix::iterator it2    = m_matrix.begin();
-        typename matrix::iterator end2   = m_matrix.end();
-        for (theory_var y = 0; it2 != end2; ++it2, ++y) {
+        // The predecessors of s are not changed by the loop because s is not in F.
+        int_vector const & s_preds = m_reach_preds[s];
+        for (unsigned i = 0, sz = s_preds.size(); i <= sz; ++i) {
+            theory_var y = i == sz ? s : s_preds[i];
             if (y != t) {
-                row  & r = *it2;
+                row  & r = m_matrix[y];
                 cell & c = r[s];
-                if (c.m_edge_id != null_edge_id) {
-                    numeral const & d_y_s = c.m_distance;
-                    target = fbegin;
-                    for (; target != fend; ++target) {
-                        theory_var x = target->m_target;
-                        if (x != y) {
-                            new_dist  = d_y_s;
-                            new_dist += target->m_new_distance;
-                            cell & y_x = m_matrix[y][x];
-                            if (y_x.m_edge_id == null_edge_id || new_dist < y_x.m_distance) {
-                                m_cell_trail.push_back(cell_trail(y, x, y_x.m_edge_id, y_x.m_distance));
-                                y_x.m_edge_id  = new_edge_id;
-                                y_x.m_distance = new_dist;
-                                if (!y_x.m_occs.empty()) {
-                                    propagate_using_cell(y, x);
-                                }
+                SASSERT(c.m_edge_id != null_edge_id);
+                numeral const & d_y_s = c.m_distance;
+                target = fbegin;
+                for (; target != fend; ++target) {
+                    theory_var x = target->m_target;
+                    if (x != y) {
+                        new_dist  = d_y_s;
+                        new_dist += target->m_new_distance;
+                        cell & y_x = r[x];
+                        if (y_x.m_edge_id == null_edge_id || new_dist < y_x.m_distance) {
+                            m_cell_trail.push_back(cell_trail(y, x, y_x.m_edge_id, y_x.m_distance));
+                            if (y_x.m_edge_id == null_edge_id) {
+                                m_reach_succs[y].push_back(x);
+                                m_reach_preds[x].push_back(y);
+                            }
+                            y_x.m_edge_id  = new_edge_id;
+                            y_x.m_distance = new_dist;
+                            if (!y_x.m_occs.empty()) {
+                                propagate_using_cell(y, x);
                             }
                         }
                     }
@@ -627,8 +645,17 @@ namespace smt {
     bool theory_dense_diff_logic<Ext>::check_matrix() const {
         int sz = m_matrix.size();
         for (theory_var i = 0; i < sz; i++) {
+            for (theory_var j : m_reach_succs[i]) {
+                SASSERT(i != j && m_matrix[i][j].m_edge_id != null_edge_id);
+            }
+            for (theory_var j : m_reach_preds[i]) {
+                SASSERT(i != j && m_matrix[j][i].m_edge_id != null_edge_id);
+            }
+            unsigned num_succs = 0;
             for (theory_var j = 0; j < sz; j++) {
                 cell const & c = m_matrix[i][j];
+                if (i != j && c.m_edge_id != null_edge_id)
+                    num_succs++;
                 if (c.m_edge_id == self_edge_id) {
                     SASSERT(i == j);
                     SASSERT(c.m_distance.is_zero());
@@ -647,6 +674,7 @@ namespace smt {
                     }
                 }
             }
+            SASSERT(num_succs == m_reach_succs[i].size());
         }
         return true;
     }
@@ -182,6 +182,7 @@ namespace smt {
         ptr_vector<atom>               m_atoms;
         ptr_vector<atom>               m_asserted_atoms;   // set of asserted atoms
         unsigned                       m_asserted_qhead;   
+        int_vector                     m_batch_edges;      // edges of atoms propagated together
         bool_var2atom                  m_bool_var2atom;
         svector<scope>                 m_scopes;
 
@@ -372,6 +373,7 @@ namespace smt {
         unsigned node2simplex(unsigned v);
         unsigned edge2simplex(unsigned e);
         unsigned obj2simplex(unsigned v);
+        void del_simplex_edges();
         unsigned num_simplex_vars();
         bool is_simplex_edge(unsigned e);
         unsigned simplex2edge(unsigned e);
@@ -359,11 +359,8 @@ void theory_diff_logic<Ext>::pop_scope_eh(unsigned num_scopes) {
     unsigned num_edges = m_graph.get_num_edges();
     m_graph.pop(num_scopes);
     CTRACE("arith", !m_graph.is_feasible_dbg(), m_graph.display(tout););
-    if (num_edges != m_graph.get_num_edges() && m_num_simplex_edges > 0) {
-        m_S.reset();
-        m_num_simplex_edges = 0;
-        m_objective_rows.reset();
-    }
+    if (num_edges != m_graph.get_num_edges() && m_num_simplex_edges > 0) 
+        del_simplex_edges();
     theory::pop_scope_eh(num_scopes);
 }
 
@@ -568,6 +565,21 @@ void theory_diff_logic<Ext>::inc_conflicts() {
 
 template<typename Ext>
 void theory_diff_logic<Ext>::propagate_core() {
+    // When many atoms are pending, for instance when propagation was deferred
+    // until final_check, their edges are enabled together and the graph is 
+    // repaired by a single relaxation.
+    unsigned const batch_threshold = 8;
+    if (m_asserted_atoms.size() >= m_asserted_qhead + batch_threshold && !ctx.inconsistent()) {
+        m_batch_edges.reset();
+        for (unsigned i = m_asserted_qhead; i < m_asserted_atoms.size(); ++i)
+            m_batch_edges.push_back(m_asserted_atoms[i]->get_asserted_edge());
+        m_asserted_qhead = m_asserted_atoms.size();
+        if (!m_graph.enable_edges(m_batch_edges.size(), m_batch_edges.c_ptr())) {
+            TRACE("arith", display(tout););
+            set_neg_cycle_conflict();
+        }
+        return;
+    }
     bool consistent = true;
     while (consistent && can_propagate()) {
         atom * a = m_asserted_atoms[m_asserted_qhead];
@@ -1146,6 +1158,30 @@ unsigned theory_diff_logic<Ext>::simplex2edge(unsigned e) {
     return (e - m_objectives.size())/2;
 }
 
+/**
+   \brief Remove the rows of edges that were popped from the graph, keeping the
+   basis of the remaining rows as a warm start for the next optimization.
+   The simplex is rebuilt if a row of an objective had to be removed.
+*/
+template<typename Ext>
+void theory_diff_logic<Ext>::del_simplex_edges() {
+    unsigned num_edges = m_graph.get_num_edges();
+    while (m_num_simplex_edges > num_edges) {
+        --m_num_simplex_edges;
+        unsigned v = edge2simplex(m_num_simplex_edges);
+        m_S.unset_upper(v);
+        m_S.del_row(v);
+    }
+    for (Simplex::row const& r : m_objective_rows) {
+        if (m_S.get_base_var(r) == Simplex::null_var) {
+            m_S.reset();
+            m_num_simplex_edges = 0;
+            m_objective_rows.reset();
+            return;
+        }
+    }
+}
+
 template<typename Ext> 
 void theory_diff_logic<Ext>::update_simplex(Simplex& S) {
     m_graph.set_to_zero(get_zero(true), get_zero(false));
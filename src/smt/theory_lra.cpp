@@ -992,6 +992,7 @@ public:
         smt_params_helper lpar(ctx().get_params());
         lp().settings().set_resource_limit(m_resource_limit);
         lp().settings().simplex_strategy() = static_cast<lp::simplex_strategy_enum>(lpar.arith_simplex_strategy());
+        lp().settings().presolve_with_double_solver_for_lar = lpar.arith_presolve_with_double();
         lp().settings().bound_propagation() = bound_prop_mode::BP_NONE != propagation_mode();
         lp().settings().enable_hnf() = lpar.arith_enable_hnf();
         lp().settings().print_external_var_name() = lpar.arith_print_ext_var_names();
@@ -1005,6 +1006,7 @@ public:
         lp().set_cut_strategy(branch_cut_ratio);
         
         lp().settings().int_run_gcd_test() = ctx().get_fparams().m_arith_gcd_test;
+        lp().settings().greatest_error_pivot() = ctx().get_fparams().m_arith_pivot_strategy == arith_pivot_strategy::ARITH_PIVOT_GREATEST_ERROR;
         lp().settings().set_random_seed(ctx().get_fparams().m_random_seed);
         m_lia = alloc(lp::int_solver, *m_solver.get());
     }
@@ -1686,11 +1688,17 @@ public:
         return delayed_assume_eqs();
     }
 
+    /**
+       \brief Assume the candidate equalities that still hold in the current model.
+       All of them are assumed in one round, instead of returning to the final 
+       check and recomputing the value classes after each one.
+    */
     bool delayed_assume_eqs() {
         if (m_assume_eq_head == m_assume_eq_candidates.size())
             return false;
             
         ctx().push_trail(value_trail<context, unsigned>(m_assume_eq_head));
+        bool result = false;
         while (m_assume_eq_head < m_assume_eq_candidates.size()) {
             std::pair<theory_var, theory_var> const & p = m_assume_eq_candidates[m_assume_eq_head];
             theory_var v1 = p.first;
@@ -1702,10 +1710,10 @@ public:
                    is_eq(v1, v2) && n1->get_root() != n2->get_root(),
                    tout << "assuming eq: v" << v1 << " = v" << v2 << "\n";);
             if (is_eq(v1, v2) &&  n1->get_root() != n2->get_root() && th.assume_eq(n1, n2)) {
-                return true;
+                result = true;
             }
         }
-        return false;
+        return result;
     }
 
     bool is_eq(theory_var v1, theory_var v2) {
@@ -3938,6 +3946,7 @@ public:
         st.update("arith-hnf-calls", lp().settings().stats().m_hnf_cutter_calls);
         st.update("arith-horner-calls", lp().settings().stats().m_horner_calls);
         st.update("arith-horner-conflicts", lp().settings().stats().m_horner_conflicts);
+        st.update("arith-horner-rows-skipped", lp().settings().stats().m_horner_rows_skipped);
         st.update("arith-horner-cross-nested-forms", lp().settings().stats().m_cross_nested_forms);
         st.update("arith-grobner-calls", lp().settings().stats().m_grobner_calls);
         st.update("arith-grobner-conflicts", lp().settings().stats().m_grobner_conflicts);
@@ -34,6 +34,7 @@ namespace smt {
           m_disabled_guards(m),
           m_enabled_guards(m),
           m_preds(m),
+          m_instance_keys(m),
           m_num_rounds(0),
           m_q_case_expand(), 
           m_q_body_expand() {
@@ -117,6 +118,42 @@ namespace smt {
             dealloc(kv.m_value);
         }
         m_guard2pending.reset();
+        reset_instances();
+    }
+
+    void theory_recfun::reset_instances() {
+        for (auto & kv : m_instances) {
+            dealloc(kv.m_value);
+        }
+        m_instances.reset();
+        m_instance_keys.reset();
+    }
+
+    /**
+     * retrieve the cached instantiation of a case predicate or macro application.
+     * The depth of a term does not change once it is set, so the instance 
+     * only depends on the term.
+     */
+    theory_recfun::case_instance& theory_recfun::get_instance(expr* key) {
+        case_instance* ci = nullptr;
+        if (!m_instances.find(key, ci)) {
+            ci = alloc(case_instance, m);
+            m_instances.insert(key, ci);
+            m_instance_keys.push_back(key);
+        }
+        return *ci;
+    }
+
+    expr_ref_vector const& theory_recfun::get_guards(case_instance& ci, unsigned depth, recfun::vars const& vars, ptr_vector<expr> const& args, recfun::case_def const& c) {
+        if (ci.m_has_guards) {
+            ++m_stats.m_cached_expansions;
+            return ci.m_guards;
+        }
+        for (auto & g : c.get_guards()) {
+            ci.m_guards.push_back(apply_args(depth, vars, args, g));
+        }
+        ci.m_has_guards = true;
+        return ci.m_guards;
     }
 
     /*
@@ -332,9 +369,15 @@ namespace smt {
         SASSERT(e.m_def->is_fun_macro());
         auto & vars = e.m_def->get_vars();
         expr_ref lhs(e.m_lhs, m);
-        unsigned depth = get_depth(e.m_lhs);
-        expr_ref rhs(apply_args(depth, vars, e.m_args, e.m_def->get_rhs()), m);
-        literal lit = mk_eq_lit(lhs, rhs);
+        case_instance& ci = get_instance(e.m_lhs);
+        if (ci.m_rhs) {
+            ++m_stats.m_cached_expansions;
+        }
+        else {
+            unsigned depth = get_depth(e.m_lhs);
+            ci.m_rhs = apply_args(depth, vars, e.m_args, e.m_def->get_rhs());
+        }
+        literal lit = mk_eq_lit(lhs, ci.m_rhs);
         std::function<literal(void)> fn = [&]() { return lit; };
         scoped_trace_stream _tr(*this, fn);
         ctx.mk_th_axiom(get_id(), 1, &lit);
@@ -367,10 +410,7 @@ namespace smt {
 
             unsigned depth = get_depth(e.m_lhs);
             set_depth(depth, pred_applied);
-            expr_ref_vector guards(m);
-            for (auto & g : c.get_guards()) {
-                guards.push_back(apply_args(depth, vars, e.m_args, g));
-            }
+            expr_ref_vector const& guards = get_guards(get_instance(pred_applied), depth, vars, e.m_args, c);
             if (c.is_immediate()) {
                 body_expansion be(pred_applied, c, e.m_args);
                 assert_body_axiom(be);            
@@ -430,13 +470,16 @@ namespace smt {
         SASSERT(is_standard_order(vars));
         unsigned depth = get_depth(e.m_pred);
         expr_ref lhs(u().mk_fun_defined(d, args), m);
-        expr_ref rhs = apply_args(depth, vars, args, e.m_cdef->get_rhs());
+        case_instance& ci = get_instance(e.m_pred);
+        if (!ci.m_rhs) {
+            ci.m_rhs = apply_args(depth, vars, args, e.m_cdef->get_rhs());
+        }
+        expr_ref rhs(ci.m_rhs, m);
         literal_vector clause;
-        for (auto & g : e.m_cdef->get_guards()) {
-            expr_ref guard = apply_args(depth, vars, args, g);
+        for (expr* guard : get_guards(ci, depth, vars, args, *e.m_cdef)) {
             clause.push_back(~mk_literal(guard));
             if (clause.back() == true_literal) {
-                TRACEFN("body " << pp_body_expansion(e,m) << "\n" << clause << "\n" << guard);
+                TRACEFN("body " << pp_body_expansion(e,m) << "\n" << clause << "\n" << mk_pp(guard, m));
                 return;
             }
             if (clause.back() == false_literal) {
@@ -516,6 +559,7 @@ namespace smt {
         st.update("recfun macro expansion", m_stats.m_macro_expansions);
         st.update("recfun case expansion", m_stats.m_case_expansions);
         st.update("recfun body expansion", m_stats.m_body_expansions);
+        st.update("recfun cached expansion", m_stats.m_cached_expansions);
     }
 
     std::ostream& operator<<(std::ostream & out, theory_recfun::pp_case_expansion const & e) {
@@ -27,7 +27,7 @@ namespace smt {
 
     class theory_recfun : public theory {
         struct stats {
-            unsigned m_case_expansions, m_body_expansions, m_macro_expansions;
+            unsigned m_case_expansions, m_body_expansions, m_macro_expansions, m_cached_expansions;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -87,6 +87,15 @@ namespace smt {
         };
 
         friend std::ostream& operator<<(std::ostream&, pp_body_expansion const &);
+
+        // guards and right-hand side of a case predicate or macro application,
+        // instantiated with its arguments. 
+        struct case_instance {
+            expr_ref_vector m_guards;
+            expr_ref        m_rhs;
+            bool            m_has_guards { false };
+            case_instance(ast_manager& m): m_guards(m), m_rhs(m) {}
+        };
         
         recfun::decl::plugin&   m_plugin;
         recfun::util&           m_util;
@@ -99,6 +108,8 @@ namespace smt {
         obj_map<expr, unsigned>  m_pred_depth;
         expr_ref_vector          m_preds;
         unsigned_vector          m_preds_lim;
+        obj_map<expr, case_instance*> m_instances;      // expansions are repeated after backtracking and restarts.
+        expr_ref_vector          m_instance_keys;
         unsigned                 m_num_rounds;
 
         ptr_vector<case_expansion> m_q_case_expand;
@@ -119,6 +130,9 @@ namespace smt {
         void activate_guard(expr* guard, expr_ref_vector const& guards);
 
         void reset_queues();
+        void reset_instances();
+        case_instance& get_instance(expr* key);
+        expr_ref_vector const& get_guards(case_instance& ci, unsigned depth, recfun::vars const& vars, ptr_vector<expr> const& args, recfun::case_def const& c);
         expr_ref apply_args(unsigned depth, recfun::vars const & vars, ptr_vector<expr> const & args, expr * e); //!< substitute variables by args
         void assert_macro_axiom(case_expansion & e);
         void assert_case_axioms(case_expansion & e);
@@ -3058,6 +3058,12 @@ void theory_seq::new_eq_eh(dependency* deps, enode* n1, enode* n2) {
         expr_ref o2(e2, m);
         TRACE("seq", tout << mk_bounded_pp(o1, m) << " = " << mk_bounded_pp(o2, m) << "\n";);
         m_eqs.push_back(mk_eqdep(o1, o2, deps));
+        if (get_fparams().m_seq_length_abstraction) {
+            // the length axioms of concatenations decompose len(o1) = len(o2)
+            // into a linear constraint over the lengths of the parts, so
+            // the arithmetic solver can refute equations before they are solved.
+            add_length_to_eqc(o1);
+        }
         solve_eqs(m_eqs.size()-1);
         enforce_length_coherence(n1, n2);
     }
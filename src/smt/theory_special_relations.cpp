@@ -58,6 +58,7 @@ namespace smt {
         m_scopes.shrink(new_lvl);
         m_graph.pop(num_scopes);        
         m_ufctx.get_trail_stack().pop_scope(num_scopes);
+        m_eqs_generation = UINT_MAX;
     }
 
     void theory_special_relations::relation::ensure_var(theory_var v) {
@@ -510,6 +511,10 @@ namespace smt {
         default:
             break;
         }
+        unsigned generation = r.m_graph.get_generation();
+        if (r.m_eqs_generation == generation) {
+            return false;
+        }
         bool new_eq = false;
         int_vector scc_id;
         u_map<unsigned> roots;
@@ -543,6 +548,9 @@ namespace smt {
                 roots.insert(scc_id[i], i);
             }
         }
+        if (!new_eq && !ctx.inconsistent()) {
+            r.m_eqs_generation = generation;
+        }
         return new_eq;
     }
 
@@ -582,9 +590,14 @@ namespace smt {
     }
 
     lbool theory_special_relations::final_check_po(relation& r) {
+        unsigned generation = r.m_graph.get_generation();
         for (atom* ap : r.m_asserted_atoms) {
             atom& a = *ap;
             if (!a.phase() && r.m_uf.find(a.v1()) == r.m_uf.find(a.v2())) {
+                if (a.unreachable_generation() == generation) {
+                    // no edges were enabled since v2 was found unreachable from v1.
+                    continue;
+                }
                 // v1 !-> v2
                 // find v1 -> v3 -> v4 -> v2 path
                 r.m_explanation.reset();
@@ -596,6 +609,7 @@ namespace smt {
                     set_conflict(r);
                     return l_false;
                 }
+                a.set_unreachable_generation(generation);
             }
         }
         return l_true;
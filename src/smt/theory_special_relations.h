@@ -39,6 +39,7 @@ namespace smt {
             theory_var  m_v2;
             edge_id     m_pos;
             edge_id     m_neg;
+            unsigned    m_unreachable_generation { UINT_MAX }; // graph generation at which v1 did not reach v2
         public:
             atom(bool_var b, relation& r, theory_var v1, theory_var v2):
                 m_bvar(b),
@@ -66,6 +67,8 @@ namespace smt {
                 edge_id edge = m_phase?m_pos:m_neg;
                 return m_relation.m_graph.enable_edge(edge);
             }
+            unsigned unreachable_generation() const { return m_unreachable_generation; }
+            void set_unreachable_generation(unsigned g) { m_unreachable_generation = g; }
         };
         typedef ptr_vector<atom> atoms;
 
@@ -78,6 +81,16 @@ namespace smt {
             typedef literal_vector explanation;
         };
         struct graph : public dl_graph<int_ext> {
+            // number of edges enabled so far. It is not restored on pop, 
+            // nodes that do not reach each other stay unreachable while 
+            // the generation does not change.
+            unsigned m_generation { 0 };
+
+            unsigned get_generation() const { return m_generation; }
+            bool enable_edge(edge_id id) {
+                ++m_generation;
+                return dl_graph<int_ext>::enable_edge(id);
+            }
             bool add_strict_edge(theory_var v1, theory_var v2, literal_vector const& j) {
                 // v1 + 1 <= v2
                 return enable_edge(add_edge(v1, v2, s_integer(-1), j));
@@ -102,8 +115,9 @@ namespace smt {
             union_find_default_ctx m_ufctx;
             union_find_t           m_uf;
             literal_vector         m_explanation;
+            unsigned               m_eqs_generation;   // graph generation at which all equalities were extracted
 
-            relation(sr_property p, func_decl* d, ast_manager& m): m(m), m_next(m), m_property(p), m_decl(d), m_asserted_qhead(0), m_uf(m_ufctx) {}
+            relation(sr_property p, func_decl* d, ast_manager& m): m(m), m_next(m), m_property(p), m_decl(d), m_asserted_qhead(0), m_uf(m_ufctx), m_eqs_generation(UINT_MAX) {}
 
             func_decl* decl() { return m_decl; }
 
@@ -23,7 +23,8 @@ Author:
 using namespace smt;
 
 user_propagator::user_propagator(context& ctx):
-    theory(ctx, ctx.get_manager().mk_family_id("user_propagator"))
+    theory(ctx, ctx.get_manager().mk_family_id("user_propagator")),
+    m_fixed_values(ctx.get_manager())
 {}
 
 user_propagator::~user_propagator() {
@@ -60,6 +61,7 @@ theory * user_propagator::mk_fresh(context * new_ctx) {
     void* ctx = m_fresh_eh(m_user_context, new_ctx->get_manager(), th->m_api_context);
     th->add(ctx, m_push_eh, m_pop_eh, m_fresh_eh);
     if ((bool)m_fixed_eh) th->register_fixed(m_fixed_eh);
+    if ((bool)m_fixed_batch_eh) th->register_fixed_batch(m_fixed_batch_eh);
     if ((bool)m_final_eh) th->register_final(m_final_eh);
     if ((bool)m_eq_eh) th->register_eq(m_eq_eh);
     if ((bool)m_diseq_eh) th->register_diseq(m_diseq_eh);
@@ -67,6 +69,7 @@ theory * user_propagator::mk_fresh(context * new_ctx) {
 }
 
 final_check_status user_propagator::final_check_eh() {
+    flush_fixed();
     if (!(bool)m_final_eh)
         return FC_DONE;
     unsigned sz = m_prop.size();
@@ -75,18 +78,39 @@ final_check_status user_propagator::final_check_eh() {
 }
 
 void user_propagator::new_fixed_eh(theory_var v, expr* value, unsigned num_lits, literal const* jlits) {
-    if (!m_fixed_eh)
+    if (!has_fixed())
         return;
     force_push();
     m_id2justification.setx(v, literal_vector(num_lits, jlits), literal_vector());
+    if (m_fixed_batch_eh) {
+        m_fixed_ids.push_back(v);
+        m_fixed_values.push_back(value);
+        return;
+    }
     m_fixed_eh(m_user_context, this, v, value);
 }
 
+/**
+ * Values are fixed at the current scope level, they are delivered before 
+ * a new level is pushed and dropped when the level is popped.
+ */
+void user_propagator::flush_fixed() {
+    if (m_fixed_ids.empty())
+        return;
+    force_push();
+    m_fixed_batch_eh(m_user_context, this, m_fixed_ids.size(), m_fixed_ids.c_ptr(), m_fixed_values.c_ptr());
+    m_fixed_ids.reset();
+    m_fixed_values.reset();
+}
+
 void user_propagator::push_scope_eh() {
+    flush_fixed();
     ++m_num_scopes;
 }
 
 void user_propagator::pop_scope_eh(unsigned num_scopes) {
+    m_fixed_ids.reset();
+    m_fixed_values.reset();
     unsigned n = std::min(num_scopes, m_num_scopes);
     m_num_scopes -= n;
     num_scopes -= n;
@@ -100,10 +124,11 @@ void user_propagator::pop_scope_eh(unsigned num_scopes) {
 }
 
 bool user_propagator::can_propagate() {
-    return m_qhead < m_prop.size();
+    return m_qhead < m_prop.size() || !m_fixed_ids.empty();
 }
 
 void user_propagator::propagate() {
+    flush_fixed();
     if (m_qhead == m_prop.size())
         return;
     force_push();
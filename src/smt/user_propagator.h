@@ -53,6 +53,7 @@ namespace smt {
         solver::fresh_eh_t     m_fresh_eh;
         solver::final_eh_t     m_final_eh;
         solver::fixed_eh_t     m_fixed_eh;
+        solver::fixed_batch_eh_t m_fixed_batch_eh;
         solver::eq_eh_t        m_eq_eh;
         solver::eq_eh_t        m_diseq_eh;
         solver::context_obj*   m_api_context { nullptr };
@@ -64,9 +65,13 @@ namespace smt {
         literal_vector         m_lits;
         enode_pair_vector      m_eqs;
         stats                  m_stats;
+        unsigned_vector        m_fixed_ids;      // fixed values not yet delivered to m_fixed_batch_eh
+        expr_ref_vector        m_fixed_values;
 
         void force_push();
 
+        void flush_fixed();
+
     public:
         user_propagator(context& ctx);
         
@@ -90,10 +95,15 @@ namespace smt {
 
         void register_final(solver::final_eh_t& final_eh) { m_final_eh = final_eh; }
         void register_fixed(solver::fixed_eh_t& fixed_eh) { m_fixed_eh = fixed_eh; }
+        /*
+         * \brief deliver the values fixed in a propagation round in one call
+         * instead of one call per value.
+         */
+        void register_fixed_batch(solver::fixed_batch_eh_t& fixed_batch_eh) { m_fixed_batch_eh = fixed_batch_eh; }
         void register_eq(solver::eq_eh_t& eq_eh) { m_eq_eh = eq_eh; }
         void register_diseq(solver::eq_eh_t& diseq_eh) { m_diseq_eh = diseq_eh; }
 
-        bool has_fixed() const { return (bool)m_fixed_eh; }
+        bool has_fixed() const { return (bool)m_fixed_eh || (bool)m_fixed_batch_eh; }
 
         void propagate(unsigned num_fixed, unsigned const* fixed_ids, unsigned num_eqs, unsigned const* lhs, unsigned const* rhs, expr* conseq) override;
 
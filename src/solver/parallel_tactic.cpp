@@ -25,13 +25,23 @@ Notes:
   3. Cube using the parameter settings prescribed in m_params.
   4. Optionally pass the cubes as assumptions and solve each sub-cube with a prescribed resource bound.
   5. Assemble cubes that could not be solved and create a cube state.
+
+ When parallel.share.units is set, states exchange units learned at base level through
+ a shared store of expressions over a separate ast_manager. A unit u derived by a state
+ that asserted the cube c is published as the globally valid clause (not c or u), and each
+ state imports the clauses published since its last import before simplifying.
+ Only units over uninterpreted symbols in the shared vocabulary are published: symbols of
+ the input and symbols introduced by the root state before it was first cloned. Fresh
+ symbols created by states after cloning may share names across managers.
  
 --*/
 
 #include "util/scoped_ptr_vector.h"
+#include "util/parallel_executor.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 #include "ast/ast_translation.h"
+#include "ast/decl_collector.h"
 #include "solver/solver.h"
 #include "solver/solver2tactic.h"
 #include "tactic/tactic.h"
@@ -202,6 +212,8 @@ class parallel_tactic : public tactic {
         unsigned        m_depth;                  // number of nested calls to cubing
         double          m_width;                  // estimate of fraction of problem handled by state
         bool            m_giveup;
+        bool            m_is_root;                // state has not been cloned yet
+        unsigned        m_shared_head;            // number of shared clauses imported
 
     public:
         solver_state(ast_manager* m, solver* s, params_ref const& p): 
@@ -212,7 +224,9 @@ class parallel_tactic : public tactic {
             m_solver(s),
             m_depth(0),
             m_width(1.0),
-            m_giveup(false)
+            m_giveup(false),
+            m_is_root(true),
+            m_shared_head(0)
         {
         }
 
@@ -242,6 +256,9 @@ class parallel_tactic : public tactic {
             for (expr* c : m_assumptions) st->m_assumptions.push_back(tr(c));
             st->m_depth = m_depth;
             st->m_width = m_width;
+            st->m_is_root = false;
+            st->m_shared_head = m_shared_head;
+            m_is_root = false;
             return st;
         }
 
@@ -273,6 +290,14 @@ class parallel_tactic : public tactic {
 
         unsigned get_depth() const { return m_depth; }
 
+        bool is_root() const { return m_is_root; }
+
+        unsigned shared_head() const { return m_shared_head; }
+
+        void set_shared_head(unsigned h) { m_shared_head = h; }
+
+        expr_ref_vector const& asserted_cubes() const { return m_asserted_cubes; }
+
         lbool simplify() {
             lbool r = l_undef;
             IF_VERBOSE(2, verbose_stream() << "(parallel.tactic simplify-1)\n";);
@@ -371,6 +396,15 @@ private:
     unsigned      m_last_depth;
     int           m_exn_code;
     std::string   m_exn_msg;
+    bool          m_share_units;
+    unsigned      m_share_max_cube;
+    scoped_ptr<ast_manager>     m_share_m;       // manager owning the shared clauses
+    scoped_ptr<expr_ref_vector> m_shared;        // clauses published by states
+    obj_hashtable<expr>         m_shared_set;
+    obj_hashtable<func_decl>    m_share_decls;   // shared vocabulary
+    scoped_ptr<func_decl_ref_vector> m_share_decls_trail;
+    unsigned      m_num_shared;
+    unsigned      m_num_imported;
 
     void init() {
         parallel_params pp(m_params);
@@ -384,6 +418,10 @@ private:
         m_backtrack_frequency = pp.conquer_backtrack_frequency();
         m_conquer_delay = pp.conquer_delay();
         m_exn_code = 0;
+        m_share_units = pp.share_units();
+        m_share_max_cube = pp.share_max_cube();
+        m_num_shared = 0;
+        m_num_imported = 0;
         m_params.set_bool("override_incremental", true);
         m_core.reset();
     }
@@ -475,6 +513,84 @@ private:
         close_branch(s, l_undef);
     }
 
+    bool in_share_vocabulary(expr* e, bool extend) {
+        decl_collector dc(*m_share_m);
+        dc.visit(e);
+        for (func_decl* f : dc.get_func_decls()) {
+            if (extend) {
+                if (!m_share_decls.contains(f)) m_share_decls_trail->push_back(f);
+                m_share_decls.insert(f);
+            }
+            else if (!m_share_decls.contains(f)) 
+                return false;
+        }
+        return true;
+    }
+
+    /*
+     * \brief publish units that s derived at base level.
+     */
+    void export_units(solver_state& s) {
+        if (!m_share_units || s.has_assumptions()) return;
+        expr_ref_vector const& cubes = s.asserted_cubes();
+        if (cubes.size() > m_share_max_cube) return;
+        ast_manager& m = s.m();
+        expr_ref_vector trail = s.get_solver().get_trail();
+        ptr_vector<expr> vars;
+        expr_ref_vector units(m);
+        for (expr* e : trail) {
+            if (!e || m.is_true(e) || m.is_false(e) || cubes.contains(e)) continue;
+            expr* a = e;
+            m.is_not(e, a);
+            vars.push_back(a);
+            units.push_back(e);
+        }
+        if (units.empty()) return;
+        unsigned_vector depth;
+        s.get_solver().get_levels(vars, depth);
+        expr_ref_vector clause(m);
+        for (expr* c : cubes) clause.push_back(mk_not(m, c));
+        expr_ref_vector lemmas(m);
+        for (unsigned i = 0; i < units.size(); ++i) {
+            if (depth[i] != 0) continue;
+            clause.push_back(units.get(i));
+            lemmas.push_back(mk_or(clause));
+            clause.pop_back();
+        }
+        if (lemmas.empty()) return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ast_translation tr(m, *m_share_m);
+        bool extend = s.is_root();
+        for (expr* e : lemmas) {
+            expr_ref r(tr(e), *m_share_m);
+            if (m_shared_set.contains(r) || !in_share_vocabulary(r, extend)) continue;
+            m_shared_set.insert(r);
+            m_shared->push_back(r);
+            ++m_num_shared;
+        }
+    }
+
+    /*
+     * \brief assert clauses published since the last import of s.
+     */
+    void import_units(solver_state& s) {
+        if (!m_share_units) return;
+        ast_manager& m = s.m();
+        expr_ref_vector lemmas(m);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            unsigned head = s.shared_head();
+            if (head == m_shared->size()) return;
+            ast_translation tr(*m_share_m, m);
+            for (unsigned i = head; i < m_shared->size(); ++i) 
+                lemmas.push_back(tr(m_shared->get(i)));
+            s.set_shared_head(m_shared->size());
+            m_num_imported += lemmas.size();
+        }
+        IF_VERBOSE(2, verbose_stream() << "(tactic.parallel :import " << lemmas.size() << ")\n";);
+        s.get_solver().assert_expr(lemmas);
+    }
+
     void cube_and_conquer(solver_state& s) {
         ast_manager& m = s.m();
         vector<cube_var> cube, hard_cubes, cubes;
@@ -501,12 +617,14 @@ private:
         // simplify
         s.inc_depth(1);
         if (canceled(s)) return;
+        import_units(s);
         switch (s.simplify()) {
         case l_undef: break;
         case l_true:  report_sat(s, nullptr); return;
         case l_false: report_unsat(s); return;                
         }
         if (canceled(s)) return;
+        export_units(s);
         if (s.giveup()) { report_undef(s); return; }
         
         if (memory_pressure()) {
@@ -688,11 +806,7 @@ private:
 
     lbool solve(model_ref& mdl) {        
         add_branches(1);
-        vector<std::thread> threads;
-        for (unsigned i = 0; i < m_num_threads; ++i) 
-            threads.push_back(std::thread([this]() { run_solver(); }));
-        for (std::thread& t : threads) 
-            t.join();
+        parallel_executor::run(m_num_threads, [this](unsigned) { run_solver(); });
         m_queue.stats(m_stats);
         m_manager.limit().reset_cancel();
         if (m_exn_code == -1) 
@@ -744,6 +858,9 @@ public:
         solver* s = m_solver->translate(m, m_params);
         solver_state* st = alloc(solver_state, nullptr, s, m_params);
         m_queue.add_task(st);
+        m_share_m = alloc(ast_manager, m, true);
+        m_shared = alloc(expr_ref_vector, *m_share_m);
+        m_share_decls_trail = alloc(func_decl_ref_vector, *m_share_m);
         expr_ref_vector clauses(m);
         ptr_vector<expr> assumptions;
         obj_map<expr, expr*> bool2dep;
@@ -754,6 +871,11 @@ public:
         for (expr * clause : clauses) {
             s->assert_expr(clause);
         }
+        if (m_share_units) {
+            ast_translation tr(m, *m_share_m);
+            for (expr * clause : clauses) 
+                in_share_vocabulary(tr(clause), true);
+        }
         st->set_assumptions(assumptions);
         model_ref mdl;
         lbool is_sat = solve(mdl);
@@ -788,6 +910,11 @@ public:
     void cleanup() override {
         m_queue.reset();
         m_models.reset();
+        m_shared_set.reset();
+        m_share_decls.reset();
+        m_shared = nullptr;
+        m_share_decls_trail = nullptr;
+        m_share_m = nullptr;
     }
 
     tactic* translate(ast_manager& m) override {
@@ -799,6 +926,8 @@ public:
         m_params.copy(p);
         parallel_params pp(p);
         m_conquer_delay = pp.conquer_delay();
+        m_share_units = pp.share_units();
+        m_share_max_cube = pp.share_max_cube();
     }
 
     void collect_statistics(statistics & st) const override {
@@ -806,6 +935,8 @@ public:
         st.update("par unsat", m_num_unsat);
         st.update("par models", m_models.size());
         st.update("par progress", m_progress);
+        st.update("par shared", m_num_shared);
+        st.update("par imported", m_num_imported);
     }
 
     void reset_statistics() override {
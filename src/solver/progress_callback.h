@@ -27,5 +27,8 @@ public:
 
     // Less frequent invoked.
     virtual void slow_progress_sample() {}
+
+    // Milliseconds between calls to slow_progress_sample, 0 to use the solver configuration.
+    virtual unsigned slow_progress_interval() const { return 0; }
 };
 
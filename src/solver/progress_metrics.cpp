@@ -0,0 +1,58 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    progress_metrics.cpp
+
+Abstract:
+
+    Machine readable progress samples of a running solver.
+
+--*/
+#include <iomanip>
+#include "util/memory_manager.h"
+#include "solver/progress_metrics.h"
+
+// counters that are reported as rates per second.
+static char const * g_rate_keys[] = {
+    "conflicts", "decisions", "propagations", "restarts",
+    "sat conflicts", "sat decisions", "sat restarts"
+};
+
+void progress_metrics::reset() {
+    m_watch.reset();
+    m_watch.start();
+    m_last_time = 0;
+    m_last_values.reset();
+    m_last_values.resize(sizeof(g_rate_keys) / sizeof(char const*), 0);
+}
+
+void progress_metrics::display_json(std::ostream & out, statistics const & st) {
+    double now = m_watch.get_current_seconds();
+    double delta = now - m_last_time;
+    out << std::fixed << std::setprecision(3);
+    out << "{\"time\":" << now;
+    out << ",\"memory\":" << static_cast<double>(memory::get_allocation_size()) / (1024 * 1024);
+    out << ",\"max-memory\":" << static_cast<double>(memory::get_max_used_memory()) / (1024 * 1024);
+    out << ",\"rates\":{";
+    bool first = true;
+    for (unsigned i = 0; i < m_last_values.size(); ++i) {
+        unsigned v = st.get_uint_value(g_rate_keys[i]);
+        if (v == 0)
+            continue;
+        double rate = (delta > 0 && v >= m_last_values[i]) ? (v - m_last_values[i]) / delta : 0;
+        m_last_values[i] = v;
+        if (!first)
+            out << ",";
+        first = false;
+        out << "\"";
+        for (char const * k = g_rate_keys[i]; *k; ++k)
+            out << (*k == ' ' ? '-' : *k);
+        out << "\":" << rate;
+    }
+    out << "},\"stats\":";
+    st.display_json(out);
+    out << "}";
+    m_last_time = now;
+}
@@ -0,0 +1,32 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    progress_metrics.h
+
+Abstract:
+
+    Machine readable progress samples of a running solver.
+
+    Each sample is a single line JSON object with the elapsed time, the
+    memory in use, the rates of the main search counters since the
+    previous sample and the current statistics of the solver.
+
+--*/
+#pragma once
+
+#include "util/statistics.h"
+#include "util/stopwatch.h"
+
+class progress_metrics {
+    stopwatch         m_watch;
+    double            m_last_time;
+    svector<unsigned> m_last_values;
+public:
+    progress_metrics() { reset(); }
+
+    void reset();
+
+    void display_json(std::ostream & out, statistics const & st);
+};
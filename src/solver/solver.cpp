@@ -186,6 +186,23 @@ lbool solver::preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>
     return check_sat(0, nullptr);
 }
 
+expr_ref_vector solver::cubes(expr_ref_vector& vars, unsigned backtrack_level, unsigned max_cubes) {
+    ast_manager& m = get_manager();
+    expr_ref_vector result(m);
+    while (result.size() < max_cubes) {
+        expr_ref_vector c = cube(vars, backtrack_level);
+        backtrack_level = UINT_MAX;
+        if (c.empty())
+            break;
+        if (c.size() == 1 && (m.is_true(c.get(0)) || m.is_false(c.get(0)))) {
+            result.push_back(c.get(0));
+            break;
+        }
+        result.push_back(mk_and(c));
+    }
+    return result;
+}
+
 
 static bool is_m_atom(ast_manager& m, expr* f) {
     if (!is_app(f)) return true;
@@ -324,6 +341,24 @@ expr_ref_vector solver::get_non_units() {
     return result;
 }
 
+expr_ref_vector solver::get_lemmas() {
+    ast_manager& m = get_manager();
+    expr_ref_vector result(m), units(m);
+    ptr_vector<expr> vars;
+    for (expr* e : get_trail()) {
+        if (!e || m.is_true(e) || m.is_false(e)) continue;
+        expr* a = e;
+        m.is_not(e, a);
+        vars.push_back(a);
+        units.push_back(e);
+    }
+    unsigned_vector depth;
+    get_levels(vars, depth);
+    for (unsigned i = 0; i < units.size(); ++i)
+        if (depth[i] == 0)
+            result.push_back(units.get(i));
+    return result;
+}
 
 lbool solver::check_sat(unsigned num_assumptions, expr * const * assumptions) {
     lbool r = l_undef;
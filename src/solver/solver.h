@@ -227,6 +227,12 @@ public:
 
     virtual expr_ref_vector cube(expr_ref_vector& vars, unsigned backtrack_level) = 0;
 
+    /**
+       \brief extract up to \c max_cubes cubes in one call, each as a conjunction.
+       The constant true or false is the last element when the cube space is exhausted.
+    */
+    virtual expr_ref_vector cubes(expr_ref_vector& vars, unsigned backtrack_level, unsigned max_cubes);
+
     /**
        \brief retrieve fixed value assignment in current solver state, if it is implied.
     */
@@ -249,6 +255,7 @@ public:
     };
     typedef std::function<void(void*, solver::propagate_callback*)> final_eh_t;
     typedef std::function<void(void*, solver::propagate_callback*, unsigned, expr*)> fixed_eh_t;
+    typedef std::function<void(void*, solver::propagate_callback*, unsigned, unsigned const*, expr* const*)> fixed_batch_eh_t;
     typedef std::function<void(void*, solver::propagate_callback*, unsigned, unsigned)> eq_eh_t;
     typedef std::function<void*(void*, ast_manager&, solver::context_obj*&)> fresh_eh_t;
     typedef std::function<void(void*)>                 push_eh_t;
@@ -267,6 +274,10 @@ public:
         throw default_exception("user-propagators are only supported on the SMT solver");
     }
 
+    virtual void user_propagate_register_fixed_batch(fixed_batch_eh_t& fixed_batch_eh) {
+        throw default_exception("user-propagators are only supported on the SMT solver");
+    }
+
     virtual void user_propagate_register_final(final_eh_t& final_eh) {
         throw default_exception("user-propagators are only supported on the SMT solver");
     }
@@ -307,6 +318,12 @@ public:
 
     expr_ref_vector get_non_units();
 
+    /**
+       \brief extract lemmas implied by the assertions that the solver derived.
+       By default these are the units assigned at base level.
+    */
+    virtual expr_ref_vector get_lemmas();
+
     virtual expr_ref_vector get_trail() = 0; // { return expr_ref_vector(get_manager()); }
     
     virtual void get_levels(ptr_vector<expr> const& vars, unsigned_vector& depth) = 0;
@@ -35,6 +35,8 @@ class pool_solver : public solver_na2as {
     bool               m_dump_benchmarks;
     double             m_dump_threshold;
     unsigned           m_dump_counter;
+    symbol             m_name;
+    unsigned           m_generation;
 
 
     bool is_virtual() const { return !m.is_true(m_pred); }
@@ -52,7 +54,9 @@ public:
         m_in_delayed_scope(false),
         m_dump_benchmarks(false),
         m_dump_threshold(5.0),
-        m_dump_counter(0) {
+        m_dump_counter(0),
+        m_name(pred->get_decl()->get_name()),
+        m_generation(0) {
         if (is_virtual()) {
             solver_na2as::assert_expr_core2(m.mk_true(), pred);
         }
@@ -282,7 +286,27 @@ public:
         SASSERT(!m_pushed);
         m_head = 0;
         m_assertions.reset();
-        m_pool.refresh(m_base.get());
+        if (is_virtual() && m_base->get_scope_level() == 0 && m_pool.retire(m_base.get())) 
+            retire_pred();
+        else 
+            m_pool.refresh(m_base.get());
+    }
+
+    /**
+       \brief disable the assertions of this solver in the base solver by asserting the
+       negation of its activation literal, and continue with a fresh literal.
+       Lemmas of the base solver that do not depend on the old literal are kept,
+       and the base solver removes the clauses satisfied by the negated literal
+       during its own simplification.
+     */
+    void retire_pred() {
+        SASSERT(m_assumptions.get(0) == m_pred);
+        m_base->assert_expr(m.mk_not(m_pred));
+        std::stringstream name;
+        name << m_name << "!" << (++m_generation);
+        m_pred = m.mk_const(symbol(name.str()), m.mk_bool_sort());
+        m_assumptions[0] = m_pred;
+        m_proof.reset();
     }
 
 private:
@@ -338,10 +362,11 @@ private:
 
 };
 
-solver_pool::solver_pool(solver* base_solver, unsigned num_pools):
+solver_pool::solver_pool(solver* base_solver, unsigned num_pools, unsigned max_retired):
     m_base_solver(base_solver),
     m_num_pools(num_pools),
-    m_current_pool(0)
+    m_current_pool(0),
+    m_max_retired(max_retired)
 {
     SASSERT(num_pools > 0);
 }
@@ -372,6 +397,8 @@ void solver_pool::collect_statistics(statistics &st) const {
     st.update("pool_solver.checks", m_stats.m_num_checks);
     st.update("pool_solver.checks.sat", m_stats.m_num_sat_checks);
     st.update("pool_solver.checks.undef", m_stats.m_num_undef_checks);
+    st.update("pool_solver.retired", m_stats.m_num_retired);
+    st.update("pool_solver.refreshes", m_stats.m_num_refreshes);
 }
 
 void solver_pool::reset_statistics() {
@@ -419,8 +446,19 @@ void solver_pool::reset_solver(solver* s) {
     if (ps) ps->reset();
 }
 
+bool solver_pool::retire(solver* base_solver) {
+    unsigned& n = m_num_retired.insert_if_not_there(base_solver, 0);
+    if (n >= m_max_retired) 
+        return false;
+    ++n;
+    m_stats.m_num_retired++;
+    return true;
+}
+
 void solver_pool::refresh(solver* base_solver) {
     ast_manager& m = m_base_solver->get_manager();
+    m_num_retired.remove(base_solver);
+    m_stats.m_num_refreshes++;
     ref<solver> new_base = m_base_solver->translate(m, m_base_solver->get_params());
     for (solver* s0 : m_solvers) {
         pool_solver* s = dynamic_cast<pool_solver*>(s0);
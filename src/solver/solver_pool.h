@@ -37,6 +37,8 @@ class solver_pool {
         unsigned m_num_checks;
         unsigned m_num_sat_checks;
         unsigned m_num_undef_checks;
+        unsigned m_num_retired;
+        unsigned m_num_refreshes;
         stats() { reset(); }
         void reset() { memset(this, 0, sizeof(*this)); }
     };
@@ -46,6 +48,8 @@ class solver_pool {
     unsigned            m_current_pool;
     sref_vector<solver> m_solvers;
     stats               m_stats;
+    unsigned            m_max_retired;
+    ptr_addr_map<solver, unsigned> m_num_retired;
 
     stopwatch m_check_watch;
     stopwatch m_check_sat_watch;
@@ -53,11 +57,18 @@ class solver_pool {
     stopwatch m_proof_watch;
 
     void refresh(solver* s);
+    bool retire(solver* s);
 
     ptr_vector<solver> get_base_solvers() const;
   
 public:
-    solver_pool(solver* base_solver, unsigned num_pools);
+    /**
+       \brief create a pool of solvers multiplexed on copies of base_solver.
+       Resetting a solver retires its activation literal in the shared base solver, 
+       which keeps the lemmas of the other solvers. A base solver is rebuilt only 
+       after max_retired literals were retired in it.
+    */
+    solver_pool(solver* base_solver, unsigned num_pools, unsigned max_retired = 1000);
 
     void collect_statistics(statistics &st) const;
     void reset_statistics();
@@ -25,6 +25,7 @@ Notes:
 #include "solver/tactic2solver.h"
 #include "solver/solver_na2as.h"
 #include "solver/mus.h"
+#include "solver/solver_params.hpp"
 
 /**
    \brief Simulates the incremental solver interface using a tactic.
@@ -32,6 +33,11 @@ Notes:
    Every query will be solved from scratch.  So, this is not a good
    option for applications trying to solve many easy queries that a
    similar to each other.
+
+   The exceptions are queries answered by the last results: a model
+   that satisfies the assertions added since it was found together with
+   the assumptions, and unsat for assertions that extend assertions that
+   were unsatisfiable without assumptions.
 */
 
 namespace {
@@ -41,6 +47,11 @@ class tactic2solver : public solver_na2as {
     unsigned                     m_last_assertions_valid;
     unsigned_vector              m_scopes;
     ref<simple_check_sat_result> m_result;
+    ref<simple_check_sat_result> m_sat_result;      // last result with a model
+    unsigned                     m_sat_prefix;      // the model satisfies m_assertions[0..m_sat_prefix)
+    ref<simple_check_sat_result> m_unsat_result;    // last unsat result of a check without assumptions
+    unsigned                     m_unsat_prefix;    // m_assertions[0..m_unsat_prefix) are unsatisfiable
+    unsigned                     m_num_reused;
     tactic_ref                   m_tactic;
     ref<model_converter>         m_mc;
     symbol                       m_logic;
@@ -48,6 +59,8 @@ class tactic2solver : public solver_na2as {
     bool                         m_produce_proofs;
     bool                         m_produce_unsat_cores;
     statistics                   m_stats;
+
+    bool reuse_result(unsigned num_assumptions, expr * const * assumptions);
     
 public:
     tactic2solver(ast_manager & m, tactic * t, params_ref const & p, bool produce_proofs, bool produce_models, bool produce_unsat_cores, symbol const & logic);
@@ -97,6 +110,10 @@ public:
         throw default_exception("cannot retrieve trail from solvers created using tactics");
     }
 
+    expr_ref_vector get_lemmas() override {
+        return expr_ref_vector(get_manager());
+    }
+
     expr_ref get_implied_value(expr* e) override {
         return expr_ref(e, m);
     }
@@ -117,7 +134,10 @@ tactic2solver::tactic2solver(ast_manager & m, tactic * t, params_ref const & p,
     solver_na2as(m),
     m_assertions(m),
     m_last_assertions(m),
-    m_last_assertions_valid(false) {
+    m_last_assertions_valid(false),
+    m_sat_prefix(0),
+    m_unsat_prefix(0),
+    m_num_reused(0) {
 
     m_tactic = t;
     m_logic  = logic;
@@ -164,12 +184,47 @@ void tactic2solver::pop_core(unsigned n) {
     m_assertions.shrink(old_sz);
     m_scopes.shrink(new_lvl);
     m_result = nullptr;
+    m_sat_prefix = std::min(m_sat_prefix, old_sz);
+    if (m_unsat_prefix > old_sz)
+        m_unsat_result = nullptr;
+}
+
+bool tactic2solver::reuse_result(unsigned num_assumptions, expr * const * assumptions) {
+    if (m_unsat_result && m_unsat_prefix <= m_assertions.size()) {
+        m_result = m_unsat_result;
+        ++m_num_reused;
+        return true;
+    }
+    if (!m_sat_result)
+        return false;
+    model_ref mdl;
+    m_sat_result->get_model_core(mdl);
+    if (!mdl)
+        return false;
+    try {
+        model::scoped_model_completion _scm(mdl, false);
+        for (unsigned i = m_sat_prefix; i < m_assertions.size(); ++i)
+            if (!mdl->is_true(m_assertions.get(i)))
+                return false;
+        for (unsigned i = 0; i < num_assumptions; ++i)
+            if (!mdl->is_true(assumptions[i]))
+                return false;
+    }
+    catch (z3_exception &) {
+        return false;
+    }
+    m_sat_prefix = m_assertions.size();
+    m_result = m_sat_result;
+    ++m_num_reused;
+    return true;
 }
 
 lbool tactic2solver::check_sat_core2(unsigned num_assumptions, expr * const * assumptions) {
     if (m_tactic.get() == nullptr)
         return l_false;
     m_last_assertions_valid = false;
+    if (solver_params(get_params()).reuse_results() && reuse_result(num_assumptions, assumptions))
+        return m_result->status();
     ast_manager & m = m_assertions.m();
     m_result = alloc(simple_check_sat_result, m);
     m_tactic->cleanup();
@@ -241,6 +296,14 @@ lbool tactic2solver::check_sat_core2(unsigned num_assumptions, expr * const * as
         m_result->m_core.append(core_elems.size(), core_elems.c_ptr());
     }
     m_tactic->cleanup();
+    if (m_result->status() == l_true && md) {
+        m_sat_result = m_result;
+        m_sat_prefix = m_assertions.size();
+    }
+    if (m_result->status() == l_false && num_assumptions == 0) {
+        m_unsat_result = m_result;
+        m_unsat_prefix = m_assertions.size();
+    }
     return m_result->status();
 }
 
@@ -263,6 +326,8 @@ solver* tactic2solver::translate(ast_manager& m, params_ref const& p) {
 
 void tactic2solver::collect_statistics(statistics & st) const {    
     st.copy(m_stats);
+    if (m_num_reused > 0)
+        st.update("solver reused results", m_num_reused);
     //SASSERT(m_stats.size() > 0);
 }
 
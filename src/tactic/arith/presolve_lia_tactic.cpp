@@ -0,0 +1,296 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    presolve_lia_tactic.cpp
+
+Abstract:
+
+    Presolve step for linear integer inequalities over bounded variables.
+
+--*/
+#include "tactic/tactical.h"
+#include "tactic/arith/bound_manager.h"
+#include "tactic/arith/presolve_lia_tactic.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/ast_pp.h"
+
+class presolve_lia_tactic : public tactic {
+
+    struct imp {
+        ast_manager &       m;
+        arith_util          a;
+        bound_manager       m_bm;
+        vector<rational>    m_coeffs;
+        ptr_vector<app>     m_vars;
+        obj_map<app, unsigned> m_var2idx;
+        rational            m_bound;            // row is sum m_coeffs[i]*m_vars[i] <= m_bound
+        unsigned            m_num_redundant;
+        unsigned            m_num_infeasible;
+        unsigned            m_num_tightened;
+
+        imp(ast_manager & _m):
+            m(_m),
+            a(m),
+            m_bm(m),
+            m_num_redundant(0),
+            m_num_infeasible(0),
+            m_num_tightened(0) {
+        }
+
+        void add_var(rational const & c, app * x) {
+            unsigned idx;
+            if (m_var2idx.find(x, idx)) {
+                m_coeffs[idx] += c;
+                return;
+            }
+            m_var2idx.insert(x, m_vars.size());
+            m_vars.push_back(x);
+            m_coeffs.push_back(c);
+        }
+
+        // add sign*e to the left-hand side, the constants go to the bound.
+        bool add_linear(rational const & sign, expr * e) {
+            rational r;
+            expr * e1, * e2;
+            bool is_int;
+            if (a.is_add(e)) {
+                for (expr * arg : *to_app(e))
+                    if (!add_linear(sign, arg))
+                        return false;
+                return true;
+            }
+            if (a.is_numeral(e, r, is_int)) {
+                m_bound -= sign * r;
+                return true;
+            }
+            if (is_uninterp_const(e) && a.is_int(e)) {
+                add_var(sign, to_app(e));
+                return true;
+            }
+            if (a.is_mul(e, e1, e2) && a.is_numeral(e1, r, is_int) && is_uninterp_const(e2) && a.is_int(e2)) {
+                add_var(sign * r, to_app(e2));
+                return true;
+            }
+            return false;
+        }
+
+        /**
+           \brief extract a row from f. Return false if f is not a linear
+           integer inequality in the variables.
+        */
+        bool extract_row(expr * f) {
+            m_coeffs.reset();
+            m_vars.reset();
+            m_var2idx.reset();
+            bool neg = m.is_not(f, f);
+            expr * lhs, * rhs;
+            rational k;
+            bool is_int;
+            bool is_le;
+            if (a.is_le(f, lhs, rhs))
+                is_le = !neg;
+            else if (a.is_ge(f, lhs, rhs))
+                is_le = neg;
+            else
+                return false;
+            if (!a.is_int(lhs) || !a.is_numeral(rhs, k, is_int) || !k.is_int())
+                return false;
+            // lhs <= k, lhs >= k, not (lhs <= k) = lhs >= k+1, not (lhs >= k) = lhs <= k-1
+            if (neg)
+                k += is_le ? rational::minus_one() : rational::one();
+            rational sign = is_le ? rational::one() : rational::minus_one();
+            m_bound = sign * k;
+            if (!add_linear(sign, lhs))
+                return false;
+            for (rational const & c : m_coeffs)
+                if (!c.is_int())
+                    return false;
+            return m_vars.size() > 1;
+        }
+
+        bool get_bounds(app * x, rational & l, rational & u) {
+            bool strict;
+            if (!m_bm.has_lower(x, l, strict))
+                return false;
+            if (strict)
+                l += rational::one();
+            if (!m_bm.has_upper(x, u, strict))
+                return false;
+            if (strict)
+                u -= rational::one();
+            l = ceil(l);
+            u = floor(u);
+            return l <= u;
+        }
+
+        /**
+           \brief process the current row.
+           Return l_true if it is redundant, l_false if it is infeasible and
+           l_undef otherwise. Set changed if coefficients were tightened.
+        */
+        lbool presolve_row(bool & changed) {
+            changed = false;
+            unsigned n = m_vars.size();
+            vector<rational> lo, hi;
+            for (app * x : m_vars) {
+                rational l, u;
+                if (!get_bounds(x, l, u))
+                    return l_undef;
+                lo.push_back(l);
+                hi.push_back(u);
+            }
+            rational max_act, min_act;
+            for (unsigned i = 0; i < n; ++i) {
+                rational const & c = m_coeffs[i];
+                max_act += c * (c.is_pos() ? hi[i] : lo[i]);
+                min_act += c * (c.is_pos() ? lo[i] : hi[i]);
+            }
+            if (max_act <= m_bound)
+                return l_true;
+            if (min_act > m_bound)
+                return l_false;
+            for (unsigned i = 0; i < n; ++i) {
+                rational & c = m_coeffs[i];
+                if (hi[i] - lo[i] != rational::one() || c.is_zero())
+                    continue;
+                rational const & l = lo[i];
+                if (c.is_pos()) {
+                    // max_act - c < m_bound < max_act
+                    rational d = m_bound - max_act + c;
+                    if (!d.is_pos() || d >= c)
+                        continue;
+                    c -= d;
+                    m_bound -= d * (l + rational::one());
+                    max_act -= d * (l + rational::one());
+                }
+                else {
+                    rational d = m_bound - c - max_act;
+                    if (!d.is_pos() || d >= -c)
+                        continue;
+                    c += d;
+                    m_bound += d * l;
+                    max_act += d * l;
+                }
+                changed = true;
+            }
+            return l_undef;
+        }
+
+        expr_ref mk_row() {
+            expr_ref_vector args(m);
+            for (unsigned i = 0; i < m_vars.size(); ++i) {
+                rational const & c = m_coeffs[i];
+                if (c.is_zero())
+                    continue;
+                if (c.is_one())
+                    args.push_back(m_vars[i]);
+                else
+                    args.push_back(a.mk_mul(a.mk_int(c), m_vars[i]));
+            }
+            expr_ref lhs(m);
+            if (args.empty())
+                lhs = a.mk_int(0);
+            else if (args.size() == 1)
+                lhs = args.get(0);
+            else
+                lhs = a.mk_add(args.size(), args.c_ptr());
+            return expr_ref(a.mk_le(lhs, a.mk_int(m_bound)), m);
+        }
+
+        expr_dependency * row_dep(expr_dependency * d) {
+            for (app * x : m_vars) {
+                d = m.mk_join(d, m_bm.lower_dep(x));
+                d = m.mk_join(d, m_bm.upper_dep(x));
+            }
+            return d;
+        }
+
+        void operator()(goal_ref const & g, goal_ref_buffer & result) {
+            tactic_report report("presolve-lia", *g);
+            if (g->proofs_enabled() || g->inconsistent()) {
+                result.push_back(g.get());
+                return;
+            }
+            m_bm(*g);
+            unsigned num_redundant = m_num_redundant, num_infeasible = m_num_infeasible, num_tightened = m_num_tightened;
+            expr_dependency_ref dep(m);
+            for (unsigned i = 0; !g->inconsistent() && i < g->size(); ++i) {
+                if (!extract_row(g->form(i)))
+                    continue;
+                bool changed = false;
+                lbool r = presolve_row(changed);
+                TRACE("presolve_lia", tout << mk_pp(g->form(i), m) << " " << r << "\n";);
+                if (r == l_undef && !changed)
+                    continue;
+                dep = g->unsat_core_enabled() ? row_dep(g->dep(i)) : nullptr;
+                if (r == l_true) {
+                    ++m_num_redundant;
+                    g->update(i, m.mk_true(), nullptr, dep);
+                }
+                else if (r == l_false) {
+                    ++m_num_infeasible;
+                    g->update(i, m.mk_false(), nullptr, dep);
+                }
+                else {
+                    ++m_num_tightened;
+                    g->update(i, mk_row(), nullptr, dep);
+                }
+            }
+            g->elim_true();
+            report_tactic_progress(":redundant", m_num_redundant - num_redundant);
+            report_tactic_progress(":tightened", m_num_tightened - num_tightened);
+            if (m_num_redundant + m_num_infeasible + m_num_tightened > num_redundant + num_infeasible + num_tightened)
+                g->inc_depth();
+            result.push_back(g.get());
+            m_bm.reset();
+        }
+    };
+
+    imp *      m_imp;
+    params_ref m_params;
+
+public:
+    presolve_lia_tactic(ast_manager & m, params_ref const & p):
+        m_params(p) {
+        m_imp = alloc(imp, m);
+    }
+
+    ~presolve_lia_tactic() override {
+        dealloc(m_imp);
+    }
+
+    tactic * translate(ast_manager & m) override {
+        return alloc(presolve_lia_tactic, m, m_params);
+    }
+
+    void operator()(goal_ref const & in, goal_ref_buffer & result) override {
+        (*m_imp)(in, result);
+    }
+
+    void collect_statistics(statistics & st) const override {
+        st.update("presolve-lia redundant", m_imp->m_num_redundant);
+        st.update("presolve-lia infeasible", m_imp->m_num_infeasible);
+        st.update("presolve-lia tightened", m_imp->m_num_tightened);
+    }
+
+    void reset_statistics() override {
+        m_imp->m_num_redundant = 0;
+        m_imp->m_num_infeasible = 0;
+        m_imp->m_num_tightened = 0;
+    }
+
+    void cleanup() override {
+        imp * d = alloc(imp, m_imp->m);
+        std::swap(d->m_num_redundant, m_imp->m_num_redundant);
+        std::swap(d->m_num_infeasible, m_imp->m_num_infeasible);
+        std::swap(d->m_num_tightened, m_imp->m_num_tightened);
+        std::swap(d, m_imp);
+        dealloc(d);
+    }
+};
+
+tactic * mk_presolve_lia_tactic(ast_manager & m, params_ref const & p) {
+    return clean(alloc(presolve_lia_tactic, m, p));
+}
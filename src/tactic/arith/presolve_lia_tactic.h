@@ -0,0 +1,34 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    presolve_lia_tactic.h
+
+Abstract:
+
+    Presolve step for linear integer inequalities over bounded variables,
+    as done by MIP solvers:
+
+    - rows that hold for all values within the bounds are removed,
+    - rows that hold for no value within the bounds become false,
+    - coefficients of variables with two values (0-1 variables up to
+      an offset) are tightened: for a*x + R <= b with a > 0 and
+      max(R) < b, the row is replaced by (a-d)*x + R <= b-d*(l+1)
+      where d = b - max(R) and l is the lower bound of x, which has the
+      same integer solutions but a tighter LP relaxation.
+
+    Bounds are the unit bounds recognized by bound_manager.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+class ast_manager;
+class tactic;
+
+tactic * mk_presolve_lia_tactic(ast_manager & m, params_ref const & p = params_ref());
+
+/*
+  ADD_TACTIC("presolve-lia", "remove redundant linear integer inequalities and tighten coefficients of 0-1 variables using bounds.", "mk_presolve_lia_tactic(m, p)")
+*/
@@ -128,6 +128,7 @@ public:
         insert_max_memory(r);
         insert_max_steps(r);
         r.insert("blast_mul", CPK_BOOL, "(default: true) bit-blast multipliers (and dividers, remainders).");
+        r.insert("blast_mul_wallace", CPK_BOOL, "(default: false) bit-blast multipliers as Wallace trees of carry-save adders.");
         r.insert("blast_add", CPK_BOOL, "(default: true) bit-blast adders.");
         r.insert("blast_quant", CPK_BOOL, "(default: false) bit-blast quantified variables.");
         r.insert("blast_full", CPK_BOOL, "(default: false) bit-blast any term with bit-vector sort, this option will make E-matching ineffective in any pattern containing bit-vector terms.");
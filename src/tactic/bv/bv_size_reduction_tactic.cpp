@@ -38,6 +38,9 @@ class bv_size_reduction_tactic : public tactic {
     obj_map<app, numeral>     m_signed_uppers;
     obj_map<app, numeral>     m_unsigned_lowers;
     obj_map<app, numeral>     m_unsigned_uppers;
+    obj_map<app, unsigned>    m_known_idx;      // uninterpreted constant -> index into m_known_bits
+    vector<svector<lbool>>    m_known_bits;     // bits fixed by unit constraints, l_undef if unknown
+    bool                      m_known_conflict { false };
     ref<bv_size_reduction_mc> m_mc;
     generic_model_converter_ref m_fmc;
     scoped_ptr<expr_replacer> m_replacer;
@@ -61,6 +64,9 @@ public:
         m_signed_uppers.reset();
         m_unsigned_lowers.reset();
         m_unsigned_uppers.reset();
+        m_known_idx.reset();
+        m_known_bits.reset();
+        m_known_conflict = false;
         m_mc = nullptr;
         m_fmc = nullptr;
         m_replacer->reset();
@@ -104,6 +110,47 @@ public:
         }
     }
 
+    svector<lbool> & known_bits(app * v) {
+        unsigned idx = 0;
+        if (!m_known_idx.find(v, idx)) {
+            idx = m_known_bits.size();
+            m_known_bits.push_back(svector<lbool>(m_util.get_bv_size(v), l_undef));
+            m_known_idx.insert(v, idx);
+        }
+        return m_known_bits[idx];
+    }
+
+    void update_known_bits(app * v, unsigned lo, unsigned len, numeral val) {
+        // bits [lo, lo + len) of v are equal to val
+        svector<lbool> & bits = known_bits(v);
+        for (unsigned i = lo; i < lo + len; i++) {
+            lbool b = val.is_even() ? l_false : l_true;
+            val = div(val, numeral(2));
+            if (bits[i] == l_undef)
+                bits[i] = b;
+            else if (bits[i] != b)
+                m_known_conflict = true;
+        }
+    }
+
+    void update_known_bits(expr * e, numeral const & val) {
+        // e = val
+        unsigned lo, hi;
+        expr * arg;
+        if (is_uninterp_const(e))
+            update_known_bits(to_app(e), 0, m_util.get_bv_size(e), val);
+        else if (m_util.is_extract(e, lo, hi, arg) && is_uninterp_const(arg))
+            update_known_bits(to_app(arg), lo, hi - lo + 1, val);
+    }
+
+    void update_known_upper(app * v, numeral const & k) {
+        // v <= k unsigned, the bits above the most significant bit of k are zero
+        unsigned bv_sz = m_util.get_bv_size(v);
+        unsigned k_nb  = k.is_zero() ? 0 : k.get_num_bits();
+        if (k_nb < bv_sz)
+            update_known_bits(v, k_nb, bv_sz - k_nb, numeral(0));
+    }
+
     void collect_bounds(goal const & g) {
         unsigned sz = g.size();
         numeral  val;
@@ -150,23 +197,28 @@ public:
                     else update_signed_lower(to_app(rhs), val);
                 }
             }
-            
-#if 0
+
             else if (m_util.is_bv_ule(f, lhs, rhs)) {
-                if (is_uninterp_const(lhs) && m_util.is_numeral(rhs, val, bv_sz)) {
-                    TRACE("bv_size_reduction", tout << (negated?"not ":"") << mk_ismt2_pp(f, m) << std::endl; );
+                bv_sz = m_util.get_bv_size(lhs);
+                if (!negated && is_uninterp_const(lhs) && m_util.is_numeral(rhs, val, bv_sz)) {
+                    TRACE("bv_size_reduction", tout << mk_ismt2_pp(f, m) << std::endl; );
                     // v <= k
-                    if (negated) update_unsigned_lower(to_app(lhs), val+numeral(1));
-                    else update_unsigned_upper(to_app(lhs), val);
+                    update_known_upper(to_app(lhs), val);
                 }
-                else if (is_uninterp_const(rhs) && m_util.is_numeral(lhs, val, bv_sz)) {
-                    TRACE("bv_size_reduction", tout << (negated?"not ":"") << mk_ismt2_pp(f, m) << std::endl; );
-                    // k <= v
-                    if (negated) update_unsigned_upper(to_app(rhs), val-numeral(1));
-                    else update_unsigned_lower(to_app(rhs), val);                    
+                else if (negated && is_uninterp_const(rhs) && m_util.is_numeral(lhs, val, bv_sz) && val.is_pos()) {
+                    TRACE("bv_size_reduction", tout << "not " << mk_ismt2_pp(f, m) << std::endl; );
+                    // v < k
+                    update_known_upper(to_app(rhs), val - numeral(1));
+                }
+            }
+            else if (!negated && m.is_eq(f, lhs, rhs) && m_util.is_bv(lhs)) {
+                if (m_util.is_numeral(lhs))
+                    std::swap(lhs, rhs);
+                if (m_util.is_numeral(rhs, val, bv_sz)) {
+                    TRACE("bv_size_reduction", tout << mk_ismt2_pp(f, m) << std::endl; );
+                    update_known_bits(lhs, val);
                 }
             }
-#endif
         }
     }
     
@@ -275,6 +327,55 @@ public:
                 }
             }
             
+            if (m_known_conflict) {
+                g.assert_expr(m.mk_false());
+                return;
+            }
+
+            // replace the known bits of constants by numerals
+            for (auto const & kv : m_known_idx) {
+                app * v = kv.m_key;
+                svector<lbool> const & bits = m_known_bits[kv.m_value];
+                if (subst.contains(v))
+                    continue;
+                ptr_buffer<expr> pieces;
+                ptr_buffer<app>  new_consts;
+                unsigned i = bits.size();
+                while (i > 0) {
+                    // bits [j, i) are either all known or all unknown
+                    bool known = bits[i - 1] != l_undef;
+                    unsigned j = i - 1;
+                    while (j > 0 && (bits[j - 1] != l_undef) == known)
+                        --j;
+                    if (known) {
+                        numeral k(0);
+                        for (unsigned b = i; b-- > j; )
+                            k = numeral(2) * k + numeral(bits[b] == l_true ? 1 : 0);
+                        pieces.push_back(m_util.mk_numeral(k, i - j));
+                    }
+                    else {
+                        new_consts.push_back(m.mk_fresh_const(nullptr, m_util.mk_sort(i - j)));
+                        pieces.push_back(new_consts.back());
+                    }
+                    i = j;
+                }
+                if (new_consts.size() == 1 && pieces.size() == 1)
+                    continue;
+                expr * new_def = pieces.size() == 1 ? pieces[0] : m_util.mk_concat(pieces.size(), pieces.c_ptr());
+                TRACE("bv_size_reduction", tout << mk_ismt2_pp(v, m) << " := " << mk_ismt2_pp(new_def, m) << "\n";);
+                subst.insert(v, new_def);
+                if (m_produce_models) {
+                    if (!m_mc) 
+                        m_mc = alloc(bv_size_reduction_mc, m, "bv_size_reduction");
+                    m_mc->add(v, new_def);
+                    if (!m_fmc && !new_consts.empty()) 
+                        m_fmc = alloc(generic_model_converter, m, "bv_size_reduction");
+                    for (app * c : new_consts)
+                        m_fmc->hide(c);
+                }
+                num_reduced++;
+            }
+            
 #if 0            
             if (!(m_unsigned_lowers.empty() && m_unsigned_uppers.empty())) {
                 TRACE("bv_size_reduction", 
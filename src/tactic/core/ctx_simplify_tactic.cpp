@@ -162,6 +162,8 @@ struct ctx_simplify_tactic::imp {
     unsigned long long          m_max_memory;
     unsigned                    m_max_depth;
     unsigned                    m_max_steps;
+    unsigned                    m_max_cache;
+    unsigned                    m_num_cached;   // number of live cached_result objects
     bool                        m_bail_on_blowup;
 
     imp(ast_manager & _m, simplifier* simp, params_ref const & p):
@@ -169,7 +171,8 @@ struct ctx_simplify_tactic::imp {
         m_simp(simp),
         m_allocator("context-simplifier"),
         m_occs(m, true, true),
-        m_mk_app(m, p) {
+        m_mk_app(m, p),
+        m_num_cached(0) {
         updt_params(p);
         m_simp->set_occs(m_occs);
     }
@@ -196,6 +199,7 @@ struct ctx_simplify_tactic::imp {
         m_max_memory   = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
         m_max_steps    = p.get_uint("max_steps", UINT_MAX);
         m_max_depth    = p.get_uint("max_depth", 1024);
+        m_max_cache    = p.get_uint("max_cache", UINT_MAX);
         m_bail_on_blowup = p.get_bool("bail_on_blowup", false);
         m_simp->updt_params(p);
     }
@@ -232,6 +236,7 @@ struct ctx_simplify_tactic::imp {
         m_cache.reserve(id+1);
         cache_cell & cell = m_cache[id];
         void * mem = m_allocator.allocate(sizeof(cached_result));
+        ++m_num_cached;
         if (cell.m_from == nullptr) {
             // new_entry
             cell.m_from   = from;
@@ -248,8 +253,10 @@ struct ctx_simplify_tactic::imp {
         m_cache_undo[scope_level()].push_back(from);
     }
 
+    // once max_cache results are cached, terms are cached again only after
+    // pops released entries of deeper scopes.
     void cache(expr * from, expr * to) {
-        if (shared(from))
+        if (m_num_cached < m_max_cache && shared(from))
             cache_core(from, to);
     }
 
@@ -283,6 +290,7 @@ struct ctx_simplify_tactic::imp {
                 cell.m_from = nullptr;
             }
             m_allocator.deallocate(sizeof(cached_result), to_delete);
+            --m_num_cached;
         }
         keys.reset();
     }
@@ -613,6 +621,7 @@ void ctx_simplify_tactic::get_param_descrs(param_descrs & r) {
     insert_max_memory(r);
     insert_max_steps(r);
     r.insert("max_depth", CPK_UINT, "(default: 1024) maximum term depth.");
+    r.insert("max_cache", CPK_UINT, "(default: infty) maximum number of cached simplified terms.");
     r.insert("propagate_eq", CPK_BOOL, "(default: false) enable equality propagation from bounds.");
 }
 
@@ -762,8 +762,68 @@ class elim_uncnstr_tactic : public tactic {
     unsigned                         m_num_elim_apps = 0;
     unsigned long long               m_max_memory;
     unsigned                         m_max_steps;
+    expr_mark                        m_visited;
+    expr_mark                        m_has_new;   // terms containing a variable that became unconstrained in the last round
+    ptr_vector<expr>                 m_todo;
     
     ast_manager & m() { return m_manager; }
+
+    /**
+       \brief Mark the variables that are unconstrained now, but were not
+       unconstrained in the previous round. Return false if there are none.
+    */
+    bool mark_new_vars(obj_hashtable<expr> const & old_vars) {
+        m_visited.reset();
+        m_has_new.reset();
+        bool found = false;
+        for (expr * v : m_vars) {
+            if (!old_vars.contains(v)) {
+                m_visited.mark(v, true);
+                m_has_new.mark(v, true);
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    /**
+       \brief Return true if f contains a new unconstrained variable.
+       Other formulas were already rewritten with the unconstrained
+       variables they contain, and are not changed by another round.
+    */
+    bool has_new_var(expr * f) {
+        m_todo.push_back(f);
+        while (!m_todo.empty()) {
+            expr * e = m_todo.back();
+            if (m_visited.is_marked(e)) {
+                m_todo.pop_back();
+                continue;
+            }
+            bool visited = true, has_new = false;
+            auto visit = [&](expr * arg) {
+                if (!m_visited.is_marked(arg)) {
+                    m_todo.push_back(arg);
+                    visited = false;
+                }
+                else if (m_has_new.is_marked(arg))
+                    has_new = true;
+            };
+            if (is_app(e)) {
+                for (expr * arg : *to_app(e))
+                    visit(arg);
+            }
+            else if (is_quantifier(e)) {
+                visit(to_quantifier(e)->get_expr());
+            }
+            if (!visited)
+                continue;
+            m_todo.pop_back();
+            m_visited.mark(e, true);
+            if (has_new)
+                m_has_new.mark(e, true);
+        }
+        return m_has_new.is_marked(f);
+    }
     
     void init_mc(bool produce_models) {
         m_mc = nullptr;
@@ -804,6 +864,8 @@ class elim_uncnstr_tactic : public tactic {
         while (true) {
             for (; idx < size; idx++) {
                 expr * f = g->form(idx);
+                if (round > 0 && !has_new_var(f))
+                    continue;
                 m_rw->operator()(f, new_f, new_pr);
                 if (f == new_f)
                     continue;
@@ -826,6 +888,8 @@ class elim_uncnstr_tactic : public tactic {
                 m_rw = nullptr;                    
                 result.push_back(g.get());
                 g->inc_depth();
+                m_visited.reset();
+                m_has_new.reset();
                 TRACE("goal", g->display(tout););
                 return;
             }
@@ -833,12 +897,13 @@ class elim_uncnstr_tactic : public tactic {
             round ++;
             size       = g->size();
             m_rw->reset(); // reset cache
-            m_vars.reset(); 
+            obj_hashtable<expr> old_vars;
+            old_vars.swap(m_vars);
             {
                 collect_occs p;
                 p(*g, m_vars);
             }
-            if (m_vars.empty()) 
+            if (!mark_new_vars(old_vars)) 
                 idx = size; // force to finish 
             else
                 idx = 0;
@@ -16,19 +16,30 @@ Author:
 Notes:
 
 --*/
+#include "util/parallel_executor.h"
+#include "util/scoped_ptr_vector.h"
 #include "tactic/core/simplify_tactic.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_translation.h"
 
 struct simplify_tactic::imp {
     ast_manager &   m_manager;
     th_rewriter     m_r;
     unsigned        m_num_steps;
+    params_ref      m_params;
+    unsigned        m_threads;
 
     imp(ast_manager & m, params_ref const & p):
         m_manager(m),
         m_r(m, p),
         m_num_steps(0) {
+        updt_params(p);
+    }
+
+    void updt_params(params_ref const & p) {
+        m_params  = p;
+        m_threads = p.get_uint("rewrite_threads", 1);
     }
 
     ~imp() {
@@ -42,11 +53,61 @@ struct simplify_tactic::imp {
         m_num_steps = 0;
     }
 
+    /**
+       \brief rewrite ranges of the formulas of g in copies of the manager on
+       separate threads. The formulas are translated to the copies and back,
+       so this pays off only for goals with many formulas.
+    */
+    void parallel_simplify(goal & g) {
+        unsigned size = g.size();
+        unsigned num_threads = std::min(m_threads, size);
+        scoped_ptr_vector<ast_manager> managers;
+        scoped_limits scl(m().limit());
+        vector<expr_ref_vector> forms;
+        for (unsigned t = 0; t < num_threads; ++t) {
+            ast_manager * new_m = alloc(ast_manager, m(), true);
+            managers.push_back(new_m);
+            scl.push_child(&new_m->limit());
+            ast_translation tr(m(), *new_m);
+            forms.push_back(expr_ref_vector(*new_m));
+            for (unsigned idx = t * size / num_threads; idx < (t + 1) * size / num_threads; ++idx)
+                forms.back().push_back(tr(g.form(idx)));
+        }
+        unsigned_vector num_steps(num_threads, 0u);
+        parallel_executor::run(num_threads, [&](unsigned t) {
+            th_rewriter r(*managers[t], m_params);
+            expr_ref new_curr(*managers[t]);
+            for (unsigned i = 0; i < forms[t].size(); ++i) {
+                r(forms[t].get(i), new_curr);
+                num_steps[t] += r.get_num_steps();
+                forms[t][i] = new_curr;
+            }
+        });
+        for (unsigned t = 0; t < num_threads; ++t) {
+            m_num_steps += num_steps[t];
+            ast_translation tr(*managers[t], m());
+            unsigned idx = t * size / num_threads;
+            for (expr * e : forms[t]) {
+                if (g.inconsistent())
+                    return;
+                expr_ref new_curr(tr(e), m());
+                g.update(idx, new_curr, nullptr, g.dep(idx));
+                ++idx;
+            }
+        }
+    }
+
     void operator()(goal & g) {
         tactic_report report("simplifier", g);
         m_num_steps = 0;
         if (g.inconsistent())
             return;
+        if (m_threads > 1 && !g.proofs_enabled() && g.size() > m_threads) {
+            parallel_simplify(g);
+            TRACE("simplifier", g.display(tout););
+            g.elim_redundancies();
+            return;
+        }
         expr_ref   new_curr(m());
         proof_ref  new_pr(m());
         unsigned size = g.size();
@@ -82,10 +143,12 @@ simplify_tactic::~simplify_tactic() {
 void simplify_tactic::updt_params(params_ref const & p) {
     m_params = p;
     m_imp->m_r.updt_params(p);
+    m_imp->updt_params(p);
 }
 
 void simplify_tactic::get_param_descrs(param_descrs & r) {
     th_rewriter::get_param_descrs(r);
+    r.insert("rewrite_threads", CPK_UINT, "(default: 1) number of threads that simplify ranges of the formulas of a goal in copies of the manager. Only used for goals without proofs that have more formulas than threads", "1");
 }
 
 void simplify_tactic::operator()(goal_ref const & in, 
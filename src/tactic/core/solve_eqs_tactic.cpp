@@ -886,8 +886,12 @@ class solve_eqs_tactic : public tactic {
         }
 
         void substitute(goal & g) {
-            // force the cache of m_r to be reset.
-            m_r->set_substitution(m_norm_subst.get());
+            // normalize() inserted the definitions in topological order, so the terms
+            // cached by m_r remain valid for the final substitution and are shared with it.
+            // Dependencies are collected only for terms that are rewritten, so the cache
+            // has to be reset when unsat cores are tracked.
+            if (m_produce_unsat_cores)
+                m_r->set_substitution(m_norm_subst.get());
             
             expr_ref new_f(m());
             proof_ref new_pr(m());
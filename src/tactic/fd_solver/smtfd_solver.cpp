@@ -387,6 +387,7 @@ namespace smtfd {
         th_rewriter     m_rewriter;
         ptr_vector<theory_plugin> m_plugins;
         model_ref       m_model;
+        ptr_vector<expr> m_terms;  // subterms of the core, collected in round 0 and reused by later rounds
     public:
         plugin_context(smtfd_abs& a, ast_manager& m):
             m(m),
@@ -441,6 +442,8 @@ namespace smtfd {
          * \brief add theory axioms that are violdated in the current model
          * the round indicator is used to prioritize "cheap" axioms before
          * expensive axiom instantiation. 
+         * Rounds after round 0 reuse the subterms of core collected in round 0,
+         * core is therefore required to be the same for all rounds.
          */
         bool add_theory_axioms(expr_ref_vector const& core, unsigned round);
 
@@ -619,7 +622,16 @@ namespace smtfd {
             return false;
         }
         else if (round < max_rounds) {
-            for (expr* t : subterms(core)) {
+            if (round == 0) {
+                m_terms.reset();
+                for (expr* t : subterms(core)) {
+                    m_terms.push_back(t);
+                }
+            }
+            for (expr* t : m_terms) {
+                if (at_max()) {
+                    break;
+                }
                 for (theory_plugin* p : m_plugins) {
                     p->check_term(t, round);
                 }
@@ -0,0 +1,445 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    fpa_interval_tactic.cpp
+
+Abstract:
+
+    Word level reasoning on floating point intervals before bit-blasting.
+
+--*/
+#include "tactic/tactical.h"
+#include "tactic/fpa/fpa_interval_tactic.h"
+#include "ast/fpa_decl_plugin.h"
+#include "ast/rewriter/expr_safe_replace.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "ast/ast_pp.h"
+
+class fpa_interval_tactic : public tactic {
+
+    struct imp {
+        ast_manager &           m;
+        fpa_util                fu;
+        mpf_manager &           fm;
+        th_rewriter             m_rw;
+        obj_map<expr, unsigned> m_expr2itv;
+        scoped_mpf_vector       m_lo;
+        scoped_mpf_vector       m_hi;
+        bool_vector             m_nan;      // the term may be NaN
+        unsigned                m_num_decided;
+        unsigned                m_num_conflicts;
+
+        imp(ast_manager & _m, params_ref const & p):
+            m(_m),
+            fu(m),
+            fm(fu.fm()),
+            m_rw(m, p),
+            m_lo(fm),
+            m_hi(fm),
+            m_num_decided(0),
+            m_num_conflicts(0) {
+        }
+
+        void reset() {
+            m_expr2itv.reset();
+            m_lo.reset();
+            m_hi.reset();
+            m_nan.reset();
+        }
+
+        unsigned mk_itv(mpf const & lo, mpf const & hi, bool nan) {
+            m_lo.push_back(lo);
+            m_hi.push_back(hi);
+            m_nan.push_back(nan);
+            return m_nan.size() - 1;
+        }
+
+        void mk_full(sort * s, scoped_mpf & lo, scoped_mpf & hi) {
+            fm.mk_ninf(fu.get_ebits(s), fu.get_sbits(s), lo);
+            fm.mk_pinf(fu.get_ebits(s), fu.get_sbits(s), hi);
+        }
+
+        bool is_bound_atom(app * a, app * & x, expr * & c) {
+            if (a->get_num_args() != 2)
+                return false;
+            expr * e1 = a->get_arg(0), * e2 = a->get_arg(1);
+            if (is_uninterp_const(e1) && fu.is_numeral(e2) && !fu.is_nan(e2)) {
+                x = to_app(e1);
+                c = e2;
+                return true;
+            }
+            if (is_uninterp_const(e2) && fu.is_numeral(e1) && !fu.is_nan(e1)) {
+                x = to_app(e2);
+                c = e1;
+                return true;
+            }
+            return false;
+        }
+
+        /**
+           \brief tighten the interval of x by the top-level formula f.
+           Return false if the interval becomes empty.
+        */
+        bool add_bound(expr * f) {
+            if (!is_app(f))
+                return true;
+            app * a = to_app(f), * x;
+            expr * c;
+            bool is_eq = m.is_eq(f);
+            if (!is_eq && a->get_family_id() != fu.get_family_id())
+                return true;
+            if (!is_bound_atom(a, x, c) || !fu.is_float(x))
+                return true;
+            bool x_first = a->get_arg(0) == x;
+            bool upper = false, lower = false;
+            switch (is_eq ? OP_FPA_EQ : a->get_decl_kind()) {
+            case OP_FPA_EQ: upper = lower = true; break;
+            case OP_FPA_LE: case OP_FPA_LT: upper = x_first; lower = !x_first; break;
+            case OP_FPA_GE: case OP_FPA_GT: upper = !x_first; lower = x_first; break;
+            default: return true;
+            }
+            unsigned idx;
+            if (!m_expr2itv.find(x, idx)) {
+                scoped_mpf lo(fm), hi(fm);
+                mk_full(x->get_decl()->get_range(), lo, hi);
+                idx = mk_itv(lo, hi, true);
+                m_expr2itv.insert(x, idx);
+            }
+            scoped_mpf v(fm);
+            VERIFY(fu.is_numeral(c, v));
+            // the comparisons are false for NaN; strict bounds are
+            // approximated by non-strict ones.
+            m_nan[idx] = false;
+            if (upper && fm.lt(v, m_hi[idx]))
+                fm.set(m_hi[idx], v);
+            if (lower && fm.lt(m_lo[idx], v))
+                fm.set(m_lo[idx], v);
+            return fm.le(m_lo[idx], m_hi[idx]);
+        }
+
+        bool is_interval_op(expr * e) {
+            if (!is_app(e) || to_app(e)->get_family_id() != fu.get_family_id())
+                return false;
+            switch (to_app(e)->get_decl_kind()) {
+            case OP_FPA_NEG: case OP_FPA_ABS: case OP_FPA_ADD: case OP_FPA_SUB:
+            case OP_FPA_MUL: case OP_FPA_DIV: case OP_FPA_SQRT:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        void get_rounding(expr * e, mpf_rounding_mode & rm_lo, mpf_rounding_mode & rm_hi) {
+            if (fu.is_rm_numeral(e, rm_lo)) {
+                rm_hi = rm_lo;
+                return;
+            }
+            rm_lo = MPF_ROUND_TOWARD_NEGATIVE;
+            rm_hi = MPF_ROUND_TOWARD_POSITIVE;
+        }
+
+        bool contains_zero(unsigned i, mpf const & zero) {
+            return fm.le(m_lo[i], zero) && fm.le(zero, m_hi[i]);
+        }
+
+        bool has_inf(unsigned i) {
+            return fm.is_inf(m_lo[i]) || fm.is_inf(m_hi[i]);
+        }
+
+        void apply(decl_kind k, mpf_rounding_mode rm, mpf const & x, mpf const & y, mpf & r) {
+            switch (k) {
+            case OP_FPA_ADD: fm.add(rm, x, y, r); break;
+            case OP_FPA_SUB: fm.sub(rm, x, y, r); break;
+            case OP_FPA_MUL: fm.mul(rm, x, y, r); break;
+            case OP_FPA_DIV: fm.div(rm, x, y, r); break;
+            default: UNREACHABLE();
+            }
+        }
+
+        /**
+           \brief compute the interval of the arithmetic operation a from
+           the intervals of its arguments. Return false if the result is
+           not bounded.
+        */
+        bool eval_op(app * a, scoped_mpf & lo, scoped_mpf & hi, bool & nan) {
+            sort * s = a->get_decl()->get_range();
+            scoped_mpf zero(fm), r(fm);
+            fm.mk_pzero(fu.get_ebits(s), fu.get_sbits(s), zero);
+            decl_kind k = a->get_decl_kind();
+            mpf_rounding_mode rm_lo, rm_hi;
+            switch (k) {
+            case OP_FPA_NEG: {
+                unsigned x = m_expr2itv[a->get_arg(0)];
+                fm.neg(m_hi[x], lo);
+                fm.neg(m_lo[x], hi);
+                nan = m_nan[x];
+                return true;
+            }
+            case OP_FPA_ABS: {
+                unsigned x = m_expr2itv[a->get_arg(0)];
+                nan = m_nan[x];
+                if (fm.le(zero, m_lo[x])) {
+                    fm.set(lo, m_lo[x]);
+                    fm.set(hi, m_hi[x]);
+                }
+                else if (fm.le(m_hi[x], zero)) {
+                    fm.neg(m_hi[x], lo);
+                    fm.neg(m_lo[x], hi);
+                }
+                else {
+                    fm.set(lo, zero);
+                    fm.neg(m_lo[x], hi);
+                    if (fm.lt(hi, m_hi[x]))
+                        fm.set(hi, m_hi[x]);
+                }
+                return true;
+            }
+            case OP_FPA_SQRT: {
+                unsigned x = m_expr2itv[a->get_arg(1)];
+                if (fm.lt(m_lo[x], zero))
+                    return false;
+                get_rounding(a->get_arg(0), rm_lo, rm_hi);
+                fm.sqrt(rm_lo, m_lo[x], lo);
+                fm.sqrt(rm_hi, m_hi[x], hi);
+                nan = m_nan[x];
+                return true;
+            }
+            default:
+                break;
+            }
+            unsigned x = m_expr2itv[a->get_arg(1)];
+            unsigned y = m_expr2itv[a->get_arg(2)];
+            // NaN results that do not occur at the corners: 0 * inf, 0 / 0 and inf / inf.
+            if (k == OP_FPA_MUL && ((contains_zero(x, zero) && has_inf(y)) || (contains_zero(y, zero) && has_inf(x))))
+                return false;
+            if (k == OP_FPA_DIV && (contains_zero(y, zero) || (has_inf(x) && has_inf(y))))
+                return false;
+            get_rounding(a->get_arg(0), rm_lo, rm_hi);
+            for (unsigned i = 0; i < 4; ++i) {
+                mpf const & u = i < 2 ? m_lo[x] : m_hi[x];
+                mpf const & v = i % 2 == 0 ? m_lo[y] : m_hi[y];
+                apply(k, rm_lo, u, v, r);
+                if (fm.is_nan(r))
+                    return false;
+                if (i == 0 || fm.lt(r, lo))
+                    fm.set(lo, r);
+                apply(k, rm_hi, u, v, r);
+                if (fm.is_nan(r))
+                    return false;
+                if (i == 0 || fm.lt(hi, r))
+                    fm.set(hi, r);
+            }
+            nan = m_nan[x] || m_nan[y];
+            return true;
+        }
+
+        void eval(expr * e) {
+            scoped_mpf lo(fm), hi(fm), v(fm);
+            bool nan = false;
+            if (fu.is_numeral(e, v) && !fm.is_nan(v)) {
+                fm.set(lo, v);
+                fm.set(hi, v);
+            }
+            else if (!is_interval_op(e) || !eval_op(to_app(e), lo, hi, nan)) {
+                mk_full(m.get_sort(e), lo, hi);
+                nan = true;
+            }
+            m_expr2itv.insert(e, mk_itv(lo, hi, nan));
+        }
+
+        unsigned get_itv(expr * e) {
+            unsigned idx;
+            if (m_expr2itv.find(e, idx))
+                return idx;
+            ptr_buffer<expr> todo;
+            todo.push_back(e);
+            while (!todo.empty()) {
+                expr * t = todo.back();
+                if (m_expr2itv.contains(t)) {
+                    todo.pop_back();
+                    continue;
+                }
+                bool visited = true;
+                if (is_interval_op(t)) {
+                    for (expr * arg : *to_app(t)) {
+                        if (fu.is_float(arg) && !m_expr2itv.contains(arg)) {
+                            todo.push_back(arg);
+                            visited = false;
+                        }
+                    }
+                }
+                if (!visited)
+                    continue;
+                todo.pop_back();
+                eval(t);
+            }
+            return m_expr2itv[e];
+        }
+
+        /**
+           \brief evaluate the comparison a. Bound atoms are skipped since
+           the intervals are derived from them.
+        */
+        lbool eval_atom(app * a) {
+            if (a->get_family_id() != fu.get_family_id())
+                return l_undef;
+            app * x;
+            expr * c;
+            if (is_bound_atom(a, x, c))
+                return l_undef;
+            decl_kind k = a->get_decl_kind();
+            if (k == OP_FPA_IS_NAN)
+                return m_nan[get_itv(a->get_arg(0))] ? l_undef : l_false;
+            expr * e1, * e2;
+            switch (k) {
+            case OP_FPA_LE: case OP_FPA_LT: case OP_FPA_EQ:
+                e1 = a->get_arg(0); e2 = a->get_arg(1); break;
+            case OP_FPA_GE:
+                k = OP_FPA_LE; e1 = a->get_arg(1); e2 = a->get_arg(0); break;
+            case OP_FPA_GT:
+                k = OP_FPA_LT; e1 = a->get_arg(1); e2 = a->get_arg(0); break;
+            default:
+                return l_undef;
+            }
+            unsigned i = get_itv(e1), j = get_itv(e2);
+            bool no_nan = !m_nan[i] && !m_nan[j];
+            switch (k) {
+            case OP_FPA_LE:
+                if (no_nan && fm.le(m_hi[i], m_lo[j]))
+                    return l_true;
+                if (fm.lt(m_hi[j], m_lo[i]))
+                    return l_false;
+                break;
+            case OP_FPA_LT:
+                if (no_nan && fm.lt(m_hi[i], m_lo[j]))
+                    return l_true;
+                if (fm.le(m_hi[j], m_lo[i]))
+                    return l_false;
+                break;
+            case OP_FPA_EQ:
+                if (no_nan && fm.le(m_hi[i], m_lo[j]) && fm.le(m_hi[j], m_lo[i]))
+                    return l_true;
+                if (fm.lt(m_hi[i], m_lo[j]) || fm.lt(m_hi[j], m_lo[i]))
+                    return l_false;
+                break;
+            default:
+                break;
+            }
+            return l_undef;
+        }
+
+        bool simplify(expr * f, expr_ref & result) {
+            expr_safe_replace sub(m);
+            bool found = false;
+            ast_mark visited;
+            ptr_buffer<expr> todo;
+            todo.push_back(f);
+            while (!todo.empty()) {
+                expr * e = todo.back();
+                todo.pop_back();
+                if (!is_app(e) || visited.is_marked(e))
+                    continue;
+                visited.mark(e, true);
+                app * a = to_app(e);
+                if (m.is_bool(a) && a->get_family_id() == fu.get_family_id()) {
+                    lbool r = eval_atom(a);
+                    TRACE("fpa_interval", tout << mk_pp(a, m) << " " << r << "\n";);
+                    if (r != l_undef) {
+                        ++m_num_decided;
+                        sub.insert(a, r == l_true ? m.mk_true() : m.mk_false());
+                        found = true;
+                    }
+                    continue;
+                }
+                for (expr * arg : *a)
+                    if (m.is_bool(arg))
+                        todo.push_back(arg);
+            }
+            if (!found)
+                return false;
+            sub(f, result);
+            m_rw(result);
+            return true;
+        }
+
+        void operator()(goal_ref const & g, goal_ref_buffer & result) {
+            tactic_report report("fpa-interval", *g);
+            if (g->proofs_enabled() || g->unsat_core_enabled() || g->inconsistent()) {
+                result.push_back(g.get());
+                return;
+            }
+            unsigned num_decided = m_num_decided;
+            for (unsigned i = 0; i < g->size(); ++i) {
+                if (!add_bound(g->form(i))) {
+                    ++m_num_conflicts;
+                    g->assert_expr(m.mk_false());
+                    break;
+                }
+            }
+            expr_ref new_f(m);
+            for (unsigned i = 0; !g->inconsistent() && i < g->size(); ++i) {
+                if (!simplify(g->form(i), new_f))
+                    continue;
+                if (m.is_false(new_f))
+                    ++m_num_conflicts;
+                g->update(i, new_f);
+            }
+            g->elim_true();
+            report_tactic_progress(":decided", m_num_decided - num_decided);
+            if (m_num_decided > num_decided)
+                g->inc_depth();
+            result.push_back(g.get());
+            reset();
+        }
+    };
+
+    imp *      m_imp;
+    params_ref m_params;
+
+public:
+    fpa_interval_tactic(ast_manager & m, params_ref const & p):
+        m_params(p) {
+        m_imp = alloc(imp, m, p);
+    }
+
+    ~fpa_interval_tactic() override {
+        dealloc(m_imp);
+    }
+
+    tactic * translate(ast_manager & m) override {
+        return alloc(fpa_interval_tactic, m, m_params);
+    }
+
+    void updt_params(params_ref const & p) override {
+        m_params.append(p);
+        m_imp->m_rw.updt_params(m_params);
+    }
+
+    void operator()(goal_ref const & in, goal_ref_buffer & result) override {
+        (*m_imp)(in, result);
+    }
+
+    void collect_statistics(statistics & st) const override {
+        st.update("fpa-interval decided", m_imp->m_num_decided);
+        st.update("fpa-interval conflicts", m_imp->m_num_conflicts);
+    }
+
+    void reset_statistics() override {
+        m_imp->m_num_decided = 0;
+        m_imp->m_num_conflicts = 0;
+    }
+
+    void cleanup() override {
+        imp * d = alloc(imp, m_imp->m, m_params);
+        std::swap(d->m_num_decided, m_imp->m_num_decided);
+        std::swap(d->m_num_conflicts, m_imp->m_num_conflicts);
+        std::swap(d, m_imp);
+        dealloc(d);
+    }
+};
+
+tactic * mk_fpa_interval_tactic(ast_manager & m, params_ref const & p) {
+    return clean(alloc(fpa_interval_tactic, m, p));
+}
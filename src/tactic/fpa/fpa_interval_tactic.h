@@ -0,0 +1,36 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    fpa_interval_tactic.h
+
+Abstract:
+
+    Word level reasoning on floating point intervals before bit-blasting.
+
+    Top-level comparisons of constants with numerals bound the
+    constants. The bounds are propagated through fp.neg, fp.abs,
+    fp.add, fp.sub, fp.mul, fp.div and fp.sqrt using mpf arithmetic:
+    rounding is monotone, so evaluating the operations at the corners
+    of the argument intervals with the rounding mode of the term (or
+    towards negative and positive infinity for rounding modes that are
+    not numerals) gives sound bounds. Every interval records whether the
+    term may be NaN.
+
+    Comparisons that are decided by the intervals are replaced by true
+    or false, so fpa2bv only creates circuits for the operations whose
+    abstraction is inconclusive. A top-level comparison that is false
+    makes the goal unsatisfiable.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+class ast_manager;
+class tactic;
+
+tactic * mk_fpa_interval_tactic(ast_manager & m, params_ref const & p = params_ref());
+/*
+  ADD_TACTIC("fpa-interval", "decide floating point comparisons using intervals derived from bounds on constants.", "mk_fpa_interval_tactic(m, p)")
+*/
@@ -18,6 +18,7 @@ Notes:
 --*/
 #include "tactic/tactical.h"
 #include "tactic/fpa/fpa2bv_tactic.h"
+#include "tactic/fpa/fpa_interval_tactic.h"
 #include "tactic/core/simplify_tactic.h"
 #include "tactic/core/propagate_values_tactic.h"
 #include "tactic/arith/probe_arith.h"
@@ -85,6 +86,7 @@ tactic * mk_qffp_tactic(ast_manager & m, params_ref const & p) {
 
     tactic * preamble = and_then(mk_simplify_tactic(m, simp_p),
                                  mk_propagate_values_tactic(m, p),
+                                 mk_fpa_interval_tactic(m, p),
                                  mk_fpa2bv_tactic(m, p),
                                  mk_propagate_values_tactic(m, p),
                                  using_params(mk_simplify_tactic(m, p), simp_p),
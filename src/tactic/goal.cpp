@@ -49,7 +49,9 @@ goal::goal(ast_manager & m, bool models_enabled, bool core_enabled):
     m_proofs_enabled(m.proofs_enabled()),
     m_core_enabled(core_enabled),
     m_inconsistent(false),
-    m_precision(PRECISE) {
+    m_precision(PRECISE),
+    m_features_valid(false),
+    m_num_exprs_valid(false) {
     }
 
 goal::goal(ast_manager & m, bool proofs_enabled, bool models_enabled, bool core_enabled):
@@ -60,7 +62,9 @@ goal::goal(ast_manager & m, bool proofs_enabled, bool models_enabled, bool core_
     m_proofs_enabled(proofs_enabled),
     m_core_enabled(core_enabled),
     m_inconsistent(false),
-    m_precision(PRECISE) {
+    m_precision(PRECISE),
+    m_features_valid(false),
+    m_num_exprs_valid(false) {
     SASSERT(!proofs_enabled || m.proofs_enabled());
     }
 
@@ -72,7 +76,9 @@ goal::goal(goal const & src):
     m_proofs_enabled(src.proofs_enabled()),
     m_core_enabled(src.unsat_core_enabled()),
     m_inconsistent(false),
-    m_precision(PRECISE) {
+    m_precision(PRECISE),
+    m_features_valid(false),
+    m_num_exprs_valid(false) {
     copy_from(src);
     }
 
@@ -86,7 +92,9 @@ goal::goal(goal const & src, bool):
     m_proofs_enabled(src.proofs_enabled()),
     m_core_enabled(src.unsat_core_enabled()),
     m_inconsistent(false),
-    m_precision(src.m_precision) {
+    m_precision(src.m_precision),
+    m_features_valid(false),
+    m_num_exprs_valid(false) {
     m_mc = src.m_mc.get();
     m_pc = src.m_pc.get();
     m_dc = src.m_dc.get();
@@ -100,6 +108,7 @@ void goal::copy_to(goal & target) const {
     SASSERT(&m_manager == &(target.m_manager));
     if (this == &target)
         return;
+    target.invalidate_features();
 
     m().copy(m_forms, target.m_forms);
     m().copy(m_proofs, target.m_proofs);
@@ -117,6 +126,7 @@ void goal::copy_to(goal & target) const {
 
 void goal::push_back(expr * f, proof * pr, expr_dependency * d) {
     SASSERT(!proofs_enabled() || pr);
+    invalidate_features();
     if (m().is_true(f))
         return;
     if (m().is_false(f)) {
@@ -130,7 +140,7 @@ void goal::push_back(expr * f, proof * pr, expr_dependency * d) {
         m().del(m_dependencies);
         m_inconsistent = true;
         m().push_back(m_forms, m().mk_false());
-        m().push_back(m_proofs, saved_pr);
+        push_proof(saved_pr);
         if (unsat_core_enabled())
             m().push_back(m_dependencies, saved_d);
     }
@@ -138,12 +148,33 @@ void goal::push_back(expr * f, proof * pr, expr_dependency * d) {
         SASSERT(!pr || m().get_fact(pr) == f);
         SASSERT(!m_inconsistent);
         m().push_back(m_forms, f);
-        m().push_back(m_proofs, pr);
+        push_proof(pr);
         if (unsat_core_enabled())
             m().push_back(m_dependencies, d);
     }
 }
 
+/**
+   \brief record the proof of the last formula.
+   Goals without proofs, in particular goals of proof-free pipelines, do not
+   store null proofs, so copying and rerooting them touches one array less.
+*/
+void goal::push_proof(proof * pr) {
+    if (!pr && m().empty(m_proofs))
+        return;
+    while (m().size(m_proofs) + 1 < size())
+        m().push_back(m_proofs, nullptr);
+    m().push_back(m_proofs, pr);
+}
+
+void goal::set_proof(unsigned i, proof * pr) {
+    if (!pr && m().empty(m_proofs))
+        return;
+    while (m().size(m_proofs) < size())
+        m().push_back(m_proofs, nullptr);
+    m().set(m_proofs, i, pr);
+}
+
 void goal::quick_process(bool save_first, expr_ref& f, expr_dependency * d) {
     expr* g = nullptr;
     if (!m().is_and(f) && !(m().is_not(f, g) && m().is_or(g))) {
@@ -287,6 +318,7 @@ void goal::get_formulas(expr_ref_vector & result) const {
 void goal::update(unsigned i, expr * f, proof * pr, expr_dependency * d) {
     if (m_inconsistent)
         return;
+    invalidate_features();
     if (proofs_enabled()) {
         SASSERT(pr);
         if (!pr)
@@ -301,7 +333,7 @@ void goal::update(unsigned i, expr * f, proof * pr, expr_dependency * d) {
             }
             else {
                 m().set(m_forms, i, out_f);
-                m().set(m_proofs, i, out_pr);
+                set_proof(i, out_pr);
                 if (unsat_core_enabled())
                     m().set(m_dependencies, i, d);
             }
@@ -324,6 +356,7 @@ void goal::update(unsigned i, expr * f, proof * pr, expr_dependency * d) {
 }
 
 void goal::reset_core() {
+    invalidate_features();
     m().del(m_forms);
     m().del(m_proofs);
     m().del(m_dependencies);
@@ -464,22 +497,72 @@ void goal::display_dimacs(std::ostream & out, bool include_names) const {
 }
 
 unsigned goal::num_exprs() const {
+    if (m_num_exprs_valid)
+        return m_num_exprs;
     expr_fast_mark1 visited;
     unsigned sz = size();
     unsigned r  = 0;
     for (unsigned i = 0; i < sz; i++) {
         r += get_num_exprs(form(i), visited);
     }
+    m_num_exprs = r;
+    m_num_exprs_valid = true;
     return r;
 }
 
+namespace {
+    struct features_proc {
+        ast_manager &    m;
+        goal::features & m_f;
+        family_id        m_arith_fid;
+        family_id        m_bv_fid;
+        features_proc(ast_manager & m, goal::features & f):
+            m(m), m_f(f), m_arith_fid(m.mk_family_id("arith")), m_bv_fid(m.mk_family_id("bv")) {}
+        void operator()(var *) {}
+        void operator()(quantifier * q) {
+            m_f.m_has_quantifiers = true;
+            if (q->get_num_patterns() > 0 || q->get_num_no_patterns() > 0)
+                m_f.m_has_patterns = true;
+        }
+        void operator()(app * n) {
+            if (n->get_num_args() > 0 || m.is_value(n))
+                return;
+            if (m.is_bool(n)) {
+                m_f.m_num_bool_consts++;
+                return;
+            }
+            m_f.m_num_consts++;
+            family_id fid = m.get_sort(n)->get_family_id();
+            if (fid == m_arith_fid)
+                m_f.m_num_arith_consts++;
+            else if (fid == m_bv_fid)
+                m_f.m_num_bv_consts++;
+        }
+    };
+}
+
+goal::features const & goal::get_features() const {
+    if (m_features_valid)
+        return m_features;
+    m_features = features();
+    features_proc p(m(), m_features);
+    expr_fast_mark1 visited;
+    unsigned sz = size();
+    for (unsigned i = 0; i < sz; i++) 
+        for_each_expr_core<features_proc, expr_fast_mark1, true, true>(p, visited, form(i));
+    m_features_valid = true;
+    return m_features;
+}
+
 void goal::shrink(unsigned j) {
     SASSERT(j <= size());
+    invalidate_features();
     unsigned sz = size();
     for (unsigned i = j; i < sz; i++)
         m().pop_back(m_forms);
-    for (unsigned i = j; i < sz; i++)
-        m().pop_back(m_proofs);
+    if (!m().empty(m_proofs))
+        for (unsigned i = j; i < sz; i++)
+            m().pop_back(m_proofs);
     if (unsat_core_enabled()) 
         for (unsigned i = j; i < sz; i++)
             m().pop_back(m_dependencies);
@@ -489,6 +572,7 @@ void goal::shrink(unsigned j) {
    \brief Eliminate true formulas.
 */
 void goal::elim_true() {
+    invalidate_features();
     unsigned sz = size();
     unsigned j = 0;
     for (unsigned i = 0; i < sz; i++) {
@@ -500,7 +584,7 @@ void goal::elim_true() {
             continue;
         }
         m().set(m_forms, j, f);
-        m().set(m_proofs, j, m().get(m_proofs, i));
+        set_proof(j, pr(i));
         if (unsat_core_enabled())
             m().set(m_dependencies, j, m().get(m_dependencies, i));
         j++;
@@ -538,6 +622,7 @@ unsigned goal::get_not_idx(expr * f) const {
 void goal::elim_redundancies() {
     if (inconsistent())
         return;
+    invalidate_features();
     expr_ref_fast_mark1 neg_lits(m());
     expr_ref_fast_mark2 pos_lits(m());
     unsigned sz = size();
@@ -586,7 +671,7 @@ void goal::elim_redundancies() {
             continue;
         }
         m().set(m_forms, j, f);
-        m().set(m_proofs, j, pr(i));
+        set_proof(j, pr(i));
         if (unsat_core_enabled())
             m().set(m_dependencies, j, dep(i));
         j++;
@@ -623,7 +708,8 @@ goal * goal::translate(ast_translation & translator) const {
     unsigned sz = m().size(m_forms);
     for (unsigned i = 0; i < sz; i++) {
         res->m().push_back(res->m_forms, translator(m().get(m_forms, i)));
-        res->m().push_back(res->m_proofs, translator(m().get(m_proofs, i)));
+        if (!m().empty(m_proofs))
+            res->m().push_back(res->m_proofs, translator(m().get(m_proofs, i)));
         if (res->unsat_core_enabled())
             res->m().push_back(res->m_dependencies, dep_translator(m().get(m_dependencies, i)));
     }
@@ -56,7 +56,7 @@ protected:
     dependency_converter_ref m_dc;
     unsigned              m_ref_count;
     expr_array            m_forms;
-    expr_array            m_proofs;
+    expr_array            m_proofs;            // empty if no formula has a proof, otherwise as long as m_forms.
     expr_dependency_array m_dependencies;
     // attributes
     unsigned              m_depth:26;          // depth of the goal in the goal tree.
@@ -65,8 +65,32 @@ protected:
     unsigned              m_core_enabled:1;    // unsat core extraction is enabled.
     unsigned              m_inconsistent:1;    // true if the goal is known to be inconsistent. 
     unsigned              m_precision:2;       // PRECISE, UNDER, OVER.
+    mutable unsigned      m_features_valid:1;  // m_features describes the current formulas.
+    mutable unsigned      m_num_exprs_valid:1; // m_num_exprs describes the current formulas.
+
+public:
+    /**
+       \brief statistics of the formulas used by probes. They are computed in
+       one traversal and kept until the formulas change.
+    */
+    struct features {
+        unsigned m_num_consts { 0 };        // non Boolean constants
+        unsigned m_num_bool_consts { 0 };
+        unsigned m_num_arith_consts { 0 };
+        unsigned m_num_bv_consts { 0 };
+        bool     m_has_quantifiers { false };
+        bool     m_has_patterns { false };
+    };
+
+protected:
+    mutable features      m_features;
+    mutable unsigned      m_num_exprs;
+
+    void invalidate_features() { m_features_valid = false; m_num_exprs_valid = false; }
 
     void push_back(expr * f, proof * pr, expr_dependency * d);
+    void push_proof(proof * pr);
+    void set_proof(unsigned i, proof * pr);
     void quick_process(bool save_first, expr_ref & f, expr_dependency * d);
     void process_and(bool save_first, app * f, proof * pr, expr_dependency * d, expr_ref & out_f, proof_ref & out_pr);
     void process_not_or(bool save_first, app * f, proof * pr, expr_dependency * d, expr_ref & out_f, proof_ref & out_pr);
@@ -118,6 +142,8 @@ public:
     unsigned size() const { return m().size(m_forms); }
 
     unsigned num_exprs() const;
+
+    features const & get_features() const;
   
     expr * form(unsigned i) const { return m().get(m_forms, i); }
     proof * pr(unsigned i) const { return m().size(m_proofs) > i ? static_cast<proof*>(m().get(m_proofs, i)) : nullptr; }
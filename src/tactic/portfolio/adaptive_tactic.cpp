@@ -0,0 +1,253 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    adaptive_tactic.cpp
+
+Abstract:
+
+    Portfolio of the logic specific strategies of the default tactic
+    that is ordered by the running times recorded for similar goals.
+
+--*/
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
+#include "util/cancel_eh.h"
+#include "util/scoped_timer.h"
+#include "util/stopwatch.h"
+#include "tactic/tactical.h"
+#include "tactic/portfolio/adaptive_tactic.h"
+#include "tactic/core/simplify_tactic.h"
+#include "tactic/smtlogics/qfbv_tactic.h"
+#include "smt/tactic/smt_tactic.h"
+#include "tactic/smtlogics/qflia_tactic.h"
+#include "tactic/smtlogics/qflra_tactic.h"
+#include "tactic/smtlogics/qfnia_tactic.h"
+#include "tactic/smtlogics/qfnra_tactic.h"
+#include "tactic/smtlogics/nra_tactic.h"
+#include "tactic/arith/probe_arith.h"
+#include "tactic/smtlogics/quant_tactics.h"
+#include "tactic/fpa/qffp_tactic.h"
+#include "tactic/fpa/qffplra_tactic.h"
+#include "tactic/smtlogics/qfaufbv_tactic.h"
+#include "tactic/smtlogics/qfauflia_tactic.h"
+#include "tactic/fd_solver/fd_solver.h"
+
+class adaptive_tactic : public tactic {
+
+    struct strategy {
+        std::string m_name;
+        probe_ref   m_probe;
+        tactic_ref  m_tactic;
+        strategy(char const* n, probe* p, tactic* t): m_name(n), m_probe(p), m_tactic(t) {}
+    };
+
+    struct record {
+        unsigned m_runs   { 0 };
+        unsigned m_solved { 0 };
+        double   m_seconds { 0 };
+        // time per decided goal, strategies that never decided a goal come last.
+        double cost() const { return m_solved == 0 ? 1e9 + m_seconds : m_seconds / m_solved; }
+    };
+
+    struct stats {
+        unsigned m_num_attempts  { 0 };
+        unsigned m_num_timeouts  { 0 };
+        unsigned m_num_fallbacks { 0 };
+    };
+
+    ast_manager&                  m;
+    params_ref                    m_params;
+    vector<strategy>              m_strategies;
+    std::map<std::string, record> m_profile;    // key is "<class> <strategy>"
+    std::string                   m_file;
+    bool                          m_loaded { false };
+    double                        m_timeout_factor { 2.0 };
+    unsigned                      m_min_timeout { 1000 };
+    stats                         m_stats;
+
+    void init_strategies() {
+        params_ref const& p = m_params;
+        m_strategies.push_back(strategy("fd", mk_and(mk_is_propositional_probe(), mk_not(mk_produce_proofs_probe())), mk_fd_tactic(m, p)));
+        m_strategies.push_back(strategy("qfbv", mk_is_qfbv_probe(), mk_qfbv_tactic(m)));
+        m_strategies.push_back(strategy("qfaufbv", mk_is_qfaufbv_probe(), mk_qfaufbv_tactic(m)));
+        m_strategies.push_back(strategy("qflia", mk_is_qflia_probe(), mk_qflia_tactic(m)));
+        m_strategies.push_back(strategy("qfauflia", mk_is_qfauflia_probe(), mk_qfauflia_tactic(m)));
+        m_strategies.push_back(strategy("qflra", mk_is_qflra_probe(), mk_qflra_tactic(m)));
+        m_strategies.push_back(strategy("qfnra", mk_is_qfnra_probe(), mk_qfnra_tactic(m)));
+        m_strategies.push_back(strategy("qfnia", mk_is_qfnia_probe(), mk_qfnia_tactic(m)));
+        m_strategies.push_back(strategy("lira", mk_is_lira_probe(), mk_lira_tactic(m, p)));
+        m_strategies.push_back(strategy("nra", mk_is_nra_probe(), mk_nra_tactic(m)));
+        m_strategies.push_back(strategy("qffp", mk_is_qffp_probe(), mk_qffp_tactic(m, p)));
+        m_strategies.push_back(strategy("qffplra", mk_is_qffplra_probe(), mk_qffplra_tactic(m, p)));
+        m_strategies.push_back(strategy("smt", mk_const_probe(1.0), and_then(mk_preamble_tactic(m), mk_smt_tactic(m))));
+        for (strategy& s : m_strategies)
+            s.m_tactic->updt_params(p);
+    }
+
+    void load() {
+        if (m_loaded || m_file.empty())
+            return;
+        m_loaded = true;
+        std::ifstream in(m_file);
+        std::string key, name;
+        record r;
+        while (in >> key >> name >> r.m_runs >> r.m_solved >> r.m_seconds)
+            m_profile[key + " " + name] = r;
+    }
+
+    void save() {
+        if (m_file.empty())
+            return;
+        std::ofstream out(m_file);
+        if (!out) {
+            warning_msg("could not write adaptive profile %s", m_file.c_str());
+            return;
+        }
+        for (auto const& kv : m_profile)
+            if (kv.second.m_runs > 0)
+                out << kv.first << " " << kv.second.m_runs << " " << kv.second.m_solved << " " << kv.second.m_seconds << "\n";
+    }
+
+    std::string classify(goal const& g, ptr_vector<strategy>& candidates) {
+        std::string logic;
+        for (strategy& s : m_strategies) {
+            if (!(*s.m_probe)(g).is_true())
+                continue;
+            candidates.push_back(&s);
+            if (logic.empty())
+                logic = s.m_name;
+        }
+        return logic + ":" + std::to_string(log2(g.num_exprs() + 1));
+    }
+
+    record& get_record(std::string const& key, strategy const& s) {
+        return m_profile[key + " " + s.m_name];
+    }
+
+    /**
+       \brief run s on in with the given timeout (0 for none).
+       Return false if s failed or did not finish in time.
+    */
+    bool run(strategy& s, unsigned timeout, goal_ref const& in, goal_ref_buffer& result) {
+        cancel_eh<reslimit> eh(m.limit());
+        scoped_timer timer(timeout, &eh);
+        try {
+            (*s.m_tactic)(in, result);
+            return true;
+        }
+        catch (z3_error&) {
+            throw;
+        }
+        catch (z3_exception& ex) {
+            if (!eh.canceled() && !m.inc())
+                throw;
+            if (eh.canceled())
+                m_stats.m_num_timeouts++;
+            IF_VERBOSE(10, verbose_stream() << "(adaptive :strategy " << s.m_name << " :failed \"" << ex.msg() << "\")\n");
+            return false;
+        }
+    }
+
+public:
+
+    adaptive_tactic(ast_manager& m, params_ref const& p): m(m), m_params(p) {
+        init_strategies();
+        updt_params(p);
+    }
+
+    tactic * translate(ast_manager & m) override {
+        return alloc(adaptive_tactic, m, m_params);
+    }
+
+    void updt_params(params_ref const & p) override {
+        m_params.append(p);
+        std::string file = m_params.get_str("profile", "");
+        if (file != m_file) {
+            m_file = file;
+            m_loaded = false;
+        }
+        m_timeout_factor = m_params.get_double("timeout_factor", 2.0);
+        m_min_timeout = m_params.get_uint("min_timeout", 1000);
+        for (strategy& s : m_strategies)
+            s.m_tactic->updt_params(p);
+    }
+
+    void collect_param_descrs(param_descrs & r) override {
+        r.insert("profile", CPK_STRING, "file recording the times of the strategies for classes of goals, empty for a profile of this tactic only", "");
+        r.insert("timeout_factor", CPK_DOUBLE, "strategies other than the last are stopped after this multiple of the best recorded time", "2.0");
+        r.insert("min_timeout", CPK_UINT, "minimal timeout (in milliseconds) of strategies other than the last", "1000");
+    }
+
+    void operator()(goal_ref const & in, goal_ref_buffer& result) override {
+        load();
+        ptr_vector<strategy> candidates;
+        std::string key = classify(*in, candidates);
+        std::stable_sort(candidates.begin(), candidates.end(), [&](strategy* a, strategy* b) {
+            record const& ra = get_record(key, *a);
+            record const& rb = get_record(key, *b);
+            return (ra.m_runs == 0 ? 0 : ra.cost()) < (rb.m_runs == 0 ? 0 : rb.cost());
+        });
+        double best = -1;
+        for (strategy* s : candidates) {
+            record const& r = get_record(key, *s);
+            if (r.m_solved > 0 && (best < 0 || r.cost() < best))
+                best = r.cost();
+        }
+        unsigned timeout = 0;
+        if (best >= 0)
+            timeout = std::max(m_min_timeout, static_cast<unsigned>(m_timeout_factor * best * 1000));
+
+        goal orig(*(in.get()));
+        for (unsigned i = 0; i < candidates.size(); ++i) {
+            strategy& s = *candidates[i];
+            bool last = i + 1 == candidates.size();
+            IF_VERBOSE(10, verbose_stream() << "(adaptive :class " << key << " :strategy " << s.m_name << " :timeout " << (last ? 0 : timeout) << ")\n");
+            m_stats.m_num_attempts++;
+            record& r = get_record(key, s);
+            stopwatch sw;
+            sw.start();
+            bool ok = last ? (s.m_tactic->operator()(in, result), true) : run(s, timeout, in, result);
+            sw.stop();
+            bool solved = ok && is_decided(result);
+            r.m_runs++;
+            r.m_seconds += sw.get_seconds();
+            if (solved)
+                r.m_solved++;
+            if (last || solved) {
+                save();
+                return;
+            }
+            m_stats.m_num_fallbacks++;
+            result.reset();
+            in->reset_all();
+            in->copy_from(orig);
+        }
+    }
+
+    void collect_statistics(statistics & st) const override {
+        st.update("adaptive attempts", m_stats.m_num_attempts);
+        st.update("adaptive timeouts", m_stats.m_num_timeouts);
+        st.update("adaptive fallbacks", m_stats.m_num_fallbacks);
+        for (strategy const& s : m_strategies)
+            s.m_tactic->collect_statistics(st);
+    }
+
+    void reset_statistics() override {
+        m_stats = stats();
+        for (strategy& s : m_strategies)
+            s.m_tactic->reset_statistics();
+    }
+
+    void cleanup() override {
+        for (strategy& s : m_strategies)
+            s.m_tactic->cleanup();
+    }
+};
+
+tactic * mk_adaptive_tactic(ast_manager & m, params_ref const & p) {
+    return using_params(and_then(mk_simplify_tactic(m), alloc(adaptive_tactic, m, p)), p);
+}
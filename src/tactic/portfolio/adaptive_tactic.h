@@ -0,0 +1,37 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    adaptive_tactic.h
+
+Abstract:
+
+    Portfolio of the logic specific strategies of the default tactic
+    that is ordered by the running times recorded for similar goals.
+
+    Goals are classified by the first logic probe they satisfy and by
+    the magnitude of their number of expressions. For every class the
+    tactic records how often each strategy was tried, how often it
+    decided the goal and the time it took. Strategies are tried in order
+    of their time per decided goal, strategies that were not tried on
+    the class before come first. All strategies but the last are
+    bounded by a multiple of the best recorded time for the class, a
+    strategy that times out or does not decide the goal is followed by
+    the next one.
+
+    When the parameter profile names a file, the recorded times are
+    read from and written to it, so they carry over between processes.
+
+--*/
+#pragma once
+
+#include "util/params.h"
+class ast_manager;
+class tactic;
+
+tactic * mk_adaptive_tactic(ast_manager & m, params_ref const & p = params_ref());
+
+/*
+ADD_TACTIC("adaptive", "logic specific strategies ordered by the times recorded for similar goals.", "mk_adaptive_tactic(m, p)")
+*/
@@ -403,70 +403,30 @@ probe * mk_is_qfufbv_probe() {
 
 
 class num_consts_probe : public probe {
-    bool         m_bool;   // If true, track only boolean constants. Otherwise, track only non boolean constants.
-    char const * m_family; // (Ignored if m_bool == true), if != 0 and m_bool == true, then track only constants of the given family.
-    struct proc {
-        ast_manager & m;
-        bool          m_bool;
-        family_id     m_fid;
-        unsigned      m_counter;
-        proc(ast_manager & _m, bool b, char const * family):m(_m), m_bool(b), m_counter(0) {
-            if (family != nullptr)
-                m_fid = m.mk_family_id(family);
-            else
-                m_fid = null_family_id;
-        }
-        void operator()(quantifier *) {}
-        void operator()(var *) {}
-        void operator()(app * n) {
-            if (n->get_num_args() == 0 && !m.is_value(n)) {
-                if (m_bool) {
-                    if (m.is_bool(n))
-                        m_counter++;
-                }
-                else {
-                    if (m_fid == null_family_id) {
-                        if (!m.is_bool(n))
-                            m_counter++;
-                    }
-                    else {
-                        if (m.get_sort(n)->get_family_id() == m_fid)
-                            m_counter++;
-                    }
-                }
-            }
-        }
-    };
-
+    unsigned goal::features::* m_counter;
 public:
-    num_consts_probe(bool b, char const * f):
-        m_bool(b), m_family(f) {
+    num_consts_probe(unsigned goal::features::* counter):
+        m_counter(counter) {
     }
     result operator()(goal const & g) override {
-        proc p(g.m(), m_bool, m_family);
-        unsigned sz = g.size();
-        expr_fast_mark1 visited;
-        for (unsigned i = 0; i < sz; i++) {
-            for_each_expr_core<proc, expr_fast_mark1, true, true>(p, visited, g.form(i));
-        }
-        return result(p.m_counter);
+        return result(g.get_features().*m_counter);
     }
 };
 
 probe * mk_num_consts_probe() {
-    return alloc(num_consts_probe, false, nullptr);
+    return alloc(num_consts_probe, &goal::features::m_num_consts);
 }
 
 probe * mk_num_bool_consts_probe() {
-    return alloc(num_consts_probe, true, nullptr);
+    return alloc(num_consts_probe, &goal::features::m_num_bool_consts);
 }
 
 probe * mk_num_arith_consts_probe() {
-    return alloc(num_consts_probe, false, "arith");
+    return alloc(num_consts_probe, &goal::features::m_num_arith_consts);
 }
 
 probe * mk_num_bv_consts_probe() {
-    return alloc(num_consts_probe, false, "bv");
+    return alloc(num_consts_probe, &goal::features::m_num_bv_consts);
 }
 
 class produce_proofs_probe : public probe {
@@ -503,30 +463,8 @@ probe * mk_produce_unsat_cores_probe() {
 }
 
 struct has_pattern_probe : public probe {
-    struct found {};
-
-    struct proc {
-        void operator()(var * n) {}
-        void operator()(app * n) {}
-        void operator()(quantifier * n) {
-            if (n->get_num_patterns() > 0 || n->get_num_no_patterns() > 0)
-                throw found();
-        }
-    };
-public:
     result operator()(goal const & g) override {
-        try {
-            expr_fast_mark1 visited;
-            proc p;
-            unsigned sz = g.size();
-            for (unsigned i = 0; i < sz; i++) {
-                quick_for_each_expr(p, visited, g.form(i));
-            }
-            return false;
-        }
-        catch (const found &) {
-            return true;
-        }
+        return g.get_features().m_has_patterns;
     }
 };
 
@@ -536,27 +474,8 @@ probe * mk_has_pattern_probe() {
 
 
 struct has_quantifier_probe : public probe {
-    struct found {};
-
-    struct proc {
-        void operator()(var * n) {}
-        void operator()(app * n) {}
-        void operator()(quantifier * n) { throw found(); }
-    };
-public:
     result operator()(goal const & g) override {
-        try {
-            expr_fast_mark1 visited;
-            proc p;
-            unsigned sz = g.size();
-            for (unsigned i = 0; i < sz; i++) {
-                quick_for_each_expr(p, visited, g.form(i));
-            }
-            return false;
-        }
-        catch (const found &) {
-            return true;
-        }
+        return g.get_features().m_has_quantifiers;
     }
 };
 
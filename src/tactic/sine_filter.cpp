@@ -15,222 +15,298 @@ Author:
 
 Revision History:
 --*/
-
 #include "tactic/sine_filter.h"
 #include "tactic/tactical.h"
-#include "tactic/generic_model_converter.h"
-#include "ast/datatype_decl_plugin.h"
-#include "ast/rewriter/rewriter_def.h"
-#include "ast/rewriter/var_subst.h"
-#include "ast/ast_util.h"
-#include "util/obj_pair_hashtable.h"
 #include "ast/ast_pp.h"
 
+/**
+   \brief Index of the uninterpreted symbols of formulas for SInE
+   premise selection.
+
+   The symbols of a formula are collected once and kept across
+   selections, so selecting premises again, for a goal that shares most
+   formulas with a previous one or with wider parameters, only
+   recomputes the occurrence counts and the trigger relation.
+
+   A symbol s triggers a formula F if s occurs in F and the number of
+   formulas containing s is at most tolerance times the number of
+   formulas containing the rarest symbol of F. Starting from the symbols
+   of the conjecture (the last formula), the formulas triggered by
+   reached symbols are selected and their symbols are reached in turn,
+   for at most depth rounds.
+*/
+class sine_index {
+    ast_manager&                  m;
+    expr_ref_vector               m_forms;
+    obj_map<expr, unsigned>       m_form2id;
+    vector<ptr_vector<func_decl>> m_syms;
+
+    void collect_symbols(expr* f, ptr_vector<func_decl>& syms) {
+        obj_hashtable<func_decl> seen;
+        expr_mark visited;
+        ptr_vector<expr> todo;
+        todo.push_back(f);
+        while (!todo.empty()) {
+            expr* e = todo.back();
+            todo.pop_back();
+            if (visited.is_marked(e))
+                continue;
+            visited.mark(e, true);
+            if (is_app(e)) {
+                app* a = to_app(e);
+                if (is_uninterp(a) && !seen.contains(a->get_decl())) {
+                    seen.insert(a->get_decl());
+                    syms.push_back(a->get_decl());
+                }
+                for (expr* arg : *a)
+                    todo.push_back(arg);
+            }
+            else if (is_quantifier(e)) {
+                todo.push_back(to_quantifier(e)->get_expr());
+            }
+        }
+    }
+
+public:
+
+    sine_index(ast_manager& m): m(m), m_forms(m) {}
+
+    unsigned get_id(expr* f) {
+        unsigned id;
+        if (m_form2id.find(f, id))
+            return id;
+        id = m_forms.size();
+        m_forms.push_back(f);
+        m_form2id.insert(f, id);
+        m_syms.push_back(ptr_vector<func_decl>());
+        collect_symbols(f, m_syms.back());
+        return id;
+    }
+
+    /**
+       \brief mark the formulas of g that are selected for the given
+       tolerance and depth. Return the number of selected formulas.
+    */
+    unsigned select(goal const& g, double tolerance, unsigned depth, bool_vector& selected) {
+        unsigned sz = g.size();
+        selected.reset();
+        selected.resize(sz, false);
+        if (sz == 0)
+            return 0;
+        unsigned_vector ids;
+        obj_map<func_decl, unsigned> occs;
+        for (unsigned i = 0; i < sz; ++i) {
+            unsigned id = get_id(g.form(i));
+            ids.push_back(id);
+            for (func_decl* s : m_syms[id])
+                occs.insert_if_not_there(s, 0)++;
+        }
+
+        unsigned num_selected = 0;
+        obj_map<func_decl, unsigned_vector> triggers;
+        for (unsigned i = 0; i < sz; ++i) {
+            ptr_vector<func_decl> const& syms = m_syms[ids[i]];
+            if (syms.empty()) {
+                // formulas without symbols are kept, they may be false
+                selected[i] = true;
+                ++num_selected;
+                continue;
+            }
+            unsigned min_occs = UINT_MAX;
+            for (func_decl* s : syms)
+                min_occs = std::min(min_occs, occs[s]);
+            for (func_decl* s : syms)
+                if (occs[s] <= tolerance * min_occs)
+                    triggers.insert_if_not_there(s, unsigned_vector()).push_back(i);
+        }
+
+        obj_hashtable<func_decl> reached;
+        ptr_vector<func_decl> frontier, next;
+        if (!selected[sz - 1]) {
+            selected[sz - 1] = true;
+            ++num_selected;
+        }
+        for (func_decl* s : m_syms[ids[sz - 1]]) {
+            reached.insert(s);
+            frontier.push_back(s);
+        }
+        for (unsigned d = 0; d < depth && !frontier.empty(); ++d) {
+            next.reset();
+            for (func_decl* s : frontier) {
+                unsigned_vector const* fs = triggers.find_core(s) ? &triggers.find(s) : nullptr;
+                if (!fs)
+                    continue;
+                for (unsigned i : *fs) {
+                    if (selected[i])
+                        continue;
+                    selected[i] = true;
+                    ++num_selected;
+                    for (func_decl* t : m_syms[ids[i]])
+                        if (!reached.contains(t)) {
+                            reached.insert(t);
+                            next.push_back(t);
+                        }
+                }
+            }
+            frontier.swap(next);
+        }
+        TRACE("sine", tout << "tolerance: " << tolerance << " depth: " << depth << " selected " << num_selected << " of " << sz << "\n";);
+        return num_selected;
+    }
+
+    void reset() {
+        m_forms.reset();
+        m_form2id.reset();
+        m_syms.reset();
+    }
+};
+
+static void sine_collect_param_descrs(param_descrs & r) {
+    r.insert("tolerance", CPK_DOUBLE, "a symbol triggers a formula if it occurs in at most this multiple of the number of formulas containing the rarest symbol of the formula", "1.0");
+    r.insert("depth", CPK_UINT, "maximal number of rounds of selecting formulas triggered by reached symbols", "4294967295");
+}
+
 class sine_tactic : public tactic {
 
     ast_manager&  m;
     params_ref    m_params;
+    sine_index    m_index;
+    double        m_tolerance;
+    unsigned      m_depth;
 
 public:
 
     sine_tactic(ast_manager& m, params_ref const& p):
-        m(m), m_params(p) {}
+        m(m), m_params(p), m_index(m) {
+        updt_params(p);
+    }
 
     tactic * translate(ast_manager & m) override {
         return alloc(sine_tactic, m, m_params);
     }
 
     void updt_params(params_ref const & p) override {
+        m_params.append(p);
+        m_tolerance = m_params.get_double("tolerance", 1.0);
+        m_depth = m_params.get_uint("depth", UINT_MAX);
     }
 
     void collect_param_descrs(param_descrs & r) override {
+        sine_collect_param_descrs(r);
     }
 
     void operator()(goal_ref const & g, goal_ref_buffer& result) override {
         TRACE("sine", g->display(tout););
-        TRACE("sine", tout << g->size(););
-        ptr_vector<expr> new_forms;
-        filter_expressions(g, new_forms);
-        TRACE("sine", tout << new_forms.size(););
-        g->reset();
-        for (unsigned i = 0; i < new_forms.size(); i++) {
-            g->assert_expr(new_forms.get(i), nullptr, nullptr);
+        bool_vector selected;
+        if (m_index.select(*g, m_tolerance, m_depth, selected) < g->size()) {
+            for (unsigned i = 0; i < g->size(); ++i)
+                if (!selected[i])
+                    g->update(i, m.mk_true(), nullptr, nullptr);
+            g->elim_true();
+            g->inc_depth();
+            g->updt_prec(goal::OVER);
         }
-        g->inc_depth();
-        g->updt_prec(goal::OVER);
         result.push_back(g.get());
         TRACE("sine", result[0]->display(tout););
         SASSERT(g->is_well_formed());
     }
 
     void cleanup() override {
+        m_index.reset();
     }
+};
 
-private:
+/**
+   \brief Run t on the premises selected by SInE. Unsatisfiability of the
+   selected premises carries over to the goal, other results do not, so
+   the selection is widened until t decides unsat or all formulas are
+   selected.
+*/
+class sine_widening_tactic : public tactic {
 
-    typedef std::pair<expr*,expr*> t_work_item;
+    ast_manager&  m;
+    params_ref    m_params;
+    tactic_ref    m_tactic;
+    sine_index    m_index;
+    double        m_tolerance;
+    unsigned      m_depth;
+    double        m_widen_factor;
+    unsigned      m_num_widenings;
 
-    t_work_item work_item(expr * e, expr * root) {
-        return std::pair<expr*, expr*>(e, root);
-    }
+public:
 
-    void find_constants(expr * e, obj_hashtable<func_decl> &consts) {
-        ptr_vector<expr> stack;
-        stack.push_back(e);
-        expr * curr;
-        while (!stack.empty()) {
-            curr = stack.back();
-            stack.pop_back();
-            if (is_app(curr) && is_uninterp(curr)) {
-                app *a = to_app(curr);
-                func_decl *f = a->get_decl();
-                consts.insert_if_not_there(f);
-            }
-        }
+    sine_widening_tactic(ast_manager& m, tactic* t, params_ref const& p):
+        m(m), m_params(p), m_tactic(t), m_index(m), m_num_widenings(0) {
+        updt_params(p);
     }
 
-    bool quantifier_matches(quantifier * q,
-                            obj_hashtable<func_decl> const & consts,
-                            ptr_vector<func_decl> & next_consts) {
-        TRACE("sine",
-              tout << "size of consts is "; tout << consts.size(); tout << "\n";
-              for (func_decl* f : consts) tout << f->get_name() << "\n";);
-
-        bool matched = false;
-        for (unsigned i = 0; i < q->get_num_patterns(); i++) {
-            bool p_matched = true;
-            ptr_vector<expr> stack;
-            expr * curr;
+    tactic * translate(ast_manager & m) override {
+        return alloc(sine_widening_tactic, m, m_tactic->translate(m), m_params);
+    }
 
-            // patterns are wrapped with "pattern"
-            if (!m.is_pattern(q->get_pattern(i), stack))
-                continue;
+    void updt_params(params_ref const & p) override {
+        m_params.append(p);
+        m_tolerance = m_params.get_double("tolerance", 1.0);
+        m_depth = m_params.get_uint("depth", UINT_MAX);
+        m_widen_factor = std::max(1.1, m_params.get_double("widen_factor", 2.0));
+        m_tactic->updt_params(p);
+    }
 
-            while (!stack.empty()) {
-                curr = stack.back();
-                stack.pop_back();
-
-                if (is_app(curr)) {
-                    app * a = to_app(curr);
-                    func_decl * f = a->get_decl();
-                    if (!consts.contains(f)) {
-                        TRACE("sine", tout << mk_pp(f, m) << "\n";);
-                        p_matched = false;
-                        next_consts.push_back(f);
-                        break;
-                    }
-                    for (unsigned j = 0; j < a->get_num_args(); j++)
-                        stack.push_back(a->get_arg(j));
-                }
-            }
+    void collect_param_descrs(param_descrs & r) override {
+        sine_collect_param_descrs(r);
+        r.insert("widen_factor", CPK_DOUBLE, "factor by which tolerance is multiplied when the selected formulas are not unsat", "2.0");
+        m_tactic->collect_param_descrs(r);
+    }
 
-            if (p_matched) {
-                matched = true;
+    void operator()(goal_ref const & g, goal_ref_buffer& result) override {
+        double tolerance = m_tolerance;
+        unsigned depth = m_depth;
+        unsigned last = 0;
+        bool_vector selected;
+        while (true) {
+            unsigned n = m_index.select(*g, tolerance, depth, selected);
+            if (n == g->size() || n == last)
                 break;
-            }
+            last = n;
+            goal_ref sub = alloc(goal, *g, true);
+            for (unsigned i = 0; i < g->size(); ++i)
+                if (selected[i])
+                    sub->assert_expr(g->form(i), g->pr(i), g->dep(i));
+            IF_VERBOSE(10, verbose_stream() << "(sine :tolerance " << tolerance << " :selected " << n << " :of " << g->size() << ")\n");
+            (*m_tactic)(sub, result);
+            if (is_decided_unsat(result))
+                return;
+            result.reset();
+            if (!m.inc())
+                throw tactic_exception(m.limit().get_cancel_msg());
+            ++m_num_widenings;
+            tolerance *= m_widen_factor;
+            if (depth != UINT_MAX)
+                depth = 2 * depth + 1;
         }
+        (*m_tactic)(g, result);
+    }
 
-        return matched;
-    }
-
-    void filter_expressions(goal_ref const & g, ptr_vector<expr> & new_exprs) {
-        obj_map<func_decl, obj_hashtable<expr> > const2exp;
-        obj_map<expr, obj_hashtable<func_decl> > exp2const;
-        obj_map<func_decl, obj_pair_hashtable<expr, expr> > const2quantifier;
-        obj_hashtable<func_decl> consts;
-        vector<t_work_item> stack;
-        t_work_item curr;
-
-        for (unsigned i = 0; i < g->size(); i++)
-            stack.push_back(work_item(g->form(i), g->form(i)));
-
-        while (!stack.empty()) {
-            curr = stack.back();
-            stack.pop_back();
-            if (is_app(curr.first) && is_uninterp(curr.first)) {
-                app * a = to_app(curr.first);
-                func_decl * f = a->get_decl();
-                if (!consts.contains(f)) {
-                    consts.insert(f);
-                    if (const2quantifier.contains(f)) {
-                        for (auto const& p : const2quantifier[f]) 
-                            stack.push_back(p);
-                        const2quantifier.remove(f);
-                    }
-                }
-                if (!const2exp.contains(f)) {
-                    const2exp.insert(f, obj_hashtable<expr>());
-                }
-                if (!const2exp[f].contains(curr.second)) {
-                    const2exp[f].insert(curr.second);
-                }
-                if (!exp2const.contains(curr.second)) {
-                    exp2const.insert(curr.second, obj_hashtable<func_decl>());
-                }
-                if (!exp2const[curr.second].contains(f)) {
-                    exp2const[curr.second].insert(f);
-                }
-
-                for (unsigned i = 0; i < a->get_num_args(); i++) {
-                    stack.push_back(work_item(a->get_arg(i), curr.second));
-                }
-            }
-            else if (is_quantifier(curr.first)) {
-                quantifier *q = to_quantifier(curr.first);
-                if (is_forall(q)) {
-                    if (q->has_patterns()) {
-                        ptr_vector<func_decl> next_consts;
-                        if (quantifier_matches(q, consts, next_consts)) {
-                            stack.push_back(work_item(q->get_expr(), curr.second));
-                        }
-                        else {
-                            for (unsigned i = 0; i < next_consts.size(); i++) {
-                                func_decl *c = next_consts.get(i);
-                                if (!const2quantifier.contains(c)) {
-                                    const2quantifier.insert(c, obj_pair_hashtable<expr, expr>());
-                                }
-                                if (!const2quantifier[c].contains(curr)) {
-                                    const2quantifier[c].insert(curr);
-                                }
-                            }
-                        }
-                    }
-                    else {
-                        stack.push_back(work_item(q->get_expr(), curr.second));
-                    }
-                }
-                else if (is_exists(q)) {
-                    stack.push_back(work_item(q->get_expr(), curr.second));
-                }
-            }
-        }
+    void collect_statistics(statistics & st) const override {
+        st.update("sine widenings", m_num_widenings);
+        m_tactic->collect_statistics(st);
+    }
 
-        // ok, now we just need to find the connected component of the last term
-        obj_hashtable<expr> visited;
-        ptr_vector<expr> to_visit;
-        to_visit.push_back(g->form(g->size() - 1));
-        expr * visiting;
-
-        while (!to_visit.empty()) {
-            visiting = to_visit.back();
-            to_visit.pop_back();
-            visited.insert(visiting);
-            if (!exp2const.contains(visiting))
-                continue;
-            for (func_decl* f : exp2const[visiting]) 
-                for (expr* e : const2exp[f]) {
-                    if (!visited.contains(e))
-                        to_visit.push_back(e);
-                }
-        }
+    void reset_statistics() override {
+        m_num_widenings = 0;
+        m_tactic->reset_statistics();
+    }
 
-        for (unsigned i = 0; i < g->size(); i++) {
-            if (visited.contains(g->form(i)))
-                new_exprs.push_back(g->form(i));
-        }
+    void cleanup() override {
+        m_index.reset();
+        m_tactic->cleanup();
     }
 };
 
 tactic * mk_sine_tactic(ast_manager & m, params_ref const & p) {
     return alloc(sine_tactic, m, p);
 }
+
+tactic * mk_sine_widening_tactic(ast_manager & m, tactic * t, params_ref const & p) {
+    return alloc(sine_widening_tactic, m, t, p);
+}
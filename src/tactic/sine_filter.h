@@ -9,6 +9,16 @@ Abstract:
 
     Tactic that performs Sine Qua Non premise selection
 
+    The formulas connected to the conjecture, the last formula of the
+    goal, through rare symbols are kept. The parameter tolerance bounds
+    how much more frequent than the rarest symbol of a formula a symbol
+    may be to select the formula, depth bounds the number of rounds of
+    selection. Dropping formulas over-approximates the goal.
+
+    mk_sine_widening_tactic runs a tactic on the selected formulas and
+    widens the selection until the tactic decides unsat or all formulas
+    are selected.
+
 Author:
 
     Doug Woos
@@ -24,6 +34,8 @@ class tactic;
 
 tactic * mk_sine_tactic(ast_manager & m, params_ref const & p = params_ref());
 
+tactic * mk_sine_widening_tactic(ast_manager & m, tactic * t, params_ref const & p = params_ref());
+
 /*
     ADD_TACTIC("sine-filter", "eliminate premises using Sine Qua Non", "mk_sine_tactic(m, p)")
 */
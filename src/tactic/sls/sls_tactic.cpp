@@ -94,6 +94,25 @@ static tactic * mk_sls_tactic(ast_manager & m, params_ref const & p) {
                     clean(alloc(sls_tactic, m, p)));
 }
 
+/**
+   \brief race sls.walkers differently seeded copies of the local search.
+   The first walker that finds a model wins, the others are canceled.
+*/
+static tactic * mk_sls_walkers_tactic(ast_manager & m, params_ref const & p) {
+    sls_params sp(p);
+    unsigned n = sp.walkers();
+    if (n <= 1)
+        return mk_sls_tactic(m, p);
+    ptr_vector<tactic> walkers;
+    for (unsigned i = 0; i < n; ++i) {
+        params_ref walker_p = p;
+        walker_p.set_uint("random_seed", sp.random_seed() + i);
+        walkers.push_back(and_then(using_params(mk_sls_tactic(m, walker_p), walker_p), 
+                                   mk_fail_if_undecided_tactic()));
+    }
+    return par(walkers.size(), walkers.c_ptr());
+}
+
 
 static tactic * mk_preamble(ast_manager & m, params_ref const & p) {
     params_ref main_p;
@@ -133,7 +152,7 @@ static tactic * mk_preamble(ast_manager & m, params_ref const & p) {
 }
 
 tactic * mk_qfbv_sls_tactic(ast_manager & m, params_ref const & p) {
-    tactic * t = and_then(mk_preamble(m, p), mk_sls_tactic(m, p));
+    tactic * t = and_then(mk_preamble(m, p), mk_sls_walkers_tactic(m, p));
     t->updt_params(p);
     return t;
 }
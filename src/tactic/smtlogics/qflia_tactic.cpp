@@ -34,6 +34,7 @@ Notes:
 #include "sat/tactic/sat_tactic.h"
 #include "tactic/arith/bound_manager.h"
 #include "tactic/arith/probe_arith.h"
+#include "tactic/arith/presolve_lia_tactic.h"
 
 struct quasi_pb_probe : public probe {
     result operator()(goal const & g) override {
@@ -224,6 +225,7 @@ tactic * mk_qflia_tactic(ast_manager & m, params_ref const & p) {
     tactic * preamble_st = mk_preamble_tactic(m);
 
     tactic * st = using_params(and_then(preamble_st,
+                                        mk_presolve_lia_tactic(m),
                                         or_else(mk_ilp_model_finder_tactic(m),
                                                 mk_pb_tactic(m),
                                                 and_then(fail_if_not(mk_is_quasi_pb_probe()), 
@@ -22,6 +22,8 @@ Notes:
 #include "tactic/arith/nla2bv_tactic.h"
 #include "smt/tactic/smt_tactic.h"
 #include "nlsat/tactic/qfnra_nlsat_tactic.h"
+#include "nlsat/nlsat_params.hpp"
+#include "math/subpaving/tactic/subpaving_tactic.h"
 
 static tactic * mk_qfnra_sat_solver(ast_manager& m, params_ref const& p, unsigned bv_size) {
     params_ref nra2sat_p = p;
@@ -32,24 +34,82 @@ static tactic * mk_qfnra_sat_solver(ast_manager& m, params_ref const& p, unsigne
                     mk_fail_if_undecided_tactic());
 }
 
-tactic * mk_qfnra_tactic(ast_manager & m, params_ref const& p) {
-    params_ref p0 = p;
-    p0.set_bool("inline_vars", true);
-    params_ref p1 = p;    
-    p1.set_uint("seed", 11);
-    p1.set_bool("factor", false);
-    params_ref p2 = p;
-    p2.set_uint("seed", 13);
-    p2.set_bool("factor", false);
-
-    return and_then(mk_simplify_tactic(m, p), 
-                    mk_propagate_values_tactic(m, p),
-                    or_else(try_for(mk_qfnra_nlsat_tactic(m, p0), 5000),
-                            try_for(mk_qfnra_nlsat_tactic(m, p1), 10000),
-                            mk_qfnra_sat_solver(m, p, 4),
-                            and_then(try_for(mk_smt_tactic(m), 5000), mk_fail_if_undecided_tactic()),
-                            mk_qfnra_sat_solver(m, p, 6),
-                            mk_qfnra_nlsat_tactic(m, p2)));
+/**
+   \brief Run n copies of nlsat in parallel. The first uses the degree based
+   variable order, the second the input order, and the others random orders
+   with different seeds. The first copy that decides the goal cancels the others
+   and reports its configuration at verbosity level 1.
+*/
+static tactic * mk_qfnra_nlsat_portfolio(ast_manager & m, params_ref const & p, unsigned n) {
+    ptr_buffer<tactic> ts;
+    for (unsigned i = 0; i < n; i++) {
+        params_ref q = p;
+        char const * msg;
+        if (i == 0) {
+            q.set_bool("inline_vars", true);
+            msg = "(qfnra-nlsat-portfolio :winner degree-order)";
+        }
+        else if (i == 1) {
+            q.set_bool("reorder", false);
+            msg = "(qfnra-nlsat-portfolio :winner input-order)";
+        }
+        else {
+            q.set_bool("shuffle_vars", true);
+            q.set_uint("seed", p.get_uint("seed", 0) + i);
+            msg = "(qfnra-nlsat-portfolio :winner random-order)";
+        }
+        ts.push_back(and_then(mk_qfnra_nlsat_tactic(m, q),
+                              mk_fail_if_undecided_tactic(),
+                              mk_report_verbose_tactic(msg, 1)));
+    }
+    return par(ts.size(), ts.c_ptr());
 }
 
+/**
+   \brief Try to refute the goal using interval subpaving over hardware floats.
+   The bounds are rounded outwards, so an infeasible paving is a proof of unsatisfiability.
+   The tactic fails if the goal is not refuted.
+*/
+static tactic * mk_qfnra_subpaving_presolver(ast_manager & m, params_ref const & p) {
+    params_ref sp = p;
+    sp.set_sym("numeral", symbol("hwf"));
+    sp.set_uint("max_nodes", 1024);
+    return try_for(and_then(mk_subpaving_tactic(m, sp),
+                            mk_fail_if_undecided_tactic()),
+                   1000);
+}
 
+tactic * mk_qfnra_tactic(ast_manager & m, params_ref const& p) {
+    nlsat_params np(p);
+    tactic * st;
+    unsigned n = np.portfolio();
+    if (n > 1) {
+        st = and_then(mk_simplify_tactic(m, p),
+                      mk_propagate_values_tactic(m, p),
+                      or_else(mk_qfnra_nlsat_portfolio(m, p, n),
+                              mk_qfnra_sat_solver(m, p, 4),
+                              mk_qfnra_sat_solver(m, p, 6)));
+    }
+    else {
+        params_ref p0 = p;
+        p0.set_bool("inline_vars", true);
+        params_ref p1 = p;
+        p1.set_uint("seed", 11);
+        p1.set_bool("factor", false);
+        params_ref p2 = p;
+        p2.set_uint("seed", 13);
+        p2.set_bool("factor", false);
+
+        st = and_then(mk_simplify_tactic(m, p),
+                      mk_propagate_values_tactic(m, p),
+                      or_else(try_for(mk_qfnra_nlsat_tactic(m, p0), 5000),
+                              try_for(mk_qfnra_nlsat_tactic(m, p1), 10000),
+                              mk_qfnra_sat_solver(m, p, 4),
+                              and_then(try_for(mk_smt_tactic(m), 5000), mk_fail_if_undecided_tactic()),
+                              mk_qfnra_sat_solver(m, p, 6),
+                              mk_qfnra_nlsat_tactic(m, p2)));
+    }
+    if (np.subpaving_presolve())
+        st = or_else(mk_qfnra_subpaving_presolver(m, p), st);
+    return st;
+}
@@ -116,7 +116,8 @@ private:
     solver* setup_sat() {
         solver * sat = nullptr;
         if (m_use_sat) {
-            if (m_inc_use_sat) {
+            // the lazy mode refines the abstraction on the same solver.
+            if (m_inc_use_sat || !ackermannization_params(m_p).eager()) {
                 sat = mk_inc_sat_solver(m_m, m_p);
             }
             else {
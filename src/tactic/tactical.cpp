@@ -19,10 +19,8 @@ Notes:
 #include "util/scoped_timer.h"
 #include "util/cancel_eh.h"
 #include "util/scoped_ptr_vector.h"
+#include "util/parallel_executor.h"
 #include "tactic/tactical.h"
-#ifndef SINGLE_THREAD
-#include <thread>
-#endif
 #include <vector>
 
 class binary_tactical : public tactic {
@@ -473,14 +471,7 @@ public:
             }
         };
 
-        vector<std::thread> threads(sz);
-
-        for (unsigned i = 0; i < sz; ++i) {
-            threads[i] = std::thread([&, i]() { worker_thread(i); });
-        }
-        for (unsigned i = 0; i < sz; ++i) {
-            threads[i].join();
-        }
+        parallel_executor::run(sz, [&](unsigned i) { worker_thread(i); });
         
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
@@ -686,13 +677,7 @@ public:
             if (m.has_trace_stream())
                 throw default_exception("threads and trace are incompatible");
 
-            vector<std::thread> threads(r1_size);
-            for (unsigned i = 0; i < r1_size; ++i) {
-                threads[i] = std::thread([&, i]() { worker_thread(i); });
-            }
-            for (unsigned i = 0; i < r1_size; ++i) {
-                threads[i].join();
-            }
+            parallel_executor::run(r1_size, [&](unsigned i) { worker_thread(i); });
             
             if (failed) {
                 switch (ex_kind) {
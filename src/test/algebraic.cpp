@@ -383,6 +383,20 @@ static void tst_eval_sign() {
     p = x0*x1 + (x1^2) - x2 + 2;
     tst_eval_sign(p, am, 0, v0, 1, v1, 2, v2, 1);
 
+    // rational values that are not binary rationals
+    scoped_mpq q(qm);
+    p = x0*x1 + x2;
+    qm.set(q, 7, 3);
+    am.set(v2, q);
+    tst_eval_sign(p, am, 0, v0, 1, v1, 2, v2, 1);
+    qm.set(q, 5, 3);
+    am.set(v2, q);
+    tst_eval_sign(p, am, 0, v0, 1, v1, 2, v2, -1);
+    p = x0 - 1000*x2;
+    qm.set(q, -1, 3);
+    am.set(v2, q);
+    tst_eval_sign(p, am, 0, v0, 1, v1, 2, v2, 1);
+
 }
 
 static void tst_isolate_roots(polynomial_ref const & p, anum_manager & am,
@@ -481,6 +495,27 @@ static void tst_isolate_roots() {
     tst_isolate_roots(p, am, 0, v0, 1, v1, 2, v2);
 }
 
+// repeated root isolation of the same polynomial is answered from the root cache
+static void tst_isolate_roots_cache() {
+    reslimit rl;
+    unsynch_mpq_manager        qm;
+    polynomial::manager        pm(rl, qm);
+    algebraic_numbers::manager am(rl, qm);
+    polynomial_ref x(pm);
+    x = pm.mk_polynomial(pm.mk_var());
+    polynomial_ref p(pm);
+    p = ((x^2) - 2)*((x^2) - 3);
+    scoped_anum_vector rs1(am), rs2(am);
+    am.isolate_roots(p, rs1);
+    am.isolate_roots(p, rs2);
+    ENSURE(rs1.size() == 4 && rs1.size() == rs2.size());
+    for (unsigned i = 0; i < rs1.size(); i++) 
+        ENSURE(am.eq(rs1[i], rs2[i]));
+    statistics st;
+    am.collect_statistics(st);
+    st.display(std::cout);
+}
+
 static void pp(polynomial_ref const & p, polynomial::var x) {
     unsigned d = degree(p, x);
     for (unsigned i = 0; i <= d; i++) {
@@ -639,6 +674,7 @@ void tst_algebraic() {
     // enable_trace("mpz_gcd");
     tst_root();
     tst_isolate_roots();
+    tst_isolate_roots_cache();
     ex1();
     tst_eval_sign();
     tst_select_small();
@@ -17,6 +17,8 @@ Revision History:
 
 --*/
 #include "ast/ast.h"
+#include <thread>
+#include <vector>
 
 static void tst1() {
     ast_manager m;
@@ -131,6 +133,68 @@ static void tst5() {
     m.del(arr3);
 }
 
+static void tst_concurrent() {
+    ast_manager m;
+    sort_ref b(m.mk_bool_sort(), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), b.get(), b.get(), b.get()), m);
+    expr_ref a(m.mk_const(symbol("a"), b.get()), m);
+    expr_ref c(m.mk_const(symbol("c"), b.get()), m);
+    unsigned num_asts = m.get_num_asts();
+    unsigned const num_threads = 4;
+    m.set_concurrent(true);
+    std::vector<expr*> results(num_threads, nullptr);
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < num_threads; ++i) {
+        threads.push_back(std::thread([&, i]() {
+            for (unsigned k = 0; k < 10; ++k) {
+                expr_ref t(a, m);
+                for (unsigned j = 0; j < 1000; ++j) 
+                    t = m.mk_app(f.get(), t.get(), (j % 2 == 0) ? a.get() : c.get());
+                if (k == 9) {
+                    m.inc_ref(t);
+                    results[i] = t;
+                }
+            }
+        }));
+    }
+    for (auto & th : threads)
+        th.join();
+    // all threads built the same terms
+    for (unsigned i = 1; i < num_threads; ++i) 
+        ENSURE(results[i] == results[0]);
+    m.set_concurrent(false);
+    ENSURE(m.get_num_asts() == num_asts + 1000);
+    for (expr* r : results)
+        m.dec_ref(r);
+    ENSURE(m.get_num_asts() == num_asts);
+}
+
+static void tst_deletion_batch() {
+    ast_manager m;
+    sort_ref b(m.mk_bool_sort(), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), b.get(), b.get(), b.get()), m);
+    expr_ref a(m.mk_const(symbol("a"), b.get()), m);
+    unsigned num_asts = m.get_num_asts();
+    m.set_deletion_batch(10);
+    expr_ref t(a, m);
+    for (unsigned j = 0; j < 1000; ++j)
+        t = m.mk_app(f.get(), t.get(), a.get());
+    ENSURE(m.get_num_asts() == num_asts + 1000);
+    // releasing the chain only reclaims a batch, the rest stays queued.
+    t = nullptr;
+    ENSURE(m.get_num_queued_deletions() > 0);
+    ENSURE(m.get_num_asts() > num_asts + 900);
+    // queued terms are revived by hash-consing.
+    expr_ref u(m.mk_app(f.get(), a.get(), a.get()), m);
+    ENSURE(m.get_num_asts() > num_asts);
+    while (m.reclaim_deleted(100) > 0)
+        ;
+    ENSURE(m.get_num_asts() == num_asts + 1);
+    u = nullptr;
+    m.set_deletion_batch(0);
+    ENSURE(m.get_num_queued_deletions() == 0);
+    ENSURE(m.get_num_asts() == num_asts);
+}
 
 struct foo {
     unsigned       m_id; 
@@ -153,5 +217,7 @@ void tst_ast() {
     tst3();
     tst4();
     tst5();
+    tst_concurrent();
+    tst_deletion_batch();
 }
 
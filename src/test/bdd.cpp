@@ -73,6 +73,25 @@ namespace dd {
         std::cout << c1 << "\n";
         std::cout << c1.bdd_size() << "\n";
     }
+
+    // many small operations cycle the operation cache without changing the results.
+    static void test5() {
+        bdd_manager m(8);
+        bdd acc = m.mk_false();
+        for (unsigned i = 0; i < 2000; ++i) {
+            bdd c = m.mk_var(i % 8) && m.mk_nvar((i * 3 + 1) % 8);
+            acc = acc || (c && m.mk_var((i * 5 + 2) % 8));
+        }
+        bdd expected = m.mk_false();
+        for (unsigned i = 0; i < 8; ++i) {
+            bdd c = m.mk_var(i % 8) && m.mk_nvar((i * 3 + 1) % 8);
+            expected = expected || (c && m.mk_var((i * 5 + 2) % 8));
+        }
+        VERIFY(acc == expected);
+        statistics st;
+        m.collect_statistics(st);
+        st.display(std::cout);
+    }
 }
 
 void tst_bdd() {
@@ -80,4 +99,5 @@ void tst_bdd() {
     dd::test2();
     dd::test3();
     dd::test4();
+    dd::test5();
 }
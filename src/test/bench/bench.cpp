@@ -0,0 +1,97 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bench.cpp
+
+Abstract:
+
+    Micro-benchmark harness.
+
+--*/
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include "test/bench/bench.h"
+#include "util/z3_version.h"
+
+namespace bench {
+
+    struct sample {
+        double   m_ns;
+        uint64_t m_items;
+    };
+
+    static sample run_once(bench_fn f, uint64_t iterations) {
+        state st(iterations);
+        f(st);
+        return { st.elapsed_ns(), st.items_processed() };
+    }
+
+    void run(config const& cfg, char const* name, bench_fn f, vector<result>& results) {
+        if (cfg.m_filter && !strstr(name, cfg.m_filter))
+            return;
+        double min_ns = cfg.m_min_time * 1e9;
+        uint64_t n = 1;
+        sample s = run_once(f, n);
+        while (s.m_ns < min_ns && n < 1000000000ull) {
+            // aim slightly above the minimal time, grow by at most 100x at a time.
+            double scale = s.m_ns > 0 ? 1.4 * min_ns / s.m_ns : 100.0;
+            scale = std::min(100.0, std::max(2.0, scale));
+            n = static_cast<uint64_t>(n * scale);
+            s = run_once(f, n);
+        }
+        svector<sample> samples;
+        samples.push_back(s);
+        for (unsigned i = 1; i < cfg.m_repetitions; ++i)
+            samples.push_back(run_once(f, n));
+        std::sort(samples.begin(), samples.end(), [](sample const& a, sample const& b) { return a.m_ns < b.m_ns; });
+        sample const& med = samples[samples.size() / 2];
+        result r;
+        r.m_name = name;
+        r.m_iterations = n;
+        r.m_ns_per_iteration = med.m_ns / n;
+        r.m_items_per_second = med.m_ns > 0 ? med.m_items * 1e9 / med.m_ns : 0;
+        results.push_back(r);
+        display(std::cout, vector<result>(1, r));
+    }
+
+    void display(std::ostream& out, vector<result> const& results) {
+        for (result const& r : results) {
+            out << std::left << std::setw(32) << r.m_name << std::right
+                << std::setw(14) << std::fixed << std::setprecision(1) << r.m_ns_per_iteration << " ns"
+                << std::setw(12) << r.m_iterations;
+            if (r.m_items_per_second > 0)
+                out << std::setw(14) << std::setprecision(3) << r.m_items_per_second / 1e6 << " M items/s";
+            out << std::endl;
+        }
+    }
+
+    void display_json(std::ostream& out, config const& cfg, vector<result> const& results) {
+        char date[64];
+        time_t now = time(nullptr);
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+        out << "{\n  \"context\": {\n"
+            << "    \"date\": \"" << date << "\",\n"
+            << "    \"version\": \"" << Z3_FULL_VERSION << "\",\n"
+            << "    \"min_time\": " << cfg.m_min_time << ",\n"
+            << "    \"repetitions\": " << cfg.m_repetitions << "\n"
+            << "  },\n  \"benchmarks\": [";
+        bool first = true;
+        for (result const& r : results) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "    {\"name\": \"" << r.m_name << "\""
+                << ", \"iterations\": " << r.m_iterations
+                << ", \"real_time\": " << std::fixed << std::setprecision(3) << r.m_ns_per_iteration
+                << ", \"time_unit\": \"ns\"";
+            if (r.m_items_per_second > 0)
+                out << ", \"items_per_second\": " << r.m_items_per_second;
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+}
@@ -0,0 +1,92 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bench.h
+
+Abstract:
+
+    Micro-benchmark harness.
+
+    A benchmark is a function that prepares its input and then runs its
+    kernel in a loop controlled by the state:
+
+        void bench_foo(bench::state& st) {
+            ... setup ...
+            while (st.keep_running()) {
+                ... kernel ...
+            }
+        }
+
+    Only the loop is timed. The runner calls the function with an
+    increasing number of iterations until one run takes at least the
+    minimal time, and reports the median over several repetitions.
+    Benchmarks use fixed seeds, so that all runs measure the same work.
+
+--*/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "util/vector.h"
+
+namespace bench {
+
+    class state {
+        typedef std::chrono::steady_clock clock;
+        uint64_t          m_iterations;
+        uint64_t          m_count = 0;
+        uint64_t          m_items = 0;
+        clock::time_point m_start, m_stop;
+    public:
+        state(uint64_t iterations): m_iterations(iterations) {}
+
+        bool keep_running() {
+            if (m_count == 0)
+                m_start = clock::now();
+            if (m_count++ < m_iterations)
+                return true;
+            m_stop = clock::now();
+            return false;
+        }
+
+        uint64_t iterations() const { return m_iterations; }
+
+        /**
+           \brief record the number of items processed by the whole run,
+           reported as a rate.
+        */
+        void set_items_processed(uint64_t n) { m_items = n; }
+        uint64_t items_processed() const { return m_items; }
+
+        double elapsed_ns() const {
+            return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(m_stop - m_start).count());
+        }
+    };
+
+    typedef void (*bench_fn)(state& st);
+
+    struct result {
+        std::string m_name;
+        uint64_t    m_iterations;
+        double      m_ns_per_iteration;
+        double      m_items_per_second;
+    };
+
+    struct config {
+        double      m_min_time = 0.5;
+        unsigned    m_repetitions = 3;
+        char const* m_filter = nullptr;
+    };
+
+    /**
+       \brief run benchmark f unless it is excluded by the filter of cfg.
+    */
+    void run(config const& cfg, char const* name, bench_fn f, vector<result>& results);
+
+    void display(std::ostream& out, vector<result> const& results);
+
+    void display_json(std::ostream& out, config const& cfg, vector<result> const& results);
+}
@@ -0,0 +1,175 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    collections.cpp
+
+Abstract:
+
+    Benchmarks of hash tables, obj_map and heap.
+
+--*/
+#include "test/bench/bench.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+#include "util/hashtable.h"
+#include "util/heap.h"
+#include "util/obj_hashtable.h"
+#include "util/swiss_hashtable.h"
+#include "util/util.h"
+
+typedef int_hashtable<int_hash, default_eq<int> > int_set;
+typedef swiss_hashtable<int_hash_entry<INT_MIN, INT_MIN + 1>, int_hash, default_eq<int> > swiss_int_set;
+
+static const unsigned table_size = 100000;
+
+template<typename Set>
+static void run_insert(bench::state& st) {
+    random_gen r(1);
+    unsigned_vector keys;
+    for (unsigned i = 0; i < table_size; ++i)
+        keys.push_back(r() * 0x8000 + r());
+    while (st.keep_running()) {
+        Set s;
+        for (unsigned k : keys)
+            s.insert(k);
+        VERIFY(s.size() <= table_size);
+    }
+    st.set_items_processed(st.iterations() * table_size);
+}
+
+template<typename Set>
+static void run_find(bench::state& st) {
+    random_gen r(1);
+    Set s;
+    unsigned_vector keys;
+    for (unsigned i = 0; i < table_size; ++i) {
+        unsigned k = r() * 0x8000 + r();
+        keys.push_back(k);
+        if (i % 2 == 0)
+            s.insert(k);
+    }
+    unsigned found = 0;
+    while (st.keep_running()) {
+        for (unsigned k : keys)
+            found += s.contains(k);
+    }
+    VERIFY(found >= st.iterations() * table_size / 2);
+    st.set_items_processed(st.iterations() * table_size);
+}
+
+void bench_hashtable_insert(bench::state& st) { run_insert<int_set>(st); }
+void bench_hashtable_find(bench::state& st) { run_find<int_set>(st); }
+void bench_swiss_hashtable_insert(bench::state& st) { run_insert<swiss_int_set>(st); }
+void bench_swiss_hashtable_find(bench::state& st) { run_find<swiss_int_set>(st); }
+
+static void mk_consts(ast_manager& m, unsigned n, expr_ref_vector& result) {
+    arith_util a(m);
+    for (unsigned i = 0; i < n; ++i)
+        result.push_back(m.mk_const(symbol(i), a.mk_int()));
+}
+
+template<typename Map>
+static void run_obj_map_insert(bench::state& st) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector consts(m);
+    mk_consts(m, table_size, consts);
+    random_gen r(1);
+    shuffle(consts.size(), consts.c_ptr(), r);
+    while (st.keep_running()) {
+        Map map;
+        unsigned i = 0;
+        for (expr* e : consts)
+            map.insert(e, i++);
+        VERIFY(map.size() == table_size);
+    }
+    st.set_items_processed(st.iterations() * table_size);
+}
+
+template<typename Map>
+static void run_obj_map_find(bench::state& st) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector consts(m);
+    mk_consts(m, table_size, consts);
+    Map map;
+    for (unsigned i = 0; i < table_size; i += 2)
+        map.insert(consts.get(i), i);
+    random_gen r(1);
+    shuffle(consts.size(), consts.c_ptr(), r);
+    uint64_t sum = 0;
+    while (st.keep_running()) {
+        unsigned v;
+        for (expr* e : consts)
+            if (map.find(e, v))
+                sum += v;
+    }
+    VERIFY(st.iterations() == 0 || sum > 0);
+    st.set_items_processed(st.iterations() * table_size);
+}
+
+void bench_obj_map_insert(bench::state& st) { run_obj_map_insert<obj_map<expr, unsigned>>(st); }
+void bench_obj_map_find(bench::state& st) { run_obj_map_find<obj_map<expr, unsigned>>(st); }
+void bench_swiss_obj_map_insert(bench::state& st) { run_obj_map_insert<obj_map<expr, unsigned, swiss_hashtable>>(st); }
+void bench_swiss_obj_map_find(bench::state& st) { run_obj_map_find<obj_map<expr, unsigned, swiss_hashtable>>(st); }
+
+struct bench_lt {
+    bool operator()(int v1, int v2) const { return v1 < v2; }
+};
+
+void bench_heap_insert_erase_min(bench::state& st) {
+    random_gen r(1);
+    unsigned_vector vals;
+    for (unsigned i = 0; i < table_size; ++i)
+        vals.push_back(i);
+    shuffle(vals.size(), vals.c_ptr(), r);
+    heap<bench_lt> h(table_size);
+    while (st.keep_running()) {
+        for (unsigned v : vals)
+            h.insert(v);
+        int last = -1;
+        while (!h.empty()) {
+            int v = h.erase_min();
+            VERIFY(last < v);
+            last = v;
+        }
+    }
+    st.set_items_processed(st.iterations() * table_size);
+}
+
+/**
+   Activity based priority queue as used by the SAT solver to select
+   decision variables.
+*/
+struct bench_activity_lt {
+    svector<unsigned> const& m_activity;
+    bench_activity_lt(svector<unsigned> const& a): m_activity(a) {}
+    bool operator()(int v1, int v2) const { return m_activity[v1] > m_activity[v2]; }
+};
+
+template<unsigned D>
+static void run_heap_decreased(bench::state& st) {
+    svector<unsigned> activity(table_size, 0u);
+    heap<bench_activity_lt, D> h(table_size, bench_activity_lt(activity));
+    for (unsigned v = 0; v < table_size; ++v)
+        h.insert(v);
+    random_gen r(1);
+    unsigned_vector bumps;
+    for (unsigned i = 0; i < table_size; ++i)
+        bumps.push_back((r() * 0x8000 + r()) % table_size);
+    unsigned inc = 1;
+    while (st.keep_running()) {
+        for (unsigned v : bumps) {
+            activity[v] += inc;
+            h.decreased(v);
+        }
+        ++inc;
+    }
+    VERIFY(!h.empty());
+    st.set_items_processed(st.iterations() * table_size);
+}
+
+void bench_heap_decreased(bench::state& st) { run_heap_decreased<2>(st); }
+void bench_heap4_decreased(bench::state& st) { run_heap_decreased<4>(st); }
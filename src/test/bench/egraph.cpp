@@ -0,0 +1,53 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    egraph.cpp
+
+Abstract:
+
+    Benchmark of merges and congruence closure in the E-graph.
+
+--*/
+#include "test/bench/bench.h"
+#include "ast/euf/euf_egraph.h"
+#include "ast/reg_decl_plugins.h"
+#include "util/util.h"
+
+void bench_egraph_merge(bench::state& st) {
+    // w chains f_d(...f_1(x_i)) of depth d. Merging the roots x_i makes the
+    // terms of each level congruent.
+    unsigned w = 100, d = 50;
+    ast_manager m;
+    reg_decl_plugins(m);
+    euf::egraph g(m);
+    sort_ref S(m.mk_uninterpreted_sort(symbol("S")), m);
+    func_decl_ref_vector fs(m);
+    for (unsigned j = 0; j < d; ++j)
+        fs.push_back(m.mk_func_decl(symbol(j), S, S));
+    expr_ref_vector pinned(m);
+    euf::enode_vector roots;
+    for (unsigned i = 0; i < w; ++i) {
+        expr_ref x(m.mk_fresh_const("x", S), m);
+        euf::enode* n = g.mk(x, 0, nullptr);
+        roots.push_back(n);
+        pinned.push_back(x);
+        for (unsigned j = 0; j < d; ++j) {
+            x = m.mk_app(fs.get(j), x.get());
+            n = g.mk(x, 1, &n);
+            pinned.push_back(x);
+        }
+    }
+    random_gen r(1);
+    shuffle(roots.size(), roots.c_ptr(), r);
+    while (st.keep_running()) {
+        g.push();
+        for (unsigned i = 1; i < w; ++i)
+            g.merge(roots[i - 1], roots[i], nullptr);
+        g.propagate();
+        VERIFY(!g.inconsistent());
+        g.pop(1);
+    }
+    st.set_items_processed(st.iterations() * w * (d + 1));
+}
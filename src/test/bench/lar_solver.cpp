@@ -0,0 +1,53 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    lar_solver.cpp
+
+Abstract:
+
+    Benchmark of pivoting in the arithmetic solver.
+
+--*/
+#include "test/bench/bench.h"
+#include "math/lp/lar_solver.h"
+#include "util/util.h"
+
+void bench_lar_solver_feasible(bench::state& st) {
+    // random rows over boxed variables. Every iteration asserts the
+    // same bounds on the rows in a new scope and restores feasibility,
+    // which is what the arithmetic theory does during the search.
+    unsigned num_vars = 200, num_terms = 100, row_size = 6, num_bounds = 60;
+    lp::lar_solver s;
+    random_gen r(1);
+    for (unsigned j = 0; j < num_vars; ++j) {
+        lp::var_index v = s.add_var(j, false);
+        s.add_var_bound(v, lp::GE, lp::mpq(-100));
+        s.add_var_bound(v, lp::LE, lp::mpq(100));
+    }
+    unsigned_vector terms;
+    vector<std::pair<lp::mpq, lp::var_index>> coeffs;
+    for (unsigned i = 0; i < num_terms; ++i) {
+        coeffs.reset();
+        for (unsigned k = 0; k < row_size; ++k)
+            coeffs.push_back(std::make_pair(lp::mpq(static_cast<int>(r(9)) - 4), r(num_vars)));
+        terms.push_back(s.add_term(coeffs, num_vars + i));
+    }
+    VERIFY(s.find_feasible_solution() == lp::lp_status::OPTIMAL);
+    svector<std::pair<unsigned, int>> bounds;
+    for (unsigned i = 0; i < num_bounds; ++i)
+        bounds.push_back(std::make_pair(terms[r(num_terms)], static_cast<int>(r(200)) - 100));
+    uint64_t pivots = 0;
+    while (st.keep_running()) {
+        s.push();
+        unsigned i = 0;
+        for (auto const& b : bounds)
+            s.add_var_bound(b.first, (i++ % 2 == 0) ? lp::GE : lp::LE, lp::mpq(b.second));
+        unsigned before = s.settings().stats().m_total_iterations;
+        s.find_feasible_solution();
+        pivots += s.settings().stats().m_total_iterations - before;
+        s.pop(1);
+    }
+    st.set_items_processed(pivots);
+}
@@ -0,0 +1,126 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    main.cpp
+
+Abstract:
+
+    Driver of the micro-benchmarks.
+
+--*/
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "test/bench/bench.h"
+#include "util/memory_manager.h"
+#include "util/util.h"
+
+#define BENCH(NAME) {                                   \
+        void bench_##NAME(bench::state& st);            \
+        if (do_display_usage)                           \
+            std::cout << "    " << #NAME << "\n";       \
+        else                                            \
+            bench::run(cfg, #NAME, bench_##NAME, results); \
+    }
+
+static void error(const char * msg) {
+    std::cerr << "Error: " << msg << "\n";
+    std::cerr << "For usage information: bench /h\n";
+    exit(1);
+}
+
+static void display_usage() {
+    std::cout << "Z3 micro-benchmarks.\n";
+    std::cout << "Usage: bench [options]\n";
+    std::cout << "  /h              prints this message.\n";
+    std::cout << "  /filter:name    only run benchmarks whose name contains <name>.\n";
+    std::cout << "  /min_time:sec   minimal time of a timed run (default 0.5).\n";
+    std::cout << "  /repetitions:n  number of timed runs, the median is reported (default 3).\n";
+    std::cout << "  /json:file      write the results in JSON to <file>.\n";
+    std::cout << "\nBenchmarks:\n";
+}
+
+static void parse_cmd_line_args(int argc, char ** argv, bench::config& cfg, char const*& json_file, bool& do_display_usage) {
+    for (int i = 1; i < argc; ++i) {
+        char * arg = argv[i];
+        if (arg[0] != '-' && arg[0] != '/')
+            error("unexpected argument.");
+        char * opt_name = arg + 1;
+        char * opt_arg  = nullptr;
+        char * colon    = strchr(arg, ':');
+        if (colon) {
+            opt_arg = colon + 1;
+            *colon  = 0;
+        }
+        if (strcmp(opt_name, "h") == 0 || strcmp(opt_name, "?") == 0) {
+            do_display_usage = true;
+        }
+        else if (strcmp(opt_name, "filter") == 0) {
+            if (!opt_arg)
+                error("option argument (/filter:name) is missing.");
+            cfg.m_filter = opt_arg;
+        }
+        else if (strcmp(opt_name, "min_time") == 0) {
+            if (!opt_arg)
+                error("option argument (/min_time:sec) is missing.");
+            cfg.m_min_time = strtod(opt_arg, nullptr);
+        }
+        else if (strcmp(opt_name, "repetitions") == 0) {
+            if (!opt_arg)
+                error("option argument (/repetitions:n) is missing.");
+            cfg.m_repetitions = std::max(1l, strtol(opt_arg, nullptr, 10));
+        }
+        else if (strcmp(opt_name, "json") == 0) {
+            if (!opt_arg)
+                error("option argument (/json:file) is missing.");
+            json_file = opt_arg;
+        }
+        else {
+            error("unknown option.");
+        }
+    }
+}
+
+int main(int argc, char ** argv) {
+    memory::initialize(0);
+    bench::config cfg;
+    char const* json_file = nullptr;
+    bool do_display_usage = false;
+    parse_cmd_line_args(argc, argv, cfg, json_file, do_display_usage);
+    if (do_display_usage)
+        display_usage();
+    vector<bench::result> results;
+    BENCH(hashtable_insert);
+    BENCH(hashtable_find);
+    BENCH(obj_map_insert);
+    BENCH(obj_map_find);
+    BENCH(swiss_hashtable_insert);
+    BENCH(swiss_hashtable_find);
+    BENCH(swiss_obj_map_insert);
+    BENCH(swiss_obj_map_find);
+    BENCH(heap_insert_erase_min);
+    BENCH(heap_decreased);
+    BENCH(heap4_decreased);
+    BENCH(mpz_mul);
+    BENCH(mpz_gcd);
+    BENCH(mpq_add);
+    BENCH(mpq_mul);
+    BENCH(rewriter_arith);
+    BENCH(rewriter_bv);
+    BENCH(sat_propagate);
+    BENCH(egraph_merge);
+    BENCH(lar_solver_feasible);
+    BENCH(smt2_parser);
+    if (json_file) {
+        std::ofstream out(json_file);
+        if (!out)
+            error("could not open the JSON output file.");
+        bench::display_json(out, cfg, results);
+    }
+    memory::finalize();
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    numerals.cpp
+
+Abstract:
+
+    Benchmarks of mpz and mpq arithmetic.
+
+--*/
+#include "test/bench/bench.h"
+#include "util/mpq.h"
+#include "util/util.h"
+
+static const unsigned num_values = 1000;
+
+/**
+   Random numbers of about 64 * digits bits.
+*/
+static void mk_values(unsynch_mpz_manager& m, unsigned digits, random_gen& r, scoped_mpz_vector& result) {
+    scoped_mpz v(m), d(m), base(m);
+    m.set(base, 1);
+    m.mul2k(base, 64);
+    for (unsigned i = 0; i < num_values; ++i) {
+        m.set(v, 0);
+        for (unsigned j = 0; j < digits; ++j) {
+            m.mul(v, base, v);
+            m.set(d, static_cast<uint64_t>(r()) << 48 | static_cast<uint64_t>(r()) << 32 | static_cast<uint64_t>(r()) << 16 | r());
+            m.add(v, d, v);
+        }
+        result.push_back(v);
+    }
+}
+
+void bench_mpz_mul(bench::state& st) {
+    unsynch_mpz_manager m;
+    random_gen r(1);
+    scoped_mpz_vector vals(m);
+    mk_values(m, 4, r, vals);
+    scoped_mpz c(m);
+    while (st.keep_running()) {
+        for (unsigned i = 1; i < num_values; ++i)
+            m.mul(vals[i - 1], vals[i], c);
+    }
+    st.set_items_processed(st.iterations() * (num_values - 1));
+}
+
+void bench_mpz_gcd(bench::state& st) {
+    unsynch_mpz_manager m;
+    random_gen r(1);
+    scoped_mpz_vector vals(m);
+    mk_values(m, 4, r, vals);
+    scoped_mpz c(m);
+    while (st.keep_running()) {
+        for (unsigned i = 1; i < num_values; ++i)
+            m.gcd(vals[i - 1], vals[i], c);
+    }
+    st.set_items_processed(st.iterations() * (num_values - 1));
+}
+
+/**
+   Fractions with small numerators and denominators, as they occur in
+   the simplex tableau.
+*/
+static void mk_fractions(unsynch_mpq_manager& m, random_gen& r, scoped_mpq_vector& result) {
+    scoped_mpq v(m);
+    for (unsigned i = 0; i < num_values; ++i) {
+        m.set(v, r() - 0x4000, r() % 1000 + 1);
+        result.push_back(v);
+    }
+}
+
+void bench_mpq_add(bench::state& st) {
+    unsynch_mpq_manager m;
+    random_gen r(1);
+    scoped_mpq_vector vals(m);
+    mk_fractions(m, r, vals);
+    scoped_mpq c(m);
+    while (st.keep_running()) {
+        for (unsigned i = 1; i < num_values; ++i)
+            m.add(vals[i - 1], vals[i], c);
+    }
+    st.set_items_processed(st.iterations() * (num_values - 1));
+}
+
+void bench_mpq_mul(bench::state& st) {
+    unsynch_mpq_manager m;
+    random_gen r(1);
+    scoped_mpq_vector vals(m);
+    mk_fractions(m, r, vals);
+    scoped_mpq c(m);
+    while (st.keep_running()) {
+        for (unsigned i = 1; i < num_values; ++i)
+            m.mul(vals[i - 1], vals[i], c);
+    }
+    st.set_items_processed(st.iterations() * (num_values - 1));
+}
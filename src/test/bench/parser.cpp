@@ -0,0 +1,58 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    parser.cpp
+
+Abstract:
+
+    Benchmark of the SMT-LIB2 parser.
+
+--*/
+#include <sstream>
+#include "test/bench/bench.h"
+#include "cmd_context/cmd_context.h"
+#include "parsers/smt2/smt2parser.h"
+#include "util/util.h"
+
+static void mk_term(std::ostream& out, random_gen& r, unsigned depth) {
+    if (depth == 0) {
+        if (r(4) == 0)
+            out << r(100);
+        else
+            out << "x" << r(50);
+        return;
+    }
+    static char const* ops[4] = { "+", "-", "*", "ite" };
+    unsigned op = r(4);
+    out << "(" << ops[op] << " ";
+    if (op == 3) {
+        out << "(<= ";
+        mk_term(out, r, depth - 1);
+        out << " 0) ";
+    }
+    mk_term(out, r, depth - 1);
+    out << " ";
+    mk_term(out, r, depth - 1);
+    out << ")";
+}
+
+void bench_smt2_parser(bench::state& st) {
+    std::ostringstream out;
+    random_gen r(1);
+    for (unsigned i = 0; i < 50; ++i)
+        out << "(declare-const x" << i << " Int)\n";
+    for (unsigned i = 0; i < 500; ++i) {
+        out << "(assert (<= ";
+        mk_term(out, r, 5);
+        out << " " << r(1000) << "))\n";
+    }
+    std::string text = out.str();
+    while (st.keep_running()) {
+        cmd_context ctx;
+        std::istringstream in(text);
+        VERIFY(parse_smt2_commands(ctx, in));
+    }
+    st.set_items_processed(st.iterations() * text.size());
+}
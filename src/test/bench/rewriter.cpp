@@ -0,0 +1,100 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    rewriter.cpp
+
+Abstract:
+
+    Benchmarks of the rewriter.
+
+--*/
+#include "test/bench/bench.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/for_each_expr.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "util/util.h"
+
+static const unsigned num_terms = 200;
+static const unsigned term_depth = 6;
+
+static expr_ref mk_arith_term(arith_util& a, expr_ref_vector const& vars, random_gen& r, unsigned depth) {
+    ast_manager& m = vars.get_manager();
+    if (depth == 0) {
+        if (r(4) == 0)
+            return expr_ref(a.mk_int(r(10)), m);
+        return expr_ref(vars.get(r(vars.size())), m);
+    }
+    expr_ref x = mk_arith_term(a, vars, r, depth - 1);
+    expr_ref y = mk_arith_term(a, vars, r, depth - 1);
+    switch (r(4)) {
+    case 0:  return expr_ref(a.mk_add(x, y), m);
+    case 1:  return expr_ref(a.mk_sub(x, y), m);
+    case 2:  return expr_ref(a.mk_mul(a.mk_int(r(5) + 1), x), m);
+    default: return expr_ref(m.mk_ite(a.mk_le(x, y), x, y), m);
+    }
+}
+
+static expr_ref mk_bv_term(bv_util& bv, expr_ref_vector const& vars, random_gen& r, unsigned depth) {
+    ast_manager& m = vars.get_manager();
+    if (depth == 0) {
+        if (r(4) == 0)
+            return expr_ref(bv.mk_numeral(r(256), 32), m);
+        return expr_ref(vars.get(r(vars.size())), m);
+    }
+    expr_ref x = mk_bv_term(bv, vars, r, depth - 1);
+    expr_ref y = mk_bv_term(bv, vars, r, depth - 1);
+    expr* args[2] = { x, y };
+    switch (r(6)) {
+    case 0:  return expr_ref(bv.mk_bv_add(x, y), m);
+    case 1:  return expr_ref(bv.mk_bv_sub(x, y), m);
+    case 2:  return expr_ref(bv.mk_bv_or(2, args), m);
+    case 3:  return expr_ref(bv.mk_bv_xor(2, args), m);
+    case 4:  return expr_ref(bv.mk_bv_mul(bv.mk_numeral(r(8) + 1, 32), x), m);
+    default: return expr_ref(m.mk_ite(bv.mk_ule(x, y), x, y), m);
+    }
+}
+
+static void run_rewriter(bench::state& st, ast_manager& m, expr_ref_vector const& terms) {
+    th_rewriter rw(m);
+    expr_ref result(m);
+    unsigned num_nodes = 0;
+    for (expr* t : terms)
+        num_nodes += get_num_exprs(t);
+    while (st.keep_running()) {
+        // the cache is cleared, so that every iteration rewrites all terms.
+        rw.reset();
+        for (expr* t : terms)
+            rw(t, result);
+    }
+    st.set_items_processed(st.iterations() * num_nodes);
+}
+
+void bench_rewriter_arith(bench::state& st) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    random_gen r(1);
+    expr_ref_vector vars(m), terms(m);
+    for (unsigned i = 0; i < 20; ++i)
+        vars.push_back(m.mk_const(symbol(i), a.mk_int()));
+    for (unsigned i = 0; i < num_terms; ++i)
+        terms.push_back(mk_arith_term(a, vars, r, term_depth));
+    run_rewriter(st, m, terms);
+}
+
+void bench_rewriter_bv(bench::state& st) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    random_gen r(1);
+    expr_ref_vector vars(m), terms(m);
+    for (unsigned i = 0; i < 20; ++i)
+        vars.push_back(m.mk_const(symbol(i), bv.mk_sort(32)));
+    for (unsigned i = 0; i < num_terms; ++i)
+        terms.push_back(mk_bv_term(bv, vars, r, term_depth));
+    run_rewriter(st, m, terms);
+}
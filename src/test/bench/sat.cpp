@@ -0,0 +1,66 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat.cpp
+
+Abstract:
+
+    Benchmark of Boolean constraint propagation in the SAT solver.
+
+--*/
+#include "test/bench/bench.h"
+#include "sat/sat_solver.h"
+#include "util/util.h"
+
+namespace {
+    /**
+       Expose decision levels, which are otherwise managed by the search.
+    */
+    class bench_sat_solver : public sat::solver {
+    public:
+        bench_sat_solver(params_ref const& p, reslimit& l): sat::solver(p, l) {}
+        using sat::solver::push;
+        using sat::solver::pop;
+    };
+}
+
+void bench_sat_propagate(bench::state& st) {
+    // random 3-SAT below the threshold, so that most decisions propagate
+    // for a while before they reach a conflict.
+    unsigned num_vars = 20000, num_clauses = 3 * num_vars, num_decisions = 200;
+    reslimit limit;
+    params_ref p;
+    bench_sat_solver s(p, limit);
+    random_gen r(1);
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    sat::literal lits[3];
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        for (unsigned j = 0; j < 3; ++j)
+            lits[j] = sat::literal((r() * 0x8000 + r()) % num_vars, r(2) == 0);
+        if (lits[0].var() == lits[1].var() || lits[0].var() == lits[2].var() || lits[1].var() == lits[2].var())
+            continue;
+        s.mk_clause(3, lits);
+    }
+    VERIFY(!s.inconsistent());
+    sat::literal_vector decisions;
+    for (unsigned i = 0; i < num_decisions; ++i)
+        decisions.push_back(sat::literal((r() * 0x8000 + r()) % num_vars, r(2) == 0));
+    uint64_t num_assigned = 0;
+    unsigned base = s.trail_size();
+    while (st.keep_running()) {
+        for (sat::literal d : decisions) {
+            if (s.value(d) != l_undef)
+                continue;
+            s.push();
+            s.assign_scoped(d);
+            if (!s.propagate(false))
+                break;
+        }
+        num_assigned += s.trail_size() - base;
+        s.pop(s.scope_lvl());
+    }
+    st.set_items_processed(num_assigned);
+}
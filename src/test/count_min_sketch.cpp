@@ -0,0 +1,57 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    count_min_sketch.cpp
+
+Abstract:
+
+    Test the count-min sketch.
+
+--*/
+#include <iostream>
+#include "util/count_min_sketch.h"
+#include "util/util.h"
+
+static void tst_estimates(unsigned num_keys, unsigned num_ops, unsigned seed) {
+    random_gen r(seed);
+    count_min_sketch s(8);
+    unsigned_vector counts(num_keys, 0u);
+    for (unsigned i = 0; i < num_ops; ++i) {
+        // skewed distribution: low keys are frequent.
+        unsigned k = r(num_keys);
+        if (r(2) == 0)
+            k = k % 8;
+        ++counts[k];
+        ENSURE(s.inc(k) >= counts[k]);
+    }
+    unsigned exact = 0;
+    for (unsigned k = 0; k < num_keys; ++k) {
+        ENSURE(s.estimate(k) >= counts[k]);
+        if (s.estimate(k) == counts[k])
+            ++exact;
+    }
+    // the heavy hitters dominate their counters.
+    for (unsigned k = 0; k < 8; ++k)
+        ENSURE(s.estimate(k) <= counts[k] + num_ops / 64);
+    std::cout << "exact estimates: " << exact << " of " << num_keys << "\n";
+}
+
+static void tst_decay() {
+    count_min_sketch s(4);
+    ENSURE(s.estimate(3) == 0);
+    for (unsigned i = 0; i < 10; ++i)
+        s.inc(3);
+    ENSURE(s.estimate(3) >= 10);
+    s.decay(0.5);
+    ENSURE(s.estimate(3) >= 5);
+    s.reset();
+    ENSURE(s.estimate(3) == 0);
+}
+
+void tst_count_min_sketch() {
+    tst_decay();
+    tst_estimates(100, 1000, 0);
+    tst_estimates(10000, 100000, 1);
+}
@@ -16,6 +16,76 @@ Author:
 Revision History:
 
 --*/
+#include "util/rational.h"
+#include "util/util.h"
+#include "smt/diff_logic.h"
+
+struct batch_dl_ext {
+    typedef rational numeral;
+    typedef int      explanation;
+};
+
+typedef dl_graph<batch_dl_ext> batch_dlg;
+
+struct tst_batch_functor {
+    int_vector m_edges;
+    void operator()(int e) { m_edges.push_back(e); }
+    void new_edge(dl_var, dl_var, unsigned, edge_id const*) {}
+};
+
+static bool is_model(batch_dlg const & g, unsigned num_vars, svector<std::pair<int, int>> const & vars, vector<rational> const & weights, unsigned num_edges) {
+    for (unsigned i = 0; i < num_edges; ++i) 
+        if (g.get_assignment(vars[i].second) - g.get_assignment(vars[i].first) > weights[i])
+            return false;
+    return true;
+}
+
+// Enabling a batch of edges must agree with enabling them one by one.
+static void tst_enable_edges(unsigned seed) {
+    random_gen r(seed);
+    unsigned const num_vars = 30, num_edges = 120;
+    svector<std::pair<int, int>> vars;
+    vector<rational> weights;
+    for (unsigned i = 0; i < num_edges; ++i) {
+        int s = r(num_vars), t = r(num_vars);
+        if (s == t) t = (t + 1) % num_vars;
+        vars.push_back(std::make_pair(s, t));
+        weights.push_back(rational(static_cast<int>(r(20)) - 4));
+    }
+    batch_dlg g1, g2;
+    for (unsigned v = 0; v < num_vars; ++v) {
+        g1.init_var(v);
+        g2.init_var(v);
+    }
+    for (unsigned i = 0; i < num_edges; ++i) {
+        g1.add_edge(vars[i].first, vars[i].second, weights[i], i);
+        g2.add_edge(vars[i].first, vars[i].second, weights[i], i);
+    }
+    unsigned i = 0;
+    while (i < num_edges) {
+        unsigned n = std::min(num_edges - i, 1 + r(15));
+        bool ok1 = true;
+        for (unsigned j = i; ok1 && j < i + n; ++j)
+            ok1 = g1.enable_edge(j);
+        int_vector ids;
+        for (unsigned j = i; j < i + n; ++j)
+            ids.push_back(j);
+        bool ok2 = g2.enable_edges(ids.size(), ids.c_ptr());
+        ENSURE(ok1 == ok2);
+        if (!ok2) {
+            tst_batch_functor f;
+            g2.traverse_neg_cycle2(false, f);
+            rational w(0);
+            for (int e : f.m_edges) 
+                w += weights[e];
+            ENSURE(w.is_neg());
+            break;
+        }
+        i += n;
+        ENSURE(is_model(g2, num_vars, vars, weights, i));
+    }
+}
+
 #ifdef _WINDOWS
 #include "util/rational.h"
 #include "smt/diff_logic.h"
@@ -167,8 +237,12 @@ void tst_diff_logic() {
     //tst1();
     //tst2();
     //tst3();
+    for (unsigned i = 0; i < 100; ++i)
+        tst_enable_edges(i);
 }
 #else
 void tst_diff_logic() {
+    for (unsigned i = 0; i < 100; ++i)
+        tst_enable_edges(i);
 }
 #endif
@@ -19,6 +19,7 @@ Revision History:
 #include<iostream>
 #include "util/util.h"
 #include "util/heap.h"
+#include "util/radix_heap.h"
 #include "util/trace.h"
 #include "util/uint_set.h"
 // include "util/hashtable.h"
@@ -134,6 +135,105 @@ static void tst2() {
     ENSURE(h.check_invariant());
 }
 
+// a 4-ary heap must agree with the binary heap.
+static void tst_4ary() {
+    int_heap2 h2(N);
+    heap<lt_proc2, 4> h4(N);
+    for (int i = 0; i < N * 10; i++) {
+        int cmd = heap_rand() % 10;
+        int val = heap_rand() % N;
+        if (cmd <= 3) {
+            if (!h2.contains(val)) {
+                h2.insert(val);
+                h4.insert(val);
+            }
+        }
+        else if (cmd <= 5) {
+            if (h2.contains(val)) {
+                h2.erase(val);
+                h4.erase(val);
+            }
+        }
+        else if (cmd <= 7) {
+            if (h2.contains(val)) {
+                int old_v = g_value[val];
+                g_value[val] = heap_rand();
+                if (old_v < g_value[val]) {
+                    h2.increased(val);
+                    h4.increased(val);
+                }
+                else {
+                    h2.decreased(val);
+                    h4.decreased(val);
+                }
+            }
+        }
+        else if (!h2.empty()) {
+            ENSURE(g_value[h2.min_value()] == g_value[h4.min_value()]);
+            int v = h4.erase_min();
+            h2.erase(v);
+        }
+        ENSURE(h2.empty() == h4.empty());
+        ENSURE(h2.contains(val) == h4.contains(val));
+    }
+    ENSURE(h4.check_invariant());
+    int_vector le;
+    h4.find_le(0, le);
+    for (int v : le)
+        ENSURE(g_value[v] <= g_value[0]);
+    while (!h4.empty()) {
+        ENSURE(g_value[h2.erase_min()] == g_value[h4.min_value()]);
+        h4.erase_min();
+    }
+    ENSURE(h2.empty());
+}
+
+// Dijkstra-like use of a radix heap, compared with a binary heap.
+static void tst_radix() {
+    radix_heap rh(N);
+    int_heap2 h(N);
+    unsigned last = 0;
+    for (int i = 0; i < N * 10; i++) {
+        int cmd = heap_rand() % 10;
+        int val = heap_rand() % N;
+        if (cmd <= 4) {
+            unsigned key = last + heap_rand() % 1000;
+            if (!rh.contains(val)) {
+                rh.insert(val, key);
+                g_value[val] = key;
+                h.insert(val);
+            }
+            else if (key < rh.get_key(val)) {
+                rh.decreased(val, key);
+                g_value[val] = key;
+                h.decreased(val);
+            }
+        }
+        else if (cmd == 5) {
+            if (rh.contains(val)) {
+                rh.erase(val);
+                h.erase(val);
+            }
+        }
+        else if (!rh.empty()) {
+            ENSURE(rh.min_key() == static_cast<unsigned>(g_value[h.min_value()]));
+            last = rh.min_key();
+            int v = rh.erase_min();
+            ENSURE(static_cast<unsigned>(g_value[v]) == last);
+            h.erase(v);
+        }
+        ENSURE(rh.size() == static_cast<unsigned>(h.end() - h.begin()));
+    }
+    while (!rh.empty()) {
+        ENSURE(rh.min_key() == static_cast<unsigned>(g_value[h.erase_min()]));
+        rh.erase_min();
+    }
+    ENSURE(h.empty());
+    rh.reset();
+    rh.insert(0, 5);
+    ENSURE(rh.erase_min() == 0 && rh.empty());
+}
+
 void tst_heap() {
     // enable_debug("heap");
     enable_trace("heap");
@@ -144,6 +244,9 @@ void tst_heap() {
         tst1();
         init_values();
         tst2();
+        init_values();
+        tst_4ary();
+        tst_radix();
     }
 }
 
@@ -595,8 +595,36 @@ static void test_A_5_5_3() {
     saturate_basis(hb);
 }
 
+// adding inequalities after saturation extends the previous basis.
+static void tst_incremental() {
+    reslimit rl;
+    hilbert_basis hb(rl);
+    hb.add_le(vec(2,1,-1));
+    ENSURE(hb.saturate() == l_true);
+    hb.add_le(vec(1,-3,2));
+    ENSURE(hb.saturate() == l_true);
+    hb.add_ge(vec(1,1,1));
+    ENSURE(hb.saturate() == l_true);
+    unsigned sz = hb.get_basis_size();
+    ENSURE(hb.saturate() == l_true && sz == hb.get_basis_size());
+    rational_vector v, a;
+    rational b;
+    bool is_initial, is_eq;
+    for (unsigned i = 0; i < sz; ++i) {
+        hb.get_basis_solution(i, v, is_initial);
+        for (unsigned j = 0; j < hb.get_num_ineqs(); ++j) {
+            hb.get_ge(j, a, b, is_eq);
+            rational sum(0);
+            for (unsigned k = 0; k < v.size(); ++k)
+                sum += a[k] * v[k];
+            ENSURE(sum >= b);
+        }
+    }
+}
+
 void tst_hilbert_basis() {
     std::cout << "hilbert basis test\n";
+    tst_incremental();
 //    tst3();
 //    return;
 
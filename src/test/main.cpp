@@ -153,9 +153,12 @@ int main(int argc, char ** argv) {
     TST(symbol);
     TST(heap);
     TST(hashtable);
+    TST(swiss_hashtable);
+    TST(count_min_sketch);
     TST(rational);
     TST(inf_rational);
     TST(ast);
+    TST(ast_serialize);
     TST(optional);
     TST(bit_vector);
     TST(fixed_bit_vector);
@@ -186,6 +189,8 @@ int main(int argc, char ** argv) {
     TST(mpq);
     TST(mpf);
     TST(total_order);
+    TST(trail);
+    TST(rlimit);
     TST(dl_table);
     TST(dl_context);
     TST(dl_util);
@@ -252,6 +257,7 @@ int main(int argc, char ** argv) {
     TST(model_evaluator);
     TST(get_consequences);
     TST(pb2bv);
+    TST(sat_aig_store);
     TST_ARGV(sat_lookahead);
     TST_ARGV(sat_local_search);
     TST_ARGV(cnf_backbones);
@@ -259,6 +265,7 @@ int main(int argc, char ** argv) {
     TST(pdd);
     TST(pdd_solver);
     TST(solver_pool);
+    TST(tactic2solver);
     //TST_ARGV(hs);
     TST(finder);
 }
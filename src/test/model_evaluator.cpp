@@ -1,12 +1,73 @@
 #include "model/model.h"
 #include "model/model_evaluator.h"
+#include "model/compiled_evaluator.h"
 #include "model/model_pp.h"
 #include "ast/arith_decl_plugin.h"
+#include "ast/bv_decl_plugin.h"
 #include "ast/reg_decl_plugins.h"
 #include "ast/ast_pp.h"
 
 
+static void tst_compiled_evaluator() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    bv_util bv(m);
+
+    sort_ref s8(bv.mk_sort(8), m), sI(a.mk_int(), m);
+    app_ref x(m.mk_const(symbol("x"), s8), m);
+    app_ref y(m.mk_const(symbol("y"), s8), m);
+    app_ref i(m.mk_const(symbol("i"), sI), m);
+    app_ref p(m.mk_const(symbol("p"), m.mk_bool_sort()), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), sI, sI), m);
+    func_interp* fi = alloc(func_interp, m, 1);
+    fi->set_else(a.mk_add(m.mk_var(0, sI), a.mk_int(3)));
+
+    expr_ref_vector es(m);
+    es.push_back(bv.mk_bv_add(x, y));
+    es.push_back(bv.mk_bv_mul(x, bv.mk_bv_neg(y)));
+    es.push_back(bv.mk_sle(x, y));
+    es.push_back(bv.mk_ule(x, y));
+    es.push_back(bv.mk_concat(x, y));
+    es.push_back(bv.mk_extract(6, 2, x));
+    es.push_back(bv.mk_sign_extend(8, x));
+    es.push_back(bv.mk_bv_shl(x, bv.mk_numeral(rational(3), 8)));
+    es.push_back(m.mk_ite(p, x, y));
+    es.push_back(m.mk_and(p, m.mk_eq(x, y)));
+    es.push_back(a.mk_add(i, m.mk_app(f.get(), i.get())));
+    es.push_back(a.mk_le(a.mk_mul(i, i), a.mk_int(100)));
+    // division and large products are not compiled natively
+    es.push_back(a.mk_idiv(i, a.mk_int(7)));
+    es.push_back(a.mk_mul(a.mk_int(rational(1ll << 40, rational::i64())), a.mk_mul(i, a.mk_int(rational(1ll << 40, rational::i64())))));
+
+    compiled_evaluator ce(m);
+    unsigned_vector regs;
+    for (expr* e : es) regs.push_back(ce.compile(e));
+
+    for (unsigned k = 0; k < 20; ++k) {
+        model mdl(m);
+        mdl.register_decl(x->get_decl(), bv.mk_numeral(rational(37 * k + 5), 8));
+        mdl.register_decl(y->get_decl(), bv.mk_numeral(rational(251 - 13 * k), 8));
+        mdl.register_decl(i->get_decl(), a.mk_int(rational((int)k - 10)));
+        mdl.register_decl(p->get_decl(), k % 2 == 0 ? m.mk_true() : m.mk_false());
+        mdl.register_decl(f, fi->copy());
+        model_evaluator ev(mdl);
+        ce.eval(mdl);
+        for (unsigned j = 0; j < es.size(); ++j) {
+            expr_ref v1 = ev(es.get(j));
+            expr_ref v2 = ce.get_value(regs[j]);
+            if (v1 != v2) {
+                std::cout << mk_pp(es.get(j), m) << "\n" << v1 << " vs " << v2 << "\n";
+            }
+            ENSURE(v1 == v2);
+        }
+    }
+    dealloc(fi);
+}
+
 void tst_model_evaluator() {
+    tst_compiled_evaluator();
+
     ast_manager m;
     reg_decl_plugins(m);
     arith_util a(m);
@@ -503,9 +503,54 @@ static void tst_pw2() {
     }
 }
 
+// carries and borrows that run through the digits of the longer operand
+static void tst_carry() {
+    unsynch_mpz_manager m;
+    scoped_mpz a(m), b(m), c(m), one(m);
+    one = 1;
+    m.power(mpz(2), 256, a);
+    m.sub(a, one, b);
+    m.add(b, one, c);
+    VERIFY(m.eq(a, c));
+    m.add(one, b, c);
+    VERIFY(m.eq(a, c));
+    m.sub(c, one, c);
+    VERIFY(m.eq(b, c));
+    m.sub(one, a, c);
+    m.neg(c);
+    VERIFY(m.eq(b, c));
+}
+
+// gcd of many numbers, when the partial gcd becomes small before the big arguments are seen
+static void tst_gcd_batch() {
+    unsynch_mpz_manager m;
+    scoped_mpz_vector as(m);
+    scoped_mpz a(m), g(m);
+    a = 6;
+    as.push_back(a);
+    a = -9;
+    as.push_back(a);
+    m.power(mpz(2), 200, a);
+    m.mul(a, mpz(3), a);
+    as.push_back(a);
+    m.neg(a);
+    as.push_back(a);
+    a = 0;
+    as.push_back(a);
+    m.gcd(as.size(), as.c_ptr(), g);
+    VERIFY(m.eq(g, mpz(3)));
+    m.power(mpz(2), 200, a);
+    m.add(a, mpz(1), a);
+    as.push_back(a);
+    m.gcd(as.size(), as.c_ptr(), g);
+    VERIFY(m.is_one(g));
+}
+
 void tst_mpz() {
     disable_trace("mpz");
     enable_trace("mpz_2k");
+    tst_carry();
+    tst_gcd_batch();
     tst_pw2();
     tst5();
     tst_div2k_bug();
@@ -53,6 +53,21 @@ public :
         VERIFY(c3 == c3.reduce(c1));
     }
 
+    static void mod2() {
+        pdd_manager m(3, pdd_manager::mod2_e);
+        pdd a = m.mk_var(0);
+        pdd b = m.mk_var(1);
+        pdd c = m.mk_var(2);
+        pdd p = a*b + c + 1;
+        VERIFY((p + p).is_zero());
+        VERIFY((p - p).is_zero());
+        VERIFY(p * p == p);
+        VERIFY(-p == p);
+        VERIFY(m.mk_xor(p, 1) == a*b + c);
+        VERIFY((a + 1) * a == m.zero());
+        VERIFY(m.mk_not(m.mk_not(p)) == p);
+    }
+
     static void reduce() {
         std::cout << "\nreduce\n";
         // a(b^2)cd + abc + bcd + bc + cd + 3 reduce by  bc
@@ -290,6 +305,7 @@ public :
 
 void tst_pdd() {
     dd::test::hello_world();
+    dd::test::mod2();
     dd::test::reduce();
     dd::test::large_product();
     dd::test::canonize();
@@ -4,7 +4,11 @@ Copyright (c) 2015 Microsoft Corporation
 
 --*/
 
+#include <sstream>
 #include "ast/proofs/proof_checker.h"
+#include "ast/proofs/proof_stream.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
 #include "ast/ast_ll_pp.h"
 
 void tst_checker1() {
@@ -28,6 +32,58 @@ void tst_checker1() {
     VERIFY(checker.check(p4.get(), side_conditions));
 }
 
+static void tst_stream() {
+    std::stringstream strm;
+    {
+        ast_manager m(PGM_ENABLED);
+        reg_decl_plugins(m);
+        arith_util a(m);
+        proof_stream_writer writer(m, strm);
+        expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+        expr_ref f(a.mk_gt(a.mk_add(x, a.mk_int(1)), a.mk_int(2)), m);
+        proof_ref p1(m), p2(m), p3(m), p4(m);
+        // a step that is deleted and recreated is written again.
+        p1 = m.mk_asserted(f);
+        p1 = nullptr;
+        p1 = m.mk_asserted(f);
+        p2 = m.mk_hypothesis(m.mk_not(f));
+        proof* proofs[2] = { p1.get(), p2.get() };
+        p3 = m.mk_unit_resolution(2, proofs);
+        p4 = m.mk_lemma(p3, f);
+        proofs[1] = m.mk_asserted(m.mk_not(f));
+        p3 = m.mk_unit_resolution(2, proofs);
+        writer.write_root(p3);
+    }
+    ast_manager m(PGM_ENABLED);
+    reg_decl_plugins(m);
+    proof_stream_checker checker(m);
+    expr_ref_vector side_conditions(m);
+    VERIFY(checker.check(strm, side_conditions));
+    ENSURE(checker.num_steps() == 7);
+    ENSURE(checker.is_refutation());
+}
+
+static void tst_parallel() {
+    ast_manager m(PGM_ENABLED);
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref_vector xs(m);
+    for (unsigned i = 0; i <= 300; ++i)
+        xs.push_back(m.mk_const(symbol(i), a.mk_int()));
+    proof_ref p(m.mk_asserted(m.mk_eq(xs.get(0), xs.get(1))), m);
+    for (unsigned i = 1; i < 300; ++i)
+        p = m.mk_transitivity(p, m.mk_asserted(m.mk_eq(xs.get(i), xs.get(i + 1))));
+    proof_checker checker(m);
+    expr_ref_vector side_conditions(m);
+    VERIFY(checker.check_parallel(p, side_conditions, 4));
+    // checked subproofs are not checked again.
+    proof_ref p2(m.mk_symmetry(p), m);
+    VERIFY(checker.check_parallel(p2, side_conditions, 4));
+    VERIFY(checker.check(p2, side_conditions));
+}
+
 void tst_proof_checker() {
     tst_checker1();    
+    tst_stream();
+    tst_parallel();
 }
@@ -453,6 +453,22 @@ static void tst11(bool use_ints) {
     std::cout << "\n";
 }
 
+static void tst_addmul() {
+    rational big("10000000000000000000000000000007");
+    rational vals[] = { rational(0), rational(1), rational(-1), rational(3), rational(-7),
+                        rational(INT_MAX), rational(INT_MIN), rational(1, 3), big };
+    for (rational const& a : vals)
+        for (rational const& b : vals)
+            for (rational const& c : vals) {
+                rational r(a);
+                r.addmul(b, c);
+                ENSURE(r == a + b * c);
+                r = a;
+                r.submul(b, c);
+                ENSURE(r == a - b * c);
+            }
+}
+
 
 void tst_rational() {
     TRACE("rational", tout << "starting rational test...\n";);
@@ -461,6 +477,7 @@ void tst_rational() {
     r1.hash();
     tst1();
     tst2();
+    tst_addmul();
     tst3();
     tst4();
     tst5();
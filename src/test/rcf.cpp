@@ -69,6 +69,37 @@ static void tst1() {
     std::cout << interval_pp((a + eps)/(a - eps)) << std::endl;
 }
 
+static void tst_sign_cache() {
+    unsynch_mpq_manager qm;
+    reslimit rl;
+    rcmanager m(rl, qm);
+    scoped_rcnumeral eps(m);
+    m.mk_infinitesimal(eps);
+    // roots of x^2 - eps
+    scoped_rcnumeral_vector as(m), roots(m);
+    scoped_rcnumeral c(m);
+    c = eps * -1;
+    as.push_back(c);
+    c = 0;
+    as.push_back(c);
+    c = 1;
+    as.push_back(c);
+    m.isolate_roots(as.size(), as.c_ptr(), roots);
+    ENSURE(roots.size() == 2);
+    scoped_rcnumeral r0(m), r1(m);
+    m.set(r0, roots[0]);
+    m.set(r1, roots[1]);
+    // repeated sign determinations of structurally equal values
+    for (unsigned i = 0; i < 3; i++) {
+        c = r1*r1 - eps;
+        ENSURE(m.is_zero(c));
+        c = r1 - eps;
+        ENSURE(m.sign(c) > 0);
+        c = r0 + eps;
+        ENSURE(m.sign(c) < 0);
+    }
+}
+
 static void tst2() {
     enable_trace("mpz_matrix");
     unsynch_mpq_manager nm;
@@ -167,6 +198,7 @@ void tst_rcf() {
     enable_trace("rcf_clean_bug");
     tst_denominators();
     tst1();
+    tst_sign_cache();
     tst2();
     { int A[] = {0, 1, 1, 1, 0, 1, 1, 1, -1}; int c[] = {10, 4, -4}; int b[] = {-2, 4, 6}; tst_solve(3, A, b, c, true); }
     { int A[] = {1, 1, 1, 0, 1, 1, 0, 1, 1}; int c[] = {3, 2, 2}; int b[] = {1, 1, 1}; tst_solve(3, A, b, c, false); }
@@ -0,0 +1,53 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    rlimit.cpp
+
+Abstract:
+
+    Test local step budgets of resource limits.
+
+--*/
+#include "util/rlimit.h"
+#include "util/debug.h"
+
+// a budget hits a resource limit at the same step as reslimit::inc.
+static void tst_budget_limit(unsigned limit, unsigned chunk) {
+    reslimit r1, r2;
+    unsigned n1 = 0, n2 = 0;
+    scoped_rlimit _s1(r1, limit), _s2(r2, limit);
+    while (r1.inc())
+        ++n1;
+    {
+        rlimit_budget b(r2, chunk);
+        while (b.inc())
+            ++n2;
+    }
+    ENSURE(n1 == n2);
+    ENSURE(r1.count() == r2.count());
+}
+
+// a cancellation is noticed within a chunk.
+static void tst_budget_cancel() {
+    reslimit r;
+    rlimit_budget b(r, 16);
+    unsigned n = 0;
+    while (b.inc() && n < 100) {
+        if (++n == 10)
+            r.cancel();
+    }
+    ENSURE(n <= 10 + 16);
+    b.flush();
+    ENSURE(r.count() >= n);
+}
+
+void tst_rlimit() {
+    tst_budget_limit(1, 4);
+    tst_budget_limit(100, 1);
+    tst_budget_limit(100, 7);
+    tst_budget_limit(1000, 1024);
+    tst_budget_limit(5000, 1024);
+    tst_budget_cancel();
+}
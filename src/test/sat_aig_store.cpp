@@ -0,0 +1,145 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    sat_aig_store.cpp
+
+Abstract:
+
+    Test the and-inverter graph store and the qfbv-aig tactic.
+
+--*/
+#include "ast/reg_decl_plugins.h"
+#include "ast/bv_decl_plugin.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "tactic/tactic.h"
+#include "tactic/goal.h"
+#include "sat/sat_aig_store.h"
+#include "sat/sat_solver.h"
+#include "sat/tactic/aig_sat_tactic.h"
+#include "util/rlimit.h"
+
+typedef sat::aig_store::lit aig_lit;
+
+static void tst_hashing() {
+    sat::aig_store aig;
+    aig_lit a = aig.mk_input(), b = aig.mk_input(), c = aig.mk_input();
+    aig_lit ab = aig.mk_and(a, b);
+    aig_lit nac = aig.mk_and(sat::aig_store::mk_not(a), c);
+    unsigned num_nodes = aig.num_nodes();
+    ENSURE(aig.mk_and(b, a) == ab);
+    ENSURE(aig.mk_and(a, sat::aig_store::mk_not(a)) == sat::aig_store::false_lit);
+    ENSURE(aig.mk_and(a, sat::aig_store::true_lit) == a);
+    ENSURE(aig.mk_and(ab, a) == ab);
+    ENSURE(aig.mk_and(ab, sat::aig_store::mk_not(b)) == sat::aig_store::false_lit);
+    ENSURE(aig.mk_and(ab, nac) == sat::aig_store::false_lit);
+    ENSURE(aig.num_nodes() == num_nodes);
+    aig_lit x = aig.mk_xor(a, b);
+    ENSURE(aig.mk_xor(sat::aig_store::mk_not(a), b) == sat::aig_store::mk_not(x));
+    ENSURE(aig.mk_iff(b, a) == sat::aig_store::mk_not(x));
+    ENSURE(aig.mk_ite(c, a, a) == a);
+}
+
+static void tst_cnf() {
+    reslimit rl;
+    params_ref p;
+    sat::aig_store aig;
+    aig_lit a = aig.mk_input(), b = aig.mk_input();
+    aig_lit x = aig.mk_xor(a, b);
+    {
+        sat::solver s(p, rl);
+        sat::literal lits[3] = { aig.to_sat(x, s), aig.to_sat(a, s), aig.to_sat(b, s) };
+        for (sat::literal l : lits)
+            s.add_clause(1, &l, sat::status::input());
+        ENSURE(s.check() == l_false);
+    }
+    aig.reset();
+    a = aig.mk_input();
+    b = aig.mk_input();
+    x = aig.mk_xor(a, b);
+    sat::solver s(p, rl);
+    sat::literal l = aig.to_sat(x, s);
+    s.add_clause(1, &l, sat::status::input());
+    ENSURE(s.check() == l_true);
+    ENSURE(aig.value(a, s.get_model()) != aig.value(b, s.get_model()));
+    ENSURE(aig.value(x, s.get_model()));
+}
+
+static lbool check(ast_manager & m, expr_ref_vector const & fmls, model_ref & mdl) {
+    goal_ref g = alloc(goal, m);
+    for (expr * f : fmls)
+        g->assert_expr(f);
+    tactic_ref t = mk_aig_sat_tactic(m);
+    goal_ref_buffer result;
+    (*t)(g, result);
+    ENSURE(result.size() == 1);
+    if (result[0]->inconsistent())
+        return l_false;
+    ENSURE(result[0]->size() == 0);
+    mdl = alloc(model, m);
+    (*result[0]->mc())(mdl);
+    return l_true;
+}
+
+// the circuits agree with the rewriter on numerals.
+static void tst_circuits() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    th_rewriter rw(m);
+    random_gen r(0);
+    unsigned const sz = 6;
+    expr_ref x(m.mk_const(symbol("x"), bv.mk_sort(sz)), m);
+    expr_ref y(m.mk_const(symbol("y"), bv.mk_sort(sz)), m);
+    decl_kind kinds[] = { OP_BADD, OP_BSUB, OP_BMUL, OP_BUDIV_I, OP_BUREM_I, OP_BSHL, OP_BLSHR, OP_BASHR,
+                          OP_BAND, OP_BXNOR, OP_ULT, OP_ULEQ, OP_SLT, OP_SGEQ };
+    for (unsigned i = 0; i < 40; ++i) {
+        expr_ref a(bv.mk_numeral(rational(r(1 << sz)), sz), m);
+        expr_ref b(bv.mk_numeral(rational(i % 5 == 0 ? 0 : r(1 << sz)), sz), m);
+        for (decl_kind k : kinds) {
+            expr_ref t(m.mk_app(bv.get_fid(), k, x, y), m);
+            expr_ref val(m.mk_app(bv.get_fid(), k, a, b), m);
+            rw(val);
+            expr_ref_vector fmls(m);
+            fmls.push_back(m.mk_eq(x, a));
+            fmls.push_back(m.mk_eq(y, b));
+            fmls.push_back(m.mk_not(m.mk_eq(t, val)));
+            model_ref mdl;
+            ENSURE(check(m, fmls, mdl) == l_false);
+        }
+    }
+}
+
+static void tst_tactic() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    bv_util bv(m);
+    unsigned const sz = 8;
+    expr_ref x(m.mk_const(symbol("x"), bv.mk_sort(sz)), m);
+    expr_ref y(m.mk_const(symbol("y"), bv.mk_sort(sz)), m);
+    expr_ref one(bv.mk_numeral(rational(1), sz), m);
+    expr_ref_vector fmls(m);
+    model_ref mdl;
+
+    // factor 143 = 11 * 13
+    fmls.push_back(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_numeral(rational(143), sz)));
+    fmls.push_back(m.mk_not(bv.mk_ule(x, one)));
+    fmls.push_back(m.mk_not(bv.mk_ule(y, one)));
+    fmls.push_back(m.mk_not(bv.mk_ule(y, x)));
+    ENSURE(check(m, fmls, mdl) == l_true);
+    for (expr * f : fmls)
+        ENSURE(mdl->is_true(f));
+
+    // multiplication commutes
+    fmls.reset();
+    fmls.push_back(m.mk_not(m.mk_eq(bv.mk_bv_mul(x, y), bv.mk_bv_mul(y, x))));
+    ENSURE(check(m, fmls, mdl) == l_false);
+}
+
+void tst_sat_aig_store() {
+    tst_hashing();
+    tst_cnf();
+    tst_circuits();
+    tst_tactic();
+}
@@ -131,6 +131,64 @@ static void test4() {
     feas(S);
 }
 
+static void mk_random_row(unsynch_mpz_manager& m, sparse_matrix& M, sparse_matrix::row r, random_gen& rand, unsigned num_vars) {
+    scoped_mpz c(m);
+    for (unsigned v = 0; v < num_vars; ++v) {
+        if (rand(2) == 0) {
+            m.set(c, static_cast<int>(rand(7)) - 3);
+            if (!m.is_zero(c))
+                M.add_var(r, c, v);
+        }
+    }
+}
+
+static void row2vector(sparse_matrix& M, sparse_matrix::row r, unsigned num_vars, vector<R>& result) {
+    result.reset();
+    result.resize(num_vars);
+    auto it = M.row_begin(r), end = M.row_end(r);
+    for (; it != end; ++it)
+        result[it->m_var] = R(it->m_coeff);
+}
+
+// pivot_row computes the same rows as mul followed by add.
+static void test_pivot_row() {
+    unsynch_mpz_manager m;
+    sparse_matrix M1(m), M2(m);
+    random_gen rand(0);
+    unsigned num_vars = 12, num_rows = 10;
+    for (unsigned v = 0; v < num_vars; ++v) {
+        M1.ensure_var(v);
+        M2.ensure_var(v);
+    }
+    for (unsigned i = 0; i < num_rows; ++i) {
+        random_gen r1(i), r2(i);
+        mk_random_row(m, M1, M1.mk_row(), r1, num_vars);
+        mk_random_row(m, M2, M2.mk_row(), r2, num_vars);
+    }
+    scoped_mpz a(m), n(m);
+    vector<R> v1, v2;
+    for (unsigned k = 0; k < 20; ++k) {
+        sparse_matrix::row src(rand(num_rows));
+        m.set(a, static_cast<int>(rand(5)) + 1);
+        M2.begin_pivot(src);
+        for (unsigned i = 0; i < num_rows; ++i) {
+            if (i == src.id())
+                continue;
+            m.set(n, static_cast<int>(rand(7)) - 3);
+            M1.mul(sparse_matrix::row(i), a);
+            M1.add(sparse_matrix::row(i), n, src);
+            M2.pivot_row(sparse_matrix::row(i), a, n);
+        }
+        M2.end_pivot();
+        for (unsigned i = 0; i < num_rows; ++i) {
+            row2vector(M1, sparse_matrix::row(i), num_vars, v1);
+            row2vector(M2, sparse_matrix::row(i), num_vars, v2);
+            ENSURE(v1 == v2);
+        }
+        ENSURE(M2.well_formed());
+    }
+}
+
 void tst_simplex() {
     reslimit rl; Simplex S(rl);
 
@@ -166,4 +224,5 @@ void tst_simplex() {
     test2();
     test3();
     test4();
+    test_pivot_row();
 }
@@ -8,8 +8,33 @@ Copyright (c) 2015 Microsoft Corporation
 #include "util/util.h"
 #include "util/trace.h"
 #include "util/small_object_allocator.h"
+#include "util/vector.h"
+
+static void tst_slab_mode() {
+    small_object_allocator soa("slab", true);
+    ENSURE(soa.slab_mode());
+    ptr_vector<char> objs;
+    for (unsigned i = 0; i < 10000; ++i)
+        objs.push_back(new (soa) char[24]);
+    // keep every 100th object alive
+    for (unsigned i = 0; i < objs.size(); ++i)
+        if (i % 100 != 0)
+            soa.deallocate(24, objs[i]);
+    size_t released = soa.release_empty_slabs();
+    ENSURE(released == 0);
+    for (unsigned i = 0; i < objs.size(); i += 100)
+        soa.deallocate(24, objs[i]);
+    ENSURE(soa.get_allocation_size() == 0);
+    released = soa.release_empty_slabs();
+    TRACE("small_object_allocator", tout << "released: " << released << "\n";);
+    ENSURE(soa.get_num_free_objs() == 0);
+    for (unsigned i = 0; i < 100; ++i) 
+        soa.deallocate(24, new (soa) char[24]);
+}
 
 void tst_small_object_allocator() {
+    tst_slab_mode();
+
     small_object_allocator soa;
 
     char * p1 = new (soa) char[13];
@@ -6,6 +6,7 @@ Copyright (c) 2015 Microsoft Corporation
 
 #include "smt/smt_context.h"
 #include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
 
 void tst_smt_context()
 {
@@ -32,4 +33,31 @@ void tst_smt_context()
     }
 
     ctx.check();
+
+    // partial models agree with the model they are completed to.
+    {
+        arith_util a(m);
+        smt::context ctx2(m, params);
+        sort_ref int_s(a.mk_int(), m);
+        app_ref x(m.mk_const(symbol("x"), int_s), m);
+        app_ref y(m.mk_const(symbol("y"), int_s), m);
+        app_ref z(m.mk_const(symbol("z"), int_s), m);
+        ctx2.assert_expr(a.mk_lt(x, y));
+        ctx2.assert_expr(a.mk_lt(y, z));
+        ctx2.assert_expr(m.mk_or(a1, b1));
+        ENSURE(ctx2.check() == l_true);
+        expr_ref_vector consts(m);
+        consts.push_back(x);
+        consts.push_back(a1);
+        model_ref pmdl, mdl;
+        ctx2.get_model(consts, pmdl);
+        ENSURE(pmdl);
+        ENSURE(pmdl->get_const_interp(x->get_decl()));
+        ENSURE(!pmdl->get_const_interp(z->get_decl()));
+        ctx2.get_model(mdl);
+        ENSURE(mdl);
+        ENSURE(mdl->get_const_interp(x->get_decl()) == pmdl->get_const_interp(x->get_decl()));
+        ENSURE(mdl->get_const_interp(z->get_decl()));
+        ENSURE(mdl->is_true(a.mk_lt(x, z)));
+    }
 }
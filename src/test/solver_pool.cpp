@@ -38,4 +38,19 @@ void tst_solver_pool() {
     std::cout << *s1;
     std::cout << *s2;
     std::cout << *base;
+
+    // resetting s1 retires its activation literal in the shared base solver
+    // and leaves the assertions of s4, which shares the base solver with s1.
+    fml = m.mk_not(b);
+    s4->assert_expr(fml);
+    ENSURE(s4->check_sat(asms) == l_false);
+    pool.reset_solver(s1.get());
+    ENSURE(s1->check_sat(asms) == l_true);
+    ENSURE(s4->check_sat(asms) == l_false);
+    fml = m.mk_not(c);
+    s1->assert_expr(fml);
+    ENSURE(s1->check_sat(asms) == l_true);
+    statistics st;
+    pool.collect_statistics(st);
+    st.display(std::cout);
 }
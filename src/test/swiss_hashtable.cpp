@@ -0,0 +1,117 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    swiss_hashtable.cpp
+
+Abstract:
+
+    Test the hash table with control bytes.
+
+--*/
+#include <iostream>
+#include <unordered_set>
+#include "util/swiss_hashtable.h"
+#include "util/obj_hashtable.h"
+#include "util/util.h"
+
+struct swiss_int_hash { unsigned operator()(int x) const { return x; } };
+// many collisions in h2 and in the group index.
+struct swiss_bad_hash { unsigned operator()(int x) const { return x % 7; } };
+
+template<typename HashProc>
+static void tst_random(unsigned num_ops, int range, unsigned seed) {
+    typedef swiss_table<int, HashProc, default_eq<int>> int_set;
+    random_gen r(seed);
+    int_set h;
+    std::unordered_set<int> ref;
+    for (unsigned i = 0; i < num_ops; ++i) {
+        int v = r(range);
+        if (r(3) == 0) {
+            h.erase(v);
+            ref.erase(v);
+            ENSURE(!h.contains(v));
+        }
+        else {
+            h.insert(v);
+            ref.insert(v);
+            ENSURE(h.contains(v));
+        }
+        ENSURE(h.size() == ref.size());
+    }
+    DEBUG_CODE(h.check_invariant(););
+    for (int v : ref)
+        ENSURE(h.contains(v));
+    unsigned n = 0;
+    for (int v : h) {
+        ENSURE(ref.count(v) == 1);
+        ++n;
+    }
+    ENSURE(n == ref.size());
+    int_set copy(h);
+    ENSURE(copy.size() == h.size());
+    for (int v : ref)
+        ENSURE(copy.contains(v));
+    h.reset();
+    ENSURE(h.empty());
+    for (int v : ref)
+        ENSURE(!h.contains(v));
+    ENSURE(copy.size() == ref.size());
+}
+
+static void tst_small() {
+    swiss_table<int, swiss_int_hash, default_eq<int>> h(2);
+    for (int i = 0; i < 100; ++i) {
+        h.insert(i);
+        h.erase(i);
+        ENSURE(h.empty());
+    }
+    // fill and drain a table of a single group, so that deleted slots are needed.
+    for (int i = 0; i < 14; ++i)
+        h.insert(i);
+    for (int i = 0; i < 14; i += 2)
+        h.erase(i);
+    for (int i = 0; i < 14; ++i)
+        ENSURE(h.contains(i) == (i % 2 == 1));
+    DEBUG_CODE(h.check_invariant(););
+}
+
+struct swiss_obj {
+    unsigned m_id;
+    unsigned hash() const { return m_id; }
+};
+
+static void tst_obj_map() {
+    obj_map<swiss_obj, unsigned, swiss_hashtable> m;
+    vector<swiss_obj> objs;
+    for (unsigned i = 0; i < 1000; ++i)
+        objs.push_back({ i });
+    for (unsigned i = 0; i < 1000; ++i)
+        m.insert(&objs[i], 2 * i);
+    for (unsigned i = 0; i < 1000; i += 3)
+        m.remove(&objs[i]);
+    for (unsigned i = 0; i < 1000; ++i) {
+        unsigned v;
+        ENSURE(m.find(&objs[i], v) == (i % 3 != 0));
+        ENSURE(i % 3 == 0 || v == 2 * i);
+    }
+    m.insert_if_not_there(&objs[0], 7) += 1;
+    ENSURE(m[&objs[0]] == 8);
+    unsigned n = 0;
+    for (auto const& kv : m) {
+        ENSURE(kv.m_key->m_id % 3 != 0 || kv.m_key->m_id == 0);
+        ++n;
+    }
+    ENSURE(n == m.size());
+}
+
+void tst_swiss_hashtable() {
+    tst_small();
+    for (unsigned i = 0; i < 20; ++i) {
+        tst_random<swiss_int_hash>(5000, 1000, i);
+        tst_random<swiss_int_hash>(20000, 100000, i);
+        tst_random<swiss_bad_hash>(2000, 300, i);
+    }
+    tst_obj_map();
+}
@@ -19,6 +19,9 @@ Revision History:
 #include<iostream>
 #include "util/symbol.h"
 #include "util/debug.h"
+#include "util/string_buffer.h"
+#include <thread>
+#include <vector>
 
 static void tst1() {
     symbol s1("foo");
@@ -51,8 +54,38 @@ static void tst1() {
     ENSURE(lt(symbol("zzz"), symbol("zzzb")));
 }
 
+// threads interning the same names must obtain the same symbols.
+static void tst_threads() {
+    unsigned const num_threads = 4, num_names = 5000;
+    std::vector<std::vector<symbol>> results(num_threads);
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < num_threads; ++i) {
+        threads.push_back(std::thread([&, i]() {
+            for (unsigned k = 0; k < 3; ++k) {
+                results[i].clear();
+                for (unsigned j = 0; j < num_names; ++j) {
+                    string_buffer<> buffer;
+                    buffer << "name!" << ((j * 7 + i) % num_names);
+                    results[i].push_back(symbol(buffer.c_str()));
+                }
+            }
+        }));
+    }
+    for (auto & th : threads)
+        th.join();
+    for (unsigned i = 0; i < num_threads; ++i) {
+        for (unsigned j = 0; j < num_names; ++j) {
+            string_buffer<> buffer;
+            buffer << "name!" << ((j * 7 + i) % num_names);
+            ENSURE(results[i][j] == symbol(buffer.c_str()));
+            ENSURE(results[i][j].str() == buffer.c_str());
+        }
+    }
+}
+
 void tst_symbol() {
     tst1();
+    tst_threads();
 }
 
 
@@ -0,0 +1,79 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    tactic2solver.cpp
+
+Abstract:
+
+    Test reuse of results in solvers based on tactics.
+
+--*/
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "smt/tactic/smt_tactic.h"
+#include "solver/tactic2solver.h"
+#include "solver/solver.h"
+
+static unsigned num_reused(solver& s) {
+    statistics st;
+    s.collect_statistics(st);
+    return st.get_uint_value("solver reused results");
+}
+
+void tst_tactic2solver() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    expr_ref zero(a.mk_int(0), m);
+
+    // results are not reused by default.
+    {
+        ref<solver> s = mk_tactic2solver(m, mk_smt_tactic(m));
+        s->assert_expr(a.mk_gt(x, zero));
+        ENSURE(s->check_sat() == l_true);
+        ENSURE(s->check_sat() == l_true);
+        ENSURE(num_reused(*s) == 0);
+    }
+
+    params_ref p;
+    p.set_bool("reuse_results", true);
+    ref<solver> s = mk_tactic2solver(m, mk_smt_tactic(m), p);
+    s->assert_expr(a.mk_gt(x, zero));
+    ENSURE(s->check_sat() == l_true);
+    ENSURE(num_reused(*s) == 0);
+
+    // the model of the last check satisfies the new assertion.
+    s->assert_expr(a.mk_gt(x, a.mk_int(-5)));
+    ENSURE(s->check_sat() == l_true);
+    ENSURE(num_reused(*s) == 1);
+
+    // the model does not satisfy x < 0, the tactic has to run again.
+    s->push();
+    s->assert_expr(a.mk_lt(x, zero));
+    ENSURE(s->check_sat() == l_false);
+    ENSURE(num_reused(*s) == 1);
+
+    // adding assertions keeps the assertions unsatisfiable.
+    s->assert_expr(a.mk_gt(y, zero));
+    ENSURE(s->check_sat() == l_false);
+    ENSURE(num_reused(*s) == 2);
+
+    // pop drops the unsat result, the last model still satisfies the assertions.
+    s->pop(1);
+    ENSURE(s->check_sat() == l_true);
+    ENSURE(num_reused(*s) == 3);
+    model_ref mdl;
+    s->get_model(mdl);
+    expr_ref fml(a.mk_gt(x, zero), m);
+    ENSURE(mdl && mdl->is_true(fml));
+
+    // assumptions are checked against the model.
+    expr_ref_vector asms(m);
+    asms.push_back(a.mk_lt(x, zero));
+    ENSURE(s->check_sat(asms) == l_false);
+    ENSURE(num_reused(*s) == 3);
+}
@@ -0,0 +1,48 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    trail.cpp
+
+Abstract:
+
+    Test trail stacks mixing compact value records and trail objects.
+
+--*/
+#include "util/trail.h"
+#include "util/debug.h"
+
+struct trail_test_ctx {};
+
+static void tst_mixed() {
+    trail_test_ctx ctx;
+    trail_stack<trail_test_ctx> ts(ctx);
+    bool     b = false;
+    unsigned u = 1;
+    int      i = -1;
+    double   d = 0.5;
+    unsigned_vector v;
+
+    ts.push_scope();
+    ts.push(value_trail<trail_test_ctx, bool>(b, true));
+    ts.push(value_trail<trail_test_ctx, unsigned>(u, 2));
+    ts.push(push_back_vector<trail_test_ctx, unsigned_vector>(v));
+    v.push_back(7);
+    ts.push_scope();
+    ts.push(value_trail<trail_test_ctx, int>(i, -5));
+    ts.push(value_trail<trail_test_ctx, double>(d, 1.5));
+    ts.push(value_trail<trail_test_ctx, unsigned>(u, 3));
+    ts.push(push_back_vector<trail_test_ctx, unsigned_vector>(v));
+    v.push_back(8);
+    ENSURE(b && u == 3 && i == -5 && d == 1.5 && v.size() == 2);
+
+    ts.pop_scope(1);
+    ENSURE(b && u == 2 && i == -1 && d == 0.5 && v.size() == 1);
+    ts.pop_scope(1);
+    ENSURE(!b && u == 1 && i == -1 && v.empty());
+}
+
+void tst_trail() {
+    tst_mixed();
+}
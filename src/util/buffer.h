@@ -22,6 +22,7 @@ Revision History:
 #pragma once
 
 #include <type_traits>
+#include <utility>
 #include "util/memory_manager.h"
 
 template<typename T, bool CallDestructors=true, unsigned INITIAL_SIZE=16>
@@ -246,6 +247,19 @@ public:
         SASSERT(size() == nsz);
     }
 
+    bool contains(T const & elem) const {
+        for (T const & e : *this)
+            if (e == elem)
+                return true;
+        return false;
+    }
+
+    void reverse() {
+        unsigned sz = size();
+        for (unsigned i = 0; i < sz/2; ++i)
+            std::swap(m_buffer[i], m_buffer[sz-i-1]);
+    }
+
     buffer & operator=(buffer const & other) {
         if (this == &other)
             return *this;
@@ -0,0 +1,81 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    count_min_sketch.h
+
+Abstract:
+
+    Count-min sketch for estimating the frequencies of keys in a stream
+    with a fixed amount of memory.
+
+    The sketch has NUM_ROWS rows of 2^log_width counters, each row
+    indexed by its own hash of the key. The estimate of a key is the
+    minimum of its counters, it is never smaller than the number of
+    times the key was added. Counters are updated conservatively: only
+    the counters equal to the minimum are incremented, which reduces
+    the overestimation caused by collisions.
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include "util/hash.h"
+#include "util/util.h"
+#include "util/debug.h"
+
+class count_min_sketch {
+    static const unsigned NUM_ROWS = 4;
+    unsigned        m_log_width;
+    unsigned        m_mask;
+    unsigned_vector m_counters;   // NUM_ROWS rows of 2^m_log_width counters, allocated on first use.
+
+    unsigned index(unsigned row, unsigned key) const {
+        return (row << m_log_width) + (hash_u(key + row * 0x9e3779b9) & m_mask);
+    }
+
+public:
+    count_min_sketch(unsigned log_width = 12):
+        m_log_width(log_width),
+        m_mask((1u << log_width) - 1) {
+        SASSERT(log_width < 28);
+    }
+
+    /**
+       \brief Add an occurrence of key, and return the new estimate of
+       its number of occurrences.
+    */
+    unsigned inc(unsigned key) {
+        if (m_counters.empty())
+            m_counters.resize(NUM_ROWS << m_log_width, 0u);
+        unsigned est = estimate(key) + 1;
+        for (unsigned r = 0; r < NUM_ROWS; ++r) {
+            unsigned & c = m_counters[index(r, key)];
+            if (c < est)
+                c = est;
+        }
+        return est;
+    }
+
+    unsigned estimate(unsigned key) const {
+        if (m_counters.empty())
+            return 0;
+        unsigned est = UINT_MAX;
+        for (unsigned r = 0; r < NUM_ROWS; ++r)
+            est = std::min(est, m_counters[index(r, key)]);
+        return est;
+    }
+
+    /**
+       \brief Scale all counters by factor, 0 <= factor <= 1.
+    */
+    void decay(double factor) {
+        for (unsigned & c : m_counters)
+            c = static_cast<unsigned>(c * factor);
+    }
+
+    void reset() {
+        m_counters.reset();
+    }
+};
@@ -16,11 +16,13 @@ Author:
 Notes:
 
 --*/
+#include <string>
 #include "util/env_params.h"
 #include "util/params.h"
 #include "util/gparams.h"
 #include "util/util.h"
 #include "util/memory_manager.h"
+#include "util/profiler.h"
 
 void env_params::updt_params() {
     params_ref const& p = gparams::get_ref();
@@ -29,6 +31,13 @@ void env_params::updt_params() {
     memory::set_max_size(megabytes_to_bytes(p.get_uint("memory_max_size", 0)));
     memory::set_max_alloc_count(p.get_uint("memory_max_alloc_count", 0));
     memory::set_high_watermark(p.get_uint("memory_high_watermark", 0));
+    for (unsigned t = 0; t < memory::NUM_TAGS; ++t) {
+        std::string name = std::string("memory_high_watermark_") + memory::get_tag_name(t);
+        memory::set_high_watermark(t, megabytes_to_bytes(p.get_uint(name.c_str(), 0)));
+    }
+    char const * trace_file = p.get_str("profile_trace_file", "");
+    profiler::set_trace_file(trace_file);
+    profiler::enable(p.get_bool("profile", false) || *trace_file);
 }
 
 void env_params::collect_param_descrs(param_descrs & d) {
@@ -37,4 +46,11 @@ void env_params::collect_param_descrs(param_descrs & d) {
     d.insert("memory_max_size", CPK_UINT, "set hard upper limit for memory consumption (in megabytes), if 0 then there is no limit", "0");
     d.insert("memory_max_alloc_count", CPK_UINT, "set hard upper limit for memory allocations, if 0 then there is no limit", "0");
     d.insert("memory_high_watermark", CPK_UINT, "set high watermark for memory consumption (in megabytes), if 0 then there is no limit", "0");
+    for (unsigned t = 0; t < memory::NUM_TAGS; ++t) {
+        std::string name = std::string("memory_high_watermark_") + memory::get_tag_name(t);
+        std::string descr = std::string("set high watermark for the memory charged to ") + memory::get_tag_name(t) + " (in megabytes), if 0 then there is no limit";
+        d.insert(name.c_str(), CPK_UINT, descr.c_str(), "0");
+    }
+    d.insert("profile", CPK_BOOL, "measure the time spent in solver phases and display the tree of phases on exit", "false");
+    d.insert("profile_trace_file", CPK_STRING, "write every profiled phase to this file on exit, in the Chrome trace event format (chrome://tracing, Perfetto)", "");
 }
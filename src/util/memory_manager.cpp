@@ -42,10 +42,31 @@ static long long  g_memory_alloc_size        = 0;
 static long long  g_memory_max_size          = 0;
 static long long  g_memory_max_used_size     = 0;
 static long long  g_memory_watermark         = 0;
+static bool       g_memory_has_watermark     = false; // some global or tag watermark is set.
 static long long  g_memory_alloc_count       = 0;
 static long long  g_memory_max_alloc_count   = 0;
 static bool       g_exit_when_out_of_memory  = false;
 static char const * g_out_of_memory_msg      = "ERROR: out of memory";
+static long long  g_memory_tag_size[memory::NUM_TAGS]      = { 0 };
+static long long  g_memory_tag_watermark[memory::NUM_TAGS] = { 0 };
+thread_local unsigned g_memory_tag                         = memory::TAG_OTHER;
+
+static char const * g_memory_tag_names[memory::NUM_TAGS] = { "other", "ast", "sat", "smt", "rewriter", "lp" };
+
+// The tag of a block is stored in the high bits of its size field.
+// Blocks that are too large to leave room for the tag are charged to TAG_OTHER.
+#define TAG_SHIFT (sizeof(size_t) * 8 - 4)
+#define SIZE_MASK ((static_cast<size_t>(1) << TAG_SHIFT) - 1)
+
+static inline size_t mk_header(size_t s, unsigned & t) {
+    if (s > SIZE_MASK)
+        t = memory::TAG_OTHER;
+    return s | (static_cast<size_t>(t) << TAG_SHIFT);
+}
+
+static inline size_t get_header_size(size_t h) { return h & SIZE_MASK; }
+
+static inline unsigned get_header_tag(size_t h) { return static_cast<unsigned>(h >> TAG_SHIFT); }
 
 void memory::exit_when_out_of_memory(bool flag, char const * msg) {
     g_exit_when_out_of_memory = flag;
@@ -105,16 +126,46 @@ bool memory::is_out_of_memory() {
     return g_memory_out_of_memory;
 }
 
+static void update_has_watermark() {
+    g_memory_has_watermark = g_memory_watermark != 0;
+    for (unsigned t = 0; t < memory::NUM_TAGS; ++t)
+        if (g_memory_tag_watermark[t] != 0)
+            g_memory_has_watermark = true;
+}
+
 void memory::set_high_watermark(size_t watermark) {
     // This method is only safe to invoke at initialization time, that is, before the threads are created.
     g_memory_watermark = watermark;
+    update_has_watermark();
+}
+
+void memory::set_high_watermark(unsigned t, size_t watermark) {
+    // This method is only safe to invoke at initialization time, that is, before the threads are created.
+    g_memory_tag_watermark[t] = watermark;
+    update_has_watermark();
 }
 
 bool memory::above_high_watermark() {
-    if (g_memory_watermark == 0)
+    if (!g_memory_has_watermark)
         return false;
     lock_guard lock(*g_memory_mux);
-    return g_memory_watermark < g_memory_alloc_size;
+    if (g_memory_watermark != 0 && g_memory_watermark < g_memory_alloc_size)
+        return true;
+    for (unsigned t = 0; t < NUM_TAGS; ++t) 
+        if (g_memory_tag_watermark[t] != 0 && g_memory_tag_watermark[t] < g_memory_tag_size[t])
+            return true;
+    return false;
+}
+
+unsigned memory::set_tag(unsigned t) {
+    SASSERT(t < NUM_TAGS);
+    unsigned old = g_memory_tag;
+    g_memory_tag = t;
+    return old;
+}
+
+char const * memory::get_tag_name(unsigned t) {
+    return g_memory_tag_names[t];
 }
 
 // The following methods are only safe to invoke at 
@@ -153,6 +204,17 @@ unsigned long long memory::get_allocation_size() {
     return r;
 }
 
+unsigned long long memory::get_allocation_size(unsigned t) {
+    long long r;
+    {
+        lock_guard lock(*g_memory_mux);
+        r = g_memory_tag_size[t];
+    }
+    if (r < 0)
+        r = 0;
+    return r;
+}
+
 unsigned long long memory::get_max_used_memory() {
     unsigned long long r;
     {
@@ -210,7 +272,30 @@ void * memory::allocate(char const* file, int line, char const* obj, size_t s) {
 }
 #endif
 
-#if !defined(SINGLE_THREAD) && (defined(_WINDOWS) || defined(_USE_THREAD_LOCAL))
+#if defined(_WINDOWS)
+#include <malloc.h>
+#endif
+
+static void * aligned_malloc(size_t alignment, size_t s) {
+#if defined(_WINDOWS)
+    return _aligned_malloc(s, alignment);
+#else
+    void * r = nullptr;
+    if (posix_memalign(&r, alignment, s) != 0)
+        return nullptr;
+    return r;
+#endif
+}
+
+static void aligned_free(void * p) {
+#if defined(_WINDOWS)
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+#if !defined(SINGLE_THREAD)
 // ==================================
 // ==================================
 // THREAD LOCAL VERSION
@@ -224,6 +309,7 @@ void * memory::allocate(char const* file, int line, char const* obj, size_t s) {
 
 thread_local long long g_memory_thread_alloc_size    = 0;
 thread_local long long g_memory_thread_alloc_count   = 0;
+thread_local long long g_memory_thread_tag_size[memory::NUM_TAGS] = { 0 };
 
 static void synchronize_counters(bool allocating) {
 #ifdef PROFILE_MEMORY
@@ -236,6 +322,10 @@ static void synchronize_counters(bool allocating) {
         lock_guard lock(*g_memory_mux);
         g_memory_alloc_size += g_memory_thread_alloc_size;
         g_memory_alloc_count += g_memory_thread_alloc_count;
+        for (unsigned t = 0; t < memory::NUM_TAGS; ++t) {
+            g_memory_tag_size[t] += g_memory_thread_tag_size[t];
+            g_memory_thread_tag_size[t] = 0;
+        }
         if (g_memory_alloc_size > g_memory_max_used_size)
             g_memory_max_used_size = g_memory_alloc_size;
         if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
@@ -244,6 +334,7 @@ static void synchronize_counters(bool allocating) {
             counts_exceeded = true;
     }
     g_memory_thread_alloc_size = 0;
+    g_memory_thread_alloc_count = 0;
     if (out_of_mem && allocating) {
         throw_out_of_memory();
     }
@@ -252,26 +343,114 @@ static void synchronize_counters(bool allocating) {
     }
 }
 
+// Small blocks are recycled through a per-thread free cache.
+// Blocks are grouped in size classes of SMALL_BLOCK_GRANULARITY bytes 
+// (including the size field). A cached block is not accounted as
+// allocated memory, and at most SMALL_BLOCK_CACHE_SIZE blocks are kept per class.
+#define SMALL_BLOCK_GRANULARITY  16
+#define SMALL_BLOCK_MAX_SIZE     256
+#define SMALL_BLOCK_NUM_CLASSES  (SMALL_BLOCK_MAX_SIZE / SMALL_BLOCK_GRANULARITY + 1)
+#define SMALL_BLOCK_CACHE_SIZE   32
+
+struct thread_block_cache {
+    void *   m_free[SMALL_BLOCK_NUM_CLASSES];
+    unsigned m_num_free[SMALL_BLOCK_NUM_CLASSES];
+    bool     m_enabled;
+    bool     m_finalized;
+};
+
+// trivially destructible, so it remains accessible during thread/process shutdown.
+thread_local thread_block_cache g_thread_block_cache;
+
+// releases the cached blocks and flushes the thread counters when the thread terminates.
+struct thread_block_cache_finalizer {
+    bool m_registered = false;
+    ~thread_block_cache_finalizer() {
+        thread_block_cache & c = g_thread_block_cache;
+        c.m_enabled   = false;
+        c.m_finalized = true;
+        for (unsigned i = 0; i < SMALL_BLOCK_NUM_CLASSES; ++i) {
+            void * b = c.m_free[i];
+            while (b) {
+                void * next = *reinterpret_cast<void**>(static_cast<size_t*>(b) + 1);
+                free(b);
+                b = next;
+            }
+            c.m_free[i]     = nullptr;
+            c.m_num_free[i] = 0;
+        }
+        synchronize_counters(false);
+    }
+};
+
+thread_local thread_block_cache_finalizer g_thread_block_cache_finalizer;
+
+static inline size_t round_block_size(size_t s) {
+    if (s > SMALL_BLOCK_MAX_SIZE)
+        return s;
+    return (s + SMALL_BLOCK_GRANULARITY - 1) & ~static_cast<size_t>(SMALL_BLOCK_GRANULARITY - 1);
+}
+
+static inline bool cache_block(void * real_p, size_t sz) {
+    if (sz > SMALL_BLOCK_MAX_SIZE || (sz % SMALL_BLOCK_GRANULARITY) != 0)
+        return false;
+    thread_block_cache & c = g_thread_block_cache;
+    if (!c.m_enabled) {
+        if (c.m_finalized)
+            return false;
+        // first use of the finalizer registers its destructor for the current thread.
+        g_thread_block_cache_finalizer.m_registered = true;
+        c.m_enabled = true;
+    }
+    unsigned idx = static_cast<unsigned>(sz / SMALL_BLOCK_GRANULARITY);
+    if (c.m_num_free[idx] >= SMALL_BLOCK_CACHE_SIZE)
+        return false;
+    // the link to the next free block is stored after the size field.
+    *reinterpret_cast<void**>(static_cast<size_t*>(real_p) + 1) = c.m_free[idx];
+    c.m_free[idx] = real_p;
+    c.m_num_free[idx]++;
+    return true;
+}
+
+static inline void * get_cached_block(size_t sz) {
+    if (sz > SMALL_BLOCK_MAX_SIZE)
+        return nullptr;
+    thread_block_cache & c = g_thread_block_cache;
+    unsigned idx = static_cast<unsigned>(sz / SMALL_BLOCK_GRANULARITY);
+    void * r = c.m_free[idx];
+    if (r) {
+        c.m_free[idx] = *reinterpret_cast<void**>(static_cast<size_t*>(r) + 1);
+        c.m_num_free[idx]--;
+    }
+    return r;
+}
+
 void memory::deallocate(void * p) {
     size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
-    size_t sz      = *sz_p;
+    size_t sz      = get_header_size(*sz_p);
     void * real_p  = reinterpret_cast<void*>(sz_p);
     g_memory_thread_alloc_size -= sz;
-    free(real_p);
+    g_memory_thread_tag_size[get_header_tag(*sz_p)] -= sz;
+    if (!cache_block(real_p, sz))
+        free(real_p);
     if (g_memory_thread_alloc_size < -SYNCH_THRESHOLD) {
         synchronize_counters(false);
     }
 }
 
 void * memory::allocate(size_t s) {
-    s = s + sizeof(size_t); // we allocate an extra field!
-    void * r = malloc(s);
-    if (r == 0) {
+    s = round_block_size(s + sizeof(size_t)); // we allocate an extra field!
+    void * r = get_cached_block(s);
+    if (r == nullptr) 
+        r = malloc(s);
+    if (r == nullptr) {
         throw_out_of_memory();
         return nullptr;
     }
-    *(static_cast<size_t*>(r)) = s;
+    unsigned t = g_memory_tag;
+    *(static_cast<size_t*>(r)) = mk_header(s, t);
     g_memory_thread_alloc_size += s;
+    g_memory_thread_tag_size[t] += s;
     g_memory_thread_alloc_count += 1;
     if (g_memory_thread_alloc_size > SYNCH_THRESHOLD) {
         synchronize_counters(true);
@@ -282,11 +461,16 @@ void * memory::allocate(size_t s) {
 
 void* memory::reallocate(void *p, size_t s) {
     size_t *sz_p = reinterpret_cast<size_t*>(p)-1;
-    size_t sz = *sz_p;
+    size_t sz = get_header_size(*sz_p);
+    unsigned old_t = get_header_tag(*sz_p);
     void *real_p = reinterpret_cast<void*>(sz_p);
-    s = s + sizeof(size_t); // we allocate an extra field!
+    s = round_block_size(s + sizeof(size_t)); // we allocate an extra field!
+    unsigned t = old_t;
+    size_t header = mk_header(s, t);
 
     g_memory_thread_alloc_size += s - sz;
+    g_memory_thread_tag_size[old_t] -= sz;
+    g_memory_thread_tag_size[t] += s;
     g_memory_thread_alloc_count += 1;
     if (g_memory_thread_alloc_size > SYNCH_THRESHOLD) {
         synchronize_counters(true);
@@ -297,10 +481,35 @@ void* memory::reallocate(void *p, size_t s) {
         throw_out_of_memory();
         return nullptr;
     }
-    *(static_cast<size_t*>(r)) = s;
+    *(static_cast<size_t*>(r)) = header;
     return static_cast<size_t*>(r) + 1; // we return a pointer to the location after the extra field
 }
 
+void * memory::allocate_aligned(size_t alignment, size_t s) {
+    void * r = aligned_malloc(alignment, s);
+    if (r == nullptr) {
+        throw_out_of_memory();
+        return nullptr;
+    }
+    g_memory_thread_alloc_size += s;
+    g_memory_thread_tag_size[g_memory_tag] += s;
+    g_memory_thread_alloc_count += 1;
+    if (g_memory_thread_alloc_size > SYNCH_THRESHOLD) {
+        synchronize_counters(true);
+    }
+    return r;
+}
+
+// aligned blocks have no size field, they are released from the current tag.
+void memory::deallocate_aligned(void * p, size_t s) {
+    g_memory_thread_alloc_size -= s;
+    g_memory_thread_tag_size[g_memory_tag] -= s;
+    aligned_free(p);
+    if (g_memory_thread_alloc_size < -SYNCH_THRESHOLD) {
+        synchronize_counters(false);
+    }
+}
+
 #else
 // ==================================
 // ==================================
@@ -311,20 +520,24 @@ void* memory::reallocate(void *p, size_t s) {
 
 void memory::deallocate(void * p) {
     size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
-    size_t sz      = *sz_p;
+    size_t sz      = get_header_size(*sz_p);
     void * real_p  = reinterpret_cast<void*>(sz_p);
     {
         lock_guard lock(*g_memory_mux);
         g_memory_alloc_size -= sz;
+        g_memory_tag_size[get_header_tag(*sz_p)] -= sz;
     }
     free(real_p);
 }
 
 void * memory::allocate(size_t s) {
     s = s + sizeof(size_t); // we allocate an extra field!
+    unsigned t = g_memory_tag;
+    size_t header = mk_header(s, t);
     {
         lock_guard lock(*g_memory_mux);
         g_memory_alloc_size += s;
+        g_memory_tag_size[t] += s;
         g_memory_alloc_count += 1;
         if (g_memory_alloc_size > g_memory_max_used_size)
             g_memory_max_used_size = g_memory_alloc_size;
@@ -338,18 +551,23 @@ void * memory::allocate(size_t s) {
         throw_out_of_memory();
         return nullptr;
     }
-    *(static_cast<size_t*>(r)) = s;
+    *(static_cast<size_t*>(r)) = header;
     return static_cast<size_t*>(r) + 1; // we return a pointer to the location after the extra field
 }
 
 void* memory::reallocate(void *p, size_t s) {
     size_t * sz_p  = reinterpret_cast<size_t*>(p) - 1;
-    size_t sz      = *sz_p;
+    size_t sz      = get_header_size(*sz_p);
+    unsigned old_t = get_header_tag(*sz_p);
     void * real_p  = reinterpret_cast<void*>(sz_p);
     s = s + sizeof(size_t); // we allocate an extra field!
+    unsigned t = old_t;
+    size_t header = mk_header(s, t);
     {
         lock_guard lock(*g_memory_mux);
         g_memory_alloc_size += s - sz;
+        g_memory_tag_size[old_t] -= sz;
+        g_memory_tag_size[t] += s;
         g_memory_alloc_count += 1;
         if (g_memory_alloc_size > g_memory_max_used_size)
             g_memory_max_used_size = g_memory_alloc_size;
@@ -363,8 +581,38 @@ void* memory::reallocate(void *p, size_t s) {
         throw_out_of_memory();
         return nullptr;
     }
-    *(static_cast<size_t*>(r)) = s;
+    *(static_cast<size_t*>(r)) = header;
     return static_cast<size_t*>(r) + 1; // we return a pointer to the location after the extra field
 }
+
+void * memory::allocate_aligned(size_t alignment, size_t s) {
+    {
+        lock_guard lock(*g_memory_mux);
+        g_memory_alloc_size += s;
+        g_memory_tag_size[g_memory_tag] += s;
+        g_memory_alloc_count += 1;
+        if (g_memory_alloc_size > g_memory_max_used_size)
+            g_memory_max_used_size = g_memory_alloc_size;
+        if (g_memory_max_size != 0 && g_memory_alloc_size > g_memory_max_size)
+            throw_out_of_memory();
+        if (g_memory_max_alloc_count != 0 && g_memory_alloc_count > g_memory_max_alloc_count)
+            throw_alloc_counts_exceeded();
+    }
+    void * r = aligned_malloc(alignment, s);
+    if (r == nullptr) {
+        throw_out_of_memory();
+        return nullptr;
+    }
+    return r;
+}
+
+void memory::deallocate_aligned(void * p, size_t s) {
+    {
+        lock_guard lock(*g_memory_mux);
+        g_memory_alloc_size -= s;
+        g_memory_tag_size[g_memory_tag] -= s;
+    }
+    aligned_free(p);
+}
  
 #endif
@@ -49,10 +49,30 @@ public:
 
 class memory {
 public:
+    /**
+       \brief Allocations are charged to the tag of the current thread,
+       so that memory can be accounted per subsystem. A block is released
+       from the tag it was charged to.
+    */
+    enum tag { TAG_OTHER, TAG_AST, TAG_SAT, TAG_SMT, TAG_REWRITER, TAG_LP, NUM_TAGS };
+
+    // NUM_TAGS keeps the tag of the current thread.
+    class scoped_tag {
+        unsigned m_old;
+    public:
+        scoped_tag(unsigned t): m_old(t < NUM_TAGS ? set_tag(t) : NUM_TAGS) {}
+        ~scoped_tag() { if (m_old < NUM_TAGS) set_tag(m_old); }
+    };
+
     static bool is_out_of_memory();
     static void initialize(size_t max_size);
     static void set_high_watermark(size_t watermak);
+    static void set_high_watermark(unsigned t, size_t watermark);
+    // true if the total or the memory of some tag is above its high watermark.
     static bool above_high_watermark();
+    // set the tag of the current thread and return the previous one.
+    static unsigned set_tag(unsigned t);
+    static char const * get_tag_name(unsigned t);
     static void set_max_size(size_t max_size);
     static void set_max_alloc_count(size_t max_count);
     static void finalize();
@@ -61,11 +81,17 @@ public:
     static void deallocate(void* p);
     static ALLOC_ATTR void* allocate(size_t s);
     static ALLOC_ATTR void* reallocate(void *p, size_t s);
+    // alignment must be a power of two and a multiple of sizeof(void*).
+    // Memory obtained with allocate_aligned must be released with deallocate_aligned
+    // using the same size.
+    static ALLOC_ATTR void* allocate_aligned(size_t alignment, size_t s);
+    static void deallocate_aligned(void* p, size_t s);
 #if Z3DEBUG
     static void deallocate(char const* file, int line, void* p);
     static ALLOC_ATTR void* allocate(char const* file, int line, char const* obj, size_t s);
 #endif
     static unsigned long long get_allocation_size();
+    static unsigned long long get_allocation_size(unsigned t);
     static unsigned long long get_max_used_memory();
     static unsigned long long get_allocation_count();
     static unsigned long long get_max_memory_size();
@@ -67,13 +67,20 @@ bool mpn_manager::add(mpn_digit const * a, size_t const lnga,
     mpn_digit k = 0;
     mpn_digit r;
     bool c1, c2;
-    for (size_t j = 0; j < len; j++) {
-        mpn_digit const & u_j = (j < lnga) ? a[j] : zero;
-        mpn_digit const & v_j = (j < lngb) ? b[j] : zero;
-        r = u_j + v_j; c1 = r < u_j;
+    size_t j = 0;
+    // digits present in both operands
+    for (size_t common = std::min(lnga, lngb); j < common; j++) {
+        mpn_digit u_j = a[j];
+        r = u_j + b[j]; c1 = r < u_j;
         c[j] = r + k;  c2 = c[j] < r;
         k = c1 | c2;
     }
+    // only the carry is added to the digits of the longer operand
+    mpn_digit const * t = lnga > lngb ? a : b;
+    for (; j < len; j++) {
+        c[j] = t[j] + k;
+        k = c[j] < k;
+    }
     c[len] = k;
     size_t &os = *plngc;
     for (os = len+1; os > 1 && c[os-1] == 0; ) os--;
@@ -91,13 +98,28 @@ bool mpn_manager::sub(mpn_digit const * a, size_t const lnga,
     mpn_digit & k = *pborrow; k = 0;
     mpn_digit r;
     bool c1, c2;
-    for (size_t j = 0; j < len; j++) {
-        mpn_digit const & u_j = (j < lnga) ? a[j] : zero;
-        mpn_digit const & v_j = (j < lngb) ? b[j] : zero;        
-        r = u_j - v_j; c1 = r > u_j;
+    size_t j = 0;
+    for (size_t common = std::min(lnga, lngb); j < common; j++) {
+        mpn_digit u_j = a[j];
+        r = u_j - b[j]; c1 = r > u_j;
         c[j] = r - k;  c2 = c[j] > r;
         k = c1 | c2;
     }
+    if (lnga > lngb) {
+        // only the borrow is subtracted from the remaining digits of a
+        for (; j < len; j++) {
+            mpn_digit u_j = a[j];
+            c[j] = u_j - k;
+            k = c[j] > u_j;
+        }
+    }
+    else {
+        for (; j < len; j++) {
+            r = zero - b[j]; c1 = r != zero;
+            c[j] = r - k;  c2 = c[j] > r;
+            k = c1 | c2;
+        }
+    }
     trace_nl(c, lnga);
     return true; // return k != 0?
 }
@@ -130,6 +130,11 @@ public:
 
     static bool is_small(mpq const & a) { return is_small(a.m_num) && is_small(a.m_den); }    
 
+    // integers stored inline: a + b*c fits in an int64_t for any three of them.
+    static bool is_small_int(mpq const & a) { return is_int(a) && is_small(a.m_num); }
+
+    static int64_t small_int_value(mpq const & a) { SASSERT(is_small_int(a)); return a.m_num.m_val; }
+
     static mpq mk_q(int v) { return mpq(v); }
 
     mpq mk_q(int n, int d) { mpq r; set(r, n, d); return r; }
@@ -335,6 +340,9 @@ public:
         else if (is_zero(b) || is_zero(c)) {
             set(d, a);
         }
+        else if (is_small_int(a) && is_small_int(b) && is_small_int(c)) {
+            set(d, small_int_value(a) + small_int_value(b) * small_int_value(c));
+        }
         else {
             if (SYNCH) {
                 mpq tmp;
@@ -383,6 +391,9 @@ public:
         else if (is_minus_one(b)) {
             add(a, c, d);
         }
+        else if (is_small_int(a) && is_small_int(b) && is_small_int(c)) {
+            set(d, small_int_value(a) - small_int_value(b) * small_int_value(c));
+        }
         else {
             if (SYNCH) {
                 mpq tmp;
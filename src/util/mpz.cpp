@@ -187,6 +187,58 @@ mpz_manager<SYNCH>::~mpz_manager() {
 }
 
 #ifndef _MP_GMP
+#ifndef SINGLE_THREAD
+// Synchronized managers (e.g., the one behind rational) are shared by all threads.
+// Their cells of the initial capacity are recycled through a per-thread pool, 
+// so short-lived numerals do not go through the global allocator.
+#define MPZ_CELL_POOL_SIZE 256
+
+struct mpz_cell_pool {
+    mpz_cell * m_cells[MPZ_CELL_POOL_SIZE];
+    unsigned   m_size;
+    unsigned   m_capacity;
+    bool       m_finalized;
+};
+
+// trivially destructible, so it remains accessible during thread/process shutdown.
+static thread_local mpz_cell_pool g_mpz_cell_pool;
+
+struct mpz_cell_pool_finalizer {
+    bool m_registered = false;
+    ~mpz_cell_pool_finalizer() {
+        mpz_cell_pool & p = g_mpz_cell_pool;
+        p.m_finalized = true;
+        for (unsigned i = 0; i < p.m_size; ++i) 
+            memory::deallocate(p.m_cells[i]);
+        p.m_size = 0;
+    }
+};
+
+static thread_local mpz_cell_pool_finalizer g_mpz_cell_pool_finalizer;
+
+static inline mpz_cell * pop_pooled_cell(unsigned capacity) {
+    mpz_cell_pool & p = g_mpz_cell_pool;
+    if (p.m_size == 0 || p.m_capacity != capacity)
+        return nullptr;
+    return p.m_cells[--p.m_size];
+}
+
+static inline bool push_pooled_cell(mpz_cell * cell, unsigned capacity) {
+    mpz_cell_pool & p = g_mpz_cell_pool;
+    if (p.m_finalized)
+        return false;
+    if (p.m_size == 0) {
+        // first use of the finalizer registers its destructor for the current thread.
+        g_mpz_cell_pool_finalizer.m_registered = true;
+        p.m_capacity = capacity;
+    }
+    if (p.m_size == MPZ_CELL_POOL_SIZE || p.m_capacity != capacity)
+        return false;
+    p.m_cells[p.m_size++] = cell;
+    return true;
+}
+#endif
+
 template<bool SYNCH>
 mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     SASSERT(capacity >= m_init_cell_capacity);
@@ -195,7 +247,9 @@ mpz_cell * mpz_manager<SYNCH>::allocate(unsigned capacity) {
     cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
 #else
     if (SYNCH) {
-        cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
+        cell = capacity == m_init_cell_capacity ? pop_pooled_cell(capacity) : nullptr;
+        if (!cell)
+            cell = reinterpret_cast<mpz_cell*>(memory::allocate(cell_size(capacity)));
     }
     else {
         cell = reinterpret_cast<mpz_cell*>(m_allocator.allocate(cell_size(capacity)));
@@ -214,7 +268,8 @@ void mpz_manager<SYNCH>::deallocate(bool is_heap, mpz_cell * ptr) {
         m_allocator.deallocate(cell_size(ptr->m_capacity), ptr); 
 #else
         if (SYNCH) {
-            memory::deallocate(ptr);
+            if (ptr->m_capacity != m_init_cell_capacity || !push_pooled_cell(ptr, m_init_cell_capacity))
+                memory::deallocate(ptr);
         }
         else {
             m_allocator.deallocate(cell_size(ptr->m_capacity), ptr);        
@@ -1223,11 +1278,20 @@ void mpz_manager<SYNCH>::gcd(unsigned sz, mpz const * as, mpz & g) {
         break;
     }
     gcd(as[0], as[1], g);
+    mpz r;
     for (unsigned i = 2; i < sz; i++) {
         if (is_one(g))
-            return;
-        gcd(g, as[i], g);
+            break;
+        if (is_small(g) && !is_zero(g) && !is_small(as[i])) {
+            // gcd(g, a) = gcd(g, a rem g), and a rem g is small.
+            rem(as[i], g, r);
+            gcd(g, r, g);
+        }
+        else {
+            gcd(g, as[i], g);
+        }
     }
+    del(r);
 #endif
 }
 
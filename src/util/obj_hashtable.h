@@ -53,7 +53,11 @@ public:
 
 };
 
-template<typename Key, typename Value>
+/**
+   \brief map from objects to values.
+   Table selects the hash table implementation, core_hashtable or swiss_hashtable.
+*/
+template<typename Key, typename Value, template<typename, typename, typename> class Table = core_hashtable>
 class obj_map {
 public:
     struct key_data {
@@ -95,7 +99,7 @@ public:
         void mark_as_free() { m_data.m_key = nullptr; }
     };
 
-    typedef core_hashtable<obj_map_entry, obj_hash<key_data>, default_eq<key_data> > table;
+    typedef Table<obj_map_entry, obj_hash<key_data>, default_eq<key_data> > table;
 
     table m_table;
   
@@ -0,0 +1,172 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    parallel_executor.cpp
+
+Abstract:
+
+    Process wide pool of worker threads.
+
+--*/
+
+#include "util/parallel_executor.h"
+#include "util/gparams.h"
+#include "util/mutex.h"
+#ifndef SINGLE_THREAD
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <thread>
+#include <vector>
+#endif
+
+static atomic<unsigned> g_max_threads(0);
+
+void parallel_executor::set_max_threads(unsigned n) {
+    g_max_threads = n;
+}
+
+unsigned parallel_executor::max_threads() {
+    unsigned n = g_max_threads;
+    if (n == 0)
+        n = gparams::get_module("parallel").get_uint("threads.max", 10000);
+    return std::max(1u, n);
+}
+
+#ifdef SINGLE_THREAD
+
+void parallel_executor::run(unsigned n, task const& t) {
+    for (unsigned i = 0; i < n; ++i)
+        t(i);
+}
+
+#else
+
+namespace {
+
+    struct batch {
+        parallel_executor::task const& m_task;
+        unsigned                       m_size;
+        unsigned                       m_next { 0 };   // next task to claim
+        unsigned                       m_pending;      // tasks that did not complete
+        std::exception_ptr             m_ex;
+        batch(parallel_executor::task const& t, unsigned n): m_task(t), m_size(n), m_pending(n) {}
+        bool exhausted() const { return m_next == m_size; }
+    };
+
+    class executor_pool {
+        std::mutex               m_mux;
+        std::condition_variable  m_work;       // new tasks for workers
+        std::condition_variable  m_done;       // completion of tasks for callers
+        std::vector<batch*>      m_batches;    // batches with unclaimed tasks, most recent last
+        std::vector<std::thread> m_workers;
+        unsigned                 m_idle { 0 };
+        unsigned                 m_unclaimed { 0 };
+        bool                     m_shutdown { false };
+
+        // claim a task of b. The caller holds m_mux.
+        unsigned claim(batch& b) {
+            SASSERT(!b.exhausted());
+            unsigned i = b.m_next++;
+            --m_unclaimed;
+            if (b.exhausted())
+                m_batches.erase(std::find(m_batches.begin(), m_batches.end(), &b));
+            return i;
+        }
+
+        void execute(batch& b, unsigned i) {
+            std::exception_ptr ex;
+            try {
+                b.m_task(i);
+            }
+            catch (...) {
+                ex = std::current_exception();
+            }
+            lock_guard lock(m_mux);
+            if (ex && !b.m_ex)
+                b.m_ex = ex;
+            if (--b.m_pending == 0)
+                m_done.notify_all();
+        }
+
+        // workers are counted as idle from their creation until they claim a task.
+        void worker() {
+            std::unique_lock<std::mutex> lock(m_mux);
+            while (true) {
+                m_work.wait(lock, [&] { return m_shutdown || !m_batches.empty(); });
+                --m_idle;
+                if (m_batches.empty())
+                    return;
+                batch& b = *m_batches.back();
+                unsigned i = claim(b);
+                lock.unlock();
+                execute(b, i);
+                lock.lock();
+                ++m_idle;
+            }
+        }
+
+    public:
+
+        ~executor_pool() {
+            {
+                lock_guard lock(m_mux);
+                m_shutdown = true;
+            }
+            m_work.notify_all();
+            for (std::thread& w : m_workers)
+                w.join();
+        }
+
+        void run(unsigned n, parallel_executor::task const& t) {
+            batch b(t, n);
+            {
+                lock_guard lock(m_mux);
+                m_batches.push_back(&b);
+                m_unclaimed += n;
+                // the calling thread executes tasks itself, other tasks go to idle or new workers.
+                unsigned max_workers = parallel_executor::max_threads() - 1;
+                while (m_workers.size() < max_workers && m_idle + 1 < m_unclaimed) {
+                    ++m_idle;
+                    m_workers.push_back(std::thread([this]() { worker(); }));
+                }
+            }
+            m_work.notify_all();
+            while (true) {
+                unsigned i;
+                {
+                    lock_guard lock(m_mux);
+                    if (b.exhausted())
+                        break;
+                    i = claim(b);
+                }
+                execute(b, i);
+            }
+            {
+                std::unique_lock<std::mutex> lock(m_mux);
+                m_done.wait(lock, [&] { return b.m_pending == 0; });
+            }
+            if (b.m_ex)
+                std::rethrow_exception(b.m_ex);
+        }
+    };
+
+    executor_pool& get_pool() {
+        static executor_pool pool;
+        return pool;
+    }
+}
+
+void parallel_executor::run(unsigned n, task const& t) {
+    if (n == 0)
+        return;
+    if (n == 1) {
+        t(0);
+        return;
+    }
+    get_pool().run(n, t);
+}
+
+#endif
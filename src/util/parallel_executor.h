@@ -0,0 +1,46 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    parallel_executor.h
+
+Abstract:
+
+    Process wide pool of worker threads shared by the parallel tacticals,
+    the parallel tactic and the parallel mode of the SMT core.
+
+    parallel_executor::run executes a batch of tasks. The calling thread
+    executes tasks of its batch itself and idle workers take the
+    remaining ones, most recent batch first, so nested parallel calls
+    reuse the threads that are already running instead of creating new
+    ones. New workers are created only when there are more pending tasks
+    than idle workers, and the total number of threads working on
+    batches is bounded by parallel.threads.max.
+
+    Tasks of a batch beyond the bound start when a thread becomes
+    available. Parallel portfolios that race their tasks should therefore
+    cancel the remaining tasks when the first one finishes.
+
+--*/
+#pragma once
+
+#include <functional>
+
+class parallel_executor {
+public:
+    typedef std::function<void(unsigned)> task;
+
+    /**
+       \brief execute task(0), ..., task(n-1) and return when all of them completed.
+       If tasks throw, the first exception is rethrown after all tasks completed.
+    */
+    static void run(unsigned n, task const& t);
+
+    /**
+       \brief number of threads, including calling threads, that may work on
+       batches at the same time. Taken from parallel.threads.max when not set.
+    */
+    static void set_max_threads(unsigned n);
+    static unsigned max_threads();
+};
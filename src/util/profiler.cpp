@@ -0,0 +1,210 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    profiler.cpp
+
+Abstract:
+
+    Hierarchical profiler for solver phases.
+
+    The buffers use the standard allocator, so that they are independent
+    of the life time of the memory manager.
+
+--*/
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "util/profiler.h"
+#include "util/mutex.h"
+#include "util/util.h"
+
+namespace profiler {
+
+    bool g_enabled = false;
+
+    struct node {
+        std::string         m_name;
+        char const *        m_name_ptr; // name passed when the node was created
+        node *              m_parent;
+        std::vector<node *> m_children;
+        uint64_t            m_count = 0;
+        uint64_t            m_time = 0;
+        node(char const * name, node * parent): m_name(name), m_name_ptr(name), m_parent(parent) {}
+        ~node() {
+            for (node * c : m_children)
+                delete c;
+        }
+        node * get_child(char const * name) {
+            for (node * c : m_children)
+                if (c->m_name_ptr == name)
+                    return c;
+            for (node * c : m_children)
+                if (c->m_name == name)
+                    return c;
+            node * c = new node(name, this);
+            m_children.push_back(c);
+            return c;
+        }
+    };
+
+    struct span {
+        node *   m_node;
+        uint64_t m_start;
+        uint64_t m_duration;
+    };
+
+    struct thread_buffer {
+        unsigned          m_id;
+        node              m_root;
+        node *            m_current;
+        std::vector<span> m_spans;
+        thread_buffer(unsigned id): m_id(id), m_root("root", nullptr), m_current(&m_root) {}
+    };
+
+    static mutex *                        g_mux = new mutex;
+    static std::vector<thread_buffer *>   g_buffers;
+    static std::string                    g_trace_file;
+    static bool                           g_record_spans = false;
+    static unsigned                       g_generation = 1;
+
+    // thread buffers are released on reset; the generation tells
+    // whether the buffer cached by a thread is still alive.
+    static thread_local thread_buffer *   t_buffer = nullptr;
+    static thread_local unsigned          t_generation = 0;
+
+    static std::chrono::steady_clock::time_point g_origin = std::chrono::steady_clock::now();
+
+    uint64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_origin).count();
+    }
+
+    static thread_buffer * get_buffer() {
+        if (t_buffer && t_generation == g_generation)
+            return t_buffer;
+        lock_guard lock(*g_mux);
+        t_buffer = new thread_buffer(static_cast<unsigned>(g_buffers.size()));
+        t_generation = g_generation;
+        g_buffers.push_back(t_buffer);
+        return t_buffer;
+    }
+
+    void enable(bool f) {
+        g_enabled = f;
+    }
+
+    void set_trace_file(char const * file) {
+        g_trace_file = file ? file : "";
+        g_record_spans = !g_trace_file.empty();
+    }
+
+    node * enter(char const * name) {
+        thread_buffer * b = get_buffer();
+        node * parent = b->m_current;
+        b->m_current = parent->get_child(name);
+        return parent;
+    }
+
+    void leave(node * parent, uint64_t start) {
+        uint64_t duration = now() - start;
+        thread_buffer * b = get_buffer();
+        node * n = b->m_current;
+        if (n->m_parent != parent)
+            return; // the profiler was reset while the phase was active
+        n->m_count++;
+        n->m_time += duration;
+        if (g_record_spans)
+            b->m_spans.push_back({ n, start, duration });
+        b->m_current = parent;
+    }
+
+    static void display(std::ostream & out, node const & n, uint64_t total, unsigned indent) {
+        std::vector<node *> children(n.m_children);
+        std::sort(children.begin(), children.end(), [](node * a, node * b) { return a->m_time > b->m_time; });
+        for (node * c : children) {
+            uint64_t self = c->m_time;
+            for (node * d : c->m_children)
+                self -= std::min(self, d->m_time);
+            out << std::string(indent, ' ') << c->m_name
+                << " :count " << c->m_count
+                << " :time " << std::fixed << std::setprecision(3) << c->m_time / 1e6 << "ms"
+                << " :self " << self / 1e6 << "ms";
+            if (total > 0)
+                out << " (" << std::setprecision(1) << (100.0 * c->m_time) / total << "%)";
+            out << "\n";
+            display(out, *c, total, indent + 2);
+        }
+    }
+
+    void display(std::ostream & out) {
+        lock_guard lock(*g_mux);
+        for (thread_buffer * b : g_buffers) {
+            uint64_t total = 0;
+            for (node * c : b->m_root.m_children)
+                total += c->m_time;
+            if (total == 0)
+                continue;
+            out << "(profile :thread " << b->m_id << "\n";
+            display(out, b->m_root, total, 2);
+            out << ")\n";
+        }
+    }
+
+    static void display_name(std::ostream & out, std::string const & name) {
+        out << '"';
+        for (char c : name) {
+            if (c == '"' || c == '\\')
+                out << '\\';
+            if (static_cast<unsigned char>(c) >= ' ')
+                out << c;
+        }
+        out << '"';
+    }
+
+    void display_trace(std::ostream & out) {
+        lock_guard lock(*g_mux);
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        for (thread_buffer * b : g_buffers) {
+            for (span const & s : b->m_spans) {
+                if (!first)
+                    out << ",";
+                first = false;
+                out << "\n{\"name\":";
+                display_name(out, s.m_node->m_name);
+                out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << b->m_id
+                    << ",\"ts\":" << s.m_start / 1000 << "." << std::setw(3) << std::setfill('0') << s.m_start % 1000
+                    << ",\"dur\":" << s.m_duration / 1000 << "." << std::setw(3) << std::setfill('0') << s.m_duration % 1000
+                    << std::setfill(' ') << "}";
+            }
+        }
+        out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+    }
+
+    void reset() {
+        lock_guard lock(*g_mux);
+        for (thread_buffer * b : g_buffers)
+            delete b;
+        g_buffers.clear();
+        ++g_generation;
+    }
+
+    void finalize() {
+        if (g_enabled) {
+            display(verbose_stream());
+            if (g_record_spans) {
+                std::ofstream out(g_trace_file);
+                if (out)
+                    display_trace(out);
+                else
+                    verbose_stream() << "(error \"could not open profile trace file " << g_trace_file << "\")\n";
+            }
+        }
+        reset();
+    }
+};
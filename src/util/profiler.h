@@ -0,0 +1,86 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    profiler.h
+
+Abstract:
+
+    Hierarchical profiler for solver phases.
+
+    Phases are marked with scoped_profile objects. Each thread keeps its
+    own tree of phases, indexed by the path of enclosing phases, with the
+    number of times a phase was entered and the time spent in it in
+    nanoseconds. When a trace file is set, every span is also recorded
+    and written in the Chrome trace event format, which can be loaded
+    into chrome://tracing or Perfetto.
+
+    Profiling is off by default. A disabled scoped_profile only tests a
+    global flag.
+
+--*/
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+namespace profiler {
+
+    struct node;
+
+    extern bool g_enabled;
+
+    inline bool is_enabled() { return g_enabled; }
+
+    void enable(bool f);
+
+    /**
+       \brief record all spans and write them as a Chrome trace to file on finalize.
+       An empty file name disables recording of spans.
+    */
+    void set_trace_file(char const * file);
+
+    uint64_t now();
+
+    /**
+       \brief enter phase name in the current thread, return the enclosing phase.
+    */
+    node * enter(char const * name);
+
+    /**
+       \brief leave the current phase that was entered at time start.
+    */
+    void leave(node * parent, uint64_t start);
+
+    /**
+       \brief display the phase trees of all threads.
+    */
+    void display(std::ostream & out);
+
+    void display_trace(std::ostream & out);
+
+    void reset();
+
+    void finalize();
+};
+
+/*
+  ADD_FINALIZER('profiler::finalize();')
+*/
+
+class scoped_profile {
+    profiler::node * m_parent;
+    uint64_t         m_start;
+public:
+    scoped_profile(char const * name): m_parent(nullptr), m_start(0) {
+        if (profiler::is_enabled()) {
+            m_parent = profiler::enter(name);
+            m_start  = profiler::now();
+        }
+    }
+    ~scoped_profile() {
+        if (m_parent)
+            profiler::leave(m_parent, m_start);
+    }
+};
@@ -0,0 +1,180 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    radix_heap.h
+
+Abstract:
+
+    A heap of integers with unsigned keys for monotone priority queues,
+    where keys inserted or decreased are never smaller than the key
+    of the last removed minimum, as in Dijkstra's algorithm with
+    non-negative integer weights.
+
+    Values are kept in 33 buckets: bucket 0 holds the values whose key is
+    equal to the last minimum, bucket i > 0 those whose key differs from
+    it first in bit i-1. erase_min redistributes the first non-empty
+    bucket when bucket 0 is empty, so each value moves O(log K) times
+    for keys in [0, K), and no comparisons between values are needed.
+
+--*/
+#pragma once
+
+#include "util/vector.h"
+#include "util/util.h"
+#include "util/debug.h"
+
+class radix_heap {
+    static const unsigned NUM_BUCKETS = 33;
+
+    struct entry {
+        int      m_value;
+        unsigned m_key;
+    };
+
+    svector<entry>   m_buckets[NUM_BUCKETS];
+    unsigned         m_last { 0 };   // key of the last removed minimum.
+    unsigned         m_size { 0 };
+    unsigned_vector  m_keys;
+    int_vector       m_value2bucket; // -1 if the value is not in the heap.
+    unsigned_vector  m_value2pos;
+
+    unsigned bucket_of(unsigned key) const {
+        return key == m_last ? 0 : log2(key ^ m_last) + 1;
+    }
+
+    void place(int v, unsigned key) {
+        SASSERT(key >= m_last);
+        unsigned b = bucket_of(key);
+        m_keys[v] = key;
+        m_value2bucket[v] = b;
+        m_value2pos[v] = m_buckets[b].size();
+        m_buckets[b].push_back({ v, key });
+    }
+
+    void remove(int v) {
+        svector<entry> & bucket = m_buckets[m_value2bucket[v]];
+        unsigned pos = m_value2pos[v];
+        entry last = bucket.back();
+        bucket[pos] = last;
+        m_value2pos[last.m_value] = pos;
+        bucket.pop_back();
+        m_value2bucket[v] = -1;
+    }
+
+    // ensure that bucket 0 contains the values with the minimal key.
+    void refill() {
+        SASSERT(!empty());
+        if (!m_buckets[0].empty())
+            return;
+        unsigned i = 1;
+        while (m_buckets[i].empty())
+            ++i;
+        svector<entry> & bucket = m_buckets[i];
+        unsigned min_key = bucket[0].m_key;
+        for (entry const & e : bucket)
+            min_key = std::min(min_key, e.m_key);
+        m_last = min_key;
+        svector<entry> todo;
+        todo.swap(bucket);
+        for (entry const & e : todo) {
+            SASSERT(bucket_of(e.m_key) < i);
+            place(e.m_value, e.m_key);
+        }
+        todo.reset();
+        // reuse the memory of the redistributed bucket.
+        if (bucket.empty())
+            bucket.swap(todo);
+    }
+
+public:
+    radix_heap(int s = 0) {
+        set_bounds(s);
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    unsigned size() const {
+        return m_size;
+    }
+
+    bool contains(int v) const {
+        return v < static_cast<int>(m_value2bucket.size()) && m_value2bucket[v] >= 0;
+    }
+
+    unsigned get_key(int v) const {
+        SASSERT(contains(v));
+        return m_keys[v];
+    }
+
+    void set_bounds(int s) {
+        m_keys.resize(s, 0);
+        m_value2bucket.resize(s, -1);
+        m_value2pos.resize(s, 0);
+    }
+
+    void reserve(int s) {
+        if (s > static_cast<int>(m_value2bucket.size()))
+            set_bounds(s);
+    }
+
+    /**
+       \brief Reset the heap, keys inserted afterwards can be arbitrary again.
+    */
+    void reset() {
+        for (auto & bucket : m_buckets) {
+            for (entry const & e : bucket)
+                m_value2bucket[e.m_value] = -1;
+            bucket.reset();
+        }
+        m_last = 0;
+        m_size = 0;
+    }
+
+    void insert(int v, unsigned key) {
+        SASSERT(!contains(v));
+        SASSERT(key >= m_last);
+        place(v, key);
+        ++m_size;
+    }
+
+    void decreased(int v, unsigned key) {
+        SASSERT(contains(v));
+        SASSERT(key >= m_last && key <= m_keys[v]);
+        if (bucket_of(key) == static_cast<unsigned>(m_value2bucket[v])) {
+            m_keys[v] = key;
+            m_buckets[m_value2bucket[v]][m_value2pos[v]].m_key = key;
+            return;
+        }
+        remove(v);
+        place(v, key);
+    }
+
+    void erase(int v) {
+        SASSERT(contains(v));
+        remove(v);
+        --m_size;
+    }
+
+    unsigned min_key() {
+        refill();
+        return m_last;
+    }
+
+    int min_value() {
+        refill();
+        return m_buckets[0].back().m_value;
+    }
+
+    int erase_min() {
+        refill();
+        int v = m_buckets[0].back().m_value;
+        m_buckets[0].pop_back();
+        m_value2bucket[v] = -1;
+        --m_size;
+        return v;
+    }
+};
@@ -104,6 +104,14 @@ public:
         return m_buffer.empty();
     }
 
+    bool contains(T * n) const {
+        return m_buffer.contains(n);
+    }
+
+    void reverse() {
+        m_buffer.reverse();
+    }
+
     void reset() {
         dec_range_ref(m_buffer.begin(), m_buffer.end());
         m_buffer.reset();
@@ -38,19 +38,6 @@ reslimit::reslimit():
     m_limit(std::numeric_limits<uint64_t>::max()) {
 }
 
-uint64_t reslimit::count() const {
-    return m_count;
-}
-
-bool reslimit::inc() {
-    ++m_count;
-    return not_canceled();
-}
-
-bool reslimit::inc(unsigned offset) {
-    m_count += offset;
-    return not_canceled();
-}
 
 void reslimit::push(unsigned delta_limit) {
     uint64_t new_limit = delta_limit ? delta_limit + m_count : std::numeric_limits<uint64_t>::max();
@@ -112,6 +99,14 @@ void reslimit::dec_cancel() {
     }
 }
 
+bool rlimit_budget::refill() {
+    flush();
+    if (!m_limit.inc())
+        return false;
+    m_granted = m_left = static_cast<unsigned>(std::min(static_cast<uint64_t>(m_chunk), m_limit.remaining()));
+    return true;
+}
+
 void reslimit::set_cancel(unsigned f) {
     m_cancel = f;
     for (unsigned i = 0; i < m_children.size(); ++i) {
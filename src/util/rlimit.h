@@ -45,9 +45,16 @@ public:
     void push_child(reslimit* r);
     void pop_child();
 
-    bool inc();
-    bool inc(unsigned offset);
-    uint64_t count() const;
+    bool inc() {
+        ++m_count;
+        return not_canceled();
+    }
+    bool inc(unsigned offset) {
+        m_count += offset;
+        return not_canceled();
+    }
+    uint64_t count() const { return m_count; }
+    uint64_t remaining() const { return m_count >= m_limit ? 0 : m_limit - m_count; }
 
     bool suspended() const { return m_suspend;  }
     inline bool not_canceled() const { return (m_cancel == 0 && m_count <= m_limit) || m_suspend; }
@@ -60,6 +67,45 @@ public:
     void dec_cancel();
 };
 
+/**
+   \brief Local budget of steps for hot loops.
+
+   The budget takes steps from a reslimit in chunks and counts them
+   down locally, so that inc() is a decrement most of the time. Used
+   steps are charged to the reslimit when a chunk is exhausted and when
+   the budget is destroyed. A chunk never exceeds the steps remaining
+   in the reslimit, so a budget that is the only consumer of the limit
+   hits it at the same step as reslimit::inc(). A cancellation is
+   noticed at the next chunk.
+*/
+class rlimit_budget {
+    reslimit& m_limit;
+    unsigned  m_chunk;
+    unsigned  m_granted { 0 };
+    unsigned  m_left { 0 };
+
+    bool refill();
+public:
+    rlimit_budget(reslimit& r, unsigned chunk = 1024): m_limit(r), m_chunk(chunk) {}
+    ~rlimit_budget() { flush(); }
+
+    bool inc() {
+        if (m_left > 0) {
+            --m_left;
+            return true;
+        }
+        return refill();
+    }
+
+    /**
+       \brief Charge the steps used so far to the reslimit.
+    */
+    void flush() {
+        m_limit.inc(m_granted - m_left);
+        m_granted = m_left = 0;
+    }
+};
+
 class scoped_rlimit {
     reslimit& m_limit;
 public:
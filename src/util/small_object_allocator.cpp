@@ -25,7 +25,8 @@ Revision History:
 #include "util/vector.h"
 #include<iomanip>
 
-small_object_allocator::small_object_allocator(char const * id) {
+small_object_allocator::small_object_allocator(char const * id, bool slab_mode) {
+    static_assert(sizeof(chunk) == SLAB_SIZE, "chunks must fit in a slab");
     for (unsigned i = 0; i < NUM_SLOTS; i++) {
         m_chunks[i] = nullptr;
         m_free_list[i] = nullptr;
@@ -34,17 +35,43 @@ small_object_allocator::small_object_allocator(char const * id) {
         m_id = id;
     });
     m_alloc_size = 0;
+    m_slab_mode = slab_mode;
+    m_tag = memory::NUM_TAGS;
 }
 
-small_object_allocator::~small_object_allocator() {
+small_object_allocator::chunk * small_object_allocator::mk_chunk() {
+    memory::scoped_tag _tag(m_tag);
+    if (m_slab_mode)
+        return new (memory::allocate_aligned(SLAB_SIZE, sizeof(chunk))) chunk();
+    return alloc(chunk);
+}
+
+void small_object_allocator::del_chunk(chunk * c) {
+    memory::scoped_tag _tag(m_tag);
+    if (m_slab_mode) {
+        c->~chunk();
+        memory::deallocate_aligned(c, sizeof(chunk));
+    }
+    else {
+        dealloc(c);
+    }
+}
+
+void small_object_allocator::del_chunks() {
     for (unsigned i = 0; i < NUM_SLOTS; i++) {
         chunk * c = m_chunks[i];
         while (c) {
             chunk * next = c->m_next;
-            dealloc(c);
+            del_chunk(c);
             c = next;
         }
+        m_chunks[i] = nullptr;
+        m_free_list[i] = nullptr;
     }
+}
+
+small_object_allocator::~small_object_allocator() {
+    del_chunks();
     DEBUG_CODE({
         if (m_alloc_size > 0) {
             std::cerr << "Memory leak detected for small object allocator '" << m_id << "'. " << m_alloc_size << " bytes leaked" << std::endl;
@@ -53,16 +80,7 @@ small_object_allocator::~small_object_allocator() {
 }
 
 void small_object_allocator::reset() {
-    for (unsigned i = 0; i < NUM_SLOTS; i++) {
-        chunk * c = m_chunks[i];
-        while (c) {
-            chunk * next = c->m_next;
-            dealloc(c);
-            c = next;
-        }
-        m_chunks[i] = nullptr;
-        m_free_list[i] = nullptr;
-    }
+    del_chunks();
     m_alloc_size = 0;
 }
 
@@ -89,6 +107,10 @@ void small_object_allocator::deallocate(size_t size, void * p) {
         slot_id++;
     SASSERT(slot_id > 0);
     SASSERT(slot_id < NUM_SLOTS);
+    if (m_slab_mode) {
+        SASSERT(get_slab(p)->m_num_used > 0);
+        get_slab(p)->m_num_used--;
+    }
     *(reinterpret_cast<void**>(p)) = m_free_list[slot_id];
     m_free_list[slot_id] = p;
 }
@@ -100,10 +122,12 @@ void * small_object_allocator::allocate(size_t size) {
 
 #if defined(Z3DEBUG) && !defined(_WINDOWS)
     // Valgrind friendly
+    memory::scoped_tag _tag(m_tag);
     return memory::allocate(size);
 #endif
     m_alloc_size += size;
     if (size >= SMALL_OBJ_SIZE - (1 << PTR_ALIGNMENT)) {
+        memory::scoped_tag _tag(m_tag);
         return memory::allocate(size);
     }
 #ifdef Z3DEBUG
@@ -117,6 +141,8 @@ void * small_object_allocator::allocate(size_t size) {
     if (m_free_list[slot_id] != nullptr) {
         void * r = m_free_list[slot_id];
         m_free_list[slot_id] = *(reinterpret_cast<void **>(r));
+        if (m_slab_mode)
+            get_slab(r)->m_num_used++;
         return r;
     }
     chunk * c = m_chunks[slot_id]; 
@@ -127,14 +153,52 @@ void * small_object_allocator::allocate(size_t size) {
         if (new_curr < c->m_data + CHUNK_SIZE) {
             void * r = c->m_curr;
             c->m_curr = new_curr;
+            c->m_num_used++;
             return r;
         }
     }
-    chunk * new_c = alloc(chunk);
+    chunk * new_c = mk_chunk();
     new_c->m_next = c;
     m_chunks[slot_id] = new_c;
     void * r = new_c->m_curr;
     new_c->m_curr += size;
+    new_c->m_num_used++;
+    return r;
+}
+
+size_t small_object_allocator::release_empty_slabs() {
+    if (!m_slab_mode)
+        return 0;
+    size_t r = 0;
+    for (unsigned slot_id = 1; slot_id < NUM_SLOTS; slot_id++) {
+        // remove free objects that live in empty slabs
+        void *  head = nullptr;
+        void ** tail = &head;
+        void *  ptr  = m_free_list[slot_id];
+        while (ptr != nullptr) {
+            void * next = *(reinterpret_cast<void**>(ptr));
+            if (get_slab(ptr)->m_num_used > 0) {
+                *tail = ptr;
+                tail  = reinterpret_cast<void**>(ptr);
+            }
+            ptr = next;
+        }
+        *tail = nullptr;
+        m_free_list[slot_id] = head;
+        // release empty slabs
+        chunk ** prev = &m_chunks[slot_id];
+        while (*prev != nullptr) {
+            chunk * c = *prev;
+            if (c->m_num_used == 0) {
+                *prev = c->m_next;
+                del_chunk(c);
+                r += SLAB_SIZE;
+            }
+            else {
+                prev = &c->m_next;
+            }
+        }
+    }
     return r;
 }
 
@@ -175,6 +239,12 @@ void small_object_allocator::consolidate() {
                verbose_stream() << "(allocator-consolidate :wasted-size " << get_wasted_size()
                << " :memory " << std::fixed << std::setprecision(2) << 
                static_cast<double>(memory::get_allocation_size())/static_cast<double>(1024*1024) << ")" << std::endl;);
+    if (m_slab_mode) {
+        size_t released = release_empty_slabs();
+        IF_VERBOSE(CONSOLIDATE_VB_LVL, verbose_stream() << "(end-allocator-consolidate :released " << released 
+                   << " :wasted-size " << get_wasted_size() << ")" << std::endl;);
+        return;
+    }
     ptr_vector<chunk> chunks;
     ptr_vector<char> free_objs;
     for (unsigned slot_id = 1; slot_id < NUM_SLOTS; slot_id++) {
@@ -219,7 +289,7 @@ void small_object_allocator::consolidate() {
                 num_free_in_chunk++;
             }
             if (num_free_in_chunk == num_objs_per_chunk) {
-                dealloc(curr_chunk);
+                del_chunk(curr_chunk);
             }
             else {
                 curr_chunk->m_next = last_chunk;
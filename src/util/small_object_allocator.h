@@ -22,26 +22,51 @@ Revision History:
 #include "util/machine.h"
 #include "util/debug.h"
 
+/**
+   \brief Allocator for small objects.
+
+   In slab mode, chunks are page-aligned slabs of SLAB_SIZE bytes. The slab containing
+   an object is obtained by masking its address, and each slab tracks the number of
+   live objects it contains. Empty slabs can then be returned in bulk using 
+   release_empty_slabs.
+*/
 class small_object_allocator {
-    static const unsigned CHUNK_SIZE     = (8192 - sizeof(void*)*2);
+    static const unsigned SLAB_SIZE      = 8192;
+    static const unsigned CHUNK_SIZE     = (SLAB_SIZE - sizeof(void*)*3);
     static const unsigned SMALL_OBJ_SIZE = 256;
     static const unsigned NUM_SLOTS      = (SMALL_OBJ_SIZE >> PTR_ALIGNMENT);
     struct chunk {
         chunk* m_next{ nullptr };
         char* m_curr{ nullptr };
+        size_t m_num_used{ 0 }; // number of live objects, only accurate in slab mode.
         char    m_data[CHUNK_SIZE];
         chunk():m_curr(m_data) {}
     };
     chunk *     m_chunks[NUM_SLOTS];
     void  *     m_free_list[NUM_SLOTS];
     size_t      m_alloc_size;
+    bool        m_slab_mode;
+    unsigned    m_tag;       // memory tag charged for chunks, memory::NUM_TAGS for the tag of the caller
 #ifdef Z3DEBUG
     char const * m_id;
 #endif
+    static chunk * get_slab(void * p) {
+        return reinterpret_cast<chunk*>(reinterpret_cast<size_t>(p) & ~static_cast<size_t>(SLAB_SIZE - 1));
+    }
+    chunk * mk_chunk();
+    void del_chunk(chunk * c);
+    void del_chunks();
 public:
-    small_object_allocator(char const * id = "unknown");
+    small_object_allocator(char const * id = "unknown", bool slab_mode = false);
     ~small_object_allocator();
     void reset();
+    bool slab_mode() const { return m_slab_mode; }
+    void set_memory_tag(unsigned t) { m_tag = t; }
+    /**
+       \brief Release the slabs that do not contain live objects.
+       Return the number of bytes released. It is a no-op if slab mode is disabled.
+    */
+    size_t release_empty_slabs();
     void * allocate(size_t size);
     void deallocate(size_t size, void * p);
     size_t get_allocation_size() const { return m_alloc_size; }
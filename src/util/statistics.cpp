@@ -173,6 +173,34 @@ std::ostream& statistics::display(std::ostream & out) const {
     return out;
 }
 
+std::ostream& statistics::display_json(std::ostream & out) const {
+    INIT_DISPLAY();
+    (void)max;
+    out << "{";
+    for (unsigned i = 0; i < keys.size(); i++) {
+        char const * k = keys.get(i);
+        if (i > 0)
+            out << ",";
+        out << "\"";
+        if (*k == ':')
+            k++;
+        for (; *k; ++k)
+            out << (is_smt2_simple_symbol_char(*k) ? *k : '-');
+        out << "\":";
+        unsigned val;
+        if (m_u.find(keys.get(i), val)) {
+            out << val;
+        }
+        else {
+            double d_val = 0.0;
+            m_d.find(keys.get(i), d_val);
+            out << std::fixed << std::setprecision(2) << d_val;
+        }
+    }
+    out << "}";
+    return out;
+}
+
 template<typename M>
 static void display_internal(std::ostream & out, M const & m) {
     typename M::iterator  it = m.begin();
@@ -229,6 +257,17 @@ double statistics::get_double_value(unsigned idx) const {
     return m_d_stats[idx - m_stats.size()].second;
 }
 
+/**
+   \brief Return the sum of the unsigned statistics with the given key.
+*/
+unsigned statistics::get_uint_value(char const * key) const {
+    unsigned r = 0;
+    for (auto const& kv : m_stats)
+        if (strcmp(kv.first, key) == 0)
+            r += kv.second;
+    return r;
+}
+
 static void get_uint64_stats(statistics& st, char const* name, unsigned long long value) {
     if (value <= UINT_MAX) {
         st.update(name, static_cast<unsigned>(value));
@@ -246,6 +285,13 @@ void get_memory_statistics(statistics& st) {
     st.update("max memory", static_cast<double>(max_mem)/100.0);    
     st.update("memory", static_cast<double>(mem)/100.0);
     get_uint64_stats(st, "num allocs",  memory::get_allocation_count());
+    static char const * tag_keys[memory::NUM_TAGS] = {
+        "memory other", "memory ast", "memory sat", "memory smt", "memory rewriter", "memory lp"
+    };
+    for (unsigned t = 0; t < memory::NUM_TAGS; ++t) {
+        mem = (100*memory::get_allocation_size(t))/(1024*1024);
+        st.update(tag_keys[t], static_cast<double>(mem)/100.0);
+    }
 }
 
 void get_rlimit_statistics(reslimit& l, statistics& st) {
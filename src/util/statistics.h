@@ -34,12 +34,14 @@ public:
     void update(char const * key, double inc);
     std::ostream& display(std::ostream & out) const;
     std::ostream& display_smt2(std::ostream & out) const;
+    std::ostream& display_json(std::ostream & out) const;
     void display_internal(std::ostream & out) const;
     unsigned size() const;
     bool is_uint(unsigned idx) const;
     char const * get_key(unsigned idx) const;
     unsigned get_uint_value(unsigned idx) const;
     double get_double_value(unsigned idx) const;
+    unsigned get_uint_value(char const * key) const;
 };
 
 inline std::ostream& operator<<(std::ostream& out, statistics const& st) { return st.display(out); }
@@ -0,0 +1,596 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    swiss_hashtable.h
+
+Abstract:
+
+    Open addressing hash table with separate control bytes.
+
+    The table has the same interface as core_hashtable and uses the same
+    entries, but the state of a slot is kept in a separate array of
+    control bytes: free, deleted, or the top 7 bits of the hash code of
+    the element in the slot. Lookups probe groups of 16 control bytes at
+    a time, using SSE2 or NEON where available, and only compare the
+    elements of slots whose control byte matches. The table can therefore
+    be filled up to 7/8 of its capacity, and deleted slots are only
+    needed in groups that have been full.
+
+--*/
+#pragma once
+
+#include <cstring>
+#include "util/hashtable.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SWISS_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define SWISS_NEON
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace swiss {
+
+    typedef signed char ctrl_t;
+
+    // full slots store h2, a value in [0, 127].
+    const ctrl_t CTRL_EMPTY    = -128;
+    const ctrl_t CTRL_DELETED  = -2;
+    // padding of tables with fewer slots than a group. Matches nothing.
+    const ctrl_t CTRL_SENTINEL = -1;
+
+    const unsigned GROUP_WIDTH = 16;
+
+    inline unsigned trailing_zeros(uint64_t x) {
+        SASSERT(x != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long r;
+        _BitScanForward64(&r, x);
+        return r;
+#else
+        unsigned r = 0;
+        for (; (x & 1) == 0; x >>= 1)
+            ++r;
+        return r;
+#endif
+    }
+
+    /**
+       \brief set of slots of a group, 2^Shift bits per slot.
+    */
+    template<typename T, unsigned Shift>
+    class bitmask {
+        T m_mask;
+    public:
+        explicit bitmask(T m): m_mask(m) {}
+        bool empty() const { return m_mask == 0; }
+        unsigned lowest() const { return trailing_zeros(m_mask) >> Shift; }
+        void remove_lowest() { m_mask &= m_mask - 1; }
+    };
+
+#if defined(SWISS_SSE2)
+    class group {
+        __m128i m_ctrl;
+        static bitmask<uint32_t, 0> mk(__m128i m) { return bitmask<uint32_t, 0>(static_cast<uint32_t>(_mm_movemask_epi8(m))); }
+    public:
+        typedef bitmask<uint32_t, 0> mask;
+        explicit group(ctrl_t const* c): m_ctrl(_mm_loadu_si128(reinterpret_cast<__m128i const*>(c))) {}
+        mask match(ctrl_t h2) const { return mk(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)); }
+        mask match_empty() const { return match(CTRL_EMPTY); }
+        mask match_empty_or_deleted() const { return mk(_mm_cmpgt_epi8(_mm_set1_epi8(CTRL_SENTINEL), m_ctrl)); }
+    };
+#elif defined(SWISS_NEON)
+    class group {
+        int8x16_t m_ctrl;
+        // narrow each byte of the comparison to a nibble and keep one bit per slot.
+        static bitmask<uint64_t, 2> mk(uint8x16_t m) {
+            uint8x8_t n = vshrn_n_u16(vreinterpretq_u16_u8(m), 4);
+            return bitmask<uint64_t, 2>(vget_lane_u64(vreinterpret_u64_u8(n), 0) & 0x8888888888888888ull);
+        }
+    public:
+        typedef bitmask<uint64_t, 2> mask;
+        explicit group(ctrl_t const* c): m_ctrl(vld1q_s8(c)) {}
+        mask match(ctrl_t h2) const { return mk(vceqq_s8(vdupq_n_s8(h2), m_ctrl)); }
+        mask match_empty() const { return match(CTRL_EMPTY); }
+        mask match_empty_or_deleted() const { return mk(vcltq_s8(m_ctrl, vdupq_n_s8(CTRL_SENTINEL))); }
+    };
+#else
+    class group {
+        ctrl_t m_ctrl[GROUP_WIDTH];
+    public:
+        typedef bitmask<uint32_t, 0> mask;
+        explicit group(ctrl_t const* c) { memcpy(m_ctrl, c, GROUP_WIDTH); }
+        mask match(ctrl_t h2) const {
+            uint32_t m = 0;
+            for (unsigned i = 0; i < GROUP_WIDTH; ++i)
+                m |= static_cast<uint32_t>(m_ctrl[i] == h2) << i;
+            return mask(m);
+        }
+        mask match_empty() const { return match(CTRL_EMPTY); }
+        mask match_empty_or_deleted() const {
+            uint32_t m = 0;
+            for (unsigned i = 0; i < GROUP_WIDTH; ++i)
+                m |= static_cast<uint32_t>(m_ctrl[i] < CTRL_SENTINEL) << i;
+            return mask(m);
+        }
+    };
+#endif
+
+    /**
+       \brief spread the bits of hash codes, many hash functions in the
+       code base map consecutive keys to consecutive codes.
+    */
+    inline unsigned mix_hash(unsigned h) {
+        h *= 0x9E3779B1u;
+        return h ^ (h >> 15);
+    }
+
+    inline ctrl_t h2(unsigned mixed) { return static_cast<ctrl_t>(mixed >> 25); }
+};
+
+template<typename Entry, typename HashProc, typename EqProc>
+class swiss_hashtable : private HashProc, private EqProc {
+public:
+    typedef typename Entry::data data;
+    typedef Entry                entry;
+protected:
+    typedef swiss::ctrl_t ctrl_t;
+    typedef swiss::group  group;
+
+    ctrl_t * m_ctrl;          // control bytes, padded to at least one group
+    entry *  m_table;
+    unsigned m_capacity;
+    unsigned m_size;
+    unsigned m_num_deleted;
+#ifdef HASHTABLE_STATISTICS
+    unsigned long long m_st_collision;
+#endif
+
+    static unsigned num_ctrl(unsigned capacity) { return std::max(capacity, swiss::GROUP_WIDTH); }
+    unsigned num_groups() const { return num_ctrl(m_capacity) / swiss::GROUP_WIDTH; }
+
+    void alloc_table(unsigned capacity) {
+        SASSERT(is_power_of_two(capacity));
+        unsigned n = num_ctrl(capacity);
+        m_ctrl     = alloc_svect(ctrl_t, n);
+        memset(m_ctrl, swiss::CTRL_EMPTY, capacity);
+        memset(m_ctrl + capacity, swiss::CTRL_SENTINEL, n - capacity);
+        m_table    = alloc_vect<entry>(capacity);
+        m_capacity = capacity;
+    }
+
+    void delete_table() {
+        dealloc_vect(m_table, m_capacity);
+        if (m_ctrl)
+            memory::deallocate(m_ctrl);
+        m_table = nullptr;
+        m_ctrl  = nullptr;
+    }
+
+    unsigned get_hash(data const & e) const { return HashProc::operator()(e); }
+    bool equals(data const & e1, data const & e2) const { return EqProc::operator()(e1, e2); }
+
+    static bool is_full(ctrl_t c) { return c >= 0; }
+
+    /**
+       \brief return the first slot on the probe sequence of hash that is
+       free or deleted.
+    */
+    unsigned find_first_non_full(unsigned mixed) const {
+        unsigned mask = num_groups() - 1;
+        unsigned g    = mixed & mask;
+        for (unsigned i = 1; ; ++i) {
+            auto m = group(m_ctrl + g * swiss::GROUP_WIDTH).match_empty_or_deleted();
+            if (!m.empty())
+                return g * swiss::GROUP_WIDTH + m.lowest();
+            g = (g + i) & mask;
+        }
+    }
+
+    void set_ctrl(unsigned idx, ctrl_t c) {
+        SASSERT(idx < m_capacity);
+        m_ctrl[idx] = c;
+    }
+
+    /**
+       \brief move the elements into a table of the given capacity.
+       Deleted slots are dropped.
+    */
+    void rehash(unsigned new_capacity) {
+        ctrl_t * old_ctrl     = m_ctrl;
+        entry *  old_table    = m_table;
+        unsigned old_capacity = m_capacity;
+        alloc_table(new_capacity);
+        for (unsigned i = 0; i < old_capacity; ++i) {
+            if (!is_full(old_ctrl[i]))
+                continue;
+            unsigned mixed = swiss::mix_hash(old_table[i].get_hash());
+            unsigned idx   = find_first_non_full(mixed);
+            set_ctrl(idx, swiss::h2(mixed));
+            m_table[idx] = std::move(old_table[i]);
+        }
+        dealloc_vect(old_table, old_capacity);
+        memory::deallocate(old_ctrl);
+        m_num_deleted = 0;
+    }
+
+    void reserve_one() {
+        if (((m_size + m_num_deleted + 1) << 3) <= m_capacity * 7)
+            return;
+        // reuse the capacity if there are enough deleted slots to reclaim.
+        if (m_num_deleted > m_size / 2 && ((m_size + 1) << 3) <= m_capacity * 7)
+            rehash(m_capacity);
+        else
+            rehash(std::max(m_capacity << 1, 2u));
+    }
+
+    void copy_from(swiss_hashtable const & source) {
+        memcpy(m_ctrl, source.m_ctrl, num_ctrl(m_capacity));
+        for (unsigned i = 0; i < m_capacity; ++i)
+            if (is_full(m_ctrl[i]))
+                m_table[i] = source.m_table[i];
+        m_size        = source.m_size;
+        m_num_deleted = source.m_num_deleted;
+    }
+
+public:
+    swiss_hashtable(unsigned initial_capacity = DEFAULT_HASHTABLE_INITIAL_CAPACITY,
+                    HashProc const & h = HashProc(),
+                    EqProc const & e = EqProc()):
+        HashProc(h),
+        EqProc(e) {
+        alloc_table(initial_capacity);
+        m_size        = 0;
+        m_num_deleted = 0;
+        HS_CODE({
+            m_st_collision = 0;
+        });
+    }
+
+    swiss_hashtable(const swiss_hashtable & source):
+        HashProc(source),
+        EqProc(source) {
+        alloc_table(source.m_capacity);
+        copy_from(source);
+        HS_CODE({
+            m_st_collision = 0;
+        });
+    }
+
+    swiss_hashtable(swiss_hashtable && source) noexcept :
+        HashProc(source),
+        EqProc(source),
+        m_ctrl(nullptr),
+        m_table(nullptr) {
+        m_capacity    = source.m_capacity;
+        std::swap(m_ctrl, source.m_ctrl);
+        std::swap(m_table, source.m_table);
+        m_size        = source.m_size;
+        m_num_deleted = source.m_num_deleted;
+        HS_CODE({
+            m_st_collision = 0;
+        });
+    }
+
+    ~swiss_hashtable() {
+        delete_table();
+    }
+
+    void swap(swiss_hashtable & source) {
+        std::swap(m_ctrl,        source.m_ctrl);
+        std::swap(m_table,       source.m_table);
+        std::swap(m_capacity,    source.m_capacity);
+        std::swap(m_size,        source.m_size);
+        std::swap(m_num_deleted, source.m_num_deleted);
+        HS_CODE({
+            std::swap(m_st_collision, source.m_st_collision);
+        });
+    }
+
+    void reset() {
+        if (m_size == 0 && m_num_deleted == 0)
+            return;
+        // shrink tables that are mostly unused, as core_hashtable does.
+        if (m_capacity > 16 && ((m_size + m_num_deleted) << 2) < m_capacity) {
+            delete_table();
+            alloc_table(m_capacity >> 1);
+        }
+        else {
+            memset(m_ctrl, swiss::CTRL_EMPTY, m_capacity);
+        }
+        m_size        = 0;
+        m_num_deleted = 0;
+    }
+
+    void finalize() {
+        if (m_capacity > SMALL_TABLE_CAPACITY) {
+            delete_table();
+            alloc_table(SMALL_TABLE_CAPACITY);
+            m_size        = 0;
+            m_num_deleted = 0;
+        }
+        else {
+            reset();
+        }
+    }
+
+    class iterator {
+        ctrl_t const * m_ctrl;
+        entry *        m_curr;
+        entry *        m_end;
+        void move_to_used() {
+            while (m_curr != m_end && !is_full(*m_ctrl)) {
+                ++m_curr;
+                ++m_ctrl;
+            }
+        }
+    public:
+        iterator(ctrl_t const * ctrl, entry * start, entry * end): m_ctrl(ctrl), m_curr(start), m_end(end) { move_to_used(); }
+        data & operator*() { return m_curr->get_data(); }
+        data const & operator*() const { return m_curr->get_data(); }
+        data const * operator->() const { return &(operator*()); }
+        data * operator->() { return &(operator*()); }
+        iterator & operator++() { ++m_curr; ++m_ctrl; move_to_used(); return *this; }
+        iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+        bool operator==(iterator const & it) const { return m_curr == it.m_curr; }
+        bool operator!=(iterator const & it) const { return m_curr != it.m_curr; }
+    };
+
+    bool empty() const { return m_size == 0; }
+
+    unsigned size() const { return m_size; }
+
+    unsigned capacity() const { return m_capacity; }
+
+    iterator begin() const { return iterator(m_ctrl, m_table, m_table + m_capacity); }
+
+    iterator end() const { return iterator(m_ctrl + m_capacity, m_table + m_capacity, m_table + m_capacity); }
+
+    entry * find_core(data const & e) const {
+        unsigned hash  = get_hash(e);
+        unsigned mixed = swiss::mix_hash(hash);
+        ctrl_t   h2    = swiss::h2(mixed);
+        unsigned mask  = num_groups() - 1;
+        unsigned g     = mixed & mask;
+        for (unsigned i = 1; ; ++i) {
+            group grp(m_ctrl + g * swiss::GROUP_WIDTH);
+            for (auto m = grp.match(h2); !m.empty(); m.remove_lowest()) {
+                entry * curr = m_table + g * swiss::GROUP_WIDTH + m.lowest();
+                if (curr->get_hash() == hash && equals(curr->get_data(), e))
+                    return curr;
+                HS_CODE(const_cast<swiss_hashtable*>(this)->m_st_collision++;);
+            }
+            if (!grp.match_empty().empty())
+                return nullptr;
+            g = (g + i) & mask;
+        }
+    }
+
+    /**
+       \brief Insert the element e if it is not in the table.
+       Return true if it is a new element, and false otherwise.
+       Store the entry/slot of the table in et.
+    */
+    bool insert_if_not_there_core(data && e, entry * & et) {
+        entry * r = find_core(e);
+        if (r) {
+            et = r;
+            return false;
+        }
+        reserve_one();
+        unsigned hash  = get_hash(e);
+        unsigned mixed = swiss::mix_hash(hash);
+        unsigned idx   = find_first_non_full(mixed);
+        if (m_ctrl[idx] == swiss::CTRL_DELETED)
+            m_num_deleted--;
+        set_ctrl(idx, swiss::h2(mixed));
+        et = m_table + idx;
+        et->set_data(std::move(e));
+        et->set_hash(hash);
+        m_size++;
+        return true;
+    }
+
+    bool insert_if_not_there_core(const data & e, entry * & et) {
+        data temp(e);
+        return insert_if_not_there_core(std::move(temp), et);
+    }
+
+    void insert(data && e) {
+        entry * r = find_core(e);
+        if (r) {
+            r->set_data(std::move(e));
+            return;
+        }
+        insert_if_not_there_core(std::move(e), r);
+    }
+
+    void insert(const data & e) {
+        data tmp(e);
+        insert(std::move(tmp));
+    }
+
+    /**
+       \brief Insert the element e if it is not in the table.
+       Return a reference to e or to an object identical to e
+       that was already in the table.
+     */
+    data const & insert_if_not_there(data const & e) {
+        entry * et;
+        insert_if_not_there_core(e, et);
+        return et->get_data();
+    }
+
+    /**
+       \brief Insert the element e if it is not in the table.
+       Return the entry that contains e.
+    */
+    entry * insert_if_not_there2(data const & e) {
+        entry * et;
+        insert_if_not_there_core(e, et);
+        return et;
+    }
+
+    bool find(data const & k, data & r) const {
+        entry * e = find_core(k);
+        if (e != nullptr) {
+            r = e->get_data();
+            return true;
+        }
+        return false;
+    }
+
+    bool contains(data const & e) const {
+        return find_core(e) != nullptr;
+    }
+
+    iterator find(data const & e) const {
+        entry * r = find_core(e);
+        if (r) {
+            return iterator(m_ctrl + (r - m_table), r, m_table + m_capacity);
+        }
+        else {
+            return end();
+        }
+    }
+
+    void remove(data const & e) {
+        entry * r = find_core(e);
+        if (!r)
+            return;
+        unsigned idx = static_cast<unsigned>(r - m_table);
+        // a probe only continues past a group that has no free slot, and a
+        // group that has a free slot has had one since the last rehash.
+        // So no element was placed behind a group with a free slot.
+        unsigned g = idx / swiss::GROUP_WIDTH;
+        if (!group(m_ctrl + g * swiss::GROUP_WIDTH).match_empty().empty()) {
+            set_ctrl(idx, swiss::CTRL_EMPTY);
+        }
+        else {
+            set_ctrl(idx, swiss::CTRL_DELETED);
+            m_num_deleted++;
+        }
+        m_size--;
+    }
+
+    void erase(data const & e) { remove(e); }
+
+    void dump(std::ostream & out) {
+        out << "[";
+        bool first = true;
+        for (data const& d : *this) {
+            if (first) {
+                first = false;
+            }
+            else {
+                out << " ";
+            }
+            out << d;
+        }
+        out << "]";
+    }
+
+    swiss_hashtable& operator|=(swiss_hashtable const& other) {
+        if (this == &other) return *this;
+        for (const data& d : other) {
+            insert(d);
+        }
+        return *this;
+    }
+
+    swiss_hashtable& operator&=(swiss_hashtable const& other) {
+        if (this == &other) return *this;
+        swiss_hashtable copy(*this);
+        for (const data& d : copy) {
+            if (!other.contains(d)) {
+                remove(d);
+            }
+        }
+        return *this;
+    }
+
+    swiss_hashtable& operator=(swiss_hashtable const& other) {
+        if (this == &other) return *this;
+        reset();
+        for (const data& d : other) {
+            insert(d);
+        }
+        return *this;
+    }
+
+#ifdef Z3DEBUG
+    bool check_invariant() {
+        unsigned num_deleted = 0;
+        unsigned num_used    = 0;
+        for (unsigned i = 0; i < m_capacity; ++i) {
+            if (m_ctrl[i] == swiss::CTRL_DELETED)
+                num_deleted++;
+            if (is_full(m_ctrl[i])) {
+                num_used++;
+                SASSERT(m_ctrl[i] == swiss::h2(swiss::mix_hash(m_table[i].get_hash())));
+                SASSERT(find_core(m_table[i].get_data()) == m_table + i);
+            }
+        }
+        for (unsigned i = m_capacity; i < num_ctrl(m_capacity); ++i)
+            SASSERT(m_ctrl[i] == swiss::CTRL_SENTINEL);
+        SASSERT(num_deleted == m_num_deleted);
+        SASSERT(num_used == m_size);
+        return true;
+    }
+#endif
+
+#ifdef HASHTABLE_STATISTICS
+    unsigned long long get_num_collision() const { return m_st_collision; }
+#else
+    unsigned long long get_num_collision() const { return 0; }
+#endif
+
+    /**
+       \brief collect the elements that are compared with e when it is looked up.
+    */
+    void get_collisions(data const& e, vector<data>& collisions) {
+        unsigned hash  = get_hash(e);
+        unsigned mixed = swiss::mix_hash(hash);
+        unsigned mask  = num_groups() - 1;
+        unsigned g     = mixed & mask;
+        for (unsigned i = 1; ; ++i) {
+            group grp(m_ctrl + g * swiss::GROUP_WIDTH);
+            for (auto m = grp.match(swiss::h2(mixed)); !m.empty(); m.remove_lowest()) {
+                entry * curr = m_table + g * swiss::GROUP_WIDTH + m.lowest();
+                if (curr->get_hash() == hash && equals(curr->get_data(), e))
+                    return;
+                collisions.push_back(curr->get_data());
+            }
+            if (!grp.match_empty().empty())
+                return;
+            g = (g + i) & mask;
+        }
+    }
+};
+
+template<typename T, typename HashProc, typename EqProc>
+class swiss_table : public swiss_hashtable<default_hash_entry<T>, HashProc, EqProc> {
+public:
+    swiss_table(unsigned initial_capacity = DEFAULT_HASHTABLE_INITIAL_CAPACITY,
+                const HashProc & h = HashProc(),
+                const EqProc & e = EqProc()):
+        swiss_hashtable<default_hash_entry<T>, HashProc, EqProc>(initial_capacity, h, e) {}
+};
+
+template<typename T, typename HashProc, typename EqProc>
+class ptr_swiss_table : public swiss_hashtable<ptr_hash_entry<T>, HashProc, EqProc> {
+public:
+    ptr_swiss_table(unsigned initial_capacity = DEFAULT_HASHTABLE_INITIAL_CAPACITY,
+                    const HashProc & h = HashProc(),
+                    const EqProc & e = EqProc()):
+        swiss_hashtable<ptr_hash_entry<T>, HashProc, EqProc>(initial_capacity, h, e) {}
+};
@@ -24,6 +24,7 @@ Revision History:
 #include "util/string_buffer.h"
 #include <cstring>
 #ifndef SINGLE_THREAD
+#include <atomic>
 #include <thread>
 #endif
 
@@ -90,15 +91,64 @@ struct internal_symbol_tables {
         dealloc_vect<internal_symbol_table*>(tables, sz);
     }
 
-    char const * get_str(char const * d) {
-        auto* table = tables[string_hash(d, static_cast<unsigned>(strlen(d)), 251) % sz];
-        return table->get_str(d);
+    char const * get_str(char const * d, unsigned h) {
+        return tables[h % sz]->get_str(d);
     }
 };
 
 
 static internal_symbol_tables* g_symbol_tables = nullptr;
 
+#ifndef SINGLE_THREAD
+/**
+   \brief Per-thread cache of interned strings.
+
+   Interned strings are never freed before finalize_symbols, so a thread can
+   keep the pointers it obtained and look them up again without taking the
+   lock of a symbol table. Parsers and fresh name generation create the same
+   names over and over again, so most lookups hit the cache. The cache is
+   direct mapped; a miss falls back to the shared table and replaces the
+   entry. finalize_symbols bumps the epoch, which invalidates the caches of
+   all threads.
+*/
+static std::atomic<unsigned> g_symbol_epoch(0);
+
+class symbol_cache {
+    static const unsigned SIZE = 1024;
+    struct entry {
+        unsigned     m_hash;
+        char const * m_str;
+    };
+    unsigned m_epoch;
+    entry    m_entries[SIZE];
+public:
+    char const * get_str(char const * d) {
+        unsigned h = string_hash(d, static_cast<unsigned>(strlen(d)), 251);
+        unsigned epoch = g_symbol_epoch.load(std::memory_order_relaxed);
+        if (epoch != m_epoch) {
+            memset(m_entries, 0, sizeof(m_entries));
+            m_epoch = epoch;
+        }
+        entry & e = m_entries[h & (SIZE - 1)];
+        if (e.m_str && e.m_hash == h && strcmp(e.m_str, d) == 0)
+            return e.m_str;
+        e.m_hash = h;
+        e.m_str  = g_symbol_tables->get_str(d, h);
+        return e.m_str;
+    }
+};
+
+static thread_local symbol_cache g_symbol_cache;
+
+static char const * intern(char const * d) {
+    return g_symbol_cache.get_str(d);
+}
+#else
+static char const * intern(char const * d) {
+    return g_symbol_tables->get_str(d, 0);
+}
+#endif
+
 void initialize_symbols() {
     if (!g_symbol_tables) {
 #ifdef SINGLE_THREAD
@@ -112,6 +162,9 @@ void initialize_symbols() {
 }
 
 void finalize_symbols() {
+#ifndef SINGLE_THREAD
+    g_symbol_epoch.fetch_add(1);
+#endif
     dealloc(g_symbol_tables);
     g_symbol_tables = nullptr;
 }
@@ -120,11 +173,11 @@ symbol::symbol(char const * d) {
     if (d == nullptr)
         m_data = nullptr;
     else
-        m_data = g_symbol_tables->get_str(d);
+        m_data = intern(d);
 }
 
 symbol & symbol::operator=(char const * d) {
-    m_data = d ? g_symbol_tables->get_str(d) : nullptr;
+    m_data = d ? intern(d) : nullptr;
     return *this;
 }
 
@@ -54,6 +54,9 @@ public:
     void undo(Ctx & ctx) override {
         m_value = m_old_value;
     }
+
+    T & get_ref() const { return m_value; }
+    T const & get_old_value() const { return m_old_value; }
 };
 
 template<typename Ctx>
@@ -366,10 +369,79 @@ void undo_trail_stack(Ctx & ctx, ptr_vector<trail<Ctx> > & s, unsigned old_size)
     s.shrink(old_size);
 }
 
+/**
+   \brief Sequence of undo actions. Trail objects are stored by pointer,
+   while value trails of bool, int and unsigned fields are stored as plain
+   records of the field address and its old value. Such a record takes 16
+   bytes instead of a pointer and a 24 byte trail object in the region,
+   and it is undone without a virtual call.
+*/
+template<typename Ctx>
+class trail_log {
+    enum kind { TRAIL_OBJ, TRAIL_BOOL, TRAIL_WORD };
+
+    struct entry {
+        void *   m_ptr;
+        unsigned m_old;
+        unsigned m_kind;
+    };
+
+    svector<entry> m_entries;
+
+public:
+    unsigned size() const { return m_entries.size(); }
+
+    bool empty() const { return m_entries.empty(); }
+
+    void push_ptr(trail<Ctx> * t) { m_entries.push_back({ t, 0, TRAIL_OBJ }); }
+
+    template<typename TrailObject>
+    void push(TrailObject const & obj, region & r) { push_ptr(new (r) TrailObject(obj)); }
+
+    void push(value_trail<Ctx, bool> const & obj, region & r) {
+        m_entries.push_back({ &obj.get_ref(), obj.get_old_value(), TRAIL_BOOL });
+    }
+
+    void push(value_trail<Ctx, unsigned> const & obj, region & r) {
+        m_entries.push_back({ &obj.get_ref(), obj.get_old_value(), TRAIL_WORD });
+    }
+
+    void push(value_trail<Ctx, int> const & obj, region & r) {
+        m_entries.push_back({ &obj.get_ref(), static_cast<unsigned>(obj.get_old_value()), TRAIL_WORD });
+    }
+
+    void shrink(unsigned sz) { m_entries.shrink(sz); }
+
+    void undo(Ctx & ctx, unsigned old_size) {
+        SASSERT(old_size <= m_entries.size());
+        for (unsigned i = m_entries.size(); i-- > old_size; ) {
+            entry const & e = m_entries[i];
+            switch (e.m_kind) {
+            case TRAIL_OBJ:
+                static_cast<trail<Ctx> *>(e.m_ptr)->undo(ctx);
+                break;
+            case TRAIL_BOOL:
+                *static_cast<bool *>(e.m_ptr) = e.m_old != 0;
+                break;
+            default:
+                // int fields are accessed through their unsigned counterpart.
+                *static_cast<unsigned *>(e.m_ptr) = e.m_old;
+                break;
+            }
+        }
+        m_entries.shrink(old_size);
+    }
+};
+
+template<typename Ctx>
+void undo_trail_stack(Ctx & ctx, trail_log<Ctx> & s, unsigned old_size) {
+    s.undo(ctx, old_size);
+}
+
 template<typename Ctx>
 class trail_stack {
     Ctx &                   m_ctx;
-    ptr_vector<trail<Ctx> > m_trail_stack;
+    trail_log<Ctx>          m_trail_stack;
     unsigned_vector         m_scopes;
     region                  m_region;
 public:
@@ -385,10 +457,10 @@ public:
         undo_trail_stack(m_ctx, m_trail_stack, 0);
     }
 
-    void push_ptr(trail<Ctx> * t) { m_trail_stack.push_back(t); }
+    void push_ptr(trail<Ctx> * t) { m_trail_stack.push_ptr(t); }
 
     template<typename TrailObject>
-    void push(TrailObject const & obj) { m_trail_stack.push_back(new (m_region) TrailObject(obj)); }
+    void push(TrailObject const & obj) { m_trail_stack.push(obj, m_region); }
 
     unsigned get_num_scopes() const { return m_scopes.size(); }
 